@@ -1,26 +1,53 @@
 /* SafeCloud Client Connection Manager Implementation */
 
 /* ================================== INCLUDES ================================== */
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include "errCodes/execErrCodes/execErrCodes.h"
 #include "CliConnMgr.h"
 
 
+/* ============================== PRIVATE METHODS ============================== */
+
+/**
+ * @brief Sets or clears the TCP_CORK option on the connection socket, which while set has the
+ *        kernel only send full TCP segments (or pending data after at most 200 milliseconds)
+ * @param cork Whether the connection socket should be corked
+ * @note  Failing to set the option is not an error, just causing the
+ *        corked messages to be sent in separate TCP segments
+ */
+void CliConnMgr::setSockCork(bool cork)
+ {
+  int corkOpt = cork ? 1 : 0;
+
+  if(setsockopt(_csk, IPPROTO_TCP, TCP_CORK, &corkOpt, sizeof(corkOpt)) == -1)
+   {
+    LOG_DEBUG("Failed to " + std::string(cork ? "cork" : "uncork") +
+              " the connection socket (" + std::string(ERRNO_DESC) + ")")
+   }
+ }
+
+
 /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
 /**
- * @brief           CliConnMgr object constructor
- * @param csk       The connection socket associated with this manager
- * @param name      The client name associated with this connection
- * @param tmpDir    The connection's temporary directory
- * @param downDir   The client's download directory absolute path
- * @param rsaKey    The client's long-term RSA key pair
- * @param certStore The client's X.509 certificates store
+ * @brief            CliConnMgr object constructor
+ * @param csk        The connection socket associated with this manager
+ * @param name       The client name associated with this connection
+ * @param tmpDir     The connection's temporary directory
+ * @param downDir    The client's download directory absolute path
+ * @param rsaKey     The client's long-term RSA key pair
+ * @param certStore  The client's X.509 certificates store
+ * @param resTicket  The client's resumption ticket
+ * @param earlyReq   Whether the client's first session request should
+ *                   be sent along with its 'CLI_AUTH' message
+ * @param aesGCMPool The client's AES_128_GCM workers pool
  * @note The constructor also initializes the _cliSTSMMgr child object
  */
-CliConnMgr::CliConnMgr(int csk, std::string* name, std::string* tmpDir,
-                       std::string* downDir, EVP_PKEY* rsaKey, X509_STORE* certStore)
- : ConnMgr(csk,name,tmpDir), _downDir(downDir),
-   _cliSTSMMgr(new CliSTSMMgr(rsaKey, *this, certStore)), _cliSessMgr(nullptr)
+CliConnMgr::CliConnMgr(int csk, std::string* name, std::string* tmpDir, std::string* downDir, EVP_PKEY* rsaKey,
+                       X509_STORE* certStore, CliResTicket* resTicket, bool earlyReq, AESGCMPool& aesGCMPool)
+ : ConnMgr(csk,name,tmpDir), _downDir(downDir), _earlyReq(earlyReq), _aesGCMPool(aesGCMPool),
+   _cliSTSMMgr(new CliSTSMMgr(rsaKey, *this, certStore, resTicket)), _cliSessMgr(nullptr)
  {}
 
 
@@ -39,27 +66,63 @@ CliConnMgr::~CliConnMgr()
 /* ============================ OTHER PUBLIC METHODS ============================ */
 
 /**
- * @brief  Executes the STSM client protocol, and
- *         initializes the communication's session phase
+ * @brief  Executes the STSM client protocol, and initializes the communication's session
+ *         phase, where if the client's first session request should be sent along with
+ *         its 'CLI_AUTH' message the server's 'SRV_OK' message is left pending, being
+ *         received via the finishCliSTSM() method before the first session message
  * @throws All the STSM exceptions and most of the OpenSSL
  *         exceptions (see "execErrCode.h" for more details)
  */
 void CliConnMgr::startCliSTSM()
  {
   // Executes the STSM client protocol, exchanging STSM messages with
-  // the SafeCloud server so to establish a shared AES_128 session key
+  // the SafeCloud server so to establish a shared session key
   // and IV and to authenticate the client and server with one another
-  _cliSTSMMgr->startCliSTSM();
+  // and, if it has completed, delete the CliSTSMMgr child object
+  if(_cliSTSMMgr->startCliSTSM(_earlyReq))
+   {
+    delete _cliSTSMMgr;
+    _cliSTSMMgr = nullptr;
+   }
+
+  /*
+   * Instantiate the CliSessMgr child object and switch the connection to the
+   * SESSION phase, which is possible also with the server's 'SRV_OK' message
+   * still pending as the session key, the IV and the connection's parameters
+   * are all known to the client after receiving the server's 'SRV_AUTH' message
+   */
+  _cliSessMgr = new CliSessMgr(*this);
+  _connPhase = SESSION;
+ }
+
+
+/**
+ * @brief  Returns whether the server's 'SRV_OK' STSM message is still pending
+ * @return Whether the server's 'SRV_OK' STSM message is still pending
+ */
+bool CliConnMgr::isSTSMPending() const
+ { return _cliSTSMMgr != nullptr; }
+
+
+/**
+ * @brief  If the server's 'SRV_OK' STSM message is pending, blocks until it has been
+ *         received and parsed, completing the STSM client protocol execution
+ * @throws All the STSM exceptions and most of the OpenSSL
+ *         exceptions (see "execErrCode.h" for more details)
+ */
+void CliConnMgr::finishCliSTSM()
+ {
+  if(_cliSTSMMgr == nullptr)
+   return;
+
+  // Receive and parse the server's 'SRV_OK' STSM message
+  _cliSTSMMgr->finishCliSTSM();
 
   // Delete the CliSTSMMgr child object
   delete _cliSTSMMgr;
   _cliSTSMMgr = nullptr;
 
-  // Instantiate the CliSessMgr child object
-  _cliSessMgr = new CliSessMgr(*this);
-
-  // Switch the connection to the SESSION phase
-  _connPhase = SESSION;
+  LOG_INFO("Successfully established a secure connection with the SafeCloud Server")
  }
 
 
@@ -14,6 +14,9 @@ class CliConnMgr : public ConnMgr
 
    /* ================================= ATTRIBUTES ================================= */
    std::string* _downDir;    // The absolute path of the client's download directory
+   bool         _earlyReq;   // Whether the client's first session request is sent along
+                             // with its 'CLI_AUTH' message (one round-trip login)
+   AESGCMPool&  _aesGCMPool; // The client's AES_128_GCM workers pool
 
    CliSTSMMgr* _cliSTSMMgr;  // The child client STSM key establishment manager object
    CliSessMgr* _cliSessMgr;  // The child client Session Manager object
@@ -23,22 +26,37 @@ class CliConnMgr : public ConnMgr
    friend class CliSTSMMgr;
    friend class CliSessMgr;
 
+   /* =============================== PRIVATE METHODS =============================== */
+
+   /**
+    * @brief Sets or clears the TCP_CORK option on the connection socket, which while set has the
+    *        kernel only send full TCP segments (or pending data after at most 200 milliseconds)
+    * @param cork Whether the connection socket should be corked
+    * @note  Failing to set the option is not an error, just causing the
+    *        corked messages to be sent in separate TCP segments
+    */
+   void setSockCork(bool cork);
+
   public:
 
    /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
    /**
-    * @brief           CliConnMgr object constructor
-    * @param csk       The connection socket associated with this manager
-    * @param name      The client name associated with this connection
-    * @param tmpDir    The connection's temporary directory
-    * @param downDir   The client's download directory
-    * @param rsaKey    The client's long-term RSA key pair
-    * @param certStore The client's X.509 certificates store
+    * @brief            CliConnMgr object constructor
+    * @param csk        The connection socket associated with this manager
+    * @param name       The client name associated with this connection
+    * @param tmpDir     The connection's temporary directory
+    * @param downDir    The client's download directory
+    * @param rsaKey     The client's long-term RSA key pair
+    * @param certStore  The client's X.509 certificates store
+    * @param resTicket  The client's resumption ticket
+    * @param earlyReq   Whether the client's first session request should
+    *                   be sent along with its 'CLI_AUTH' message
+    * @param aesGCMPool The client's AES_128_GCM workers pool
     * @note The constructor also initializes the _cliSTSMMgr child object
     */
-   CliConnMgr(int csk, std::string* name, std::string* tmpDir,
-              std::string* downDir, EVP_PKEY* rsaKey, X509_STORE* certStore);
+   CliConnMgr(int csk, std::string* name, std::string* tmpDir, std::string* downDir, EVP_PKEY* rsaKey,
+              X509_STORE* certStore, CliResTicket* resTicket, bool earlyReq, AESGCMPool& aesGCMPool);
 
    /**
     * @brief CliConnMgr object destructor, safely deleting the
@@ -49,13 +67,29 @@ class CliConnMgr : public ConnMgr
    /* ============================= OTHER PUBLIC METHODS ============================= */
 
    /**
-    * @brief  Executes the STSM client protocol, and
-    *         initializes the communication's session phase
+    * @brief  Executes the STSM client protocol, and initializes the communication's session
+    *         phase, where if the client's first session request should be sent along with
+    *         its 'CLI_AUTH' message the server's 'SRV_OK' message is left pending, being
+    *         received via the finishCliSTSM() method before the first session message
     * @throws All the STSM exceptions and most of the OpenSSL
     *         exceptions (see "execErrCode.h" for more details)
     */
    void startCliSTSM();
 
+   /**
+    * @brief  Returns whether the server's 'SRV_OK' STSM message is still pending
+    * @return Whether the server's 'SRV_OK' STSM message is still pending
+    */
+   bool isSTSMPending() const;
+
+   /**
+    * @brief  If the server's 'SRV_OK' STSM message is pending, blocks until it has been
+    *         received and parsed, completing the STSM client protocol execution
+    * @throws All the STSM exceptions and most of the OpenSSL
+    *         exceptions (see "execErrCode.h" for more details)
+    */
+   void finishCliSTSM();
+
    /**
     * @brief  Returns a pointer to the session manager's child object
     * @return A pointer to the session manager's child object
@@ -158,9 +158,67 @@ void CliSTSMMgr::recvCheckCliSTSMMsg()
       THROW_EXEC_EXCP(ERR_STSM_MALFORMED_MESSAGE,
                       "'SRV_OK' message of unexpected length");
 
+     // Ensure the optional features and the AEAD cipher of the connection to match
+     // the ones announced by the server in its 'SRV_AUTH' message, which have
+     // already been adopted by the client (and possibly used in its first
+     // session request sent along with its 'CLI_AUTH' message)
+     if(reinterpret_cast<STSM_SRV_OK_MSG*>(stsmMsg)->srvFeatures !=
+        _cliConnMgr.getFeatures() ||
+        reinterpret_cast<STSM_SRV_OK_MSG*>(stsmMsg)->srvCipher != _cliConnMgr._aeadCipher)
+      THROW_EXEC_EXCP(ERR_STSM_MALFORMED_MESSAGE,
+                      "'SRV_OK' message parameters not matching the 'SRV_AUTH' message ones");
+
      // A valid 'SRV_OK' message has been received
      return;
 
+    // 'SRV_RESUME_OK' message
+    case SRV_RESUME_OK:
+
+     /*
+      * NOTE: As for the 'SRV_OK' message, in case of 'SRV_RESUME_OK'
+      *       message errors no notification is returned to the server,
+      *       as it has already determined the STSM protocol as completed
+      */
+     // This message can be received only in the 'WAITING_SRV_RESUME' STSM client state
+     if(_stsmCliState != WAITING_SRV_RESUME)
+      THROW_EXEC_EXCP(ERR_STSM_UNEXPECTED_MESSAGE, "SRV_RESUME_OK");
+
+     // Ensure the message length to be at least equal to the size of a 'SRV_RESUME_OK' message's
+     // fixed part (the size of the server's ephemeral public key being validated in the
+     // recv_srv_resume_ok() method)
+     if(stsmMsg->header.len < sizeof(STSM_SRV_RESUME_OK_MSG))
+      THROW_EXEC_EXCP(ERR_STSM_MALFORMED_MESSAGE,
+                      "'SRV_RESUME_OK' message of unexpected length");
+
+     // Ensure the server to have enabled only optional features offered by the client
+     if(reinterpret_cast<STSM_SRV_RESUME_OK_MSG*>(stsmMsg)->srvFeatures & ~STSM_SUPPORTED_FEATURES)
+      THROW_EXEC_EXCP(ERR_STSM_MALFORMED_MESSAGE,
+                      "'SRV_RESUME_OK' message enabling features not offered by the client");
+
+     // Ensure the server to have selected an AEAD cipher offered by the client
+     if(reinterpret_cast<STSM_SRV_RESUME_OK_MSG*>(stsmMsg)->srvCipher != AEAD_AES_128_GCM &&
+        reinterpret_cast<STSM_SRV_RESUME_OK_MSG*>(stsmMsg)->srvCipher != AEAD_CHACHA20_POLY1305)
+      THROW_EXEC_EXCP(ERR_STSM_MALFORMED_MESSAGE,
+                      "'SRV_RESUME_OK' message selecting an AEAD cipher not offered by the client");
+
+     // A valid 'SRV_RESUME_OK' message has been received
+     return;
+
+    // 'SRV_RESUME_REJECTED' message
+    case SRV_RESUME_REJECTED:
+
+     // This message can be received only in the 'WAITING_SRV_RESUME' STSM client state
+     if(_stsmCliState != WAITING_SRV_RESUME)
+      sendCliSTSMErrMsg(ERR_UNEXPECTED_MESSAGE,"'SRV_RESUME_REJECTED'");
+
+     // Ensure the message length to be equal to the size of a 'SRV_RESUME_REJECTED' message
+     if(stsmMsg->header.len != sizeof(STSMMsg))
+      sendCliSTSMErrMsg(ERR_MALFORMED_MESSAGE,
+                        "'SRV_RESUME_REJECTED' message of unexpected length");
+
+     // A valid 'SRV_RESUME_REJECTED' message has been received
+     return;
+
     /* ------------------------ Error STSM Messages  ------------------------ */
 
     // The server reported the last STSM message to have
@@ -203,11 +261,20 @@ void CliSTSMMgr::recvCheckCliSTSMMsg()
 
 /**
  * @brief  Sends the 'CLIENT_HELLO' STSM message to the SafeCloud server (1/4), consisting of:\n\n
- *             1) The client's ephemeral DH public key "Yc"\n\n
- *             2) The initial random IV to be used in the secure communication
+ *             1) The initial random IV to be used in the secure communication\n\n
+ *             2) The optional features supported by the client\n\n
+ *             3) The AEAD ciphers supported by the client in decreasing order of preference\n\n
+ *             4) The STSM suite chosen by the client (STSM_CLI_SUITE)\n\n
+ *             5) The client's ephemeral public key "Yc" of such suite
+ * @throws ERR_OSSL_EVP_PKEY_NEW                EVP_PKEY struct creation failed
+ * @throws ERR_OSSL_EVP_PKEY_ASSIGN             EVP_PKEY struct assignment failure
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW            EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT        EVP_PKEY key generation initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN             EVP_PKEY Key generation failed
  * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
  * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the client's ephemeral DH public key into the BIO
  * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read the client's ephemeral DH public key from the BIO
+ * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write the client's ephemeral X25519 public key
  * @throws ERR_OSSL_RAND_POLL_FAILED            RAND_poll() IV seed generation failed
  * @throws ERR_OSSL_RAND_BYTES_FAILED           RAND_bytes() IV bytes generation failed
  */
@@ -217,10 +284,19 @@ void CliSTSMMgr::send_client_hello()
   // connection buffer as a 'CLIENT_HELLO' STSM message
   STSM_CLIENT_HELLO_MSG* cliHelloMsg = reinterpret_cast<STSM_CLIENT_HELLO_MSG*>(_cliConnMgr._priBuf);
 
+  /* ----------------------------- STSM Suite ----------------------------- */
+
+  // Set the STSM suite chosen by the client and generate its ephemeral key pair accordingly
+  _stsmSuite = STSM_CLI_SUITE;
+  EDHKeygen();
+
+  // Notify the server of the STSM suite chosen by the client
+  cliHelloMsg->cliSuite = _stsmSuite;
+
   /* ------------------------ STSM Message Header ------------------------ */
 
   // Initialize the STSM message length and type
-  cliHelloMsg->header.len = sizeof(STSM_CLIENT_HELLO_MSG);
+  cliHelloMsg->header.len = sizeof(STSM_CLIENT_HELLO_MSG) + EDHPubKeySize();
   cliHelloMsg->header.type = CLIENT_HELLO;
 
   /* ------------------ Client's ephemeral DH public key ------------------ */
@@ -236,6 +312,15 @@ void CliSTSMMgr::send_client_hello()
   // Copy the generated IV into the 'CLIENT_HELLO' message
   cliHelloMsg->iv = *_cliConnMgr._iv;
 
+  /* ------------------------- Supported Features ------------------------- */
+
+  // Offer the server all the optional features supported by the client
+  cliHelloMsg->cliFeatures = STSM_SUPPORTED_FEATURES;
+
+  // Offer the server the AEAD ciphers supported by the client, in
+  // decreasing order of preference depending on its CPU features
+  AEAD_GetCipherPrefs(cliHelloMsg->cliCiphers);
+
   /* -------------------------- Message Sending -------------------------- */
 
   // Send the 'CLIENT_HELLO' message to the server
@@ -345,16 +430,22 @@ void CliSTSMMgr::validateSrvCert(X509* srvCert)
 
 /**
  * @brief  Parses the server's 'SRV_AUTH' STSM message (2/4), consisting of:\n\n
- *            1) The server's ephemeral DH public key "Ys"\n\n
- *            2) The server's STSM authentication proof, consisting of the concatenation
+ *            1) The optional features and the AEAD cipher selected by the server
+ *               for the connection, which are adopted by the client\n\n
+ *            2) The server's ephemeral DH public key "Ys"\n\n
+ *            3) The server's STSM authentication proof, consisting of the concatenation
  *               of both actors' ephemeral public DH keys (STSM authentication value)
- *               signed with the server's long-term private RSA key and encrypted with
+ *               signed with the server's long-term private key and encrypted with
  *               the resulting shared symmetric session key "{<Yc,Ys>s}k"\n\n
- *            3) The server's certificate "srvCert"
+ *            4) The server's certificate "srvCert"
+ * @throws ERR_STSM_MALFORMED_MESSAGE           Message length not matching its contents' sizes
+ * @throws ERR_STSM_MALFORMED_MESSAGE           Features or AEAD cipher not offered by the client
  * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
  * @throws ERR_OSSL_EVP_PKEY_NEW                EVP_PKEY struct creation failed
  * @throws ERR_STSM_SRV_CLI_INVALID_PUBKEY      The server provided an invalid ephemeral DH public key
  * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the server' public key into the memory BIO
+ * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write an actor's raw X25519 public key
+ * @throws ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY     Failed to rebuild the client's raw X25519 public key
  * @throws ERR_STSM_CLI_SRV_CERT_REJECTED       The server's certificate is invalid
  * @throws ERR_OSSL_X509_STORE_CTX_NEW          X509_STORE context creation failed
  * @throws ERR_OSSL_X509_STORE_CTX_INIT         X509_STORE context initialization failed
@@ -378,28 +469,47 @@ void CliSTSMMgr::recv_srv_auth()
   // primary connection buffer as a 'SRV_AUTH' message
   STSM_SRV_AUTH_MSG* stsmSrvAuth = reinterpret_cast<STSM_SRV_AUTH_MSG*>(_cliConnMgr._priBuf);
 
-  /* ------------------ Server's ephemeral DH public key ------------------ */
+  // The size of an ephemeral public key in the STSM suite used
+  unsigned int pubKeySize = EDHPubKeySize();
 
-  // Initialize a memory BIO to the server's ephemeral DH public key
-  BIO* srvPubDHBIO = BIO_new_mem_buf(stsmSrvAuth->srvEDHPubKey, -1);
-  if(srvPubDHBIO == NULL)
-   THROW_EXEC_EXCP(ERR_OSSL_BIO_NEW_FAILED, OSSL_ERR_DESC);
+  // The size of the server's STSM authentication proof
+  unsigned int srvProofSize = stsmSrvAuth->srvSTSMAuthProofSize;
 
-  /* NOT NEEDED (from valgrind memory checker) */
-  /*
-  // Initialize the server's ephemeral DH public key structure
-  _otherDHEPubKey = EVP_PKEY_new();
-  if(_otherDHEPubKey == nullptr)
-   THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_NEW, OSSL_ERR_DESC);
-  */
+  // The server's long-term public key, as extracted from its certificate
+  EVP_PKEY* srvPubKey;
 
-  // Write the server's ephemeral DH public key from
-  // the memory BIO into the EVP_PKEY structure
-  _otherDHEPubKey = PEM_read_bio_PUBKEY(srvPubDHBIO, NULL, NULL, NULL);
+  /* ----------------------- Message Size Validation ----------------------- */
 
-  // Free the memory BIO
-  if(BIO_free(srvPubDHBIO) != 1)
-   LOG_EXEC_CODE(ERR_OSSL_BIO_FREE_FAILED, OSSL_ERR_DESC);
+  // Ensure the server's STSM authentication proof size to be valid and the message
+  // length to leave room for the server's certificate after its fixed-size contents
+  if(srvProofSize == 0 || srvProofSize > STSM_AUTH_PROOF_MAX_SIZE ||
+     stsmSrvAuth->header.len <= sizeof(STSM_SRV_AUTH_MSG) + pubKeySize + srvProofSize)
+   sendCliSTSMErrMsg(ERR_MALFORMED_MESSAGE,"'SRV_AUTH' message of unexpected length");
+
+  /* ----------------------- Connection Parameters ----------------------- */
+
+  // Ensure the server to have enabled only optional features offered by the client
+  if(stsmSrvAuth->srvFeatures & ~STSM_SUPPORTED_FEATURES)
+   sendCliSTSMErrMsg(ERR_MALFORMED_MESSAGE,"'SRV_AUTH' message enabling features not offered by the client");
+
+  // Ensure the server to have selected an AEAD cipher offered by the client
+  if(stsmSrvAuth->srvCipher != AEAD_AES_128_GCM && stsmSrvAuth->srvCipher != AEAD_CHACHA20_POLY1305)
+   sendCliSTSMErrMsg(ERR_MALFORMED_MESSAGE,"'SRV_AUTH' message selecting an AEAD cipher not offered by the client");
+
+  // Enable the optional features that were agreed with the server
+  // and set the AEAD cipher selected for the session phase of the connection
+  _cliConnMgr._compress = (stsmSrvAuth->srvFeatures & STSM_FEATURE_COMPRESSION) != 0;
+  _cliConnMgr._largeFiles = (stsmSrvAuth->srvFeatures & STSM_FEATURE_LARGE_FILES) != 0;
+  _cliConnMgr._resumeUploads = (stsmSrvAuth->srvFeatures & STSM_FEATURE_RESUMABLE_UPLOADS) != 0;
+  _cliConnMgr._rangedDownloads = (stsmSrvAuth->srvFeatures & STSM_FEATURE_RANGED_DOWNLOADS) != 0;
+  _cliConnMgr._dedupUploads = (stsmSrvAuth->srvFeatures & STSM_FEATURE_DEDUP_UPLOADS) != 0;
+  _cliConnMgr._deltaUploads = (stsmSrvAuth->srvFeatures & STSM_FEATURE_DELTA_UPLOADS) != 0;
+  _cliConnMgr._aeadCipher = (AEADCipher)stsmSrvAuth->srvCipher;
+
+  /* ------------------ Server's ephemeral DH public key ------------------ */
+
+  // Read the server's ephemeral public key from the 'SRV_AUTH' message
+  readOtherEDHPubKey(&stsmSrvAuth->srvAuthData[0]);
 
   // Ensure the server's ephemeral DH public key to be valid
   if(_otherDHEPubKey == nullptr)
@@ -414,28 +524,27 @@ void CliSTSMMgr::recv_srv_auth()
 
   /* ------------------- Shared Session Key Derivation ------------------- */
 
-  // Derive the shared AES_128 session key from the client's
+  // Derive the shared session key from the client's
   // private and the server's public ephemeral DH keys
-  deriveAES128SKey(_cliConnMgr._skey);
+  deriveSessKey(_cliConnMgr._skey, nullptr);
 
   // In DEBUG_MODE, log the shared session key in hexadecimal
 #ifdef DEBUG_MODE
-  char skeyHex[33];
-  for(int i = 0; i < AES_128_KEY_SIZE; i++)
+  char skeyHex[2 * AEAD_KEY_MAX_SIZE + 1];
+  for(int i = 0; i < AEAD_KEY_MAX_SIZE; i++)
    sprintf(skeyHex + 2 * i, "%.2x", _cliConnMgr._skey[i]);
-  skeyHex[32] = '\0';
+  skeyHex[2 * AEAD_KEY_MAX_SIZE] = '\0';
 
   LOG_DEBUG("Shared session key: " + std::string(skeyHex))
 #endif
 
   /* ------------------ Server Certificate Verification ------------------ */
 
-  // Initialize a memory BIO to the server's certificate
-  //
-  // NOTE: The function is capable of autonomously determining the
-  //       correct certificate's length by passing "-1" as "len" argument
-  //
-  BIO* srvCertBIO = BIO_new_mem_buf(stsmSrvAuth->srvCert, -1);
+  // Initialize a memory BIO to the server's certificate, which
+  // occupies the rest of the 'SRV_AUTH' message after its proof
+  BIO* srvCertBIO = BIO_new_mem_buf(&stsmSrvAuth->srvAuthData[pubKeySize + srvProofSize],
+                                    (int)(stsmSrvAuth->header.len - sizeof(STSM_SRV_AUTH_MSG)
+                                          - pubKeySize - srvProofSize));
   if(srvCertBIO == NULL)
    THROW_EXEC_EXCP(ERR_OSSL_BIO_NEW_FAILED, OSSL_ERR_DESC);
 
@@ -454,36 +563,40 @@ void CliSTSMMgr::recv_srv_auth()
   /*
   // LOG: Server's STSM authentication proof
   printf("Server's STSM authentication proof:\n");
-  for(int i=0; i < STSM_AUTH_PROOF_SIZE ; i++)
-   printf("%02x", stsmSrvAuth->srvSTSMAuthProof[i]);
+  for(int i=0; i < srvProofSize ; i++)
+   printf("%02x", stsmSrvAuth->srvAuthData[pubKeySize + i]);
   printf("\n");
   */
 
   // Build the server's STSM authentication value, consisting of the concatenation of both actors'
   // ephemeral public DH keys "Yc||Ys", in the associated connection manager's secondary buffer
   writeMyEDHPubKey(&_cliConnMgr._secBuf[0]);
-  writeOtherEDHPubKey(&_cliConnMgr._secBuf[DH2048_PUBKEY_PEM_SIZE]);
+  writeOtherEDHPubKey(&_cliConnMgr._secBuf[pubKeySize]);
 
   // Decrypt the server's STSM authentication proof in the associated connection manager's secondary buffer
-  int decProofSize = AES_128_CBC_Decrypt(_cliConnMgr._skey, _cliConnMgr._iv, stsmSrvAuth->srvSTSMAuthProof,
-                                         STSM_AUTH_PROOF_SIZE, &_cliConnMgr._secBuf[2 * DH2048_PUBKEY_PEM_SIZE]);
+  int decProofSize = AES_128_CBC_Decrypt(_cliConnMgr._skey, _cliConnMgr._iv, &stsmSrvAuth->srvAuthData[pubKeySize],
+                                         (int)srvProofSize, &_cliConnMgr._secBuf[2 * pubKeySize]);
+
+  // Retrieve the server's long-term public key from its certificate
+  srvPubKey = X509_get0_pubkey(srvCert);
 
-  // Assert the decrypted STSM authentication proof to be on RSA2048_SIG_SIZE = 256 bytes
-  if(decProofSize != 256)
+  // Assert the decrypted STSM authentication proof to be of the signature size of the
+  // server's long-term key type (RSA2048_SIG_SIZE = 256 or ED25519_SIG_SIZE = 64 bytes)
+  if(srvPubKey == nullptr || decProofSize != EVP_PKEY_get_size(srvPubKey))
    sendCliSTSMErrMsg(ERR_MALFORMED_MESSAGE,"Decrypted server's STSM authentication proof of invalid size");
 
   /*
   // LOG: Server's signed STSM authentication value
   printf("Server signed STSM authentication value: \n");
-  for(int i=0; i < RSA2048_SIG_SIZE; i++)
-   printf("%02x", _cliConnMgr._secBuf[2 * DH2048_PUBKEY_PEM_SIZE + i]);
+  for(int i=0; i < decProofSize; i++)
+   printf("%02x", _cliConnMgr._secBuf[2 * pubKeySize + i]);
   printf("\n");
   */
 
   // Attempt to verify the server's signature on its STSM authentication value <Yc||Ys>s
   try
-   { digSigVerify(X509_get_pubkey(srvCert), &_cliConnMgr._secBuf[0], 2 * DH2048_PUBKEY_PEM_SIZE,
-                  &_cliConnMgr._secBuf[2 * DH2048_PUBKEY_PEM_SIZE], RSA2048_SIG_SIZE); }
+   { digSigVerify(srvPubKey, &_cliConnMgr._secBuf[0], 2 * pubKeySize,
+                  &_cliConnMgr._secBuf[2 * pubKeySize], decProofSize); }
   catch(execErrExcp& digVerExcp)
    {
     // If the signature verification failed, inform the server that they
@@ -512,13 +625,14 @@ void CliSTSMMgr::recv_srv_auth()
  *            1) The client's name \n\n
  *            2) The client's STSM authentication proof, consisting of the concatenation
  *               of its name and both actors' ephemeral public DH keys (STSM authentication
- *               value) signed with the client's long-term private RSA key and encrypted
+ *               value) signed with the client's long-term private key and encrypted
  *               with the resulting shared session key "{<name||Yc||Ys>s}k"
  * @throws ERR_STSM_MY_PUBKEY_MISSING           The client's ephemeral DH public key is missing
  * @throws ERR_STSM_OTHER_PUBKEY_MISSING        The server's ephemeral DH public key is missing
  * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
  * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write an actor's ephemeral DH public key into a BIO
  * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read an actor's ephemeral DH public key from a BIO
+ * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write an actor's ephemeral X25519 public key
  * @throws ERR_OSSL_EVP_MD_CTX_NEW              EVP_MD context creation failed
  * @throws ERR_OSSL_EVP_SIGN_INIT               EVP_MD signing initialization failed
  * @throws ERR_OSSL_EVP_SIGN_UPDATE             EVP_MD signing update failed
@@ -540,6 +654,13 @@ void CliSTSMMgr::send_cli_auth()
   const char* cliName = _cliConnMgr._name->c_str();
   const size_t cliNameLen = strlen(cliName);
 
+  // The size of an ephemeral public key in the STSM suite used
+  unsigned int pubKeySize = EDHPubKeySize();
+
+  // The sizes of the client's signed STSM authentication value and proof
+  unsigned int cliSigSize;
+  int          cliProofSize;
+
   /* ---------------------------- Client's Name ---------------------------- */
 
   // Copy the client's name to the 'CLI_AUTH' message
@@ -552,42 +673,38 @@ void CliSTSMMgr::send_cli_auth()
   // "name||Yc||Ys", in the associated connection manager's secondary buffer
   strcpy(reinterpret_cast<char*>(&_cliConnMgr._secBuf), cliName);
   writeMyEDHPubKey(&_cliConnMgr._secBuf[cliNameLen + 1]);
-  writeOtherEDHPubKey(&_cliConnMgr._secBuf[cliNameLen + 1 + DH2048_PUBKEY_PEM_SIZE]);
+  writeOtherEDHPubKey(&_cliConnMgr._secBuf[cliNameLen + 1 + pubKeySize]);
 
-  /*
-   * Sign the client's STSM authentication value using the client's long-term private RSA key
-   *
-   * NOTE: As the client's private RSA key is on 2048 bit, the resulting
-   *       signature has an implicit size of 2048 bits = 256 bytes
-   */
-  digSigSign(_myRSALongPrivKey, &_cliConnMgr._secBuf[0],cliNameLen + 1 + (2 * DH2048_PUBKEY_PEM_SIZE),
-             &_cliConnMgr._secBuf[cliNameLen + 1 + (2 * DH2048_PUBKEY_PEM_SIZE)]);
+  // Sign the client's STSM authentication value using the client's long-term private key, whose
+  // signature size depends on its type (RSA2048_SIG_SIZE or ED25519_SIG_SIZE bytes)
+  cliSigSize = digSigSign(_myLongPrivKey, &_cliConnMgr._secBuf[0],cliNameLen + 1 + (2 * pubKeySize),
+                          &_cliConnMgr._secBuf[cliNameLen + 1 + (2 * pubKeySize)]);
 
   /*
   // LOG: Client's signed STSM authentication value
   printf("Client signed STSM authentication value: \n");
-  for(int i=0; i < RSA2048_SIG_SIZE; i++)
-   printf("%02x", _cliConnMgr._secBuf[cliNameLen + 1 + (2 * DH2048_PUBKEY_PEM_SIZE) + i]);
+  for(int i=0; i < cliSigSize; i++)
+   printf("%02x", _cliConnMgr._secBuf[cliNameLen + 1 + (2 * pubKeySize) + i]);
   printf("\n");
   */
 
   /*
-   * Encrypt the signed STSM authentication value as the server
-   * STSM authentication proof in the 'SRV_AUTH' message
+   * Encrypt the signed STSM authentication value as the client
+   * STSM authentication proof in the 'CLI_AUTH' message
    *
-   * NOTE: Being the size of the signed STSM authentication value of 256 bytes an
-   *       integer multiple of the AES block size, its encryption will always add
-   *       a full padding block of 128 bits = 16 bytes, for an implicit size of
-   *       the  resulting STSM  authentication proof of 256 + 16 = 272 bytes
+   * NOTE: Being the size of both RSA-2048 and Ed25519 signatures an integer
+   *       multiple of the AES block size, their encryption will always add a
+   *       full padding block of 128 bits = 16 bytes, for a size of the resulting
+   *       STSM authentication proof of respectively 272 and 80 bytes
    */
-  AES_128_CBC_Encrypt(_cliConnMgr._skey, _cliConnMgr._iv,
-                      &_cliConnMgr._secBuf[cliNameLen + 1 + (2 * DH2048_PUBKEY_PEM_SIZE)],
-                      RSA2048_SIG_SIZE, stsmCliAuth->cliSTSMAuthProof);
+  cliProofSize = AES_128_CBC_Encrypt(_cliConnMgr._skey, _cliConnMgr._iv,
+                                     &_cliConnMgr._secBuf[cliNameLen + 1 + (2 * pubKeySize)],
+                                     (int)cliSigSize, stsmCliAuth->cliSTSMAuthProof);
 
   /* ------------------ Message Finalization and Sending ------------------ */
 
   // Initialize the 'CLI_AUTH' message length and type
-  stsmCliAuth->header.len = sizeof(STSM_CLI_AUTH_MSG);
+  stsmCliAuth->header.len = sizeof(STSM_CLI_AUTH_MSG) + cliProofSize;
   stsmCliAuth->header.type = CLI_AUTH;
 
   // Send the 'CLI_AUTH' message to the server
@@ -604,7 +721,7 @@ void CliSTSMMgr::send_cli_auth()
   printf("\n");
 
   printf("Client's STSM authentication proof:\n");
-  for(int i=0; i < STSM_AUTH_PROOF_SIZE ; i++)
+  for(int i=0; i < cliProofSize ; i++)
    printf("%02x", stsmCliAuth->cliSTSMAuthProof[i]);
   printf("\n");
   */
@@ -613,23 +730,280 @@ void CliSTSMMgr::send_cli_auth()
 
 /* ---------------------------- 'SRV_OK' Message (4/4) ---------------------------- */
 
-/*
- * A dedicated method for parsing a received 'SRV_OK' message
- * is not required, as all its associated checks are already
- * performed within the recvCheckCliSTSMMsg() function)
+/**
+ * @brief  Parses the server's 'SRV_OK' STSM message (4/4), whose contents have already been validated
+ *         in the recvCheckCliSTSMMsg() function, storing the resumption ticket issued by the server
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+ */
+void CliSTSMMgr::recv_srv_ok()
+ {
+  // Interpret the associated connection manager's
+  // primary connection buffer as a 'SRV_OK' message
+  STSM_SRV_OK_MSG* stsmSrvOK = reinterpret_cast<STSM_SRV_OK_MSG*>(_cliConnMgr._priBuf);
+
+  // Derive the resumption PSK of the session key and store the
+  // resumption ticket issued by the server for future connections
+  deriveLabeledKey(_cliConnMgr._skey, STSM_RES_PSK_LABEL, _resPSK);
+  storeResTicket(stsmSrvOK->ticket, stsmSrvOK->ticketLifetime);
+
+  LOG_DEBUG("STSM 4/4: Received 'SRV_OK' message, STSM protocol completed (session cipher: "
+            + AEAD_CipherToStr(_cliConnMgr._aeadCipher) + ")")
+ }
+
+
+/* ------------------------- Resumption Tickets Utilities ------------------------- */
+
+/**
+ * @brief Stores a resumption ticket issued by the server along with the resumption
+ *        PSK derived from the current session key, or invalidates the client's
+ *        resumption ticket if the server has not issued one
+ * @param ticket         The resumption ticket issued by the server
+ * @param ticketLifetime The ticket's remaining lifetime in seconds (0 = no ticket issued)
+ */
+void CliSTSMMgr::storeResTicket(STSMTicket& ticket, uint32_t ticketLifetime)
+ {
+  // If the server has not issued a ticket (resumption tickets disabled
+  // or client's tickets expired), invalidate the client's resumption ticket
+  if(ticketLifetime == 0)
+   {
+    invalidateResTicket();
+    return;
+   }
+
+  // Store the resumption ticket along with its resumption PSK and expiration time
+  _resTicket->ticket = ticket;
+  memcpy(&_resTicket->psk[0], &_resPSK[0], STSM_RES_PSK_SIZE);
+  _resTicket->expTime = time(NULL) + ticketLifetime;
+  _resTicket->valid = true;
+ }
+
+
+/**
+ * @brief Invalidates and safely deletes the client's resumption ticket
+ */
+void CliSTSMMgr::invalidateResTicket()
+ {
+  OPENSSL_cleanse(_resTicket, sizeof(CliResTicket));
+  _resTicket->valid = false;
+ }
+
+
+/* --------------------- 'CLI_RESUME_HELLO' Message (1/2) --------------------- */
+
+/**
+ * @brief  Sends the 'CLI_RESUME_HELLO' STSM message to the SafeCloud server (1/2), consisting of:\n\n
+ *             1) The initial random IV to be used in the secure communication\n\n
+ *             2) The optional features supported by the client\n\n
+ *             3) The AEAD ciphers supported by the client in decreasing order of preference\n\n
+ *             4) The STSM suite chosen by the client (STSM_CLI_SUITE)\n\n
+ *             5) The client's resumption ticket\n\n
+ *             6) The client's binder, consisting of the HMAC of the message (binder excluded)
+ *                with the binder key of the ticket's resumption PSK\n\n
+ *             7) The client's ephemeral public key "Yc" of such suite
+ * @throws ERR_OSSL_EVP_PKEY_NEW                EVP_PKEY struct creation failed
+ * @throws ERR_OSSL_EVP_PKEY_ASSIGN             EVP_PKEY struct assignment failure
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW            EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT        EVP_PKEY key generation initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN             EVP_PKEY Key generation failed
+ * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
+ * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the client's ephemeral DH public key into the BIO
+ * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read the client's ephemeral DH public key from the BIO
+ * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write the client's ephemeral X25519 public key
+ * @throws ERR_OSSL_RAND_POLL_FAILED            RAND_poll() IV seed generation failed
+ * @throws ERR_OSSL_RAND_BYTES_FAILED           RAND_bytes() IV bytes generation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT        Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE             Key derivation failed
+ * @throws ERR_OSSL_HMAC_FAILED                 HMAC computation failed
  */
+void CliSTSMMgr::send_cli_resume_hello()
+ {
+  // Interpret the associated connection manager's primary
+  // connection buffer as a 'CLI_RESUME_HELLO' STSM message
+  STSM_CLI_RESUME_HELLO_MSG* cliResHelloMsg = reinterpret_cast<STSM_CLI_RESUME_HELLO_MSG*>(_cliConnMgr._priBuf);
+
+  // The size in bytes of the 'CLI_RESUME_HELLO' message's portion preceding the client's binder
+  size_t binderOffset = cliResHelloMsg->cliBinder - _cliConnMgr._priBuf;
+
+  // The binder key derived from the ticket's resumption PSK
+  unsigned char binderKey[STSM_RES_PSK_SIZE];
+
+  /* ----------------------------- STSM Suite ----------------------------- */
+
+  // Set the STSM suite chosen by the client and generate its ephemeral key pair accordingly
+  _stsmSuite = STSM_CLI_SUITE;
+  EDHKeygen();
+
+  // Notify the server of the STSM suite chosen by the client
+  cliResHelloMsg->cliSuite = _stsmSuite;
+
+  /* ------------------------ STSM Message Header ------------------------ */
+
+  // Initialize the STSM message length and type
+  cliResHelloMsg->header.len = sizeof(STSM_CLI_RESUME_HELLO_MSG) + EDHPubKeySize();
+  cliResHelloMsg->header.type = CLI_RESUME_HELLO;
+
+  /* ------------------ Client's ephemeral DH public key ------------------ */
+
+  // Write the client's ephemeral DH public key into the 'CLI_RESUME_HELLO' message
+  writeMyEDHPubKey(cliResHelloMsg->cliEDHPubKey);
+
+  /* ----------------------------- Random IV ----------------------------- */
+
+  // Generate a random AES_GCM_128 IV for the connection
+  _cliConnMgr._iv = new IV();
+
+  // Copy the generated IV into the 'CLI_RESUME_HELLO' message
+  cliResHelloMsg->iv = *_cliConnMgr._iv;
+
+  /* ------------------------- Supported Features ------------------------- */
+
+  // Offer the server all the optional features supported by the client
+  cliResHelloMsg->cliFeatures = STSM_SUPPORTED_FEATURES;
+
+  // Offer the server the AEAD ciphers supported by the client, in
+  // decreasing order of preference depending on its CPU features
+  AEAD_GetCipherPrefs(cliResHelloMsg->cliCiphers);
+
+  /* ------------------- Resumption Ticket and Binder ------------------- */
+
+  // Copy the client's resumption ticket into the 'CLI_RESUME_HELLO' message
+  cliResHelloMsg->ticket = _resTicket->ticket;
+
+  // Build the client's binder input, consisting of the concatenation of the 'CLI_RESUME_HELLO'
+  // message's portion preceding the binder and of the client's ephemeral public key "Yc",
+  // in the associated connection manager's secondary buffer
+  memcpy(&_cliConnMgr._secBuf[0], _cliConnMgr._priBuf, binderOffset);
+  memcpy(&_cliConnMgr._secBuf[binderOffset], cliResHelloMsg->cliEDHPubKey, EDHPubKeySize());
+
+  // Compute the client's binder with the binder key of the ticket's resumption PSK,
+  // retaining it for the verification of the server's finished value
+  deriveLabeledKey(_resTicket->psk, STSM_RES_BINDER_LABEL, binderKey);
+  computeResMAC(binderKey, &_cliConnMgr._secBuf[0], binderOffset + EDHPubKeySize(), cliResHelloMsg->cliBinder);
+  memcpy(&_cliBinder[0], cliResHelloMsg->cliBinder, STSM_RES_MAC_SIZE);
+  OPENSSL_cleanse(&binderKey[0], STSM_RES_PSK_SIZE);
+
+  /* -------------------------- Message Sending -------------------------- */
+
+  // Send the 'CLI_RESUME_HELLO' message to the server
+  _cliConnMgr.sendMsg();
+
+  LOG_DEBUG("STSM 1/2: Sent 'CLI_RESUME_HELLO' message, awaiting server 'SRV_RESUME_OK' message")
+ }
+
+
+/* ----------------------- 'SRV_RESUME_OK' Message (2/2) ----------------------- */
+
+/**
+ * @brief  Parses the server's 'SRV_RESUME_OK' STSM message (2/2), deriving the session key
+ *         from the ticket's resumption PSK and both actors' ephemeral keys and verifying
+ *         the server's finished value, consisting of the HMAC of the client's binder and
+ *         of the message (finished value excluded) with the session key's finished key
+ * @throws ERR_STSM_MALFORMED_MESSAGE           Message length not matching the server's ephemeral public key size
+ * @throws ERR_STSM_CLI_SRV_INVALID_PUBKEY      The server provided an invalid ephemeral public key
+ * @throws ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY     Failed to rebuild the server's raw X25519 public key
+ * @throws ERR_STSM_MY_PUBKEY_MISSING           The client's ephemeral DH public key is missing
+ * @throws ERR_STSM_OTHER_PUBKEY_MISSING        The server's ephemeral DH public key is missing
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW            EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT        Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE             Key derivation failed
+ * @throws ERR_OSSL_EVP_MD_CTX_NEW              EVP_MD context creation failed
+ * @throws ERR_OSSL_EVP_DIGEST_INIT             EVP_MD digest initialization failed
+ * @throws ERR_OSSL_EVP_DIGEST_UPDATE           EVP_MD digest update failed
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL            EVP_MD digest final failed
+ * @throws ERR_OSSL_HMAC_FAILED                 HMAC computation failed
+ * @throws ERR_STSM_CLI_SRV_AUTH_FAILED         Invalid server's finished value
+ */
+void CliSTSMMgr::recv_srv_resume_ok()
+ {
+  // Interpret the associated connection manager's
+  // primary connection buffer as a 'SRV_RESUME_OK' message
+  STSM_SRV_RESUME_OK_MSG* stsmSrvResOK = reinterpret_cast<STSM_SRV_RESUME_OK_MSG*>(_cliConnMgr._priBuf);
+
+  // The size of an ephemeral public key in the STSM suite used
+  unsigned int pubKeySize = EDHPubKeySize();
+
+  // The size in bytes of the 'SRV_RESUME_OK' message's portion preceding the server's finished value
+  size_t finishedOffset = stsmSrvResOK->srvFinished - _cliConnMgr._priBuf;
+
+  // The finished key derived from the session key and the expected server's finished value
+  unsigned char finishedKey[STSM_RES_PSK_SIZE];
+  unsigned char expFinished[STSM_RES_MAC_SIZE];
+
+  // Ensure the message length to match the size of the
+  // server's ephemeral public key in the STSM suite used
+  if(stsmSrvResOK->header.len != sizeof(STSM_SRV_RESUME_OK_MSG) + pubKeySize)
+   THROW_EXEC_EXCP(ERR_STSM_MALFORMED_MESSAGE, "'SRV_RESUME_OK' message of unexpected length");
+
+  /* ------------------ Server's ephemeral DH public key ------------------ */
+
+  // Read the server's ephemeral public key from the 'SRV_RESUME_OK' message
+  readOtherEDHPubKey(stsmSrvResOK->srvEDHPubKey);
+
+  // Ensure the server's ephemeral DH public key to be valid
+  if(_otherDHEPubKey == nullptr)
+   THROW_EXEC_EXCP(ERR_STSM_CLI_SRV_INVALID_PUBKEY, OSSL_ERR_DESC);
+
+  /* ---------------------------- Session Key ---------------------------- */
+
+  // Derive the shared session key from the ticket's resumption PSK
+  // and from the client's private and server's public ephemeral keys
+  deriveSessKey(_cliConnMgr._skey, _resTicket->psk);
+
+  /* ----------------------- Server's Finished Value ----------------------- */
+
+  // Build the server's finished value input, consisting of the concatenation of the client's binder,
+  // the 'SRV_RESUME_OK' message's portion preceding the finished value and the server's ephemeral
+  // public key "Ys", in the associated connection manager's secondary buffer
+  memcpy(&_cliConnMgr._secBuf[0], &_cliBinder[0], STSM_RES_MAC_SIZE);
+  memcpy(&_cliConnMgr._secBuf[STSM_RES_MAC_SIZE], _cliConnMgr._priBuf, finishedOffset);
+  memcpy(&_cliConnMgr._secBuf[STSM_RES_MAC_SIZE + finishedOffset], stsmSrvResOK->srvEDHPubKey, pubKeySize);
+
+  // Compute the expected server's finished value with the session key's finished key
+  deriveLabeledKey(_cliConnMgr._skey, STSM_RES_FINISHED_LABEL, finishedKey);
+  computeResMAC(finishedKey, &_cliConnMgr._secBuf[0], STSM_RES_MAC_SIZE + finishedOffset + pubKeySize, expFinished);
+  OPENSSL_cleanse(&finishedKey[0], STSM_RES_PSK_SIZE);
+
+  // Verify the server's finished value in constant time, which proves that the server could open
+  // the client's resumption ticket and derived the same session key (no notification is returned
+  // to the server, as it has already determined the STSM protocol as completed)
+  if(CRYPTO_memcmp(expFinished, stsmSrvResOK->srvFinished, STSM_RES_MAC_SIZE) != 0)
+   THROW_EXEC_EXCP(ERR_STSM_CLI_SRV_AUTH_FAILED, "Invalid resumption finished value");
+
+  /* ------------------ Connection Parameters and Ticket ------------------ */
+
+  // Enable the optional features that were agreed with the server
+  // and set the AEAD cipher selected for the session phase of the connection
+  _cliConnMgr._compress = (stsmSrvResOK->srvFeatures & STSM_FEATURE_COMPRESSION) != 0;
+  _cliConnMgr._largeFiles = (stsmSrvResOK->srvFeatures & STSM_FEATURE_LARGE_FILES) != 0;
+  _cliConnMgr._resumeUploads = (stsmSrvResOK->srvFeatures & STSM_FEATURE_RESUMABLE_UPLOADS) != 0;
+  _cliConnMgr._rangedDownloads = (stsmSrvResOK->srvFeatures & STSM_FEATURE_RANGED_DOWNLOADS) != 0;
+  _cliConnMgr._dedupUploads = (stsmSrvResOK->srvFeatures & STSM_FEATURE_DEDUP_UPLOADS) != 0;
+  _cliConnMgr._deltaUploads = (stsmSrvResOK->srvFeatures & STSM_FEATURE_DELTA_UPLOADS) != 0;
+  _cliConnMgr._aeadCipher = (AEADCipher)stsmSrvResOK->srvCipher;
+
+  // Derive the resumption PSK of the new session key and store the new resumption ticket
+  deriveLabeledKey(_cliConnMgr._skey, STSM_RES_PSK_LABEL, _resPSK);
+  storeResTicket(stsmSrvResOK->ticket, stsmSrvResOK->ticketLifetime);
+
+  LOG_DEBUG("STSM 2/2: Received 'SRV_RESUME_OK' message, STSM protocol completed (session cipher: "
+            + AEAD_CipherToStr(_cliConnMgr._aeadCipher) + ")")
+ }
 
 
 /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
 /**
- * @brief                  CliSTSMMgr object constructor
- * @param myRSALongPrivKey The client's long-term RSA key pair
- * @param cliConnMgr       The parent CliConnMgr instance managing this object
- * @param cliStore         The client's X.509 certificates store
+ * @brief               CliSTSMMgr object constructor
+ * @param myLongPrivKey The client's long-term key pair (RSA-2048 or Ed25519)
+ * @param cliConnMgr    The parent CliConnMgr instance managing this object
+ * @param cliStore      The client's X.509 certificates store
+ * @param resTicket     The client's resumption ticket
  */
-CliSTSMMgr::CliSTSMMgr(EVP_PKEY* myRSALongPrivKey, CliConnMgr& cliConnMgr, X509_STORE* cliStore)
-                      : STSMMgr(myRSALongPrivKey), _stsmCliState(INIT), _cliConnMgr(cliConnMgr), _cliStore(cliStore)
+CliSTSMMgr::CliSTSMMgr(EVP_PKEY* myLongPrivKey, CliConnMgr& cliConnMgr, X509_STORE* cliStore, CliResTicket* resTicket)
+                      : STSMMgr(myLongPrivKey), _stsmCliState(INIT), _cliConnMgr(cliConnMgr), _cliStore(cliStore),
+                        _resTicket(resTicket), _cliBinder()
  {}
 
 
@@ -637,18 +1011,61 @@ CliSTSMMgr::CliSTSMMgr(EVP_PKEY* myRSALongPrivKey, CliConnMgr& cliConnMgr, X509_
 
 /**
  * @brief  Starts the STSM client protocol, exchanging STSM messages with
- *         the SafeCloud server so to establish a shared AES_128 session key
- *         and IV and to authenticate the client and server with one another
+ *         the SafeCloud server so to establish a shared session key
+ *         and IV and to authenticate the client and server with one another,
+ *         first attempting to resume the client's authentication within an
+ *         abbreviated STSM execution if it holds a valid resumption ticket
+ * @param  earlyReq Whether the client's first session request should be sent along with its 'CLI_AUTH'
+ *                  message, returning without awaiting the server's 'SRV_OK' message, which must
+ *                  then be received via the finishCliSTSM() method before any session message
+ * @return Whether the STSM protocol has completed, i.e. 'false' if the server's 'SRV_OK' message is pending
  * @throws All the STSM exceptions and most of the OpenSSL
  *         exceptions (see "execErrCode.h" for more details)
  */
-void CliSTSMMgr::startCliSTSM()
+bool CliSTSMMgr::startCliSTSM(bool earlyReq)
  {
   // Ensure that the STSM client protocol has
   // not already been started by this manager
   if(_stsmCliState != INIT)
    THROW_EXEC_EXCP(ERR_STSM_CLI_ALREADY_STARTED);
 
+  // If the client holds an unexpired resumption ticket, attempt
+  // to resume its authentication in an abbreviated STSM execution
+  if(_resTicket->valid && time(NULL) < _resTicket->expTime)
+   {
+    // Send the 'CLI_RESUME_HELLO' STSM message to the SafeCloud server (1/2)
+    send_cli_resume_hello();
+
+    // Update the STSM client state
+    _stsmCliState = WAITING_SRV_RESUME;
+
+    // Block until the expected 'SRV_RESUME_OK' or 'SRV_RESUME_REJECTED' STSM message has been received
+    recvCheckCliSTSMMsg();
+
+    // If the server accepted the ticket, parse its 'SRV_RESUME_OK' STSM message (2/2)
+    // and return control to the associated connection manager to switch the connection
+    // into the session phase (as the abbreviated STSM execution already takes a single
+    // round-trip, the client's first session request is not sent along with it)
+    if(reinterpret_cast<STSMMsg*>(_cliConnMgr._priBuf)->header.type == SRV_RESUME_OK)
+     {
+      recv_srv_resume_ok();
+      return true;
+     }
+
+    LOG_DEBUG("STSM 2/2: Resumption ticket rejected by the server, falling back to a full STSM execution")
+
+    // Otherwise invalidate the client's resumption ticket and discard
+    // the client's ephemeral key pair and IV sent with it, continuing
+    // with a full STSM execution on the same connection
+    invalidateResTicket();
+    EVP_PKEY_free(_myDHEKey);
+    _myDHEKey = nullptr;
+    delete _cliConnMgr._iv;
+    _cliConnMgr._iv = nullptr;
+   }
+  else
+   invalidateResTicket();
+
   // Send the 'CLIENT_HELLO' STSM message to the SafeCloud server (1/4)
   send_client_hello();
 
@@ -661,23 +1078,64 @@ void CliSTSMMgr::startCliSTSM()
   // Parse the server's 'SRV_AUTH' STSM message (2/4)
   recv_srv_auth();
 
+  // If the client's first session request should be sent along with its 'CLI_AUTH'
+  // message, cork the connection socket so that the kernel coalesces them in the
+  // same TCP segments (the socket being uncorked in the finishCliSTSM() method)
+  if(earlyReq)
+   _cliConnMgr.setSockCork(true);
+
   // Send the 'CLI_AUTH' STSM message to the SafeCloud server (3/4)
   send_cli_auth();
 
   // Update the STSM client state
   _stsmCliState = WAITING_SRV_OK;
 
-  // Block until the expected 'SRV_OK' STSM message has been received
-  recvCheckCliSTSMMsg();
+  // If the client's first session request should be sent along with its 'CLI_AUTH'
+  // message, return control to the associated connection manager without awaiting
+  // the server's 'SRV_OK' message, which the SafeCloud server sends immediately before
+  // its response to such request and that must so be received before it
+  if(earlyReq)
+   return false;
 
-  /*
-   * NOTE: Explicitly parsing the 'SRV_OK' message is not required,
-   *       as its contents are already validated within the
-   *       recvCheckCliSTSMMsg() function
-   */
-
-  LOG_DEBUG("STSM 4/4: Received 'SRV_OK' message, STSM protocol completed")
+  // Otherwise block until the server's 'SRV_OK' message has been received and parsed
+  finishCliSTSM();
 
   // Return control to the associated connection manager
   // to switch the connection into the session phase
+  return true;
+ }
+
+
+/**
+ * @brief  Completes a STSM client protocol execution that returned after the client sent its 'CLI_AUTH'
+ *         message by uncorking the connection socket, so to flush the client's 'CLI_AUTH' message along
+ *         with its first session request, and blocking until the server's 'SRV_OK' message has been
+ *         received and parsed (4/4)
+ * @throws ERR_STSM_UNEXPECTED_MESSAGE       An out-of-order STSM message has been received
+ * @throws ERR_STSM_MALFORMED_MESSAGE        STSM message type and size mismatch
+ * @throws ERR_STSM_CLI_CLIENT_LOGIN_FAILED  The server did not recognize the client's username
+ * @throws ERR_STSM_CLI_CLI_AUTH_FAILED      The server reported the client failing the STSM authentication
+ * @throws ERR_STSM_CLI_UNEXPECTED_MESSAGE   The server reported to have received an out-of-order STSM message
+ * @throws ERR_STSM_CLI_MALFORMED_MESSAGE    The server reported to have received a malformed STSM message
+ * @throws ERR_STSM_CLI_UNKNOWN_STSMMSG_TYPE The server reported to have received an STSM message of unknown type
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW         EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT     Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE          Key derivation failed
+ */
+void CliSTSMMgr::finishCliSTSM()
+ {
+  // Ensure the client to be awaiting the server's 'SRV_OK' message
+  if(_stsmCliState != WAITING_SRV_OK)
+   THROW_EXEC_EXCP(ERR_STSM_UNEXPECTED_MESSAGE, "Attempting to complete the STSM protocol "
+                                                "without awaiting the 'SRV_OK' message");
+
+  // Uncork the connection socket, flushing the pending
+  // 'CLI_AUTH' message and first session request, if any
+  _cliConnMgr.setSockCork(false);
+
+  // Block until the expected 'SRV_OK' STSM message has been received
+  recvCheckCliSTSMMsg();
+
+  // Parse the server's 'SRV_OK' STSM message (4/4)
+  recv_srv_ok();
  }
\ No newline at end of file
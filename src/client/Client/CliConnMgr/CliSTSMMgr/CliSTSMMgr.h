@@ -6,6 +6,15 @@
 /* ================================== INCLUDES ================================== */
 #include "SafeCloudApp/ConnMgr/STSMMgr/STSMMgr.h"
 
+// A resumption ticket issued to the client along with its associated information
+struct CliResTicket
+ {
+  bool          valid;                   // Whether the client holds a resumption ticket
+  time_t        expTime;                 // The time in Unix epochs at which the ticket expires
+  STSMTicket    ticket;                  // The resumption ticket (opaque to the client)
+  unsigned char psk[STSM_RES_PSK_SIZE];  // The ticket's resumption PSK
+ };
+
 
 // Forward Declaration
 class CliConnMgr;
@@ -24,13 +33,19 @@ class CliSTSMMgr : public STSMMgr
      WAITING_SRV_AUTH,
 
      // The client has sent its 'auth' message and is awaiting the server 'ok' message
-     WAITING_SRV_OK
+     WAITING_SRV_OK,
+
+     // The client has sent its 'resume hello' message and is awaiting
+     // the server's 'resume ok' or 'resume rejected' message
+     WAITING_SRV_RESUME
     };
 
    /* ================================= ATTRIBUTES ================================= */
    enum STSMCliState _stsmCliState;  // Current client state in the STSM key exchange protocol
    CliConnMgr&       _cliConnMgr;    // The parent CliConnMgr instance managing this object
    X509_STORE*       _cliStore;      // The client's already-initialized X.509 certificate store used for validating the server's signature
+   CliResTicket*     _resTicket;     // The client's resumption ticket
+   unsigned char     _cliBinder[STSM_RES_MAC_SIZE];  // The client's binder sent in its 'resume hello' message
 
    /* =============================== PRIVATE METHODS =============================== */
 
@@ -75,11 +90,20 @@ class CliSTSMMgr : public STSMMgr
 
    /**
     * @brief  Sends the 'CLIENT_HELLO' STSM message to the SafeCloud server (1/4), consisting of:\n\n
-    *             1) The client's ephemeral DH public key "Yc"\n\n
-    *             2) The initial random IV to be used in the secure communication
+    *             1) The initial random IV to be used in the secure communication\n\n
+    *             2) The optional features supported by the client\n\n
+    *             3) The AEAD ciphers supported by the client in decreasing order of preference\n\n
+    *             4) The STSM suite chosen by the client (STSM_CLI_SUITE)\n\n
+    *             5) The client's ephemeral public key "Yc" of such suite
+    * @throws ERR_OSSL_EVP_PKEY_NEW                EVP_PKEY struct creation failed
+    * @throws ERR_OSSL_EVP_PKEY_ASSIGN             EVP_PKEY struct assignment failure
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW            EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT        EVP_PKEY key generation initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_KEYGEN             EVP_PKEY Key generation failed
     * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
     * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the client's ephemeral DH public key into the BIO
     * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read the client's ephemeral DH public key from the BIO
+    * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write the client's ephemeral X25519 public key
     * @throws ERR_OSSL_RAND_POLL_FAILED            RAND_poll() IV seed generation failed
     * @throws ERR_OSSL_RAND_BYTES_FAILED           RAND_bytes() IV bytes generation failed
     */
@@ -102,16 +126,22 @@ class CliSTSMMgr : public STSMMgr
 
    /**
     * @brief  Parses the server's 'SRV_AUTH' STSM message (2/4), consisting of:\n\n
-    *            1) The server's ephemeral DH public key "Ys"\n\n
-    *            2) The server's STSM authentication proof, consisting of the concatenation
+    *            1) The optional features and the AEAD cipher selected by the server
+    *               for the connection, which are adopted by the client\n\n
+    *            2) The server's ephemeral DH public key "Ys"\n\n
+    *            3) The server's STSM authentication proof, consisting of the concatenation
     *               of both actors' ephemeral public DH keys (STSM authentication value)
-    *               signed with the server's long-term private RSA key and encrypted with
+    *               signed with the server's long-term private key and encrypted with
     *               the resulting shared symmetric session key "{<Yc,Ys>s}k"\n\n
-    *            3) The server's certificate "srvCert"
+    *            4) The server's certificate "srvCert"
+    * @throws ERR_STSM_MALFORMED_MESSAGE           Message length not matching its contents' sizes
+    * @throws ERR_STSM_MALFORMED_MESSAGE           Features or AEAD cipher not offered by the client
     * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
     * @throws ERR_OSSL_EVP_PKEY_NEW                EVP_PKEY struct creation failed
     * @throws ERR_STSM_SRV_CLI_INVALID_PUBKEY      The server provided an invalid ephemeral DH public key
     * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the server' public key into the memory BIO
+    * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write an actor's raw X25519 public key
+    * @throws ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY     Failed to rebuild the client's raw X25519 public key
     * @throws ERR_STSM_CLI_SRV_CERT_REJECTED       The server's certificate is invalid
     * @throws ERR_OSSL_X509_STORE_CTX_NEW          X509_STORE context creation failed
     * @throws ERR_OSSL_X509_STORE_CTX_INIT         X509_STORE context initialization failed
@@ -139,13 +169,14 @@ class CliSTSMMgr : public STSMMgr
     *            1) The client's name \n\n
     *            2) The client's STSM authentication proof, consisting of the concatenation
     *               of its name and both actors' ephemeral public DH keys (STSM authentication
-    *               value) signed with the client's long-term private RSA key and encrypted
+    *               value) signed with the client's long-term private key and encrypted
     *               with the resulting shared session key "{<name||Yc||Ys>s}k"
     * @throws ERR_STSM_MY_PUBKEY_MISSING           The client's ephemeral DH public key is missing
     * @throws ERR_STSM_OTHER_PUBKEY_MISSING        The server's ephemeral DH public key is missing
     * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
     * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write an actor's ephemeral DH public key into a BIO
     * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read an actor's ephemeral DH public key from a BIO
+    * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write an actor's ephemeral X25519 public key
     * @throws ERR_OSSL_EVP_MD_CTX_NEW              EVP_MD context creation failed
     * @throws ERR_OSSL_EVP_SIGN_INIT               EVP_MD signing initialization failed
     * @throws ERR_OSSL_EVP_SIGN_UPDATE             EVP_MD signing update failed
@@ -161,23 +192,96 @@ class CliSTSMMgr : public STSMMgr
 
    /* ---------------------------- 'SRV_OK' Message (4/4) ---------------------------- */
 
-   /*
-    * A dedicated method for parsing a received 'SRV_OK' message
-    * is not required, as all its associated checks are already
-    * performed within the recvCheckCliSTSMMsg() function)
+   /**
+    * @brief  Parses the server's 'SRV_OK' STSM message (4/4), whose contents have already been validated
+    *         in the recvCheckCliSTSMMsg() function, storing the resumption ticket issued by the server
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+    */
+   void recv_srv_ok();
+
+   /* ------------------------- Resumption Tickets Utilities ------------------------- */
+
+   /**
+    * @brief Stores a resumption ticket issued by the server along with the resumption
+    *        PSK derived from the current session key, or invalidates the client's
+    *        resumption ticket if the server has not issued one
+    * @param ticket         The resumption ticket issued by the server
+    * @param ticketLifetime The ticket's remaining lifetime in seconds (0 = no ticket issued)
+    */
+   void storeResTicket(STSMTicket& ticket, uint32_t ticketLifetime);
+
+   /**
+    * @brief Invalidates and safely deletes the client's resumption ticket
+    */
+   void invalidateResTicket();
+
+   /* --------------------- 'CLI_RESUME_HELLO' Message (1/2) --------------------- */
+
+   /**
+    * @brief  Sends the 'CLI_RESUME_HELLO' STSM message to the SafeCloud server (1/2), consisting of:\n\n
+    *             1) The initial random IV to be used in the secure communication\n\n
+    *             2) The optional features supported by the client\n\n
+    *             3) The AEAD ciphers supported by the client in decreasing order of preference\n\n
+    *             4) The STSM suite chosen by the client (STSM_CLI_SUITE)\n\n
+    *             5) The client's resumption ticket\n\n
+    *             6) The client's binder, consisting of the HMAC of the message (binder excluded)
+    *                with the binder key of the ticket's resumption PSK\n\n
+    *             7) The client's ephemeral public key "Yc" of such suite
+    * @throws ERR_OSSL_EVP_PKEY_NEW                EVP_PKEY struct creation failed
+    * @throws ERR_OSSL_EVP_PKEY_ASSIGN             EVP_PKEY struct assignment failure
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW            EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT        EVP_PKEY key generation initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_KEYGEN             EVP_PKEY Key generation failed
+    * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
+    * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the client's ephemeral DH public key into the BIO
+    * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read the client's ephemeral DH public key from the BIO
+    * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write the client's ephemeral X25519 public key
+    * @throws ERR_OSSL_RAND_POLL_FAILED            RAND_poll() IV seed generation failed
+    * @throws ERR_OSSL_RAND_BYTES_FAILED           RAND_bytes() IV bytes generation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT        Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE             Key derivation failed
+    * @throws ERR_OSSL_HMAC_FAILED                 HMAC computation failed
+    */
+   void send_cli_resume_hello();
+
+   /* ----------------------- 'SRV_RESUME_OK' Message (2/2) ----------------------- */
+
+   /**
+    * @brief  Parses the server's 'SRV_RESUME_OK' STSM message (2/2), deriving the session key
+    *         from the ticket's resumption PSK and both actors' ephemeral keys and verifying
+    *         the server's finished value, consisting of the HMAC of the client's binder and
+    *         of the message (finished value excluded) with the session key's finished key
+    * @throws ERR_STSM_MALFORMED_MESSAGE           Message length not matching the server's ephemeral public key size
+    * @throws ERR_STSM_CLI_SRV_INVALID_PUBKEY      The server provided an invalid ephemeral public key
+    * @throws ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY     Failed to rebuild the server's raw X25519 public key
+    * @throws ERR_STSM_MY_PUBKEY_MISSING           The client's ephemeral DH public key is missing
+    * @throws ERR_STSM_OTHER_PUBKEY_MISSING        The server's ephemeral DH public key is missing
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW            EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT        Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE             Key derivation failed
+    * @throws ERR_OSSL_EVP_MD_CTX_NEW              EVP_MD context creation failed
+    * @throws ERR_OSSL_EVP_DIGEST_INIT             EVP_MD digest initialization failed
+    * @throws ERR_OSSL_EVP_DIGEST_UPDATE           EVP_MD digest update failed
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL            EVP_MD digest final failed
+    * @throws ERR_OSSL_HMAC_FAILED                 HMAC computation failed
+    * @throws ERR_STSM_CLI_SRV_AUTH_FAILED         Invalid server's finished value
     */
+   void recv_srv_resume_ok();
 
   public:
 
    /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
    /**
-    * @brief                  CliSTSMMgr object constructor
-    * @param myRSALongPrivKey The client's long-term RSA key pair
-    * @param cliConnMgr       A reference to the parent CliConnMgr object
-    * @param cliStore         The client's X.509 certificates store
+    * @brief               CliSTSMMgr object constructor
+    * @param myLongPrivKey The client's long-term key pair (RSA-2048 or Ed25519)
+    * @param cliConnMgr    The parent CliConnMgr instance managing this object
+    * @param cliStore      The client's X.509 certificates store
+    * @param resTicket     The client's resumption ticket
     */
-   CliSTSMMgr(EVP_PKEY* myRSALongPrivKey, CliConnMgr& cliConnMgr, X509_STORE* cliStore);
+   CliSTSMMgr(EVP_PKEY* myLongPrivKey, CliConnMgr& cliConnMgr, X509_STORE* cliStore, CliResTicket* resTicket);
 
 
    /* Same destructor of the STSMMgr base class */
@@ -187,12 +291,36 @@ class CliSTSMMgr : public STSMMgr
 
    /**
     * @brief  Starts the STSM client protocol, exchanging STSM messages with
-    *         the SafeCloud server so to establish a shared AES_128 session key
-    *         and IV and to authenticate the client and server with one another
+    *         the SafeCloud server so to establish a shared session key
+    *         and IV and to authenticate the client and server with one another,
+    *         first attempting to resume the client's authentication within an
+    *         abbreviated STSM execution if it holds a valid resumption ticket
+    * @param  earlyReq Whether the client's first session request should be sent along with its 'CLI_AUTH'
+    *                  message, returning without awaiting the server's 'SRV_OK' message, which must
+    *                  then be received via the finishCliSTSM() method before any session message
+    * @return Whether the STSM protocol has completed, i.e. 'false' if the server's 'SRV_OK' message is pending
     * @throws All the STSM exceptions and most of the OpenSSL
     *         exceptions (see "execErrCode.h" for more details)
     */
-   void startCliSTSM();
+   bool startCliSTSM(bool earlyReq);
+
+   /**
+    * @brief  Completes a STSM client protocol execution that returned after the client sent its 'CLI_AUTH'
+    *         message by uncorking the connection socket, so to flush the client's 'CLI_AUTH' message along
+    *         with its first session request, and blocking until the server's 'SRV_OK' message has been
+    *         received and parsed (4/4)
+    * @throws ERR_STSM_UNEXPECTED_MESSAGE       An out-of-order STSM message has been received
+    * @throws ERR_STSM_MALFORMED_MESSAGE        STSM message type and size mismatch
+    * @throws ERR_STSM_CLI_CLIENT_LOGIN_FAILED  The server did not recognize the client's username
+    * @throws ERR_STSM_CLI_CLI_AUTH_FAILED      The server reported the client failing the STSM authentication
+    * @throws ERR_STSM_CLI_UNEXPECTED_MESSAGE   The server reported to have received an out-of-order STSM message
+    * @throws ERR_STSM_CLI_MALFORMED_MESSAGE    The server reported to have received a malformed STSM message
+    * @throws ERR_STSM_CLI_UNKNOWN_STSMMSG_TYPE The server reported to have received an STSM message of unknown type
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW         EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT     Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE          Key derivation failed
+    */
+   void finishCliSTSM();
  };
 
 
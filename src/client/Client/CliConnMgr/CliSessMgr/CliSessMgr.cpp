@@ -4,9 +4,18 @@
 
 // System Headers
 #include <cstring>
+#include <algorithm>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <openssl/evp.h>
 
 // SafeCloud Headers
 #include "CliSessMgr.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/SessStream/SessStream.h"
 #include "errCodes/sessErrCodes/sessErrCodes.h"
 #include "errCodes/execErrCodes/execErrCodes.h"
 #include "sanUtils.h"
@@ -28,6 +37,7 @@
  * @throws ERR_SESS_UNEXPECTED_MESSAGE   The session manager received a session message
  *                                       invalid for its current operation or step
  * @throws ERR_SESS_MALFORMED_MESSAGE    The session manager received a malformed session message
+ * @throws ERR_SESS_NO_SPACE             Not enough storage space for the file to be received
  * @throws ERR_SESS_UNKNOWN_SESSMSG_TYPE The session manager received a session message of unknown type
  * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
@@ -70,6 +80,13 @@ void CliSessMgr::sendCliSessSignalMsg(SessMsgType sessMsgSignalingType, const st
      else
       THROW_SESS_EXCP(ERR_SESS_MALFORMED_MESSAGE, abortedOpToStr());
 
+    // Not enough storage space is available for the file to be received
+    case ERR_NO_SPACE:
+     if(!errReason.empty())
+      THROW_SESS_EXCP(ERR_SESS_NO_SPACE, abortedOpToStr(), errReason);
+     else
+      THROW_SESS_EXCP(ERR_SESS_NO_SPACE, abortedOpToStr());
+
     // A session message of unknown type was received, an error to be attributed to a desynchronization
     // between the client and server IVs and that requires the connection to be reset
     case ERR_UNKNOWN_SESSMSG_TYPE:
@@ -87,26 +104,38 @@ void CliSessMgr::sendCliSessSignalMsg(SessMsgType sessMsgSignalingType, const st
 
 /**
  * @brief  Client Session message reception handler, which:\n\n
- *            1) Blocks the execution until a complete session message wrapper has
+ *            1) If pending, receives the server's 'SRV_OK' STSM message preceding the
+ *               response to a first session request sent along with the 'CLI_AUTH' message\n\n
+ *            2) Blocks the execution until a complete session message wrapper has
  *               been received in the associated connection manager's primary buffer\n\n
- *            2) Unwraps the received session message wrapper from
+ *            3) Unwraps the received session message wrapper from
  *               the primary into the secondary connection buffer\n\n
- *            3) Asserts the resulting session message to be allowed in
+ *            4) Asserts the resulting session message to be allowed in
  *               the current client session manager operation and step\n\n
- *            4) Handles session-resetting or terminating signaling messages\n\n
- *            5) Handles session error signaling messages
+ *            5) Handles session-resetting or terminating signaling messages\n\n
+ *            6) Handles session error signaling messages
  * @throws Most of the session and OpenSSL exceptions (see
  *         "execErrCode.h" and "sessErrCodes.h" for more details)
  */
 void CliSessMgr::recvCheckCliSessMsg()
  {
-  // Block the execution until a complete session message wrapper has
-  // been received in the associated connection manager's primary buffer
-  _connMgr.recvFullMsg();
+  // If the client's first session request was sent along with its 'CLI_AUTH' message,
+  // receive the server's 'SRV_OK' STSM message preceding its response to such request
+  _cliConnMgr.finishCliSTSM();
 
-  // Unwrap the received session message wrapper stored in the connection's primary
-  // buffer into its associated session message in the connection's secondary buffer
-  unwrapSessMsg();
+  do
+   {
+    // Block the execution until a complete session message wrapper has
+    // been received in the associated connection manager's primary buffer
+    _connMgr.recvFullMsg();
+
+    // Unwrap the received session message wrapper stored in the connection's primary
+    // buffer into its associated session message in the connection's secondary buffer
+    unwrapSessMsg();
+   }
+  // A 'REKEY' message, which may be received in any operation and step, is handled by
+  // ratcheting the session messages' receiving key and awaiting the following message
+  while(recvRekeyMsg());
 
   // Interpret the contents of associated connection
   // manager's secondary buffer as a base session message
@@ -117,18 +146,26 @@ void CliSessMgr::recvCheckCliSessMsg()
   _recvSessMsgLen = sessMsg->msgLen;
   _recvSessMsgType = sessMsg->msgType;
 
+  // A session message referring to a non-existing stream is attributed to a desynchronization
+  // between the connection peers and requires the connection to be reset
+  if(sessMsg->streamId >= SESS_MAX_STREAMS)
+   THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_STREAM, "stream " + std::to_string(sessMsg->streamId));
+
+  // Carry out the received session message on its stream
+  _stream = _streams[sessMsg->streamId];
+
   // If a signaling message type was received, assert the message
   // length to be equal to the size of a base session message
   if(isSessSignalingMsgType(_recvSessMsgType) && _recvSessMsgLen != sizeof(SessMsg))
    sendCliSessSignalMsg(ERR_MALFORMED_SESS_MESSAGE,"Received a session signaling message of invalid "
                                                    "length (" + std::to_string(_recvSessMsgLen) + ")");
 
-  // With the client session manager in the 'IDLE' operation,
-  // only the 'BYE' and error signaling messages can be received
-  if(_sessMgrOp == IDLE && !(_recvSessMsgType == BYE || isSessErrSignalingMsgType(_recvSessMsgType)))
+  // With the stream in the 'IDLE' operation, only
+  // the 'BYE' and error signaling messages can be received
+  if(_stream->op == IDLE && !(_recvSessMsgType == BYE || isSessErrSignalingMsgType(_recvSessMsgType)))
    sendCliSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"Received a session message of type " +
                                                     std::to_string(_recvSessMsgType) + " with"
-                                                    " an IDLE client session manager");
+                                                    " an IDLE session stream");
 
   /*
    * Check whether the received session message type:
@@ -145,17 +182,38 @@ void CliSessMgr::recvCheckCliSessMsg()
     // A 'FILE_EXISTS' payload message type is allowed in
     // all operations but 'LIST' with step 'WAITING_RESP'
     case FILE_EXISTS:
-     if(!(_sessMgrOp != LIST && _sessMgrOpStep == WAITING_RESP))
+     if(!(_stream->op != LIST && _stream->opStep == WAITING_RESP))
       sendCliSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'FILE_EXISTS' session message received in"
                                                        " session operation \"" + sessMgrOpToStrUpCase() +
                                                        "\", step " + sessMgrOpStepToStrUpCase());
       break;
 
+    /* --------------------------- 'UPLOAD_RESUME' Payload Message Type --------------------------- */
+
+    // An 'UPLOAD_RESUME' payload message type is allowed in the 'UPLOAD' operation with step 'WAITING_RESP'
+    case UPLOAD_RESUME:
+     if(!(_stream->op == UPLOAD && _stream->opStep == WAITING_RESP))
+      sendCliSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'UPLOAD_RESUME' session message received in session"
+                                                       " operation \"" + sessMgrOpToStrUpCase() +
+                                                       "\", step " + sessMgrOpStepToStrUpCase());
+     break;
+
+    /* -------------------------- 'DELTA_SIGNATURES' Payload Message Type -------------------------- */
+
+    // A 'DELTA_SIGNATURES' payload message type is allowed in the 'UPLOAD'
+    // operation with step 'WAITING_RESP' once its delta upload was confirmed
+    case DELTA_SIGNATURES:
+     if(!(_stream->op == UPLOAD && _stream->opStep == WAITING_RESP && _stream->fileDelta != nullptr))
+      sendCliSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'DELTA_SIGNATURES' session message received in session"
+                                                       " operation \"" + sessMgrOpToStrUpCase() +
+                                                       "\", step " + sessMgrOpStepToStrUpCase());
+     break;
+
     /* ----------------------------- 'POOL_SIZE' Payload Message Type ----------------------------- */
 
     // A 'POOL_SIZE' payload message type is allowed in the 'LIST' operation with step 'WAITING_RESP'
     case POOL_SIZE:
-     if(!(_sessMgrOp == LIST && _sessMgrOpStep == WAITING_RESP))
+     if(!(_stream->op == LIST && _stream->opStep == WAITING_RESP))
       sendCliSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'POOL_SIZE' session message received in session"
                                                        " operation \"" + sessMgrOpToStrUpCase() +
                                                        "\", step " + sessMgrOpStepToStrUpCase());
@@ -167,7 +225,7 @@ void CliSessMgr::recvCheckCliSessMsg()
     // A 'FILE_NOT_EXISTS' signaling message type is allowed
     // in all operations but 'LIST' with step 'WAITING_RESP'
     case FILE_NOT_EXISTS:
-     if(!(_sessMgrOp != LIST && _sessMgrOpStep == WAITING_RESP))
+     if(!(_stream->op != LIST && _stream->opStep == WAITING_RESP))
       sendCliSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'FILE_NOT_EXISTS' session message received in "
                                                        "session operation \"" + sessMgrOpToStrUpCase() +
                                                        "\", step " + sessMgrOpStepToStrUpCase());
@@ -186,8 +244,8 @@ void CliSessMgr::recvCheckCliSessMsg()
      // Since after sending a 'COMPLETED' message the SafeCloud server has supposedly reset its session
      // state, if such a message type is received in an invalid operation or step just throw the
      // associated exception without notifying the server that an unexpected session message was received
-     if(!((_sessMgrOp == UPLOAD) || (_sessMgrOp == DELETE && _sessMgrOpStep == WAITING_COMPL) ||
-          (_sessMgrOp == RENAME && _sessMgrOpStep == WAITING_RESP)))
+     if(!((_stream->op == UPLOAD) || (_stream->op == DELETE && _stream->opStep == WAITING_COMPL) ||
+          (_stream->op == RENAME && _stream->opStep == WAITING_RESP)))
       THROW_SESS_EXCP(ERR_SESS_UNEXPECTED_MESSAGE, abortedOpToStr(), "'COMPLETED' session message received in "
                                                                      "session operation \"" + sessMgrOpToStrUpCase() +
                                                                      "\", step " + sessMgrOpStepToStrUpCase());
@@ -195,17 +253,29 @@ void CliSessMgr::recvCheckCliSessMsg()
 
     /* ------------------------------- 'BYE' Signaling Message Type ------------------------------- */
 
-    // A 'BYE' signaling message type is allowed in the 'IDLE' operation only
+    // A 'BYE' signaling message type is allowed with all the session's streams in the 'IDLE' operation only
     case BYE:
 
      // Since after sending a 'BYE' message the SafeCloud server is supposedly shutting down the
      // connection, if such a message type is received in an invalid operation or step just throw the
      // associated exception without notifying the server that an unexpected session message was received
-     if(_sessMgrOp != IDLE)
+     if(!isIdle())
       THROW_EXEC_EXCP(ERR_SESSABORT_SRV_GRACEFUL_DISCONNECT, abortedOpToStr());
      else
       THROW_EXEC_EXCP(ERR_SESSABORT_SRV_GRACEFUL_DISCONNECT);
 
+    /* -------------------------------- 'FILE_SEGMENT' Message Type -------------------------------- */
+
+    // A 'FILE_SEGMENT' message type is allowed only in the 'DOWNLOAD' operation with step 'WAITING_RAW',
+    // where as the segment's raw contents immediately follow its announcement, an unexpected
+    // 'FILE_SEGMENT' message requires the connection to be dropped
+    case FILE_SEGMENT:
+     if(!(_stream->op == DOWNLOAD && _stream->opStep == WAITING_RAW))
+      THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_SEGMENT, "stream " + std::to_string(_stream->streamId) +
+                                                          ", operation " + sessMgrOpToStrUpCase() +
+                                                          ", step " + sessMgrOpStepToStrUpCase());
+     break;
+
     /* ------------------------------ Error Signaling Message Types ------------------------------ */
 
     /* Error Signaling Message Types are allowed in all operations and steps */
@@ -222,6 +292,10 @@ void CliSessMgr::recvCheckCliSessMsg()
     case ERR_MALFORMED_SESS_MESSAGE:
      THROW_SESS_EXCP(ERR_SESS_CLI_SRV_MALFORMED_MESSAGE, abortedOpToStr());
 
+    // The server reported not to have enough storage space for the file to be uploaded
+    case ERR_NO_SPACE:
+     THROW_SESS_EXCP(ERR_SESS_CLI_SRV_NO_SPACE, abortedOpToStr());
+
     // The server reported to have received a session message of unknown type, an error to be attributed to
     // a desynchronization between the connection peers' IVs and that requires the connection to be reset
     case ERR_UNKNOWN_SESSMSG_TYPE:
@@ -254,7 +328,7 @@ void CliSessMgr::recvCheckCliSessMsg()
  *         cancelling the operation on the SafeCloud server depending on the user's response
  * @return A boolean indicating whether the file upload or download operation should continue
  * @throws ERR_SESS_INTERNAL_ERROR      Invalid session operation or step or uninitialized
- *                                      '_mainFileInfo' or '_remFileInfo' attributes
+ *                                      'mainFileInfo' or 'remFileInfo' attributes
  * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
@@ -267,22 +341,22 @@ void CliSessMgr::recvCheckCliSessMsg()
 bool CliSessMgr::askFileOpConf()
  {
   // Assert the client session manager operation and step to be valid to ask for a user's file operation confirmation
-  if(!((_sessMgrOp == UPLOAD || _sessMgrOp == DOWNLOAD) && _sessMgrOpStep == WAITING_RESP))
+  if(!((_stream->op == UPLOAD || _stream->op == DOWNLOAD) && _stream->opStep == WAITING_RESP))
    sendCliSessSignalMsg(ERR_INTERNAL_ERROR,"Attempting to ask for a user file " + sessMgrOpToStrLowCase() + " confirmation in "
                                            "operation \"" + sessMgrOpToStrUpCase() + "\", step " + sessMgrOpStepToStrUpCase());
 
-  // Ensure the '_mainFileInfo' attribute to have been initialized
-  if(_mainFileInfo == nullptr)
+  // Ensure the 'mainFileInfo' attribute to have been initialized
+  if(_stream->mainFileInfo == nullptr)
    sendCliSessSignalMsg(ERR_INTERNAL_ERROR,"Attempting to ask for a user file \"" + sessMgrOpToStrLowCase() +
-                                           "\" confirmation with a NULL '_mainFileInfo'");
+                                           "\" confirmation with a NULL 'mainFileInfo'");
 
-  // Ensure the '_remFileInfo' attribute to have been initialized
-  if(_remFileInfo == nullptr)
+  // Ensure the 'remFileInfo' attribute to have been initialized
+  if(_stream->remFileInfo == nullptr)
    sendCliSessSignalMsg(ERR_INTERNAL_ERROR,"Attempting to ask for a user file \"" + sessMgrOpToStrLowCase() +
-                                           "\" confirmation with a NULL '_remFileInfo'");
+                                           "\" confirmation with a NULL 'remFileInfo'");
 
   // Print a table comparing the metadata of the main and remote file
-  _mainFileInfo->compareMetadata(_remFileInfo);
+  _stream->mainFileInfo->compareMetadata(_stream->remFileInfo);
 
   // Assemble the file operation confirmation question
   std::string fileOpContinueQuestion("Do you want to continue " + sessMgrOpToStrLowCase() + "ing the file?");
@@ -290,8 +364,12 @@ bool CliSessMgr::askFileOpConf()
   // Ask the user the file operation confirmation question and, if they confirm
   if(Client::askUser(fileOpContinueQuestion.c_str()))
    {
-    // Confirm the file operation to the SafeCloud server
-    sendCliSessSignalMsg(CONFIRM);
+    // Confirm the file operation to the SafeCloud server, where a download may be resumed
+    // from its interrupted download, if any, and an upload may be carried out as a delta
+    if(_stream->op == DOWNLOAD)
+     confirmDownload(false);
+    else
+     confirmUpload();
 
     // Return that the file operation should continue
     return true;
@@ -314,15 +392,15 @@ bool CliSessMgr::askFileOpConf()
 /**
  * @brief  Loads and sanitizes the information of the file to
  *         be uploaded to the SafeCloud storage pool by:\n\n
- *           1) Writing its canonicalized path into the '_mainFileAbsPath' attribute\n\n
- *           2) Opening its '_mainFileDscr' file descriptor in read-byte mode\n\n
- *           3) Loading the file name and metadata into the '_mainFileInfo' attribute
+ *           1) Writing its canonicalized path into the 'mainFileAbsPath' attribute\n\n
+ *           2) Opening its 'mainFileDscr' file descriptor in read-byte mode\n\n
+ *           3) Loading the file name and metadata into the 'mainFileInfo' attribute
  * @param  filePath The relative or absolute path of the file to be uploaded
  * @throws ERR_SESS_FILE_NOT_FOUND   The file to be uploaded was not found
  * @throws ERR_SESS_FILE_OPEN_FAILED The file to be uploaded could not be opened in read mode
  * @throws ERR_SESS_FILE_READ_FAILED Error in reading the metadata of the file to be uploaded
  * @throws ERR_SESS_UPLOAD_DIR       The file to be uploaded is in fact a directory
- * @throws ERR_SESS_UPLOAD_TOO_BIG   The file to be uploaded is too large (>= 4GB)
+ * @throws ERR_SESS_UPLOAD_TOO_BIG   The file to be uploaded is too large
  */
 void CliSessMgr::checkLoadUploadFile(std::string& filePath)
  {
@@ -334,21 +412,24 @@ void CliSessMgr::checkLoadUploadFile(std::string& filePath)
   try
    {
     // Write the canonicalized file path of the file to
-    // be uploaded into the '_mainFileAbsPath' attribute
-    _mainFileAbsPath = new std::string(_targFileAbsPathC);
+    // be uploaded into the 'mainFileAbsPath' attribute
+    _stream->mainFileAbsPath = new std::string(_targFileAbsPathC);
 
     // Attempt to open the file to be uploaded in read-byte mode
-    _mainFileDscr = fopen(_targFileAbsPathC, "rb");
-    if(!_mainFileDscr)
+    _stream->mainFileDscr = fopen(_targFileAbsPathC, "rb");
+    if(!_stream->mainFileDscr)
      THROW_SESS_EXCP(ERR_SESS_FILE_OPEN_FAILED, filePath, ERRNO_DESC);
 
     // Attempt to load the name and metadata of the file to be uploaded
-    _mainFileInfo = new FileInfo(*_mainFileAbsPath);
+    _stream->mainFileInfo = new FileInfo(*_stream->mainFileAbsPath);
 
-    // Assert the size of the file to be uploaded to be less or
-    // equal than the allowed maximum upload file size (4GB - 1B)
-    if(_mainFileInfo->meta->fileSizeRaw > FILE_UPLOAD_MAX_SIZE)
-     THROW_SESS_EXCP(ERR_SESS_FILE_TOO_BIG, "it is " + std::string(_mainFileInfo->meta->fileSizeStr) + " >= 4GB");
+    // Assert the size of the file to be uploaded to be less or equal than the allowed maximum
+    // upload file size, which is 4GB - 1B if the server does not support 64-bit file sizes
+    if(_stream->mainFileInfo->meta->fileSizeRaw >
+       (_connMgr._largeFiles ? FILE_UPLOAD_MAX_SIZE : FILE_UPLOAD_MAX_SIZE_LEGACY))
+     THROW_SESS_EXCP(ERR_SESS_FILE_TOO_BIG, "it is " + std::string(_stream->mainFileInfo->meta->fileSizeStr) +
+                                            (_connMgr._largeFiles ? " >= 10000GB" : " >= 4GB, the server"
+                                                                    " not supporting larger files"));
 
     // Free the canonicalized path as a C string of the file to be uploaded
     free(_targFileAbsPathC);
@@ -372,10 +453,177 @@ void CliSessMgr::checkLoadUploadFile(std::string& filePath)
  }
 
 
+/**
+ * @brief  Digests the contents of the file to be uploaded, which is read without affecting its descriptor's
+ *         position, and sends their digest to the SafeCloud server within a 'SessMsgUploadDigest' session
+ *         message, so that the server may complete the upload without the contents being transferred
+ *         if it already holds them (see 'STSM_FEATURE_DEDUP_UPLOADS')
+ * @throws ERR_SESS_FILE_READ_FAILED    Error in reading the file to be uploaded
+ * @throws ERR_OSSL_EVP_MD_CTX_NEW      EVP_MD context creation failed
+ * @throws ERR_OSSL_EVP_DIGEST_INIT     EVP_MD digest initialization failed
+ * @throws ERR_OSSL_EVP_DIGEST_UPDATE   EVP_MD digest update failed
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL    EVP_MD digest final failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_CLI_DISCONNECTED         The server disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void CliSessMgr::sendUploadDigest()
+ {
+  EVP_MD_CTX*                mdCtx;                     // The digest context of the file's contents
+  unsigned char              digest[FILE_DIGEST_SIZE];  // The digest of the file's contents
+  std::vector<unsigned char> buf(65536);                // The buffer the file's contents are read into
+  ssize_t                    readRet;                   // The number of bytes read by pread()
+  off_t                      offset = 0;                // The offset of the next bytes to be read
+
+  // The file descriptor of the file to be uploaded
+  int fileFd = fileno(_stream->mainFileDscr);
+
+  mdCtx = EVP_MD_CTX_new();
+  if(mdCtx == nullptr)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_MD_CTX_NEW, OSSL_ERR_DESC);
+  if(EVP_DigestInit_ex(mdCtx, EVP_sha256(), NULL) != 1)
+   {
+    EVP_MD_CTX_free(mdCtx);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_INIT, OSSL_ERR_DESC);
+   }
+
+  // Digest the file's contents up to its end
+  while((readRet = pread(fileFd, buf.data(), buf.size(), offset)) > 0)
+   {
+    if(EVP_DigestUpdate(mdCtx, buf.data(), (size_t)readRet) != 1)
+     {
+      EVP_MD_CTX_free(mdCtx);
+      THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_UPDATE, OSSL_ERR_DESC);
+     }
+    offset += readRet;
+   }
+  if(readRet < 0)
+   {
+    EVP_MD_CTX_free(mdCtx);
+    THROW_SESS_EXCP(ERR_SESS_FILE_READ_FAILED, *_stream->mainFileAbsPath, ERRNO_DESC);
+   }
+
+  if(EVP_DigestFinal_ex(mdCtx, digest, NULL) != 1)
+   {
+    EVP_MD_CTX_free(mdCtx);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_FINAL, OSSL_ERR_DESC);
+   }
+  EVP_MD_CTX_free(mdCtx);
+
+  // Send the digest of the file's contents to the SafeCloud server
+  sendSessMsgUploadDigest(digest);
+ }
+
+
+/**
+ * @brief  Confirms the upload of the current stream's file overwriting the one in the user's storage pool to the
+ *         SafeCloud server where, if the server supports delta uploads (see 'STSM_FEATURE_DELTA_UPLOADS'), the
+ *         file is not authenticated only, its upload is not resumed, both its versions are at least
+ *         FILE_DELTA_MIN_SIZE bytes and the server's version is at most FILE_DELTA_MAX_SIZE bytes, the
+ *         upload is confirmed with a 'DELTA_CONFIRM' message so that only the file's changes against the
+ *         server's version are sent
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_CLI_DISCONNECTED         The server disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void CliSessMgr::confirmUpload()
+ {
+  // If the upload is eligible for being carried out as a delta,
+  // confirm it as such and await the server's blocks' signatures
+  if(_connMgr._deltaUploads && !_stream->authOnly && _stream->rawOffset == 0 &&
+     _stream->mainFileInfo->meta->fileSizeRaw >= FILE_DELTA_MIN_SIZE &&
+     _stream->remFileInfo->meta->fileSizeRaw >= FILE_DELTA_MIN_SIZE &&
+     _stream->remFileInfo->meta->fileSizeRaw <= FILE_DELTA_MAX_SIZE)
+   {
+    _stream->fileDelta = new FileDelta(-1, _stream->remFileInfo->meta->fileSizeRaw);
+    sendCliSessSignalMsg(DELTA_CONFIRM);
+   }
+
+  // Otherwise, confirm the upload of the whole file
+  else
+   sendCliSessSignalMsg(CONFIRM);
+ }
+
+
+/**
+ * @brief  Loads the signatures of the blocks of the server's version of the file to be uploaded received within
+ *         a 'SessMsgDeltaSigs' session message, encodes the file as a delta against them into a temporary file
+ *         (an anonymous 'O_TMPFILE' inode in the temporary directory or, where the filesystem does not support
+ *         it, a named one) whose contents are then uploaded in place of the file's, and announces the delta's
+ *         size and the digest of the file's contents to the server within a 'SessMsgUploadDelta' message
+ * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid 'SessMsgDeltaSigs' message length or blocks
+ * @throws ERR_SESS_INTERNAL_ERROR      Failed to create the temporary file or to encode the delta into it
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL    EVP_MD digest failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_CLI_DISCONNECTED         The server disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void CliSessMgr::sendUploadDelta()
+ {
+  int      tmpFileFd;  // The file descriptor of the delta's temporary file
+  uint64_t deltaSize;  // The size of the file's delta
+
+  // Load the signatures of the blocks of the server's version of the file
+  loadSessMsgDeltaSigs();
+
+  // Attempt to create the delta's temporary file as an anonymous inode in the temporary directory,
+  // falling back to a named temporary file where the filesystem does not support anonymous inodes
+  _stream->tmpFileAbsPath = new std::string(*_tmpDirAbsPath + "/" + _stream->mainFileInfo->fileName + "_DELTA");
+  tmpFileFd = open(_tmpDirAbsPath->c_str(), O_TMPFILE | O_RDWR, 0600);
+  if(tmpFileFd != -1)
+   {
+    _stream->tmpFileDscr = fdopen(tmpFileFd, "w+b");
+    if(!_stream->tmpFileDscr)
+     close(tmpFileFd);
+    else
+     _stream->tmpFileAnon = true;
+   }
+  if(!_stream->tmpFileDscr)
+   {
+    _stream->tmpFileDscr = fopen(_stream->tmpFileAbsPath->c_str(), "w+b");
+    if(!_stream->tmpFileDscr)
+     sendCliSessSignalMsg(ERR_INTERNAL_ERROR, "Failed to create the delta file \"" + *_stream->tmpFileAbsPath
+                                              + "\" (" + ERRNO_DESC + ")");
+   }
+
+  // Encode the file as a delta against the server's version into the temporary
+  // file, which is then rewound for its contents to be uploaded
+  if(!_stream->fileDelta->encode(fileno(_stream->mainFileDscr), _stream->mainFileInfo->meta->fileSizeRaw,
+                                 _stream->tmpFileDscr, deltaSize, _stream->deltaDigest)
+     || fflush(_stream->tmpFileDscr) != 0 || fseeko(_stream->tmpFileDscr, 0, SEEK_SET) != 0)
+   sendCliSessSignalMsg(ERR_INTERNAL_ERROR, "Failed to encode the delta of file \"" + _stream->mainFileInfo->fileName
+                                            + "\" (" + ERRNO_DESC + ")");
+
+  // Upload the delta in place of the file's contents, announcing its size and the digest of the file's contents
+  _stream->rawLength = deltaSize;
+  sendSessMsgUploadDelta(deltaSize, _stream->deltaDigest);
+
+  LOG_DEBUG("File \"" + _stream->mainFileInfo->fileName + "\" (" + _stream->mainFileInfo->meta->fileSizeStr
+            + ") encoded as a delta of " + std::to_string(deltaSize) + " bytes against "
+            + std::to_string(_stream->fileDelta->getNumBlocks()) + " blocks of its server's version")
+ }
+
+
 /**
  * @brief  Parses the 'FILE_UPLOAD_REQ' session response message returned by the SafeCloud server, where:\n\n
- *            1) If the SafeCloud server has reported to have successfully uploaded
- *               the empty file, inform the user of the success of the operation.\n\n
+ *            1) If the SafeCloud server has reported to have successfully uploaded the empty file, or a
+ *               non-empty file whose contents it already holds if it deduplicates uploads, inform
+ *               the user of the success of the operation.\n\n
  *            2) If the SafeCloud server has reported that a file with the same name of the one to be
  *               uploaded does not exist in the user's storage pool, the file upload operation should continue\n\n
  *            3) If the SafeCloud server has reported that a file with the same name of the one to be uploaded
@@ -387,9 +635,12 @@ void CliSessMgr::checkLoadUploadFile(std::string& filePath)
  *                       one in the storage pool the file upload operation should continue\n\n
  *                  3.3) If the file to be uploaded has the same size and last modified time of
  *                       the one in the storage pool, or the latter was more recently modified,
- *                       ask for user confirmation on whether the upload operation should continue
+ *                       ask for user confirmation on whether the upload operation should continue\n\n
+ *            4) If the SafeCloud server has reported to resume the upload from its partial upload of
+ *               the file, load the offset it is resumed from and parse the server's following response
  * @return A boolean indicating whether the upload operation should continue
  * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid file values in the 'SessMsgFileInfo' message
+ *                                      or invalid offset in the 'SessMsgUploadResume' message
  * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
@@ -409,17 +660,26 @@ bool CliSessMgr::parseUploadResponse()
     // If the SafeCloud server has reported that the empty file has been uploaded successfully
     case COMPLETED:
 
-     // Ensure the file that was uploaded to be in fact empty, where, since
-     // after sending a 'COMPLETED' message the server has supposedly reset
+     // If the file is NOT empty and the server deduplicates uploads, it has completed the upload
+     // by linking the contents it already holds in the user's storage pool under the file's name
+     if(_stream->mainFileInfo->meta->fileSizeRaw != 0 && _connMgr._dedupUploads)
+      {
+       std::cout << "\nFile \"" + _stream->mainFileInfo->fileName + "\" (" + _stream->mainFileInfo->meta->fileSizeStr + ") successfully "
+                    "uploaded to the SafeCloud storage pool (deduplicated, its contents being already held by the server)\n" << std::endl;
+       return false;
+      }
+
+     // Otherwise ensure the file that was uploaded to be in fact empty, where,
+     // since after sending a 'COMPLETED' message the server has supposedly reset
      // its session state, in case such a file is in fact NOT empty just throw
      // the associated exception without notifying the server of the error
-     if(_mainFileInfo->meta->fileSizeRaw != 0)
+     if(_stream->mainFileInfo->meta->fileSizeRaw != 0)
       THROW_SESS_EXCP(ERR_SESS_UNEXPECTED_MESSAGE, abortedOpToStr(),
                       "The server reported to have completed an upload operation of a non-empty file without actually receiving"
-                      "its data (file: \"" + _mainFileInfo->fileName + "\", size: " + _mainFileInfo->meta->fileSizeStr + ")");
+                      "its data (file: \"" + _stream->mainFileInfo->fileName + "\", size: " + _stream->mainFileInfo->meta->fileSizeStr + ")");
 
      // Inform the user that the empty file has been successfully uploaded to their storage pool
-     std::cout << "\nEmpty file \"" + _mainFileInfo->fileName + "\" successfully uploaded to the SafeCloud storage pool\n" << std::endl;
+     std::cout << "\nEmpty file \"" + _stream->mainFileInfo->fileName + "\" successfully uploaded to the SafeCloud storage pool\n" << std::endl;
 
      // As it has just completed, return that the upload operation should not proceed
      return false;
@@ -429,17 +689,30 @@ bool CliSessMgr::parseUploadResponse()
     case FILE_NOT_EXISTS:
      return true;
 
+    // If the SafeCloud server has reported to resume the upload from its partial upload
+    // of the file, load the offset the upload is resumed from and, since the server
+    // follows it with its actual response, receive and parse such response
+    case UPLOAD_RESUME:
+     loadSessMsgUploadResume();
+
+     std::cout << "\nResuming the interrupted upload of file \"" + _stream->mainFileInfo->fileName + "\" ("
+                  + std::to_string(_stream->rawOffset * 100 / _stream->mainFileInfo->meta->fileSizeRaw)
+                  + "% already in the storage pool)" << std::endl;
+
+     recvCheckCliSessMsg();
+     return parseUploadResponse();
+
     // If the SafeCloud server has reported that a file with the same name
     // of the one to be uploaded already exists in the user's storage pool
     case FILE_EXISTS:
 
-     // Load into the '_remFileInfo' attribute the name and metadata of the file
+     // Load into the 'remFileInfo' attribute the name and metadata of the file
      // in the user's storage pool with the same name of the one to be uploaded
      loadRemSessMsgFileInfo();
 
      // If the file to be uploaded is empty and, at this point, the
      // file with the same name in the SafeCloud storage pool is not
-     if(_mainFileInfo->meta->fileSizeRaw == 0)
+     if(_stream->mainFileInfo->meta->fileSizeRaw == 0)
       {
        // Inform the user that the upload would result in overwriting
        // a non-empty with an empty file in their storage pool
@@ -453,10 +726,10 @@ bool CliSessMgr::parseUploadResponse()
 
      // If the file to be uploaded was more recently modified than the one in
      // the storage pool, return that the file raw contents should be uploaded
-     if(_mainFileInfo->meta->lastModTimeRaw > _remFileInfo->meta->lastModTimeRaw)
+     if(_stream->mainFileInfo->meta->lastModTimeRaw > _stream->remFileInfo->meta->lastModTimeRaw)
       {
        // Confirm the upload operation to the SafeCloud server
-       sendCliSessSignalMsg(CONFIRM);
+       confirmUpload();
 
        // Return that the upload operation should continue
        return true;
@@ -464,11 +737,11 @@ bool CliSessMgr::parseUploadResponse()
 
      // Otherwise, if the file to be uploaded and the one on the
      // storage pool have the same size and last modified time
-     if(_mainFileInfo->meta->lastModTimeRaw == _remFileInfo->meta->lastModTimeRaw
-        && _mainFileInfo->meta->fileSizeRaw == _remFileInfo->meta->fileSizeRaw)
+     if(_stream->mainFileInfo->meta->lastModTimeRaw == _stream->remFileInfo->meta->lastModTimeRaw
+        && _stream->mainFileInfo->meta->fileSizeRaw == _stream->remFileInfo->meta->fileSizeRaw)
       {
        // Inform the user that the file they want to upload probably already exists in their storage pool
-       std::cout << "\nYour storage pool already contains a \"" + _mainFileInfo->fileName
+       std::cout << "\nYour storage pool already contains a \"" + _stream->mainFileInfo->fileName
                     + "\" file of the same size and last modified time of the one to be uploaded" << std::endl;
 
        // Ask for user confirmation on whether to continue the file upload, also sending
@@ -478,11 +751,11 @@ bool CliSessMgr::parseUploadResponse()
 
      // Otherwise, if the file in the storage pool was more
      // recently modified than the one to be uploaded
-     if(_mainFileInfo->meta->lastModTimeRaw < _remFileInfo->meta->lastModTimeRaw)
+     if(_stream->mainFileInfo->meta->lastModTimeRaw < _stream->remFileInfo->meta->lastModTimeRaw)
       {
        // Inform the user that the file on the storage pool is more recent than the one they want to upload
        std::cout << "Your storage pool contains a more recent version of "
-                    "the \"" + _mainFileInfo->fileName + "\" file" << std::endl;
+                    "the \"" + _stream->mainFileInfo->fileName + "\" file" << std::endl;
 
        // Ask for user confirmation on whether to continue the file upload, also sending
        // the operation confirmation or cancellation notification to the SafeCloud server
@@ -501,50 +774,210 @@ bool CliSessMgr::parseUploadResponse()
 
 
 /**
- * @brief  Uploads the main file's raw contents and sends the
- *         resulting integrity tag to the SafeCloud server
- * @throws ERR_FILE_WRITE_FAILED              Error in reading from the main file
+ * @brief Upload pipeline reading stage, reading in a round-robin fashion the segments of the files
+ *        of the session's streams in the 'SENDING_RAW' step into the plaintext buffers of the
+ *        pipeline slots and passing them to the encryption stage
+ * @param uploadPipe The file upload pipeline
+ * @param totBytes   The total size of the files' contents to be uploaded
+ * @note  Being executed in a separate thread, the stage never throws, with
+ *        its exceptions aborting the pipeline and being stored within it
+ */
+void CliSessMgr::uploadReadStage(FilePipe& uploadPipe, long int totBytes)
+ {
+  // The index of the pipeline slot the segment is read into
+  unsigned int slotIdx;
+
+  // The number of bytes that have been read from each stream's file (starting
+  // from the offsets their uploads are resumed from, if any) and in total
+  long int readBytes[SESS_MAX_STREAMS];
+  long int totReadBytes = 0;
+
+  // The index of the stream whose file the next segment is read from
+  unsigned char streamInd = 0;
+
+  // fread() return, representing the number of bytes read
+  // from main file into the slot's plaintext buffer
+  size_t freadRet;
+
+  for(unsigned char i = 0; i < SESS_MAX_STREAMS; i++)
+   readBytes[i] = (long int)_streams[i]->rawOffset;
+
+  try
+   {
+    while(totReadBytes < totBytes)
+     {
+      // Select the next stream whose file has not been completely read yet
+      while(!(_streams[streamInd]->opStep == SENDING_RAW &&
+              readBytes[streamInd] < (long int)(_streams[streamInd]->rawOffset + _streams[streamInd]->rawLength)))
+       streamInd = (unsigned char)((streamInd + 1) % SESS_MAX_STREAMS);
+      SessStream& stream = *_streams[streamInd];
+
+      // The raw contents are read from the file or, if it is uploaded as a delta, from the delta's temporary file
+      FILE* rawDscr = stream.tmpFileDscr != nullptr ? stream.tmpFileDscr : stream.mainFileDscr;
+
+      // Wait for a free pipeline slot (returning if the pipeline was aborted)
+      if(!uploadPipe.takeSlot(UPLOAD_STAGE_READ, slotIdx))
+       return;
+      FilePipe::Slot& slot = uploadPipe.getSlot(slotIdx);
+
+      // Determine the plaintext size of the segment, adapted to the connection's bandwidth-delay product
+      slot.streamId = streamInd;
+      slot.ptSize = adaptSendSegSize((long int)(stream.rawOffset + stream.rawLength) - readBytes[streamInd]);
+
+      // Read the segment's raw contents from the file into the slot's plaintext buffer
+      freadRet = fread(slot.ptBuf, sizeof(char), slot.ptSize, rawDscr);
+
+      // An error occurred in reading the file raw contents is a critical error that in the current
+      // session state cannot be notified to the server and so require the connection to be dropped
+      if(ferror(rawDscr))
+       THROW_EXEC_EXCP(ERR_FILE_READ_FAILED, stream.mainFileInfo->fileName + ", upload operation aborted", ERRNO_DESC);
+
+      // Reading from the file less bytes than its expected size (i.e. the file was truncated after
+      // the upload operation was started) is a critical error that in the current session state
+      // cannot be notified to the server and so require the connection to be dropped
+      if(freadRet != slot.ptSize)
+       THROW_EXEC_EXCP(ERR_SESSABORT_UNEXPECTED_FILE_SIZE, "file: \"" + stream.mainFileInfo->fileName + "\", upload "
+                                                           "operation aborted", std::to_string(readBytes[streamInd] + freadRet)
+                                                           + " != " + std::to_string(stream.rawOffset + stream.rawLength));
+
+      readBytes[streamInd] += slot.ptSize;
+      totReadBytes += slot.ptSize;
+
+      // Pass the slot to the encryption stage
+      uploadPipe.passSlot(UPLOAD_STAGE_READ, slotIdx);
+
+      // Interleave the next segment with the ones of the following stream
+      streamInd = (unsigned char)((streamInd + 1) % SESS_MAX_STREAMS);
+     }
+   }
+  catch(...)
+   { uploadPipe.abort(std::current_exception()); }
+ }
+
+
+/**
+ * @brief Upload pipeline encryption stage, encrypting the segments in the pipeline slots with
+ *        the chunk IVs of their streams from their plaintext into their ciphertext buffers
+ *        and passing them to the sending stage
+ * @param uploadPipe The file upload pipeline
+ * @param totBytes   The total size of the files' contents to be uploaded
+ * @note  Being executed in a separate thread, the stage never throws, with
+ *        its exceptions aborting the pipeline and being stored within it
+ */
+void CliSessMgr::uploadEncryptStage(FilePipe& uploadPipe, long int totBytes)
+ {
+  // The index of the pipeline slot whose segment is encrypted
+  unsigned int slotIdx;
+
+  // The number of file bytes that have been encrypted
+  long int encBytes = 0;
+
+  try
+   {
+    while(encBytes < totBytes)
+     {
+      // Wait for a read segment (returning if the pipeline was aborted)
+      if(!uploadPipe.takeSlot(UPLOAD_STAGE_ENCRYPT, slotIdx))
+       return;
+      FilePipe::Slot& slot = uploadPipe.getSlot(slotIdx);
+
+      // Encrypt the segment's chunks from the slot's plaintext into its ciphertext buffer with the current
+      // sending key epoch (this stage being the only one accessing the cryptographic state of the file chunks)
+      slot.keyEpoch = _sendKeyEpoch;
+      slot.ctSize   = encryptFileSegment(*_streams[slot.streamId], slot.ptSize, slot.keyEpoch, slot.ptBuf, slot.ctBuf);
+      encBytes += slot.ptSize;
+
+      // Pass the slot to the sending stage
+      uploadPipe.passSlot(UPLOAD_STAGE_ENCRYPT, slotIdx);
+     }
+   }
+  catch(...)
+   { uploadPipe.abort(std::current_exception()); }
+ }
+
+
+/**
+ * @brief  Uploads the raw contents of the files of the session's streams in the 'SENDING_RAW' step
+ *         to the SafeCloud server as 'FILE_SEGMENT' messages each followed by the segment's individually
+ *         authenticated chunks, with the segments of different files being interleaved on the connection
+ *         and passing through a pipeline where their reading, encryption and sending overlap
+ * @throws ERR_FILE_WRITE_FAILED              Error in reading from a main file
  * @throws ERR_SESSABORT_UNEXPECTED_FILE_SIZE The main file raw contents that were read differ from its size
  * @throws ERR_AESGCMMGR_INVALID_STATE        Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW        EVP_CIPHER context creation failed
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT          EVP_CIPHER encrypt initialization failed
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE       The plaintext block size is non-positive (probable overflow)
  * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE        EVP_CIPHER encrypt update failed
  * @throws ERR_OSSL_EVP_ENCRYPT_FINAL         EVP_CIPHER encrypt final failed
  * @throws ERR_OSSL_GET_TAG_FAILED            Error in retrieving the resulting integrity tag
- * @throws ERR_SEND_OVERFLOW                  Attempting to send a number of bytes > _priBufSize
  * @throws ERR_PEER_DISCONNECTED              The connection peer disconnected during the send()
  * @throws ERR_SEND_FAILED                    send() fatal error
  */
-void CliSessMgr::uploadFileData()
+void CliSessMgr::uploadFilesData()
  {
-  // fread() return, representing the number of bytes read
-  // from main file into the secondary connection buffer
-  size_t freadRet;
+  // The number of files being uploaded and their total size
+  unsigned char numFiles = 0;
+  long int totBytes = 0;
 
-  // The total number of file bytes sent to the SafeCloud server
-  size_t totBytesSent = 0;
+  // The stream of the (last) file being uploaded
+  SessStream* fileStream = nullptr;
+
+  // The maximum plaintext size of the files' segments, which is adapted during the upload
+  unsigned int maxSegSize = 0;
+
+  // The upload pipeline reading and encryption threads
+  std::thread readThread;
+  std::thread encryptThread;
+
+  // The index of the pipeline slot whose segment is sent and the zero-copy sequence number of its send
+  unsigned int slotIdx;
+  uint32_t     sendSeq;
+
+  // The index of the slot whose segment was last sent and its zero-copy sequence number, with
+  // the slot being returned to the reading stage only after the kernel has released its buffer
+  unsigned int sentSlotIdx = 0;
+  uint32_t     sentSlotSeq = 0;
+  bool         sentSlotHeld = false;
+
+  // The number of file bytes that have been sent
+  long int sentBytes = 0;
 
   // A progress bar possibly used for displaying the
-  // file's upload progress discretized between 0-100%
+  // files' upload progress discretized between 0-100%
   ProgressBar uploadProgBar(100);
 
   // The previous and current upload progress discretized between 0-100%
   unsigned char prevUploadProg = 0;
   unsigned char currUploadProg;
 
-  // If the file to be uploaded is large enough, display
+  // Determine the number and total size of the files' contents to be uploaded and their maximum segment size
+  for(SessStream* stream : _streams)
+   if(stream->opStep == SENDING_RAW)
+    {
+     fileStream = stream;
+     numFiles++;
+     totBytes += (long int)stream->rawBytesRem;
+     maxSegSize = std::max(maxSegSize, (unsigned int)std::min((long int)stream->rawBytesRem,
+                                                              (long int)FILE_SEGMENT_SIZE));
+    }
+
+  // The file upload pipeline, whose slots hold a segment's plaintext and
+  // ciphertext and are sized so to fit the files' largest segment
+  FilePipe uploadPipe(UPLOAD_STAGES, UPLOAD_PIPE_SLOTS, maxSegSize, fileSegmentWireSize(maxSegSize));
+
+  // If the files to be uploaded are large enough, display
   // the upload progress to the user via a progress bar
-  bool showProgBar = _mainFileInfo->meta->fileSizeRaw > (_connMgr._priBufSize * 5);
-
-  // Initialize the file encryption operation
-  _aesGCMMgr.encryptInit();
+  bool showProgBar = totBytes > (_connMgr._priBufSize * 5);
 
   // If the upload progress bar should be displayed
   if(showProgBar)
    {
     // Print an introductory uploaded message
-    std::cout << "\nUploading file \"" + _mainFileInfo->fileName + "\" ("
-                 + _mainFileInfo->meta->fileSizeStr + ") to the storage pool:\n" << std::endl;
+    if(numFiles == 1)
+     std::cout << "\nUploading file \"" + fileStream->mainFileInfo->fileName + "\" ("
+                  + fileStream->mainFileInfo->meta->fileSizeStr + ") to the storage pool:\n" << std::endl;
+    else
+     std::cout << "\nUploading " + std::to_string(numFiles) + " files to the storage pool:\n" << std::endl;
 
     // Display the progress bar with 0% completion
     uploadProgBar.update();
@@ -552,34 +985,44 @@ void CliSessMgr::uploadFileData()
 
   // -------------------------------- File Upload Loop -------------------------------- //
 
-  do
+  try
    {
-    // Read the file raw contents into the secondary buffer size (possibly filling it)
-    freadRet = fread(_connMgr._secBuf, sizeof(char), _connMgr._secBufSize, _mainFileDscr);
+    // Start the upload pipeline reading and encryption stages
+    readThread = std::thread(&CliSessMgr::uploadReadStage, this, std::ref(uploadPipe), totBytes);
+    encryptThread = std::thread(&CliSessMgr::uploadEncryptStage, this, std::ref(uploadPipe), totBytes);
 
-    // An error occurred in reading the file raw contents is a critical error that in the current
-    // session state cannot be notified to the server and so require the connection to be dropped
-    if(ferror(_mainFileDscr))
-     THROW_EXEC_EXCP(ERR_FILE_READ_FAILED, _mainFileInfo->fileName + ", upload operation aborted", ERRNO_DESC);
-
-    // If bytes were read from the file into the secondary connection buffer
-    if(freadRet > 0)
+    // Sending stage, executed in the calling thread
+    while(sentBytes < totBytes)
      {
-      // Encrypt the file raw contents from the secondary into the primary connection buffer
-      _aesGCMMgr.encryptAddPT(&_connMgr._secBuf[0], (int)freadRet, &_connMgr._priBuf[0]);
+      // Wait for an encrypted segment (breaking if the pipeline was aborted)
+      if(!uploadPipe.takeSlot(UPLOAD_STAGE_SEND, slotIdx))
+       break;
+      FilePipe::Slot& slot = uploadPipe.getSlot(slotIdx);
 
-      // Send the encrypted file contents to the SafeCloud server
-      _connMgr.sendRaw(freadRet);
+      // Announce the segment on its stream and send its chunks
+      // along with their integrity tags to the SafeCloud server
+      sendSessMsgFileSegment(*_streams[slot.streamId], slot.ptSize, slot.ctSize, slot.keyEpoch);
+      sendSeq = _connMgr.sendRawZeroCopy(slot.ctBuf, slot.ctSize);
+      sentBytes += slot.ptSize;
+
+      // Return the previously sent slot to the reading stage once the kernel has released its
+      // buffer, so that its transmission overlaps with the sending of the current segment
+      if(sentSlotHeld)
+       {
+        _connMgr.waitZeroCopyCompl(sentSlotSeq);
+        uploadPipe.passSlot(UPLOAD_STAGE_SEND, sentSlotIdx);
+       }
 
-      // Update the total number of bytes sent to the SafeCloud server
-      totBytesSent += freadRet;
+      // Hold the current slot until the kernel releases its buffer
+      sentSlotIdx = slotIdx;
+      sentSlotSeq = sendSeq;
+      sentSlotHeld = true;
 
       // If the upload progress bar should be displayed
       if(showProgBar)
        {
         // Compute the current upload progress discretized between 0-100%
-        currUploadProg = (unsigned char)((float)totBytesSent /
-                         (float)_mainFileInfo->meta->fileSizeRaw * 100);
+        currUploadProg = (unsigned char)((float)sentBytes / (float)totBytes * 100);
 
         // Update the progress bar to the current upload progress
         for(unsigned char i = prevUploadProg; i < currUploadProg; i++)
@@ -589,30 +1032,369 @@ void CliSessMgr::uploadFileData()
         prevUploadProg = currUploadProg;
        }
      }
-   } while(!feof(_mainFileDscr)); // While the main file has not been completely read
+
+    // Wait for the kernel to release the buffer of the last sent slot, which
+    // also drains the connection socket's error queue from its notifications
+    if(sentSlotHeld)
+     _connMgr.waitZeroCopyCompl(sentSlotSeq);
+   }
+  catch(...)
+   { uploadPipe.abort(std::current_exception()); }
+
+  // Wait for the upload pipeline reading and encryption stages to terminate
+  if(readThread.joinable())
+   readThread.join();
+  if(encryptThread.joinable())
+   encryptThread.join();
 
   // Indentation
   if(showProgBar)
    printf("\n");
 
+  // If an error occurred in any stage of the upload pipeline, rethrow it
+  uploadPipe.rethrowAbortExcp();
+
   // ------------------------------ End File Upload Loop ------------------------------ //
+ }
+
+
+/**
+ * @brief  Uploads a batch of up to SESS_MAX_STREAMS files to the user's SafeCloud storage pool,
+ *         carrying out each upload operation on its own session stream by:\n\n
+ *            1) Sending the upload requests of all files.\n\n
+ *            2) Parsing the server's responses to the upload requests, in order.\n\n
+ *            3) Uploading the raw contents of the confirmed files, whose segments are
+ *               interleaved on the connection (see the uploadFilesData() method).\n\n
+ *            4) Awaiting the server's completion notifications of the uploaded files.
+ * @param  filePaths The relative or absolute paths of the files to be uploaded
+ * @param  firstFile The index in 'filePaths' of the first file of the batch
+ * @param  numFiles  The number of files in the batch (<= SESS_MAX_STREAMS)
+ * @param  authOnly  Whether the files' contents should be authenticated only instead of encrypted
+ * @note   Recoverable errors of a file's upload operation are reported to the user
+ *         and only abort such operation, leaving the other ones of the batch unaffected
+ * @throws Most of the session-aborting and OpenSSL exceptions
+ *         (see "execErrCode.h" for more details)
+ */
+void CliSessMgr::uploadFilesBatch(std::vector<std::string>& filePaths, size_t firstFile, unsigned char numFiles, bool authOnly)
+ {
+  // The number of streams awaiting a server response or completion notification
+  unsigned char numPending = 0;
+
+  // Whether the raw contents of any file should be uploaded
+  bool sendRaw = false;
+
+  // ----------------------------- Upload Requests ----------------------------- //
+
+  for(unsigned char streamInd = 0; streamInd < numFiles; streamInd++)
+   {
+    _stream = _streams[streamInd];
+    try
+     {
+      // Initialize the stream operation and whether its file's contents are authenticated only
+      _stream->op = UPLOAD;
+      _stream->authOnly = authOnly;
+
+      // Load and sanitize the information of the file to be uploaded to the SafeCloud storage pool
+      checkLoadUploadFile(filePaths[firstFile + streamInd]);
+
+      // Prepare a 'SessMsgFileInfo' session message of type 'FILE_UPLOAD_REQ' containing the
+      // name and metadata of the file to be uploaded and send it to the SafeCloud server
+      sendSessMsgFileInfo(FILE_UPLOAD_REQ);
+
+      // If the server deduplicates uploads, follow the request of a non-empty file with the digest of its contents
+      if(_connMgr._dedupUploads && _stream->mainFileInfo->meta->fileSizeRaw != 0)
+       sendUploadDigest();
 
-  // Having sent to the SafeCloud server a number of bytes different from the
-  // file size is a critical error that in the current session state cannot
-  // be notified to the server and so require the connection to be dropped
-  if(totBytesSent != _mainFileInfo->meta->fileSizeRaw)
-   THROW_EXEC_EXCP(ERR_SESSABORT_UNEXPECTED_FILE_SIZE, "file: \"" + _mainFileInfo->fileName + "\", upload "
-                                                       "operation aborted", std::to_string(totBytesSent) + " != "
-                                                       + std::to_string(_mainFileInfo->meta->fileSizeRaw));
-
-  // Finalize the file upload operation by sending
-  // the resulting integrity tag to the server
-  sendRawTag();
+      LOG_DEBUG("Sent 'FILE_UPLOAD_REQ' message to the server (stream = " + std::to_string(streamInd) + ", file = \""
+                + *_stream->mainFileAbsPath + "\", size = " + _stream->mainFileInfo->meta->fileSizeStr + ")")
+
+      // Update the operation step so to expect a 'FILE_UPLOAD_REQ' response
+      _stream->opStep = WAITING_RESP;
+      numPending++;
+     }
+    catch(sessErrExcp& sessExcp)
+     {
+      handleSessErrException(sessExcp);
+      resetStreamState();
+     }
+   }
+
+  // ----------------------------- Upload Responses ----------------------------- //
+
+  // The server answers the upload requests in the order they were sent
+  for(unsigned char resp = numPending; resp > 0; resp--)
+   {
+    try
+     {
+      // Block until a 'FILE_UPLOAD_REQ' response is received from the SafeCloud server
+      recvCheckCliSessMsg();
+
+      // If the server sent the signatures of its version of a file whose upload was confirmed as a
+      // delta (which may follow the responses to the other requests), encode and announce its delta
+      if(_recvSessMsgType == DELTA_SIGNATURES)
+       sendUploadDelta();
+
+      // Otherwise parse the 'FILE_UPLOAD_REQ' response, obtaining an indication
+      // on whether the file raw contents should be uploaded to the SafeCloud server
+      else
+       {
+        if(!parseUploadResponse())
+         {
+          numPending--;
+          resetStreamState();
+          continue;
+         }
+
+        // If the upload was confirmed as a delta, await the signatures of the server's version of the file
+        if(_stream->fileDelta != nullptr)
+         {
+          resp++;
+          continue;
+         }
+       }
+
+      // If uploading a non-empty file, prepare the stream to send its raw contents
+      if(_stream->mainFileInfo->meta->fileSizeRaw != 0)
+       {
+        prepSendFileRaw();
+
+        // If the upload is resumed, position the file at the offset it is resumed from
+        if(_stream->rawOffset != 0 && fseeko(_stream->mainFileDscr, (off_t)_stream->rawOffset, SEEK_SET) != 0)
+         sendCliSessSignalMsg(ERR_INTERNAL_ERROR, "Error in seeking file \"" + _stream->mainFileInfo->fileName
+                                                  + "\" to offset " + std::to_string(_stream->rawOffset)
+                                                  + " (" + ERRNO_DESC + ")");
+
+        _stream->opStep = SENDING_RAW;
+        sendRaw = true;
+       }
+
+      // Otherwise, expect the server completion notification
+      else
+       _stream->opStep = WAITING_COMPL;
+     }
+    catch(sessErrExcp& sessExcp)
+     {
+      handleSessErrException(sessExcp);
+      numPending--;
+      resetStreamState();
+     }
+   }
+
+  // ------------------------------- Files Upload ------------------------------- //
+
+  // Upload the raw contents of the non-empty files
+  if(sendRaw)
+   uploadFilesData();
+
+  // Update the operation step of the streams that uploaded
+  // their files so to expect the server completion notifications
+  for(SessStream* stream : _streams)
+   if(stream->opStep == SENDING_RAW)
+    stream->opStep = WAITING_COMPL;
+
+  // --------------------------- Upload Completions --------------------------- //
+
+  for(; numPending > 0; numPending--)
+   {
+    try
+     {
+      // Block until a supposed server completion notification has been received
+      recvCheckCliSessMsg();
+
+      // Ensure that the server completion notification was received
+      if(_recvSessMsgType != COMPLETED)
+       sendCliSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"Received a session message of type" +
+                                                        std::to_string(_recvSessMsgType) +
+                                                        " while awaiting for the server's 'UPLOAD' completion");
+
+      // Inform the user that the file has been successfully uploaded to
+      // their storage pool depending on whether it is empty or not
+      if(_stream->mainFileInfo->meta->fileSizeRaw == 0)
+       std::cout << "\nEmpty file \"" + _stream->mainFileInfo->fileName + "\" successfully"
+                    " uploaded to the SafeCloud storage pool\n" << std::endl;
+      else
+       std::cout << "\nFile \"" + _stream->mainFileInfo->fileName + "\" (" + _stream->mainFileInfo->meta->fileSizeStr +
+                   ") successfully uploaded to the SafeCloud storage pool" +
+                   (_stream->authOnly ? " (authenticated only)" : "") + (_stream->fileDelta != nullptr ? ", sent as a delta of "
+                   + std::to_string(_stream->rawLength) + " bytes" : "") + (_connMgr._compress ? ", " +
+                   compressionStatsStr(_stream->xferRawBytes, _stream->xferWireBytes) : "") + "\n" << std::endl;
+     }
+    catch(sessErrExcp& sessExcp)
+     { handleSessErrException(sessExcp); }
+
+    // Reset the stream state
+    resetStreamState();
+   }
  }
 
 
 /* ------------------------ 'DOWNLOAD' Operation Methods ------------------------ */
 
+/**
+ * @brief  Confirms the download of the current stream's file to the SafeCloud server where, if the server
+ *         supports ranged downloads:\n\n
+ *            - The download is resumable, its verified contents being preserved in the user's "resume" directory
+ *              should it be interrupted, keyed by the name, size and last modification time of the file in the
+ *              storage pool (where the partial downloads of the file's other versions are deleted)\n\n
+ *            - If an interrupted download of the same version of the file was preserved or, in tail mode, the
+ *              copy of the file in the download directory is shorter than the one in the storage pool, they are
+ *              claimed as the download's temporary file and only the file's contents past them are downloaded
+ *              by confirming the download with a 'DOWNLOAD_RANGE' message\n\n
+ *         with failures in preparing the download's resumption only causing the whole file to be downloaded
+ * @param  tail Whether the copy of the file in the download directory is assumed to be a prefix of the file
+ *              in the storage pool, as for append-only files (e.g. logs), so that only its tail is downloaded
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL    EVP_MD digest failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_CLI_DISCONNECTED         The server disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void CliSessMgr::confirmDownload(bool tail)
+ {
+  // The digest of the file's name and its hexadecimal representation
+  unsigned char nameDigest[EVP_MAX_MD_SIZE];
+  unsigned int  nameDigestSize;
+  char          nameDigestHex[2 * EVP_MAX_MD_SIZE + 1];
+
+  // The names of the partial downloads of the file's versions, sharing the file name's digest
+  // as a prefix so that they can be recognized without storing the file's name in clear,
+  // and the one of the partial download of the version being downloaded
+  std::string partialPrefix;
+  std::string partialName;
+
+  DIR*         dir;           // The user's partial downloads directory
+  dirent*      dirEntry;      // An entry of the partial downloads directory
+  std::string  srcPath;       // The path of the contents the download is resumed from, if any
+  struct stat  srcInfo;       // Information on the contents the download is resumed from
+  std::string  claimPath;     // The path the contents the download is resumed from are moved to
+  int          claimFd;       // The file descriptor of the claimed contents
+  FILE*        claimDscr;     // The descriptor of the claimed contents
+
+  // The size of the file to be downloaded
+  long int fileSize = _stream->remFileInfo->meta->fileSizeRaw;
+
+  // If the server does not support ranged downloads, the whole file is downloaded as usual
+  if(!_connMgr._rangedDownloads)
+   {
+    sendCliSessSignalMsg(CONFIRM);
+    return;
+   }
+
+  // Open the user's partial downloads directory, creating it if it does not exist
+  dir = opendir(_resumeDirPath.c_str());
+  if(dir == nullptr)
+   {
+    if(errno != ENOENT)
+     LOG_EXEC_CODE(ERR_DIR_OPEN_FAILED, _resumeDirPath, ERRNO_DESC);
+    else
+     if(mkdir(_resumeDirPath.c_str(), 0700) != 0)
+      LOG_EXEC_CODE(ERR_DIR_CREATE_FAILED, _resumeDirPath, ERRNO_DESC);
+     else
+      dir = opendir(_resumeDirPath.c_str());
+
+    // If the directory is not available the download is not resumable
+    if(dir == nullptr)
+     {
+      sendCliSessSignalMsg(CONFIRM);
+      return;
+     }
+   }
+
+  // Determine the name of the file's partial download
+  if(EVP_Digest(_stream->remFileInfo->fileName.data(), _stream->remFileInfo->fileName.size(), nameDigest,
+                &nameDigestSize, EVP_sha256(), NULL) != 1)
+   {
+    closedir(dir);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_FINAL, OSSL_ERR_DESC);
+   }
+  for(unsigned int i = 0; i < nameDigestSize; i++)
+   sprintf(&nameDigestHex[2 * i], "%02x", nameDigest[i]);
+  partialPrefix = std::string(nameDigestHex, 2 * nameDigestSize) + "_";
+  partialName   = partialPrefix + std::to_string(fileSize) + "_" + std::to_string(_stream->remFileInfo->meta->lastModTimeRaw);
+
+  // Delete the partial downloads of the file's other versions, which can no longer be resumed,
+  // including their contents claimed by downloads that were never completed nor preserved
+  while((dirEntry = readdir(dir)) != nullptr)
+   if(strncmp(dirEntry->d_name, partialPrefix.c_str(), partialPrefix.size()) == 0 &&
+      partialName != dirEntry->d_name && std::string(dirEntry->d_name).rfind(partialName + "_", 0) != 0 &&
+      remove((_resumeDirPath + dirEntry->d_name).c_str()) != 0)
+    LOG_EXEC_CODE(ERR_FILE_DELETE_FAILED, _resumeDirPath + dirEntry->d_name, ERRNO_DESC);
+  closedir(dir);
+
+  // Make the download resumable
+  _stream->resumeFileAbsPath = new std::string(_resumeDirPath + partialName);
+
+  // Resume the download from its partial download, if any, deleting
+  // it if it cannot have been produced by a download of the file
+  if(stat(_stream->resumeFileAbsPath->c_str(), &srcInfo) == 0 && S_ISREG(srcInfo.st_mode))
+   {
+    if(srcInfo.st_size > 0 && srcInfo.st_size < fileSize)
+     srcPath = *_stream->resumeFileAbsPath;
+    else
+     if(remove(_stream->resumeFileAbsPath->c_str()) != 0)
+      LOG_EXEC_CODE(ERR_FILE_DELETE_FAILED, *_stream->resumeFileAbsPath, ERRNO_DESC);
+   }
+
+  // Otherwise in tail mode resume it from the shorter copy of the file in the download directory
+  if(srcPath.empty() && tail && _stream->mainFileInfo != nullptr &&
+     _stream->mainFileInfo->meta->fileSizeRaw > 0 && _stream->mainFileInfo->meta->fileSizeRaw < fileSize &&
+     stat(_stream->mainFileAbsPath->c_str(), &srcInfo) == 0)
+   srcPath = *_stream->mainFileAbsPath;
+
+  // If the download is resumed, claim its contents by moving them to a path private to the download's
+  // stream and opening them in write mode (without truncating them) positioned at their end, where
+  // the download in tail mode removes the file from the download directory until it completes, so
+  // that the directory never holds a partially downloaded file (as should it be interrupted its
+  // contents are preserved as the file's partial download, from which it is resumed)
+  if(!srcPath.empty())
+   {
+    claimPath = *_stream->resumeFileAbsPath + "_" + std::to_string(_stream->streamId);
+    if(rename(srcPath.c_str(), claimPath.c_str()) != 0)
+     LOG_EXEC_CODE(ERR_FILE_RENAME_FAILED, srcPath, ERRNO_DESC);
+    else
+     {
+      claimFd = open(claimPath.c_str(), O_WRONLY);
+      if(claimFd == -1 || lseek(claimFd, srcInfo.st_size, SEEK_SET) == -1 ||
+         (claimDscr = fdopen(claimFd, "wb")) == nullptr)
+       {
+        // Restore the claimed contents where they were
+        LOG_EXEC_CODE(ERR_FILE_OPEN_FAILED, claimPath, ERRNO_DESC);
+        if(claimFd != -1)
+         close(claimFd);
+        if(rename(claimPath.c_str(), srcPath.c_str()) != 0)
+         LOG_EXEC_CODE(ERR_FILE_RENAME_FAILED, claimPath, ERRNO_DESC);
+       }
+
+      // Set the claimed contents as the download's temporary file, and
+      // confirm the download of the file's contents past them only
+      else
+       {
+        delete _stream->tmpFileAbsPath;
+        _stream->tmpFileAbsPath = new std::string(claimPath);
+        _stream->tmpFileDscr    = claimDscr;
+        _stream->rawOffset      = srcInfo.st_size;
+        sendSessMsgDownloadRange();
+
+        if(srcPath == *_stream->mainFileAbsPath)
+         std::cout << "\nDownloading the last " + std::to_string(fileSize - srcInfo.st_size) + " bytes of file \""
+                      + _stream->remFileInfo->fileName + "\" past its copy in your download directory" << std::endl;
+        else
+         std::cout << "\nResuming the interrupted download of file \"" + _stream->remFileInfo->fileName + "\" ("
+                      + std::to_string(_stream->rawOffset * 100 / fileSize) + "% already downloaded)" << std::endl;
+        return;
+       }
+     }
+   }
+
+  // Otherwise confirm the download of the whole file
+  sendCliSessSignalMsg(CONFIRM);
+ }
+
+
 /**
  * @brief  Parses the 'FILE_DOWNLOAD_REQ' session response message returned by the SafeCloud server, where:\n\n
  *            1) If the SafeCloud server has reported that the file to be downloaded does not exist in
@@ -634,7 +1416,15 @@ void CliSessMgr::uploadFileData()
  *                                           on whether the upload operation should continue\n\n
  *                                    2.4.3) Has a last modified time older than the one in the
  *                                           download directory, ask for user confirmation on
- *                                           whether the upload operation should continue
+ *                                           whether the upload operation should continue\n\n
+ *                  2.5) In tail mode, if the file to be downloaded is NOT empty and a file with such name does
+ *                       exist in the user's download directory, download only the file's contents past it if
+ *                       it is shorter, or otherwise cancel the download operation as the file in the
+ *                       storage pool has no tail to be downloaded\n\n
+ *         where confirmed downloads may be resumed from their interrupted downloads (see confirmDownload())
+ * @param  fileName The name of the file to be downloaded from the SafeCloud storage pool
+ * @param  tail     Whether the copy of the file in the download directory is assumed to be a
+ *                  prefix of the one in the storage pool, so that only its tail is downloaded
  * @return A boolean indicating whether the downloaded operation should continue
  * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid file values in the 'SessMsgFileInfo' message
  * @throws ERR_SESS_MAIN_FILE_IS_DIR    The main file was found to be a directory (!)
@@ -649,7 +1439,7 @@ void CliSessMgr::uploadFileData()
  * @throws ERR_SESS_UNEXPECTED_MESSAGE  An invalid 'FILE_DOWNLOAD_REQ' session
  *                                      message response type was received
  */
-bool CliSessMgr::parseDownloadResponse(std::string& fileName)
+bool CliSessMgr::parseDownloadResponse(std::string& fileName, bool tail)
  {
   // Depending on the 'FILE_DOWNLOAD_REQ' response message type:
   switch(_recvSessMsgType)
@@ -669,33 +1459,33 @@ bool CliSessMgr::parseDownloadResponse(std::string& fileName)
     // Otherwise, if the SafeCloud server has returned the information on the file to be downloaded
     case FILE_EXISTS:
 
-     // Load into the '_remFileInfo' attribute the name and
+     // Load into the 'remFileInfo' attribute the name and
      // metadata of the file the client is requesting to download
      loadRemSessMsgFileInfo();
 
      // Ensure that the file information received from the server
      // refer to a file with the same name of the one to be downloaded
-     if(_remFileInfo->fileName != fileName)
+     if(_stream->remFileInfo->fileName != fileName)
       sendCliSessSignalMsg(ERR_MALFORMED_SESS_MESSAGE,"Received as a FILE_DOWNLOAD_REQ response information on a "
-                                                      "file (\"" + _remFileInfo->fileName + "\") different from the "
+                                                      "file (\"" + _stream->remFileInfo->fileName + "\") different from the "
                                                       "one the client wants to download (\"" + fileName + "\")");
 
      // Check whether a file with the same name of the one to be downloaded already exists in the client's
-     // download directory by attempting to load its information into the '_mainFileInfo' attribute
+     // download directory by attempting to load its information into the 'mainFileInfo' attribute
      checkLoadMainFileInfo();
 
      // If the file to be downloaded is empty and the file in the user's download
      // directory does not exist or is empty, the download operation should proceed
-     if(_remFileInfo->meta->fileSizeRaw == 0 &&
-        (_mainFileInfo == nullptr || _mainFileInfo->meta->fileSizeRaw == 0))
+     if(_stream->remFileInfo->meta->fileSizeRaw == 0 &&
+        (_stream->mainFileInfo == nullptr || _stream->mainFileInfo->meta->fileSizeRaw == 0))
       return true;
 
      // If a file with the same name of the one to be downloaded
      // was not found in the client's download directory
-     if(_mainFileInfo == nullptr)
+     if(_stream->mainFileInfo == nullptr)
       {
        // Confirm the download operation on the SafeCloud server
-       sendCliSessSignalMsg(CONFIRM);
+       confirmDownload(tail);
 
        // Return that the download operation should proceed
        return true;
@@ -709,7 +1499,7 @@ bool CliSessMgr::parseDownloadResponse(std::string& fileName)
        /* [PATCH] */
        // If the file to be downloaded is empty and, at this point, the
        // file with the same name in the user's download directory is not
-       if(_remFileInfo->meta->fileSizeRaw == 0)
+       if(_stream->remFileInfo->meta->fileSizeRaw == 0)
         {
          // Inform the user that the download would result in overwriting
          // a non-empty with an empty file in their download directory
@@ -717,7 +1507,7 @@ bool CliSessMgr::parseDownloadResponse(std::string& fileName)
                       "file in your download directory" << std::endl;
 
          // Print a table comparing the metadata of the main and remote file
-         _mainFileInfo->compareMetadata(_remFileInfo);
+         _stream->mainFileInfo->compareMetadata(_stream->remFileInfo);
 
          // Ask the user whether the download operation should proceed
          if(Client::askUser("Do you want to continue downloading the file?"))
@@ -734,12 +1524,29 @@ bool CliSessMgr::parseDownloadResponse(std::string& fileName)
           }
         }
 
+       // In tail mode, if the file in the download directory is assumed to be a prefix of the one in the
+       // storage pool (as for append-only files), download only the latter's tail if it is longer or
+       // otherwise inform the user that the file in the storage pool has no tail to be downloaded
+       if(tail && _stream->remFileInfo->meta->fileSizeRaw != 0)
+        {
+         if(_stream->mainFileInfo->meta->fileSizeRaw < _stream->remFileInfo->meta->fileSizeRaw)
+          {
+           confirmDownload(tail);
+           return true;
+          }
+
+         std::cout << "\nThe \"" + _stream->mainFileInfo->fileName + "\" file in your download directory is not "
+                      "shorter than the one in your storage pool, which has no tail to be downloaded" << std::endl;
+         sendCliSessSignalMsg(CANCEL);
+         return false;
+        }
+
        // If the file on the storage pool was more recently
        // modified than the one in the client's download directory
-       if(_remFileInfo->meta->lastModTimeRaw > _mainFileInfo->meta->lastModTimeRaw)
+       if(_stream->remFileInfo->meta->lastModTimeRaw > _stream->mainFileInfo->meta->lastModTimeRaw)
         {
          // Confirm the download operation on the SafeCloud server
-         sendCliSessSignalMsg(CONFIRM);
+         confirmDownload(tail);
 
          // Return that the download operation should proceed
          return true;
@@ -747,12 +1554,12 @@ bool CliSessMgr::parseDownloadResponse(std::string& fileName)
 
        // Otherwise, if the file on the storage pool and the one in the
        // download directory have the same size and last modified time
-       if(_mainFileInfo->meta->lastModTimeRaw == _remFileInfo->meta->lastModTimeRaw
-          && _mainFileInfo->meta->fileSizeRaw == _remFileInfo->meta->fileSizeRaw)
+       if(_stream->mainFileInfo->meta->lastModTimeRaw == _stream->remFileInfo->meta->lastModTimeRaw
+          && _stream->mainFileInfo->meta->fileSizeRaw == _stream->remFileInfo->meta->fileSizeRaw)
         {
          // Inform the user that the most recent version of the file they
          // want to download probably is already in their download directory
-         std::cout << "\nYour download directory already contains a \"" + _mainFileInfo->fileName
+         std::cout << "\nYour download directory already contains a \"" + _stream->mainFileInfo->fileName
                       + "\" file of the same size and last modified time of the one in your storage pool" << std::endl;
 
          // Ask for user confirmation on whether to continue the file download, also sending
@@ -762,11 +1569,11 @@ bool CliSessMgr::parseDownloadResponse(std::string& fileName)
 
        // Otherwise, if the file in the download directory was more
        // recently modified than the one in the client's storage pool
-       if(_mainFileInfo->meta->lastModTimeRaw > _remFileInfo->meta->lastModTimeRaw)
+       if(_stream->mainFileInfo->meta->lastModTimeRaw > _stream->remFileInfo->meta->lastModTimeRaw)
         {
          // Inform the user that the file in their download directory is more recent than the one to be downloaded
          std::cout << "Your download directory contains a more recent version"
-                      " of the \"" + _mainFileInfo->fileName + "\" file" << std::endl;
+                      " of the \"" + _stream->mainFileInfo->fileName + "\" file" << std::endl;
 
          // Ask for user confirmation on whether to continue the file download, also sending
          // the operation confirmation or cancellation notification to the SafeCloud server
@@ -786,70 +1593,242 @@ bool CliSessMgr::parseDownloadResponse(std::string& fileName)
 
 
 /**
- * @brief Downloads a file's raw contents from the user's SafeCloud storage pool by:\n\n
- *            1) Preparing the client session manager to receive the file's raw contents.\n\n
- *            2) Receiving and decrypting the file's raw contents.\n\n
- *            3) Verifying the file trailing integrity tag.\n\n
- *            4) Moving the resulting temporary file into the associated
- *               associated main file in the user's download directory.\n\n
- *            5) Setting the main file last modified time to
- *               the one specified in the '_remFileInfo' object.\n\n
- *            6) Notifying the success of the download operation to the SafeCloud server.
- * @param  fileName The name of the file to be downloaded from the SafeCloud storage pool
- * @throws ERR_SESSABORT_INTERNAL_ERROR   Invalid session manager operation or step
- *                                        for receiving a file's raw contents
- * @throws ERR_SESS_FILE_OPEN_FAILED      Failed to open the temporary file
- *                                        descriptor in write-byte mode
- * @throws ERR_FILE_WRITE_FAILED          Error in writing to the temporary file
+ * @brief Download pipeline receiving stage, receiving the 'FILE_SEGMENT' messages of the session's streams
+ *        in the 'WAITING_RAW' step and their segments from the SafeCloud server into the ciphertext
+ *        buffers of the pipeline slots, passing them to the decryption stage
+ * @param downloadPipe The file download pipeline
+ * @param totBytes     The total size of the files being downloaded
+ * @note  Being executed in a separate thread, the stage never throws, with
+ *        its exceptions aborting the pipeline and being stored within it
+ */
+void CliSessMgr::downloadRecvStage(FilePipe& downloadPipe, long int totBytes)
+ {
+  // The index of the pipeline slot the segment is received into
+  unsigned int slotIdx;
+
+  // The number of bytes of each stream's file yet to be announced by the server
+  // (as the streams' 'rawBytesRem' attributes are updated by the decryption stage)
+  uint64_t announcedRem[SESS_MAX_STREAMS] = {0};
+
+  // The number of file bytes whose segments have been received
+  long int recvBytes = 0;
+
+  try
+   {
+    // Initialize the number of bytes yet to be announced of each file
+    for(SessStream* stream : _streams)
+     if(stream->opStep == WAITING_RAW)
+      announcedRem[stream->streamId] = stream->rawBytesRem;
+
+    while(recvBytes < totBytes)
+     {
+      // Wait for a free pipeline slot (returning if the pipeline was aborted)
+      if(!downloadPipe.takeSlot(DOWNLOAD_STAGE_RECV, slotIdx))
+       return;
+      FilePipe::Slot& slot = downloadPipe.getSlot(slotIdx);
+
+      // Block until the next segment's announcement is received, selecting its stream
+      recvCheckCliSessMsg();
+      if(_recvSessMsgType != FILE_SEGMENT)
+       sendCliSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"Received a session message of type " +
+                                                        std::to_string(_recvSessMsgType) +
+                                                        " while awaiting for a file segment");
+
+      // Read the segment's stream and its plaintext and wire sizes and key epoch
+      slot.streamId = _stream->streamId;
+      slot.ptSize = loadSessMsgFileSegment(announcedRem[slot.streamId], slot.ctSize, slot.keyEpoch);
+      announcedRem[slot.streamId] -= slot.ptSize;
+
+      // Block until the segment's chunks and their integrity tags have been
+      // completely received from the server into the slot's ciphertext buffer
+      _connMgr.recvRaw(slot.ctBuf, slot.ctSize);
+      recvBytes += slot.ptSize;
+
+      // Pass the slot to the decryption stage
+      downloadPipe.passSlot(DOWNLOAD_STAGE_RECV, slotIdx);
+     }
+   }
+  catch(...)
+   { downloadPipe.abort(std::current_exception()); }
+ }
+
+
+/**
+ * @brief Download pipeline decryption stage, verifying and decrypting the segments in the pipeline slots
+ *        with the chunk IVs of their streams from their ciphertext into their plaintext buffers and
+ *        passing them to the writing stage
+ * @param downloadPipe The file download pipeline
+ * @param totBytes     The total size of the files being downloaded
+ * @note  Being executed in a separate thread, the stage never throws, with
+ *        its exceptions aborting the pipeline and being stored within it
+ */
+void CliSessMgr::downloadDecryptStage(FilePipe& downloadPipe, long int totBytes)
+ {
+  // The index of the pipeline slot whose segment is decrypted
+  unsigned int slotIdx;
+
+  // The number of file bytes that have been decrypted
+  long int decBytes = 0;
+
+  try
+   {
+    while(decBytes < totBytes)
+     {
+      // Wait for a received segment (returning if the pipeline was aborted)
+      if(!downloadPipe.takeSlot(DOWNLOAD_STAGE_DECRYPT, slotIdx))
+       return;
+      FilePipe::Slot& slot = downloadPipe.getSlot(slotIdx);
+
+      // Verify and decrypt the segment's chunks from the slot's ciphertext into its plaintext buffer (this
+      // stage being the only one accessing the cryptographic state of the file chunks)
+      decryptFileSegment(*_streams[slot.streamId], slot.ptSize, slot.ctSize, slot.keyEpoch, slot.ctBuf, slot.ptBuf);
+      decBytes += slot.ptSize;
+
+      // Pass the slot to the writing stage
+      downloadPipe.passSlot(DOWNLOAD_STAGE_DECRYPT, slotIdx);
+     }
+   }
+  catch(...)
+   { downloadPipe.abort(std::current_exception()); }
+ }
+
+
+/**
+ * @brief  Download pipeline writing stage helper, writing the plaintexts of a batch of consecutive
+ *         decrypted segments of a same stream into its temporary file with a single writev()
+ * @param  downloadPipe The file download pipeline
+ * @param  slotIdxs     The indexes of the pipeline slots holding the segments, in file order
+ * @param  numSlots     The number of slots in the batch
+ * @throws ERR_FILE_WRITE_FAILED Error in writing to the temporary file
+ */
+void CliSessMgr::downloadWriteBatch(FilePipe& downloadPipe, unsigned int* slotIdxs, unsigned int numSlots)
+ {
+  // The stream the segments belong to
+  SessStream& stream = *_streams[downloadPipe.getSlot(slotIdxs[0]).streamId];
+
+  // The I/O vectors of the segments' plaintexts
+  struct iovec segIov[DOWNLOAD_PIPE_SLOTS];
+
+  // The index of the first I/O vector not completely written yet
+  unsigned int iovInd = 0;
+
+  // writev() return, representing the number of
+  // bytes written into the temporary file
+  ssize_t writevRet;
+
+  // Initialize the I/O vectors of the segments' plaintexts
+  for(unsigned int i = 0; i < numSlots; i++)
+   {
+    segIov[i].iov_base = downloadPipe.getSlot(slotIdxs[i]).ptBuf;
+    segIov[i].iov_len  = downloadPipe.getSlot(slotIdxs[i]).ptSize;
+   }
+
+  // Write the segments' plaintexts into the temporary file, resuming partial writes
+  while(iovInd < numSlots)
+   {
+    writevRet = writev(fileno(stream.tmpFileDscr), &segIov[iovInd], (int)(numSlots - iovInd));
+
+    // Writing into the temporary file is a critical error that in the current session state
+    // cannot be notified to the server and so require the connection to be dropped
+    if(writevRet < 0)
+     {
+      if(errno == EINTR)
+       continue;
+      THROW_EXEC_EXCP(ERR_FILE_WRITE_FAILED,"file: " + *stream.tmpFileAbsPath + ", download operation aborted",
+                      ERRNO_DESC);
+     }
+
+    // Skip the I/O vectors that have been completely
+    // written and advance the partially written one
+    while(iovInd < numSlots && (size_t)writevRet >= segIov[iovInd].iov_len)
+     writevRet -= (ssize_t)segIov[iovInd++].iov_len;
+    if(iovInd < numSlots)
+     {
+      segIov[iovInd].iov_base = (unsigned char*)segIov[iovInd].iov_base + writevRet;
+      segIov[iovInd].iov_len -= writevRet;
+     }
+   }
+ }
+
+
+/**
+ * @brief Downloads the raw contents of the files of the session's streams in the 'WAITING_RAW' step, each
+ *        prepared to receive its file's raw contents, by receiving their interleaved segments of individually
+ *        authenticated chunks and verifying, decrypting and writing each segment into its stream's temporary
+ *        file through a pipeline where the reception, decryption and writing of different segments overlap
+ * @throws ERR_SESSABORT_INVALID_FILE_SEGMENT     Unexpected or invalid file segment announcement
+ * @throws ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED A file chunk other than the last failed its integrity verification
+ * @throws ERR_FILE_WRITE_FAILED          Error in writing to a temporary file
  * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE   The ciphertext block size is non-positive (probable overflow)
  * @throws ERR_OSSL_EVP_DECRYPT_UPDATE    EVP_CIPHER decrypt update failed
  * @throws ERR_OSSL_SET_TAG_FAILED        Error in setting the expected file integrity tag
  * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED File integrity verification failed
- * @throws ERR_SESS_FILE_CLOSE_FAILED     Error in closing the temporary file
- * @throws ERR_SESS_FILE_RENAME_FAILED    Error in moving the temporary file to the main directory
- * @throws ERR_SESS_FILE_META_SET_FAILED  Error in setting the main file's last modification time
- * @throws ERR_OSSL_EVP_ENCRYPT_INIT      EVP_CIPHER encrypt initialization failed
- * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE    EVP_CIPHER encrypt update failed
- * @throws ERR_OSSL_EVP_ENCRYPT_FINAL     EVP_CIPHER encrypt final failed
- * @throws ERR_OSSL_GET_TAG_FAILED        Error in retrieving the resulting integrity tag
- * @throws ERR_PEER_DISCONNECTED          The connection peer disconnected during the send()
- * @throws ERR_SEND_FAILED                send() fatal error
- * @throws ERR_SESS_INTERNAL_ERROR        Failed to close or move the downloaded temporary
- *                                        file or NULL session attributes
+ * @throws ERR_PEER_DISCONNECTED          The connection peer disconnected during the recv()
+ * @throws ERR_CSK_RECV_FAILED            Error in receiving data from the connection socket
  */
-void CliSessMgr::downloadFileData()
+void CliSessMgr::downloadFilesData()
  {
-  // Prepare the client session manager to receive
-  // the raw contents of the file to be downloaded
-  prepRecvFileRaw();
+  // The number of files being downloaded and their total size
+  unsigned char numFiles = 0;
+  long int totBytes = 0;
 
-  // The number of raw file bytes read from the
-  // connection socket into the primary connection buffer
-  size_t recvBytes;
+  // The stream of the (last) file being downloaded
+  SessStream* fileStream = nullptr;
+
+  // The maximum plaintext size of the files' segments
+  unsigned int maxSegSize = 0;
+
+  // The download pipeline receiving and decryption threads
+  std::thread recvThread;
+  std::thread decryptThread;
+
+  // The indexes of the pipeline slots whose segments are written in a batch
+  unsigned int batchSlotIdxs[DOWNLOAD_PIPE_SLOTS];
+  unsigned int batchSize;
+
+  // The bounds of a run of consecutive segments of a same stream in the batch
+  unsigned int runStart;
+  unsigned int runEnd;
 
-  // fwrite() return, representing the number of bytes written
-  // from the secondary connection buffer into the temporary file
-  size_t fwriteRet;
+  // The number of file bytes that have been written
+  long int writtenBytes = 0;
 
   // A progress bar possibly used for displaying the
-  // file's download progress discretized between 0-100%
+  // files' download progress discretized between 0-100%
   ProgressBar downloadProgBar(100);
 
   // The previous and current download progress discretized between 0-100%
   unsigned char prevDownloadProg = 0;
   unsigned char currDownloadProg;
 
-  // If the file to be downloaded is large enough, display
+  // Determine the number and total size of the files being downloaded and their maximum segment size
+  for(SessStream* stream : _streams)
+   if(stream->opStep == WAITING_RAW)
+    {
+     fileStream = stream;
+     numFiles++;
+     totBytes += (long int)stream->rawBytesRem;
+     maxSegSize = std::max(maxSegSize, (unsigned int)std::min(stream->rawBytesRem, (uint64_t)FILE_SEGMENT_SIZE));
+    }
+
+  // The file download pipeline, whose slots hold a segment's ciphertext and
+  // plaintext and are sized so to fit the files' largest segment
+  FilePipe downloadPipe(DOWNLOAD_STAGES, DOWNLOAD_PIPE_SLOTS, maxSegSize, fileSegmentWireSize(maxSegSize));
+
+  // If the files to be downloaded are large enough, display
   // the download progress to the user via a progress bar
-  bool showProgBar = _remFileInfo->meta->fileSizeRaw > (_connMgr._priBufSize * 5);
+  bool showProgBar = totBytes > (_connMgr._priBufSize * 5);
 
   // If the download progress bar should be displayed
   if(showProgBar)
    {
     // Print an introductory downloaded message
-    std::cout << "\nDownloading file \"" + _remFileInfo->fileName + "\" ("
-                 + _remFileInfo->meta->fileSizeStr + ") from the storage pool:\n" << std::endl;
+    if(numFiles == 1)
+     std::cout << "\nDownloading file \"" + fileStream->remFileInfo->fileName + "\" ("
+                  + fileStream->remFileInfo->meta->fileSizeStr + ") from the storage pool:\n" << std::endl;
+    else
+     std::cout << "\nDownloading " + std::to_string(numFiles) + " files from the storage pool:\n" << std::endl;
 
     // Display the progress bar with 0% completion
     downloadProgBar.update();
@@ -857,76 +1836,236 @@ void CliSessMgr::downloadFileData()
 
   // ------------------------------- File Download Loop ------------------------------- //
 
-  do
+  try
    {
-    // Receive any number of raw file bytes
-    recvBytes = _connMgr.recvRaw();
+    // Start the download pipeline receiving and decryption stages
+    recvThread = std::thread(&CliSessMgr::downloadRecvStage, this, std::ref(downloadPipe), totBytes);
+    decryptThread = std::thread(&CliSessMgr::downloadDecryptStage, this, std::ref(downloadPipe), totBytes);
 
-    // Decrypted the received file raw bytes from the primary into the secondary connection buffer
-    _aesGCMMgr.decryptAddCT(&_connMgr._priBuf[0], (int)recvBytes, &_connMgr._secBuf[0]);
+    // Writing stage, executed in the calling thread
+    while(writtenBytes < totBytes)
+     {
+      // Wait for a decrypted segment (breaking if the pipeline was aborted)
+      if(!downloadPipe.takeSlot(DOWNLOAD_STAGE_WRITE, batchSlotIdxs[0]))
+       break;
 
-    // Write the decrypted file bytes from the secondary buffer into the temporary file
-    fwriteRet = fwrite(_connMgr._secBuf, sizeof(char), recvBytes, _tmpFileDscr);
+      // Batch any further decrypted segments already available
+      batchSize = 1;
+      while(batchSize < DOWNLOAD_PIPE_SLOTS && downloadPipe.tryTakeSlot(DOWNLOAD_STAGE_WRITE, batchSlotIdxs[batchSize]))
+       batchSize++;
 
-    // Writing into the temporary file less bytes than the ones received into the
-    // primary connection buffer is a critical error that in the current session state
-    // cannot be notified to the server and so require the connection to be dropped
-    if(fwriteRet < recvBytes)
-     THROW_EXEC_EXCP(ERR_FILE_WRITE_FAILED,"file: " + *_tmpFileAbsPath + ", download operation aborted","written " +
-                     std::to_string(fwriteRet) + " < recvBytes = " + std::to_string(recvBytes) + " bytes");
+      // Write each run of consecutive segments of a same stream into its temporary file
+      for(runStart = 0; runStart < batchSize; runStart = runEnd)
+       {
+        runEnd = runStart + 1;
+        while(runEnd < batchSize && downloadPipe.getSlot(batchSlotIdxs[runEnd]).streamId ==
+                                    downloadPipe.getSlot(batchSlotIdxs[runStart]).streamId)
+         runEnd++;
+        downloadWriteBatch(downloadPipe, &batchSlotIdxs[runStart], runEnd - runStart);
+       }
 
-    // Update the number of remaining bytes of the file being uploaded
-    _rawBytesRem -= recvBytes;
+      // Return the batch's slots to the receiving stage
+      for(unsigned int i = 0; i < batchSize; i++)
+       {
+        writtenBytes += downloadPipe.getSlot(batchSlotIdxs[i]).ptSize;
+        downloadPipe.passSlot(DOWNLOAD_STAGE_WRITE, batchSlotIdxs[i]);
+       }
 
-    // If the download progress bar should be displayed
-    if(showProgBar)
-     {
-      // Compute the current download progress discretized between 0-100%
-      currDownloadProg = (unsigned char)((float)(_remFileInfo->meta->fileSizeRaw - _rawBytesRem) /
-                                         (float)_remFileInfo->meta->fileSizeRaw * 100);
+      // If the download progress bar should be displayed
+      if(showProgBar)
+       {
+        // Compute the current download progress discretized between 0-100%
+        currDownloadProg = (unsigned char)((float)writtenBytes / (float)totBytes * 100);
 
-      // Update the progress bar to the current download progress
-      for(unsigned char i = prevDownloadProg; i < currDownloadProg; i++)
-       downloadProgBar.update();
+        // Update the progress bar to the current download progress
+        for(unsigned char i = prevDownloadProg; i < currDownloadProg; i++)
+         downloadProgBar.update();
 
-      // Update the previous download progress
-      prevDownloadProg = currDownloadProg;
+        // Update the previous download progress
+        prevDownloadProg = currDownloadProg;
+       }
      }
+   }
+  catch(...)
+   { downloadPipe.abort(std::current_exception()); }
 
-    // Update the associated connection manager's expected data block
-    // size to the number of remaining file bytes to be received
-    _connMgr._recvBlockSize = _rawBytesRem;
-
-    // Reset the index of the most significant byte in the primary connection buffer
-    _connMgr._priBufInd = 0;
-
-   } while(_rawBytesRem != 0);
+  // Wait for the download pipeline receiving and decryption stages to terminate
+  if(recvThread.joinable())
+   recvThread.join();
+  if(decryptThread.joinable())
+   decryptThread.join();
 
-  // ------------------------ File Integrity Tag Verification ------------------------ //
+  // ----------------------------- End File Download Loop ----------------------------- //
 
   // Indentation
   if(showProgBar)
    printf("\n");
 
-  // Reset the index of the most significant byte in the primary connection buffer
-  _connMgr._priBufInd = 0;
+  // If an error occurred in any stage of the download pipeline, rethrow it
+  downloadPipe.rethrowAbortExcp();
+ }
 
-  // Set the associated connection manager primary buffer to
-  // receive bytes up to the size of an AES_128_GCM integrity tag
-  _connMgr._recvBlockSize = AES_128_GCM_TAG_SIZE;
 
-  // Block until the complete file integrity tag has been received
-  while(_connMgr._priBufInd != AES_128_GCM_TAG_SIZE)
-   _connMgr.recvRaw();
+/**
+ * @brief  Downloads a batch of up to SESS_MAX_STREAMS files from the user's SafeCloud storage
+ *         pool, carrying out each download operation on its own session stream by:\n\n
+ *            1) Sending the download requests of all files.\n\n
+ *            2) Parsing the server's responses to the download requests, in order, with empty
+ *               files being directly touched in the download directory.\n\n
+ *            3) Downloading the raw contents of the confirmed files, whose segments are
+ *               interleaved on the connection (see the downloadFilesData() method).\n\n
+ *            4) Finalizing each downloaded file and notifying its
+ *               download completion to the SafeCloud server.
+ * @param  fileNames The names of the files to be downloaded from the user's SafeCloud storage pool
+ * @param  firstFile The index in 'fileNames' of the first file of the batch
+ * @param  numFiles  The number of files in the batch (<= SESS_MAX_STREAMS)
+ * @param  authOnly  Whether the files' contents should be authenticated only instead of decrypted
+ * @param  tail      Whether only the tails of the files past their shorter copies in the download
+ *                   directory should be downloaded, as for append-only files (e.g. logs)
+ * @note   Recoverable errors of a file's download operation are reported to the user
+ *         and only abort such operation, leaving the other ones of the batch unaffected
+ * @throws Most of the session-aborting and OpenSSL exceptions
+ *         (see "execErrCode.h" for more details)
+ */
+void CliSessMgr::downloadFilesBatch(std::vector<std::string>& fileNames, size_t firstFile, unsigned char numFiles, bool authOnly, bool tail)
+ {
+  // The number of streams awaiting a server response
+  unsigned char numPending = 0;
 
-  /*
-   * Finalize the downloaded file by:
-   *    1) Verifying its integrity tag
-   *    2) Moving it from the temporary into the download directory
-   *    3) Setting its last modified time to the one
-   *       specified in the '_remFileInfo' object
-   */
-  finalizeRecvFileRaw();
+  // Whether the raw contents of any file should be downloaded
+  bool recvRaw = false;
+
+  // ---------------------------- Download Requests ---------------------------- //
+
+  for(unsigned char streamInd = 0; streamInd < numFiles; streamInd++)
+   {
+    _stream = _streams[streamInd];
+    try
+     {
+      // Initialize the stream operation and whether its file's contents are authenticated only
+      _stream->op = DOWNLOAD;
+      _stream->authOnly = authOnly;
+
+      // Assert the file name string to consist of a valid Linux file name
+      validateFileName(fileNames[firstFile + streamInd]);
+
+      // Initialize the main and temporary absolute paths of the file to be downloaded
+      _stream->mainFileAbsPath = new std::string(*_mainDirAbsPath + "/" + fileNames[firstFile + streamInd]);
+      _stream->tmpFileAbsPath  = new std::string(*_tmpDirAbsPath + "/" + fileNames[firstFile + streamInd] + "_PART");
+
+      /*
+      // LOG: Main and temporary files absolute paths
+      std::cout << "_stream->mainFileAbsPath = " << *_stream->mainFileAbsPath << std::endl;
+      std::cout << "_stream->tmpFileAbsPath = " << *_stream->tmpFileAbsPath << std::endl;
+      */
+
+      // Prepare a 'SessMsgFileName' session message of type 'FILE_DOWNLOAD_REQ' containing
+      // the name of the file to be downloaded and send it to the SafeCloud server
+      sendSessMsgFileName(FILE_DOWNLOAD_REQ,fileNames[firstFile + streamInd]);
+
+      LOG_DEBUG("Sent 'FILE_DOWNLOAD_REQ' message to the server (stream = " + std::to_string(streamInd) +
+                ", file = \"" + fileNames[firstFile + streamInd] + "\")")
+
+      // Update the operation step so to expect a 'FILE_DOWNLOAD_REQ' response
+      _stream->opStep = WAITING_RESP;
+      numPending++;
+     }
+    catch(sessErrExcp& sessExcp)
+     {
+      handleSessErrException(sessExcp);
+      resetStreamState();
+     }
+   }
+
+  // ---------------------------- Download Responses ---------------------------- //
+
+  // The server answers the download requests in the order they were sent
+  for(; numPending > 0; numPending--)
+   {
+    try
+     {
+      // Block until a 'FILE_DOWNLOAD_REQ' response is received from the SafeCloud server
+      recvCheckCliSessMsg();
+
+      // Parse the 'FILE_DOWNLOAD_REQ' response, obtaining an indication on
+      // whether to proceed downloading the file from the SafeCloud server
+      if(!parseDownloadResponse(fileNames[firstFile + _stream->streamId], tail))
+       {
+        resetStreamState();
+        continue;
+       }
+
+      // If downloading a non-empty file, prepare the stream to receive its raw contents
+      if(_stream->remFileInfo->meta->fileSizeRaw != 0)
+       {
+        prepRecvFileRaw();
+        recvRaw = true;
+       }
+
+      // Otherwise, if downloading an empty file
+      else
+       {
+        // Touch the empty file in the client's download directory
+        touchEmptyFile();
+
+        // Notify the server that the empty file has been successfully downloaded
+        sendCliSessSignalMsg(COMPLETED);
+
+        // Inform the user that the empty file has been successfully downloaded
+        std::cout << "\nEmpty file \"" + _stream->remFileInfo->fileName + "\" successfully "
+                     "downloaded from the SafeCloud storage pool\n" << std::endl;
+
+        // Reset the stream state
+        resetStreamState();
+       }
+     }
+    catch(sessErrExcp& sessExcp)
+     {
+      handleSessErrException(sessExcp);
+      resetStreamState();
+     }
+   }
+
+  // ------------------------------ Files Download ------------------------------ //
+
+  // If no non-empty file should be downloaded, return
+  if(!recvRaw)
+   return;
+
+  // Receive the raw contents of the non-empty files
+  downloadFilesData();
+
+  // ---------------------------- Download Completions ---------------------------- //
+
+  for(SessStream* stream : _streams)
+   if(stream->opStep == WAITING_RAW)
+    {
+     _stream = stream;
+     try
+      {
+       /*
+        * Finalize the downloaded file, whose chunks have all been verified, by:
+        *    1) Moving it from the temporary into the download directory
+        *    2) Setting its last modified time to the one
+        *       specified in the 'remFileInfo' object
+        */
+       finalizeRecvFileRaw();
+
+       // Notify the server that the file download has been completed successfully
+       sendSessSignalMsg(COMPLETED);
+
+       // Inform the user that the file has been successfully downloaded to their download directory
+       std::cout << "\nFile \"" + _stream->remFileInfo->fileName + "\" (" + _stream->remFileInfo->meta->fileSizeStr +
+                    ") successfully downloaded into the download directory" +
+                    (_stream->authOnly ? " (authenticated only)" : "") + (_connMgr._compress ? ", " +
+                    compressionStatsStr(_stream->xferRawBytes, _stream->xferWireBytes) : "") + "\n" << std::endl;
+      }
+     catch(sessErrExcp& sessExcp)
+      { handleSessErrException(sessExcp); }
+
+     // Reset the stream state
+     resetStreamState();
+    }
  }
 
 
@@ -974,19 +2113,19 @@ bool CliSessMgr::parseDeleteResponse(std::string& fileName)
     // the information on the file to be deleted
     case FILE_EXISTS:
 
-     // Load into the '_remFileInfo' attribute the name and
+     // Load into the 'remFileInfo' attribute the name and
      // metadata of the file the client is requesting to delete
      loadRemSessMsgFileInfo();
 
      // Ensure that the file information received from the server
      // refer to a file with the same name of the one to be deleted
-     if(_remFileInfo->fileName != fileName)
+     if(_stream->remFileInfo->fileName != fileName)
       sendCliSessSignalMsg(ERR_MALFORMED_SESS_MESSAGE, "Received as a FILE_DELETE_REQ response information on a "
-                                                       "file (\"" + _remFileInfo->fileName + "\") different from "
+                                                       "file (\"" + _stream->remFileInfo->fileName + "\") different from "
                                                        "the one the client wants to delete (\"" + fileName + "\")");
 
      // Print the information on the file to be deleted
-     _remFileInfo->printFileInfo();
+     _stream->remFileInfo->printFileInfo();
 
      // Ask for user confirmation on whether proceeding deleting the file
      if(Client::askUser("Are you sure to delete this file from your storage pool?"))
@@ -1061,16 +2200,16 @@ void CliSessMgr::parseRenameResponse(std::string& oldFileName, std::string& newF
     // file with the same name of the one the user wants to rename the file to
     case FILE_EXISTS:
 
-     // Load into the '_remFileInfo' attribute the name and metadata of the
+     // Load into the 'remFileInfo' attribute the name and metadata of the
      // file with the same name of the one the user wants to rename the file to
      loadRemSessMsgFileInfo();
 
      // Ensure that the file information received from the server refer to a file with the same
      // name of the one the user wants to rename the file to, an error that should be thrown
      // directly without notifying the server as it has supposedly reset its session state
-     if(_remFileInfo->fileName != newFileName)
+     if(_stream->remFileInfo->fileName != newFileName)
       THROW_SESS_EXCP(ERR_SESS_MALFORMED_MESSAGE, "Received as a FILE_RESPONSE_REQ response information on a file"
-                                                  " (\"" + _remFileInfo->fileName + "\") different from the one "
+                                                  " (\"" + _stream->remFileInfo->fileName + "\") different from the one "
                                                   "the user wants to rename the file to (\"" + newFileName + "\")");
 
      // Inform the user that a file with the same name of the one they
@@ -1080,7 +2219,7 @@ void CliSessMgr::parseRenameResponse(std::string& oldFileName, std::string& newF
      // Print the information on the file with the same name
      // of the use the user wants to rename the file to
      // Print the information on the file to be deleted
-     _remFileInfo->printFileInfo();
+     _stream->remFileInfo->printFileInfo();
 
      // Inform the user that such a file should be in turn
      // renamed or deleted before renaming the original file
@@ -1118,31 +2257,31 @@ void CliSessMgr::parseRenameResponse(std::string& oldFileName, std::string& newF
 void CliSessMgr::prepRecvPoolRaw()
  {
   // Assert the client session manager to be in the 'LIST' operation
-  if(_sessMgrOp != LIST)
+  if(_stream->op != LIST)
    THROW_EXEC_EXCP(ERR_SESSABORT_INTERNAL_ERROR, "Preparing to receive the serialized user pool contents with the "
                                                  "client session manager in operation \"" + sessMgrOpToStrUpCase() +
                                                  "\", step " + sessMgrOpStepToStrUpCase());
 
-  // Assert the expected serialized pool contents' not to be empty as for the '_rawBytesRem' attribute
-  if(_rawBytesRem == 0)
+  // Assert the expected serialized pool contents' not to be empty as for the 'rawBytesRem' attribute
+  if(_stream->rawBytesRem == 0)
    THROW_EXEC_EXCP(ERR_SESSABORT_INTERNAL_ERROR, "Attempting to receive the empty serialized user pool contents");
 
   // Update the client session manager step so to expect raw data
-  _sessMgrOpStep = WAITING_RAW;
+  _stream->opStep = WAITING_RAW;
 
   // Set the reception mode of the associated connection manager to 'RECV_RAW'
   _connMgr._recvMode = ConnMgr::RECV_RAW;
 
   // Set the associated connection manager's expected block size to the
-  // serialized pool contents' size stored in the '_rawBytesRem' attribute
-  _connMgr._recvBlockSize = _rawBytesRem;
+  // serialized pool contents' size stored in the 'rawBytesRem' attribute
+  _connMgr._recvBlockSize = _stream->rawBytesRem;
 
   // Initialize the 'DirInfo' object used for
   // storing the contents of the user's storage pool
-  _mainDirInfo = new DirInfo();
+  _stream->mainDirInfo = new DirInfo();
 
   // Initialize the serialized pool contents' decryption operation
-  _aesGCMMgr.decryptInit();
+  _recvAESGCMMgr.decryptInit();
  }
 
 
@@ -1152,7 +2291,7 @@ void CliSessMgr::prepRecvPoolRaw()
  * @throws ERR_SESS_FILE_INVALID_NAME     Received a file of name
  * @throws ERR_SESS_FILE_META_NEGATIVE    Received a file with negative metadata values
  * @throws ERR_FILE_TOO_LARGE             Received a too large file (> 9999GB)
- * @throws ERR_SESS_DIR_INFO_OVERFLOW     The storage pool information size exceeds 4GB
+ * @throws ERR_SESS_DIR_INFO_OVERFLOW     The storage pool information size overflows a 64-bit integer
  * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE   The ciphertext block size is non-positive (probable overflow)
  * @throws ERR_OSSL_EVP_DECRYPT_UPDATE    EVP_CIPHER decrypt update failed
@@ -1202,15 +2341,15 @@ void CliSessMgr::recvPoolRawContents()
     // Decrypted the received serialized pool contents bytes
     // from the primary into the secondary connection buffer
     // after any bytes carried out from the previous cycle
-    _aesGCMMgr.decryptAddCT(&_connMgr._priBuf[carryOverBytes], (int)recvBytes,
-                            &_connMgr._secBuf[carryOverBytes]);
+    _recvAESGCMMgr.decryptAddCT(&_connMgr._priBuf[carryOverBytes], (int)recvBytes,
+                                &_connMgr._secBuf[carryOverBytes]);
 
     // Update the number of serialized pool contents' bytes to be received
-    _rawBytesRem -= recvBytes;
+    _stream->rawBytesRem -= recvBytes;
 
     // Update the associated connection manager's expected block size
     // to the number of serialized pool contents' bytes to be received
-    _connMgr._recvBlockSize = _rawBytesRem;
+    _connMgr._recvBlockSize = _stream->rawBytesRem;
 
     // Reset the index of the first available byte in the secondary
     // connection buffer at which reading the serialized pool contents
@@ -1259,7 +2398,7 @@ void CliSessMgr::recvPoolRawContents()
                               poolFileInfo->lastModTimeRaw, poolFileInfo->creationTimeRaw);
 
       // Add the FileInfo to the DirInfo object storing the contents of the user's storage pool
-      _mainDirInfo->addFileInfo(fileInfo);
+      _stream->mainDirInfo->addFileInfo(fileInfo);
 
       // Increment the index of the first available byte in the secondary connection
       // buffer of the size of the 'PoolFileInfo' struct that has been just read
@@ -1295,15 +2434,15 @@ void CliSessMgr::recvPoolRawContents()
      }
 
      // While the user's serialized pool contents have not been completely received
-   } while(_rawBytesRem > 0);
+   } while(_stream->rawBytesRem > 0);
 
   // --------------- End Serialized Pool Contents Reception Cycle --------------- //
 
   /*
   // LOG: User's storage pool contents
-  _mainDirInfo->printDirContents();
-  std::cout << "N° files = " << _mainDirInfo->numFiles << std::endl;
-  std::cout << "Pool contents' raw size = " << _mainDirInfo->dirRawSize << std::endl;
+  _stream->mainDirInfo->printDirContents();
+  std::cout << "N° files = " << _stream->mainDirInfo->numFiles << std::endl;
+  std::cout << "Pool contents' raw size = " << _stream->mainDirInfo->dirRawSize << std::endl;
   std::cout << "_connMgr._recvBlockSize = " << _connMgr._recvBlockSize << std::endl;
   */
 
@@ -1321,7 +2460,7 @@ void CliSessMgr::recvPoolRawContents()
    _connMgr.recvRaw();
 
   // Finalize the pool contents' decryption by verifying their integrity tag
-  _aesGCMMgr.decryptFinal(&_connMgr._priBuf[0]);
+  _recvAESGCMMgr.decryptFinal(&_connMgr._priBuf[0]);
  }
 
 
@@ -1333,7 +2472,8 @@ void CliSessMgr::recvPoolRawContents()
  * @param cliConnMgr A reference to the client connection manager parent object
  */
 CliSessMgr::CliSessMgr(CliConnMgr& cliConnMgr)
- : SessMgr(reinterpret_cast<ConnMgr&>(cliConnMgr),cliConnMgr._downDir)
+ : SessMgr(reinterpret_cast<ConnMgr&>(cliConnMgr),cliConnMgr._downDir,false,cliConnMgr._aesGCMPool), _cliConnMgr(cliConnMgr),
+   _resumeDirPath(CLI_USER_RESUME_DIR_PATH(*cliConnMgr._name))
  {}
 
 /* Same destructor of the 'SessMgr' base class */
@@ -1355,6 +2495,8 @@ CliSessMgr::CliSessMgr(CliConnMgr& cliConnMgr)
  *                                                    received an unexpected session message
  * @throws ERR_SESS_CLI_SRV_MALFORMED_MESSAGE         The SafeCloud server reported to have
  *                                                    received a malformed session message
+ * @throws ERR_SESS_CLI_SRV_NO_SPACE                  The SafeCloud server reported not to have enough
+ *                                                    storage space for the file to be uploaded
  * @throws ERR_SESSABORT_CLI_SRV_UNKNOWN_SESSMSG_TYPE The SafeCloud server reported to have
  *                                                    received a session message of unknown type
  * @throws ERR_CSK_RECV_FAILED                        Error in receiving data from the connection socket
@@ -1364,6 +2506,11 @@ void CliSessMgr::checkAsyncSrvMsg()
 
   //_connMgr.clearPriBuf();
 
+  // While the server's 'SRV_OK' STSM message is pending no asynchronous session message can have been
+  // received (with such message being received along with the response to the first session request)
+  if(_cliConnMgr.isSTSMPending())
+   return;
+
   // If the connection socket has input data available, receive and check the
   // supposed asynchronous session message sent by the SafeCloud server
   if(_connMgr.isRecvDataAvailable())
@@ -1373,142 +2520,53 @@ void CliSessMgr::checkAsyncSrvMsg()
 /* ---------------------------- Session Operations API ---------------------------- */
 
 /**
- * @brief  Uploads a file to the user's SafeCloud storage pool
- * @param  filePath The relative or absolute path of the file to be uploaded
- * @throws ERR_SESS_FILE_NOT_FOUND   The file to be uploaded was not found
- * @throws ERR_SESS_FILE_OPEN_FAILED The file to be uploaded could not be opened in read mode
- * @throws ERR_SESS_FILE_READ_FAILED Error in reading the metadata of the file to be uploaded
- * @throws ERR_SESS_UPLOAD_DIR       The file to be uploaded is in fact a directory
- * @throws ERR_SESS_UPLOAD_TOO_BIG   The file to be uploaded is too large (>= 4GB)
- * @throws Most of the session and OpenSSL exceptions (see
- *         "execErrCode.h" and "sessErrCodes.h" for more details)
+ * @brief  Uploads one or more files to the user's SafeCloud storage pool, carrying out concurrently the upload
+ *         operations of each batch of up to SESS_MAX_STREAMS files on different session streams
+ * @param  filePaths The relative or absolute paths of the files to be uploaded
+ * @param  authOnly  Whether the files' contents, already encrypted by the user, should be authenticated
+ *                   only (GMAC) instead of encrypted, keeping their integrity protection
+ * @note   Recoverable errors in the upload of a file (e.g. the file was not found or is too large)
+ *         are reported to the user and only abort such file's upload operation
+ * @throws Most of the session-aborting and OpenSSL exceptions
+ *         (see "execErrCode.h" for more details)
  */
-void CliSessMgr::uploadFile(std::string& filePath)
+void CliSessMgr::uploadFiles(std::vector<std::string>& filePaths, bool authOnly)
  {
-  // Initialize the client session manager operation
-  _sessMgrOp = UPLOAD;
-
-  // Load and sanitize the information of the file to be uploaded to the SafeCloud storage pool
-  checkLoadUploadFile(filePath);
-
-  /*
-  // LOG: Upload file info
-  _mainFileInfo->printFileInfo();
-  */
-
-  // Prepare a 'SessMsgFileInfo' session message of type 'FILE_UPLOAD_REQ' containing the
-  // name and metadata of the file to be uploaded and send it to the SafeCloud server
-  sendSessMsgFileInfo(FILE_UPLOAD_REQ);
-
-  LOG_DEBUG("Sent 'FILE_UPLOAD_REQ' message to the server (file = \""
-            + *_mainFileAbsPath + "\", size = " + _mainFileInfo->meta->fileSizeStr + ")")
-
-  // Update the operation step so to expect a 'FILE_UPLOAD_REQ' response
-  _sessMgrOpStep = WAITING_RESP;
-
-  // Block until the 'FILE_UPLOAD_REQ' response is received from the SafeCloud server
-  recvCheckCliSessMsg();
-
-  // Parse the 'FILE_UPLOAD_REQ' response, obtaining an indication on whether
-  // the file raw contents should be uploaded to the SafeCloud server
-  if(!parseUploadResponse())
-   return;
-
-  // If uploading a non-empty file, send its raw contents
-  if(_mainFileInfo->meta->fileSizeRaw != 0)
-   uploadFileData();
-
-  // Update the operation step so to expect the server completion notification
-  _sessMgrOpStep = WAITING_COMPL;
-
-  // Block until the supposed server completion notification has been received
-  recvCheckCliSessMsg();
-
-  // Ensure that the server completion notification was received
-  if(_recvSessMsgType != COMPLETED)
-   sendCliSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"Received a session message of type" +
-                                                    std::to_string(_recvSessMsgType) +
-                                                    " while awaiting for the server's 'UPLOAD' completion");
+  for(size_t firstFile = 0; firstFile < filePaths.size(); firstFile += SESS_MAX_STREAMS)
+   {
+    uploadFilesBatch(filePaths, firstFile, (unsigned char)std::min(filePaths.size() - firstFile, (size_t)SESS_MAX_STREAMS),
+                     authOnly);
 
-  // Inform the user that the file has been successfully uploaded to
-  // their storage pool depending on whether it is empty or not
-  if(_mainFileInfo->meta->fileSizeRaw == 0)
-   std::cout << "\nEmpty file \"" + _mainFileInfo->fileName + "\" successfully"
-                " uploaded to the SafeCloud storage pool\n" << std::endl;
-  else
-   std::cout << "\nFile \"" + _mainFileInfo->fileName + "\" (" + _mainFileInfo->meta->fileSizeStr +
-               ") successfully uploaded to the SafeCloud storage pool\n" << std::endl;
+    // Reset the session state in preparation to the next batch
+    resetSessState();
+   }
  }
 
 
 /**
- * @brief  Downloads a file from the user's SafeCloud storage pool into their download directory
- * @param  fileName The name of the file to be downloaded from the user's SafeCloud storage pool
- * @throws ERR_SESS_FILE_INVALID_NAME The provided file name is not a valid Linux file name
- * @throws Most of the session and OpenSSL exceptions (see
- *         "execErrCode.h" and "sessErrCodes.h" for more details)
+ * @brief  Downloads one or more files from the user's SafeCloud storage pool into their download directory,
+ *         carrying out concurrently the download operations of each batch of up to SESS_MAX_STREAMS
+ *         files on different session streams
+ * @param  fileNames The names of the files to be downloaded from the user's SafeCloud storage pool
+ * @param  authOnly  Whether the files' contents, already encrypted by the user, should be authenticated
+ *                   only (GMAC) instead of encrypted, keeping their integrity protection
+ * @param  tail      Whether the copies of the files in the download directory are assumed to be prefixes of
+ *                   the ones in the storage pool, as for append-only files (e.g. logs), so that only the
+ *                   tails of the files past them are downloaded
+ * @note   Recoverable errors in the download of a file (e.g. an invalid file name or a file not
+ *         existing in the storage pool) are reported to the user and only abort such file's download
+ * @throws Most of the session-aborting and OpenSSL exceptions
+ *         (see "execErrCode.h" for more details)
  */
-void CliSessMgr::downloadFile(std::string& fileName)
+void CliSessMgr::downloadFiles(std::vector<std::string>& fileNames, bool authOnly, bool tail)
  {
-  // Initialize the client session manager operation
-  _sessMgrOp = DOWNLOAD;
-
-  // Assert the file name string to consist of a valid Linux file name
-  validateFileName(fileName);
-
-  // Initialize the main and temporary absolute paths of the file to be downloaded
-  _mainFileAbsPath = new std::string(*_mainDirAbsPath + "/" + fileName);
-  _tmpFileAbsPath  = new std::string(*_tmpDirAbsPath + "/" + fileName + "_PART");
-
-  /*
-  // LOG: Main and temporary files absolute paths
-  std::cout << "_mainFileAbsPath = " << *_mainFileAbsPath << std::endl;
-  std::cout << "_tmpFileAbsPath = " << *_tmpFileAbsPath << std::endl;
-  */
-
-  // Prepare a 'SessMsgFileName' session message of type 'FILE_DOWNLOAD_REQ' containing
-  // the name of the file to be uploaded and send it to the SafeCloud server
-  sendSessMsgFileName(FILE_DOWNLOAD_REQ,fileName);
-
-  LOG_DEBUG("Sent 'FILE_DOWNLOAD_REQ' message to the server (file = \"" + fileName + "\")")
-
-  // Update the operation step so to expect a 'FILE_DOWNLOAD_REQ' response
-  _sessMgrOpStep = WAITING_RESP;
-
-  // Block until the 'FILE_DOWNLOAD_REQ' response is received from the SafeCloud server
-  recvCheckCliSessMsg();
-
-  // Parse the 'FILE_DOWNLOAD_REQ' response, obtaining an indication on
-  // whether to proceed downloading the file from the SafeCloud server
-  if(!parseDownloadResponse(fileName))
-   return;
-
-  // If downloading a non-empty file
-  if(_remFileInfo->meta->fileSizeRaw != 0)
+  for(size_t firstFile = 0; firstFile < fileNames.size(); firstFile += SESS_MAX_STREAMS)
    {
-    // Receive the file's raw contents
-    downloadFileData();
-
-    // Notify the server that the file download has been completed successfully
-    sendSessSignalMsg(COMPLETED);
-
-    // Inform the user that the file has been successfully downloaded to their download directory
-    std::cout << "\nFile \"" + _remFileInfo->fileName + "\" (" + _remFileInfo->meta->fileSizeStr +
-                 ") successfully downloaded into the download directory\n" << std::endl;
-   }
-
-  // Otherwise, if downloading an empty file
-  else
-   {
-    // Touch the empty file in the client's download directory
-    touchEmptyFile();
-
-    // Notify the server that the empty file has been successfully downloaded
-    sendCliSessSignalMsg(COMPLETED);
+    downloadFilesBatch(fileNames, firstFile, (unsigned char)std::min(fileNames.size() - firstFile, (size_t)SESS_MAX_STREAMS),
+                       authOnly, tail);
 
-    // Inform the user that the empty file has been successfully downloaded
-    std::cout << "\nEmpty file \"" + _remFileInfo->fileName + "\" successfully "
-                 "downloaded from the SafeCloud storage pool\n" << std::endl;
+    // Reset the session state in preparation to the next batch
+    resetSessState();
    }
  }
 
@@ -1523,7 +2581,7 @@ void CliSessMgr::downloadFile(std::string& fileName)
 void CliSessMgr::deleteFile(std::string& fileName)
  {
   // Initialize the client session manager operation
-  _sessMgrOp = DELETE;
+  _stream->op = DELETE;
 
   // Assert the file name string to consist of a valid Linux file name
   validateFileName(fileName);
@@ -1535,7 +2593,7 @@ void CliSessMgr::deleteFile(std::string& fileName)
   LOG_DEBUG("Sent 'FILE_DELETE_REQ' message to the server (file = \"" + fileName + "\")")
 
   // Update the operation step so to expect a 'FILE_DOWNLOAD_REQ' response
-  _sessMgrOpStep = WAITING_RESP;
+  _stream->opStep = WAITING_RESP;
 
   // Block until the 'FILE_DELETE_REQ' response is received from the SafeCloud server
   recvCheckCliSessMsg();
@@ -1546,7 +2604,7 @@ void CliSessMgr::deleteFile(std::string& fileName)
    return;
 
   // Update the operation step so to expect the server completion notification
-  _sessMgrOpStep = WAITING_COMPL;
+  _stream->opStep = WAITING_COMPL;
 
   // Block until the supposed server completion notification has been received
   recvCheckCliSessMsg();
@@ -1558,7 +2616,7 @@ void CliSessMgr::deleteFile(std::string& fileName)
                                                     " while awaiting for the server's 'DELETE' completion");
 
   // Inform the user that the file on their storage pool has been deleted successfully
-  std::cout << "\nFile \"" + _remFileInfo->fileName + "\" (" + _remFileInfo->meta->fileSizeStr +
+  std::cout << "\nFile \"" + _stream->remFileInfo->fileName + "\" (" + _stream->remFileInfo->meta->fileSizeStr +
                ") successfully deleted from the SafeCloud storage pool\n" << std::endl;
  }
 
@@ -1575,7 +2633,7 @@ void CliSessMgr::deleteFile(std::string& fileName)
 void CliSessMgr::renameFile(std::string& oldFilename, std::string& newFilename)
  {
   // Initialize the client session manager operation
-  _sessMgrOp = RENAME;
+  _stream->op = RENAME;
 
   // Assert both file names to represent valid Linux file names
   validateFileName(oldFilename);
@@ -1593,7 +2651,7 @@ void CliSessMgr::renameFile(std::string& oldFilename, std::string& newFilename)
             + oldFilename + "\", newFilename = \"" + newFilename + "\")")
 
   // Update the operation step so to expect a 'FILE_RENAME_REQ' response
-  _sessMgrOpStep = WAITING_RESP;
+  _stream->opStep = WAITING_RESP;
 
   // Block until the 'FILE_RENAME_REQ' response is received from the SafeCloud server
   recvCheckCliSessMsg();
@@ -1611,7 +2669,7 @@ void CliSessMgr::renameFile(std::string& oldFilename, std::string& newFilename)
 void CliSessMgr::listPoolFiles()
  {
   // Initialize the client session manager operation
-  _sessMgrOp = LIST;
+  _stream->op = LIST;
 
   // Send a 'FILE_LIST_REQ' signaling
   // message to the SafeCloud server
@@ -1620,7 +2678,7 @@ void CliSessMgr::listPoolFiles()
   LOG_DEBUG("Sent 'FILE_LIST_REQ' message to the server")
 
   // Update the operation step so to expect a 'FILE_LIST_REQ' response
-  _sessMgrOpStep = WAITING_RESP;
+  _stream->opStep = WAITING_RESP;
 
   // Block until the 'FILE_LIST_REQ' response is received from the SafeCloud server
   recvCheckCliSessMsg();
@@ -1634,11 +2692,11 @@ void CliSessMgr::listPoolFiles()
                                                     "'FILE_LIST_REQ' response");
 
   // Read the serialized size of the user's storage pool from
-  // the 'SessMsgPoolSize' into the '_rawBytesRem' attribute
+  // the 'SessMsgPoolSize' into the 'rawBytesRem' attribute
   loadSessMsgPoolSize();
 
   // If the user's storage pool is empty, inform them and return
-  if(_rawBytesRem == 0)
+  if(_stream->rawBytesRem == 0)
    {
     std::cout << "\nYour storage pool is empty\n" << std::endl;
     return;
@@ -1659,6 +2717,6 @@ void CliSessMgr::listPoolFiles()
     sendSessSignalMsg(COMPLETED);
 
     // Print the user's storage pool contents on stdout
-    _mainDirInfo->printDirContents();
+    _stream->mainDirInfo->printDirContents();
    }
  }
\ No newline at end of file
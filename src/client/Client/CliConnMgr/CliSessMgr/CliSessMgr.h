@@ -6,6 +6,33 @@
 /* ================================== INCLUDES ================================== */
 #include "SafeCloudApp/ConnMgr/SessMgr/SessMgr.h"
 #include "SafeCloudApp/ConnMgr/SessMgr/SessMsg.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/FilePipe/FilePipe.h"
+
+/*
+ * The stages of the file upload pipeline, where the main file's segments are read, encrypted and
+ * sent to the SafeCloud server by different threads, so that disk, CPU and network are used concurrently
+ */
+#define UPLOAD_STAGE_READ    0   // Reads a segment from the main file
+#define UPLOAD_STAGE_ENCRYPT 1   // Encrypts a segment
+#define UPLOAD_STAGE_SEND    2   // Sends a segment to the SafeCloud server
+#define UPLOAD_STAGES        3
+
+// The number of slots in the file upload pipeline, so that a segment sent in
+// zero-copy mode can be held by the sending stage until the kernel releases it
+#define UPLOAD_PIPE_SLOTS 4
+
+/*
+ * The stages of the file download pipeline, where the file's segments are received, decrypted and written
+ * to disk by different threads, so that the socket keeps being read while segments are decrypted and written
+ */
+#define DOWNLOAD_STAGE_RECV    0   // Receives a segment from the SafeCloud server
+#define DOWNLOAD_STAGE_DECRYPT 1   // Verifies and decrypts a segment
+#define DOWNLOAD_STAGE_WRITE   2   // Writes a batch of consecutive segments into the temporary file
+#define DOWNLOAD_STAGES        3
+
+// The number of slots in the file download pipeline, so that up to
+// 2 segments can be written into the temporary file in a single batch
+#define DOWNLOAD_PIPE_SLOTS 4
 
 
 // Forward Declaration
@@ -17,7 +44,9 @@ class CliSessMgr : public SessMgr
 
    /* ================================= ATTRIBUTES ================================= */
 
-   /* Same of the 'SessMgr' base class */
+   // In addition to the ones of the 'SessMgr' base class
+   CliConnMgr& _cliConnMgr;     // The parent CliConnMgr instance managing this object
+   std::string _resumeDirPath;  // The path of the user's partial downloads directory
 
    /* ============================== PRIVATE METHODS ============================== */
 
@@ -33,6 +62,7 @@ class CliSessMgr : public SessMgr
     * @throws ERR_SESS_UNEXPECTED_MESSAGE   The session manager received a session message
     *                                       invalid for its current operation or step
     * @throws ERR_SESS_MALFORMED_MESSAGE    The session manager received a malformed session message
+    * @throws ERR_SESS_NO_SPACE             Not enough storage space for the file to be received
     * @throws ERR_SESS_UNKNOWN_SESSMSG_TYPE The session manager received a session message of unknown type
     * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
@@ -49,14 +79,16 @@ class CliSessMgr : public SessMgr
 
    /**
     * @brief  Client Session message reception handler, which:\n\n
-    *            1) Blocks the execution until a complete session message wrapper has
+    *            1) If pending, receives the server's 'SRV_OK' STSM message preceding the
+    *               response to a first session request sent along with the 'CLI_AUTH' message\n\n
+    *            2) Blocks the execution until a complete session message wrapper has
     *               been received in the associated connection manager's primary buffer\n\n
-    *            2) Unwraps the received session message wrapper from
+    *            3) Unwraps the received session message wrapper from
     *               the primary into the secondary connection buffer\n\n
-    *            3) Asserts the resulting session message to be allowed in
+    *            4) Asserts the resulting session message to be allowed in
     *               the current client session manager operation and step\n\n
-    *            4) Handles session-resetting or terminating signaling messages\n\n
-    *            5) Handles session error signaling messages
+    *            5) Handles session-resetting or terminating signaling messages\n\n
+    *            6) Handles session error signaling messages
     * @throws Most of the session and OpenSSL exceptions (see
     *         "execErrCode.h" and "sessErrCodes.h" for more details)
     */
@@ -68,7 +100,7 @@ class CliSessMgr : public SessMgr
     *         cancelling the operation on the SafeCloud server depending on the user's response
     * @return A boolean indicating whether the file upload or download operation should continue
     * @throws ERR_SESS_INTERNAL_ERROR      Invalid session operation or step or uninitialized
-    *                                      '_mainFileInfo' or '_remFileInfo' attributes
+    *                                      'mainFileInfo' or 'remFileInfo' attributes
     * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
@@ -85,22 +117,82 @@ class CliSessMgr : public SessMgr
    /**
     * @brief  Loads and sanitizes the information of the file to\n\n
     *         be uploaded to the SafeCloud storage pool by:\n\n
-    *           1) Writing its canonicalized path into the '_mainFileAbsPath' attribute\n\n
-    *           2) Opening its '_mainFileDscr' file descriptor in read-byte mode\n\n
-    *           3) Loading the file name and metadata into the '_mainFileInfo' attribute
+    *           1) Writing its canonicalized path into the 'mainFileAbsPath' attribute\n\n
+    *           2) Opening its 'mainFileDscr' file descriptor in read-byte mode\n\n
+    *           3) Loading the file name and metadata into the 'mainFileInfo' attribute
     * @param  filePath The relative or absolute path of the file to be uploaded
     * @throws ERR_SESS_FILE_NOT_FOUND   The file to be uploaded was not found
     * @throws ERR_SESS_FILE_OPEN_FAILED The file to be uploaded could not be opened in read mode
     * @throws ERR_SESS_FILE_READ_FAILED Error in reading the metadata of the file to be uploaded
     * @throws ERR_SESS_UPLOAD_DIR       The file to be uploaded is in fact a directory
-    * @throws ERR_SESS_UPLOAD_TOO_BIG   The file to be uploaded is too large (>= 4GB)
+    * @throws ERR_SESS_UPLOAD_TOO_BIG   The file to be uploaded is too large
     */
    void checkLoadUploadFile(std::string& filePath);
 
+   /**
+    * @brief  Digests the contents of the file to be uploaded, which is read without affecting its descriptor's
+    *         position, and sends their digest to the SafeCloud server within a 'SessMsgUploadDigest' session
+    *         message, so that the server may complete the upload without the contents being transferred
+    *         if it already holds them (see 'STSM_FEATURE_DEDUP_UPLOADS')
+    * @throws ERR_SESS_FILE_READ_FAILED    Error in reading the file to be uploaded
+    * @throws ERR_OSSL_EVP_MD_CTX_NEW      EVP_MD context creation failed
+    * @throws ERR_OSSL_EVP_DIGEST_INIT     EVP_MD digest initialization failed
+    * @throws ERR_OSSL_EVP_DIGEST_UPDATE   EVP_MD digest update failed
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL    EVP_MD digest final failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_CLI_DISCONNECTED         The server disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void sendUploadDigest();
+
+   /**
+    * @brief  Confirms the upload of the current stream's file overwriting the one in the user's storage pool to the
+    *         SafeCloud server where, if the server supports delta uploads (see 'STSM_FEATURE_DELTA_UPLOADS'), the
+    *         file is not authenticated only, its upload is not resumed, both its versions are at least
+    *         FILE_DELTA_MIN_SIZE bytes and the server's version is at most FILE_DELTA_MAX_SIZE bytes, the
+    *         upload is confirmed with a 'DELTA_CONFIRM' message so that only the file's changes against the
+    *         server's version are sent
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_CLI_DISCONNECTED         The server disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void confirmUpload();
+
+   /**
+    * @brief  Loads the signatures of the blocks of the server's version of the file to be uploaded received within
+    *         a 'SessMsgDeltaSigs' session message, encodes the file as a delta against them into a temporary file
+    *         (an anonymous 'O_TMPFILE' inode in the temporary directory or, where the filesystem does not support
+    *         it, a named one) whose contents are then uploaded in place of the file's, and announces the delta's
+    *         size and the digest of the file's contents to the server within a 'SessMsgUploadDelta' message
+    * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid 'SessMsgDeltaSigs' message length or blocks
+    * @throws ERR_SESS_INTERNAL_ERROR      Failed to create the temporary file or to encode the delta into it
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL    EVP_MD digest failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_CLI_DISCONNECTED         The server disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void sendUploadDelta();
+
    /**
     * @brief  Parses the 'FILE_UPLOAD_REQ' session response message returned by the SafeCloud server, where:\n\n
-    *            1) If the SafeCloud server has reported to have successfully uploaded
-    *               the empty file, inform the user of the success of the operation.\n\n
+    *            1) If the SafeCloud server has reported to have successfully uploaded the empty file, or a
+    *               non-empty file whose contents it already holds if it deduplicates uploads, inform
+    *               the user of the success of the operation.\n\n
     *            2) If the SafeCloud server has reported that a file with the same name of the one to be
     *               uploaded does not exist in the user's storage pool, the file upload operation should continue\n\n
     *            3) If the SafeCloud server has reported that a file with the same name of the one to be uploaded
@@ -112,9 +204,12 @@ class CliSessMgr : public SessMgr
     *                       one in the storage pool the file upload operation should continue\n\n
     *                  3.3) If the file to be uploaded has the same size and last modified time of
     *                       the one in the storage pool, or the latter was more recently modified,
-    *                       ask for user confirmation on whether the upload operation should continue
+    *                       ask for user confirmation on whether the upload operation should continue\n\n
+    *            4) If the SafeCloud server has reported to resume the upload from its partial upload of
+    *               the file, load the offset it is resumed from and parse the server's following response
     * @return A boolean indicating whether the upload operation should continue
     * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid file values in the 'SessMsgFileInfo' message
+    *                                      or invalid offset in the 'SessMsgUploadResume' message
     * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
@@ -129,24 +224,92 @@ class CliSessMgr : public SessMgr
    bool parseUploadResponse();
 
    /**
-    * @brief  Uploads the main file's raw contents and sends the
-    *         resulting integrity tag to the SafeCloud server
-    * @throws ERR_FILE_WRITE_FAILED              Error in reading from the main file
+    * @brief Upload pipeline reading stage, reading in a round-robin fashion the segments of the files
+    *        of the session's streams in the 'SENDING_RAW' step into the plaintext buffers of the
+    *        pipeline slots and passing them to the encryption stage
+    * @param uploadPipe The file upload pipeline
+    * @param totBytes   The total size of the files' contents to be uploaded
+    * @note  Being executed in a separate thread, the stage never throws, with
+    *        its exceptions aborting the pipeline and being stored within it
+    */
+   void uploadReadStage(FilePipe& uploadPipe, long int totBytes);
+
+   /**
+    * @brief Upload pipeline encryption stage, encrypting the segments in the pipeline slots with
+    *        the chunk IVs of their streams from their plaintext into their ciphertext buffers
+    *        and passing them to the sending stage
+    * @param uploadPipe The file upload pipeline
+    * @param totBytes   The total size of the files' contents to be uploaded
+    * @note  Being executed in a separate thread, the stage never throws, with
+    *        its exceptions aborting the pipeline and being stored within it
+    */
+   void uploadEncryptStage(FilePipe& uploadPipe, long int totBytes);
+
+   /**
+    * @brief  Uploads the raw contents of the files of the session's streams in the 'SENDING_RAW' step
+    *         to the SafeCloud server as 'FILE_SEGMENT' messages each followed by the segment's individually
+    *         authenticated chunks, with the segments of different files being interleaved on the connection
+    *         and passing through a pipeline where their reading, encryption and sending overlap
+    * @throws ERR_FILE_WRITE_FAILED              Error in reading from a main file
     * @throws ERR_SESSABORT_UNEXPECTED_FILE_SIZE The main file raw contents that were read differ from its size
     * @throws ERR_AESGCMMGR_INVALID_STATE        Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW        EVP_CIPHER context creation failed
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT          EVP_CIPHER encrypt initialization failed
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE       The plaintext block size is non-positive (probable overflow)
     * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE        EVP_CIPHER encrypt update failed
     * @throws ERR_OSSL_EVP_ENCRYPT_FINAL         EVP_CIPHER encrypt final failed
     * @throws ERR_OSSL_GET_TAG_FAILED            Error in retrieving the resulting integrity tag
-    * @throws ERR_SEND_OVERFLOW                  Attempting to send a number of bytes > _priBufSize
     * @throws ERR_PEER_DISCONNECTED              The connection peer disconnected during the send()
     * @throws ERR_SEND_FAILED                    send() fatal error
     */
-   void uploadFileData();
+   void uploadFilesData();
+
+   /**
+    * @brief  Uploads a batch of up to SESS_MAX_STREAMS files to the user's SafeCloud storage pool,
+    *         carrying out each upload operation on its own session stream by:\n\n
+    *            1) Sending the upload requests of all files.\n\n
+    *            2) Parsing the server's responses to the upload requests, in order.\n\n
+    *            3) Uploading the raw contents of the confirmed files, whose segments are
+    *               interleaved on the connection (see the uploadFilesData() method).\n\n
+    *            4) Awaiting the server's completion notifications of the uploaded files.
+    * @param  filePaths The relative or absolute paths of the files to be uploaded
+    * @param  firstFile The index in 'filePaths' of the first file of the batch
+    * @param  numFiles  The number of files in the batch (<= SESS_MAX_STREAMS)
+    * @param  authOnly  Whether the files' contents should be authenticated only instead of encrypted
+    * @note   Recoverable errors of a file's upload operation are reported to the user
+    *         and only abort such operation, leaving the other ones of the batch unaffected
+    * @throws Most of the session-aborting and OpenSSL exceptions
+    *         (see "execErrCode.h" for more details)
+    */
+   void uploadFilesBatch(std::vector<std::string>& filePaths, size_t firstFile, unsigned char numFiles, bool authOnly);
 
    /* ------------------------ 'DOWNLOAD' Operation Methods ------------------------ */
 
+   /**
+    * @brief  Confirms the download of the current stream's file to the SafeCloud server where, if the server
+    *         supports ranged downloads:\n\n
+    *            - The download is resumable, its verified contents being preserved in the user's "resume" directory
+    *              should it be interrupted, keyed by the name, size and last modification time of the file in the
+    *              storage pool (where the partial downloads of the file's other versions are deleted)\n\n
+    *            - If an interrupted download of the same version of the file was preserved or, in tail mode, the
+    *              copy of the file in the download directory is shorter than the one in the storage pool, they are
+    *              claimed as the download's temporary file and only the file's contents past them are downloaded
+    *              by confirming the download with a 'DOWNLOAD_RANGE' message\n\n
+    *         with failures in preparing the download's resumption only causing the whole file to be downloaded
+    * @param  tail Whether the copy of the file in the download directory is assumed to be a prefix of the file
+    *              in the storage pool, as for append-only files (e.g. logs), so that only its tail is downloaded
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL    EVP_MD digest failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_CLI_DISCONNECTED         The server disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void confirmDownload(bool tail);
+
    /**
     * @brief  Parses the 'FILE_DOWNLOAD_REQ' session response message returned by the SafeCloud server, where:\n\n
     *            1) If the SafeCloud server has reported that the file to be downloaded does not exist in
@@ -168,7 +331,15 @@ class CliSessMgr : public SessMgr
     *                                           on whether the upload operation should continue\n\n
     *                                    2.4.3) Has a last modified time older than the one in the
     *                                           download directory, ask for user confirmation on
-    *                                           whether the upload operation should continue
+    *                                           whether the upload operation should continue\n\n
+    *                  2.5) In tail mode, if the file to be downloaded is NOT empty and a file with such name does
+    *                       exist in the user's download directory, download only the file's contents past it if
+    *                       it is shorter, or otherwise cancel the download operation as the file in the
+    *                       storage pool has no tail to be downloaded\n\n
+    *         where confirmed downloads may be resumed from their interrupted downloads (see confirmDownload())
+    * @param  fileName The name of the file to be downloaded from the SafeCloud storage pool
+    * @param  tail     Whether the copy of the file in the download directory is assumed to be a
+    *                  prefix of the one in the storage pool, so that only its tail is downloaded
     * @return A boolean indicating whether the downloaded operation should continue
     * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid file values in the 'SessMsgFileInfo' message
     * @throws ERR_SESS_MAIN_FILE_IS_DIR    The main file was found to be a directory (!)
@@ -183,42 +354,80 @@ class CliSessMgr : public SessMgr
     * @throws ERR_SESS_UNEXPECTED_MESSAGE  An invalid 'FILE_DOWNLOAD_REQ' session
     *                                      message response type was received
     */
-   bool parseDownloadResponse(std::string& fileName);
+   bool parseDownloadResponse(std::string& fileName, bool tail);
 
    /**
-    * @brief Downloads a file's raw contents from the user's SafeCloud storage pool by:\n\n
-    *            1) Preparing the client session manager to receive the file's raw contents.\n\n
-    *            2) Receiving and decrypting the file's raw contents.\n\n
-    *            3) Verifying the file trailing integrity tag.\n\n
-    *            4) Moving the resulting temporary file into the associated
-    *               associated main file in the user's download directory.\n\n
-    *            5) Setting the main file last modified time to
-    *               the one specified in the '_remFileInfo' object.\n\n
-    *            6) Notifying the success of the download operation to the SafeCloud server.
-    * @param  fileName The name of the file to be downloaded from the SafeCloud storage pool
-    * @throws ERR_SESSABORT_INTERNAL_ERROR   Invalid session manager operation or step
-    *                                        for receiving a file's raw contents
-    * @throws ERR_SESS_FILE_OPEN_FAILED      Failed to open the temporary file
-    *                                        descriptor in write-byte mode
-    * @throws ERR_FILE_WRITE_FAILED          Error in writing to the temporary file
+    * @brief Download pipeline receiving stage, receiving the 'FILE_SEGMENT' messages of the session's streams
+    *        in the 'WAITING_RAW' step and their segments from the SafeCloud server into the ciphertext
+    *        buffers of the pipeline slots, passing them to the decryption stage
+    * @param downloadPipe The file download pipeline
+    * @param totBytes     The total size of the files being downloaded
+    * @note  Being executed in a separate thread, the stage never throws, with
+    *        its exceptions aborting the pipeline and being stored within it
+    */
+   void downloadRecvStage(FilePipe& downloadPipe, long int totBytes);
+
+   /**
+    * @brief Download pipeline decryption stage, verifying and decrypting the segments in the pipeline slots
+    *        with the chunk IVs of their streams from their ciphertext into their plaintext buffers and
+    *        passing them to the writing stage
+    * @param downloadPipe The file download pipeline
+    * @param totBytes     The total size of the files being downloaded
+    * @note  Being executed in a separate thread, the stage never throws, with
+    *        its exceptions aborting the pipeline and being stored within it
+    */
+   void downloadDecryptStage(FilePipe& downloadPipe, long int totBytes);
+
+   /**
+    * @brief  Download pipeline writing stage helper, writing the plaintexts of a batch of consecutive
+    *         decrypted segments of a same stream into its temporary file with a single writev()
+    * @param  downloadPipe The file download pipeline
+    * @param  slotIdxs     The indexes of the pipeline slots holding the segments, in file order
+    * @param  numSlots     The number of slots in the batch
+    * @throws ERR_FILE_WRITE_FAILED Error in writing to the temporary file
+    */
+   void downloadWriteBatch(FilePipe& downloadPipe, unsigned int* slotIdxs, unsigned int numSlots);
+
+   /**
+    * @brief Downloads the raw contents of the files of the session's streams in the 'WAITING_RAW' step, each
+    *        prepared to receive its file's raw contents, by receiving their interleaved segments of individually
+    *        authenticated chunks and verifying, decrypting and writing each segment into its stream's temporary
+    *        file through a pipeline where the reception, decryption and writing of different segments overlap
+    * @throws ERR_SESSABORT_INVALID_FILE_SEGMENT     Unexpected or invalid file segment announcement
+    * @throws ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED A file chunk other than the last failed its integrity verification
+    * @throws ERR_FILE_WRITE_FAILED          Error in writing to a temporary file
     * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE   The ciphertext block size is non-positive (probable overflow)
     * @throws ERR_OSSL_EVP_DECRYPT_UPDATE    EVP_CIPHER decrypt update failed
     * @throws ERR_OSSL_SET_TAG_FAILED        Error in setting the expected file integrity tag
     * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED File integrity verification failed
-    * @throws ERR_SESS_FILE_CLOSE_FAILED     Error in closing the temporary file
-    * @throws ERR_SESS_FILE_RENAME_FAILED    Error in moving the temporary file to the main directory
-    * @throws ERR_SESS_FILE_META_SET_FAILED  Error in setting the main file's last modification time
-    * @throws ERR_OSSL_EVP_ENCRYPT_INIT      EVP_CIPHER encrypt initialization failed
-    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE    EVP_CIPHER encrypt update failed
-    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL     EVP_CIPHER encrypt final failed
-    * @throws ERR_OSSL_GET_TAG_FAILED        Error in retrieving the resulting integrity tag
-    * @throws ERR_PEER_DISCONNECTED          The connection peer disconnected during the send()
-    * @throws ERR_SEND_FAILED                send() fatal error
-    * @throws ERR_SESS_INTERNAL_ERROR        Failed to close or move the downloaded temporary
-    *                                        file or NULL session attributes
+    * @throws ERR_PEER_DISCONNECTED          The connection peer disconnected during the recv()
+    * @throws ERR_CSK_RECV_FAILED            Error in receiving data from the connection socket
     */
-   void downloadFileData();
+   void downloadFilesData();
+
+   /**
+    * @brief  Downloads a batch of up to SESS_MAX_STREAMS files from the user's SafeCloud storage
+    *         pool, carrying out each download operation on its own session stream by:\n\n
+    *            1) Sending the download requests of all files.\n\n
+    *            2) Parsing the server's responses to the download requests, in order, with empty
+    *               files being directly touched in the download directory.\n\n
+    *            3) Downloading the raw contents of the confirmed files, whose segments are
+    *               interleaved on the connection (see the downloadFilesData() method).\n\n
+    *            4) Finalizing each downloaded file and notifying its
+    *               download completion to the SafeCloud server.
+    * @param  fileNames The names of the files to be downloaded from the user's SafeCloud storage pool
+    * @param  firstFile The index in 'fileNames' of the first file of the batch
+    * @param  numFiles  The number of files in the batch (<= SESS_MAX_STREAMS)
+    * @param  authOnly  Whether the files' contents should be authenticated only instead of decrypted
+    * @param  tail      Whether only the tails of the files past their shorter copies in the download
+    *                   directory should be downloaded, as for append-only files (e.g. logs)
+    * @note   Recoverable errors of a file's download operation are reported to the user
+    *         and only abort such operation, leaving the other ones of the batch unaffected
+    * @throws Most of the session-aborting and OpenSSL exceptions
+    *         (see "execErrCode.h" for more details)
+    */
+   void downloadFilesBatch(std::vector<std::string>& fileNames, size_t firstFile, unsigned char numFiles, bool authOnly, bool tail);
 
    /* ------------------------- 'DELETE' Operation Methods ------------------------- */
 
@@ -289,7 +498,7 @@ class CliSessMgr : public SessMgr
     * @throws ERR_SESS_FILE_INVALID_NAME     Received a file of name
     * @throws ERR_SESS_FILE_META_NEGATIVE    Received a file with negative metadata values
     * @throws ERR_FILE_TOO_LARGE             Received a too large file (> 9999GB)
-    * @throws ERR_SESS_DIR_INFO_OVERFLOW     The storage pool information size exceeds 4GB
+    * @throws ERR_SESS_DIR_INFO_OVERFLOW     The storage pool information size overflows a 64-bit integer
     * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE   The ciphertext block size is non-positive (probable overflow)
     * @throws ERR_OSSL_EVP_DECRYPT_UPDATE    EVP_CIPHER decrypt update failed
@@ -330,6 +539,8 @@ class CliSessMgr : public SessMgr
     *                                                    received an unexpected session message
     * @throws ERR_SESS_CLI_SRV_MALFORMED_MESSAGE         The SafeCloud server reported to have
     *                                                    received a malformed session message
+    * @throws ERR_SESS_CLI_SRV_NO_SPACE                  The SafeCloud server reported not to have enough
+    *                                                    storage space for the file to be uploaded
     * @throws ERR_SESSABORT_CLI_SRV_UNKNOWN_SESSMSG_TYPE The SafeCloud server reported to have
     *                                                    received a session message of unknown type
     * @throws ERR_CSK_RECV_FAILED                        Error in receiving data from the connection socket
@@ -339,26 +550,34 @@ class CliSessMgr : public SessMgr
    /* ---------------------------- Session Operations API ---------------------------- */
 
    /**
-    * @brief  Uploads a file to the user's SafeCloud storage pool
-    * @param  filePath The relative or absolute path of the file to be uploaded
-    * @throws ERR_SESS_FILE_NOT_FOUND   The file to be uploaded was not found
-    * @throws ERR_SESS_FILE_OPEN_FAILED The file to be uploaded could not be opened in read mode
-    * @throws ERR_SESS_FILE_READ_FAILED Error in reading the metadata of the file to be uploaded
-    * @throws ERR_SESS_UPLOAD_DIR       The file to be uploaded is in fact a directory
-    * @throws ERR_SESS_UPLOAD_TOO_BIG   The file to be uploaded is too large (>= 4GB)
-    * @throws Most of the session and OpenSSL exceptions (see
-    *         "execErrCode.h" and "sessErrCodes.h" for more details)
+    * @brief  Uploads one or more files to the user's SafeCloud storage pool, carrying out concurrently the upload
+    *         operations of each batch of up to SESS_MAX_STREAMS files on different session streams
+    * @param  filePaths The relative or absolute paths of the files to be uploaded
+    * @param  authOnly  Whether the files' contents, already encrypted by the user, should be authenticated
+    *                   only (GMAC) instead of encrypted, keeping their integrity protection
+    * @note   Recoverable errors in the upload of a file (e.g. the file was not found or is too large)
+    *         are reported to the user and only abort such file's upload operation
+    * @throws Most of the session-aborting and OpenSSL exceptions
+    *         (see "execErrCode.h" for more details)
     */
-   void uploadFile(std::string& filePath);
+   void uploadFiles(std::vector<std::string>& filePaths, bool authOnly);
 
    /**
-    * @brief  Downloads a file from the user's SafeCloud storage pool into their download directory
-    * @param  fileName The name of the file to be downloaded from the user's SafeCloud storage pool
-    * @throws ERR_SESS_FILE_INVALID_NAME The provided file name is not a valid Linux file name
-    * @throws Most of the session and OpenSSL exceptions (see
-    *         "execErrCode.h" and "sessErrCodes.h" for more details)
+    * @brief  Downloads one or more files from the user's SafeCloud storage pool into their download directory,
+    *         carrying out concurrently the download operations of each batch of up to SESS_MAX_STREAMS
+    *         files on different session streams
+    * @param  fileNames The names of the files to be downloaded from the user's SafeCloud storage pool
+    * @param  authOnly  Whether the files' contents, already encrypted by the user, should be authenticated
+    *                   only (GMAC) instead of encrypted, keeping their integrity protection
+    * @param  tail      Whether the copies of the files in the download directory are assumed to be prefixes of
+    *                   the ones in the storage pool, as for append-only files (e.g. logs), so that only the
+    *                   tails of the files past them are downloaded
+    * @note   Recoverable errors in the download of a file (e.g. an invalid file name or a file not
+    *         existing in the storage pool) are reported to the user and only abort such file's download
+    * @throws Most of the session-aborting and OpenSSL exceptions
+    *         (see "execErrCode.h" for more details)
     */
-   void downloadFile(std::string& fileName);
+   void downloadFiles(std::vector<std::string>& fileNames, bool authOnly, bool tail);
 
    /**
     * @brief  Deletes a file from the user's SafeCloud storage pool
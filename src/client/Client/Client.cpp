@@ -10,6 +10,7 @@
 
 // SafeCloud Headers
 #include "errCodes/sessErrCodes/sessErrCodes.h"
+#include "ossl_crypto/DigSig.h"
 #include "Client.h"
 #include "sanUtils.h"
 
@@ -300,6 +301,8 @@ void Client::delUserInfo()
   OPENSSL_cleanse(&_downDir[0], _downDir.size());
   OPENSSL_cleanse(&_tempDir[0], _tempDir.size());
   EVP_PKEY_free(_rsaKey);
+  OPENSSL_cleanse(&_resTicket, sizeof(CliResTicket));
+  _resTicket.valid = false;
  }
 
 
@@ -403,7 +406,7 @@ std::string Client::getUserPwd()
  * @throws ERR_LOGIN_PRIVKFILE_OPEN_FAILED Error in opening the user's RSA private key file
  * @throws ERR_FILE_CLOSE_FAILED           Error in closing the user's RSA private key file
  * @throws ERR_LOGIN_PRIVK_INVALID         The contents of the user's private key file
- *                                         could not be interpreted as a valid RSA key pair
+ *                                         could not be interpreted as a valid RSA-2048 or Ed25519 key pair
  */
 void Client::getUserRSAKey(std::string& username,std::string& password)
  {
@@ -438,6 +441,15 @@ void Client::getUserRSAKey(std::string& username,std::string& password)
     if(!_rsaKey)
       THROW_EXEC_EXCP(ERR_LOGIN_PRIVK_INVALID, RSAKeyFilePath, OSSL_ERR_DESC);
 
+    // Ensure the private key to be of a type supported
+    // in the STSM handshake (RSA-2048 or Ed25519)
+    if(!digSigKeySupported(_rsaKey))
+     {
+      EVP_PKEY_free(_rsaKey);
+      _rsaKey = nullptr;
+      THROW_EXEC_EXCP(ERR_LOGIN_PRIVK_INVALID, RSAKeyFilePath, "Unsupported key type");
+     }
+
     // At this point, being the RSA private key valid,
     // the client has successfully locally authenticated
     LOG_DEBUG("Client long-term private key successfully loaded")
@@ -471,7 +483,7 @@ void Client::getUserRSAKey(std::string& username,std::string& password)
  * @throws ERR_LOGIN_PRIVKFILE_OPEN_FAILED Error in opening the user's RSA private key file
  * @throws ERR_FILE_CLOSE_FAILED           Error in closing the user's RSA private key file
  * @throws ERR_LOGIN_PRIVK_INVALID         The contents of the user's private key file
- *                                         could not be interpreted as a valid RSA key pair
+ *                                         could not be interpreted as a valid RSA-2048 or Ed25519 key pair
  * @throws ERR_DOWNDIR_NOT_FOUND           The authenticated client's
  *                                         download directory was not found
  * @throws ERR_TMPDIR_NOT_FOUND            The authenticated client's
@@ -666,7 +678,7 @@ void Client::srvSecureConnect()
    }
 
   // Initialize the connection's manager
-  _cliConnMgr = new CliConnMgr(csk,&_name,&_tempDir,&_downDir,_rsaKey,_certStore);
+  _cliConnMgr = new CliConnMgr(csk,&_name,&_tempDir,&_downDir,_rsaKey,_certStore,&_resTicket,_earlyReq,_aesGCMPool);
 
   // At this point the client has successfully connected with the server
   _connected = true;
@@ -674,8 +686,11 @@ void Client::srvSecureConnect()
   // Establish a shared session key with the server
   _cliConnMgr->startCliSTSM();
 
-  // Log that a secure connection with the SafeCloud Server has been established
-  LOG_INFO("Successfully established a secure connection with the SafeCloud Server")
+  // Log that a secure connection with the SafeCloud Server has been established, which if the
+  // first session request is sent along with the 'CLI_AUTH' STSM message is logged once the
+  // server's 'SRV_OK' STSM message has been received (see CliConnMgr::finishCliSTSM())
+  if(!_cliConnMgr->isSTSMPending())
+   LOG_INFO("Successfully established a secure connection with the SafeCloud Server")
  }
 
 
@@ -705,14 +720,16 @@ void Client::printCmdHelp()
  {
   std::cout << "\nAvailable Commands" << std::endl;
   std::cout << "------------------" << std::endl;
-  std::cout << "UP   filename                  - Uploads a file to your SafeCloud storage pool (< 4GB)" << std::endl;
-  std::cout << "DOWN filename                  - Downloads a file from your SafeCloud storage pool into the download directory" << std::endl;
-  std::cout << "DEL  filename                  - Deletes a file from your SafeCloud storage pool" << std::endl;
-  std::cout << "REN  old_filename new_filename - Renames a file within your SafeCloud storage pool" << std::endl;
-  std::cout << "LIST pool                      - List the files within your Safecloud storage pool" << std::endl;
-  std::cout << "LIST local                     - List the files within your local download directory" << std::endl;
-  std::cout << "HELP                           - Prints this list of available commands" << std::endl;
-  std::cout << "LOGOUT/EXIT/QUIT/BYE           - Closes the application\n" << std::endl;
+  std::cout << "UP   [-a] filename [filename...]      - Uploads one or more files to your SafeCloud storage pool" << std::endl;
+  std::cout << "DOWN [-a] [-t] filename [filename...] - Downloads one or more files from your SafeCloud storage pool into the download directory" << std::endl;
+  std::cout << "DEL  filename                          - Deletes a file from your SafeCloud storage pool" << std::endl;
+  std::cout << "REN  old_filename new_filename         - Renames a file within your SafeCloud storage pool" << std::endl;
+  std::cout << "LIST pool                              - List the files within your Safecloud storage pool" << std::endl;
+  std::cout << "LIST local                             - List the files within your local download directory" << std::endl;
+  std::cout << "HELP                                   - Prints this list of available commands" << std::endl;
+  std::cout << "LOGOUT/EXIT/QUIT/BYE                   - Closes the application\n" << std::endl;
+  std::cout << "-a: Transfer the files' contents authenticated only instead of encrypted, for files you have already encrypted" << std::endl;
+  std::cout << "-t: Download only the files' contents past their copies in the download directory, for files only ever appended to (e.g. logs)\n" << std::endl;
  }
 
 
@@ -759,30 +776,6 @@ void Client::parseUserCmd1(std::string& cmd)
  */
 void Client::parseUserCmd2(std::string& cmd, std::string& arg1)
  {
-  // ------------------------- 'UPLOAD' Command ------------------------- //
-  if(cmd == "UP" || cmd == "UPLOAD")
-   {
-    // Attempt to upload the specified file to the SafeCloud storage pool
-    _cliConnMgr->getSession()->uploadFile(arg1);
-
-    // Reset the client session manager state
-    _cliConnMgr->getSession()->resetSessState();
-
-    return;
-   }
-
-  // ------------------------ 'DOWNLOAD' Command ------------------------ //
-  if(cmd == "DOWN" || cmd == "DOWNLOAD")
-   {
-    // Attempt to download the specified file from the SafeCloud storage pool
-    _cliConnMgr->getSession()->downloadFile(arg1);
-
-    // Reset the client session manager state
-    _cliConnMgr->getSession()->resetSessState();
-
-    return;
-   }
-
   // ------------------------- 'DELETE' Command ------------------------- //
   if(cmd == "DEL" || cmd == "DELETE")
    {
@@ -831,6 +824,73 @@ void Client::parseUserCmd2(std::string& cmd, std::string& arg1)
  }
 
 
+/**
+ * @brief  Parses and executes a user's input command accepting one or more file
+ *         arguments, i.e. 'UPLOAD' and 'DOWNLOAD' (parseUserCmd() helper function)
+ * @param  cmd      The command word
+ * @param  fileArgs The command file arguments, possibly preceded by the '-a' option requesting the
+ *                  files' contents to be authenticated only and, for the 'DOWNLOAD' command, by
+ *                  the '-t' option requesting only the files' tails to be downloaded
+ * @throws ERR_UNSUPPORTED_CMD Unsupported command
+ * @throws Most of the session and OpenSSL exceptions (see
+ *         "execErrCode.h" and "sessErrCodes.h" for more details)
+ */
+void Client::parseUserCmdFiles(std::string& cmd, std::vector<std::string>& fileArgs)
+ {
+  // Whether the files' contents should be transferred authenticated only instead of
+  // encrypted, as they have already been encrypted by the user ('-a' option)
+  bool authOnly = false;
+
+  // Whether the copies of the files in the download directory are assumed to be prefixes of the ones in
+  // the storage pool, so that only the files' tails past them are downloaded ('-t' option, 'DOWNLOAD' only)
+  bool tail = false;
+
+  // Parse the options preceding the file arguments
+  while(!fileArgs.empty())
+   {
+    if(fileArgs[0] == "-a" || fileArgs[0] == "-A")
+     authOnly = true;
+    else
+     if((fileArgs[0] == "-t" || fileArgs[0] == "-T") && (cmd == "DOWN" || cmd == "DOWNLOAD"))
+      tail = true;
+     else
+      break;
+    fileArgs.erase(fileArgs.begin());
+
+    // The options must be followed by at least a file argument
+    if(fileArgs.empty())
+     THROW_SESS_EXCP(ERR_UNSUPPORTED_CMD);
+   }
+
+  // ------------------------- 'UPLOAD' Command ------------------------- //
+  if(cmd == "UP" || cmd == "UPLOAD")
+   {
+    // Attempt to upload the specified files to the SafeCloud storage pool
+    _cliConnMgr->getSession()->uploadFiles(fileArgs, authOnly);
+
+    // Reset the client session manager state
+    _cliConnMgr->getSession()->resetSessState();
+
+    return;
+   }
+
+  // ------------------------ 'DOWNLOAD' Command ------------------------ //
+  if(cmd == "DOWN" || cmd == "DOWNLOAD")
+   {
+    // Attempt to download the specified files from the SafeCloud storage pool
+    _cliConnMgr->getSession()->downloadFiles(fileArgs, authOnly, tail);
+
+    // Reset the client session manager state
+    _cliConnMgr->getSession()->resetSessState();
+
+    return;
+   }
+
+  // ----------------------- Unsupported Command ----------------------- //
+  THROW_SESS_EXCP(ERR_UNSUPPORTED_CMD);
+ }
+
+
 /**
  * @brief  Parses and executes a user's input command consisting
  *         of 3 words (parseUserCmd() helper function)
@@ -887,6 +947,16 @@ void Client::parseUserCmd(std::string& cmdLine)
   // Otherwise, convert the first word in the command line to upper case
   transform(cmdLineWords[0].begin(), cmdLineWords[0].end(), cmdLineWords[0].begin(), ::toupper);
 
+  // The 'UPLOAD' and 'DOWNLOAD' commands accept one or more file arguments,
+  // whose operations are carried out concurrently on different session streams
+  if(numCmdLineWords > 1 && (cmdLineWords[0] == "UP" || cmdLineWords[0] == "UPLOAD" ||
+                             cmdLineWords[0] == "DOWN" || cmdLineWords[0] == "DOWNLOAD"))
+   {
+    std::vector<std::string> fileArgs(cmdLineWords.begin() + 1, cmdLineWords.end());
+    parseUserCmdFiles(cmdLineWords[0], fileArgs);
+    return;
+   }
+
   // Parse the command line depending on its number of words
   switch(numCmdLineWords)
    {
@@ -946,6 +1016,10 @@ void Client::userCmdPrompt()
       // the associated SafeCloud command
       parseUserCmd(cmdLine);
 
+      // If the first command did not involve the server, complete the STSM
+      // protocol by receiving its pending 'SRV_OK' message, if any
+      _cliConnMgr->finishCliSTSM();
+
       // Read whether the client connection
       // manager should be closed
       closeConn = _cliConnMgr->shutdownConn();
@@ -1005,8 +1079,10 @@ void Client::userCmdPrompt()
 /**
  * @brief  SafeCloud client object constructor, initializing the IP and port of the
  *         SafeCloud server to connect to and the client's X.509 certificates store
- * @param  srvIP   The IP address as a string of the SafeCloud server to connect to
- * @param  srvPort The port of the SafeCloud server to connect to
+ * @param  srvIP    The IP address as a string of the SafeCloud server to connect to
+ * @param  srvPort  The port of the SafeCloud server to connect to
+ * @param  earlyReq Whether the first session request on each connection
+ *                  should be sent along with the 'CLI_AUTH' STSM message
  * @throws ERR_INVALID_SRV_ADDR        Invalid IP address format
  * @throws ERR_INVALID_SRV_PORT        Invalid Port
  * @throws ERR_CA_CERT_OPEN_FAILED     The CA Certificate file could not be opened
@@ -1021,9 +1097,9 @@ void Client::userCmdPrompt()
  * @throws ERR_STORE_REJECT_SET_FAILED Error in configuring the X.509
  *                                     store to reject revoked certificates
  */
-Client::Client(char* srvIP, uint16_t srvPort)
- : SafeCloudApp(), _certStore(nullptr), _cliConnMgr(nullptr),
-   _remLoginAttempts(CLI_MAX_LOGIN_ATTEMPTS), _name(), _downDir(), _tempDir()
+Client::Client(char* srvIP, uint16_t srvPort, bool earlyReq)
+ : SafeCloudApp(), _certStore(nullptr), _cliConnMgr(nullptr), _remLoginAttempts(CLI_MAX_LOGIN_ATTEMPTS),
+   _earlyReq(earlyReq), _aesGCMPool(), _name(), _downDir(), _tempDir(), _resTicket()
  {
   // Attempt to set up the server endpoint parameters
   setSrvEndpoint(srvIP, srvPort);
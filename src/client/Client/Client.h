@@ -18,12 +18,20 @@ class Client : public SafeCloudApp
    X509_STORE*        _certStore;         // The client's X.509 certificates store
    CliConnMgr*        _cliConnMgr;        // The client's connection manager object
    unsigned char      _remLoginAttempts;  // The remaining number of client's login attempts
+   bool               _earlyReq;          // Whether the first session request on each connection
+                                          // is sent along with the 'CLI_AUTH' STSM message
+   AESGCMPool         _aesGCMPool;        // The AES_128_GCM workers pool encrypting and decrypting
+                                          // the file segments of the client's connections
 
    /* ------------------------ Client Personal Information ------------------------ */
    std::string _name;     // The client's username (unique in the SafeCloud application)
    std::string _downDir;  // The client's download directory
    std::string _tempDir;  // The client's temporary files directory
 
+   // The resumption ticket last issued to the client by the server, allowing it to
+   // reconnect within an abbreviated STSM execution (see "CliSTSMMgr.h")
+   CliResTicket _resTicket;
+
    /* =============================== PRIVATE METHODS =============================== */
 
    /* ------------------------ Client Object Initialization ------------------------ */
@@ -136,7 +144,7 @@ class Client : public SafeCloudApp
     * @throws ERR_LOGIN_PRIVKFILE_OPEN_FAILED Error in opening the user's RSA private key file
     * @throws ERR_FILE_CLOSE_FAILED           Error in closing the user's RSA private key file
     * @throws ERR_LOGIN_PRIVK_INVALID         The contents of the user's private key file
-    *                                         could not be interpreted as a valid RSA key pair
+    *                                         could not be interpreted as a valid RSA-2048 or Ed25519 key pair
     */
    void getUserRSAKey(std::string& username,std::string& password);
 
@@ -155,7 +163,7 @@ class Client : public SafeCloudApp
     * @throws ERR_LOGIN_PRIVKFILE_OPEN_FAILED Error in opening the user's RSA private key file
     * @throws ERR_FILE_CLOSE_FAILED           Error in closing the user's RSA private key file
     * @throws ERR_LOGIN_PRIVK_INVALID         The contents of the user's private key file
-    *                                         could not be interpreted as a valid RSA key pair
+    *                                         could not be interpreted as a valid RSA-2048 or Ed25519 key pair
     * @throws ERR_DOWNDIR_NOT_FOUND           The authenticated client's
     *                                         download directory was not found
     * @throws ERR_TMPDIR_NOT_FOUND            The authenticated client's
@@ -224,6 +232,19 @@ class Client : public SafeCloudApp
     */
    void parseUserCmd2(std::string& cmd, std::string& arg1);
 
+   /**
+    * @brief  Parses and executes a user's input command accepting one or more file
+    *         arguments, i.e. 'UPLOAD' and 'DOWNLOAD' (parseUserCmd() helper function)
+    * @param  cmd      The command word
+    * @param  fileArgs The command file arguments, possibly preceded by the '-a' option requesting the
+    *                  files' contents to be authenticated only and, for the 'DOWNLOAD' command, by
+    *                  the '-t' option requesting only the files' tails to be downloaded
+    * @throws ERR_UNSUPPORTED_CMD Unsupported command
+    * @throws Most of the session and OpenSSL exceptions (see
+    *         "execErrCode.h" and "sessErrCodes.h" for more details)
+    */
+   void parseUserCmdFiles(std::string& cmd, std::vector<std::string>& fileArgs);
+
    /**
     * @brief  Parses and executes a user's input command consisting
     *         of 3 words (parseUserCmd() helper function)
@@ -261,8 +282,10 @@ class Client : public SafeCloudApp
    /**
     * @brief  SafeCloud client object constructor, initializing the IP and port of the
     *         SafeCloud server to connect to and the client's X.509 certificates store
-    * @param  srvIP   The IP address as a string of the SafeCloud server to connect to
-    * @param  srvPort The port of the SafeCloud server to connect to
+    * @param  srvIP    The IP address as a string of the SafeCloud server to connect to
+    * @param  srvPort  The port of the SafeCloud server to connect to
+    * @param  earlyReq Whether the first session request on each connection
+    *                  should be sent along with the 'CLI_AUTH' STSM message
     * @throws ERR_INVALID_SRV_ADDR        Invalid IP address format
     * @throws ERR_INVALID_SRV_PORT        Invalid Port
     * @throws ERR_CA_CERT_OPEN_FAILED     The CA Certificate file could not be opened
@@ -277,7 +300,7 @@ class Client : public SafeCloudApp
     * @throws ERR_STORE_REJECT_SET_FAILED Error in configuring the X.509
     *                                     store to reject revoked certificates
     */
-   Client(char* srvIP, uint16_t srvPort);
+   Client(char* srvIP, uint16_t srvPort, bool earlyReq);
 
    /**
     * @brief SafeCloud client object destructor,
@@ -93,15 +93,17 @@ void OSSignalsCallback(__attribute__((unused)) int signum)
 /**
  * @brief         Attempts to initialize the SafeCloud Client object by passing
  *                it the IP and port of the SafeCloud server to connect to
- * @param srvIP   The IP address as a string of the SafeCloud server to connect to
- * @param srvPort The port of the SafeCloud server to connect to
+ * @param srvIP    The IP address as a string of the SafeCloud server to connect to
+ * @param srvPort  The port of the SafeCloud server to connect to
+ * @param earlyReq Whether the first session request on each connection
+ *                 should be sent along with the 'CLI_AUTH' STSM message
  */
-void clientInit(char* srvIP,uint16_t& srvPort)
+void clientInit(char* srvIP,uint16_t& srvPort,bool earlyReq)
  {
   // Attempt to initialize the client object by
   // passing the server connection parameters
   try
-   { cli = new Client(srvIP,srvPort); }
+   { cli = new Client(srvIP,srvPort,earlyReq); }
   catch(execErrExcp& exeErrExcp)
    {
     // If the exception is relative to an invalid srvIP or srvPort passed
@@ -145,6 +147,8 @@ void printProgramUsageGuidelines()
   std::cerr << "./client [-a IP] [-p PORT] -> Connect to the SafeCloud server "
                "with a custom IPv4 address and/or a custom port PORT >= "
                << std::to_string(SRV_PORT_MIN) << std::endl;
+  std::cerr << "         [-e]              -> Send the first command on each connection "
+               "along with the login (one round-trip login)" << std::endl;
   std::cerr << std::endl;
  }
 
@@ -157,12 +161,14 @@ void printProgramUsageGuidelines()
   *              "defaults.h" (with validity checks remanded to the Client's constructor)\n\n
   *           3) The resulting options' values are written in
   *              the reference variables provided by the caller
-  * @param argc    The number of command-line input arguments
-  * @param argv    The array of command-line input arguments
-  * @param srvIP   The resulting SafeCloud server IP address to connect to as a string
-  * @param srvPort The resulting SafeCloud server port to connect to
+  * @param argc     The number of command-line input arguments
+  * @param argv     The array of command-line input arguments
+  * @param srvIP    The resulting SafeCloud server IP address to connect to as a string
+  * @param srvPort  The resulting SafeCloud server port to connect to
+  * @param earlyReq Whether the first session request on each connection
+  *                 should be sent along with the 'CLI_AUTH' STSM message
   */
-void parseCmdArgs(int argc, char** argv, char* srvIP, uint16_t& srvPort)
+void parseCmdArgs(int argc, char** argv, char* srvIP, uint16_t& srvPort, bool& earlyReq)
  {
   // The candidate IP and port of the SafeCloud server to connect to
   char     _srvIP[16] = SRV_DEFAULT_IP;
@@ -172,7 +178,7 @@ void parseCmdArgs(int argc, char** argv, char* srvIP, uint16_t& srvPort)
   int      opt;
 
   // Read all command-line arguments via the getOpt() function
-  while((opt = getopt(argc, argv, ":a:p:h")) != -1)
+  while((opt = getopt(argc, argv, ":a:p:eh")) != -1)
    switch(opt)
     {
      // Help option
@@ -181,6 +187,11 @@ void parseCmdArgs(int argc, char** argv, char* srvIP, uint16_t& srvPort)
      exit(EXIT_SUCCESS);
      // break
 
+     // One round-trip login option
+     case 'e':
+      earlyReq = true;
+     break;
+
      // Server IP option + its value
      case 'a':
       strncpy(_srvIP, optarg, 15);
@@ -262,6 +273,10 @@ int main(int argc, char** argv)
   char srvIP[16];
   uint16_t srvPort;
 
+  // Whether the first session request on each connection
+  // should be sent along with the 'CLI_AUTH' STSM message
+  bool earlyReq = false;
+
   // Register the SIGINT, SIGTERM and SIGQUIT signals handler
   signal(SIGINT, OSSignalsCallback);
   signal(SIGTERM, OSSignalsCallback);
@@ -269,11 +284,11 @@ int main(int argc, char** argv)
 
   // Determine the IP and port of the SafeCloud server the client
   // application should connect to by parsing the command-line arguments
-  parseCmdArgs(argc,argv,srvIP,srvPort);
+  parseCmdArgs(argc,argv,srvIP,srvPort,earlyReq);
 
   // Attempt to initialize the SafeCloud Client object by passing
   // it the IP and port of the SafeCloud server to connect to
-  clientInit(srvIP,srvPort);
+  clientInit(srvIP,srvPort,earlyReq);
 
   // Start the SafeCloud Client
   try
@@ -27,7 +27,7 @@ DirInfo::DirInfo()
  * @param  dirAbspath The absolute path of the directory to create the snapshot of
  * @throws ERR_DIR_OPEN_FAILED        The target directory was not found
  * @throws ERR_SESS_FILE_READ_FAILED  Error in reading a file's metadata
- * @throws ERR_SESS_DIR_INFO_OVERFLOW The directory information size exceeds 4GB
+ * @throws ERR_SESS_DIR_INFO_OVERFLOW The directory information size overflows a 64-bit integer
  */
 DirInfo::DirInfo(std::string* dirAbspath)
  : dirPath(dirAbspath), dirFiles(), dirRawSize(0), numFiles(0)
@@ -71,8 +71,8 @@ DirInfo::DirInfo(std::string* dirAbspath)
       fileInfoRawSize = strlen(dirFile->d_name) + 3 * sizeof(long int);
 
       // Ensure that adding the file information's raw size to the
-      // directory contents' raw size would not overflow an unsigned integer
-      if(dirRawSize > UINT_MAX - fileInfoRawSize)
+      // directory contents' raw size would not overflow a 64-bit integer
+      if(dirRawSize > UINT64_MAX - fileInfoRawSize)
        THROW_SESS_EXCP(ERR_SESS_DIR_INFO_OVERFLOW, *dirAbspath);
 
       // Add the file's information to the
@@ -114,7 +114,7 @@ DirInfo::~DirInfo()
 /**
  * @brief  Adds a file with its information in the directory
  * @param  fileInfo The information on the file to be added to the directory
- * @throws ERR_SESS_DIR_INFO_OVERFLOW The directory information size exceeds 4GB
+ * @throws ERR_SESS_DIR_INFO_OVERFLOW The directory information size overflows a 64-bit integer
  */
 void DirInfo::addFileInfo(FileInfo* fileInfo)
  {
@@ -122,8 +122,8 @@ void DirInfo::addFileInfo(FileInfo* fileInfo)
   unsigned short fileInfoRawSize = fileInfo->fileName.length() + 3 * sizeof(long int);
 
   // Ensure that adding the file information's raw size to the
-  // directory contents' raw size would not overflow an unsigned integer
-  if(dirRawSize > UINT_MAX - fileInfoRawSize)
+  // directory contents' raw size would not overflow a 64-bit integer
+  if(dirRawSize > UINT64_MAX - fileInfoRawSize)
    THROW_SESS_EXCP(ERR_SESS_DIR_INFO_OVERFLOW, *dirPath);
 
   // Add the file's information to the list of directory's files information
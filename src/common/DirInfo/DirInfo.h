@@ -29,10 +29,10 @@ class DirInfo
 
    // The directory contents' raw size, consisting in the sum of its files names' lengths
    // ('\0' excluded) and their metadata (excluding the directory's absolute path)
-   unsigned int dirRawSize;
+   uint64_t dirRawSize;
 
    // The number of files in the directory
-   unsigned int numFiles;
+   uint64_t numFiles;
 
    /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
@@ -48,7 +48,7 @@ class DirInfo
     * @param  dirAbspath The absolute path of the directory to create the snapshot of
     * @throws ERR_DIR_OPEN_FAILED        The target directory was not found
     * @throws ERR_SESS_FILE_READ_FAILED  Error in reading a file's metadata
-    * @throws ERR_SESS_DIR_INFO_OVERFLOW The directory information size exceeds 4GB
+    * @throws ERR_SESS_DIR_INFO_OVERFLOW The directory information size overflows a 64-bit integer
     */
    explicit DirInfo(std::string* dirAbspath);
 
@@ -62,7 +62,7 @@ class DirInfo
    /**
     * @brief  Adds a file with its information in the directory
     * @param  fileInfo The information on the file to be added to the directory
-    * @throws ERR_SESS_DIR_INFO_OVERFLOW The directory information size exceeds 4GB
+    * @throws ERR_SESS_DIR_INFO_OVERFLOW The directory information size overflows a 64-bit integer
     */
    void addFileInfo(FileInfo* fileInfo);
 
@@ -4,12 +4,16 @@
 
 // System Headers
 #include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <linux/errqueue.h>
+#include <poll.h>
 #include <dirent.h>
 #include <unistd.h>
 #include <cstring>
 
 // SafeCloud Headers
 #include "ConnMgr.h"
+#include "STSMMgr/STSMMsg.h"
 #include "errCodes/execErrCodes/execErrCodes.h"
 
 
@@ -18,8 +22,8 @@
 /* ------------------------------- Utility Methods ------------------------------- */
 
 /**
- * @brief Deletes the contents of the connection's temporary directory
- *        (called within the connection manager's destructor)
+ * @brief Deletes the contents of the connection's temporary directory (called within the
+ *        connection manager's destructor if named temporary files were created in it)
  */
 void ConnMgr::cleanTmpDir()
  {
@@ -144,6 +148,45 @@ bool ConnMgr::isRecvDataAvailable() const
  }
 
 
+/**
+ * @brief  Estimates the connection's bandwidth-delay product from the kernel's TCP_INFO, as the
+ *         product of its measured throughput (congestion window per smoothed RTT) and its RTT
+ * @return The connection's estimated bandwidth-delay product in bytes, or 0 if not available
+ */
+unsigned int ConnMgr::getBDPEstimate() const
+ {
+  // The connection socket's TCP information and its size
+  struct tcp_info tcpInfo;
+  socklen_t tcpInfoLen = sizeof(tcpInfo);
+
+  // Retrieve the connection socket's TCP information, returning
+  // that the BDP is not available if it cannot be retrieved
+  if(getsockopt(_csk, IPPROTO_TCP, TCP_INFO, &tcpInfo, &tcpInfoLen) != 0 || tcpInfo.tcpi_rtt == 0)
+   return 0;
+
+  /*
+   * The connection's throughput is measured as the number of bytes its congestion window allows to
+   * be in flight per smoothed RTT, so that its product by the RTT (i.e. the BDP) reduces to the
+   * congestion window in bytes, which is capped so to prevent overflows on uncommon window sizes
+   */
+  return (unsigned int)std::min((unsigned long)tcpInfo.tcpi_snd_cwnd * tcpInfo.tcpi_snd_mss, (unsigned long)UINT32_MAX);
+ }
+
+
+/**
+ * @brief  Returns the optional features enabled on the connection (STSM_FEATURE_ flags)
+ * @return The optional features enabled on the connection (STSM_FEATURE_ flags)
+ */
+uint8_t ConnMgr::getFeatures() const
+ {
+  return (uint8_t)((_compress ? STSM_FEATURE_COMPRESSION : 0) | (_largeFiles ? STSM_FEATURE_LARGE_FILES : 0) |
+                   (_resumeUploads ? STSM_FEATURE_RESUMABLE_UPLOADS : 0) |
+                   (_rangedDownloads ? STSM_FEATURE_RANGED_DOWNLOADS : 0) |
+                   (_dedupUploads ? STSM_FEATURE_DEDUP_UPLOADS : 0) |
+                   (_deltaUploads ? STSM_FEATURE_DELTA_UPLOADS : 0));
+ }
+
+
 /* ----------------------- SafeCloud Messages Send/Receive ----------------------- */
 
 /**
@@ -275,29 +318,46 @@ void ConnMgr::recvFullMsg()
  */
 void ConnMgr::sendRaw(unsigned int numBytes)
  {
-  // Connection socket send() return, representing, if no error
-  // has occurred, the number of bytes read sent from the
-  // primary connection buffer through the connection socket
-  ssize_t sendRet;
-
   // Assert the number of bytes to be sent to be less
   // or equal than the primary connection buffer size
   if(numBytes > _priBufSize)
    THROW_EXEC_EXCP(ERR_SEND_OVERFLOW,std::to_string(numBytes) +
                                      " > _priBufSize = " + std::to_string(_priBufSize));
 
+  // Send the bytes from the start of the primary connection buffer
+  sendRaw(&_priBuf[0], numBytes);
+
   // Reset the index of the most significant byte in the primary connection buffer
   _priBufInd = 0;
+ }
+
+
+/**
+ * @brief Sends bytes from an arbitrary buffer to the connection peer, not
+ *        affecting the contents or the indexes of the connection buffers
+ * @param srcAddr  The initial address of the bytes to be sent
+ * @param numBytes The number of bytes to be sent
+ * @throws ERR_PEER_DISCONNECTED The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED       send() fatal error
+ */
+void ConnMgr::sendRaw(const unsigned char* srcAddr, unsigned int numBytes)
+ {
+  // Connection socket send() return, representing, if no error
+  // has occurred, the number of bytes sent through the connection socket
+  ssize_t sendRet;
+
+  // The number of bytes that have been sent
+  unsigned int sentBytes = 0;
 
-  do
+  while(sentBytes != numBytes)
    {
-    // Attempt to send the pending message bytes through the connection socket
-    sendRet = send(_csk, (const char*)&_priBuf + _priBufInd, numBytes - _priBufInd, 0);
+    // Attempt to send the pending bytes through the connection socket
+    sendRet = send(_csk, (const char*)srcAddr + sentBytes, numBytes - sentBytes, 0);
 
-    // If any number of bytes were successfully sent, increment the index of the
-    // most significant byte in the primary connection buffer of that amount
+    // If any number of bytes were successfully
+    // sent, increment the sent bytes of that amount
     if(sendRet > 0)
-     _priBufInd += sendRet;
+     sentBytes += sendRet;
     else
 
      // Otherwise, if the send() failed, depending on its error
@@ -323,11 +383,8 @@ void ConnMgr::sendRaw(unsigned int numBytes)
       // bytes was sent (sendRet == 0), retry sending
      else
       LOG_WARNING("send() sent 0 bytes (numBytes = " + std::to_string(numBytes)
-                  + ", _priBufInd = " + std::to_string(_priBufInd) + ")")
-   } while(_priBufInd != numBytes);
-
-  // Reset the index of the most significant byte in the primary connection buffer
-  _priBufInd = 0;
+                  + ", sentBytes = " + std::to_string(sentBytes) + ")")
+   }
  }
 
 
@@ -371,7 +428,7 @@ unsigned int ConnMgr::recvRaw()
    *    - The difference between the expected data block size and the index of the first available byte
    *      in the primary connection buffer (so to prevent reading bytes belonging to the next data block)
    */
-  maxReadBytes = std::min((_priBufSize - _priBufInd), (_recvBlockSize - _priBufInd));
+  maxReadBytes = (size_t)std::min((uint64_t)(_priBufSize - _priBufInd), (_recvBlockSize - _priBufInd));
 
   // Block until any number of bytes up to 'maxReadBytes' are received from the
   // connection socket to the first available byte in the primary connection buffer
@@ -411,6 +468,274 @@ unsigned int ConnMgr::recvRaw()
  }
 
 
+/**
+ * @brief  Blocks until a given number of bytes are read from the connection socket into an
+ *         arbitrary buffer, not affecting the contents or the indexes of the connection buffers
+ * @param  dstAddr  The address where to write the received bytes
+ * @param  numBytes The number of bytes to be received
+ * @throws ERR_CSK_RECV_FAILED   Error in receiving data from the connection socket
+ * @throws ERR_PEER_DISCONNECTED The connection peer has abruptly disconnected
+ */
+void ConnMgr::recvRaw(unsigned char* dstAddr, unsigned int numBytes)
+ {
+  // Connection socket recv() return, representing, if no error
+  // has occurred, the number of bytes read from the connection socket
+  ssize_t recvRet;
+
+  // The number of bytes that have been received
+  unsigned int recvBytes = 0;
+
+  while(recvBytes != numBytes)
+   {
+    // Block until any number of the pending bytes are received from the connection socket
+    recvRet = recv(_csk, &dstAddr[recvBytes], numBytes - recvBytes, 0);
+
+    // Depending on the recv() return
+    switch(recvRet)
+     {
+      /* ------------------ recv() error ------------------ */
+      case -1:
+
+       // If the process was interrupted within the recv(), retry receiving
+       if(errno == EINTR)
+        break;
+
+       // If the peer abruptly disconnected
+       if(errno == ECONNRESET)
+        THROW_EXEC_EXCP(ERR_PEER_DISCONNECTED);
+
+        // Otherwise it is a recv() FATAL error
+       else
+        THROW_EXEC_EXCP(ERR_CSK_RECV_FAILED, ERRNO_DESC);
+
+      /* ------------ Abrupt peer disconnection ------------ */
+      case 0:
+       THROW_EXEC_EXCP(ERR_PEER_DISCONNECTED);
+
+      /* ---------------- Valid bytes read ---------------- */
+      default:
+       recvBytes += recvRet;
+     }
+   }
+ }
+
+
+/* --------------------------- Zero-Copy Raw Data Send --------------------------- */
+
+/**
+ * @brief Attempts to enable zero-copy sends (MSG_ZEROCOPY) on the connection socket,
+ *        leaving them disabled if they are not supported by the kernel
+ */
+void ConnMgr::enableZeroCopy()
+ {
+  // Socket option value
+  int zcOpt = 1;
+
+  // Zero-copy sends are not supported by kernels older than 4.14, in which
+  // case the connection just keeps using copying sends (not an error)
+  _zcEnabled = (setsockopt(_csk, SOL_SOCKET, SO_ZEROCOPY, &zcOpt, sizeof(zcOpt)) == 0);
+
+  if(!_zcEnabled)
+   {
+    LOG_DEBUG("Zero-copy sends not available on the connection socket (" + std::string(ERRNO_DESC) + ")")
+   }
+ }
+
+
+/**
+ * @brief  Processes the zero-copy completion notifications pending on the connection socket's error
+ *         queue without blocking, updating the number of zero-copy sends whose buffers were released
+ * @return Whether any zero-copy completion notification was processed
+ * @throws ERR_SEND_FAILED Error in reading from the connection socket's error queue
+ */
+bool ConnMgr::recvZeroCopyCompl()
+ {
+  // The message header and control buffer used for reading the error queue
+  struct msghdr errMsg;
+  unsigned char errCtrl[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+
+  // A control message in the error queue message and its extended error
+  struct cmsghdr*           errCmsg;
+  struct sock_extended_err* extErr;
+
+  // Whether any zero-copy completion notification was processed
+  bool complRecv = false;
+
+  while(true)
+   {
+    // Read the next message from the socket's error queue, if any
+    memset(&errMsg, 0, sizeof(errMsg));
+    errMsg.msg_control    = errCtrl;
+    errMsg.msg_controllen = sizeof(errCtrl);
+
+    if(recvmsg(_csk, &errMsg, MSG_ERRQUEUE | MSG_DONTWAIT) == -1)
+     {
+      // If the process was interrupted within the recvmsg(), retry reading
+      if(errno == EINTR)
+       continue;
+
+      // If the error queue is empty, all pending notifications have been processed
+      if(errno == EAGAIN || errno == EWOULDBLOCK)
+       return complRecv;
+
+      THROW_EXEC_EXCP(ERR_SEND_FAILED, *_name, "Reading the socket error queue: " + std::string(ERRNO_DESC));
+     }
+
+    // Process the zero-copy completion notifications in the message
+    for(errCmsg = CMSG_FIRSTHDR(&errMsg); errCmsg != NULL; errCmsg = CMSG_NXTHDR(&errMsg, errCmsg))
+     {
+      if(!(errCmsg->cmsg_level == SOL_IP && errCmsg->cmsg_type == IP_RECVERR) &&
+         !(errCmsg->cmsg_level == SOL_IPV6 && errCmsg->cmsg_type == IPV6_RECVERR))
+       continue;
+
+      extErr = (struct sock_extended_err*)CMSG_DATA(errCmsg);
+      if(extErr->ee_errno != 0 || extErr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+       continue;
+
+      // A notification reports the completion of the zero-copy sends in the [ee_info, ee_data] sequence numbers
+      // range, with TCP completing them in order (the comparison being performed so to handle wrap-arounds)
+      if((int32_t)(extErr->ee_data + 1 - _zcComplSeq) > 0)
+       _zcComplSeq = extErr->ee_data + 1;
+
+      // If the kernel had to copy the bytes anyway (e.g. on the loopback interface or on network
+      // devices not supporting scatter-gather), disable zero-copy sends on the connection,
+      // as in this case they are more expensive than copying sends
+      if(extErr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+       _zcEnabled = false;
+
+      complRecv = true;
+     }
+   }
+ }
+
+
+/**
+ * @brief  Sends bytes from an arbitrary buffer to the connection peer in zero-copy mode (MSG_ZEROCOPY)
+ *         if enabled and if their number is at least CONN_ZEROCOPY_MIN_SIZE, falling back to a
+ *         copying send otherwise, where in zero-copy mode the buffer must not be modified
+ *         before the send is reported as completed by the waitZeroCopyCompl() method
+ * @param  srcAddr  The initial address of the bytes to be sent
+ * @param  numBytes The number of bytes to be sent
+ * @return The zero-copy sequence number to be passed to the waitZeroCopyCompl()
+ *         method for waiting for the kernel to release the buffer
+ * @throws ERR_PEER_DISCONNECTED The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED       send() fatal error
+ */
+uint32_t ConnMgr::sendRawZeroCopy(const unsigned char* srcAddr, unsigned int numBytes)
+ {
+  // Connection socket send() return, representing, if no error
+  // has occurred, the number of bytes sent through the connection socket
+  ssize_t sendRet;
+
+  // The number of bytes that have been sent
+  unsigned int sentBytes = 0;
+
+  // If zero-copy sends are disabled or the bytes to be sent are too
+  // few for them to be worth it, fall back to a copying send
+  if(!_zcEnabled || numBytes < CONN_ZEROCOPY_MIN_SIZE)
+   {
+    sendRaw(srcAddr, numBytes);
+    return _zcSendSeq;
+   }
+
+  while(sentBytes != numBytes)
+   {
+    // Attempt to send the pending bytes through the connection socket in zero-copy mode
+    sendRet = send(_csk, (const char*)srcAddr + sentBytes, numBytes - sentBytes, MSG_ZEROCOPY);
+
+    // If any number of bytes were successfully sent, increment the sent bytes of
+    // that amount, where the kernel associates a sequence number to each send()
+    if(sendRet > 0)
+     {
+      sentBytes += sendRet;
+      _zcSendSeq++;
+     }
+    else
+
+     // Otherwise, if the send() failed, depending on its error
+     if(sendRet == -1)
+      switch(errno)
+       {
+        // If the process was interrupted
+        // within the send(), retry sending
+        case EINTR:
+         break;
+
+        // If the kernel could not pin further pages of the buffer (e.g. because the socket's
+        // optional memory limit was reached), send the remaining bytes by copying them
+        case ENOBUFS:
+         sendRaw(srcAddr + sentBytes, numBytes - sentBytes);
+         return _zcSendSeq;
+
+        // If the peer abruptly closed the connection while
+        // data was being sent, throw the associated exception
+        case ECONNRESET:
+         THROW_EXEC_EXCP(ERR_PEER_DISCONNECTED, *_name);
+
+        // All other send() errors are FATAL errors
+        default:
+         THROW_EXEC_EXCP(ERR_SEND_FAILED, *_name,ERRNO_DESC);
+       }
+
+      // Otherwise, if no error has occurred and no
+      // bytes was sent (sendRet == 0), retry sending
+     else
+      LOG_WARNING("send() sent 0 bytes (numBytes = " + std::to_string(numBytes)
+                  + ", sentBytes = " + std::to_string(sentBytes) + ")")
+   }
+
+  return _zcSendSeq;
+ }
+
+
+/**
+ * @brief  Blocks until the kernel has released the buffers of all zero-copy
+ *         sends preceding a zero-copy sequence number (returned by the
+ *         sendRawZeroCopy() method), which may so be modified
+ * @param  sendSeq The zero-copy sequence number
+ * @throws ERR_PEER_DISCONNECTED The connection peer has abruptly disconnected
+ * @throws ERR_SEND_FAILED       Error in waiting for the zero-copy completion notifications
+ */
+void ConnMgr::waitZeroCopyCompl(uint32_t sendSeq)
+ {
+  // The connection socket poll() descriptor, where no events must be requested
+  // as pending error queue messages are always reported as POLLERR
+  struct pollfd cskPoll = {_csk, 0, 0};
+
+  // The connection socket pending error, if any
+  int       sockErr;
+  socklen_t sockErrLen = sizeof(sockErr);
+
+  // While not all the zero-copy sends preceding the sequence number have completed
+  // (the comparison being performed so to handle wrap-arounds)
+  while((int32_t)(sendSeq - _zcComplSeq) > 0)
+   {
+    // Block until the connection socket's error queue is not empty
+    if(poll(&cskPoll, 1, -1) == -1)
+     {
+      if(errno == EINTR)
+       continue;
+      THROW_EXEC_EXCP(ERR_SEND_FAILED, *_name, "Polling the socket error queue: " + std::string(ERRNO_DESC));
+     }
+
+    // Process the pending zero-copy completion notifications
+    if(recvZeroCopyCompl())
+     continue;
+
+    // If no notification was pending, the poll() was woken by a
+    // pending socket error or by the connection being closed
+    if(getsockopt(_csk, SOL_SOCKET, SO_ERROR, &sockErr, &sockErrLen) == 0 && sockErr != 0)
+     {
+      if(sockErr == ECONNRESET || sockErr == EPIPE)
+       THROW_EXEC_EXCP(ERR_PEER_DISCONNECTED, *_name);
+      THROW_EXEC_EXCP(ERR_SEND_FAILED, *_name, strerror(sockErr));
+     }
+    if(cskPoll.revents & (POLLHUP | POLLNVAL))
+     THROW_EXEC_EXCP(ERR_PEER_DISCONNECTED, *_name);
+   }
+ }
+
+
 /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
 /**
@@ -424,20 +749,24 @@ ConnMgr::ConnMgr(int csk, std::string* name, std::string* tmpDir)
  : _connPhase(KEYXCHANGE), _recvMode(RECV_MSG), _csk(csk), _shutdownConn(false),
    _priBuf(), _priBufSize(CONN_BUF_SIZE), _priBufInd(0), _recvBlockSize(0),
    _secBuf(), _secBufSize(CONN_BUF_SIZE), _secBufInd(0),
-   _skey(), _iv(nullptr), _name(name), _tmpDir(tmpDir)
- {}
+   _zcEnabled(false), _zcSendSeq(0), _zcComplSeq(0),
+   _skey(), _iv(nullptr), _compress(false), _largeFiles(false), _resumeUploads(false), _rangedDownloads(false),
+   _dedupUploads(false), _deltaUploads(false), _aeadCipher(AEAD_AES_128_GCM), _name(name),
+   _tmpDir(tmpDir), _tmpDirUsed(false)
+ { enableZeroCopy(); }
 
 
 /**
  * @brief Connection Manager object destructor, which:\n\n
  *          1) Closes its associated connection socket\n\n
- *          2) Delete the contents of the connection's temporary directory\n\n
+ *          2) Delete the contents of the connection's temporary
+ *             directory, if named temporary files were created in it\n\n
  *          3) Safely deletes all the connection's sensitive information
  */
 ConnMgr::~ConnMgr()
  {
   // Delete the connection's symmetric key and IV
-  OPENSSL_cleanse(&_skey[0], AES_128_KEY_SIZE);
+  OPENSSL_cleanse(&_skey[0], AEAD_KEY_MAX_SIZE);
   delete _iv;
 
   // Safely delete the connection's buffers
@@ -448,8 +777,9 @@ ConnMgr::~ConnMgr()
   if(close(_csk) != 0)
    LOG_EXEC_CODE(ERR_CSK_CLOSE_FAILED, std::to_string(_csk), ERRNO_DESC);
 
-  // If set, delete the contents of the connection's temporary directory
-  if(_tmpDir != nullptr)
+  // If named temporary files were created in it, delete the contents of the connection's
+  // temporary directory (anonymous temporary files are instead released by the kernel)
+  if(_tmpDir != nullptr && _tmpDirUsed)
    cleanTmpDir();
  }
 
@@ -12,6 +12,7 @@
 #include "defaults.h"
 #include "SafeCloudApp/ConnMgr/IV/IV.h"
 #include "ossl_crypto/AES_128_CBC.h"
+#include "ossl_crypto/AEAD.h"
 
 
 // Connection Manager Buffers Size
@@ -21,6 +22,11 @@
 // (STSMMsg or Session Message) length header
 #define MSG_LEN_HEAD_SIZE 2
 
+// The minimum number of bytes for a raw send to be performed in zero-copy mode (MSG_ZEROCOPY),
+// as for smaller sends the cost of pinning the buffer's pages and of processing the
+// kernel's completion notification outweighs the cost of copying the bytes
+#define CONN_ZEROCOPY_MIN_SIZE (32 * 1024)    // 32 KB
+
 
 class ConnMgr
  {
@@ -70,7 +76,7 @@ class ConnMgr
    unsigned int       _priBufInd;
 
    // Expected size of the data block (message or raw) to be received
-   uint32_t           _recvBlockSize;
+   uint64_t           _recvBlockSize;
 
    /* ----------------------- Secondary Communication Buffer ----------------------- */
 
@@ -89,14 +95,43 @@ class ConnMgr
    // Secondary communication buffer size
    const unsigned int _secBufSize;
 
+   /* ------------------------ Zero-Copy Send Information ------------------------ */
+
+   /*
+    * Zero-copy sends (MSG_ZEROCOPY) have the kernel transmit the bytes directly from the sender's buffer,
+    * which so cannot be modified until the kernel has released it, as notified by a completion
+    * notification queued on the connection socket's error queue, where the kernel identifies
+    * each zero-copy send via an increasing 32-bit sequence number starting from 0
+    */
+
+   bool     _zcEnabled;   // Whether zero-copy sends are enabled on the connection socket
+   uint32_t _zcSendSeq;   // The number of zero-copy sends performed on the connection socket
+   uint32_t _zcComplSeq;  // The number of zero-copy sends whose buffers have been released by the kernel
+
    /* -------------------- Connection Cryptographic Quantities -------------------- */
-   unsigned char _skey[AES_128_KEY_SIZE];   // The connection's symmetric key
+   unsigned char _skey[AEAD_KEY_MAX_SIZE];  // The connection's symmetric key
    IV* _iv;                                 // The connection's initialization vector
+   bool _compress;                          // Whether the file transfers on the connection are
+                                            // compressed, as negotiated in the STSM handshake
+   bool _largeFiles;                        // Whether the connection peers support 64-bit file and storage
+                                            // pool sizes, as negotiated in the STSM handshake
+   bool _resumeUploads;                     // Whether interrupted uploads are resumed from the contents the
+                                            // server already verified, as negotiated in the STSM handshake
+   bool _rangedDownloads;                   // Whether downloads may be restricted to a byte range of their
+                                            // file, as negotiated in the STSM handshake
+   bool _dedupUploads;                      // Whether uploads announce their file's digest so to skip the contents
+                                            // the server already holds, as negotiated in the STSM handshake
+   bool _deltaUploads;                      // Whether uploads of files the server already holds may send only the
+                                            // changes to its copy, as negotiated in the STSM handshake
+   AEADCipher _aeadCipher;                  // The AEAD cipher protecting the session phase of the
+                                            // connection, as negotiated in the STSM handshake
 
    /* ----------------------- Connection Client Information ----------------------- */
    std::string* _name;   // The name of the client associated with this connection
    std::string* _tmpDir; // The absolute path of the temporary directory
                          // of the client associated with this connection
+   bool _tmpDirUsed;     // Whether named temporary files were created in the temporary directory,
+                         // which is otherwise left untouched (see 'SessMgr::prepRecvFileRaw()')
 
 
    /* =============================== FRIEND CLASSES =============================== */
@@ -109,8 +144,8 @@ class ConnMgr
    /* ------------------------------- Utility Methods ------------------------------- */
 
    /**
-    * @brief Deletes the contents of the connection's temporary directory
-    *        (called within the connection manager's destructor)
+    * @brief Deletes the contents of the connection's temporary directory (called within the
+    *        connection manager's destructor if named temporary files were created in it)
     */
    void cleanTmpDir();
 
@@ -130,6 +165,19 @@ class ConnMgr
     */
    bool isRecvDataAvailable() const;
 
+   /**
+    * @brief  Estimates the connection's bandwidth-delay product from the kernel's TCP_INFO, as the
+    *         product of its measured throughput (congestion window per smoothed RTT) and its RTT
+    * @return The connection's estimated bandwidth-delay product in bytes, or 0 if not available
+    */
+   unsigned int getBDPEstimate() const;
+
+   /**
+    * @brief  Returns the optional features enabled on the connection (STSM_FEATURE_ flags)
+    * @return The optional features enabled on the connection (STSM_FEATURE_ flags)
+    */
+   uint8_t getFeatures() const;
+
    /* ----------------------- SafeCloud Messages Send/Receive ----------------------- */
 
    /**
@@ -171,6 +219,16 @@ class ConnMgr
     */
    void sendRaw(unsigned int numBytes);
 
+   /**
+    * @brief Sends bytes from an arbitrary buffer to the connection peer, not
+    *        affecting the contents or the indexes of the connection buffers
+    * @param srcAddr  The initial address of the bytes to be sent
+    * @param numBytes The number of bytes to be sent
+    * @throws ERR_PEER_DISCONNECTED The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED       send() fatal error
+    */
+   void sendRaw(const unsigned char* srcAddr, unsigned int numBytes);
+
    /**
     * @brief  Blocks until any number of bytes belonging to the data block to be received (message
     *         or raw) are read from the connection socket into the primary connection buffer
@@ -182,6 +240,56 @@ class ConnMgr
     */
    unsigned int recvRaw();
 
+   /**
+    * @brief  Blocks until a given number of bytes are read from the connection socket into an
+    *         arbitrary buffer, not affecting the contents or the indexes of the connection buffers
+    * @param  dstAddr  The address where to write the received bytes
+    * @param  numBytes The number of bytes to be received
+    * @throws ERR_CSK_RECV_FAILED   Error in receiving data from the connection socket
+    * @throws ERR_PEER_DISCONNECTED The connection peer has abruptly disconnected
+    */
+   void recvRaw(unsigned char* dstAddr, unsigned int numBytes);
+
+   /* --------------------------- Zero-Copy Raw Data Send --------------------------- */
+
+   /**
+    * @brief Attempts to enable zero-copy sends (MSG_ZEROCOPY) on the connection socket,
+    *        leaving them disabled if they are not supported by the kernel
+    */
+   void enableZeroCopy();
+
+   /**
+    * @brief  Processes the zero-copy completion notifications pending on the connection socket's error
+    *         queue without blocking, updating the number of zero-copy sends whose buffers were released
+    * @return Whether any zero-copy completion notification was processed
+    * @throws ERR_SEND_FAILED Error in reading from the connection socket's error queue
+    */
+   bool recvZeroCopyCompl();
+
+   /**
+    * @brief  Sends bytes from an arbitrary buffer to the connection peer in zero-copy mode (MSG_ZEROCOPY)
+    *         if enabled and if their number is at least CONN_ZEROCOPY_MIN_SIZE, falling back to a
+    *         copying send otherwise, where in zero-copy mode the buffer must not be modified
+    *         before the send is reported as completed by the waitZeroCopyCompl() method
+    * @param  srcAddr  The initial address of the bytes to be sent
+    * @param  numBytes The number of bytes to be sent
+    * @return The zero-copy sequence number to be passed to the waitZeroCopyCompl()
+    *         method for waiting for the kernel to release the buffer
+    * @throws ERR_PEER_DISCONNECTED The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED       send() fatal error
+    */
+   uint32_t sendRawZeroCopy(const unsigned char* srcAddr, unsigned int numBytes);
+
+   /**
+    * @brief  Blocks until the kernel has released the buffers of all zero-copy
+    *         sends preceding a zero-copy sequence number (returned by the
+    *         sendRawZeroCopy() method), which may so be modified
+    * @param  sendSeq The zero-copy sequence number
+    * @throws ERR_PEER_DISCONNECTED The connection peer has abruptly disconnected
+    * @throws ERR_SEND_FAILED       Error in waiting for the zero-copy completion notifications
+    */
+   void waitZeroCopyCompl(uint32_t sendSeq);
+
   public:
 
    /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
@@ -198,7 +306,8 @@ class ConnMgr
    /**
     * @brief Connection Manager object destructor, which:\n\n
     *          1) Closes its associated connection socket\n\n
-    *          2) Delete the contents of the connection's temporary directory\n\n
+    *          2) Delete the contents of the connection's temporary
+    *             directory, if named temporary files were created in it\n\n
     *          3) Safely deletes all the connection's sensitive information
     */
    ~ConnMgr();
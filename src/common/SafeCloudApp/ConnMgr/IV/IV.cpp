@@ -32,6 +32,19 @@ IV::IV() : iv_AES_CBC(), iv_AES_GCM(), iv_var(), iv_var_start()
  }
 
 
+/**
+ * @brief IV object channel constructor, deriving from an IV an independent IV for a communication
+ *        channel by XOR-ing the channel identifier into the IV's constant AES_GCM_128 part, so that
+ *        IVs of different channels never coincide while sharing the same variable part
+ * @param iv      The IV to be derived from
+ * @param channel The communication channel identifier (must be != 0 for the derived
+ *                IV to differ from the one it is derived from)
+ */
+IV::IV(const IV& iv, uint32_t channel)
+ : iv_AES_CBC(iv.iv_AES_CBC), iv_AES_GCM(iv.iv_AES_GCM ^ channel), iv_var(iv.iv_var), iv_var_start(iv.iv_var_start)
+ {}
+
+
 /**
  * @brief IV object destructor, safely deleting the IV value
  */
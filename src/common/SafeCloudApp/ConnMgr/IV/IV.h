@@ -57,6 +57,16 @@ class IV
     */
    IV();
 
+   /**
+    * @brief IV object channel constructor, deriving from an IV an independent IV for a communication
+    *        channel by XOR-ing the channel identifier into the IV's constant AES_GCM_128 part, so that
+    *        IVs of different channels never coincide while sharing the same variable part
+    * @param iv      The IV to be derived from
+    * @param channel The communication channel identifier (must be != 0 for the derived
+    *                IV to differ from the one it is derived from)
+    */
+   IV(const IV& iv, uint32_t channel);
+
    /**
     * @brief IV object destructor, safely deleting the IV value
     */
@@ -5,6 +5,10 @@
 // System Headers
 #include <string.h>
 
+// OpenSSL Headers
+#include <openssl/kdf.h>
+#include <openssl/hmac.h>
+
 // SafeCloud Headers
 #include "STSMMgr.h"
 #include "errCodes/execErrCodes/execErrCodes.h"
@@ -65,6 +69,59 @@ EVP_PKEY* STSMMgr::DHE_2048_Keygen()
   return DHEKey;
  }
 
+
+/**
+ * @brief  Generates an ephemeral X25519 key pair for the local actor
+ * @return The EVP_PKEY structure holding the local actor's ephemeral X25519 key pair
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT EVP_PKEY key generation initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN      EVP_PKEY Key generation failed
+ */
+EVP_PKEY* STSMMgr::X25519_Keygen()
+ {
+  EVP_PKEY_CTX* X25519GenCtx;          // X25519 key generation context
+  EVP_PKEY*     X25519Key = nullptr;   // The resulting actor's ephemeral X25519 key pair
+
+  // Create an X25519 key generation context, which
+  // differently from DH requires no parameters
+  X25519GenCtx = EVP_PKEY_CTX_new_id(EVP_PKEY_X25519, nullptr);
+  if(!X25519GenCtx)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_CTX_NEW, OSSL_ERR_DESC);
+
+  // Initialize the key generation context
+  if(EVP_PKEY_keygen_init(X25519GenCtx) != 1)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_KEYGEN_INIT, OSSL_ERR_DESC);
+
+  // Generate an ephemeral X25519 key pair
+  if(EVP_PKEY_keygen(X25519GenCtx, &X25519Key) != 1)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_KEYGEN, OSSL_ERR_DESC);
+
+  // Free the key generation context
+  EVP_PKEY_CTX_free(X25519GenCtx);
+
+  // Return the actor's ephemeral X25519 key pair
+  return X25519Key;
+ }
+
+
+/**
+ * @brief  Generates the local actor's ephemeral key pair of
+ *         the type of the STSM suite used in the key exchange
+ * @throws ERR_OSSL_EVP_PKEY_NEW         EVP_PKEY struct creation failed
+ * @throws ERR_OSSL_EVP_PKEY_ASSIGN      EVP_PKEY struct assignment failure
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT EVP_PKEY key generation initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN      EVP_PKEY Key generation failed
+ */
+void STSMMgr::EDHKeygen()
+ {
+  // Generate the local actor's ephemeral key pair of the suite's type
+  if(_stsmSuite == STSM_SUITE_X25519)
+   _myDHEKey = X25519_Keygen();
+  else
+   _myDHEKey = DHE_2048_Keygen();
+ }
+
 /* ---------------------- Ephemeral Public Keys Utilities ---------------------- */
 
 /**
@@ -95,14 +152,27 @@ void STSMMgr::logEDHPubKey(EVP_PKEY* EDHPubKey)
 
 
 /**
- * @brief  Writes an actor's ephemeral DH public key at the specified memory address
+ * @brief  Writes an actor's ephemeral public key at the specified memory address, in
+ *         PEM format for DH 2048-bit keys or in raw format for X25519 keys
  * @param  EDHPubKey the actor's ephemeral DH public key to be printed
  * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
  * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the actor's ephemeral DH public key into the BIO
  * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read the actor's ephemeral DH public key from the BIO
+ * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write the actor's ephemeral X25519 public key
  */
 void STSMMgr::writeEDHPubKey(EVP_PKEY* EDHPubKey,unsigned char* addr)
  {
+  // The size of a raw X25519 public key
+  size_t rawPubKeySize = X25519_PUBKEY_SIZE;
+
+  // X25519 public keys are directly written in their fixed-size raw format
+  if(EVP_PKEY_get_base_id(EDHPubKey) == EVP_PKEY_X25519)
+   {
+    if(EVP_PKEY_get_raw_public_key(EDHPubKey, addr, &rawPubKeySize) != 1)
+     THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY, OSSL_ERR_DESC);
+    return;
+   }
+
   // Initialize a memory BIO for storing the actor's ephemeral DH public key
   BIO* EDHPubKeyBIO = BIO_new(BIO_s_mem());
   if(EDHPubKeyBIO == NULL)
@@ -122,6 +192,58 @@ void STSMMgr::writeEDHPubKey(EVP_PKEY* EDHPubKey,unsigned char* addr)
  }
 
 
+/**
+ * @brief  Returns the size in bytes of an encoded ephemeral public key in the STSM suite used
+ * @return The size in bytes of an encoded ephemeral public key in the STSM suite used
+ */
+unsigned int STSMMgr::EDHPubKeySize()
+ {
+  if(_stsmSuite == STSM_SUITE_X25519)
+   return X25519_PUBKEY_SIZE;
+  else
+   return DH2048_PUBKEY_PEM_SIZE;
+ }
+
+
+/**
+ * @brief  Reads the remote actor's ephemeral public key of the STSM suite used from
+ *         the specified memory address, leaving it to NULL if it is not valid
+ * @param  addr The address of the remote actor's encoded ephemeral public key
+ * @throws ERR_OSSL_BIO_NEW_FAILED OpenSSL BIO initialization failed
+ */
+void STSMMgr::readOtherEDHPubKey(unsigned char* addr)
+ {
+  // X25519 public keys are directly read from their fixed-size raw format (where
+  // low-order points are rejected in the derivation of the shared secret)
+  if(_stsmSuite == STSM_SUITE_X25519)
+   {
+    _otherDHEPubKey = EVP_PKEY_new_raw_public_key(EVP_PKEY_X25519, NULL, addr, X25519_PUBKEY_SIZE);
+    return;
+   }
+
+  // Initialize a memory BIO to the remote actor's ephemeral DH public key
+  BIO* otherPubDHBIO = BIO_new_mem_buf(addr, DH2048_PUBKEY_PEM_SIZE);
+  if(otherPubDHBIO == NULL)
+   THROW_EXEC_EXCP(ERR_OSSL_BIO_NEW_FAILED, OSSL_ERR_DESC);
+
+  // Write the remote actor's ephemeral DH public
+  // key from the memory BIO into the EVP_PKEY structure
+  _otherDHEPubKey = PEM_read_bio_PUBKEY(otherPubDHBIO, NULL, NULL, NULL);
+
+  // Free the memory BIO
+  if(BIO_free(otherPubDHBIO) != 1)
+   LOG_EXEC_CODE(ERR_OSSL_BIO_FREE_FAILED, OSSL_ERR_DESC);
+
+  // Ensure the remote actor's public key to be a DH key (and
+  // not, for example, an RSA key of the same PEM size)
+  if(_otherDHEPubKey != nullptr && EVP_PKEY_get_base_id(_otherDHEPubKey) != EVP_PKEY_DHX)
+   {
+    EVP_PKEY_free(_otherDHEPubKey);
+    _otherDHEPubKey = nullptr;
+   }
+ }
+
+
 /* --------------------------- Session Key Derivation --------------------------- */
 
 /**
@@ -131,9 +253,31 @@ void STSMMgr::writeEDHPubKey(EVP_PKEY* EDHPubKey,unsigned char* addr)
 * @throws ERR_OSSL_BIO_NEW_FAILED              Memory BIO Initialization Failed
 * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the public key into the memory BIO
 * @throws ERR_OSSL_EVP_PKEY_NEW                EVP_PKEY struct creation failed
+* @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to extract the raw X25519 public key
+* @throws ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY     Failed to rebuild the raw X25519 public key
 */
 void STSMMgr::delMyDHEPrivKey()
  {
+  // The local actor's raw X25519 public key and its size
+  unsigned char myRawPubKey[X25519_PUBKEY_SIZE];
+  size_t        myRawPubKeySize = X25519_PUBKEY_SIZE;
+
+  // X25519 key pairs are rebuilt from their raw public key alone
+  if(_stsmSuite == STSM_SUITE_X25519)
+   {
+    if(EVP_PKEY_get_raw_public_key(_myDHEKey, myRawPubKey, &myRawPubKeySize) != 1)
+     THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY, OSSL_ERR_DESC);
+
+    // Free the local actor's ephemeral X25519 key pair
+    EVP_PKEY_free(_myDHEKey);
+
+    // Rebuild the local actor's ephemeral X25519 public key
+    _myDHEKey = EVP_PKEY_new_raw_public_key(EVP_PKEY_X25519, NULL, myRawPubKey, myRawPubKeySize);
+    if(_myDHEKey == nullptr)
+     THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY, OSSL_ERR_DESC);
+    return;
+   }
+
   // Initialize a memory BIO for storing the local actor's ephemeral DH public key
   BIO* myEDHPubKeyBIO = BIO_new(BIO_s_mem());
   if(myEDHPubKeyBIO == NULL)
@@ -170,11 +314,14 @@ void STSMMgr::delMyDHEPrivKey()
 
 
 /**
- * @brief  Derives the shared AES_128 session key from the local actor's
- *         private and the remote actor's public ephemeral DH keys
- * @param  skey The buffer where to write the resulting AES_128 session key
+ * @brief  Derives the shared session key from the local actor's private and the remote
+ *         actor's public ephemeral DH keys, of which the AES_128 ciphers (AES_128_CBC in the STSM
+ *         handshake, AES_128_GCM in the session phase) use the first AES_128_KEY_SIZE = 16 bytes
+ * @param  skey The buffer where to write the resulting session key
+ * @param  psk  The resumption PSK the session key must also be derived from in an
+ *              abbreviated STSM execution (nullptr in a full STSM execution)
  * @note   This function assumes the "skey" destination buffer to be large enough to
- *         contain the resulting AES_128 session key (at least AES_128_KEY_SIZE = 16 bytes)
+ *         contain the resulting session key (at least AEAD_KEY_MAX_SIZE = 32 bytes)
  * @throws ERR_STSM_OTHER_PUBKEY_MISSING        The remote actor's public ephemeral DH key is missing
  * @throws ERR_OSSL_EVP_PKEY_CTX_NEW            EVP_PKEY context creation failed
  * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT        Key derivation context initialization failed
@@ -184,13 +331,15 @@ void STSMMgr::delMyDHEPrivKey()
  * @throws ERR_OSSL_BIO_NEW_FAILED              Memory BIO Initialization Failed
  * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the public key into the memory BIO
  * @throws ERR_OSSL_EVP_PKEY_NEW                EVP_PKEY struct creation failed
+ * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to extract the raw X25519 public key
+ * @throws ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY     Failed to rebuild the raw X25519 public key
  * @throws ERR_OSSL_EVP_MD_CTX_NEW              EVP_MD context creation failed
  * @throws ERR_OSSL_EVP_DIGEST_INIT             EVP_MD digest initialization failed
  * @throws ERR_OSSL_EVP_DIGEST_UPDATE           EVP_MD digest update failed
  * @throws ERR_OSSL_EVP_DIGEST_FINAL            EVP_MD digest final failed
  * @throws ERR_MALLOC_FAILED                    malloc() failed
  */
-void STSMMgr::deriveAES128SKey(unsigned char* skey)
+void STSMMgr::deriveSessKey(unsigned char* skey, const unsigned char* psk)
  {
   // Shared secret buffer and size
   unsigned char* sSecret;
@@ -283,6 +432,12 @@ void STSMMgr::deriveAES128SKey(unsigned char* skey)
   if(EVP_DigestInit(sSecretHashCTX, EVP_sha256()) <= 0)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_INIT, OSSL_ERR_DESC);
 
+  // In an abbreviated STSM execution, prepend the resumption PSK to the shared secret, so
+  // that the session key depends both on the client's past authentication and on
+  // the fresh ephemeral keys (which provide the session's forward secrecy)
+  if(psk != nullptr && EVP_DigestUpdate(sSecretHashCTX, psk, STSM_RES_PSK_SIZE) <= 0)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_UPDATE, OSSL_ERR_DESC);
+
   // Pass the derived shared secret to the EVP_DigestUpdate()
   if(EVP_DigestUpdate(sSecretHashCTX, (unsigned char*)sSecret, sSecretSize) <= 0)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_UPDATE, OSSL_ERR_DESC);
@@ -302,35 +457,99 @@ void STSMMgr::deriveAES128SKey(unsigned char* skey)
   printf("\n");
   */
 
-  /* ------------------- AES_128 Session Key Derivation ------------------- */
+  /* ----------------------- Session Key Derivation ----------------------- */
 
-  // Set the shared session key as the first AES_128_KEY_SIZE
-  // = 16 bytes of the shared secret's digest
-  memcpy(skey, sSecretDigest, AES_128_KEY_SIZE);
+  // Set the shared session key as the AEAD_KEY_MAX_SIZE
+  // = 32 bytes of the shared secret's SHA-256 digest
+  memcpy(skey, sSecretDigest, AEAD_KEY_MAX_SIZE);
 
   // Free the shared secret and its digest's buffers
   free(sSecret);
   free(sSecretDigest);
 
   /*
-  // LOG: AES_128 session key in hexadecimal
-  printf("AES_128 session key in hexadecimal: ");
-  for(int i=0; i < AES_128_KEY_SIZE ; i++)
+  // LOG: Session key in hexadecimal
+  printf("Session key in hexadecimal: ");
+  for(int i=0; i < AEAD_KEY_MAX_SIZE ; i++)
    printf("%02x", (unsigned char) skey[i]);
   printf("\n");
   */
  }
 
 
+/* ---------------------------- Session Resumption ---------------------------- */
+
+/**
+ * @brief  Derives via HKDF-SHA256 a 32 bytes key from a 32 bytes key and a label (used
+ *         for deriving the resumption PSK and the binder and finished keys)
+ * @param  key   The key to derive from (32 bytes)
+ * @param  label The label identifying the derived key's purpose
+ * @param  out   The buffer where to write the derived key (32 bytes)
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+ */
+void STSMMgr::deriveLabeledKey(const unsigned char* key, const char* label, unsigned char* out)
+ {
+  // The size of the derived key
+  size_t outSize = STSM_RES_PSK_SIZE;
+
+  // Create the HKDF key derivation context
+  EVP_PKEY_CTX* hkdfCTX = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, NULL);
+  if(!hkdfCTX)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_CTX_NEW, OSSL_ERR_DESC);
+
+  // Initialize the key derivation with SHA-256, the key as input
+  // keying material (with no salt) and the label as info
+  if(EVP_PKEY_derive_init(hkdfCTX) <= 0 || EVP_PKEY_CTX_set_hkdf_md(hkdfCTX, EVP_sha256()) <= 0 ||
+     EVP_PKEY_CTX_set1_hkdf_key(hkdfCTX, key, STSM_RES_PSK_SIZE) <= 0 ||
+     EVP_PKEY_CTX_add1_hkdf_info(hkdfCTX, reinterpret_cast<const unsigned char*>(label), (int)strlen(label)) <= 0)
+   {
+    EVP_PKEY_CTX_free(hkdfCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_DERIVE_INIT, OSSL_ERR_DESC);
+   }
+
+  // Derive the key
+  if(EVP_PKEY_derive(hkdfCTX, out, &outSize) <= 0)
+   {
+    EVP_PKEY_CTX_free(hkdfCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_DERIVE, OSSL_ERR_DESC);
+   }
+  EVP_PKEY_CTX_free(hkdfCTX);
+ }
+
+
+/**
+ * @brief  Computes the HMAC-SHA256 of a buffer (used for computing
+ *         the resumption binder and finished values)
+ * @param  key      The HMAC key (32 bytes)
+ * @param  data     The buffer to be authenticated
+ * @param  dataSize The size of the buffer to be authenticated
+ * @param  mac      The buffer where to write the resulting HMAC (STSM_RES_MAC_SIZE bytes)
+ * @throws ERR_OSSL_HMAC_FAILED HMAC computation failed
+ */
+void STSMMgr::computeResMAC(const unsigned char* key, const unsigned char* data,
+                            size_t dataSize, unsigned char* mac)
+ {
+  // The size of the resulting HMAC
+  unsigned int macSize = STSM_RES_MAC_SIZE;
+
+  if(HMAC(EVP_sha256(), key, STSM_RES_PSK_SIZE, data, dataSize, mac, &macSize) == NULL)
+   THROW_EXEC_EXCP(ERR_OSSL_HMAC_FAILED, OSSL_ERR_DESC);
+ }
+
+
 /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
 /**
- * @brief                   STSMMgr object constructor
- * @param myRSALongPrivKey  The actor's long-term RSA private key
- * @note The constructor initializes the actor's ephemeral DH 2048 key pair
+ * @brief               STSMMgr object constructor
+ * @param myLongPrivKey The actor's long-term private key (RSA-2048 or Ed25519)
+ * @note  The actor's ephemeral key pair is generated once the STSM suite
+ *        used in the key exchange is known (see the EDHKeygen() method)
  */
-STSMMgr::STSMMgr(EVP_PKEY* myRSALongPrivKey)
- : _myRSALongPrivKey(myRSALongPrivKey), _myDHEKey(DHE_2048_Keygen()), _otherDHEPubKey(nullptr)
+STSMMgr::STSMMgr(EVP_PKEY* myLongPrivKey)
+ : _myLongPrivKey(myLongPrivKey), _stsmSuite(STSM_SUITE_DH2048), _myDHEKey(nullptr), _otherDHEPubKey(nullptr),
+   _resPSK()
  {}
 
 
@@ -343,6 +562,9 @@ STSMMgr::~STSMMgr()
   EVP_PKEY_free(_myDHEKey);
   EVP_PKEY_free(_otherDHEPubKey);
 
+  // Safely delete the resumption PSK
+  OPENSSL_cleanse(&_resPSK[0], STSM_RES_PSK_SIZE);
+
   /*
    * NOTE: The actor's long-term RSA private key must NOT be
    *       deleted, as it may be reused across multiple connections
@@ -388,6 +610,8 @@ void STSMMgr::logOtherEDHPubKey()
  *                                              ephemeral DH public key into the BIO
  * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read the local actor's
  *                                              ephemeral DH public key from the BIO
+ * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write the local actor's
+ *                                              ephemeral X25519 public key
  */
 void STSMMgr::writeMyEDHPubKey(unsigned char* addr)
  {
@@ -407,6 +631,8 @@ void STSMMgr::writeMyEDHPubKey(unsigned char* addr)
  *                                              ephemeral DH public key into the BIO
  * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read the remote actor's
  *                                              ephemeral DH public key from the BIO
+ * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write the remote actor's
+ *                                              ephemeral X25519 public key
  */
 void STSMMgr::writeOtherEDHPubKey(unsigned char* addr)
  {
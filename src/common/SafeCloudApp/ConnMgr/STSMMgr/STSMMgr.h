@@ -15,9 +15,11 @@ class STSMMgr
    /* ================================= ATTRIBUTES ================================= */
 
    // STSM shared cryptographic quantities
-   EVP_PKEY*          _myRSALongPrivKey;  // The actor's long-term RSA private key
+   EVP_PKEY*          _myLongPrivKey;     // The actor's long-term private key (RSA-2048 or Ed25519)
+   STSMSuite          _stsmSuite;         // The STSM suite used in the key exchange
    EVP_PKEY*          _myDHEKey;          // The actor's ephemeral DH key pair
    EVP_PKEY*          _otherDHEPubKey;    // The other actor's ephemeral DH public key
+   unsigned char      _resPSK[STSM_RES_PSK_SIZE];  // The resumption PSK derived from the session key
 
    /* ============================== PROTECTED METHODS ============================== */
 
@@ -35,6 +37,26 @@ class STSMMgr
     */
    static EVP_PKEY* DHE_2048_Keygen();
 
+   /**
+    * @brief  Generates an ephemeral X25519 key pair for the local actor
+    * @return The EVP_PKEY structure holding the local actor's ephemeral X25519 key pair
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT EVP_PKEY key generation initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_KEYGEN      EVP_PKEY Key generation failed
+    */
+   static EVP_PKEY* X25519_Keygen();
+
+   /**
+    * @brief  Generates the local actor's ephemeral key pair of
+    *         the type of the STSM suite used in the key exchange
+    * @throws ERR_OSSL_EVP_PKEY_NEW         EVP_PKEY struct creation failed
+    * @throws ERR_OSSL_EVP_PKEY_ASSIGN      EVP_PKEY struct assignment failure
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT EVP_PKEY key generation initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_KEYGEN      EVP_PKEY Key generation failed
+    */
+   void EDHKeygen();
+
    /* ---------------------- Ephemeral Public Keys Utilities ---------------------- */
 
    /**
@@ -44,14 +66,30 @@ class STSMMgr
    static void logEDHPubKey(EVP_PKEY* EDHPubKey);
 
    /**
-    * @brief  Writes an actor's ephemeral DH public key at the specified memory address
+    * @brief  Writes an actor's ephemeral public key at the specified memory address, in
+    *         PEM format for DH 2048-bit keys or in raw format for X25519 keys
     * @param  EDHPubKey the actor's ephemeral DH public key to be printed
     * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
     * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the actor's ephemeral DH public key into the BIO
     * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read the actor's ephemeral DH public key from the BIO
+    * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write the actor's ephemeral X25519 public key
     */
    static void writeEDHPubKey(EVP_PKEY* EDHPubKey,unsigned char* addr);
 
+   /**
+    * @brief  Returns the size in bytes of an encoded ephemeral public key in the STSM suite used
+    * @return The size in bytes of an encoded ephemeral public key in the STSM suite used
+    */
+   unsigned int EDHPubKeySize();
+
+   /**
+    * @brief  Reads the remote actor's ephemeral public key of the STSM suite used from
+    *         the specified memory address, leaving it to NULL if it is not valid
+    * @param  addr The address of the remote actor's encoded ephemeral public key
+    * @throws ERR_OSSL_BIO_NEW_FAILED OpenSSL BIO initialization failed
+    */
+   void readOtherEDHPubKey(unsigned char* addr);
+
 
    /* --------------------------- Session Key Derivation --------------------------- */
 
@@ -62,15 +100,20 @@ class STSMMgr
     * @throws ERR_OSSL_BIO_NEW_FAILED              Memory BIO Initialization Failed
     * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the public key into the memory BIO
     * @throws ERR_OSSL_EVP_PKEY_NEW                EVP_PKEY struct creation failed
+    * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to extract the raw X25519 public key
+    * @throws ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY     Failed to rebuild the raw X25519 public key
     */
    void delMyDHEPrivKey();
 
    /**
-    * @brief  Derives the shared AES_128 session key from the local actor's
-    *         private and the remote actor's public ephemeral DH keys
-    * @param  skey The buffer where to write the resulting AES_128 session key
+    * @brief  Derives the shared session key from the local actor's private and the remote
+    *         actor's public ephemeral DH keys, of which the AES_128 ciphers (AES_128_CBC in the STSM
+    *         handshake, AES_128_GCM in the session phase) use the first AES_128_KEY_SIZE = 16 bytes
+    * @param  skey The buffer where to write the resulting session key
+    * @param  psk  The resumption PSK the session key must also be derived from in an
+    *              abbreviated STSM execution (nullptr in a full STSM execution)
     * @note   This function assumes the "skey" destination buffer to be large enough to
-    *         contain the resulting AES_128 session key (at least AES_128_KEY_SIZE = 16 bytes)
+    *         contain the resulting session key (at least AEAD_KEY_MAX_SIZE = 32 bytes)
     * @throws ERR_STSM_OTHER_PUBKEY_MISSING        The remote actor's public ephemeral DH key is missing
     * @throws ERR_OSSL_EVP_PKEY_CTX_NEW            EVP_PKEY context creation failed
     * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT        Key derivation context initialization failed
@@ -80,24 +123,53 @@ class STSMMgr
     * @throws ERR_OSSL_BIO_NEW_FAILED              Memory BIO Initialization Failed
     * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write the public key into the memory BIO
     * @throws ERR_OSSL_EVP_PKEY_NEW                EVP_PKEY struct creation failed
+    * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to extract the raw X25519 public key
+    * @throws ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY     Failed to rebuild the raw X25519 public key
     * @throws ERR_OSSL_EVP_MD_CTX_NEW              EVP_MD context creation failed
     * @throws ERR_OSSL_EVP_DIGEST_INIT             EVP_MD digest initialization failed
     * @throws ERR_OSSL_EVP_DIGEST_UPDATE           EVP_MD digest update failed
     * @throws ERR_OSSL_EVP_DIGEST_FINAL            EVP_MD digest final failed
     * @throws ERR_MALLOC_FAILED                    malloc() failed
     */
-   void deriveAES128SKey(unsigned char* skey);
+   void deriveSessKey(unsigned char* skey, const unsigned char* psk);
+
+   /* ---------------------------- Session Resumption ---------------------------- */
+
+   /**
+    * @brief  Derives via HKDF-SHA256 a 32 bytes key from a 32 bytes key and a label (used
+    *         for deriving the resumption PSK and the binder and finished keys)
+    * @param  key   The key to derive from (32 bytes)
+    * @param  label The label identifying the derived key's purpose
+    * @param  out   The buffer where to write the derived key (32 bytes)
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+    */
+   static void deriveLabeledKey(const unsigned char* key, const char* label, unsigned char* out);
+
+   /**
+    * @brief  Computes the HMAC-SHA256 of a buffer (used for computing
+    *         the resumption binder and finished values)
+    * @param  key      The HMAC key (32 bytes)
+    * @param  data     The buffer to be authenticated
+    * @param  dataSize The size of the buffer to be authenticated
+    * @param  mac      The buffer where to write the resulting HMAC (STSM_RES_MAC_SIZE bytes)
+    * @throws ERR_OSSL_HMAC_FAILED HMAC computation failed
+    */
+   static void computeResMAC(const unsigned char* key, const unsigned char* data,
+                             size_t dataSize, unsigned char* mac);
 
   public:
 
    /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
    /**
-    * @brief                  STSMMgr object constructor
-    * @param myRSALongPrivKey The actor's long-term RSA private key
-    * @note  The constructor initializes the actor's ephemeral DH 2048 key pair
+    * @brief               STSMMgr object constructor
+    * @param myLongPrivKey The actor's long-term private key (RSA-2048 or Ed25519)
+    * @note  The actor's ephemeral key pair is generated once the STSM suite
+    *        used in the key exchange is known (see the EDHKeygen() method)
     */
-   explicit STSMMgr(EVP_PKEY* myRSALongPrivKey);
+   explicit STSMMgr(EVP_PKEY* myLongPrivKey);
 
    /**
     * @brief STSMMgr object destructor, which safely deletes its sensitive attributes
@@ -126,6 +198,8 @@ class STSMMgr
     *                                              ephemeral DH public key into the BIO
     * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read the local actor's
     *                                              ephemeral DH public key from the BIO
+    * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write the local actor's
+    *                                              ephemeral X25519 public key
     */
    void writeMyEDHPubKey(unsigned char* addr);
 
@@ -137,6 +211,8 @@ class STSMMgr
     *                                              ephemeral DH public key into the BIO
     * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read the remote actor's
     *                                              ephemeral DH public key from the BIO
+    * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write the remote actor's
+    *                                              ephemeral X25519 public key
     */
    void writeOtherEDHPubKey(unsigned char* addr);
  };
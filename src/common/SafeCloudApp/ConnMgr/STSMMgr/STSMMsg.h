@@ -6,6 +6,7 @@
 /* ================================== INCLUDES ================================== */
 #include "defaults.h"
 #include "SafeCloudApp/ConnMgr/IV/IV.h"
+#include "ossl_crypto/AEAD.h"
 
 /* ======================= STSM MESSAGE TYPES DEFINITIONS ======================= */
 enum STSMMsgType : uint8_t
@@ -19,6 +20,16 @@ enum STSMMsgType : uint8_t
   CLI_AUTH,      // 3/4) Client -> Server
   SRV_OK,        // 4/4) Server -> Client
 
+  /*
+   * STSM resumption messages exchanged between client and server within an
+   * abbreviated STSM execution, where the client resumes its authentication
+   * by presenting a resumption ticket previously issued by the server
+   */
+  CLI_RESUME_HELLO,     // 1/2) Client -> Server
+  SRV_RESUME_OK,        // 2/2) Server -> Client (ticket accepted)
+  SRV_RESUME_REJECTED,  // 2/2) Server -> Client (ticket rejected, the client
+                        //      must continue with a 'CLIENT_HELLO' message)
+
   /*
    * STSM Error messages, sent by one party to the other upon
    * erroneous conditions in the STSM handshake (causing both
@@ -61,19 +72,106 @@ enum STSMMsgType : uint8_t
  };
 
 
+/* ========================== STSM SUITES DEFINITIONS ========================== */
+
+/*
+ * The STSM suites, defining the ephemeral key exchange used in the STSM handshake
+ * and the encoding of the actors' ephemeral public keys, of which the client
+ * chooses one in its 'CLIENT_HELLO' message that the server must support
+ *
+ * NOTE: The actors' digital signature algorithms are independent from the STSM
+ *       suite, depending instead on the type of their long-term keys (RSA-2048
+ *       or Ed25519, see the digSigKeySupported() function in "DigSig.h")
+ */
+enum STSMSuite : uint8_t
+ {
+  STSM_SUITE_DH2048,  // Ephemeral DH 2048-bit keys in PEM format (legacy)
+  STSM_SUITE_X25519   // Ephemeral X25519 keys in raw format
+ };
+
+// The STSM suite chosen by this SafeCloud version's client
+#define STSM_CLI_SUITE STSM_SUITE_X25519
+
 /* ========================= STSM MESSAGES DEFINITIONS ========================= */
 
 // The size in bytes of a PEM-encoded DH public key on 2048-bit
 #define DH2048_PUBKEY_PEM_SIZE 1194
 
+// The size in bytes of a raw X25519 public key
+#define X25519_PUBKEY_SIZE 32
+
 // The size in bytes of an RSA-2048 digital signature
 #define RSA2048_SIG_SIZE 256
 
-// The size in bytes of an STSM authentication proof, which is constant
-// due to the size of an RSA-2048 digital signature (256 bytes) being
-// a multiple of the AES block size, leading in turn to a full padding
-// block of 128 bits = 16 bytes being always added in its encryption
-#define STSM_AUTH_PROOF_SIZE 272
+// The size in bytes of an Ed25519 digital signature
+#define ED25519_SIG_SIZE 64
+
+// The maximum size in bytes of an STSM authentication proof, consisting in an
+// encrypted RSA-2048 digital signature, whose size (256 bytes) being a multiple
+// of the AES block size leads to a full padding block of 128 bits = 16 bytes
+// always being added in its encryption (an Ed25519 one being of 64 + 16 = 80 bytes)
+#define STSM_AUTH_PROOF_MAX_SIZE 272
+
+// The optional features a peer may support in the secure communication, which are
+// offered by the client in its 'CLIENT_HELLO' message and of which the server returns
+// the ones it also supports in its 'SRV_AUTH' and 'SRV_OK' messages (bit flags)
+#define STSM_FEATURE_COMPRESSION       0x01  // Compressed file transfers
+#define STSM_FEATURE_LARGE_FILES       0x02  // 64-bit file and storage pool sizes (files larger than 4GB)
+#define STSM_FEATURE_RESUMABLE_UPLOADS 0x04  // Interrupted uploads resumed from their verified contents
+#define STSM_FEATURE_RANGED_DOWNLOADS  0x08  // Downloads of a byte range of a file (resumable downloads)
+#define STSM_FEATURE_DEDUP_UPLOADS     0x10  // Uploads skipping the contents the server already holds
+#define STSM_FEATURE_DELTA_UPLOADS     0x20  // Uploads sending only the changes to the server's copy of the file
+
+// The optional features supported by this SafeCloud version
+#define STSM_SUPPORTED_FEATURES (STSM_FEATURE_COMPRESSION | STSM_FEATURE_LARGE_FILES | \
+                                 STSM_FEATURE_RESUMABLE_UPLOADS | STSM_FEATURE_RANGED_DOWNLOADS | \
+                                 STSM_FEATURE_DEDUP_UPLOADS | STSM_FEATURE_DELTA_UPLOADS)
+
+/* ------------------------- STSM Resumption Tickets ------------------------- */
+
+// The size in bytes of a resumption pre-shared key (PSK)
+#define STSM_RES_PSK_SIZE 32
+
+// The sizes in bytes of the nonce and integrity tag of a
+// resumption ticket's contents encryption (AES_256_GCM)
+#define STSM_TICKET_NONCE_SIZE 12
+#define STSM_TICKET_TAG_SIZE   16
+
+// The size in bytes of the resumption binder and finished values (HMAC-SHA256)
+#define STSM_RES_MAC_SIZE 32
+
+// The HKDF labels used in deriving the resumption PSK from a session key,
+// the client's binder key from a resumption PSK and the server's finished
+// key from the session key established in an abbreviated STSM execution
+#define STSM_RES_PSK_LABEL      "SafeCloud resumption psk"
+#define STSM_RES_BINDER_LABEL   "SafeCloud resumption binder"
+#define STSM_RES_FINISHED_LABEL "SafeCloud resumption finished"
+
+// The contents of a resumption ticket, which are known to the server only
+struct STSMTicketContents
+ {
+  // The time in Unix epochs at which the client last authenticated within
+  // a full STSM execution, from which the ticket's lifetime is computed
+  uint64_t authTime;
+
+  // The name of the client the ticket was issued to
+  unsigned char cliName[CLI_NAME_MAX_LENGTH + 1];
+
+  // The resumption PSK shared by the client and the server
+  unsigned char psk[STSM_RES_PSK_SIZE];
+ };
+
+// A resumption ticket, consisting of its contents encrypted and authenticated with
+// one of the server's ticket keys and which is so opaque to the client (see "TicketKeys.h")
+struct STSMTicket
+ {
+  uint32_t      keyId;                                   // The identifier of the ticket key used
+  unsigned char nonce[STSM_TICKET_NONCE_SIZE];           // The contents' encryption nonce
+  unsigned char encContents[sizeof(STSMTicketContents)]; // The encrypted ticket contents
+  unsigned char tag[STSM_TICKET_TAG_SIZE];               // The contents' integrity tag
+ };
+
+/* ------------------------------- STSM Header ------------------------------- */
 
 // STSM Message header
 struct STSMMsgHeader
@@ -99,11 +197,22 @@ struct STSM_CLIENT_HELLO_MSG : public STSMMsg
  {
   public:
 
-  // The client's ephemeral DH 2048-bit public key in PEM format
-   unsigned char cliEDHPubKey[DH2048_PUBKEY_PEM_SIZE];
-
    // The initial random IV to be used in the secure communication
    IV iv;
+
+   // The optional features supported by the client (STSM_FEATURE_ flags)
+   uint8_t cliFeatures;
+
+   // The AEAD ciphers supported by the client in decreasing order of
+   // preference ('AEADCipher' values, with unused slots set to AEAD_NONE)
+   uint8_t cliCiphers[AEAD_NUM_CIPHERS];
+
+   // The STSM suite chosen by the client ('STSMSuite' value)
+   uint8_t cliSuite;
+
+   // The client's ephemeral public key, whose encoding
+   // and size depend on the chosen STSM suite
+   unsigned char cliEDHPubKey[];
  };
 
 /* ------------------------- 'SRV_AUTH' Message (2/4) ------------------------- */
@@ -111,14 +220,30 @@ struct STSM_CLIENT_HELLO_MSG : public STSMMsg
 // Implicit header.type ='SRV_AUTH'
 struct STSM_SRV_AUTH_MSG : public STSMMsg
  {
-  // The server's ephemeral DH 2048-bit public key in PEM format
-  unsigned char srvEDHPubKey[DH2048_PUBKEY_PEM_SIZE];
+  // The optional features offered by the client that are also supported by the
+  // server, and that are so enabled in the secure communication (STSM_FEATURE_ flags)
+  uint8_t srvFeatures;
+
+  // The AEAD cipher selected by the server from both peers' preferences
+  // for protecting the session phase of the connection ('AEADCipher' value)
+  //
+  // NOTE: Announcing the connection's parameters already in the 'SRV_AUTH' message
+  //       allows the client to send its first session request along with its
+  //       'CLI_AUTH' message, without awaiting the server's 'SRV_OK' message
+  uint8_t srvCipher;
+
+  // The size of the server's STSM authentication proof, depending
+  // on the type of its long-term key (up to STSM_AUTH_PROOF_MAX_SIZE)
+  uint16_t srvSTSMAuthProofSize;
 
-  // The server's STSM authentication proof
-  unsigned char srvSTSMAuthProof[STSM_AUTH_PROOF_SIZE];
-
-  // The server's X.509 certificate (of variable size in general)
-  unsigned char srvCert[];
+  /*
+   * The concatenation of:
+   *   1) The server's ephemeral public key, whose encoding
+   *      and size depend on the client-chosen STSM suite
+   *   2) The server's STSM authentication proof (of "srvSTSMAuthProofSize" bytes)
+   *   3) The server's X.509 certificate (of variable size in general)
+   */
+  unsigned char srvAuthData[];
  };
 
 /* ------------------------- 'CLI_AUTH' Message (3/4) ------------------------- */
@@ -129,15 +254,92 @@ struct STSM_CLI_AUTH_MSG : public STSMMsg
   // The client's name
   unsigned char cliName[CLI_NAME_MAX_LENGTH + 1];
 
-  // The client's STSM authentication proof
-  unsigned char cliSTSMAuthProof[STSM_AUTH_PROOF_SIZE];
+  // The client's STSM authentication proof, whose size depends on the
+  // type of its long-term key (up to STSM_AUTH_PROOF_MAX_SIZE)
+  unsigned char cliSTSMAuthProof[];
  };
 
 /* -------------------------- 'SRV_OK' Message (4/4) -------------------------- */
 
 // Implicit header.type ='SRV_OK'
 struct STSM_SRV_OK_MSG : public STSMMsg
- {};
+ {
+  // The optional features enabled in the secure communication, which
+  // must match the ones announced in the 'SRV_AUTH' message (STSM_FEATURE_ flags)
+  uint8_t srvFeatures;
+
+  // The AEAD cipher selected for the session phase of the connection, which must
+  // match the one announced in the 'SRV_AUTH' message ('AEADCipher' value)
+  uint8_t srvCipher;
+
+  // The remaining lifetime in seconds of the resumption ticket
+  // issued to the client (0 if resumption tickets are disabled)
+  uint32_t ticketLifetime;
+
+  // The resumption ticket issued to the client
+  STSMTicket ticket;
+ };
+
+/* --------------------- 'CLI_RESUME_HELLO' Message (1/2) --------------------- */
+
+// Implicit header.type ='CLI_RESUME_HELLO'
+struct STSM_CLI_RESUME_HELLO_MSG : public STSMMsg
+ {
+  public:
+
+   // The initial random IV to be used in the secure communication
+   IV iv;
+
+   // The optional features supported by the client (STSM_FEATURE_ flags)
+   uint8_t cliFeatures;
+
+   // The AEAD ciphers supported by the client in decreasing order of
+   // preference ('AEADCipher' values, with unused slots set to AEAD_NONE)
+   uint8_t cliCiphers[AEAD_NUM_CIPHERS];
+
+   // The STSM suite chosen by the client ('STSMSuite' value)
+   uint8_t cliSuite;
+
+   // The resumption ticket previously issued to the client
+   STSMTicket ticket;
+
+   // The client's binder, proving its knowledge of the ticket's resumption PSK, consisting
+   // of the HMAC of the message (binder excluded) with the PSK's binder key
+   unsigned char cliBinder[STSM_RES_MAC_SIZE];
+
+   // The client's ephemeral public key, whose encoding
+   // and size depend on the chosen STSM suite
+   unsigned char cliEDHPubKey[];
+ };
+
+/* ----------------------- 'SRV_RESUME_OK' Message (2/2) ----------------------- */
+
+// Implicit header.type ='SRV_RESUME_OK'
+struct STSM_SRV_RESUME_OK_MSG : public STSMMsg
+ {
+  public:
+
+   // The optional features enabled in the secure communication (STSM_FEATURE_ flags)
+   uint8_t srvFeatures;
+
+   // The AEAD cipher selected for the session phase of the connection ('AEADCipher' value)
+   uint8_t srvCipher;
+
+   // The remaining lifetime in seconds of the new resumption ticket issued to the client
+   uint32_t ticketLifetime;
+
+   // The new resumption ticket issued to the client
+   STSMTicket ticket;
+
+   // The server's finished value, proving its knowledge of the ticket's resumption PSK and its
+   // agreement on the resulting session key, consisting of the HMAC of the client's binder and
+   // of the message (finished value excluded) with the session key's finished key
+   unsigned char srvFinished[STSM_RES_MAC_SIZE];
+
+   // The server's ephemeral public key, whose encoding
+   // and size depend on the client-chosen STSM suite
+   unsigned char srvEDHPubKey[];
+ };
 
 
 #endif //SAFECLOUD_STSMMSG_H
\ No newline at end of file
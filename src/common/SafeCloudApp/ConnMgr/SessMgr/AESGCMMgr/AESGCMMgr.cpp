@@ -8,37 +8,76 @@
 /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
 /**
- * @brief  AES_128_GCM object constructor, setting the session's cryptographic
- *         quantities and initializing the first cipher encryption or decryption context
- * @param  skey The AES_128_GCM symmetric key to be used in the secure communication (16 bytes)
- * @param  iv   The already-initialized IV to be used in the secure communication
- * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW EVP_CIPHER context creation failed
+ * @brief  AES_128_GCM object constructor, setting the session's cryptographic quantities and
+ *         creating the cipher encryption and decryption contexts, which are initialized with
+ *         the cipher and session key once for all the manager's operations
+ * @param  skey   The session key to be used in the secure communication (32 bytes)
+ * @param  iv     The already-initialized IV to be used in the secure communication
+ * @param  cipher The AEAD cipher to be used in the secure communication
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW  EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_AEAD_UNKNOWN_CIPHER Unknown AEAD cipher
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_OSSL_EVP_DECRYPT_INIT    EVP_CIPHER decrypt initialization failed
  */
-AESGCMMgr::AESGCMMgr(unsigned char* skey, IV* iv)
- : _aesGcmMgrState(READY), _aesGcmCTX(EVP_CIPHER_CTX_new()),
-   _skey(skey), _iv(iv), _sizeTot(0), _sizePart(0)
+AESGCMMgr::AESGCMMgr(const unsigned char* skey, IV* iv, AEADCipher cipher)
+ : _aesGcmMgrState(READY), _aesGcmEncCTX(EVP_CIPHER_CTX_new()), _aesGcmDecCTX(EVP_CIPHER_CTX_new()),
+   _cipher(AEAD_GetEVPCipher(cipher)), _iv(iv), _sizeTot(0), _sizePart(0)
  {
-  // Assert the cipher context to have been created
-  if(!_aesGcmCTX)
-   THROW_EXEC_EXCP(ERR_OSSL_EVP_CIPHER_CTX_NEW, OSSL_ERR_DESC);
+  // Assert both cipher contexts to have been created
+  if(!_aesGcmEncCTX || !_aesGcmDecCTX)
+   {
+    freeCTXs();
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_CIPHER_CTX_NEW, OSSL_ERR_DESC);
+   }
+
+  /*
+   * Initialize the cipher encryption and decryption contexts specifying the cipher and
+   * the session key only, so that its key schedule (AES round keys and GHASH tables, or
+   * ChaCha20 state) is computed once and retained across the manager's operations, each
+   * of which only sets a new IV (see the encryptInit() and decryptInit() methods)
+   */
+  if(EVP_EncryptInit_ex(_aesGcmEncCTX, _cipher, NULL, skey, NULL) != 1)
+   {
+    freeCTXs();
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_ENCRYPT_INIT, OSSL_ERR_DESC);
+   }
+  if(EVP_DecryptInit_ex(_aesGcmDecCTX, _cipher, NULL, skey, NULL) != 1)
+   {
+    freeCTXs();
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_DECRYPT_INIT, OSSL_ERR_DESC);
+   }
  }
 
 
 /**
- * @brief AES_128_GCM object destructor, freeing its prepared cipher context
+ * @brief AES_128_GCM object destructor, freeing its cipher contexts
  * @note  It is assumed the secure erasure of the connection's cryptographic quantities
  *        (session key, IV) to be performed by the associated connection manager object
  */
 AESGCMMgr::~AESGCMMgr()
- { EVP_CIPHER_CTX_free(_aesGcmCTX); }
+ { freeCTXs(); }
+
+
+/* ============================== PRIVATE METHODS ============================== */
+
+/**
+ * @brief Frees the manager's cipher encryption and decryption contexts, which
+ *        also securely erases the session key schedule they retain
+ */
+void AESGCMMgr::freeCTXs()
+ {
+  EVP_CIPHER_CTX_free(_aesGcmEncCTX);
+  EVP_CIPHER_CTX_free(_aesGcmDecCTX);
+ }
 
 
 /* ============================= OTHER PUBLIC METHODS ============================= */
 
 /**
- * @brief  Resets the AES_128_GCM manager state so to be
- *         ready for a new encryption or decryption operation
- * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW EVP_CIPHER context creation failed
+ * @brief Resets the AES_128_GCM manager state so to be
+ *        ready for a new encryption or decryption operation
+ * @note  The cipher contexts are not freed nor re-created, as any completed or aborted
+ *        operation state they hold is discarded by setting the next operation's IV
  */
 void AESGCMMgr::resetState()
  {
@@ -46,28 +85,40 @@ void AESGCMMgr::resetState()
   _sizeTot = 0;
   _sizePart = 0;
 
-  // If an encryption or decryption operation
-  // has been completed or is in progress
+  // If an encryption or decryption operation has been
+  // completed or is in progress, increment the IV value
   if(_aesGcmMgrState != READY)
-   {
-    // Free the current cipher context
-    EVP_CIPHER_CTX_free(_aesGcmCTX);
-
-    // Initialize a new cipher context for the
-    // next encryption or decryption operation
-    _aesGcmCTX = EVP_CIPHER_CTX_new();
-    if(!_aesGcmCTX)
-     THROW_EXEC_EXCP(ERR_OSSL_EVP_CIPHER_CTX_NEW, OSSL_ERR_DESC);
-
-    // Increment the IV value
-    _iv->incIV();
-   }
+   _iv->incIV();
 
   // Set the manager state to 'READY'
   _aesGcmMgrState = READY;
  }
 
 
+/**
+ * @brief  Replaces the key of the manager's cipher encryption and decryption contexts,
+ *         which is used by all of its following operations (see the SessKey class)
+ * @param  skey The new key to be used in the secure communication (32 bytes)
+ * @throws ERR_AESGCMMGR_INVALID_STATE Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT   EVP_CIPHER encrypt initialization failed
+ * @throws ERR_OSSL_EVP_DECRYPT_INIT   EVP_CIPHER decrypt initialization failed
+ */
+void AESGCMMgr::rekey(const unsigned char* skey)
+ {
+  // Assert no encryption or decryption operation to be in progress
+  if(_aesGcmMgrState != READY)
+   THROW_EXEC_EXCP(ERR_AESGCMMGR_INVALID_STATE, "state " + std::to_string(_aesGcmMgrState)
+                                                         + " in rekey()");
+
+  // Set the new key in the cipher encryption and decryption
+  // contexts, which recomputes their key schedule
+  if(EVP_EncryptInit_ex(_aesGcmEncCTX, NULL, NULL, skey, NULL) != 1)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_ENCRYPT_INIT, OSSL_ERR_DESC);
+  if(EVP_DecryptInit_ex(_aesGcmDecCTX, NULL, NULL, skey, NULL) != 1)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_DECRYPT_INIT, OSSL_ERR_DESC);
+ }
+
+
 /* ---------------------------- Encryption Operation ---------------------------- */
 
 /**
@@ -82,18 +133,19 @@ void AESGCMMgr::encryptInit()
    THROW_EXEC_EXCP(ERR_AESGCMMGR_INVALID_STATE, "state " + std::to_string(_aesGcmMgrState)
                                                          + " in encryptInit()");
 
-  // Initialize the cipher encryption context specifying the cipher, key and IV
-  if(EVP_EncryptInit(_aesGcmCTX, EVP_aes_128_gcm(), _skey,
-                     reinterpret_cast<const unsigned char*>(&(_iv->iv_AES_GCM))) != 1)
+  // Set the IV in the already keyed cipher encryption context, starting a new encryption
+  if(EVP_EncryptInit_ex(_aesGcmEncCTX, NULL, NULL, NULL,
+                        reinterpret_cast<const unsigned char*>(&(_iv->iv_AES_GCM))) != 1)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_ENCRYPT_INIT, OSSL_ERR_DESC);
 
-  // Set the manager to expect up to one AAD block (if any) for encryption
+  // Set the manager to expect any number of AAD blocks (if any) for encryption
   _aesGcmMgrState = ENCRYPT_AAD;
  }
 
 
 /**
- * @brief Add the single, optional AAD block in the manager current encryption operation
+ * @brief Adds an AAD block in the manager current encryption operation, where multiple AAD blocks
+ *        can be added before any plaintext block, so to authenticate data without encrypting it (GMAC)
  * @param aadAddr The AAD initial address
  * @param aadSize The AAD size
  * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
@@ -120,29 +172,35 @@ void AESGCMMgr::encryptAddAAD(unsigned char* aadAddr, int aadSize)
   printf("aadBlockHex = %s\n",aadBlockHex);
   */
 
-  // Set the encryption AAD block
-  if(EVP_EncryptUpdate(_aesGcmCTX, NULL, &_sizeTot, aadAddr, aadSize) != 1)
+  // Add the encryption AAD block, which leaves the manager expecting
+  // further AAD blocks, plaintext blocks or the operation's finalization
+  if(EVP_EncryptUpdate(_aesGcmEncCTX, NULL, &_sizePart, aadAddr, aadSize) != 1)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_ENCRYPT_UPDATE, OSSL_ERR_DESC);
 
-  // Set the manager to expect any number of plaintext blocks for encryption
-  _aesGcmMgrState = ENCRYPT_UPDATE;
+  // Update the encryption operation's cumulative size (AAD included)
+  _sizeTot += _sizePart;
  }
 
 
 /**
- * @brief Encrypts a plaintext block in the manager current
- *        encryption operation, safely deleting it afterwards
- * @param ptAddr The plaintext block initial address
- * @param ptSize The plaintext block size
- * @param ctDest The address where to write the resulting ciphertext block
- * @note         The function assumes the "ctDest" destination buffer to be large enough
- *               to contain the resulting ciphertext block (at least 'ptSize' bytes)
- * @return       The encryption operation's cumulative ciphertext size (AAD included)
+ * @brief Encrypts a plaintext block in the manager current encryption operation,
+ *        safely deleting it afterwards unless it is encrypted in place or preserved
+ * @param ptAddr    The plaintext block initial address
+ * @param ptSize    The plaintext block size
+ * @param ctDest    The address where to write the resulting ciphertext block
+ * @param cleansePT Whether the plaintext block must be safely deleted (false for plaintexts that must
+ *                  be preserved or cannot be written, e.g. the memory mapping of a file being sent)
+ * @note            The function assumes the "ctDest" destination buffer to be large enough
+ *                  to contain the resulting ciphertext block (at least 'ptSize' bytes)
+ * @return          The encryption operation's cumulative ciphertext size (AAD included)
  * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE The plaintext block size is non-positive (probable overflow)
  * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
  */
-int AESGCMMgr::encryptAddPT(unsigned char* ptAddr, int ptSize, unsigned char* ctDest)
+long int AESGCMMgr::encryptAddPT(unsigned char* ptAddr, int ptSize, unsigned char* ctDest)
+ { return encryptAddPT(ptAddr, ptSize, ctDest, true); }
+
+long int AESGCMMgr::encryptAddPT(unsigned char* ptAddr, int ptSize, unsigned char* ctDest, bool cleansePT)
  {
   // Assert the manager to be expecting either
   // the AAD or a plaintext block for encryption
@@ -158,7 +216,7 @@ int AESGCMMgr::encryptAddPT(unsigned char* ptAddr, int ptSize, unsigned char* ct
    THROW_EXEC_EXCP(ERR_NON_POSITIVE_BUFFER_SIZE, "ptSize = " + std::to_string(ptSize));
 
   // Encrypt the plaintext block to the ciphertext buffer
-  if(EVP_EncryptUpdate(_aesGcmCTX, ctDest, &_sizePart, ptAddr, ptSize) != 1)
+  if(EVP_EncryptUpdate(_aesGcmEncCTX, ctDest, &_sizePart, ptAddr, ptSize) != 1)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_ENCRYPT_UPDATE, OSSL_ERR_DESC);
 
   /*
@@ -187,8 +245,10 @@ int AESGCMMgr::encryptAddPT(unsigned char* ptAddr, int ptSize, unsigned char* ct
   // Update the encryption operation's cumulative ciphertext size
   _sizeTot += _sizePart;
 
-  // Safely delete the plaintext from its buffer
-  OPENSSL_cleanse(&ptAddr[0], ptSize);
+  // Safely delete the plaintext from its buffer, unless it was encrypted in
+  // place (and so overwritten by its ciphertext) or it must be preserved
+  if(cleansePT && ptAddr != ctDest)
+   OPENSSL_cleanse(&ptAddr[0], ptSize);
 
   // Return the encryption operation's cumulative ciphertext size (AAD included)
   return _sizeTot;
@@ -206,23 +266,23 @@ int AESGCMMgr::encryptAddPT(unsigned char* ptAddr, int ptSize, unsigned char* ct
  * @throws ERR_OSSL_EVP_ENCRYPT_FINAL  EVP_CIPHER encrypt final failed
  * @throws ERR_OSSL_GET_TAG_FAILED     Error in retrieving the resulting integrity tag
  */
-int AESGCMMgr::encryptFinal(unsigned char* tagDest)
+long int AESGCMMgr::encryptFinal(unsigned char* tagDest)
  {
-  // Assert the manager to be expecting a plaintext block for encryption
-  if(_aesGcmMgrState != ENCRYPT_UPDATE)
+  // Assert the manager to be expecting either an AAD or a plaintext block for encryption
+  if(_aesGcmMgrState != ENCRYPT_AAD && _aesGcmMgrState != ENCRYPT_UPDATE)
    THROW_EXEC_EXCP(ERR_AESGCMMGR_INVALID_STATE, "state " + std::to_string(_aesGcmMgrState)
                                                          + " in encryptFinal()");
 
   // Finalize the encryption operation
-  if(EVP_EncryptFinal(_aesGcmCTX, NULL, &_sizePart) != 1)
+  if(EVP_EncryptFinal(_aesGcmEncCTX, NULL, &_sizePart) != 1)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_ENCRYPT_FINAL, OSSL_ERR_DESC);
 
   // Encryption operation resulting ciphertext size (AAD included)
-  int ctSize = _sizeTot + _sizePart;
+  long int ctSize = _sizeTot + _sizePart;
 
   // Extract the encryption operation's integrity
   // tag and write it into the specified buffer
-  if(EVP_CIPHER_CTX_ctrl(_aesGcmCTX, EVP_CTRL_AEAD_GET_TAG, 16, tagDest) != 1)
+  if(EVP_CIPHER_CTX_ctrl(_aesGcmEncCTX, EVP_CTRL_AEAD_GET_TAG, 16, tagDest) != 1)
    THROW_EXEC_EXCP(ERR_OSSL_GET_TAG_FAILED, OSSL_ERR_DESC);
 
   /*
@@ -257,18 +317,19 @@ void AESGCMMgr::decryptInit()
    THROW_EXEC_EXCP(ERR_AESGCMMGR_INVALID_STATE, "state " + std::to_string(_aesGcmMgrState)
                                                          + " in decryptInit()");
 
-  // Initialize the cipher decryption context specifying the cipher, key and IV
-  if(EVP_DecryptInit(_aesGcmCTX, EVP_aes_128_gcm(), _skey,
-                     reinterpret_cast<const unsigned char*>(&(_iv->iv_AES_GCM))) != 1)
+  // Set the IV in the already keyed cipher decryption context, starting a new decryption
+  if(EVP_DecryptInit_ex(_aesGcmDecCTX, NULL, NULL, NULL,
+                        reinterpret_cast<const unsigned char*>(&(_iv->iv_AES_GCM))) != 1)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_DECRYPT_INIT, OSSL_ERR_DESC);
 
-  // Set the manager to expect up to one AAD block (if any) for decryption
+  // Set the manager to expect any number of AAD blocks (if any) for decryption
   _aesGcmMgrState = DECRYPT_AAD;
  }
 
 
 /**
- * @brief Add the single, optional AAD block in the manager current decryption operation
+ * @brief Adds an AAD block in the manager current decryption operation, where multiple AAD blocks
+ *        can be added before any ciphertext block, so to authenticate data without decrypting it (GMAC)
  * @param aadAddr The AAD initial address
  * @param aadSize The AAD size
  * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
@@ -295,12 +356,13 @@ void AESGCMMgr::decryptAddAAD(unsigned char* aadAddr, int aadSize)
   printf("aadBlockHex = %s\n",aadBlockHex);
   */
 
-  // Set the decryption AAD block
-  if(EVP_DecryptUpdate(_aesGcmCTX, NULL, &_sizeTot, aadAddr, aadSize) != 1)
+  // Add the decryption AAD block, which leaves the manager expecting
+  // further AAD blocks, ciphertext blocks or the operation's finalization
+  if(EVP_DecryptUpdate(_aesGcmDecCTX, NULL, &_sizePart, aadAddr, aadSize) != 1)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_DECRYPT_UPDATE, OSSL_ERR_DESC);
 
-  // Set the manager to expect any number of ciphertext blocks for encryption
-  _aesGcmMgrState = DECRYPT_UPDATE;
+  // Update the decryption operation's cumulative size (AAD included)
+  _sizeTot += _sizePart;
  }
 
 
@@ -316,7 +378,7 @@ void AESGCMMgr::decryptAddAAD(unsigned char* aadAddr, int aadSize)
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE The ciphertext block size is non-positive (probable overflow)
  * @throws ERR_OSSL_EVP_DECRYPT_UPDATE  EVP_CIPHER decrypt update failed
  */
-int AESGCMMgr::decryptAddCT(unsigned char* ctAddr, int ctSize, unsigned char* ptDest)
+long int AESGCMMgr::decryptAddCT(unsigned char* ctAddr, int ctSize, unsigned char* ptDest)
  {
   // Assert the manager to be expecting either the AAD or a ciphertext block for decryption
   if(_aesGcmMgrState != DECRYPT_UPDATE && _aesGcmMgrState != DECRYPT_AAD)
@@ -331,7 +393,7 @@ int AESGCMMgr::decryptAddCT(unsigned char* ctAddr, int ctSize, unsigned char* pt
    THROW_EXEC_EXCP(ERR_NON_POSITIVE_BUFFER_SIZE, "ctSize = " + std::to_string(ctSize));
 
   // Decrypt the ciphertext block to the plaintext buffer
-  if(EVP_DecryptUpdate(_aesGcmCTX, ptDest, &_sizePart, ctAddr, ctSize) != 1)
+  if(EVP_DecryptUpdate(_aesGcmDecCTX, ptDest, &_sizePart, ctAddr, ctSize) != 1)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_DECRYPT_UPDATE, OSSL_ERR_DESC);
 
   /*
@@ -375,15 +437,15 @@ int AESGCMMgr::decryptAddCT(unsigned char* ctAddr, int ctSize, unsigned char* pt
  *         verification failures, which are thrown as session exceptions (sessErrExcp)
  *         so to preserve the connection between the SafeCloud server and client
  */
-int AESGCMMgr::decryptFinal(unsigned char* tagAddr)
+long int AESGCMMgr::decryptFinal(unsigned char* tagAddr)
  {
-  // Assert the manager to be expecting either the AAD or a ciphertext block for decryption
-  if(_aesGcmMgrState != DECRYPT_UPDATE)
+  // Assert the manager to be expecting either an AAD or a ciphertext block for decryption
+  if(_aesGcmMgrState != DECRYPT_AAD && _aesGcmMgrState != DECRYPT_UPDATE)
    THROW_EXEC_EXCP(ERR_AESGCMMGR_INVALID_STATE, "state " + std::to_string(_aesGcmMgrState)
                                                          + " in decryptFinal()");
 
   // Set the decryption operation's expected integrity tag
-  if(!EVP_CIPHER_CTX_ctrl(_aesGcmCTX, EVP_CTRL_AEAD_SET_TAG, 16, tagAddr))
+  if(!EVP_CIPHER_CTX_ctrl(_aesGcmDecCTX, EVP_CTRL_AEAD_SET_TAG, 16, tagAddr))
    THROW_EXEC_EXCP(ERR_OSSL_SET_TAG_FAILED);
 
   /*
@@ -397,14 +459,14 @@ int AESGCMMgr::decryptFinal(unsigned char* tagAddr)
 
   // Finalize the decryption operation by validating the integrity
   // of the resulting plaintext against the expected integrity tag
-  if(EVP_DecryptFinal(_aesGcmCTX, NULL, &_sizePart) <= 0)
+  if(EVP_DecryptFinal(_aesGcmDecCTX, NULL, &_sizePart) <= 0)
    {
     ERR_print_errors_fp(stderr);
     THROW_SESS_EXCP(ERR_OSSL_DECRYPT_VERIFY_FAILED, OSSL_ERR_DESC);
    }
 
   // Decryption operation resulting plaintext size (AAD included)
-  int ptSize = _sizeTot + _sizePart;
+  long int ptSize = _sizeTot + _sizePart;
 
   // Reset the AES_128_GCM manager state so to be ready
   // for a new encryption or decryption operation
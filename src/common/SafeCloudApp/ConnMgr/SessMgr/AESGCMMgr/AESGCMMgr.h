@@ -3,12 +3,15 @@
 
 /*
  * This class represents the AES_128_GCM Manager used for encrypting, decrypting, and asserting
- * the integrity of data exchanged between the SafeCloud server and client in the session phase
+ * the integrity of data exchanged between the SafeCloud server and client in the session phase,
+ * which can also use the ChaCha20-Poly1305 AEAD cipher negotiated for the connection as an
+ * alternative to AES_128_GCM, both ciphers sharing the same 12 bytes IV and 16 bytes tag
  */
 
 /* ================================== INCLUDES ================================== */
 #include <openssl/pem.h>
 #include "SafeCloudApp/ConnMgr/IV/IV.h"
+#include "ossl_crypto/AEAD.h"
 
 #define AES_128_GCM_TAG_SIZE 16
 
@@ -22,13 +25,13 @@ class AESGCMMgr
      // Ready to start an encryption or decryption operation
      READY = 0,
 
-     // Expecting up to one Associated Authenticated Data (AAD) block (if any) for encryption
+     // Expecting any number of Associated Authenticated Data (AAD) blocks (if any) for encryption
      ENCRYPT_AAD,
 
      // Expecting one or more plaintext blocks for encryption
      ENCRYPT_UPDATE,
 
-     // Expecting up to one Associated Authenticated Data (AAD) block (if any) for decryption
+     // Expecting any number of Associated Authenticated Data (AAD) blocks (if any) for decryption
      DECRYPT_AAD,
 
      // Expecting one or more ciphertext blocks for decryption
@@ -40,12 +43,13 @@ class AESGCMMgr
    // The current manager state
    AESGCMMgrState  _aesGcmMgrState;
 
-   // The cipher context used in the current or the next
-   // AES_128_GCM encryption or decryption operation
-   EVP_CIPHER_CTX* _aesGcmCTX;
+   // The cipher contexts used in the manager's AES_128_GCM encryption and decryption
+   // operations, both keyed once at construction with the cipher and session key
+   EVP_CIPHER_CTX* _aesGcmEncCTX;
+   EVP_CIPHER_CTX* _aesGcmDecCTX;
 
-   // A pointer to the AES_128_GCM symmetric key of AES_128_KEY_SIZE = 16 bytes
-   unsigned char* _skey;
+   // The AEAD cipher used by the manager (AES_128_GCM or ChaCha20-Poly1305)
+   const EVP_CIPHER* _cipher;
 
    // A pointer to the connection's initialization vector
    IV* _iv;
@@ -53,26 +57,40 @@ class AESGCMMgr
    // The total number of bytes encrypted or decrypted in the current
    // encryption or decryption operation, eventually representing
    // the resulting ciphertext or plaintext size including any AAD
-   int _sizeTot;
+   long int _sizeTot;
 
    // The number of bytes encrypted or decrypted by the last OpenSSL API call
    int _sizePart;
 
+   /* ============================== PRIVATE METHODS ============================== */
+
+   /**
+    * @brief Frees the manager's cipher encryption and decryption contexts, which
+    *        also securely erases the session key schedule they retain
+    */
+   void freeCTXs();
+
   public:
 
    /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
    /**
-    * @brief  AES_128_GCM object constructor, setting the session's cryptographic
-    *         quantities and initializing the first cipher encryption or decryption context
-    * @param  skey The AES_128_GCM symmetric key to be used in the secure communication (16 bytes)
-    * @param  iv   The already-initialized IV to be used in the secure communication
-    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW EVP_CIPHER context creation failed
+    * @brief  AES_128_GCM object constructor, setting the session's cryptographic quantities and
+    *         creating the cipher encryption and decryption contexts, which are initialized with
+    *         the cipher and session key once for all the manager's operations
+    * @param  skey   The session key to be used in the secure communication (32 bytes, of which
+    *                AES_128_GCM uses the first AES_128_KEY_SIZE = 16 bytes)
+    * @param  iv     The already-initialized IV to be used in the secure communication
+    * @param  cipher The AEAD cipher to be used in the secure communication
+    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW  EVP_CIPHER context creation failed
+    * @throws ERR_OSSL_AEAD_UNKNOWN_CIPHER Unknown AEAD cipher
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_OSSL_EVP_DECRYPT_INIT    EVP_CIPHER decrypt initialization failed
     */
-   AESGCMMgr(unsigned char* skey, IV* iv);
+   AESGCMMgr(const unsigned char* skey, IV* iv, AEADCipher cipher);
 
    /**
-    * @brief AES_128_GCM object destructor, freeing its prepared cipher context
+    * @brief AES_128_GCM object destructor, freeing its cipher contexts
     * @note  It is assumed the secure erasure of the connection's cryptographic quantities
     *        (session key, IV) to be performed by the associated connection manager object
     */
@@ -81,12 +99,23 @@ class AESGCMMgr
    /* ============================ OTHER PUBLIC METHODS ============================= */
 
    /**
-    * @brief  Resets the AES_128_GCM manager state so to be
-    *         ready for a new encryption or decryption operation
-    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW EVP_CIPHER context creation failed
+    * @brief Resets the AES_128_GCM manager state so to be
+    *        ready for a new encryption or decryption operation
+    * @note  The cipher contexts are not freed nor re-created, as any completed or aborted
+    *        operation state they hold is discarded by setting the next operation's IV
     */
    void resetState();
 
+   /**
+    * @brief  Replaces the key of the manager's cipher encryption and decryption contexts,
+    *         which is used by all of its following operations (see the SessKey class)
+    * @param  skey The new key to be used in the secure communication (32 bytes)
+    * @throws ERR_AESGCMMGR_INVALID_STATE Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT   EVP_CIPHER encrypt initialization failed
+    * @throws ERR_OSSL_EVP_DECRYPT_INIT   EVP_CIPHER decrypt initialization failed
+    */
+   void rekey(const unsigned char* skey);
+
    /* ---------------------------- Encryption Operation ---------------------------- */
 
    /**
@@ -97,7 +126,8 @@ class AESGCMMgr
    void encryptInit();
 
    /**
-    * @brief Add the single, optional AAD block in the manager current encryption operation
+    * @brief Adds an AAD block in the manager current encryption operation, where multiple AAD blocks
+    *        can be added before any plaintext block, so to authenticate data without encrypting it (GMAC)
     * @param aadAddr The AAD initial address
     * @param aadSize The AAD size
     * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
@@ -107,19 +137,23 @@ class AESGCMMgr
    void encryptAddAAD(unsigned char* aadAddr, int aadSize);
 
    /**
-    * @brief Encrypts a plaintext block in the manager current
-    *        encryption operation, safely deleting it afterwards
-    * @param ptAddr The plaintext block initial address
-    * @param ptSize The plaintext block size
-    * @param ctDest The address where to write the resulting ciphertext block
-    * @note         The function assumes the "ctDest" destination buffer to be large enough
-    *               to contain the resulting ciphertext block (at least 'ptSize' bytes)
-    * @return       The encryption operation's cumulative ciphertext size (AAD included)
+    * @brief Encrypts a plaintext block in the manager current encryption operation,
+    *        safely deleting it afterwards unless it is encrypted in place or preserved
+    * @param ptAddr    The plaintext block initial address
+    * @param ptSize    The plaintext block size
+    * @param ctDest    The address where to write the resulting ciphertext block
+    * @param cleansePT Whether the plaintext block must be safely deleted (false for plaintexts that must
+    *                  be preserved or cannot be written, e.g. the memory mapping of a file being sent)
+    * @note            The function assumes the "ctDest" destination buffer to be large enough
+    *                  to contain the resulting ciphertext block (at least 'ptSize' bytes)
+    * @return          The encryption operation's cumulative ciphertext size (AAD included)
     * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE The plaintext block size is non-positive (probable overflow)
     * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
     */
-   int encryptAddPT(unsigned char* ptAddr, int ptSize, unsigned char* ctDest);
+   long int encryptAddPT(unsigned char* ptAddr, int ptSize, unsigned char* ctDest);
+
+   long int encryptAddPT(unsigned char* ptAddr, int ptSize, unsigned char* ctDest, bool cleansePT);
 
    /**
     * @brief  Finalizes the manager current encryption operation and
@@ -132,7 +166,7 @@ class AESGCMMgr
     * @throws ERR_OSSL_EVP_ENCRYPT_FINAL  EVP_CIPHER encrypt final failed
     * @throws ERR_OSSL_GET_TAG_FAILED     Error in retrieving the resulting integrity tag
     */
-   int encryptFinal(unsigned char* tagDest);
+   long int encryptFinal(unsigned char* tagDest);
 
    /* ---------------------------- Decryption Operation ---------------------------- */
 
@@ -144,7 +178,8 @@ class AESGCMMgr
    void decryptInit();
 
    /**
-    * @brief Add the single, optional AAD block in the manager current decryption operation
+    * @brief Adds an AAD block in the manager current decryption operation, where multiple AAD blocks
+    *        can be added before any ciphertext block, so to authenticate data without decrypting it (GMAC)
     * @param aadAddr The AAD initial address
     * @param aadSize The AAD size
     * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
@@ -165,7 +200,7 @@ class AESGCMMgr
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE The ciphertext block size is non-positive (probable overflow)
     * @throws ERR_OSSL_EVP_DECRYPT_UPDATE  EVP_CIPHER decrypt update failed
     */
-   int decryptAddCT(unsigned char* ctAddr, int ctSize, unsigned char* ptDest);
+   long int decryptAddCT(unsigned char* ctAddr, int ctSize, unsigned char* ptDest);
 
 
    /**
@@ -180,7 +215,7 @@ class AESGCMMgr
     *         verification failures, which are thrown as session exceptions (sessErrExcp)
     *         so to preserve the connection between the SafeCloud server and client
     */
-   int decryptFinal(unsigned char* tagAddr);
+   long int decryptFinal(unsigned char* tagAddr);
  };
 
 
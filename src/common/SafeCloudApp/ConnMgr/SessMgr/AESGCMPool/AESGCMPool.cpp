@@ -0,0 +1,370 @@
+/* AES_128_GCM Workers Pool Definitions */
+
+/* ================================== INCLUDES ================================== */
+
+// System Headers
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+// SafeCloud Headers
+#include "AESGCMPool.h"
+
+
+/* ============================== PRIVATE METHODS ============================== */
+
+/**
+ * @brief Worker thread main loop, waiting for chunks jobs batches and taking
+ *        part in those that require it until the pool is destroyed
+ * @param workerIdx The index of the worker's persistent state (>= 1)
+ */
+void AESGCMPool::workerLoop(unsigned int workerIdx)
+ {
+  // The identifier of the last batch seen by the worker thread
+  unsigned long lastBatchId = 0;
+
+  std::unique_lock<std::mutex> poolLock(_poolMutex);
+
+  while(true)
+   {
+    // Wait for a new batch or for the pool to be destroyed
+    _batchStartCond.wait(poolLock, [&]{ return _shutdown || _batchId != lastBatchId; });
+    if(_shutdown)
+     return;
+    lastBatchId = _batchId;
+
+    // Only the first '_batchThreads' worker threads take part in the batch
+    if(workerIdx > _batchThreads)
+     continue;
+
+    // Process the batch's chunks jobs without holding the pool mutex
+    poolLock.unlock();
+    chunksWorker(_workers[workerIdx]);
+    poolLock.lock();
+
+    // Signal the caller if this was the last worker thread processing the batch
+    if(--_batchPending == 0)
+     _batchEndCond.notify_one();
+   }
+ }
+
+
+/**
+ * @brief Worker routine encrypting or decrypting the current batch's chunks jobs not yet taken by another
+ *        worker, each using as nonce the batch's IV incremented by the chunk's job index, where the worker's
+ *        AES_128_GCM manager is (re)created at its first use or if the batch's AEAD cipher is different,
+ *        and rekeyed if the batch's key or its epoch is different
+ * @param worker The worker's persistent state
+ * @note  Being also executed in the worker threads, the routine never throws, with the exceptions raised
+ *        by each chunk job being stored into its associated element of the batch's exceptions array
+ */
+void AESGCMPool::chunksWorker(Worker& worker)
+ {
+  // The index of the chunk job currently processed by the worker
+  unsigned int jobIdx;
+
+  // The chunk plaintext or ciphertext size
+  int chunkSize;
+
+  // The worker's AES_128_GCM manager to be used for the batch
+  WorkerMgr& workerMgr = _batchEncrypt ? worker.enc : worker.dec;
+
+  // Set the worker's private IV to the batch's IV, whose variable
+  // part is set to the nonce of each chunk job before processing it
+  worker.iv = *_batchIV;
+
+  try
+   {
+    // Create the worker's AES_128_GCM manager at its first use or if the batch's AEAD cipher
+    // is different, using the worker's private IV, or rekey it if the batch's key or its epoch
+    // is different (where the manager is marked as not keyed until this succeeds)
+    if(workerMgr.mgr == nullptr || workerMgr.cipher != _batchCipher)
+     {
+      delete workerMgr.mgr;
+      workerMgr.mgr    = nullptr;
+      workerMgr.key    = nullptr;
+      workerMgr.mgr    = new AESGCMMgr(_batchKey->key, &worker.iv, _batchCipher);
+      workerMgr.cipher = _batchCipher;
+     }
+    else
+     if(workerMgr.key != _batchKey || workerMgr.epoch != _batchKey->epoch)
+      {
+       workerMgr.key = nullptr;
+       workerMgr.mgr->rekey(_batchKey->key);
+      }
+    workerMgr.key   = _batchKey;
+    workerMgr.epoch = _batchKey->epoch;
+
+    // While chunks jobs not taken by other workers are available
+    while((jobIdx = _batchNextJob++) < _batchNumJobs)
+     {
+      AESGCMChunkJob& job = _batchJobs[jobIdx];
+
+      // Set the IV to the chunk's nonce, i.e. the batch's IV incremented by the
+      // chunk job index, exactly as if the chunks were encrypted or decrypted serially
+      worker.iv.iv_var = _batchIV->iv_var + jobIdx;
+
+      // The size of the chunk's data to be encrypted or decrypted
+      chunkSize = (int)job.dataSize;
+
+      try
+       {
+        // Encrypt the chunk, authenticating its AAD and
+        // writing the resulting tag into its associated address
+        if(_batchEncrypt)
+         {
+          workerMgr.mgr->encryptInit();
+          workerMgr.mgr->encryptAddAAD(reinterpret_cast<unsigned char*>(&job.aad), sizeof(FileChunkAAD));
+
+          // Authenticate-only chunks have their data authenticated as
+          // further AAD (GMAC) and copied as-is to their output address
+          if(job.aad.authOnly)
+           {
+            workerMgr.mgr->encryptAddAAD(job.inAddr, chunkSize);
+            if(job.outAddr != job.inAddr)
+             memcpy(job.outAddr, job.inAddr, chunkSize);
+           }
+          else
+           workerMgr.mgr->encryptAddPT(job.inAddr, chunkSize, job.outAddr, !job.keepIn);
+
+          workerMgr.mgr->encryptFinal(job.tagAddr);
+         }
+
+        // Decrypt the chunk, authenticating its AAD and verifying it
+        // against the integrity tag available at its associated address
+        else
+         {
+          workerMgr.mgr->decryptInit();
+          workerMgr.mgr->decryptAddAAD(reinterpret_cast<unsigned char*>(&job.aad), sizeof(FileChunkAAD));
+
+          // Authenticate-only chunks have their data authenticated as
+          // further AAD (GMAC) and copied as-is to their output address
+          if(job.aad.authOnly)
+           {
+            workerMgr.mgr->decryptAddAAD(job.inAddr, chunkSize);
+            if(job.outAddr != job.inAddr)
+             memcpy(job.outAddr, job.inAddr, chunkSize);
+           }
+          else
+           workerMgr.mgr->decryptAddCT(job.inAddr, chunkSize, job.outAddr);
+
+          workerMgr.mgr->decryptFinal(job.tagAddr);
+         }
+       }
+      catch(...)
+       {
+        // Store the exception raised by the chunk job
+        _batchExcp[jobIdx] = std::current_exception();
+
+        // Reset the worker's AES_128_GCM manager so
+        // to be ready for processing the next chunk
+        workerMgr.mgr->resetState();
+       }
+     }
+   }
+
+  // Failing to create or rekey the worker's AES_128_GCM manager is attributed to the next
+  // chunk job it takes, if any (otherwise all chunks jobs were processed by other workers)
+  catch(...)
+   {
+    if((jobIdx = _batchNextJob++) < _batchNumJobs)
+     _batchExcp[jobIdx] = std::current_exception();
+   }
+ }
+
+
+/**
+ * @brief  Encrypts or decrypts a set of chunks jobs by using up to 'numWorkers' workers
+ *         (the caller included), advancing the provided IV by the number of chunks jobs
+ * @param  encrypt    Whether the chunks should be encrypted or decrypted
+ * @param  cipher     The AEAD cipher the chunks are encrypted or decrypted with
+ * @param  skey       The key the chunks are encrypted or decrypted with
+ * @param  iv         The IV the chunks jobs' nonces are derived from
+ * @param  jobs       The chunks jobs array
+ * @param  numJobs    The number of chunks jobs
+ * @param  numWorkers The maximum number of workers to be used
+ * @throws The exception raised by the first chunk job that has failed, if any
+ */
+void AESGCMPool::processChunks(bool encrypt, AEADCipher cipher, const SessKey& skey, IV* iv, AESGCMChunkJob* jobs, unsigned int numJobs, unsigned int numWorkers)
+ {
+  // Serialize the operations sharing the pool
+  std::lock_guard<std::mutex> callLock(_callMutex);
+
+  // The exception raised by each chunk job, if any
+  std::vector<std::exception_ptr> jobExcp(numJobs);
+
+  // If there are no chunks jobs, just return
+  if(numJobs == 0)
+   return;
+
+  // The actual number of workers cannot exceed neither
+  // the number of chunks jobs nor the maximum allowed
+  numWorkers = std::max(1U, std::min({numWorkers, numJobs, _maxWorkers}));
+
+  // Set the batch's information, starting it in the worker threads should any be required
+  {
+   std::lock_guard<std::mutex> poolLock(_poolMutex);
+
+   _batchEncrypt = encrypt;
+   _batchCipher  = cipher;
+   _batchKey     = &skey;
+   _batchIV      = iv;
+   _batchJobs    = jobs;
+   _batchNumJobs = numJobs;
+   _batchExcp    = jobExcp.data();
+   _batchNextJob = 0;
+   _batchThreads = numWorkers - 1;
+   _batchPending = numWorkers - 1;
+
+   if(numWorkers > 1)
+    _batchId++;
+  }
+
+  if(numWorkers > 1)
+   _batchStartCond.notify_all();
+
+  // Process chunks jobs in the caller thread as well
+  chunksWorker(_workers[0]);
+
+  // Wait for the worker threads taking part in the batch to finish processing it
+  if(numWorkers > 1)
+   {
+    std::unique_lock<std::mutex> poolLock(_poolMutex);
+    _batchEndCond.wait(poolLock, [&]{ return _batchPending == 0; });
+   }
+
+  // Advance the provided IV by the number of chunks, so to be consistent with
+  // the nonces used by the chunks and in sync with the IV of the connection peer
+  iv->iv_var += numJobs;
+
+  // Rethrow the exception raised by the first chunk job that has failed, if any
+  for(auto& excp : jobExcp)
+   if(excp)
+    std::rethrow_exception(excp);
+ }
+
+
+/* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+/**
+ * @brief AES_128_GCM workers pool object constructor, creating its worker threads
+ * @note  Should a worker thread fail to be created, the pool uses the ones created so far
+ */
+AESGCMPool::AESGCMPool()
+ : _maxWorkers(std::max(1U, std::min(std::thread::hardware_concurrency(), (unsigned int)AESGCM_POOL_MAX_WORKERS))),
+   _workers(_maxWorkers), _threads(), _batchEncrypt(false), _batchCipher(AEAD_AES_128_GCM), _batchKey(nullptr),
+   _batchIV(nullptr), _batchJobs(nullptr), _batchNumJobs(0), _batchExcp(nullptr), _batchNextJob(0), _batchThreads(0),
+   _batchPending(0), _batchId(0), _shutdown(false), _poolMutex(), _batchStartCond(), _batchEndCond(), _callMutex()
+ {
+  try
+   {
+    for(unsigned int i = 1; i < _maxWorkers; i++)
+     _threads.emplace_back(&AESGCMPool::workerLoop, this, i);
+   }
+  catch(std::system_error&)
+   { _maxWorkers = (unsigned int)_threads.size() + 1; }
+ }
+
+
+/**
+ * @brief AES_128_GCM workers pool object destructor, terminating
+ *        its worker threads and freeing the workers' managers
+ */
+AESGCMPool::~AESGCMPool()
+ {
+  {
+   std::lock_guard<std::mutex> poolLock(_poolMutex);
+   _shutdown = true;
+  }
+  _batchStartCond.notify_all();
+
+  for(auto& thread : _threads)
+   thread.join();
+
+  for(auto& worker : _workers)
+   {
+    delete worker.enc.mgr;
+    delete worker.dec.mgr;
+   }
+ }
+
+
+/* ============================ OTHER PUBLIC METHODS ============================ */
+
+/**
+ * @brief  Returns the number of workers to be used for
+ *         encrypting or decrypting the chunks of a file
+ * @param  fileSize The file size
+ * @return The number of workers to be used (1 = serial encryption or decryption)
+ */
+unsigned int AESGCMPool::getNumWorkers(long int fileSize) const
+ {
+  if(fileSize < AESGCM_POOL_MIN_FILE_SIZE)
+   return 1;
+  return _maxWorkers;
+ }
+
+
+/**
+ * @brief  Encrypts a set of file chunks, writing each resulting integrity tag
+ *         into its associated address, and advances the provided IV
+ *         by the number of chunks
+ * @param  cipher     The AEAD cipher the chunks are encrypted with
+ * @param  skey       The key the chunks are encrypted with
+ * @param  iv         The IV the chunks' nonces are derived from, advanced by the number of chunks
+ * @param  jobs       The chunks jobs array
+ * @param  numJobs    The number of chunks jobs
+ * @param  numWorkers The maximum number of workers to be used (the caller included)
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW  EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The plaintext block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ */
+void AESGCMPool::encryptChunks(AEADCipher cipher, const SessKey& skey, IV* iv, AESGCMChunkJob* jobs, unsigned int numJobs, unsigned int numWorkers)
+ { processChunks(true, cipher, skey, iv, jobs, numJobs, numWorkers); }
+
+
+/**
+ * @brief  Decrypts a set of file chunks, verifying each against the integrity tag
+ *         at its associated address, and advances the provided IV
+ *         by the number of chunks
+ * @param  cipher     The AEAD cipher the chunks are decrypted with
+ * @param  skey       The key the chunks are decrypted with
+ * @param  iv         The IV the chunks' nonces are derived from, advanced by the number of chunks
+ * @param  jobs       The chunks jobs array
+ * @param  numJobs    The number of chunks jobs
+ * @param  numWorkers The maximum number of workers to be used (the caller included)
+ * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW    EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_DECRYPT_INIT      EVP_CIPHER decrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE   The ciphertext block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_DECRYPT_UPDATE    EVP_CIPHER decrypt update failed
+ * @throws ERR_OSSL_SET_TAG_FAILED        Error in setting the expected integrity tag
+ * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED A chunk integrity verification failed
+ */
+void AESGCMPool::decryptChunks(AEADCipher cipher, const SessKey& skey, IV* iv, AESGCMChunkJob* jobs, unsigned int numJobs, unsigned int numWorkers)
+ { processChunks(false, cipher, skey, iv, jobs, numJobs, numWorkers); }
+
+
+/**
+ * @brief Frees the workers' managers keyed with a key, safely deleting its
+ *        key schedule, which must be called before the key is destroyed
+ * @param skey The key whose workers' managers are to be freed
+ */
+void AESGCMPool::releaseKey(const SessKey& skey)
+ {
+  // Wait for any batch using the pool to complete
+  std::lock_guard<std::mutex> callLock(_callMutex);
+
+  for(auto& worker : _workers)
+   for(WorkerMgr* workerMgr : {&worker.enc, &worker.dec})
+    if(workerMgr->key == &skey)
+     {
+      delete workerMgr->mgr;
+      workerMgr->mgr = nullptr;
+      workerMgr->key = nullptr;
+     }
+ }
\ No newline at end of file
@@ -0,0 +1,232 @@
+#ifndef SAFECLOUD_AESGCMPOOL_H
+#define SAFECLOUD_AESGCMPOOL_H
+
+/*
+ * This class represents the AES_128_GCM Workers Pool used for encrypting and decrypting in parallel
+ * the chunks of a file segment, where each chunk is a standalone AES_128_GCM operation whose nonce
+ * is derived from the IV of the stream the segment belongs to and the chunk position in the segment,
+ * so that the chunks resulting from a parallel encryption are exactly the same as the ones of a
+ * serial encryption, where:
+ *   - A single pool is shared by all the sessions of the SafeCloud server or client, whose worker
+ *     threads are created once with it and wait for the chunks jobs of each file segment, processing
+ *     them together with the calling thread
+ *   - Each worker (the calling thread included) keeps its AES_128_GCM managers across file segments,
+ *     only rekeying them when the chunks' key or its epoch changes, and recreating them when the
+ *     AEAD cipher changes (as it is negotiated per connection)
+ *   - The managers keyed with a session's keys are freed when the session ends
+ */
+
+/* ================================== INCLUDES ================================== */
+
+// System Headers
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+// SafeCloud Headers
+#include "SafeCloudApp/ConnMgr/SessMgr/AESGCMMgr/AESGCMMgr.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/SessKey/SessKey.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/SessMsg.h"
+
+
+// The maximum number of worker threads used for
+// encrypting or decrypting a file segment's chunks
+#define AESGCM_POOL_MAX_WORKERS 8
+
+// The minimum size of a file for its segments' chunks to be encrypted or decrypted
+// in parallel (as for smaller files the threads overhead is not worth it)
+#define AESGCM_POOL_MIN_FILE_SIZE (8 * 1024 * 1024)  // 8 MB
+
+
+/* ============================== TYPE DEFINITIONS ============================== */
+
+// A file chunk AES_128_GCM encryption or decryption job
+struct AESGCMChunkJob
+ {
+  unsigned char* inAddr;   // The chunk's plaintext (encryption) or ciphertext (decryption) initial address
+  unsigned char* outAddr;  // The address where to write the chunk's resulting ciphertext or plaintext
+  unsigned char* tagAddr;  // The address where to write (encryption) or read (decryption) the chunk's tag
+  unsigned int   dataSize; // The size of the chunk's data to be encrypted or decrypted (smaller
+                           // than its plaintext size if the chunk is transferred compressed)
+  FileChunkAAD   aad;      // The chunk's AAD
+  bool           keepIn;   // Whether the chunk's plaintext must be preserved rather than safely deleted
+                           // after its encryption (e.g. when read from a file's memory mapping)
+ };
+
+
+class AESGCMPool
+ {
+  private:
+
+   /* ============================== TYPE DEFINITIONS ============================== */
+
+   // A pool worker's AES_128_GCM manager and the key it is keyed with
+   struct WorkerMgr
+    {
+     AESGCMMgr*     mgr    = nullptr;            // The AES_128_GCM manager (created at its first use)
+     const SessKey* key    = nullptr;            // The key the manager is keyed with (nullptr = none)
+     uint32_t       epoch  = 0;                  // The epoch of the key the manager is keyed with
+     AEADCipher     cipher = AEAD_AES_128_GCM;   // The AEAD cipher used by the manager
+    };
+
+   // A pool worker's persistent state
+   struct Worker
+    {
+     IV        iv;    // The worker's private IV, whose variable part is set to the nonce of each chunk job
+     WorkerMgr enc;   // The worker's encryption manager
+     WorkerMgr dec;   // The worker's decryption manager
+    };
+
+   /* ================================= ATTRIBUTES ================================= */
+
+   // The maximum number of workers used in an encryption or decryption operation
+   // (the calling thread included), depending on the number of available hardware
+   // threads and on the number of worker threads that could be created
+   unsigned int _maxWorkers;
+
+   // The workers' persistent states, where the first is the
+   // calling thread's and the others are the worker threads'
+   std::vector<Worker> _workers;
+
+   // The pool's worker threads
+   std::vector<std::thread> _threads;
+
+   // The chunks jobs batch currently processed by the pool
+   bool                      _batchEncrypt;   // Whether the batch's chunks should be encrypted or decrypted
+   AEADCipher                _batchCipher;    // The AEAD cipher the batch's chunks are encrypted or decrypted with
+   const SessKey*            _batchKey;       // The key the batch's chunks are encrypted or decrypted with
+   IV*                       _batchIV;        // The IV the batch's chunks jobs' nonces are derived from
+   AESGCMChunkJob*           _batchJobs;      // The batch's chunks jobs array
+   unsigned int              _batchNumJobs;   // The batch's number of chunks jobs
+   std::exception_ptr*       _batchExcp;      // The exception raised by each of the batch's chunks jobs, if any
+   std::atomic<unsigned int> _batchNextJob;   // The index of the batch's next chunk job to be taken by a worker
+   unsigned int              _batchThreads;   // The number of worker threads taking part in the batch
+   unsigned int              _batchPending;   // The number of worker threads still processing the batch
+   unsigned long             _batchId;        // The identifier of the batch (0 = none yet)
+
+   // Whether the pool is being destroyed and its worker threads should terminate
+   bool _shutdown;
+
+   // Mutex and condition variables protecting the batch's information
+   // and signaling its start to the worker threads and its end to the caller
+   std::mutex              _poolMutex;
+   std::condition_variable _batchStartCond;
+   std::condition_variable _batchEndCond;
+
+   // Mutex serializing the operations sharing the pool (e.g. the encryptions
+   // of an upload pipeline stage and the decryptions of the main thread)
+   std::mutex _callMutex;
+
+   /* ============================== PRIVATE METHODS ============================== */
+
+   /**
+    * @brief Worker thread main loop, waiting for chunks jobs batches and taking
+    *        part in those that require it until the pool is destroyed
+    * @param workerIdx The index of the worker's persistent state (>= 1)
+    */
+   void workerLoop(unsigned int workerIdx);
+
+   /**
+    * @brief Worker routine encrypting or decrypting the current batch's chunks jobs not yet taken by another
+    *        worker, each using as nonce the batch's IV incremented by the chunk's job index, where the worker's
+    *        AES_128_GCM manager is (re)created at its first use or if the batch's AEAD cipher is different,
+    *        and rekeyed if the batch's key or its epoch is different
+    * @param worker The worker's persistent state
+    * @note  Being also executed in the worker threads, the routine never throws, with the exceptions raised
+    *        by each chunk job being stored into its associated element of the batch's exceptions array
+    */
+   void chunksWorker(Worker& worker);
+
+   /**
+    * @brief  Encrypts or decrypts a set of chunks jobs by using up to 'numWorkers' workers
+    *         (the caller included), advancing the provided IV by the number of chunks jobs
+    * @param  encrypt    Whether the chunks should be encrypted or decrypted
+    * @param  cipher     The AEAD cipher the chunks are encrypted or decrypted with
+    * @param  skey       The key the chunks are encrypted or decrypted with
+    * @param  iv         The IV the chunks jobs' nonces are derived from
+    * @param  jobs       The chunks jobs array
+    * @param  numJobs    The number of chunks jobs
+    * @param  numWorkers The maximum number of workers to be used
+    * @throws The exception raised by the first chunk job that has failed, if any
+    */
+   void processChunks(bool encrypt, AEADCipher cipher, const SessKey& skey, IV* iv, AESGCMChunkJob* jobs, unsigned int numJobs, unsigned int numWorkers);
+
+  public:
+
+   /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+   /**
+    * @brief AES_128_GCM workers pool object constructor, creating its worker threads
+    * @note  Should a worker thread fail to be created, the pool uses the ones created so far
+    */
+   AESGCMPool();
+
+   /**
+    * @brief AES_128_GCM workers pool object destructor, terminating
+    *        its worker threads and freeing the workers' managers
+    */
+   ~AESGCMPool();
+
+   /* ============================ OTHER PUBLIC METHODS ============================= */
+
+   /**
+    * @brief  Returns the number of workers to be used for
+    *         encrypting or decrypting the chunks of a file
+    * @param  fileSize The file size
+    * @return The number of workers to be used (1 = serial encryption or decryption)
+    */
+   unsigned int getNumWorkers(long int fileSize) const;
+
+   /**
+    * @brief  Encrypts a set of file chunks, writing each resulting integrity tag
+    *         into its associated address, and advances the provided IV
+    *         by the number of chunks
+    * @param  cipher     The AEAD cipher the chunks are encrypted with
+    * @param  skey       The key the chunks are encrypted with
+    * @param  iv         The IV the chunks' nonces are derived from, advanced by the number of chunks
+    * @param  jobs       The chunks jobs array
+    * @param  numJobs    The number of chunks jobs
+    * @param  numWorkers The maximum number of workers to be used (the caller included)
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW  EVP_CIPHER context creation failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The plaintext block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    */
+   void encryptChunks(AEADCipher cipher, const SessKey& skey, IV* iv, AESGCMChunkJob* jobs, unsigned int numJobs, unsigned int numWorkers);
+
+   /**
+    * @brief  Decrypts a set of file chunks, verifying each against the integrity tag
+    *         at its associated address, and advances the provided IV
+    *         by the number of chunks
+    * @param  cipher     The AEAD cipher the chunks are decrypted with
+    * @param  skey       The key the chunks are decrypted with
+    * @param  iv         The IV the chunks' nonces are derived from, advanced by the number of chunks
+    * @param  jobs       The chunks jobs array
+    * @param  numJobs    The number of chunks jobs
+    * @param  numWorkers The maximum number of workers to be used (the caller included)
+    * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW    EVP_CIPHER context creation failed
+    * @throws ERR_OSSL_EVP_DECRYPT_INIT      EVP_CIPHER decrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE   The ciphertext block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_DECRYPT_UPDATE    EVP_CIPHER decrypt update failed
+    * @throws ERR_OSSL_SET_TAG_FAILED        Error in setting the expected integrity tag
+    * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED A chunk integrity verification failed
+    */
+   void decryptChunks(AEADCipher cipher, const SessKey& skey, IV* iv, AESGCMChunkJob* jobs, unsigned int numJobs, unsigned int numWorkers);
+
+   /**
+    * @brief Frees the workers' managers keyed with a key, safely deleting its
+    *        key schedule, which must be called before the key is destroyed
+    * @param skey The key whose workers' managers are to be freed
+    */
+   void releaseKey(const SessKey& skey);
+ };
+
+
+#endif //SAFECLOUD_AESGCMPOOL_H
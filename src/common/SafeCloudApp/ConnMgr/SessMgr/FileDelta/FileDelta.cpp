@@ -0,0 +1,669 @@
+/* File Delta Definitions */
+
+/* ================================== INCLUDES ================================== */
+
+// System Headers
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// OpenSSL Headers
+#include <openssl/crypto.h>
+#include <openssl/err.h>
+
+// SafeCloud Headers
+#include "FileDelta.h"
+#include "errCodes/execErrCodes/execErrCodes.h"
+
+
+/* ============================== PRIVATE METHODS ============================== */
+
+/**
+ * @brief  Returns the rolling checksum of a block of data, consisting of the sum of its bytes (low 16 bits)
+ *         and the sum of its bytes weighted by their distance from the block's end (high 16 bits)
+ * @param  data The block's data
+ * @param  len  The block's length
+ * @return The block's rolling checksum
+ */
+uint32_t FileDelta::rollingChecksum(const unsigned char* data, size_t len)
+ {
+  uint32_t a = 0;
+  uint32_t b = 0;
+
+  // Each byte is added to the second sum once for every byte from it up to the block's end
+  for(size_t i = 0; i < len; i++)
+   {
+    a += data[i];
+    b += a;
+   }
+  return (a & 0xffff) | (b << 16);
+ }
+
+
+/**
+ * @brief  Returns the 16-bit tag of a weak checksum indexing the bitmap of the base's weak checksums
+ * @param  weak The weak checksum
+ * @return The weak checksum's tag
+ */
+uint32_t FileDelta::weakTag(uint32_t weak)
+ { return (weak ^ (weak >> 16)) & 0xffff; }
+
+
+/**
+ * @brief  Looks for a block of the base whose signatures match a window of the file being encoded,
+ *         preferring the block following the last one matched so that their references are merged
+ * @param  window    The window's data (of the size of the base's blocks)
+ * @param  weak      The window's rolling checksum
+ * @param  prefBlock The index of the block that is preferred if matching
+ * @param  block     Where to write the index of the matching block
+ * @return Whether a block matching the window was found
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL EVP_MD digest failed
+ */
+bool FileDelta::findBlock(const unsigned char* window, uint32_t weak, uint32_t prefBlock, uint32_t& block) const
+ {
+  unsigned char strong[EVP_MAX_MD_SIZE];  // The window's strong signature, computed on the first weak match
+  bool          strongSet = false;        // Whether the window's strong signature has been computed
+  bool          found = false;            // Whether a matching block has been found
+
+  // The base's last block, if shorter, is only matched against the file's end
+  uint32_t fullBlocks = (uint64_t)_numBlocks * _blockSize > _baseSize ? _numBlocks - 1 : _numBlocks;
+
+  // The blocks whose weak checksum matches the window's, which are sorted by their index
+  auto cand = std::lower_bound(_weakIndex.begin(), _weakIndex.end(), std::make_pair(weak, (uint32_t)0));
+
+  for(; cand != _weakIndex.end() && cand->first == weak; ++cand)
+   {
+    if(cand->second >= fullBlocks)
+     continue;
+
+    if(!strongSet)
+     {
+      if(EVP_Digest(window, _blockSize, strong, NULL, EVP_sha256(), NULL) != 1)
+       THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_FINAL, OSSL_ERR_DESC);
+      strongSet = true;
+     }
+
+    if(memcmp(strong, _sigs[cand->second].strong, FILE_DELTA_STRONG_SIZE) == 0)
+     {
+      // The preferred block is returned as soon as it is found to be matching
+      if(!found || cand->second == prefBlock)
+       block = cand->second;
+      found = true;
+      if(block == prefBlock)
+       break;
+     }
+   }
+  return found;
+ }
+
+
+/**
+ * @brief  Writes a record of the delta being encoded into its file
+ * @param  deltaDscr The descriptor of the delta file
+ * @param  type      The record's type
+ * @param  field1    The record's first field (COPY: firstBlock, LITERAL: length)
+ * @param  field2    The record's second field (COPY: numBlocks, LITERAL: unused)
+ * @param  data      The literal record's contents (nullptr for COPY records)
+ * @param  deltaSize The size of the delta written so far, which is updated
+ * @return Whether the record has been written
+ */
+bool FileDelta::writeRecord(FILE* deltaDscr, uint8_t type, uint32_t field1, uint32_t field2,
+                            const unsigned char* data, uint64_t& deltaSize)
+ {
+  unsigned char hdr[FILE_DELTA_COPY_HDR_SIZE];  // The record's header
+  size_t        hdrSize;                        // The size of the record's header
+
+  hdr[0] = type;
+  memcpy(&hdr[1], &field1, sizeof(uint32_t));
+  if(type == FILE_DELTA_REC_COPY)
+   {
+    memcpy(&hdr[1 + sizeof(uint32_t)], &field2, sizeof(uint32_t));
+    hdrSize = FILE_DELTA_COPY_HDR_SIZE;
+   }
+  else
+   hdrSize = FILE_DELTA_LITERAL_HDR_SIZE;
+
+  if(fwrite(hdr, 1, hdrSize, deltaDscr) != hdrSize)
+   return false;
+  deltaSize += hdrSize;
+
+  // A literal record is followed by its contents
+  if(type == FILE_DELTA_REC_LITERAL)
+   {
+    if(fwrite(data, 1, field1, deltaDscr) != field1)
+     return false;
+    deltaSize += field1;
+   }
+  return true;
+ }
+
+
+/**
+ * @brief  Writes literal contents of the file being encoded into the delta file,
+ *         split into records of up to FILE_DELTA_MAX_LITERAL bytes
+ * @param  deltaDscr The descriptor of the delta file
+ * @param  data      The literal contents
+ * @param  len       The literal contents' length
+ * @param  deltaSize The size of the delta written so far, which is updated
+ * @return Whether the literal contents have been written
+ */
+bool FileDelta::writeLiteral(FILE* deltaDscr, const unsigned char* data, uint64_t len, uint64_t& deltaSize)
+ {
+  uint32_t recLen;  // The length of the next literal record
+
+  while(len > 0)
+   {
+    recLen = (uint32_t)std::min(len, (uint64_t)FILE_DELTA_MAX_LITERAL);
+    if(!writeRecord(deltaDscr, FILE_DELTA_REC_LITERAL, recLen, 0, data, deltaSize))
+     return false;
+    data += recLen;
+    len  -= recLen;
+   }
+  return true;
+ }
+
+
+/**
+ * @brief  Writes contents of the file being rebuilt into its descriptor, updating its digest
+ * @param  data The contents
+ * @param  len  The contents' length
+ * @throws ERR_SESSABORT_INVALID_FILE_DELTA The contents exceed the size of the file being rebuilt
+ * @throws ERR_FILE_WRITE_FAILED            Error in writing the file being rebuilt
+ * @throws ERR_OSSL_EVP_DIGEST_UPDATE       EVP_MD digest update failed
+ */
+void FileDelta::writeOutput(const unsigned char* data, size_t len)
+ {
+  if(len > _targetSize - _outSize)
+   THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_DELTA, "the rebuilt file exceeds its size of "
+                                                     + std::to_string(_targetSize) + " bytes");
+
+  if(fwrite(data, 1, len, _outDscr) != len)
+   THROW_EXEC_EXCP(ERR_FILE_WRITE_FAILED, "file being rebuilt from its delta", ERRNO_DESC);
+
+  if(EVP_DigestUpdate(_mdCtx, data, len) != 1)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_UPDATE, OSSL_ERR_DESC);
+
+  _outSize += len;
+ }
+
+
+/**
+ * @brief  Copies a run of consecutive blocks of the base into the file being rebuilt
+ * @param  firstBlock The index of the run's first block
+ * @param  numBlocks  The number of blocks in the run
+ * @throws ERR_SESSABORT_INVALID_FILE_DELTA The run is out of the base's blocks or its contents
+ *                                          exceed the size of the file being rebuilt
+ * @throws ERR_FILE_READ_FAILED             Error in reading the base
+ * @throws ERR_FILE_WRITE_FAILED            Error in writing the file being rebuilt
+ * @throws ERR_OSSL_EVP_DIGEST_UPDATE       EVP_MD digest update failed
+ */
+void FileDelta::copyBlocks(uint32_t firstBlock, uint32_t numBlocks)
+ {
+  uint64_t offset;   // The offset in the base of the contents to be copied
+  uint64_t end;      // The end in the base of the contents to be copied
+  ssize_t  readRet;  // The number of bytes read by pread()
+
+  if(numBlocks == 0 || firstBlock >= _numBlocks || numBlocks > _numBlocks - firstBlock)
+   THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_DELTA, "copy of blocks [" + std::to_string(firstBlock) + ", "
+                                                     + std::to_string((uint64_t)firstBlock + numBlocks) + ") of "
+                                                     + std::to_string(_numBlocks));
+
+  offset = (uint64_t)firstBlock * _blockSize;
+  end    = std::min((uint64_t)(firstBlock + numBlocks) * _blockSize, _baseSize);
+  if(end - offset > _targetSize - _outSize)
+   THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_DELTA, "the rebuilt file exceeds its size of "
+                                                     + std::to_string(_targetSize) + " bytes");
+
+  if(_ioBuf.empty())
+   _ioBuf.resize(FILE_DELTA_IO_SIZE);
+
+  while(offset < end)
+   {
+    readRet = pread(_baseFd, _ioBuf.data(), (size_t)std::min(end - offset, (uint64_t)_ioBuf.size()), (off_t)offset);
+    if(readRet <= 0)
+     THROW_EXEC_EXCP(ERR_FILE_READ_FAILED, "base of the file delta at offset " + std::to_string(offset),
+                     readRet == 0 ? "unexpected end of file" : ERRNO_DESC);
+    writeOutput(_ioBuf.data(), (size_t)readRet);
+    offset += (uint64_t)readRet;
+   }
+ }
+
+
+/* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+/**
+ * @brief FileDelta object constructor, dividing the base into blocks whose size is the square root of the
+ *        base's size (rounded up to a KB multiple), but not smaller than FILE_DELTA_MIN_BLOCK nor yielding
+ *        more than FILE_DELTA_MAX_BLOCKS blocks
+ * @param baseFd   The base's file descriptor, of which the object takes ownership (server only, -1 = none)
+ * @param baseSize The base's size
+ */
+FileDelta::FileDelta(int baseFd, uint64_t baseSize)
+ : _baseFd(baseFd), _baseSize(baseSize), _blockSize(0), _numBlocks(0), _sigsDone(0), _sigs(), _weakIndex(), _weakTags(),
+   _outDscr(nullptr), _targetSize(0), _outSize(0), _mdCtx(nullptr), _recHdr(), _recHdrLen(0), _litRem(0),
+   _ioBuf(), _digest()
+ {
+  uint64_t blockSize = ((uint64_t)std::ceil(std::sqrt((double)baseSize)) + 1023) / 1024 * 1024;
+  uint64_t minBlockSize = (baseSize + FILE_DELTA_MAX_BLOCKS - 1) / FILE_DELTA_MAX_BLOCKS;
+
+  blockSize = std::max(blockSize, (uint64_t)FILE_DELTA_MIN_BLOCK);
+  if(blockSize < minBlockSize)
+   blockSize = (minBlockSize + 1023) / 1024 * 1024;
+
+  _blockSize = (uint32_t)blockSize;
+  _numBlocks = (uint32_t)((baseSize + blockSize - 1) / blockSize);
+ }
+
+
+/**
+ * @brief FileDelta object destructor, closing the base's file descriptor
+ *        and freeing the digest context of the file being rebuilt
+ */
+FileDelta::~FileDelta()
+ {
+  if(_baseFd != -1 && close(_baseFd) != 0)
+   LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, "base of the file delta", ERRNO_DESC);
+  EVP_MD_CTX_free(_mdCtx);
+ }
+
+
+/* ============================ OTHER PUBLIC METHODS ============================ */
+
+/**
+ * @brief  Returns the size of the base's blocks
+ * @return The size of the base's blocks
+ */
+uint32_t FileDelta::getBlockSize() const
+ { return _blockSize; }
+
+
+/**
+ * @brief  Returns the number of the base's blocks
+ * @return The number of the base's blocks
+ */
+uint32_t FileDelta::getNumBlocks() const
+ { return _numBlocks; }
+
+
+/**
+ * @brief  Returns the digest of the rebuilt file's contents (valid after 'finishApply()' succeeded)
+ * @return The digest of the rebuilt file's contents
+ */
+const unsigned char* FileDelta::getDigest() const
+ { return _digest; }
+
+
+/* --------------------------- Server-side Methods --------------------------- */
+
+/**
+ * @brief  Computes the signatures of the base's next blocks not yet signed, spanning FILE_DELTA_SIGS_STEP
+ *         bytes (or at least one block), so that the base is signed incrementally across multiple calls
+ * @return Whether the step has been computed, or 'false' on errors in reading the base
+ * @throws ERR_OSSL_EVP_MD_CTX_NEW    EVP_MD context creation failed
+ * @throws ERR_OSSL_EVP_DIGEST_INIT   EVP_MD digest initialization failed
+ * @throws ERR_OSSL_EVP_DIGEST_UPDATE EVP_MD digest update failed
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL  EVP_MD digest final failed
+ */
+bool FileDelta::computeSigsStep()
+ {
+  EVP_MD_CTX*   mdCtx;                    // The digest context of the blocks' strong signatures
+  unsigned char strong[EVP_MAX_MD_SIZE];  // A block's full strong signature
+  uint64_t      offset;                   // The offset of the next bytes to be read
+  uint64_t      stepEnd;                  // The offset past which no further block is signed in the step
+  uint64_t      blockEnd;                 // The end of the current block
+  ssize_t       readRet;                  // The number of bytes read by pread()
+  uint32_t      a;                        // The current block's sum of bytes
+  uint32_t      b;                        // The current block's weighted sum of bytes
+
+  mdCtx = EVP_MD_CTX_new();
+  if(mdCtx == nullptr)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_MD_CTX_NEW, OSSL_ERR_DESC);
+
+  // In the first step, allocate the signatures and the buffer
+  // and advise the kernel that the base is read sequentially
+  if(_sigs.empty())
+   {
+    _sigs.resize(_numBlocks);
+    _ioBuf.resize(FILE_DELTA_IO_SIZE);
+    posix_fadvise(_baseFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+   }
+
+  offset  = (uint64_t)_sigsDone * _blockSize;
+  stepEnd = offset + FILE_DELTA_SIGS_STEP;
+
+  for(; _sigsDone < _numBlocks && offset < stepEnd; _sigsDone++)
+   {
+    if(EVP_DigestInit_ex(mdCtx, EVP_sha256(), NULL) != 1)
+     {
+      EVP_MD_CTX_free(mdCtx);
+      THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_INIT, OSSL_ERR_DESC);
+     }
+    a = 0;
+    b = 0;
+
+    // Read the block, which may be larger than the buffer, and compute its signatures
+    blockEnd = std::min(offset + _blockSize, _baseSize);
+    while(offset < blockEnd)
+     {
+      readRet = pread(_baseFd, _ioBuf.data(), (size_t)std::min(blockEnd - offset, (uint64_t)_ioBuf.size()), (off_t)offset);
+      if(readRet <= 0)
+       {
+        EVP_MD_CTX_free(mdCtx);
+        return false;
+       }
+      for(ssize_t j = 0; j < readRet; j++)
+       {
+        a += _ioBuf[j];
+        b += a;
+       }
+      if(EVP_DigestUpdate(mdCtx, _ioBuf.data(), (size_t)readRet) != 1)
+       {
+        EVP_MD_CTX_free(mdCtx);
+        THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_UPDATE, OSSL_ERR_DESC);
+       }
+      offset += (uint64_t)readRet;
+     }
+
+    if(EVP_DigestFinal_ex(mdCtx, strong, NULL) != 1)
+     {
+      EVP_MD_CTX_free(mdCtx);
+      THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_FINAL, OSSL_ERR_DESC);
+     }
+    _sigs[_sigsDone].weak = (a & 0xffff) | (b << 16);
+    memcpy(_sigs[_sigsDone].strong, strong, FILE_DELTA_STRONG_SIZE);
+   }
+
+  EVP_MD_CTX_free(mdCtx);
+  return true;
+ }
+
+
+/**
+ * @brief  Returns whether the signatures of all the base's blocks have been computed
+ * @return Whether the signatures of all the base's blocks have been computed
+ */
+bool FileDelta::sigsComputed() const
+ { return _sigsDone == _numBlocks; }
+
+
+/**
+ * @brief  Returns the signatures of the base's blocks (valid once 'sigsComputed()' holds)
+ * @return The signatures of the base's blocks
+ */
+const DeltaBlockSig* FileDelta::getSigs() const
+ { return _sigs.data(); }
+
+
+/**
+ * @brief  Prepares to rebuild a file by applying the delta records to be received
+ * @param  outDscr    The descriptor of the file being rebuilt
+ * @param  targetSize The size of the file being rebuilt
+ * @throws ERR_OSSL_EVP_MD_CTX_NEW  EVP_MD context creation failed
+ * @throws ERR_OSSL_EVP_DIGEST_INIT EVP_MD digest initialization failed
+ */
+void FileDelta::startApply(FILE* outDscr, uint64_t targetSize)
+ {
+  _outDscr    = outDscr;
+  _targetSize = targetSize;
+  _outSize    = 0;
+  _recHdrLen  = 0;
+  _litRem     = 0;
+
+  _mdCtx = EVP_MD_CTX_new();
+  if(_mdCtx == nullptr)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_MD_CTX_NEW, OSSL_ERR_DESC);
+  if(EVP_DigestInit_ex(_mdCtx, EVP_sha256(), NULL) != 1)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_INIT, OSSL_ERR_DESC);
+ }
+
+
+/**
+ * @brief  Applies a piece of the delta to the file being rebuilt, where
+ *         records may span across the pieces the delta is received in
+ * @param  data The delta piece
+ * @param  len  The delta piece's length
+ * @throws ERR_SESSABORT_INVALID_FILE_DELTA Malformed delta record
+ * @throws ERR_FILE_READ_FAILED             Error in reading the base
+ * @throws ERR_FILE_WRITE_FAILED            Error in writing the file being rebuilt
+ * @throws ERR_OSSL_EVP_DIGEST_UPDATE       EVP_MD digest update failed
+ */
+void FileDelta::apply(const unsigned char* data, size_t len)
+ {
+  uint32_t field1;  // The first field of the parsed record's header
+  uint32_t field2;  // The second field of the parsed record's header
+  size_t   litLen;  // The number of the literal record's contents in the delta piece
+
+  while(len > 0)
+   {
+    // Contents of a literal record are written into the rebuilt file as they are
+    if(_litRem > 0)
+     {
+      litLen = std::min(len, (size_t)_litRem);
+      writeOutput(data, litLen);
+      data    += litLen;
+      len     -= litLen;
+      _litRem -= (uint32_t)litLen;
+      continue;
+     }
+
+    // Otherwise accumulate the next record's header
+    _recHdr[_recHdrLen++] = *data++;
+    len--;
+
+    switch(_recHdr[0])
+     {
+      case FILE_DELTA_REC_COPY:
+       if(_recHdrLen < FILE_DELTA_COPY_HDR_SIZE)
+        break;
+       memcpy(&field1, &_recHdr[1], sizeof(uint32_t));
+       memcpy(&field2, &_recHdr[1 + sizeof(uint32_t)], sizeof(uint32_t));
+       _recHdrLen = 0;
+       copyBlocks(field1, field2);
+       break;
+
+      case FILE_DELTA_REC_LITERAL:
+       if(_recHdrLen < FILE_DELTA_LITERAL_HDR_SIZE)
+        break;
+       memcpy(&field1, &_recHdr[1], sizeof(uint32_t));
+       _recHdrLen = 0;
+       if(field1 == 0 || field1 > FILE_DELTA_MAX_LITERAL)
+        THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_DELTA, "literal record of length " + std::to_string(field1));
+       _litRem = field1;
+       break;
+
+      default:
+       THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_DELTA, "record of type " + std::to_string(_recHdr[0]));
+     }
+   }
+ }
+
+
+/**
+ * @brief  Completes the rebuilding of a file once its whole delta has been applied
+ * @param  expDigest The expected digest of the file's contents
+ * @return Whether the delta ended on a record boundary and the rebuilt
+ *         file has the expected size and digest of its contents
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL EVP_MD digest final failed
+ */
+bool FileDelta::finishApply(const unsigned char* expDigest)
+ {
+  if(_recHdrLen != 0 || _litRem != 0 || _outSize != _targetSize)
+   return false;
+
+  if(EVP_DigestFinal_ex(_mdCtx, _digest, NULL) != 1)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_FINAL, OSSL_ERR_DESC);
+
+  return CRYPTO_memcmp(_digest, expDigest, FILE_DIGEST_SIZE) == 0;
+ }
+
+
+/* --------------------------- Client-side Methods --------------------------- */
+
+/**
+ * @brief Loads the signatures of the base's blocks received from the server, which
+ *        override the size and number of the blocks the base was divided into
+ * @param blockSize The size of the base's blocks
+ * @param numBlocks The number of the base's blocks
+ * @param sigs      The signatures of the base's blocks
+ */
+void FileDelta::loadSigs(uint32_t blockSize, uint32_t numBlocks, const DeltaBlockSig* sigs)
+ {
+  uint32_t tag;  // The tag of a block's weak checksum
+
+  _blockSize = blockSize;
+  _numBlocks = numBlocks;
+  _sigs.assign(sigs, sigs + numBlocks);
+
+  // Index the blocks by their weak checksums
+  _weakIndex.resize(numBlocks);
+  _weakTags.assign(65536 / 8, 0);
+  for(uint32_t i = 0; i < numBlocks; i++)
+   {
+    _weakIndex[i] = std::make_pair((uint32_t)_sigs[i].weak, i);
+    tag = weakTag(_sigs[i].weak);
+    _weakTags[tag >> 3] |= (uint8_t)(1 << (tag & 7));
+   }
+  std::sort(_weakIndex.begin(), _weakIndex.end());
+ }
+
+
+/**
+ * @brief  Encodes a file as a delta against the base into a delta file, also digesting its contents
+ * @param  srcFd     The file descriptor of the file to be encoded
+ * @param  srcSize   The size of the file to be encoded
+ * @param  deltaDscr The descriptor of the delta file
+ * @param  deltaSize Where to write the size of the delta
+ * @param  digest    Where to write the digest of the file's contents
+ * @return Whether the file has been encoded, or 'false' on errors in
+ *         mapping the file or writing the delta file (errno being set)
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL EVP_MD digest failed
+ */
+bool FileDelta::encode(int srcFd, uint64_t srcSize, FILE* deltaDscr, uint64_t& deltaSize, unsigned char* digest)
+ {
+  unsigned char* src;                // The memory mapping of the file being encoded
+  uint64_t       pos = 0;            // The offset of the window in the file
+  uint64_t       litStart = 0;       // The offset of the file's contents not yet encoded
+  bool           winSet = false;     // Whether the window's rolling checksum has been computed
+  uint32_t       weak = 0;           // The window's rolling checksum
+  uint32_t       a;                  // The window's sum of bytes
+  uint32_t       b;                  // The window's weighted sum of bytes
+  uint32_t       tag;                // The tag of the window's rolling checksum
+  uint32_t       block;              // The index of the block matching the window
+  uint32_t       runFirst = 0;       // The first block of the run of matched blocks not yet encoded
+  uint32_t       runLen = 0;         // The number of blocks in the run of matched blocks not yet encoded
+  bool           ok = true;          // Whether the delta records have been written
+  unsigned char  strong[EVP_MAX_MD_SIZE];
+
+  // The base's last block and its length, which may be shorter than the other blocks'
+  uint32_t lastBlock = _numBlocks - 1;
+  uint64_t lastLen   = _baseSize - (uint64_t)lastBlock * _blockSize;
+
+  deltaSize = 0;
+
+  src = (unsigned char*)mmap(nullptr, srcSize, PROT_READ, MAP_PRIVATE, srcFd, 0);
+  if(src == MAP_FAILED)
+   return false;
+  madvise(src, srcSize, MADV_SEQUENTIAL);
+
+  // Digest the file's contents, which the server verifies the rebuilt file against
+  if(EVP_Digest(src, srcSize, digest, NULL, EVP_sha256(), NULL) != 1)
+   {
+    munmap(src, srcSize);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_FINAL, OSSL_ERR_DESC);
+   }
+
+  // Slide a window of the size of the base's blocks over the file
+  while(ok && pos + _blockSize <= srcSize)
+   {
+    if(!winSet)
+     {
+      weak = rollingChecksum(src + pos, _blockSize);
+      winSet = true;
+     }
+
+    // If the window matches a block of the base, encode the file's contents preceding it
+    // as literal and extend the current run of matched blocks or start a new one
+    tag = weakTag(weak);
+    if((_weakTags[tag >> 3] & (1 << (tag & 7))) &&
+       findBlock(src + pos, weak, runLen != 0 && pos == litStart ? runFirst + runLen : _numBlocks, block))
+     {
+      if(pos > litStart)
+       {
+        if(runLen != 0)
+         ok = writeRecord(deltaDscr, FILE_DELTA_REC_COPY, runFirst, runLen, nullptr, deltaSize);
+        runLen = 0;
+        ok = ok && writeLiteral(deltaDscr, src + litStart, pos - litStart, deltaSize);
+       }
+      if(runLen != 0 && block == runFirst + runLen)
+       runLen++;
+      else
+       {
+        if(runLen != 0)
+         ok = ok && writeRecord(deltaDscr, FILE_DELTA_REC_COPY, runFirst, runLen, nullptr, deltaSize);
+        runFirst = block;
+        runLen   = 1;
+       }
+      pos += _blockSize;
+      litStart = pos;
+      winSet = false;
+      continue;
+     }
+
+    // Otherwise slide the window by one byte, updating its rolling checksum
+    if(pos + _blockSize < srcSize)
+     {
+      a = (weak - src[pos] + src[pos + _blockSize]) & 0xffff;
+      b = ((weak >> 16) - (uint32_t)((uint64_t)_blockSize * src[pos]) + a) & 0xffff;
+      weak = a | (b << 16);
+     }
+    pos++;
+   }
+
+  // The base's last block, if shorter than the others, may only match the file's end
+  if(ok && lastLen < _blockSize && srcSize >= litStart + lastLen &&
+     rollingChecksum(src + srcSize - lastLen, lastLen) == _sigs[lastBlock].weak)
+   {
+    if(EVP_Digest(src + srcSize - lastLen, lastLen, strong, NULL, EVP_sha256(), NULL) != 1)
+     {
+      munmap(src, srcSize);
+      THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_FINAL, OSSL_ERR_DESC);
+     }
+    if(memcmp(strong, _sigs[lastBlock].strong, FILE_DELTA_STRONG_SIZE) == 0)
+     {
+      if(srcSize - lastLen > litStart)
+       {
+        if(runLen != 0)
+         ok = writeRecord(deltaDscr, FILE_DELTA_REC_COPY, runFirst, runLen, nullptr, deltaSize);
+        runLen = 0;
+        ok = ok && writeLiteral(deltaDscr, src + litStart, srcSize - lastLen - litStart, deltaSize);
+       }
+      if(runLen != 0 && lastBlock == runFirst + runLen)
+       runLen++;
+      else
+       {
+        if(runLen != 0)
+         ok = ok && writeRecord(deltaDscr, FILE_DELTA_REC_COPY, runFirst, runLen, nullptr, deltaSize);
+        runFirst = lastBlock;
+        runLen   = 1;
+       }
+      litStart = srcSize;
+     }
+   }
+
+  // Encode the file's remaining contents as literal and the last run of matched blocks
+  if(ok && srcSize > litStart)
+   {
+    if(runLen != 0)
+     ok = writeRecord(deltaDscr, FILE_DELTA_REC_COPY, runFirst, runLen, nullptr, deltaSize);
+    runLen = 0;
+    ok = ok && writeLiteral(deltaDscr, src + litStart, srcSize - litStart, deltaSize);
+   }
+  if(ok && runLen != 0)
+   ok = writeRecord(deltaDscr, FILE_DELTA_REC_COPY, runFirst, runLen, nullptr, deltaSize);
+
+  munmap(src, srcSize);
+  return ok && fflush(deltaDscr) == 0;
+ }
\ No newline at end of file
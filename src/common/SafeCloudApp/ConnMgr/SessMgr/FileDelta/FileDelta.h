@@ -0,0 +1,295 @@
+#ifndef SAFECLOUD_FILEDELTA_H
+#define SAFECLOUD_FILEDELTA_H
+
+/*
+ * This class represents the delta of a file being uploaded against the copy of it held by the server (the
+ * "base"), which is used for uploading files that changed only slightly without transferring their whole
+ * contents again (see 'STSM_FEATURE_DELTA_UPLOADS') in an rsync-like fashion, where:
+ *
+ *   - The server divides its copy of the file into blocks and sends the client their signatures, each
+ *     consisting of a weak rolling checksum and a strong (truncated SHA-256) signature of the block,
+ *     which are computed in steps of FILE_DELTA_SIGS_STEP bytes so not to stall the server's main loop
+ *
+ *   - The client scans its file for windows matching a block's signatures, the rolling checksum allowing the
+ *     window to be slid by one byte in constant time, and encodes the file as a sequence of records that
+ *     either reference a run of consecutive blocks of the base or carry literal contents not found in it
+ *
+ *   - The server applies the records as they are received, rebuilding the file in the upload's
+ *     temporary file, and verifies the rebuilt file against the digest of its contents announced
+ *     by the client, which also catches any block matched on colliding signatures
+ *
+ * The delta records consist of a type byte followed by their fields in host byte order:
+ *
+ *   - COPY:    uint32_t firstBlock, uint32_t numBlocks   (the blocks' contents are copied from the base)
+ *   - LITERAL: uint32_t length, followed by its contents (1 <= length <= FILE_DELTA_MAX_LITERAL)
+ */
+
+/* ================================== INCLUDES ================================== */
+
+// System Headers
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+// OpenSSL Headers
+#include <openssl/evp.h>
+
+// SafeCloud Headers
+#include "defaults.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/SessMsg.h"
+
+
+// The delta records' types
+#define FILE_DELTA_REC_COPY    1
+#define FILE_DELTA_REC_LITERAL 2
+
+// The sizes of the delta records' headers
+#define FILE_DELTA_COPY_HDR_SIZE    (1 + 2 * sizeof(uint32_t))
+#define FILE_DELTA_LITERAL_HDR_SIZE (1 + sizeof(uint32_t))
+
+// The maximum length of a literal delta record
+#define FILE_DELTA_MAX_LITERAL (1024 * 1024)  // 1 MB
+
+// The size of the buffer the base is read through
+#define FILE_DELTA_IO_SIZE (1024 * 1024)  // 1 MB
+
+// The number of the base's bytes whose blocks are signed in each step of the signatures' computation
+#define FILE_DELTA_SIGS_STEP (1024 * 1024)  // 1 MB
+
+
+class FileDelta
+ {
+  private:
+
+   /* ================================= ATTRIBUTES ================================= */
+
+   // The base's file descriptor (server only, -1 = none)
+   int _baseFd;
+
+   // The base's size and the size and number of the blocks it is divided into
+   uint64_t _baseSize;
+   uint32_t _blockSize;
+   uint32_t _numBlocks;
+
+   // The number of the base's blocks whose signatures have been computed (server only)
+   uint32_t _sigsDone;
+
+   /* ----------------------------- Delta Encoding ----------------------------- */
+
+   // The signatures of the base's blocks (computed by the server or received by the client) and their
+   // (weak checksum, block index) pairs sorted by weak checksum, with a bitmap of the 16-bit tags of
+   // their weak checksums rejecting most windows at once
+   std::vector<DeltaBlockSig>                 _sigs;
+   std::vector<std::pair<uint32_t, uint32_t>> _weakIndex;
+   std::vector<uint8_t>                       _weakTags;
+
+   /* ----------------------------- Delta Applying ----------------------------- */
+
+   FILE*         _outDscr;                            // The descriptor of the file being rebuilt
+   uint64_t      _targetSize;                         // The size of the file being rebuilt
+   uint64_t      _outSize;                            // The number of the file's bytes rebuilt so far
+   EVP_MD_CTX*   _mdCtx;                              // The digest context of the file being rebuilt
+   unsigned char _recHdr[FILE_DELTA_COPY_HDR_SIZE];   // The header of the record being parsed
+   unsigned int  _recHdrLen;                          // The number of the header's bytes received so far
+   uint32_t      _litRem;                             // The bytes of the literal record being parsed yet to be received
+   std::vector<unsigned char> _ioBuf;                 // The buffer the base is read through
+   unsigned char _digest[FILE_DIGEST_SIZE];           // The digest of the rebuilt file
+
+   /* =============================== PRIVATE METHODS =============================== */
+
+   /**
+    * @brief  Returns the rolling checksum of a block of data, consisting of the sum of its bytes (low 16 bits)
+    *         and the sum of its bytes weighted by their distance from the block's end (high 16 bits)
+    * @param  data The block's data
+    * @param  len  The block's length
+    * @return The block's rolling checksum
+    */
+   static uint32_t rollingChecksum(const unsigned char* data, size_t len);
+
+   /**
+    * @brief  Returns the 16-bit tag of a weak checksum indexing the bitmap of the base's weak checksums
+    * @param  weak The weak checksum
+    * @return The weak checksum's tag
+    */
+   static uint32_t weakTag(uint32_t weak);
+
+   /**
+    * @brief  Looks for a block of the base whose signatures match a window of the file being encoded,
+    *         preferring the block following the last one matched so that their references are merged
+    * @param  window    The window's data (of the size of the base's blocks)
+    * @param  weak      The window's rolling checksum
+    * @param  prefBlock The index of the block that is preferred if matching
+    * @param  block     Where to write the index of the matching block
+    * @return Whether a block matching the window was found
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL EVP_MD digest failed
+    */
+   bool findBlock(const unsigned char* window, uint32_t weak, uint32_t prefBlock, uint32_t& block) const;
+
+   /**
+    * @brief  Writes a record of the delta being encoded into its file
+    * @param  deltaDscr The descriptor of the delta file
+    * @param  type      The record's type
+    * @param  field1    The record's first field (COPY: firstBlock, LITERAL: length)
+    * @param  field2    The record's second field (COPY: numBlocks, LITERAL: unused)
+    * @param  data      The literal record's contents (nullptr for COPY records)
+    * @param  deltaSize The size of the delta written so far, which is updated
+    * @return Whether the record has been written
+    */
+   static bool writeRecord(FILE* deltaDscr, uint8_t type, uint32_t field1, uint32_t field2,
+                           const unsigned char* data, uint64_t& deltaSize);
+
+   /**
+    * @brief  Writes literal contents of the file being encoded into the delta file,
+    *         split into records of up to FILE_DELTA_MAX_LITERAL bytes
+    * @param  deltaDscr The descriptor of the delta file
+    * @param  data      The literal contents
+    * @param  len       The literal contents' length
+    * @param  deltaSize The size of the delta written so far, which is updated
+    * @return Whether the literal contents have been written
+    */
+   static bool writeLiteral(FILE* deltaDscr, const unsigned char* data, uint64_t len, uint64_t& deltaSize);
+
+   /**
+    * @brief  Writes contents of the file being rebuilt into its descriptor, updating its digest
+    * @param  data The contents
+    * @param  len  The contents' length
+    * @throws ERR_SESSABORT_INVALID_FILE_DELTA The contents exceed the size of the file being rebuilt
+    * @throws ERR_FILE_WRITE_FAILED            Error in writing the file being rebuilt
+    * @throws ERR_OSSL_EVP_DIGEST_UPDATE       EVP_MD digest update failed
+    */
+   void writeOutput(const unsigned char* data, size_t len);
+
+   /**
+    * @brief  Copies a run of consecutive blocks of the base into the file being rebuilt
+    * @param  firstBlock The index of the run's first block
+    * @param  numBlocks  The number of blocks in the run
+    * @throws ERR_SESSABORT_INVALID_FILE_DELTA The run is out of the base's blocks or its contents
+    *                                          exceed the size of the file being rebuilt
+    * @throws ERR_FILE_READ_FAILED             Error in reading the base
+    * @throws ERR_FILE_WRITE_FAILED            Error in writing the file being rebuilt
+    * @throws ERR_OSSL_EVP_DIGEST_UPDATE       EVP_MD digest update failed
+    */
+   void copyBlocks(uint32_t firstBlock, uint32_t numBlocks);
+
+  public:
+
+   /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+   /**
+    * @brief FileDelta object constructor, dividing the base into blocks whose size is the square root of the
+    *        base's size (rounded up to a KB multiple), but not smaller than FILE_DELTA_MIN_BLOCK nor yielding
+    *        more than FILE_DELTA_MAX_BLOCKS blocks
+    * @param baseFd   The base's file descriptor, of which the object takes ownership (server only, -1 = none)
+    * @param baseSize The base's size
+    */
+   FileDelta(int baseFd, uint64_t baseSize);
+
+   /**
+    * @brief FileDelta object destructor, closing the base's file descriptor
+    *        and freeing the digest context of the file being rebuilt
+    */
+   ~FileDelta();
+
+   /* ============================ OTHER PUBLIC METHODS ============================ */
+
+   /**
+    * @brief  Returns the size of the base's blocks
+    * @return The size of the base's blocks
+    */
+   uint32_t getBlockSize() const;
+
+   /**
+    * @brief  Returns the number of the base's blocks
+    * @return The number of the base's blocks
+    */
+   uint32_t getNumBlocks() const;
+
+   /**
+    * @brief  Returns the digest of the rebuilt file's contents (valid after 'finishApply()' succeeded)
+    * @return The digest of the rebuilt file's contents
+    */
+   const unsigned char* getDigest() const;
+
+   /* --------------------------- Server-side Methods --------------------------- */
+
+   /**
+    * @brief  Computes the signatures of the base's next blocks not yet signed, spanning FILE_DELTA_SIGS_STEP
+    *         bytes (or at least one block), so that the base is signed incrementally across multiple calls
+    * @return Whether the step has been computed, or 'false' on errors in reading the base
+    * @throws ERR_OSSL_EVP_MD_CTX_NEW    EVP_MD context creation failed
+    * @throws ERR_OSSL_EVP_DIGEST_INIT   EVP_MD digest initialization failed
+    * @throws ERR_OSSL_EVP_DIGEST_UPDATE EVP_MD digest update failed
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL  EVP_MD digest final failed
+    */
+   bool computeSigsStep();
+
+   /**
+    * @brief  Returns whether the signatures of all the base's blocks have been computed
+    * @return Whether the signatures of all the base's blocks have been computed
+    */
+   bool sigsComputed() const;
+
+   /**
+    * @brief  Returns the signatures of the base's blocks (valid once 'sigsComputed()' holds)
+    * @return The signatures of the base's blocks
+    */
+   const DeltaBlockSig* getSigs() const;
+
+   /**
+    * @brief  Prepares to rebuild a file by applying the delta records to be received
+    * @param  outDscr    The descriptor of the file being rebuilt
+    * @param  targetSize The size of the file being rebuilt
+    * @throws ERR_OSSL_EVP_MD_CTX_NEW  EVP_MD context creation failed
+    * @throws ERR_OSSL_EVP_DIGEST_INIT EVP_MD digest initialization failed
+    */
+   void startApply(FILE* outDscr, uint64_t targetSize);
+
+   /**
+    * @brief  Applies a piece of the delta to the file being rebuilt, where
+    *         records may span across the pieces the delta is received in
+    * @param  data The delta piece
+    * @param  len  The delta piece's length
+    * @throws ERR_SESSABORT_INVALID_FILE_DELTA Malformed delta record
+    * @throws ERR_FILE_READ_FAILED             Error in reading the base
+    * @throws ERR_FILE_WRITE_FAILED            Error in writing the file being rebuilt
+    * @throws ERR_OSSL_EVP_DIGEST_UPDATE       EVP_MD digest update failed
+    */
+   void apply(const unsigned char* data, size_t len);
+
+   /**
+    * @brief  Completes the rebuilding of a file once its whole delta has been applied
+    * @param  expDigest The expected digest of the file's contents
+    * @return Whether the delta ended on a record boundary and the rebuilt
+    *         file has the expected size and digest of its contents
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL EVP_MD digest final failed
+    */
+   bool finishApply(const unsigned char* expDigest);
+
+   /* --------------------------- Client-side Methods --------------------------- */
+
+   /**
+    * @brief Loads the signatures of the base's blocks received from the server, which
+    *        override the size and number of the blocks the base was divided into
+    * @param blockSize The size of the base's blocks
+    * @param numBlocks The number of the base's blocks
+    * @param sigs      The signatures of the base's blocks
+    */
+   void loadSigs(uint32_t blockSize, uint32_t numBlocks, const DeltaBlockSig* sigs);
+
+   /**
+    * @brief  Encodes a file as a delta against the base into a delta file, also digesting its contents
+    * @param  srcFd     The file descriptor of the file to be encoded
+    * @param  srcSize   The size of the file to be encoded
+    * @param  deltaDscr The descriptor of the delta file
+    * @param  deltaSize Where to write the size of the delta
+    * @param  digest    Where to write the digest of the file's contents
+    * @return Whether the file has been encoded, or 'false' on errors in
+    *         mapping the file or writing the delta file (errno being set)
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL EVP_MD digest failed
+    */
+   bool encode(int srcFd, uint64_t srcSize, FILE* deltaDscr, uint64_t& deltaSize, unsigned char* digest);
+ };
+
+
+#endif //SAFECLOUD_FILEDELTA_H
\ No newline at end of file
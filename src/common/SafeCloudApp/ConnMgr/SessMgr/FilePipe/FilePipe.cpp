@@ -0,0 +1,150 @@
+/* File Segments Pipeline Definitions */
+
+/* ================================== INCLUDES ================================== */
+
+// OpenSSL Headers
+#include <openssl/crypto.h>
+
+// SafeCloud Headers
+#include "FilePipe.h"
+
+
+/* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+/**
+ * @brief FilePipe object constructor, allocating the slots' buffers
+ *        and making all slots available to the pipeline's first stage
+ * @param numStages The number of stages in the pipeline
+ * @param numSlots  The number of slots in the pipeline
+ * @param ptBufSize The size of each slot's plaintext buffer
+ * @param ctBufSize The size of each slot's ciphertext buffer
+ */
+FilePipe::FilePipe(unsigned int numStages, unsigned int numSlots, unsigned int ptBufSize, unsigned int ctBufSize)
+ : _slots(numSlots), _ptBufSize(ptBufSize), _ctBufSize(ctBufSize),
+   _stageQueues(numStages), _pipeMutex(), _pipeCond(), _aborted(false), _abortExcp()
+ {
+  for(unsigned int i = 0; i < numSlots; i++)
+   {
+    // Allocate the slot's plaintext and ciphertext buffers
+    _slots[i].ptBuf    = new unsigned char[_ptBufSize];
+    _slots[i].ptSize   = 0;
+    _slots[i].ctBuf    = new unsigned char[_ctBufSize];
+    _slots[i].ctSize   = 0;
+    _slots[i].streamId = 0;
+
+    // Make the slot available to the pipeline's first stage
+    _stageQueues[0].push_back(i);
+   }
+ }
+
+
+/**
+ * @brief FilePipe object destructor, safely erasing and freeing the slots' buffers
+ */
+FilePipe::~FilePipe()
+ {
+  for(auto& slot : _slots)
+   {
+    OPENSSL_cleanse(slot.ptBuf, _ptBufSize);
+    OPENSSL_cleanse(slot.ctBuf, _ctBufSize);
+    delete[] slot.ptBuf;
+    delete[] slot.ctBuf;
+   }
+ }
+
+
+/* ============================ OTHER PUBLIC METHODS ============================ */
+
+/**
+ * @brief  Blocks until a slot is available to a stage and takes it
+ * @param  stage   The stage taking the slot
+ * @param  slotIdx The index of the taken slot
+ * @return 'true' if a slot was taken or 'false' if the pipeline was aborted
+ */
+bool FilePipe::takeSlot(unsigned int stage, unsigned int& slotIdx)
+ {
+  std::unique_lock<std::mutex> pipeLock(_pipeMutex);
+
+  // Wait for a slot to be available to the stage or for the pipeline to be aborted
+  _pipeCond.wait(pipeLock, [&]{ return _aborted || !_stageQueues[stage].empty(); });
+
+  if(_aborted)
+   return false;
+
+  // Take the first slot that was passed to the stage
+  slotIdx = _stageQueues[stage].front();
+  _stageQueues[stage].pop_front();
+  return true;
+ }
+
+
+/**
+ * @brief  Takes a slot available to a stage, if any, without blocking
+ * @param  stage   The stage taking the slot
+ * @param  slotIdx The index of the taken slot
+ * @return 'true' if a slot was taken or 'false' if no slot is
+ *         available to the stage or the pipeline was aborted
+ */
+bool FilePipe::tryTakeSlot(unsigned int stage, unsigned int& slotIdx)
+ {
+  std::lock_guard<std::mutex> pipeLock(_pipeMutex);
+
+  if(_aborted || _stageQueues[stage].empty())
+   return false;
+
+  // Take the first slot that was passed to the stage
+  slotIdx = _stageQueues[stage].front();
+  _stageQueues[stage].pop_front();
+  return true;
+ }
+
+
+/**
+ * @brief Passes a slot from a stage to the following one (or from the last stage to the first)
+ * @param stage   The stage passing the slot
+ * @param slotIdx The index of the passed slot
+ */
+void FilePipe::passSlot(unsigned int stage, unsigned int slotIdx)
+ {
+  std::lock_guard<std::mutex> pipeLock(_pipeMutex);
+  _stageQueues[(stage + 1) % _stageQueues.size()].push_back(slotIdx);
+  _pipeCond.notify_all();
+ }
+
+
+/**
+ * @brief Aborts the pipeline, waking up all stages waiting for a slot and
+ *        storing the exception that caused the abort, if the first one
+ * @param abortExcp The exception that caused the abort
+ */
+void FilePipe::abort(std::exception_ptr abortExcp)
+ {
+  std::lock_guard<std::mutex> pipeLock(_pipeMutex);
+  if(!_aborted)
+   {
+    _aborted = true;
+    _abortExcp = abortExcp;
+   }
+  _pipeCond.notify_all();
+ }
+
+
+/**
+ * @brief  Rethrows the exception that caused the pipeline to be aborted, if any
+ * @throws The exception that caused the pipeline to be aborted
+ */
+void FilePipe::rethrowAbortExcp()
+ {
+  std::lock_guard<std::mutex> pipeLock(_pipeMutex);
+  if(_abortExcp)
+   std::rethrow_exception(_abortExcp);
+ }
+
+
+/**
+ * @brief  Returns a reference to a pipeline slot
+ * @param  slotIdx The index of the slot
+ * @return A reference to the pipeline slot
+ */
+FilePipe::Slot& FilePipe::getSlot(unsigned int slotIdx)
+ { return _slots[slotIdx]; }
@@ -0,0 +1,132 @@
+#ifndef SAFECLOUD_FILEPIPE_H
+#define SAFECLOUD_FILEPIPE_H
+
+/*
+ * This class represents a file segments pipeline, consisting of a ring of slots, each holding a file segment's
+ * plaintext and ciphertext buffers, that are passed in order through a fixed number of stages, each executed by
+ * a different thread (e.g. read from disk -> encrypt -> send), with the last stage returning its slots to the
+ * first, allowing the stages to operate concurrently on different segments of the same file
+ */
+
+/* ================================== INCLUDES ================================== */
+
+// System Headers
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <deque>
+#include <vector>
+#include <cstdint>
+
+
+// The default number of slots in a file segments pipeline
+// (one for each stage of a read/encrypt/send pipeline)
+#define FILE_PIPE_SLOTS 3
+
+
+class FilePipe
+ {
+  public:
+
+   /* ============================== TYPE DEFINITIONS ============================== */
+
+   // A file segments pipeline slot
+   struct Slot
+    {
+     unsigned char* ptBuf;     // The segment's plaintext buffer
+     unsigned int   ptSize;    // The segment's plaintext size
+     unsigned char* ctBuf;     // The segment's ciphertext buffer (chunks' ciphertexts and tags)
+     unsigned int   ctSize;    // The segment's ciphertext size
+     unsigned char  streamId;  // The identifier of the session stream the segment belongs to
+     uint32_t       keyEpoch;  // The epoch of the key the segment's chunks are encrypted with
+    };
+
+  private:
+
+   /* ================================= ATTRIBUTES ================================= */
+
+   // The pipeline slots and the size of their plaintext and ciphertext buffers
+   std::vector<Slot> _slots;
+   const unsigned int _ptBufSize;
+   const unsigned int _ctBufSize;
+
+   // The indexes of the slots ready to be taken by each
+   // stage, in the order they were passed to the stage
+   std::vector<std::deque<unsigned int>> _stageQueues;
+
+   // Mutex and condition variable protecting the stages' queues
+   std::mutex              _pipeMutex;
+   std::condition_variable _pipeCond;
+
+   // Whether the pipeline was aborted and the exception that caused it
+   bool               _aborted;
+   std::exception_ptr _abortExcp;
+
+  public:
+
+   /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+   /**
+    * @brief FilePipe object constructor, allocating the slots' buffers
+    *        and making all slots available to the pipeline's first stage
+    * @param numStages The number of stages in the pipeline
+    * @param numSlots  The number of slots in the pipeline
+    * @param ptBufSize The size of each slot's plaintext buffer
+    * @param ctBufSize The size of each slot's ciphertext buffer
+    */
+   FilePipe(unsigned int numStages, unsigned int numSlots, unsigned int ptBufSize, unsigned int ctBufSize);
+
+   /**
+    * @brief FilePipe object destructor, safely erasing and freeing the slots' buffers
+    */
+   ~FilePipe();
+
+   /* ============================ OTHER PUBLIC METHODS ============================ */
+
+   /**
+    * @brief  Blocks until a slot is available to a stage and takes it
+    * @param  stage   The stage taking the slot
+    * @param  slotIdx The index of the taken slot
+    * @return 'true' if a slot was taken or 'false' if the pipeline was aborted
+    */
+   bool takeSlot(unsigned int stage, unsigned int& slotIdx);
+
+   /**
+    * @brief  Takes a slot available to a stage, if any, without blocking
+    * @param  stage   The stage taking the slot
+    * @param  slotIdx The index of the taken slot
+    * @return 'true' if a slot was taken or 'false' if no slot is
+    *         available to the stage or the pipeline was aborted
+    */
+   bool tryTakeSlot(unsigned int stage, unsigned int& slotIdx);
+
+   /**
+    * @brief Passes a slot from a stage to the following one (or from the last stage to the first)
+    * @param stage   The stage passing the slot
+    * @param slotIdx The index of the passed slot
+    */
+   void passSlot(unsigned int stage, unsigned int slotIdx);
+
+   /**
+    * @brief Aborts the pipeline, waking up all stages waiting for a slot and
+    *        storing the exception that caused the abort, if the first one
+    * @param abortExcp The exception that caused the abort
+    */
+   void abort(std::exception_ptr abortExcp);
+
+   /**
+    * @brief  Rethrows the exception that caused the pipeline to be aborted, if any
+    * @throws The exception that caused the pipeline to be aborted
+    */
+   void rethrowAbortExcp();
+
+   /**
+    * @brief  Returns a reference to a pipeline slot
+    * @param  slotIdx The index of the slot
+    * @return A reference to the pipeline slot
+    */
+   Slot& getSlot(unsigned int slotIdx);
+ };
+
+
+#endif //SAFECLOUD_FILEPIPE_H
@@ -0,0 +1,104 @@
+/* SafeCloud Session Key Definitions */
+
+/* ================================== INCLUDES ================================== */
+
+// System Headers
+#include <cstring>
+
+// OpenSSL Headers
+#include <openssl/kdf.h>
+
+// SafeCloud Headers
+#include "SessKey.h"
+#include "errCodes/execErrCodes/execErrCodes.h"
+
+/* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+/**
+ * @brief SessKey object constructor, initializing the key to the session key (epoch 0)
+ * @param skey       The session key established in the STSM handshake (32 bytes)
+ * @param srvToCli   Whether the key protects the server -> client direction
+ * @param fileChunks Whether the key protects the file chunks rather than the session messages
+ */
+SessKey::SessKey(const unsigned char* skey, bool srvToCli, bool fileChunks)
+ : key(), epoch(0), label(fileChunks ? (srvToCli ? SESS_CHUNK_KEY_LABEL_SRV_TO_CLI : SESS_CHUNK_KEY_LABEL_CLI_TO_SRV)
+                                     : (srvToCli ? SESS_KEY_LABEL_SRV_TO_CLI : SESS_KEY_LABEL_CLI_TO_SRV))
+ { memcpy(key, skey, AEAD_KEY_MAX_SIZE); }
+
+
+/**
+ * @brief SessKey object destructor, safely deleting the key value
+ */
+SessKey::~SessKey()
+ { OPENSSL_cleanse(&key[0], AEAD_KEY_MAX_SIZE); }
+
+
+/* ============================ OTHER PUBLIC METHODS ============================ */
+
+/**
+ * @brief  Ratchets the key into the key of its next epoch, also setting
+ *         the nonce base of the next epoch in the provided IV, if any
+ * @param  iv The IV whose constant and variable parts are to be set to
+ *            the nonce base of the next epoch (nullptr if not required)
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+ */
+void SessKey::ratchet(IV* iv)
+ {
+  // The HKDF output, consisting of the next epoch's key followed by its nonce base
+  unsigned char hkdfOut[AEAD_KEY_MAX_SIZE + sizeof(uint32_t) + sizeof(uint64_t)];
+  size_t hkdfOutSize = sizeof(hkdfOut);
+
+  // Create the HKDF key derivation context
+  EVP_PKEY_CTX* hkdfCTX = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, NULL);
+  if(!hkdfCTX)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_CTX_NEW, OSSL_ERR_DESC);
+
+  // Initialize the key derivation with SHA-256, the current key as input
+  // keying material (with no salt) and the key's direction and traffic label as info
+  if(EVP_PKEY_derive_init(hkdfCTX) <= 0 || EVP_PKEY_CTX_set_hkdf_md(hkdfCTX, EVP_sha256()) <= 0 ||
+     EVP_PKEY_CTX_set1_hkdf_key(hkdfCTX, key, AEAD_KEY_MAX_SIZE) <= 0 ||
+     EVP_PKEY_CTX_add1_hkdf_info(hkdfCTX, reinterpret_cast<const unsigned char*>(label), (int)strlen(label)) <= 0)
+   {
+    EVP_PKEY_CTX_free(hkdfCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_DERIVE_INIT, OSSL_ERR_DESC);
+   }
+
+  // Derive the next epoch's key and nonce base
+  if(EVP_PKEY_derive(hkdfCTX, hkdfOut, &hkdfOutSize) <= 0)
+   {
+    EVP_PKEY_CTX_free(hkdfCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_DERIVE, OSSL_ERR_DESC);
+   }
+  EVP_PKEY_CTX_free(hkdfCTX);
+
+  // Replace the current key with the next epoch's key
+  memcpy(key, &hkdfOut[0], AEAD_KEY_MAX_SIZE);
+  epoch++;
+
+  // If provided, set the IV's constant and variable parts to the next epoch's nonce base
+  if(iv != nullptr)
+   {
+    memcpy(&iv->iv_AES_GCM, &hkdfOut[AEAD_KEY_MAX_SIZE], sizeof(uint32_t));
+    memcpy(&iv->iv_var, &hkdfOut[AEAD_KEY_MAX_SIZE + sizeof(uint32_t)], sizeof(uint64_t));
+    iv->iv_var_start = iv->iv_var;
+   }
+
+  // Securely erase the HKDF output
+  OPENSSL_cleanse(&hkdfOut[0], sizeof(hkdfOut));
+ }
+
+
+/**
+ * @brief  Ratchets the key up to a following epoch
+ * @param  toEpoch The epoch the key should be ratcheted to (>= the current epoch)
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+ */
+void SessKey::ratchetTo(uint32_t toEpoch)
+ {
+  while(epoch < toEpoch)
+   ratchet(nullptr);
+ }
@@ -0,0 +1,88 @@
+#ifndef SAFECLOUD_SESSKEY_H
+#define SAFECLOUD_SESSKEY_H
+
+/*
+ * This class represents the key protecting the session messages or the file chunks sent in a direction
+ * of a session, which is periodically ratcheted into the key of its next epoch, where:
+ *
+ *   - Epoch 0 uses the session key established in the STSM handshake
+ *
+ *   - The key of an epoch and its nonce base (the IV's constant and starting variable parts) are
+ *     derived via HKDF-SHA256 from the key of the previous epoch and a label identifying the direction
+ *     and whether the key protects the session messages or the file chunks, so that the keys of the two
+ *     directions and of the two kinds of traffic diverge from their first ratchet (where in epoch 0 the
+ *     session messages' and file chunks' IVs are disjoint by construction, see the IV channels), as
+ *     the session messages' nonce base is no longer derived from the connection's IV past it
+ *
+ *   - Being the derivation one-way, the compromise of a key does not expose
+ *     the traffic protected with the keys of the previous epochs
+ */
+
+/* ================================== INCLUDES ================================== */
+#include "ossl_crypto/AEAD.h"
+#include "SafeCloudApp/ConnMgr/IV/IV.h"
+
+// The HKDF labels of the session messages' keys of the client -> server and server -> client directions
+#define SESS_KEY_LABEL_CLI_TO_SRV "SafeCloud rekey client->server"
+#define SESS_KEY_LABEL_SRV_TO_CLI "SafeCloud rekey server->client"
+
+// The HKDF labels of the file chunks' keys of the client -> server and server -> client directions
+#define SESS_CHUNK_KEY_LABEL_CLI_TO_SRV "SafeCloud chunks client->server"
+#define SESS_CHUNK_KEY_LABEL_SRV_TO_CLI "SafeCloud chunks server->client"
+
+
+class SessKey
+ {
+  public:
+
+   /* ================================= ATTRIBUTES ================================= */
+
+   // The key of the current epoch (AEAD_KEY_MAX_SIZE = 32 bytes)
+   unsigned char key[AEAD_KEY_MAX_SIZE];
+
+   // The current epoch of the key (0 = session key)
+   uint32_t epoch;
+
+   // The HKDF label of the key's direction and traffic
+   const char* label;
+
+   /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+   /**
+    * @brief SessKey object constructor, initializing the key to the session key (epoch 0)
+    * @param skey       The session key established in the STSM handshake (32 bytes)
+    * @param srvToCli   Whether the key protects the server -> client direction
+    * @param fileChunks Whether the key protects the file chunks rather than the session messages
+    */
+   SessKey(const unsigned char* skey, bool srvToCli, bool fileChunks);
+
+   /**
+    * @brief SessKey object destructor, safely deleting the key value
+    */
+   ~SessKey();
+
+   /* ============================ OTHER PUBLIC METHODS ============================ */
+
+   /**
+    * @brief  Ratchets the key into the key of its next epoch, also setting
+    *         the nonce base of the next epoch in the provided IV, if any
+    * @param  iv The IV whose constant and variable parts are to be set to
+    *            the nonce base of the next epoch (nullptr if not required)
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+    */
+   void ratchet(IV* iv);
+
+   /**
+    * @brief  Ratchets the key up to a following epoch
+    * @param  toEpoch The epoch the key should be ratcheted to (>= the current epoch)
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+    */
+   void ratchetTo(uint32_t toEpoch);
+ };
+
+
+#endif //SAFECLOUD_SESSKEY_H
@@ -4,11 +4,16 @@
 
 // System Headers
 #include <sys/time.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <fstream>
 #include <cstring>
+#include <algorithm>
+#include <zlib.h>
 
 // SafeCloud Headers
 #include "SessMgr.h"
+#include "SessStream/SessStream.h"
 #include "errCodes/errCodes.h"
 #include "errCodes/execErrCodes/execErrCodes.h"
 #include "errCodes/sessErrCodes/sessErrCodes.h"
@@ -31,7 +36,9 @@ bool SessMgr::isSessSignalingMsgType(SessMsgType sessMsgType)
   // type, as there are less payload than signaling session message types
   if(sessMsgType == FILE_UPLOAD_REQ || sessMsgType == FILE_DOWNLOAD_REQ ||
      sessMsgType == FILE_DELETE_REQ || sessMsgType == FILE_RENAME_REQ ||
-     sessMsgType == FILE_EXISTS || sessMsgType == POOL_SIZE)
+     sessMsgType == FILE_EXISTS || sessMsgType == POOL_SIZE || sessMsgType == FILE_SEGMENT ||
+     sessMsgType == UPLOAD_RESUME || sessMsgType == DOWNLOAD_RANGE || sessMsgType == UPLOAD_DIGEST ||
+     sessMsgType == DELTA_SIGNATURES || sessMsgType == UPLOAD_DELTA)
    return false;
   return true;
  }
@@ -46,7 +53,8 @@ bool SessMgr::isSessSignalingMsgType(SessMsgType sessMsgType)
 bool SessMgr::isSessErrSignalingMsgType(SessMsgType sessMsgType)
  {
   if(sessMsgType == ERR_INTERNAL_ERROR || sessMsgType == ERR_UNEXPECTED_SESS_MESSAGE ||
-     sessMsgType == ERR_MALFORMED_SESS_MESSAGE || sessMsgType == ERR_UNKNOWN_SESSMSG_TYPE)
+     sessMsgType == ERR_MALFORMED_SESS_MESSAGE || sessMsgType == ERR_NO_SPACE ||
+     sessMsgType == ERR_UNKNOWN_SESSMSG_TYPE)
    return true;
   return false;
  }
@@ -60,7 +68,7 @@ bool SessMgr::isSessErrSignalingMsgType(SessMsgType sessMsgType)
  */
 std::string SessMgr::sessMgrOpToStrLowCase()
  {
-  switch(_sessMgrOp)
+  switch(_stream->op)
    {
     case IDLE:
      return "idle";
@@ -85,7 +93,7 @@ std::string SessMgr::sessMgrOpToStrLowCase()
  */
 std::string SessMgr::sessMgrOpToStrUpCase()
  {
-  switch(_sessMgrOp)
+  switch(_stream->op)
    {
     case IDLE:
      return "'IDLE'";
@@ -111,7 +119,7 @@ std::string SessMgr::sessMgrOpToStrUpCase()
  */
 std::string SessMgr::sessMgrOpStepToStrUpCase()
  {
-  switch(_sessMgrOpStep)
+  switch(_stream->opStep)
    {
     case OP_START:
      return "'OP_START'";
@@ -119,10 +127,20 @@ std::string SessMgr::sessMgrOpStepToStrUpCase()
      return "'WAITING_RESP'";
     case WAITING_CONF:
      return "'WAITING_CONF'";
+    case SIGNING_BASE:
+     return "'SIGNING_BASE'";
     case WAITING_RAW:
      return "'WAITING_RAW'";
+    case SENDING_RAW:
+     return "'SENDING_RAW'";
     case WAITING_COMPL:
      return "'WAITING_COMPL'";
+    case WAITING_COMMIT:
+     return "'WAITING_COMMIT'";
+    case COMMITTED:
+     return "'COMMITTED'";
+    case COMMIT_FAILED:
+     return "'COMMIT_FAILED'";
    }
  }
 
@@ -135,7 +153,7 @@ std::string SessMgr::sessMgrOpStepToStrUpCase()
  */
 std::string SessMgr::abortedOpToStr()
  {
-  if(_sessMgrOp != IDLE)
+  if(_stream->op != IDLE)
    return sessMgrOpToStrLowCase() + " operation aborted";
   else
    return "no operation was aborted";
@@ -169,25 +187,25 @@ void SessMgr::validateRecvFileName(std::string& fileName)
 
 
 /**
- * @brief Attempts to load into the '_mainFileInfo' attribute the information
- *        of the main file referred by the '_mainFileAbsPath' attribute
- * @throws ERR_SESS_INTERNAL_ERROR   The '_mainFileAbsPath' attribute has not been initialized
+ * @brief Attempts to load into the 'mainFileInfo' attribute the information
+ *        of the main file referred by the 'mainFileAbsPath' attribute
+ * @throws ERR_SESS_INTERNAL_ERROR   The 'mainFileAbsPath' attribute has not been initialized
  * @throws ERR_SESS_MAIN_FILE_IS_DIR The main file was found to be a directory (!)
  */
 void SessMgr::checkLoadMainFileInfo()
  {
-  // Ensure the '_mainFileAbsPath' attribute to have been initialized
-  if(_mainFileAbsPath == nullptr)
+  // Ensure the 'mainFileAbsPath' attribute to have been initialized
+  if(_stream->mainFileAbsPath == nullptr)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
     THROW_SESS_EXCP(ERR_SESS_INTERNAL_ERROR,"Attempting to load the main file "
-                                            "information time with a NULL '_mainFileAbsPath'");
+                                            "information time with a NULL 'mainFileAbsPath'");
    }
 
-  // Attempt to load into the '_mainFileInfo' attribute the information
-  // of the main file referred by the '_mainFileAbsPath' attribute
+  // Attempt to load into the 'mainFileInfo' attribute the information
+  // of the main file referred by the 'mainFileAbsPath' attribute
   try
-   { _mainFileInfo = new FileInfo(*_mainFileAbsPath); }
+   { _stream->mainFileInfo = new FileInfo(*_stream->mainFileAbsPath); }
 
   // If the main file information could not be loaded
   catch(sessErrExcp& mainFileError)
@@ -204,58 +222,58 @@ void SessMgr::checkLoadMainFileInfo()
     if(mainFileError.sesErrCode == ERR_SESS_FILE_IS_DIR)
      {
       sendSessSignalMsg(ERR_INTERNAL_ERROR);
-      THROW_SESS_EXCP(ERR_SESS_MAIN_FILE_IS_DIR, *_mainFileAbsPath);
+      THROW_SESS_EXCP(ERR_SESS_MAIN_FILE_IS_DIR, *_stream->mainFileAbsPath);
      }
 
     // Otherwise the main file was not found in the session's main directory
-    _mainFileInfo = nullptr;
+    _stream->mainFileInfo = nullptr;
    }
  }
 
 
 /**
  * @brief  Sets the main file last modification time to
- *         the one specified in the '_remFileInfo' attribute
- * @throws ERR_SESS_INTERNAL_ERROR       NULL '_mainFileAbsPath' or '_remFileInfo' attributes
+ *         the one specified in the 'remFileInfo' attribute
+ * @throws ERR_SESS_INTERNAL_ERROR       NULL 'mainFileAbsPath' or 'remFileInfo' attributes
  * @throws ERR_SESS_FILE_META_SET_FAILED Error in setting the main file's metadata
  */
 void SessMgr::mainToRemLastModTime()
  {
-  // Ensure the '_mainFileAbsPath' attribute to have been initialized
-  if(_mainFileAbsPath == nullptr)
+  // Ensure the 'mainFileAbsPath' attribute to have been initialized
+  if(_stream->mainFileAbsPath == nullptr)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
     THROW_SESS_EXCP(ERR_SESS_INTERNAL_ERROR,"Attempting to mirror a last modification"
-                                            " time with a NULL '_mainFileAbsPath'");
+                                            " time with a NULL 'mainFileAbsPath'");
    }
 
-  // Ensure the '_remFileInfo' attribute to have been initialized
-  if(_remFileInfo == nullptr)
+  // Ensure the 'remFileInfo' attribute to have been initialized
+  if(_stream->remFileInfo == nullptr)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
     THROW_SESS_EXCP(ERR_SESS_INTERNAL_ERROR,"Attempting to mirror a last modification"
-                                            " time with a NULL '_remFileInfo'");
+                                            " time with a NULL 'remFileInfo'");
    }
 
   // Write the remote file last modification time in the second element of a 'timeval' array
-  timeval timesArr[] = {{}, {_remFileInfo->meta->lastModTimeRaw, 0}};
+  timeval timesArr[] = {{}, {_stream->remFileInfo->meta->lastModTimeRaw, 0}};
 
   // Attempt to set the main file last modification time
-  // to the one specified in the '_remFileInfo' attribute
-  if(utimes(_mainFileAbsPath->c_str(), timesArr) == -1)
+  // to the one specified in the 'remFileInfo' attribute
+  if(utimes(_stream->mainFileAbsPath->c_str(), timesArr) == -1)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
-    THROW_SESS_EXCP(ERR_SESS_FILE_META_SET_FAILED,*_mainFileAbsPath,ERRNO_DESC);
+    THROW_SESS_EXCP(ERR_SESS_FILE_META_SET_FAILED,*_stream->mainFileAbsPath,ERRNO_DESC);
    }
  }
 
 
 /**
  * @brief  If present deletes the main empty file for then touching it and setting its
- *         last modified time to the one specified in the '_remFileInfo' attribute
+ *         last modified time to the one specified in the 'remFileInfo' attribute
  * @note   If present the main file is preliminarily deleted
  *         for the purposes of updating its creation time
- * @throws ERR_SESS_INTERNAL_ERROR       NULL '_mainFileAbsPath' or '_remFileInfo' attributes
+ * @throws ERR_SESS_INTERNAL_ERROR       NULL 'mainFileAbsPath' or 'remFileInfo' attributes
  * @throws ERR_SESS_FILE_DELETE_FAILED   Error in deleting the main file
  * @throws ERR_SESS_FILE_OPEN_FAILED     Error in touching the main file
  * @throws ERR_SESS_FILE_CLOSE_FAILED    Error in closing the main file
@@ -263,49 +281,82 @@ void SessMgr::mainToRemLastModTime()
  */
 void SessMgr::touchEmptyFile()
  {
-  // Ensure the '_mainFileAbsPath' attribute to have been initialized
-  if(_mainFileAbsPath == nullptr)
+  // Ensure the 'mainFileAbsPath' attribute to have been initialized
+  if(_stream->mainFileAbsPath == nullptr)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
     THROW_SESS_EXCP(ERR_SESS_INTERNAL_ERROR,"Attempting to touch an empty file "
-                                            "with a NULL '_mainFileAbsPath'");
+                                            "with a NULL 'mainFileAbsPath'");
    }
 
-  // Ensure the '_remFileInfo' attribute to have been initialized
-  if(_remFileInfo == nullptr)
+  // Ensure the 'remFileInfo' attribute to have been initialized
+  if(_stream->remFileInfo == nullptr)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
     THROW_SESS_EXCP(ERR_SESS_INTERNAL_ERROR,"Attempting to touch an empty file "
-                                            "with a NULL '_remFileInfo'");
+                                            "with a NULL 'remFileInfo'");
    }
 
   // If the main file already exists, delete it for
   // the purposes of updating its creation time
- if(_mainFileInfo != nullptr && remove(_mainFileAbsPath->c_str()) == -1)
+ if(_stream->mainFileInfo != nullptr && remove(_stream->mainFileAbsPath->c_str()) == -1)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
-    THROW_SESS_EXCP(ERR_SESS_FILE_DELETE_FAILED,*_mainFileAbsPath,ERRNO_DESC);
+    THROW_SESS_EXCP(ERR_SESS_FILE_DELETE_FAILED,*_stream->mainFileAbsPath,ERRNO_DESC);
    }
 
   // Touch the main empty file
-  std::ofstream upFile(*_mainFileAbsPath);
+  std::ofstream upFile(*_stream->mainFileAbsPath);
   if(!upFile)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
-    THROW_SESS_EXCP(ERR_SESS_FILE_OPEN_FAILED,*_mainFileAbsPath,ERRNO_DESC);
+    THROW_SESS_EXCP(ERR_SESS_FILE_OPEN_FAILED,*_stream->mainFileAbsPath,ERRNO_DESC);
    }
 
   // Close the main empty file
   upFile.close();
   if(upFile.fail())
-   LOG_SESS_CODE(ERR_SESS_FILE_CLOSE_FAILED,*_mainFileAbsPath,ERRNO_DESC);
+   LOG_SESS_CODE(ERR_SESS_FILE_CLOSE_FAILED,*_stream->mainFileAbsPath,ERRNO_DESC);
 
   // Set the main file last modification time to the
-  // one specified in the '_remFileInfo' attribute
+  // one specified in the 'remFileInfo' attribute
   mainToRemLastModTime();
  }
 
 
+/**
+ * @brief  Returns whether an anonymous 'O_TMPFILE' inode can be published by linking it through its
+ *         entry in the process's file descriptors table, which requires '/proc' to be mounted
+ * @param  tmpFileFd The file descriptor of the anonymous inode
+ * @return 'true' if the anonymous inode can be linked, 'false' otherwise
+ */
+bool SessMgr::anonTmpFileLinkable(int tmpFileFd)
+ {
+  std::string tmpFileFdPath = "/proc/self/fd/" + std::to_string(tmpFileFd);
+  return access(tmpFileFdPath.c_str(), F_OK) == 0;
+ }
+
+
+/**
+ * @brief  Links an anonymous 'O_TMPFILE' inode at a path through its entry in the process's file
+ *         descriptors table or, should it not be accessible, through the 'AT_EMPTY_PATH' flag
+ *         (which on older kernels requires the 'CAP_DAC_READ_SEARCH' capability)
+ * @param  tmpFileFd   The file descriptor of the anonymous inode
+ * @param  linkAbsPath The absolute path the anonymous inode is to be linked at
+ * @return 0 on success, -1 on failure with 'errno' set by 'linkat()' (EEXIST = the path already exists)
+ */
+int SessMgr::linkAnonTmpFile(int tmpFileFd, const std::string& linkAbsPath)
+ {
+  // Linking through the file descriptors table requires no particular capability
+  if(anonTmpFileLinkable(tmpFileFd))
+   {
+    std::string tmpFileFdPath = "/proc/self/fd/" + std::to_string(tmpFileFd);
+    return linkat(AT_FDCWD, tmpFileFdPath.c_str(), AT_FDCWD, linkAbsPath.c_str(), AT_SYMLINK_FOLLOW);
+   }
+  return linkat(tmpFileFd, "", AT_FDCWD, linkAbsPath.c_str(), AT_EMPTY_PATH);
+ }
+
+
 /* -------------------------- Session Raw Send/Receive -------------------------- */
 
 /**
@@ -322,7 +373,7 @@ void SessMgr::sendRawTag()
  {
   // Finalize the file encryption operation by writing the resulting
   // integrity tag at the start of the primary connection buffer
-  _aesGCMMgr.encryptFinal(&_connMgr._priBuf[0]);
+  _sendAESGCMMgr.encryptFinal(&_connMgr._priBuf[0]);
 
   // Send the file integrity tag to the client
   _connMgr.sendRaw(AES_128_GCM_TAG_SIZE);
@@ -330,15 +381,503 @@ void SessMgr::sendRawTag()
 
 
 /**
- * @brief  Prepares the session manager to receive the raw
- *         contents of a file being uploaded or downloaded
+ * @brief  Returns the maximum wire size of a file segment, i.e. its plaintext size plus the integrity
+ *         tags of the chunks it is made of and, if the connection's file transfers are compressed,
+ *         the table of the chunks' sizes on the wire preceding them
+ * @param  segSize The file segment's plaintext size
+ * @return The file segment's maximum wire size
+ */
+unsigned int SessMgr::fileSegmentWireSize(unsigned int segSize)
+ {
+  // The number of chunks the file segment is made of
+  unsigned int numChunks = (segSize + FILE_CHUNK_SIZE - 1) / FILE_CHUNK_SIZE;
+
+  return segSize + numChunks * AES_128_GCM_TAG_SIZE + (_connMgr._compress ? numChunks * (unsigned int)sizeof(uint32_t) : 0);
+ }
+
+
+/**
+ * @brief  Compresses a file raw contents' chunk into a destination buffer, where, for not wasting CPU time on
+ *         incompressible data (e.g. media or archive files), a sample of the chunk is compressed first, with
+ *         the chunk being left uncompressed if its sample does not shrink below FILE_COMPR_SAMPLE_MAX_RATIO
+ * @param  chunk     The chunk's plaintext address
+ * @param  chunkSize The chunk's plaintext size
+ * @param  destBuf   The destination buffer (at least 'chunkSize' bytes)
+ * @return The chunk's compressed size, or its plaintext size if the chunk should be sent uncompressed
+ */
+unsigned int SessMgr::compressFileChunk(unsigned char* chunk, unsigned int chunkSize, unsigned char* destBuf)
+ {
+  // The chunk's (or its sample's) compressed size, initialized to the
+  // destination buffer's capacity, as compressing the chunk is
+  // worthwhile only if it shrinks it by at least one byte
+  uLongf comprSize = chunkSize - 1;
+
+  // If the chunk is larger than its sample, compress its sample first into the destination buffer,
+  // leaving the chunk uncompressed if its sample does not shrink below the maximum ratio
+  if(chunkSize > FILE_COMPR_SAMPLE_SIZE)
+   {
+    if(compress2(destBuf, &comprSize, chunk, FILE_COMPR_SAMPLE_SIZE, FILE_COMPR_LEVEL) != Z_OK ||
+       comprSize * 100 > FILE_COMPR_SAMPLE_SIZE * FILE_COMPR_SAMPLE_MAX_RATIO)
+     return chunkSize;
+
+    comprSize = chunkSize - 1;
+   }
+
+  // Compress the chunk into the destination buffer, leaving it
+  // uncompressed if it does not shrink (Z_BUF_ERROR)
+  if(compress2(destBuf, &comprSize, chunk, chunkSize, FILE_COMPR_LEVEL) != Z_OK)
+   return chunkSize;
+
+  return (unsigned int)comprSize;
+ }
+
+
+/**
+ * @brief  Decompresses a verified file raw contents' chunk of a stream into its plaintext address
+ * @param  stream     The stream the chunk belongs to
+ * @param  comprChunk The chunk's compressed data address
+ * @param  comprSize  The chunk's compressed size
+ * @param  chunk      The address where to write the chunk's plaintext
+ * @param  chunkSize  The chunk's expected plaintext size
+ * @throws ERR_SESSABORT_FILE_DECOMPRESS_FAILED The chunk failed its decompression or
+ *                                              its plaintext is of unexpected size
+ */
+void SessMgr::decompressFileChunk(SessStream& stream, unsigned char* comprChunk, unsigned int comprSize,
+                                  unsigned char* chunk, unsigned int chunkSize)
+ {
+  // The chunk's decompressed size
+  uLongf decomprSize = chunkSize;
+
+  // zlib uncompress() return
+  int uncompressRet = uncompress(chunk, &decomprSize, comprChunk, comprSize);
+
+  // As the chunk has already been verified, a decompression failure is attributed to a
+  // peer's malfunction, which as the peer may be still sending the file's following
+  // segments cannot be recovered from and so requires the connection to be dropped
+  if(uncompressRet != Z_OK || decomprSize != chunkSize)
+   THROW_EXEC_EXCP(ERR_SESSABORT_FILE_DECOMPRESS_FAILED, "file: \"" + stream.remFileInfo->fileName + "\", zlib error "
+                   + std::to_string(uncompressRet) + ", decompressed " + std::to_string(decomprSize) + " of "
+                   + std::to_string(chunkSize) + " bytes");
+ }
+
+
+/**
+ * @brief  Returns a string reporting the savings of the compression of file transfers
+ * @param  rawBytes  The plaintext size of the file segments sent or received
+ * @param  wireBytes The wire size of the file segments sent or received
+ * @return The compression statistics string
+ */
+std::string SessMgr::compressionStatsStr(unsigned long rawBytes, unsigned long wireBytes)
+ {
+  return "compressed to " + std::to_string(rawBytes == 0 ? 100 : wireBytes * 100 / rawBytes) + "% ("
+         + std::to_string(wireBytes) + " of " + std::to_string(rawBytes) + " bytes on the wire)";
+ }
+
+
+/**
+ * @brief  Returns the plaintext size of the next file segment to be sent, adapted so to match
+ *         the connection's current bandwidth-delay product within FILE_SEGMENT_MIN_CHUNKS and
+ *         FILE_SEGMENT_CHUNKS chunks, and not exceeding the remaining file bytes to be sent
+ * @param  bytesRem The remaining file bytes to be sent
+ * @return The plaintext size of the next file segment to be sent
+ */
+unsigned int SessMgr::adaptSendSegSize(long int bytesRem)
+ {
+  // The connection's estimated bandwidth-delay product
+  unsigned int connBDP = _connMgr.getBDPEstimate();
+
+  // The number of chunks in the segment, defaulting to their maximum if the BDP is not available
+  unsigned int numChunks = FILE_SEGMENT_CHUNKS;
+
+  if(connBDP > 0)
+   numChunks = std::max((unsigned int)FILE_SEGMENT_MIN_CHUNKS,
+                        (unsigned int)std::min((connBDP + FILE_CHUNK_SIZE - 1UL) / FILE_CHUNK_SIZE, (unsigned long)FILE_SEGMENT_CHUNKS));
+
+  return (unsigned int)std::min(bytesRem, (long int)numChunks * FILE_CHUNK_SIZE);
+ }
+
+
+/**
+ * @brief  Prepares the chunks jobs of a file segment, where each chunk's plaintext is located in the
+ *         segment's plaintext buffer and its ciphertext, followed by its integrity tag, in the
+ *         segment's ciphertext buffer, with compressed chunks being encrypted or decrypted in place
+ * @param  stream     The stream the file segment belongs to
+ * @param  jobs       The chunks jobs array to be initialized (at least FILE_SEGMENT_CHUNKS elements)
+ * @param  segSize    The file segment's plaintext size
+ * @param  ptBuf      The segment's plaintext buffer
+ * @param  ctBuf      The segment's ciphertext buffer
+ * @param  chunkSizes The table of the chunks' sizes on the wire at the start of the ciphertext buffer,
+ *                    where a size smaller than the chunk's plaintext size denotes a compressed
+ *                    chunk (nullptr if the connection's file transfers are not compressed)
+ * @param  encrypt    Whether the chunks are to be encrypted (plaintext -> ciphertext
+ *                    buffer) or decrypted (ciphertext -> plaintext buffer)
+ * @return The number of chunks the file segment is made of
+ */
+unsigned int SessMgr::prepFileSegmentJobs(SessStream& stream, AESGCMChunkJob* jobs, unsigned int segSize,
+                                          unsigned char* ptBuf, unsigned char* ctBuf, uint32_t* chunkSizes, bool encrypt)
+ {
+  // The number of chunks the file segment is made of
+  unsigned int numChunks = (segSize + FILE_CHUNK_SIZE - 1) / FILE_CHUNK_SIZE;
+
+  // The current chunk's index, plaintext offset within the file segment and size
+  unsigned int chunkIdx;
+  unsigned int chunkOffset;
+  unsigned int chunkSize;
+
+  // The current chunk's offset and data size in the segment's ciphertext
+  // buffer, where the chunks follow the table of their sizes, if any
+  unsigned int wireOffset = (chunkSizes != nullptr) ? numChunks * (unsigned int)sizeof(uint32_t) : 0;
+  unsigned int dataSize;
+
+  for(chunkIdx = 0, chunkOffset = 0; chunkIdx < numChunks; chunkIdx++, chunkOffset += chunkSize)
+   {
+    chunkSize = std::min(segSize - chunkOffset, (unsigned int)FILE_CHUNK_SIZE);
+    dataSize  = (chunkSizes != nullptr) ? chunkSizes[chunkIdx] : chunkSize;
+
+    // A compressed chunk is encrypted or decrypted in place in
+    // the ciphertext buffer, where it was compressed into or
+    // from where it will be decompressed from
+    if(dataSize < chunkSize)
+     {
+      jobs[chunkIdx].inAddr  = &ctBuf[wireOffset];
+      jobs[chunkIdx].outAddr = &ctBuf[wireOffset];
+     }
+
+    // Otherwise the plaintext of the chunk is stored in the plaintext
+    // buffer, and its ciphertext and tag in the ciphertext buffer
+    else
+     if(encrypt)
+      {
+       jobs[chunkIdx].inAddr  = &ptBuf[chunkOffset];
+       jobs[chunkIdx].outAddr = &ctBuf[wireOffset];
+      }
+     else
+      {
+       jobs[chunkIdx].inAddr  = &ctBuf[wireOffset];
+       jobs[chunkIdx].outAddr = &ptBuf[chunkOffset];
+      }
+    jobs[chunkIdx].tagAddr  = &ctBuf[wireOffset + dataSize];
+    jobs[chunkIdx].dataSize = dataSize;
+
+    // Initialize the chunk's AAD from its position in the file, whether
+    // it is compressed and whether it is authenticated only
+    jobs[chunkIdx].aad.seqNum     = stream.chunkSeqNum + chunkIdx;
+    jobs[chunkIdx].aad.chunkSize  = chunkSize;
+    jobs[chunkIdx].aad.lastChunk  = (chunkOffset + chunkSize == stream.rawBytesRem);
+    jobs[chunkIdx].aad.compressed = (dataSize < chunkSize);
+    jobs[chunkIdx].aad.authOnly   = stream.authOnly;
+
+    // The plaintext of a chunk encrypted from the memory mapping of
+    // the file being sent (read-only) cannot be safely deleted
+    jobs[chunkIdx].keepIn = encrypt && stream.mainFileMap != nullptr;
+
+    wireOffset += dataSize + AES_128_GCM_TAG_SIZE;
+   }
+
+  return numChunks;
+ }
+
+
+/**
+ * @brief  Encrypts a file raw contents' segment of a stream from a plaintext into a ciphertext buffer,
+ *         where each of its chunks is encrypted with the stream's sending IV as a standalone AES_128_GCM
+ *         operation authenticating its sequence number, size, whether it is the file's last chunk and
+ *         whether it is compressed as AAD (possibly in parallel by the AES_128_GCM workers pool), with
+ *         each chunk's ciphertext followed by its integrity tag and, if the connection's file transfers are
+ *         compressed, the compressible chunks being compressed before their encryption and the chunks
+ *         being preceded by the table of their sizes on the wire (where if the stream's transfer is
+ *         authenticated only the chunks are not encrypted nor compressed, but sent as-is along with
+ *         their GMAC integrity tag)
+ * @param  stream   The stream the file segment belongs to
+ * @param  segSize  The segment's plaintext size (must be <= FILE_SEGMENT_SIZE and <= the stream's 'rawBytesRem')
+ * @param  keyEpoch The epoch of the sending key the segment's chunks are to be encrypted with
+ * @param  ptBuf    The segment's plaintext buffer
+ * @param  ctBuf    The segment's ciphertext buffer (at least CONN_BUF_SIZE bytes)
+ * @return The segment's wire size, i.e. the size of its chunks' ciphertexts
+ *         and integrity tags, plus the chunks' sizes table, if any
+ * @throws ERR_SESSABORT_INTERNAL_ERROR  Invalid segment size
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW   EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The plaintext block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+ */
+unsigned int SessMgr::encryptFileSegment(SessStream& stream, unsigned int segSize, uint32_t keyEpoch,
+                                         unsigned char* ptBuf, unsigned char* ctBuf)
+ {
+  // The segment's chunks encryption jobs
+  AESGCMChunkJob chunkJobs[FILE_SEGMENT_CHUNKS];
+
+  // The number of chunks the segment is made of
+  unsigned int numChunks;
+
+  // The table of the chunks' sizes on the wire, if the connection's file transfers are compressed
+  uint32_t* chunkSizes = nullptr;
+
+  // The current chunk's plaintext offset within the file segment
+  // and its offset in the segment's ciphertext buffer
+  unsigned int chunkOffset;
+  unsigned int wireOffset;
+
+  // The segment's wire size
+  unsigned int wireSize;
+
+  // Assert the segment size to be positive and to not exceed
+  // neither the maximum segment size nor the remaining file bytes
+  if(segSize == 0 || segSize > FILE_SEGMENT_SIZE || segSize > stream.rawBytesRem)
+   THROW_EXEC_EXCP(ERR_SESSABORT_INTERNAL_ERROR, "Invalid file segment size (" + std::to_string(segSize)
+                                                 + ", rawBytesRem = " + std::to_string(stream.rawBytesRem) + ")");
+
+  // If the connection's file transfers are compressed, compress the segment's compressible chunks
+  // into the ciphertext buffer following the table of the chunks' sizes on the wire (where the
+  // chunks of an authenticated-only transfer, being already encrypted, are never compressed)
+  if(_connMgr._compress)
+   {
+    chunkSizes = reinterpret_cast<uint32_t*>(ctBuf);
+    numChunks  = (segSize + FILE_CHUNK_SIZE - 1) / FILE_CHUNK_SIZE;
+    wireOffset = numChunks * (unsigned int)sizeof(uint32_t);
+
+    for(unsigned int i = 0; i < numChunks; i++)
+     {
+      chunkOffset   = i * FILE_CHUNK_SIZE;
+      chunkSizes[i] = std::min(segSize - chunkOffset, (unsigned int)FILE_CHUNK_SIZE);
+      if(!stream.authOnly)
+       chunkSizes[i] = compressFileChunk(&ptBuf[chunkOffset], chunkSizes[i], &ctBuf[wireOffset]);
+      wireOffset   += chunkSizes[i] + AES_128_GCM_TAG_SIZE;
+     }
+   }
+
+  // Prepare the segment's chunks encryption jobs from the plaintext into the ciphertext buffer
+  numChunks = prepFileSegmentJobs(stream, chunkJobs, segSize, ptBuf, ctBuf, chunkSizes, true);
+
+  // Ratchet the chunks' sending key up to the epoch the segment is to be encrypted with
+  _sendChunkKey.ratchetTo(keyEpoch);
+
+  // Encrypt the segment's chunks, appending each chunk's integrity tag to its ciphertext
+  _aesGCMPool.encryptChunks(_connMgr._aeadCipher, _sendChunkKey, &stream.sendChunkIV, chunkJobs, numChunks, stream.cryptoWorkers);
+
+  // The segment's wire size ends with its last chunk's integrity tag
+  wireSize = (unsigned int)(chunkJobs[numChunks - 1].tagAddr + AES_128_GCM_TAG_SIZE - ctBuf);
+
+  // Update the number of remaining file bytes to be
+  // encrypted and the sequence number of the next chunk
+  stream.rawBytesRem -= segSize;
+  stream.chunkSeqNum += numChunks;
+
+  // Update the stream's and the session's transferred bytes
+  stream.xferRawBytes  += segSize;
+  stream.xferWireBytes += wireSize;
+  _xferRawBytes        += segSize;
+  _xferWireBytes       += wireSize;
+
+  return wireSize;
+ }
+
+
+/**
+ * @brief  Verifies and decrypts the next file raw contents' segment of a stream from a ciphertext into a
+ *         plaintext buffer with the stream's receiving IV (possibly in parallel by the AES_128_GCM workers
+ *         pool), decompressing its compressed chunks, if any, and updating the number of remaining file
+ *         bytes to be received and the sequence number of the stream's next chunk
+ * @param  stream   The stream the file segment belongs to
+ * @param  segSize  The segment's plaintext size, as announced by its 'FILE_SEGMENT' session message
+ * @param  wireSize The segment's wire size, as announced by its 'FILE_SEGMENT' session message
+ * @param  keyEpoch The epoch of the receiving key the segment's chunks are encrypted
+ *                  with, as announced by its 'FILE_SEGMENT' session message
+ * @param  ctBuf    The segment's ciphertext buffer (chunks' sizes table, ciphertexts and tags)
+ * @param  ptBuf    The segment's plaintext buffer (at least FILE_SEGMENT_SIZE bytes)
+ * @throws ERR_SESSABORT_INVALID_FILE_SEGMENT     The segment's chunks' sizes table is
+ *                                                inconsistent with its announced sizes
+ * @throws ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED A chunk of a segment other than the file's
+ *                                                last failed its integrity verification
+ * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED         A chunk of the file's last segment
+ *                                                failed its integrity verification
+ * @throws ERR_SESSABORT_FILE_DECOMPRESS_FAILED   A compressed chunk failed its decompression
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW              EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT          Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE               Key derivation failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE            Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW            EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_DECRYPT_INIT              EVP_CIPHER decrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE           The ciphertext block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_DECRYPT_UPDATE            EVP_CIPHER decrypt update failed
+ * @throws ERR_OSSL_SET_TAG_FAILED                Error in setting the expected chunk integrity tag
+ */
+void SessMgr::decryptFileSegment(SessStream& stream, unsigned int segSize, unsigned int wireSize,
+                                 uint32_t keyEpoch, unsigned char* ctBuf, unsigned char* ptBuf)
+ {
+  // The segment's chunks decryption jobs
+  AESGCMChunkJob chunkJobs[FILE_SEGMENT_CHUNKS];
+
+  // The number of chunks the segment is made of
+  unsigned int numChunks = (segSize + FILE_CHUNK_SIZE - 1) / FILE_CHUNK_SIZE;
+
+  // The table of the chunks' sizes on the wire, if the connection's file transfers are compressed
+  uint32_t* chunkSizes = nullptr;
+
+  // The segment's wire size resulting from its chunks' sizes table
+  unsigned int tableWireSize;
+
+  // If the connection's file transfers are compressed, assert each chunk's size on the wire to be positive
+  // and not to exceed its plaintext size, and the resulting wire size to match the announced one
+  if(_connMgr._compress)
+   {
+    chunkSizes    = reinterpret_cast<uint32_t*>(ctBuf);
+    tableWireSize = numChunks * (unsigned int)sizeof(uint32_t);
+
+    for(unsigned int i = 0; i < numChunks; i++)
+     {
+      if(chunkSizes[i] == 0 || chunkSizes[i] > std::min(segSize - i * FILE_CHUNK_SIZE, (unsigned int)FILE_CHUNK_SIZE))
+       THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_SEGMENT, "stream " + std::to_string(stream.streamId) + ", chunk "
+                                                           + std::to_string(i) + " wire size = " + std::to_string(chunkSizes[i]));
+      tableWireSize += chunkSizes[i] + AES_128_GCM_TAG_SIZE;
+     }
+
+    if(tableWireSize != wireSize)
+     THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_SEGMENT, "stream " + std::to_string(stream.streamId)
+                                                         + ", chunks' wire size = " + std::to_string(tableWireSize)
+                                                         + ", announced wireSize = " + std::to_string(wireSize));
+   }
+
+  // Prepare the segment's chunks decryption jobs from the ciphertext into the plaintext
+  // buffer, authenticating their expected positions in the file as their AADs
+  prepFileSegmentJobs(stream, chunkJobs, segSize, ptBuf, ctBuf, chunkSizes, false);
+
+  // Ratchet the chunks' receiving key up to the epoch the segment is encrypted with
+  _recvChunkKey.ratchetTo(keyEpoch);
+
+  // Decrypt and verify the segment's chunks
+  try
+   { _aesGCMPool.decryptChunks(_connMgr._aeadCipher, _recvChunkKey, &stream.recvChunkIV, chunkJobs, numChunks, stream.cryptoWorkers); }
+  catch(sessErrExcp& chunkVerifyExcp)
+   {
+    // As the peer is still sending the file's following segments, an integrity verification
+    // failure in a segment other than the last cannot be recovered from without resynchronizing
+    // the connection, and so requires it to be dropped (while a failure in the last segment is
+    // handled as a session error as for the previous whole-file integrity tag)
+    if(segSize != stream.rawBytesRem)
+     THROW_EXEC_EXCP(ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED, "file: \"" + stream.remFileInfo->fileName + "\", chunks "
+                     + std::to_string(stream.chunkSeqNum) + "-" + std::to_string(stream.chunkSeqNum + numChunks - 1),
+                     "the file's raw contents have been tampered with");
+    throw;
+   }
+
+  // Decompress the segment's verified compressed chunks into the plaintext buffer
+  for(unsigned int i = 0; i < numChunks; i++)
+   if(chunkJobs[i].aad.compressed)
+    decompressFileChunk(stream, chunkJobs[i].outAddr, chunkJobs[i].dataSize, &ptBuf[i * FILE_CHUNK_SIZE], chunkJobs[i].aad.chunkSize);
+
+  // Update the number of remaining file bytes to be
+  // received and the sequence number of the next chunk
+  stream.rawBytesRem -= segSize;
+  stream.chunkSeqNum += numChunks;
+
+  // Update the stream's and the session's transferred bytes
+  stream.xferRawBytes  += segSize;
+  stream.xferWireBytes += wireSize;
+  _xferRawBytes        += segSize;
+  _xferWireBytes       += wireSize;
+ }
+
+
+/**
+ * @brief  Verifies and decrypts a file raw contents' segment of the current stream that has been fully
+ *         received in the primary connection buffer (possibly in parallel by the AES_128_GCM workers pool),
+ *         writes the resulting plaintext into the stream's temporary file (or, if it is a piece of the delta of
+ *         the file being uploaded, applies it to the file being rebuilt in such temporary file) and sets the
+ *         associated connection manager to expect the next session message
+ * @param  segSize  The segment's plaintext size, as announced by its 'FILE_SEGMENT' session message
+ * @param  wireSize The segment's wire size, as announced by its 'FILE_SEGMENT' session message
+ * @param  keyEpoch The segment's key epoch, as announced by its 'FILE_SEGMENT' session message
+ * @throws ERR_SESSABORT_INVALID_FILE_SEGMENT     The segment's chunks' sizes table is
+ *                                                inconsistent with its announced sizes
+ * @throws ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED A chunk of a segment other than the file's
+ *                                                last failed its integrity verification
+ * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED         A chunk of the file's last segment
+ *                                                failed its integrity verification
+ * @throws ERR_SESSABORT_FILE_DECOMPRESS_FAILED   A compressed chunk failed its decompression
+ * @throws ERR_FILE_WRITE_FAILED                  Error in writing to the temporary file
+ * @throws ERR_SESSABORT_INVALID_FILE_DELTA       Malformed delta of the file being uploaded
+ * @throws ERR_FILE_READ_FAILED                   Error in reading the server's copy of the file being uploaded
+ * @throws ERR_OSSL_EVP_DIGEST_UPDATE             EVP_MD digest update failed
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW              EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT          Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE               Key derivation failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE            Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW            EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_DECRYPT_INIT              EVP_CIPHER decrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE           The ciphertext block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_DECRYPT_UPDATE            EVP_CIPHER decrypt update failed
+ * @throws ERR_OSSL_SET_TAG_FAILED                Error in setting the expected chunk integrity tag
+ */
+void SessMgr::recvFileSegment(unsigned int segSize, unsigned int wireSize, uint32_t keyEpoch)
+ {
+  // fwrite() return, representing the number of bytes written
+  // from the secondary connection buffer into the temporary file
+  size_t fwriteRet;
+
+  // Verify and decrypt the segment from the primary into the secondary connection buffer
+  decryptFileSegment(*_stream, segSize, wireSize, keyEpoch, &_connMgr._priBuf[0], &_connMgr._secBuf[0]);
+
+  // If the segment is a piece of the delta of the file being uploaded, apply it to the file being rebuilt
+  if(_stream->fileDelta != nullptr)
+   _stream->fileDelta->apply(_connMgr._secBuf, segSize);
+
+  // Otherwise write the verified segment plaintext from the secondary buffer into the temporary file
+  else
+   {
+    fwriteRet = fwrite(_connMgr._secBuf, sizeof(char), segSize, _stream->tmpFileDscr);
+
+    // Writing into the temporary file less bytes than the ones of the segment is a critical error that in
+    // the current session state cannot be notified to the peer and so require the connection to be dropped
+    if(fwriteRet < segSize)
+     THROW_EXEC_EXCP(ERR_FILE_WRITE_FAILED,"file: " + *_stream->tmpFileAbsPath + ", " + sessMgrOpToStrLowCase()
+                     + " operation aborted","written " + std::to_string(fwriteRet) + " < segSize = "
+                     + std::to_string(segSize) + " bytes");
+   }
+
+  // Set the associated connection manager to expect the next session message, which
+  // may refer to any stream, and mark the primary connection buffer contents as consumed
+  _connMgr._recvMode = ConnMgr::RECV_MSG;
+  _connMgr.clearPriBuf();
+ }
+
+
+/**
+ * @brief Prepares the current stream to send the raw contents of the file being uploaded or downloaded,
+ *        whose size is assumed to be specified in its 'mainFileInfo' object, from its 'rawOffset' and for
+ *        its 'rawLength' (if not 0) by initializing the number of raw bytes to be sent, the sequence number
+ *        of the first chunk and the number of worker threads to be used for encrypting the file's segments
+ */
+void SessMgr::prepSendFileRaw()
+ {
+  if(_stream->rawLength == 0)
+   _stream->rawLength = _stream->mainFileInfo->meta->fileSizeRaw - _stream->rawOffset;
+  _stream->rawBytesRem   = _stream->rawLength;
+  _stream->chunkSeqNum   = _stream->rawOffset / FILE_CHUNK_SIZE;
+  _stream->cryptoWorkers = _aesGCMPool.getNumWorkers((long)_stream->rawBytesRem);
+ }
+
+
+/**
+ * @brief  Prepares the current stream to receive the raw contents of a file being uploaded or
+ *         downloaded from its 'rawOffset', whose segments are each announced by a 'FILE_SEGMENT'
+ *         session message, writing them into an anonymous 'O_TMPFILE' inode in the main file's
+ *         directory or, where the filesystem does not support it or it could not be linked (no
+ *         '/proc'), into the named temporary file
+ *         (where a resumed reception writes them into its already open temporary file, which
+ *         holds the file's contents up to the offset)
  * @throws ERR_SESSABORT_INTERNAL_ERROR  Invalid session manager operation or step
  *                                       for receiving a file's raw contents
  * @throws ERR_SESS_FILE_OPEN_FAILED     Failed to open the temporary file
  *                                       descriptor in write-byte mode
  * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
- * @throws ERR_OSSL_EVP_DECRYPT_INIT     EVP_CIPHER decrypt initialization failed
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
  * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
  * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
@@ -348,82 +887,146 @@ void SessMgr::sendRawTag()
  */
 void SessMgr::prepRecvFileRaw()
  {
-  // Assert the session manager to be in the 'UPLOAD' or 'DOWNLOAD' operation
-  if(_sessMgrOp != UPLOAD && _sessMgrOp != DOWNLOAD)
+  // Assert the stream to be in the 'UPLOAD' or 'DOWNLOAD' operation
+  if(_stream->op != UPLOAD && _stream->op != DOWNLOAD)
    THROW_EXEC_EXCP(ERR_SESSABORT_INTERNAL_ERROR, "Preparing to receive a file's raw"
                                                  "contents with the session manager in "
                                                  "operation \"" + sessMgrOpToStrUpCase() +
                                                  "\", step " + sessMgrOpStepToStrUpCase());
 
-  // Update the session manager step so to expect raw data
-  _sessMgrOpStep = WAITING_RAW;
-
-  // Set the reception mode of the associated connection manager to 'RECV_RAW'
-  _connMgr._recvMode = ConnMgr::RECV_RAW;
-
-  // Set the associated connection manager's expected data
-  // block size to the size of the file to be received
-  _connMgr._recvBlockSize = _remFileInfo->meta->fileSizeRaw;
+  // Update the stream step so to expect raw data
+  _stream->opStep = WAITING_RAW;
+
+  // Initialize the number of raw bytes to be received to the file size past its offset (if no range
+  // length was set), the sequence number of the first chunk to be received and the number of worker
+  // threads used for decrypting it
+  if(_stream->rawLength == 0)
+   _stream->rawLength = _stream->remFileInfo->meta->fileSizeRaw - _stream->rawOffset;
+  _stream->rawBytesRem   = _stream->rawLength;
+  _stream->chunkSeqNum   = _stream->rawOffset / FILE_CHUNK_SIZE;
+  _stream->cryptoWorkers = _aesGCMPool.getNumWorkers((long)_stream->rawBytesRem);
+
+  // If the reception is resumed, its temporary file is already open
+  if(_stream->tmpFileDscr != nullptr)
+   return;
+
+  // Attempt to create the temporary file as an anonymous inode in the main file's directory, which is
+  // published only by linking it into the main directory once all its chunks have been verified and
+  // is otherwise released by the kernel when closed, including if the application crashes
+  std::string mainFileDir = _stream->mainFileAbsPath->substr(0, _stream->mainFileAbsPath->find_last_of('/'));
+  int tmpFileFd = open(mainFileDir.c_str(), O_TMPFILE | O_WRONLY, 0666);
+  if(tmpFileFd != -1)
+   {
+    // As the anonymous inode could not be published, nor preserved as a partial file, without
+    // its entry in the process's file descriptors table (i.e. if '/proc' is not mounted), in
+    // such a case the named temporary file is used instead
+    if(!anonTmpFileLinkable(tmpFileFd))
+     {
+      LOG_DEBUG("Anonymous temporary files cannot be linked without \"/proc/self/fd\", using \""
+                + *_stream->tmpFileAbsPath + "\"")
+      close(tmpFileFd);
+     }
+    else
+     {
+      _stream->tmpFileDscr = fdopen(tmpFileFd, "wb");
+      if(!_stream->tmpFileDscr)
+       close(tmpFileFd);
+      else
+       {
+        _stream->tmpFileAnon = true;
+        return;
+       }
+     }
+   }
 
-  // Initialize the number of raw bytes to be received to the file size
-  _rawBytesRem = _remFileInfo->meta->fileSizeRaw;
+  // Otherwise, as if the main directory's filesystem does not support anonymous
+  // inodes, fall back to the named temporary file in the temporary directory
+  else
+   {
+    LOG_DEBUG("Anonymous temporary files not available in \"" + mainFileDir + "\" ("
+              + std::string(ERRNO_DESC) + "), using \"" + *_stream->tmpFileAbsPath + "\"")
+   }
+  _connMgr._tmpDirUsed = true;
 
   // Open the temporary file descriptor in write-byte mode
-  _tmpFileDscr = fopen(_tmpFileAbsPath->c_str(), "wb");
-  if(!_tmpFileDscr)
+  _stream->tmpFileDscr = fopen(_stream->tmpFileAbsPath->c_str(), "wb");
+  if(!_stream->tmpFileDscr)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
-    THROW_SESS_EXCP(ERR_SESS_FILE_OPEN_FAILED,*_tmpFileAbsPath,ERRNO_DESC);
+    THROW_SESS_EXCP(ERR_SESS_FILE_OPEN_FAILED,*_stream->tmpFileAbsPath,ERRNO_DESC);
    }
-
-  // Initialize the file AES_128_GCM decryption operation
-  _aesGCMMgr.decryptInit();
  }
 
 
 /**
- * @brief Finalizes a received file, whether uploaded or downloaded, by:\n\n
- *           1) Verifying its integrity tag\n\n
- *           2) Moving it from the temporary into the main directory\n\n
- *           3) Setting its last modified time to the one
- *              specified in the '_remFileInfo' object
- * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
- * @throws ERR_NON_POSITIVE_BUFFER_SIZE   The ciphertext block size is non-positive (probable overflow)
- * @throws ERR_OSSL_EVP_DECRYPT_UPDATE    EVP_CIPHER decrypt update failed
- * @throws ERR_OSSL_SET_TAG_FAILED        Error in setting the expected file integrity tag
- * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED File integrity verification failed
- * @throws ERR_SESS_FILE_CLOSE_FAILED     Error in closing the temporary file
- * @throws ERR_SESS_FILE_RENAME_FAILED    Error in moving the temporary file to the main directory
+ * @brief Finalizes a received file, whether uploaded or downloaded,
+ *        whose chunks have all been verified upon reception, by:\n\n
+ *           1) Publishing it as the main file, by linking it into the main directory if
+ *              anonymous or by moving it from the temporary into the main directory\n\n
+ *           2) Setting its last modified time to the one
+ *              specified in the 'remFileInfo' object
+ * @throws ERR_SESS_FILE_CLOSE_FAILED     Error in flushing or closing the temporary file
+ * @throws ERR_SESS_FILE_RENAME_FAILED    Error in linking or moving the temporary file to the main directory
  * @throws ERR_SESS_FILE_META_SET_FAILED  Error in setting the main file's last modification time
  */
 void SessMgr::finalizeRecvFileRaw()
  {
-  // Finalize the file reception's decryption by verifying its
-  // integrity tag available in the primary connection buffer
-  // Finalize the upload decryption by verifying the file's integrity tag
-  _aesGCMMgr.decryptFinal(&_connMgr._priBuf[0]);
+  // Whether the temporary file must be moved from the temporary into the main directory
+  bool tmpFileNamed = !_stream->tmpFileAnon;
+
+  // If the temporary file is an anonymous inode, flush its buffered
+  // contents and link it into the main directory as the main file
+  if(_stream->tmpFileAnon)
+   {
+    if(fflush(_stream->tmpFileDscr) != 0)
+     {
+      sendSessSignalMsg(ERR_INTERNAL_ERROR);
+      THROW_SESS_EXCP(ERR_SESS_FILE_CLOSE_FAILED,"Received file \""
+                                                 + *_stream->mainFileAbsPath + "\"", ERRNO_DESC);
+     }
+
+    if(linkAnonTmpFile(fileno(_stream->tmpFileDscr), *_stream->mainFileAbsPath))
+     {
+      // As linkat() does not replace existing files, if the main file already exists (i.e. it is
+      // being overwritten) link the inode as the named temporary file and move it over the main
+      // file instead, so that the main file is atomically replaced as in the named fallback
+      if(errno == EEXIST)
+       {
+        _connMgr._tmpDirUsed = true;
+        unlink(_stream->tmpFileAbsPath->c_str());
+        if(!linkAnonTmpFile(fileno(_stream->tmpFileDscr), *_stream->tmpFileAbsPath))
+         tmpFileNamed = true;
+       }
+      if(!tmpFileNamed)
+       {
+        sendSessSignalMsg(ERR_INTERNAL_ERROR);
+        THROW_SESS_EXCP(ERR_SESS_FILE_RENAME_FAILED,"anonymous source, dest: \""
+                                                    + *_stream->mainFileAbsPath + "\"", ERRNO_DESC);
+       }
+     }
+   }
 
   // Close and reset the temporary file descriptor
-  if(fclose(_tmpFileDscr) != 0)
+  if(fclose(_stream->tmpFileDscr) != 0)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
     THROW_SESS_EXCP(ERR_SESS_FILE_CLOSE_FAILED,"Received file \""
-                                               + *_tmpFileAbsPath + "\"", ERRNO_DESC);
+                                               + *_stream->tmpFileAbsPath + "\"", ERRNO_DESC);
    }
-  _tmpFileDscr = nullptr;
+  _stream->tmpFileDscr = nullptr;
 
-  // Move the temporary file from the temporary
+  // If named, move the temporary file from the temporary
   // directory into the main file in the main directory
-  if(rename(_tmpFileAbsPath->c_str(),_mainFileAbsPath->c_str()))
+  if(tmpFileNamed && rename(_stream->tmpFileAbsPath->c_str(),_stream->mainFileAbsPath->c_str()))
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
-    THROW_SESS_EXCP(ERR_SESS_FILE_RENAME_FAILED,"source: \"" + *_tmpFileAbsPath
-                                                + "\", dest: \"" + *_mainFileAbsPath
+    THROW_SESS_EXCP(ERR_SESS_FILE_RENAME_FAILED,"source: \"" + *_stream->tmpFileAbsPath
+                                                + "\", dest: \"" + *_stream->mainFileAbsPath
                                                 + "\"", ERRNO_DESC);
    }
 
   // Set the received file last modified time to
-  // the one specified in the '_remFileInfo' object
+  // the one specified in the 'remFileInfo' object
   mainToRemLastModTime();
  }
 
@@ -431,9 +1034,10 @@ void SessMgr::finalizeRecvFileRaw()
 /* -------------------- Session Messages Wrapping/Unwrapping -------------------- */
 
 /**
- * @brief  Wraps a session message stored in the associated connection's
- *         secondary buffer into a session message wrapper in the connection's
- *         primary buffer, sending the resulting wrapper to the connection peer
+ * @brief  Wraps a session message into a session message wrapper in the associated connection's
+ *         primary buffer, sending the resulting wrapper to the connection peer and accounting
+ *         it in the data protected by the current sending key
+ * @param  sessMsgBuf The buffer storing the session message to be wrapped
  * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
@@ -443,13 +1047,13 @@ void SessMgr::finalizeRecvFileRaw()
  * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
  * @throws ERR_SEND_FAILED              send() fatal error
  */
-void SessMgr::wrapSendSessMsg()
+void SessMgr::wrapSendSessMsg(unsigned char* sessMsgBuf)
  {
   /* ------------------ Session Message and Wrapper Sizes ------------------ */
 
-  // Determine the size of the session message to be wrapped and send from
-  // the first 16 bit of the associated connection manager's secondary buffer
-  uint16_t sessMsgSize = ((uint16_t*)_connMgr._secBuf)[0];
+  // Determine the size of the session message to be wrapped
+  // and send from the first 16 bit of its buffer
+  uint16_t sessMsgSize = ((uint16_t*)sessMsgBuf)[0];
 
   // Determine the session message wrapper size
   uint16_t sessWrapSize = sessMsgSize + sizeof(SessMsgWrapper);
@@ -461,21 +1065,104 @@ void SessMgr::wrapSendSessMsg()
   /* ---------------------- Session Message Encryption ---------------------- */
 
   // Initialize an AES_128_GCM encryption operation
-  _aesGCMMgr.encryptInit();
+  _sendAESGCMMgr.encryptInit();
 
   // Set the encryption operation's AAD to the session message wrapper size
-  _aesGCMMgr.encryptAddAAD(reinterpret_cast<unsigned char*>(&sessWrapSize), sizeof(sessWrapSize));
+  _sendAESGCMMgr.encryptAddAAD(reinterpret_cast<unsigned char*>(&sessWrapSize), sizeof(sessWrapSize));
 
-  // Encrypt the session message from the secondary into the primary
+  // Encrypt the session message from its buffer into the primary
   // connection buffer after the session message wrapper size
-  _aesGCMMgr.encryptAddPT(&_connMgr._secBuf[0], sessMsgSize, &_connMgr._priBuf[sizeof(uint16_t)]);
+  _sendAESGCMMgr.encryptAddPT(sessMsgBuf, sessMsgSize, &_connMgr._priBuf[sizeof(uint16_t)]);
 
   // Finalize the encryption by writing the resulting integrity tag after the encrypted
   // session message (or, equivalently, at the end of the session message wrapper)
-  _aesGCMMgr.encryptFinal(&_connMgr._priBuf[sessWrapSize - AES_128_GCM_TAG_SIZE]);
+  _sendAESGCMMgr.encryptFinal(&_connMgr._priBuf[sessWrapSize - AES_128_GCM_TAG_SIZE]);
 
   // Send the wrapped session message
   _connMgr.sendMsg();
+
+  // Account the session message in the data protected by the current sending key
+  _sendKeyBytes += sessWrapSize;
+  _sendKeyOps++;
+ }
+
+
+/**
+ * @brief  Sends a 'REKEY' session message to the connection peer, for then ratcheting the sending key
+ *         and the session messages' sending IV into the ones of the key's next epoch, which the file
+ *         segments encrypted from now on are protected with
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED         The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED               send() fatal error
+ */
+void SessMgr::sendRekeyMsg()
+ {
+  // The 'REKEY' session message, which is prepared outside of the associated connection
+  // manager's secondary buffer so not to overwrite the session message to be sent after it
+  SessMsg rekeyMsg;
+
+  // Set the 'REKEY' message length, type and stream (which, as
+  // the session's keys are shared by all streams, is irrelevant)
+  rekeyMsg.msgLen   = sizeof(SessMsg);
+  rekeyMsg.msgType  = REKEY;
+  rekeyMsg.streamId = 0;
+
+  // Wrap the 'REKEY' message with the current sending key and send it to the connection peer,
+  // which will unwrap the session messages following it with the key of its next epoch
+  wrapSendSessMsg(reinterpret_cast<unsigned char*>(&rekeyMsg));
+
+  // Ratchet the sending key and the session messages' sending IV
+  // into the ones of the next epoch and rekey the sending manager
+  _sendKey.ratchet(&_sendIV);
+  _sendAESGCMMgr.rekey(_sendKey.key);
+
+  // Have the file segments encrypted from now on protected with the key of the new epoch, which
+  // as they are announced after the 'REKEY' message is already known to the connection peer
+  _sendKeyEpoch = _sendKey.epoch;
+
+  // Reset the data protected by the current sending key
+  _sendKeyBytes = 0;
+  _sendKeyOps   = 0;
+
+  LOG_DEBUG("[" + *_connMgr._name + "] Sending key ratcheted to epoch " + std::to_string(_sendKey.epoch))
+ }
+
+
+/**
+ * @brief  Wraps a session message stored in the associated connection's
+ *         secondary buffer into a session message wrapper in the connection's
+ *         primary buffer, sending the resulting wrapper to the connection peer,
+ *         where if the current sending key has reached the SESS_REKEY_MAX_BYTES
+ *         or SESS_REKEY_MAX_OPS limits it is first ratcheted via a 'REKEY' message
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED         The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED               send() fatal error
+ */
+void SessMgr::wrapSendSessMsg()
+ {
+  // If the current sending key has reached its usage limits, ratchet it before sending the session message,
+  // which as no raw data is pending between two session messages the connection peer can follow in sync
+  if(_sendKeyBytes >= SESS_REKEY_MAX_BYTES || _sendKeyOps >= SESS_REKEY_MAX_OPS)
+   sendRekeyMsg();
+
+  // Wrap and send the session message stored in the connection manager's secondary buffer
+  wrapSendSessMsg(&_connMgr._secBuf[0]);
  }
 
 
@@ -504,16 +1191,55 @@ void SessMgr::unwrapSessMsg()
   /* ---------------------- Session Message Decryption ---------------------- */
 
   // Initialize an AES_128_GCM decryption operation
-  _aesGCMMgr.decryptInit();
+  _recvAESGCMMgr.decryptInit();
 
   // Set the decryption operation's AAD to the session message wrapper size
-  _aesGCMMgr.decryptAddAAD(reinterpret_cast<unsigned char*>(&sessWrapSize), sizeof(sessWrapSize));
+  _recvAESGCMMgr.decryptAddAAD(reinterpret_cast<unsigned char*>(&sessWrapSize), sizeof(sessWrapSize));
 
   // Decrypt the wrapped session message from the primary into the secondary connection buffer
-  _aesGCMMgr.decryptAddCT(&_connMgr._priBuf[sizeof(uint16_t)], sessMsgSize, &_connMgr._secBuf[0]);
+  _recvAESGCMMgr.decryptAddCT(&_connMgr._priBuf[sizeof(uint16_t)], sessMsgSize, &_connMgr._secBuf[0]);
 
   // Finalize the decryption by verifying the session wrapper's integrity tag
-  _aesGCMMgr.decryptFinal(&_connMgr._priBuf[sessWrapSize - AES_128_GCM_TAG_SIZE]);
+  _recvAESGCMMgr.decryptFinal(&_connMgr._priBuf[sessWrapSize - AES_128_GCM_TAG_SIZE]);
+ }
+
+
+/**
+ * @brief  If the session message unwrapped in the associated connection's secondary buffer is a
+ *         'REKEY' message, ratchets the receiving key and the session messages' receiving IV into
+ *         the ones of the key's next epoch, which the following session messages are wrapped with
+ * @return 'true' if the unwrapped session message was a 'REKEY' message, or 'false' otherwise
+ * @throws ERR_SESSABORT_INVALID_KEY_EPOCH 'REKEY' message of invalid length
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW       EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT   Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE        Key derivation failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE     Invalid AES_128_GCM manager state
+ * @note   As the peer has already ratcheted its sending key, a 'REKEY' message must
+ *         be processed before any other session message following it is unwrapped
+ */
+bool SessMgr::recvRekeyMsg()
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a base session message
+  SessMsg* sessMsg = reinterpret_cast<SessMsg*>(_connMgr._secBuf);
+
+  // If the unwrapped session message is not a 'REKEY' message, it must be handled by the caller
+  if(sessMsg->msgType != REKEY)
+   return false;
+
+  // As the connection peer has already ratcheted its sending key, a malformed
+  // 'REKEY' message cannot be notified and requires the connection to be dropped
+  if(sessMsg->msgLen != sizeof(SessMsg))
+   THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_KEY_EPOCH, "'REKEY' message of length " + std::to_string(sessMsg->msgLen));
+
+  // Ratchet the receiving key and the session messages' receiving IV
+  // into the ones of the next epoch and rekey the receiving manager
+  _recvKey.ratchet(&_recvIV);
+  _recvAESGCMMgr.rekey(_recvKey.key);
+
+  LOG_DEBUG("[" + *_connMgr._name + "] Receiving key ratcheted to epoch " + std::to_string(_recvKey.epoch))
+
+  return true;
  }
 
 
@@ -553,6 +1279,9 @@ void SessMgr::sendSessSignalMsg(SessMsgType sessMsgSignalingType) // NOLINT(misc
   // Set the session message type to the specified type
   sessSignalMsg->msgType = sessMsgSignalingType;
 
+  // Set the session message stream to the current stream
+  sessSignalMsg->streamId = _stream->streamId;
+
   // Wrap and send the session signaling message
   wrapSendSessMsg();
  }
@@ -561,10 +1290,10 @@ void SessMgr::sendSessSignalMsg(SessMsgType sessMsgSignalingType) // NOLINT(misc
 /**
  * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgFileInfo'
  *         session message of the specified type containing the name and metadata of the main
- *         file referred by the '_mainFileInfo' attribute, for then wrapping and sending the
+ *         file referred by the 'mainFileInfo' attribute, for then wrapping and sending the
  *         resulting session message wrapper to the connection peer
  * @param  sessMsgType The 'SessMsgFileInfo' session message type (FILE_UPLOAD_REQ || FILE_EXISTS)
- * @throws ERR_SESS_INTERNAL_ERROR      Invalid 'sessMsgType' or uninitialized '_mainFileInfo' attribute
+ * @throws ERR_SESS_INTERNAL_ERROR      Invalid 'sessMsgType' or uninitialized 'mainFileInfo' attribute
  * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
@@ -584,12 +1313,12 @@ void SessMgr::sendSessMsgFileInfo(SessMsgType sessMsgType)
                                             "type (" + std::to_string(sessMsgType) + ")");
    }
 
-  // Ensure the '_mainFileInfo' attribute to have been initialized
-  if(_mainFileInfo == nullptr)
+  // Ensure the 'mainFileInfo' attribute to have been initialized
+  if(_stream->mainFileInfo == nullptr)
    {
     sendSessSignalMsg(ERR_INTERNAL_ERROR);
     THROW_SESS_EXCP(ERR_SESS_INTERNAL_ERROR,"Attempting to prepare a 'SessMsgFileInfo' "
-                                            "message with a NULL _mainFileInfo");
+                                            "message with a NULL 'mainFileInfo'");
    }
 
   // Interpret the contents of the connection manager's
@@ -599,18 +1328,24 @@ void SessMgr::sendSessMsgFileInfo(SessMsgType sessMsgType)
   // Set the 'SessMsgFileInfo' message type to the provided argument
   sessMsgFileInfoMsg->msgType = sessMsgType;
 
+  // Set the 'SessMsgFileInfo' message stream to the current stream
+  sessMsgFileInfoMsg->streamId = _stream->streamId;
+
   // Set the length of the 'SessMsgFileInfo' message to the length of its struct + the main file name
   // length (+1 for the '/0' character, -1 for the 'fileName' placeholder attribute in the struct)
-  sessMsgFileInfoMsg->msgLen = sizeof(SessMsgFileInfo) + _mainFileInfo->fileName.length();
+  sessMsgFileInfoMsg->msgLen = sizeof(SessMsgFileInfo) + _stream->mainFileInfo->fileName.length();
 
   // Write the main file's metadata into the 'SessMsgFileInfo' message
-  sessMsgFileInfoMsg->fileSize     = _mainFileInfo->meta->fileSizeRaw;
-  sessMsgFileInfoMsg->lastModTime  = _mainFileInfo->meta->lastModTimeRaw;
-  sessMsgFileInfoMsg->creationTime = _mainFileInfo->meta->creationTimeRaw;
+  sessMsgFileInfoMsg->fileSize     = _stream->mainFileInfo->meta->fileSizeRaw;
+  sessMsgFileInfoMsg->lastModTime  = _stream->mainFileInfo->meta->lastModTimeRaw;
+  sessMsgFileInfoMsg->creationTime = _stream->mainFileInfo->meta->creationTimeRaw;
+
+  // Write the stream's file transfer flags into the 'SessMsgFileInfo' message
+  sessMsgFileInfoMsg->xferFlags = _stream->authOnly ? SESS_XFER_AUTH_ONLY : 0;
 
   // Write the main file name, '/0' character included, into the 'SessMsgFileInfo' message
   memcpy(reinterpret_cast<char*>(&sessMsgFileInfoMsg->fileName),
-         _mainFileInfo->fileName.c_str(), _mainFileInfo->fileName.length() + 1);
+         _stream->mainFileInfo->fileName.c_str(), _stream->mainFileInfo->fileName.length() + 1);
 
   // Wrap the 'SessMsgFileInfo' message into its associated
   // session message wrapper and send it to the connection peer
@@ -650,10 +1385,16 @@ void SessMgr::sendSessMsgFileName(SessMsgType sessMsgType, std::string& fileName
   // Set the 'SessMsgFileName' message type to the provided argument
   sessMsgFileNameMsg->msgType = sessMsgType;
 
+  // Set the 'SessMsgFileName' message stream to the current stream
+  sessMsgFileNameMsg->streamId = _stream->streamId;
+
   // Set the length of the 'SessMsgFileName' message to the length of its struct + the fileName
   // length (+1 for the '/0' character, -1 for the 'fileName' placeholder attribute in the struct)
   sessMsgFileNameMsg->msgLen = sizeof(SessMsgFileName) + fileName.length();
 
+  // Write the stream's file transfer flags into the 'SessMsgFileName' message
+  sessMsgFileNameMsg->xferFlags = _stream->authOnly ? SESS_XFER_AUTH_ONLY : 0;
+
   // Write the fileName, '/0' character included, into the 'SessMsgFileName' message
   memcpy(reinterpret_cast<char*>(&sessMsgFileNameMsg->fileName),
          fileName.c_str(), fileName.length() + 1);
@@ -689,6 +1430,9 @@ void SessMgr::sendSessMsgFileRename(std::string& oldFilename, std::string& newFi
   // Set the 'SessMsgFileRename' message type to the implicit 'FILE_RENAME_REQUEST'
   sessMsgFileRenameMsg->msgType = FILE_RENAME_REQ;
 
+  // Set the 'SessMsgFileRename' message stream to the current stream
+  sessMsgFileRenameMsg->streamId = _stream->streamId;
+
   // Set the old filename length, '/0' character included, in the 'SessMsgFileRename' message
   sessMsgFileRenameMsg->oldFilenameLen = oldFilename.length() + 1;
 
@@ -713,7 +1457,7 @@ void SessMgr::sendSessMsgFileRename(std::string& oldFilename, std::string& newFi
 /**
  * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgPoolSize'
  *         session message of implicit type 'POOL_SIZE' containing the serialized size of
- *         the user's storage pool store in the '_rawBytesRem' attribute, for then wrapping
+ *         the user's storage pool store in the 'rawBytesRem' attribute, for then wrapping
  *         and sending the resulting session message wrapper to the connection peer
  * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
@@ -733,12 +1477,23 @@ void SessMgr::sendSessMsgPoolSize()
   // Set the 'SessMsgPoolSize' message type to the implicit 'POOL_SIZE'
   sessMsgPoolSizeMsg->msgType = POOL_SIZE;
 
-  // Set the 'SessMsgPoolSize' message length
-  sessMsgPoolSizeMsg->msgLen = sizeof(SessMsgPoolSize);
+  // Set the 'SessMsgPoolSize' message stream to the current stream
+  sessMsgPoolSizeMsg->streamId = _stream->streamId;
 
-  // Set the serialized size of the user's storage pool into the
-  // 'SessMsgPoolSize' message to the value of the '_rawBytesRem' attribute
-  sessMsgPoolSizeMsg->serPoolSize = _rawBytesRem;
+  // Set the 'SessMsgPoolSize' message length and the serialized size of the user's storage
+  // pool to the value of the 'rawBytesRem' attribute, where on connections not supporting
+  // 64-bit sizes the message carries its legacy 32-bit size (the server having ensured
+  // the storage pool's serialized size to fit it, see 'SrvSessMgr::listStartCallback()')
+  if(_connMgr._largeFiles)
+   {
+    sessMsgPoolSizeMsg->msgLen = sizeof(SessMsgPoolSize);
+    sessMsgPoolSizeMsg->serPoolSize = _stream->rawBytesRem;
+   }
+  else
+   {
+    sessMsgPoolSizeMsg->msgLen = sizeof(SessMsgPoolSizeLegacy);
+    reinterpret_cast<SessMsgPoolSizeLegacy*>(sessMsgPoolSizeMsg)->serPoolSize = (uint32_t)_stream->rawBytesRem;
+   }
 
   // Wrap the 'SessMsgPoolSize' message into its associated
   // session message wrapper and send it to the connection peer
@@ -746,13 +1501,267 @@ void SessMgr::sendSessMsgPoolSize()
  }
 
 
+/**
+ * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgUploadResume' session
+ *         message of implicit type 'UPLOAD_RESUME' containing the offset from which the upload of the current
+ *         stream is resumed stored in its 'rawOffset' attribute, for then wrapping and sending the resulting
+ *         session message wrapper to the connection peer
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SessMgr::sendSessMsgUploadResume()
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgUploadResume' session message
+  SessMsgUploadResume* uploadResumeMsg = reinterpret_cast<SessMsgUploadResume*>(_connMgr._secBuf);
+
+  // Set the 'SessMsgUploadResume' message length, type and stream
+  uploadResumeMsg->msgLen   = sizeof(SessMsgUploadResume);
+  uploadResumeMsg->msgType  = UPLOAD_RESUME;
+  uploadResumeMsg->streamId = _stream->streamId;
+
+  // Set the offset from which the upload is resumed
+  uploadResumeMsg->offset = _stream->rawOffset;
+
+  // Wrap the 'SessMsgUploadResume' message into its associated
+  // session message wrapper and send it to the connection peer
+  wrapSendSessMsg();
+ }
+
+
+/**
+ * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgDownloadRange' session
+ *         message of implicit type 'DOWNLOAD_RANGE' confirming the download of the current stream's file from
+ *         the offset and for the length stored in its 'rawOffset' and 'rawLength' attributes, for then wrapping
+ *         and sending the resulting session message wrapper to the connection peer
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SessMgr::sendSessMsgDownloadRange()
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgDownloadRange' session message
+  SessMsgDownloadRange* downloadRangeMsg = reinterpret_cast<SessMsgDownloadRange*>(_connMgr._secBuf);
+
+  // Set the 'SessMsgDownloadRange' message length, type and stream
+  downloadRangeMsg->msgLen   = sizeof(SessMsgDownloadRange);
+  downloadRangeMsg->msgType  = DOWNLOAD_RANGE;
+  downloadRangeMsg->streamId = _stream->streamId;
+
+  // Set the byte range of the file to be downloaded
+  downloadRangeMsg->offset = _stream->rawOffset;
+  downloadRangeMsg->length = _stream->rawLength;
+
+  // Wrap the 'SessMsgDownloadRange' message into its associated
+  // session message wrapper and send it to the connection peer
+  wrapSendSessMsg();
+ }
+
+
+/**
+ * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgUploadDigest' session
+ *         message of implicit type 'UPLOAD_DIGEST' containing the digest of the contents of the current stream's
+ *         file to be uploaded, for then wrapping and sending the resulting session message wrapper to the
+ *         connection peer
+ * @param  digest The SHA-256 digest of the contents of the file to be uploaded
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SessMgr::sendSessMsgUploadDigest(const unsigned char* digest)
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgUploadDigest' session message
+  SessMsgUploadDigest* uploadDigestMsg = reinterpret_cast<SessMsgUploadDigest*>(_connMgr._secBuf);
+
+  // Set the 'SessMsgUploadDigest' message length, type and stream
+  uploadDigestMsg->msgLen   = sizeof(SessMsgUploadDigest);
+  uploadDigestMsg->msgType  = UPLOAD_DIGEST;
+  uploadDigestMsg->streamId = _stream->streamId;
+
+  // Set the digest of the file's contents
+  memcpy(uploadDigestMsg->digest, digest, FILE_DIGEST_SIZE);
+
+  // Wrap the 'SessMsgUploadDigest' message into its associated
+  // session message wrapper and send it to the connection peer
+  wrapSendSessMsg();
+ }
+
+
+/**
+ * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgDeltaSigs' session message
+ *         of implicit type 'DELTA_SIGNATURES' containing the signatures of the blocks of the server's copy of the
+ *         current stream's file to be uploaded, as computed in full by its 'fileDelta' object, for then
+ *         wrapping and sending the resulting session message wrapper to the connection peer
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SessMgr::sendSessMsgDeltaSigs()
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgDeltaSigs' session message
+  SessMsgDeltaSigs* deltaSigsMsg = reinterpret_cast<SessMsgDeltaSigs*>(_connMgr._secBuf);
+
+  // Set the size of the server's copy of the file and the size and number of its blocks
+  deltaSigsMsg->baseSize  = (uint64_t)_stream->mainFileInfo->meta->fileSizeRaw;
+  deltaSigsMsg->blockSize = _stream->fileDelta->getBlockSize();
+  deltaSigsMsg->numBlocks = _stream->fileDelta->getNumBlocks();
+
+  // Copy the blocks' signatures into the message
+  memcpy(deltaSigsMsg->sigs, _stream->fileDelta->getSigs(), deltaSigsMsg->numBlocks * sizeof(DeltaBlockSig));
+
+  // Set the 'SessMsgDeltaSigs' message length, type and stream
+  deltaSigsMsg->msgLen   = (uint16_t)(sizeof(SessMsgDeltaSigs) + deltaSigsMsg->numBlocks * sizeof(DeltaBlockSig));
+  deltaSigsMsg->msgType  = DELTA_SIGNATURES;
+  deltaSigsMsg->streamId = _stream->streamId;
+
+  // Wrap the 'SessMsgDeltaSigs' message into its associated
+  // session message wrapper and send it to the connection peer
+  wrapSendSessMsg();
+ }
+
+
+/**
+ * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgUploadDelta' session
+ *         message of implicit type 'UPLOAD_DELTA' announcing that the raw contents of the current stream's
+ *         file to be uploaded are sent as its delta against the server's copy, for then wrapping and sending
+ *         the resulting session message wrapper to the connection peer
+ * @param  deltaSize The size of the file's delta
+ * @param  digest    The SHA-256 digest of the contents of the file to be uploaded
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SessMgr::sendSessMsgUploadDelta(uint64_t deltaSize, const unsigned char* digest)
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgUploadDelta' session message
+  SessMsgUploadDelta* uploadDeltaMsg = reinterpret_cast<SessMsgUploadDelta*>(_connMgr._secBuf);
+
+  // Set the 'SessMsgUploadDelta' message length, type and stream
+  uploadDeltaMsg->msgLen   = sizeof(SessMsgUploadDelta);
+  uploadDeltaMsg->msgType  = UPLOAD_DELTA;
+  uploadDeltaMsg->streamId = _stream->streamId;
+
+  // Set the size of the file's delta and the digest of its contents
+  uploadDeltaMsg->deltaSize = deltaSize;
+  memcpy(uploadDeltaMsg->digest, digest, FILE_DIGEST_SIZE);
+
+  // Wrap the 'SessMsgUploadDelta' message into its associated
+  // session message wrapper and send it to the connection peer
+  wrapSendSessMsg();
+ }
+
+
+/**
+ * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgFileSegment'
+ *         session message of implicit type 'FILE_SEGMENT' announcing a file raw contents' segment of
+ *         the specified stream, plaintext and wire size and key epoch, for then wrapping and sending
+ *         the resulting session message wrapper to the connection peer
+ * @param  stream   The stream the file segment belongs to
+ * @param  segSize  The file segment's plaintext size
+ * @param  wireSize The file segment's wire size
+ * @param  keyEpoch The epoch of the sending key the segment's chunks have been encrypted with
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED         The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED               send() fatal error
+ */
+void SessMgr::sendSessMsgFileSegment(SessStream& stream, unsigned int segSize, unsigned int wireSize, uint32_t keyEpoch)
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgFileSegment' session message
+  SessMsgFileSegment* sessMsgFileSegmentMsg = reinterpret_cast<SessMsgFileSegment*>(_connMgr._secBuf);
+
+  // Set the 'SessMsgFileSegment' message type to the implicit 'FILE_SEGMENT'
+  sessMsgFileSegmentMsg->msgType = FILE_SEGMENT;
+
+  // Set the 'SessMsgFileSegment' message stream to the segment's stream
+  sessMsgFileSegmentMsg->streamId = stream.streamId;
+
+  // Set the 'SessMsgFileSegment' message length and segment plaintext and wire sizes
+  sessMsgFileSegmentMsg->msgLen   = sizeof(SessMsgFileSegment);
+  sessMsgFileSegmentMsg->segSize  = segSize;
+  sessMsgFileSegmentMsg->wireSize = wireSize;
+
+  // Set the 'SessMsgFileSegment' message key epoch of the segment's chunks
+  sessMsgFileSegmentMsg->keyEpoch = keyEpoch;
+
+  // Account the segment's chunks in the data protected by the current sending key
+  // (conservatively, as they may have been encrypted with a previous epoch's key)
+  _sendKeyBytes += wireSize;
+  _sendKeyOps   += (segSize + FILE_CHUNK_SIZE - 1) / FILE_CHUNK_SIZE;
+
+  // Wrap the 'SessMsgFileSegment' message into its associated
+  // session message wrapper and send it to the connection peer
+  wrapSendSessMsg();
+ }
+
+
 /* ------------------------- Session Messages Reception ------------------------- */
 
 /**
- * @brief Validates and loads into a FileInfo object pointed by the '_remFileInfo' attribute
+ * @brief  Validates and applies to the current stream the file transfer
+ *         flags embedded within a received session message
+ * @param  xferFlags The received file transfer flags
+ * @throws ERR_SESS_MALFORMED_MESSAGE Unknown file transfer flags
+ */
+void SessMgr::loadSessMsgXferFlags(uint8_t xferFlags)
+ {
+  // Flags unknown to this SafeCloud version imply that a malformed message was received
+  if(xferFlags & ~SESS_XFER_FLAGS)
+   {
+    sendSessSignalMsg(ERR_MALFORMED_SESS_MESSAGE);
+    THROW_SESS_EXCP(ERR_SESS_MALFORMED_MESSAGE,"Unknown file transfer flags ("
+                                               + std::to_string(xferFlags) + ")");
+   }
+
+  // Set whether the stream's file chunks are authenticated only
+  _stream->authOnly = (xferFlags & SESS_XFER_AUTH_ONLY);
+ }
+
+
+/**
+ * @brief Validates and loads into a FileInfo object pointed by the 'remFileInfo' attribute
  *        the name and metadata of a remote file embedded within a 'SessMsgFileInfo'
  *        session message stored in the associated connection manager's secondary buffer
- * @throws ERR_SESS_MALFORMED_MESSAGE Invalid file values in the 'SessMsgFileInfo' message
+ * @throws ERR_SESS_MALFORMED_MESSAGE Invalid file values or unknown file
+ *                                    transfer flags in the 'SessMsgFileInfo' message
  */
 void SessMgr::loadRemSessMsgFileInfo()
  {
@@ -766,12 +1775,12 @@ void SessMgr::loadRemSessMsgFileInfo()
   // Extract the remote file name from the 'SessMsgFileInfo' session message
   std::string remFileName(reinterpret_cast<char*>(fileInfoMsg->fileName),remFileNameLength);
 
-  // Attempt to re-initialize the '_remFileInfo' attribute with the remote file information
-  delete _remFileInfo;
+  // Attempt to re-initialize the 'remFileInfo' attribute with the remote file information
+  delete _stream->remFileInfo;
 
   try
    {
-    _remFileInfo = new FileInfo(remFileName,fileInfoMsg->fileSize,
+    _stream->remFileInfo = new FileInfo(remFileName,fileInfoMsg->fileSize,
                                  fileInfoMsg->lastModTime,fileInfoMsg->creationTime);
    }
 
@@ -781,16 +1790,20 @@ void SessMgr::loadRemSessMsgFileInfo()
     sendSessSignalMsg(ERR_MALFORMED_SESS_MESSAGE);
     THROW_SESS_EXCP(ERR_SESS_MALFORMED_MESSAGE,"Invalid file values in the 'SessMsgFileInfo' message");
    }
+
+  // Load the transfer flags embedded in the 'SessMsgFileInfo' message
+  loadSessMsgXferFlags(fileInfoMsg->xferFlags);
  }
 
 
 /**
  * @brief  Validates the 'fileName' string embedded within a 'SessMsgFileName'
  *         session message stored in the associated connection manager's secondary
- *         buffer and initializes the '_mainFileAbsPath' attribute to the
+ *         buffer and initializes the 'mainFileAbsPath' attribute to the
  *         concatenation of the session's main directory with such file name
  * @return The file name embedded in the 'SessMsgFileName' session message
- * @throws ERR_SESS_MALFORMED_MESSAGE The 'fileName' string does not represent a valid Linux file name
+ * @throws ERR_SESS_MALFORMED_MESSAGE The 'fileName' string does not represent a valid
+ *                                    Linux file name or unknown file transfer flags
  */
 std::string SessMgr::loadMainSessMsgFileName()
  {
@@ -808,9 +1821,12 @@ std::string SessMgr::loadMainSessMsgFileName()
   // Assert the received file name string to consist of a valid Linux file name
   validateRecvFileName(fileName);
 
-  // Initialize the '_mainFileAbsPath' attribute to the concatenation
+  // Load the transfer flags embedded in the 'SessMsgFileName' message
+  loadSessMsgXferFlags(sessFileNameMsg->xferFlags);
+
+  // Initialize the 'mainFileAbsPath' attribute to the concatenation
   // of the session's main directory with such file name
-  _mainFileAbsPath = new std::string(*_mainDirAbsPath + fileName);
+  _stream->mainFileAbsPath = new std::string(*_mainDirAbsPath + fileName);
 
   // Return file name embedded in the 'SessMsgFileName' session message
   return fileName;
@@ -858,7 +1874,7 @@ void SessMgr::loadSessMsgFileRename(std::string** oldFilenameDest, std::string**
 
 /**
  * @brief Reads the serialized size of a user's storage pool from a
- *        'SessMsgPoolSize' session  message into the '_rawBytesRem' attribute
+ *        'SessMsgPoolSize' session  message into the 'rawBytesRem' attribute
  */
 void SessMgr::loadSessMsgPoolSize()
  {
@@ -866,37 +1882,269 @@ void SessMgr::loadSessMsgPoolSize()
   // secondary buffer as a 'SessMsgPoolSize' session message
   SessMsgPoolSize* sessMsgPoolSizeMsg = reinterpret_cast<SessMsgPoolSize*>(_connMgr._secBuf);
 
-  // Copy the serialized contents' size of the user's
-  // storage pool into the '_rawBytesRem' attribute
-  _rawBytesRem = sessMsgPoolSizeMsg->serPoolSize;
+  // Copy the serialized contents' size of the user's storage pool into the 'rawBytesRem'
+  // attribute, where connections not supporting 64-bit sizes carry its legacy 32-bit size
+  if(_connMgr._largeFiles)
+   _stream->rawBytesRem = sessMsgPoolSizeMsg->serPoolSize;
+  else
+   _stream->rawBytesRem = reinterpret_cast<SessMsgPoolSizeLegacy*>(sessMsgPoolSizeMsg)->serPoolSize;
+ }
+
+
+/**
+ * @brief  Validates and loads into the 'rawOffset' attribute the offset from which the upload of the current
+ *         stream is resumed embedded within a 'SessMsgUploadResume' session message stored in the associated
+ *         connection manager's secondary buffer, which must be a positive multiple of FILE_CHUNK_SIZE smaller
+ *         than the size of the file being uploaded (specified in its 'mainFileInfo' object)
+ * @throws ERR_SESS_MALFORMED_MESSAGE Invalid message length or upload offset
+ */
+void SessMgr::loadSessMsgUploadResume()
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgUploadResume' session message
+  SessMsgUploadResume* uploadResumeMsg = reinterpret_cast<SessMsgUploadResume*>(_connMgr._secBuf);
+
+  // Assert the message length and the upload offset to be valid, where
+  // an upload's offset cannot be announced more than once
+  if(_recvSessMsgLen != sizeof(SessMsgUploadResume) || _stream->rawOffset != 0 || uploadResumeMsg->offset == 0 ||
+     uploadResumeMsg->offset % FILE_CHUNK_SIZE != 0 ||
+     uploadResumeMsg->offset >= (uint64_t)_stream->mainFileInfo->meta->fileSizeRaw)
+   {
+    sendSessSignalMsg(ERR_MALFORMED_SESS_MESSAGE);
+    THROW_SESS_EXCP(ERR_SESS_MALFORMED_MESSAGE,"Invalid 'SessMsgUploadResume' message (length = "
+                                               + std::to_string(_recvSessMsgLen) + ", offset = "
+                                               + std::to_string(uploadResumeMsg->offset) + ")");
+   }
+
+  _stream->rawOffset = uploadResumeMsg->offset;
+ }
+
+
+/**
+ * @brief  Validates and loads into the 'rawOffset' and 'rawLength' attributes the byte range of the file of the
+ *         current stream to be downloaded embedded within a 'SessMsgDownloadRange' session message stored in
+ *         the associated connection manager's secondary buffer, which must start before the end of the file
+ *         to be downloaded (specified in its 'mainFileInfo' object) and not extend past it
+ * @throws ERR_SESS_MALFORMED_MESSAGE Invalid message length or byte range
+ */
+void SessMgr::loadSessMsgDownloadRange()
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgDownloadRange' session message
+  SessMsgDownloadRange* downloadRangeMsg = reinterpret_cast<SessMsgDownloadRange*>(_connMgr._secBuf);
+
+  // The size of the file to be downloaded
+  uint64_t fileSize = (uint64_t)_stream->mainFileInfo->meta->fileSizeRaw;
+
+  // Assert the message length and the byte range to be valid, where the
+  // range's length is checked against the file's bytes past its offset
+  if(_recvSessMsgLen != sizeof(SessMsgDownloadRange) || downloadRangeMsg->offset >= fileSize ||
+     downloadRangeMsg->length > fileSize - downloadRangeMsg->offset)
+   {
+    sendSessSignalMsg(ERR_MALFORMED_SESS_MESSAGE);
+    THROW_SESS_EXCP(ERR_SESS_MALFORMED_MESSAGE,"Invalid 'SessMsgDownloadRange' message (length = "
+                                               + std::to_string(_recvSessMsgLen) + ", offset = "
+                                               + std::to_string(downloadRangeMsg->offset) + ", range length = "
+                                               + std::to_string(downloadRangeMsg->length) + ")");
+   }
+
+  _stream->rawOffset = downloadRangeMsg->offset;
+  _stream->rawLength = downloadRangeMsg->length;
+ }
+
+
+/**
+ * @brief  Validates and loads the digest of the contents of the current stream's file to be uploaded
+ *         embedded within a 'SessMsgUploadDigest' session message stored in the associated
+ *         connection manager's secondary buffer
+ * @param  digest The buffer the SHA-256 digest of the file's contents is loaded into
+ * @throws ERR_SESS_MALFORMED_MESSAGE Invalid message length
+ */
+void SessMgr::loadSessMsgUploadDigest(unsigned char* digest)
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgUploadDigest' session message
+  SessMsgUploadDigest* uploadDigestMsg = reinterpret_cast<SessMsgUploadDigest*>(_connMgr._secBuf);
+
+  // Assert the message length to be valid
+  if(_recvSessMsgLen != sizeof(SessMsgUploadDigest))
+   {
+    sendSessSignalMsg(ERR_MALFORMED_SESS_MESSAGE);
+    THROW_SESS_EXCP(ERR_SESS_MALFORMED_MESSAGE,"Invalid 'SessMsgUploadDigest' message (length = "
+                                               + std::to_string(_recvSessMsgLen) + ")");
+   }
+
+  memcpy(digest, uploadDigestMsg->digest, FILE_DIGEST_SIZE);
+ }
+
+
+/**
+ * @brief  Validates and loads into the current stream's 'fileDelta' object the signatures of the blocks of the
+ *         server's copy of the file to be uploaded embedded within a 'SessMsgDeltaSigs' session message stored
+ *         in the associated connection manager's secondary buffer, where the copy's size must be the one
+ *         specified in the 'remFileInfo' object and its blocks must be at least FILE_DELTA_MIN_BLOCK bytes,
+ *         no more than FILE_DELTA_MAX_BLOCKS and consistent with such size and the message length
+ * @throws ERR_SESS_MALFORMED_MESSAGE Invalid message length or blocks
+ */
+void SessMgr::loadSessMsgDeltaSigs()
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgDeltaSigs' session message
+  SessMsgDeltaSigs* deltaSigsMsg = reinterpret_cast<SessMsgDeltaSigs*>(_connMgr._secBuf);
+
+  // Assert the message length, the size of the server's copy of the file and
+  // the size and number of its blocks to be valid and consistent
+  if(_recvSessMsgLen < sizeof(SessMsgDeltaSigs) ||
+     deltaSigsMsg->baseSize != (uint64_t)_stream->remFileInfo->meta->fileSizeRaw ||
+     deltaSigsMsg->blockSize < FILE_DELTA_MIN_BLOCK || deltaSigsMsg->numBlocks > FILE_DELTA_MAX_BLOCKS ||
+     deltaSigsMsg->numBlocks != (deltaSigsMsg->baseSize + deltaSigsMsg->blockSize - 1) / deltaSigsMsg->blockSize ||
+     _recvSessMsgLen != sizeof(SessMsgDeltaSigs) + deltaSigsMsg->numBlocks * sizeof(DeltaBlockSig))
+   {
+    sendSessSignalMsg(ERR_MALFORMED_SESS_MESSAGE);
+    THROW_SESS_EXCP(ERR_SESS_MALFORMED_MESSAGE,"Invalid 'SessMsgDeltaSigs' message (length = "
+                                               + std::to_string(_recvSessMsgLen) + ", base size = "
+                                               + std::to_string(deltaSigsMsg->baseSize) + ", block size = "
+                                               + std::to_string(deltaSigsMsg->blockSize) + ", blocks = "
+                                               + std::to_string(deltaSigsMsg->numBlocks) + ")");
+   }
+
+  _stream->fileDelta->loadSigs(deltaSigsMsg->blockSize, deltaSigsMsg->numBlocks, deltaSigsMsg->sigs);
+ }
+
+
+/**
+ * @brief  Validates and loads into the 'rawLength' attribute the size of the delta of the current stream's
+ *         file to be uploaded and the digest of its contents embedded within a 'SessMsgUploadDelta' session
+ *         message stored in the associated connection manager's secondary buffer
+ * @param  digest The buffer the SHA-256 digest of the file's contents is loaded into
+ * @throws ERR_SESS_MALFORMED_MESSAGE Invalid message length or delta size
+ */
+void SessMgr::loadSessMsgUploadDelta(unsigned char* digest)
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgUploadDelta' session message
+  SessMsgUploadDelta* uploadDeltaMsg = reinterpret_cast<SessMsgUploadDelta*>(_connMgr._secBuf);
+
+  // Assert the message length and the delta size to be valid
+  if(_recvSessMsgLen != sizeof(SessMsgUploadDelta) || uploadDeltaMsg->deltaSize == 0)
+   {
+    sendSessSignalMsg(ERR_MALFORMED_SESS_MESSAGE);
+    THROW_SESS_EXCP(ERR_SESS_MALFORMED_MESSAGE,"Invalid 'SessMsgUploadDelta' message (length = "
+                                               + std::to_string(_recvSessMsgLen) + ", delta size = "
+                                               + std::to_string(uploadDeltaMsg->deltaSize) + ")");
+   }
+
+  _stream->rawLength = uploadDeltaMsg->deltaSize;
+  memcpy(digest, uploadDeltaMsg->digest, FILE_DIGEST_SIZE);
+ }
+
+
+/**
+ * @brief  Reads and validates the plaintext and wire sizes of the file segment of the current stream
+ *         announced by a 'SessMsgFileSegment' session message, where the plaintext size must be positive,
+ *         not exceed neither the maximum segment size nor the stream's file bytes yet to be announced and
+ *         consist of whole chunks unless it is the file's last segment, while the wire size must exceed the
+ *         segment's integrity tags and chunks' sizes table and not exceed the segment's maximum wire size,
+ *         to which it must be equal if the file transfers are not compressed, and its key epoch must be
+ *         neither older than the previous segment's nor newer than the current receiving key's
+ * @param  bytesRem The stream's file bytes yet to be announced
+ * @param  wireSize Where to write the announced file segment's wire size
+ * @param  keyEpoch Where to write the announced file segment's key epoch
+ * @return The announced file segment's plaintext size
+ * @throws ERR_SESSABORT_INVALID_FILE_SEGMENT The stream is not expecting a file segment or
+ *                                            the announced segment sizes are invalid
+ * @throws ERR_SESSABORT_INVALID_KEY_EPOCH    Invalid announced segment key epoch
+ * @note   As the segment's raw contents immediately follow its announcement,
+ *         an invalid announcement requires the connection to be dropped
+ */
+unsigned int SessMgr::loadSessMsgFileSegment(uint64_t bytesRem, unsigned int& wireSize, uint32_t& keyEpoch)
+ {
+  // Interpret the contents of the connection manager's
+  // secondary buffer as a 'SessMsgFileSegment' session message
+  SessMsgFileSegment* sessMsgFileSegmentMsg = reinterpret_cast<SessMsgFileSegment*>(_connMgr._secBuf);
+
+  // The announced file segment's plaintext size
+  unsigned int segSize;
+
+  // Assert the message length and the stream to be expecting a file's raw contents
+  if(_recvSessMsgLen != sizeof(SessMsgFileSegment) || _stream->opStep != WAITING_RAW)
+   THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_SEGMENT, "stream " + std::to_string(_stream->streamId)
+                                                       + ", operation " + sessMgrOpToStrUpCase()
+                                                       + ", step " + sessMgrOpStepToStrUpCase());
+
+  segSize = sessMsgFileSegmentMsg->segSize;
+
+  // Assert the segment size to be valid for the file's remaining raw contents
+  if(segSize == 0 || segSize > FILE_SEGMENT_SIZE || segSize > bytesRem ||
+     (segSize % FILE_CHUNK_SIZE != 0 && segSize != bytesRem))
+   THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_SEGMENT, "stream " + std::to_string(_stream->streamId)
+                                                       + ", segSize = " + std::to_string(segSize)
+                                                       + ", bytesRem = " + std::to_string(bytesRem));
+
+  wireSize = sessMsgFileSegmentMsg->wireSize;
+
+  // Assert the wire size to be valid for the segment size (where its consistency
+  // with the segment's chunks' sizes table, if any, is validated upon its reception)
+  if(wireSize > fileSegmentWireSize(segSize) || wireSize <= fileSegmentWireSize(segSize) - segSize ||
+     (!_connMgr._compress && wireSize != fileSegmentWireSize(segSize)))
+   THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_SEGMENT, "stream " + std::to_string(_stream->streamId)
+                                                       + ", segSize = " + std::to_string(segSize)
+                                                       + ", wireSize = " + std::to_string(wireSize));
+
+  keyEpoch = sessMsgFileSegmentMsg->keyEpoch;
+
+  // Assert the key epoch to be neither older than the previous segment's (as segments are announced in the
+  // order they are encrypted) nor newer than the receiving key's (as the peer ratchets its sending key, and
+  // so announces its new epoch via a 'REKEY' message, before encrypting any segment with it)
+  if(keyEpoch < _recvSegKeyEpoch || keyEpoch > _recvKey.epoch)
+   THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_KEY_EPOCH, "stream " + std::to_string(_stream->streamId)
+                                                    + ", keyEpoch = " + std::to_string(keyEpoch)
+                                                    + ", expected " + std::to_string(_recvSegKeyEpoch)
+                                                    + "-" + std::to_string(_recvKey.epoch));
+  _recvSegKeyEpoch = keyEpoch;
+
+  return segSize;
  }
 
 
 /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
 /**
- * @brief Session manager object constructor
- * @param connMgr A reference to the connection manager parent object
- * @param mainDir The session's main directory, consisting in the user's storage pool on
- *                the SafeCloud server or their downloads folder in the client application
+ * @brief Session manager object constructor, deriving from the connection's IV the independent
+ *        IVs used for the session messages and the file chunks of each stream in each direction
+ * @param connMgr    A reference to the connection manager parent object
+ * @param mainDir    The session's main directory, consisting in the user's storage pool on
+ *                   the SafeCloud server or their downloads folder in the client application
+ * @param isServer   Whether the session manager belongs to the SafeCloud server or client
+ * @param aesGCMPool The application's AES_128_GCM workers pool
  */
-SessMgr::SessMgr(ConnMgr& connMgr, std::string* mainDir) :
+SessMgr::SessMgr(ConnMgr& connMgr, std::string* mainDir, bool isServer, AESGCMPool& aesGCMPool) :
 
   /* ------------------------ Constant Session Attributes ------------------------ */
   _connMgr(connMgr), _mainDirAbsPath(mainDir), _tmpDirAbsPath(_connMgr._tmpDir),
 
   /* -------------------------- Session State Attributes -------------------------- */
-  _sessMgrOp(IDLE), _sessMgrOpStep(OP_START), _aesGCMMgr(_connMgr._skey, _connMgr._iv),
-  _mainDirInfo(nullptr), _mainFileAbsPath(nullptr), _mainFileInfo(nullptr), _mainFileDscr(nullptr),
-  _tmpFileAbsPath(nullptr), _tmpFileDscr(nullptr), _remFileInfo(nullptr),
-  _rawBytesRem(0), _recvSessMsgLen(0), _recvSessMsgType(ERR_UNKNOWN_SESSMSG_TYPE)
- {}
+  _sendKey(_connMgr._skey, isServer, false), _recvKey(_connMgr._skey, !isServer, false),
+  _sendChunkKey(_connMgr._skey, isServer, true), _recvChunkKey(_connMgr._skey, !isServer, true),
+  _sendKeyEpoch(0), _sendKeyBytes(0), _sendKeyOps(0), _recvSegKeyEpoch(0),
+  _sendIV(*_connMgr._iv, isServer ? SESS_IV_SRV_TO_CLI : 0), _recvIV(*_connMgr._iv, isServer ? 0 : SESS_IV_SRV_TO_CLI),
+  _sendAESGCMMgr(_sendKey.key, &_sendIV, _connMgr._aeadCipher), _recvAESGCMMgr(_recvKey.key, &_recvIV, _connMgr._aeadCipher),
+  _aesGCMPool(aesGCMPool), _streams(), _stream(nullptr),
+  _recvSessMsgLen(0), _recvSessMsgType(ERR_UNKNOWN_SESSMSG_TYPE), _xferRawBytes(0), _xferWireBytes(0)
+ {
+  // Initialize the session's streams
+  for(uint8_t i = 0; i < SESS_MAX_STREAMS; i++)
+   _streams[i] = new SessStream(i, *_connMgr._iv, isServer ? SESS_IV_SRV_TO_CLI : 0, isServer ? 0 : SESS_IV_SRV_TO_CLI);
+
+  // Operations are carried out on the first stream unless otherwise specified
+  _stream = _streams[0];
+ }
 
 
 /**
- * @brief Session manager object destructor,  performing cleanup operations on the session's
- *        state attributes and resetting the associated connection manager's reception mode
- *        to 'RECV_MSG' and marking the contents of its primary connection buffer as consumed
+ * @brief Session manager object destructor, performing cleanup operations on the session's
+ *        streams and resetting the associated connection manager's reception mode to
+ *        'RECV_MSG' and marking the contents of its primary connection buffer as consumed
  * @note  It is assumed the connection's cryptographic quantities (session key, IV)
  *        to be securely erased by the associated connection manager parent object
  */
@@ -906,29 +2154,14 @@ SessMgr::~SessMgr()
 
   /* ----------------- Session State Attributes Cleanup ----------------- */
 
-  // If open, close the main file
-  if(_mainFileDscr != nullptr)
-   {
-    if(fclose(_mainFileDscr) != 0)
-     LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, *_mainFileAbsPath, ERRNO_DESC);
-   }
-
-  // If open, close and delete the temporary file
-  if(_tmpFileDscr != nullptr)
-   {
-    if(fclose(_tmpFileDscr) != 0)
-     LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, *_tmpFileAbsPath, ERRNO_DESC);
-    else
-     if(remove(_tmpFileAbsPath->c_str()) == -1)
-      LOG_EXEC_CODE(ERR_FILE_DELETE_FAILED, *_tmpFileAbsPath, ERRNO_DESC);
-   }
+  // Delete the session's streams, closing and
+  // deleting their files and dynamic attributes
+  for(SessStream* stream : _streams)
+   delete stream;
 
-  // Delete the session manager state dynamic attributes
-  delete _mainDirInfo;
-  delete _mainFileAbsPath;
-  delete _mainFileInfo;
-  delete _tmpFileAbsPath;
-  delete _remFileInfo;
+  // Free the AES_128_GCM workers pool's managers keyed with the file chunks' keys
+  _aesGCMPool.releaseKey(_sendChunkKey);
+  _aesGCMPool.releaseKey(_recvChunkKey);
 
   /* ----------------- Connection Manager State Cleanup ----------------- */
 
@@ -944,89 +2177,73 @@ SessMgr::~SessMgr()
 /* ============================ OTHER PUBLIC METHODS ============================ */
 
 /**
- * @brief  Returns whether the session manager is idle
+ * @brief  Returns a string reporting the savings of the compression
+ *         of the file transfers carried out in the session
+ * @return The session's compression statistics string
+ */
+std::string SessMgr::compressionStatsStr()
+ { return compressionStatsStr(_xferRawBytes, _xferWireBytes); }
+
+
+/**
+ * @brief  Returns whether the session manager is idle, i.e. no operation is pending on any of its streams
  * @return A boolean indicating whether the connection manager is idle
  */
 bool SessMgr::isIdle()
- { return _sessMgrOp == IDLE; }
+ {
+  for(SessStream* stream : _streams)
+   if(stream->op != IDLE)
+    return false;
+  return true;
+ }
 
 
 /**
- * @brief Reset the session manager state in preparation to the next session operation by
- *        resetting and performing cleanup operation on all its session state attributes
- *        and by resetting the associated connection manager's reception mode to 'RECV_MSG'
+ * @brief Resets the current stream in preparation to its next operation, resetting and performing
+ *        cleanup operations on its operation state attributes, resetting the session's AES_128_GCM
+ *        managers, resetting the associated connection manager's reception mode to 'RECV_MSG'
  *        and by marking the contents of its primary connection buffer as consumed
  */
-void SessMgr::resetSessState()
+void SessMgr::resetStreamState()
  {
-  /* ------------------ Session State Attributes Reset ------------------ */
+  // Reset the current stream's operation state
+  _stream->reset();
 
-  // Reset the session manager current operation and operation step
-  _sessMgrOp     = IDLE;
-  _sessMgrOpStep = OP_START;
-
-  // Reset the state of the AESGCMMgr child object (causing its IV to
+  // Reset the state of the AESGCMMgr child objects (causing their IVs to
   // increment if an encryption or decryption operation was pending)
-  _aesGCMMgr.resetState();
+  _sendAESGCMMgr.resetState();
+  _recvAESGCMMgr.resetState();
 
-  // If present, delete and reset the
-  // contents of the session's main directory
-  if(_mainDirInfo != nullptr)
-   {
-    delete _mainDirInfo;
-    _mainDirInfo = nullptr;
-   }
+  // Reset the associated connection manager's reception mode to 'RECV_MSG'
+  _connMgr._recvMode = ConnMgr::RECV_MSG;
 
-  // If present, reset the main file absolute path
-  if(_mainFileAbsPath != nullptr)
-   {
-    delete _mainFileAbsPath;
-    _mainFileAbsPath = nullptr;
-   }
+  // Mark the contents of the associated connection
+  // manager's primary buffer as consumed
+  _connMgr.clearPriBuf();
+ }
 
-  // If present, delete and reset the main file information
-  if(_mainFileInfo != nullptr)
-   {
-    delete _mainFileInfo;
-    _mainFileInfo = nullptr;
-   }
 
-  // If open, close the main file and reset its descriptor
-  if(_mainFileDscr != nullptr)
-   {
-    if(fclose(_mainFileDscr) != 0)
-     LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, *_mainFileAbsPath, ERRNO_DESC);
-    _mainFileDscr = nullptr;
-   }
-
-  // If present, reset the temporary file absolute path
-  if(_tmpFileAbsPath != nullptr)
-   {
-    delete _tmpFileAbsPath;
-    _tmpFileAbsPath = nullptr;
-   }
+/**
+ * @brief Reset the session manager state in preparation to the next session operations by
+ *        resetting and performing cleanup operation on all its streams and session state
+ *        attributes and by resetting the associated connection manager's reception mode
+ *        to 'RECV_MSG' and by marking the contents of its primary connection buffer as consumed
+ */
+void SessMgr::resetSessState()
+ {
+  /* ------------------ Session State Attributes Reset ------------------ */
 
-  // If open, close the temporary file, delete it and reset its descriptor
-  if(_tmpFileDscr != nullptr)
-   {
-    if(fclose(_tmpFileDscr) != 0)
-     LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, *_tmpFileAbsPath, ERRNO_DESC);
-    else
-     if(remove(_tmpFileAbsPath->c_str()) == -1)
-      LOG_EXEC_CODE(ERR_FILE_DELETE_FAILED, *_tmpFileAbsPath, ERRNO_DESC);
-    _tmpFileDscr = nullptr;
-   }
+  // Reset the operation state of all the session's streams
+  for(SessStream* stream : _streams)
+   stream->reset();
 
-  // If present, delete the information on the remote file
-  if(_remFileInfo != nullptr)
-   {
-    delete _remFileInfo;
-    _remFileInfo = nullptr;
-   }
+  // Operations are carried out on the first stream unless otherwise specified
+  _stream = _streams[0];
 
-  // Reset the number of remaining raw bytes to be
-  // sent or received in a raw data transmission
-  _rawBytesRem = 0;
+  // Reset the state of the AESGCMMgr child objects (causing their IVs to
+  // increment if an encryption or decryption operation was pending)
+  _sendAESGCMMgr.resetState();
+  _recvAESGCMMgr.resetState();
 
   // Reset the length and type of the last received session message
   _recvSessMsgLen = 0;
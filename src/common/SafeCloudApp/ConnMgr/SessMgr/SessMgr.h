@@ -19,9 +19,69 @@
 
 /* ================================== INCLUDES ================================== */
 #include "SafeCloudApp/ConnMgr/SessMgr/AESGCMMgr/AESGCMMgr.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/AESGCMPool/AESGCMPool.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/SessKey/SessKey.h"
 #include "SafeCloudApp/ConnMgr/ConnMgr.h"
 #include "DirInfo/DirInfo.h"
 #include "SessMsg.h"
+#include <atomic>
+
+
+/*
+ * The maximum size in bytes of a file's raw contents chunk, each of which is encrypted and authenticated
+ * as a standalone AES_128_GCM operation, so that chunks can be verified upon reception without having to
+ * receive the entire file first and can be encrypted or decrypted in parallel by the AES_128_GCM workers pool
+ */
+#define FILE_CHUNK_SIZE (64 * 1024)   // 64 KB
+
+/*
+ * The maximum number of chunks in a file's raw contents segment, i.e. the set of chunks that are
+ * encrypted or decrypted together and sent or received in a connection buffer, with each chunk's
+ * ciphertext being followed by its integrity tag (15 chunks per segment with the default sizes)
+ */
+#define FILE_SEGMENT_CHUNKS (CONN_BUF_SIZE / (FILE_CHUNK_SIZE + AES_128_GCM_TAG_SIZE))
+
+// The maximum plaintext size in bytes of a file's raw contents segment
+#define FILE_SEGMENT_SIZE (FILE_SEGMENT_CHUNKS * FILE_CHUNK_SIZE)
+
+/*
+ * The minimum number of chunks in a file's raw contents segment being sent, whose actual number is adapted
+ * during a transfer between this value and FILE_SEGMENT_CHUNKS so to match the connection's bandwidth-delay
+ * product (as the receiver parses segments at chunk granularity, the sender's segment size need not be negotiated)
+ */
+#define FILE_SEGMENT_MIN_CHUNKS 2
+
+/*
+ * The size of the sample of a file chunk that is compressed first for estimating the chunk's compressibility, and the
+ * maximum percentage of its size the sample must be compressed into for the whole chunk to be compressed (so that
+ * with compressed file transfers no CPU time is wasted in attempting to compress incompressible data)
+ */
+#define FILE_COMPR_SAMPLE_SIZE (4 * 1024)  // 4 KB
+#define FILE_COMPR_SAMPLE_MAX_RATIO 90
+
+// The zlib compression level of the file chunks (favoring speed over ratio, as the compression is
+// carried out on the same threads preparing the file segments to be encrypted and sent)
+#define FILE_COMPR_LEVEL 1
+
+// The maximum number of concurrent operations (streams) within a session
+#define SESS_MAX_STREAMS 8
+
+/*
+ * The maximum number of bytes and AEAD operations (session messages and file chunks) sent with a key
+ * before it is ratcheted into the key of its next epoch via a 'REKEY' session message, bounding the
+ * data each key protects well below the AEAD's usage limits (see "SessKey/SessKey.h")
+ */
+#define SESS_REKEY_MAX_BYTES (64UL * 1024 * 1024 * 1024)  // 64 GB
+#define SESS_REKEY_MAX_OPS   (1UL << 24)
+
+/*
+ * IV channel identifiers, XOR-ed into the connection's IV for deriving the independent IVs used in a
+ * session (see the IV channel constructor), where the most significant bit identifies the direction
+ * (server -> client if set) and the following bits the stream whose file chunks are encrypted,
+ * with session messages using the channel with no stream of their direction
+ */
+#define SESS_IV_SRV_TO_CLI 0x80000000
+#define SESS_IV_STREAM_CHANNEL(streamId) (((uint32_t)(streamId) + 1) << 16)
 
 class SessMgr
  {
@@ -41,13 +101,21 @@ class SessMgr
   // Session manager operations steps
   enum sessMgrOpStep : uint8_t
    {
-    OP_START,      // Default starting step                                                   (both)
-    WAITING_RESP,  // Awaiting the server's response to an operation-starting session message (client only)
-    WAITING_CONF,  // Awaiting the client confirmation notification                           (server only)
-    WAITING_RAW,   // Awaiting raw data                                                       (both)
-    WAITING_COMPL  // Awaiting the operation completion notification                          (both)
+    OP_START,       // Default starting step                                                   (both)
+    WAITING_RESP,   // Awaiting the server's response to an operation-starting session message (client only)
+    WAITING_CONF,   // Awaiting the client confirmation notification                           (server only)
+    SIGNING_BASE,   // Signing a delta upload's base as the connection becomes writable        (server only)
+    WAITING_RAW,    // Awaiting raw data                                                       (both)
+    SENDING_RAW,    // Sending a file's raw contents as the connection becomes writable        (server only)
+    WAITING_COMPL,  // Awaiting the operation completion notification                          (both)
+    WAITING_COMMIT, // Awaiting the group commit making an uploaded file durable               (server only)
+    COMMITTED,      // Sending an upload's completion as the connection becomes writable       (server only)
+    COMMIT_FAILED   // Sending an upload's commit failure as the connection becomes writable   (server only)
    };
 
+   // The state of a session operation (see "SessStream/SessStream.h")
+   class SessStream;
+
    /* ================================= ATTRIBUTES ================================= */
 
    /* ------------------------ Constant Session Attributes ------------------------ */
@@ -72,38 +140,56 @@ class SessMgr
     * across different session manager operations
     */
 
-   // The session manager current operation and operation step
-   sessMgrOp     _sessMgrOp;
-   sessMgrOpStep _sessMgrOpStep;
+   // The keys used for wrapping the session messages sent to and for unwrapping the
+   // ones received from the peer, ratcheted by the 'REKEY' session messages
+   SessKey       _sendKey;
+   SessKey       _recvKey;
+
+   // The keys used for encrypting the file chunks sent and decrypting the ones received, which are ratcheted
+   // with their own labels up to the epoch of each file segment, as in the pipelined transfers segments
+   // may be encrypted before and decrypted after the 'REKEY' messages following their announcement
+   SessKey       _sendChunkKey;
+   SessKey       _recvChunkKey;
 
-   // The associated AES_128_GCM manager child object
-   AESGCMMgr     _aesGCMMgr;
+   // The epoch of the session messages' sending key, which is read by the
+   // thread encrypting the file segments to be sent (possibly not the main one)
+   std::atomic<uint32_t> _sendKeyEpoch;
 
-   // The contents of the session's main directory
-   DirInfo* _mainDirInfo;
+   // The number of bytes and AEAD operations sent with the current sending key
+   unsigned long _sendKeyBytes;
+   unsigned long _sendKeyOps;
 
-   // The absolute path, information and file descriptor
-   // of a same file in the session's main directory
-   std::string* _mainFileAbsPath;
-   FileInfo*    _mainFileInfo;
-   FILE*        _mainFileDscr;
+   // The key epoch of the last file segment announced by the peer
+   uint32_t      _recvSegKeyEpoch;
 
-   // The absolute path and file descriptor
-   // of a same file in the session's temporary directory
-   std::string* _tmpFileAbsPath;
-   FILE* _tmpFileDscr;
+   // The IVs used for wrapping the session messages sent
+   // to and for unwrapping the ones received from the peer
+   IV            _sendIV;
+   IV            _recvIV;
 
-   // Information on a remote file
-   FileInfo*  _remFileInfo;
+   // The AES_128_GCM managers child objects used for
+   // the messages and raw data sent and received
+   AESGCMMgr     _sendAESGCMMgr;
+   AESGCMMgr     _recvAESGCMMgr;
 
-   // The number of remaining raw bytes to be
-   // sent or received in a raw data transmission
-   unsigned int _rawBytesRem;
+   // The AES_128_GCM workers pool used for encrypting and decrypting
+   // files' segments, shared by all the sessions of the application
+   AESGCMPool&   _aesGCMPool;
+
+   // The session's streams, each holding the state of a session operation, and the stream the
+   // session message being processed or the operation being carried out refers to
+   SessStream*   _streams[SESS_MAX_STREAMS];
+   SessStream*   _stream;
 
    // The length and type of the last received session message
    uint16_t    _recvSessMsgLen;
    SessMsgType _recvSessMsgType;
 
+   // The total plaintext and wire sizes of the file segments sent and received in the
+   // session (preserved across its operations), reporting the compression's savings
+   unsigned long _xferRawBytes;
+   unsigned long _xferWireBytes;
+
 
    /* ============================= PROTECTED METHODS ============================= */
 
@@ -169,27 +255,27 @@ class SessMgr
    void validateRecvFileName(std::string& fileName);
 
    /**
-    * @brief Attempts to load into the '_mainFileInfo' attribute the information
-    *        of the main file referred by the '_mainFileAbsPath' attribute
-    * @throws ERR_SESS_INTERNAL_ERROR   The '_mainFileAbsPath' attribute has not been initialized
+    * @brief Attempts to load into the 'mainFileInfo' attribute the information
+    *        of the main file referred by the 'mainFileAbsPath' attribute
+    * @throws ERR_SESS_INTERNAL_ERROR   The 'mainFileAbsPath' attribute has not been initialized
     * @throws ERR_SESS_MAIN_FILE_IS_DIR The main file was found to be a directory (!)
     */
    void checkLoadMainFileInfo();
 
    /**
     * @brief  Sets the main file last modification time to
-    *         the one specified in the '_remFileInfo' attribute
-    * @throws ERR_SESS_INTERNAL_ERROR       NULL '_mainFileAbsPath' or '_remFileInfo' attributes
+    *         the one specified in the 'remFileInfo' attribute
+    * @throws ERR_SESS_INTERNAL_ERROR       NULL 'mainFileAbsPath' or 'remFileInfo' attributes
     * @throws ERR_SESS_FILE_META_SET_FAILED Error in setting the main file's metadata
     */
    void mainToRemLastModTime();
 
    /**
     * @brief  If present deletes the main empty file for then touching it and setting its
-    *         last modified time to the one specified in the '_remFileInfo' attribute
+    *         last modified time to the one specified in the 'remFileInfo' attribute
     * @note   If present the main file is preliminarily deleted
     *         for the purposes of updating its creation time
-    * @throws ERR_SESS_INTERNAL_ERROR       NULL '_mainFileAbsPath' or '_remFileInfo' attributes
+    * @throws ERR_SESS_INTERNAL_ERROR       NULL 'mainFileAbsPath' or 'remFileInfo' attributes
     * @throws ERR_SESS_FILE_DELETE_FAILED   Error in deleting the main file
     * @throws ERR_SESS_FILE_OPEN_FAILED     Error in touching the main file
     * @throws ERR_SESS_FILE_CLOSE_FAILED    Error in closing the main file
@@ -197,6 +283,24 @@ class SessMgr
     */
    void touchEmptyFile();
 
+   /**
+    * @brief  Returns whether an anonymous 'O_TMPFILE' inode can be published by linking it through its
+    *         entry in the process's file descriptors table, which requires '/proc' to be mounted
+    * @param  tmpFileFd The file descriptor of the anonymous inode
+    * @return 'true' if the anonymous inode can be linked, 'false' otherwise
+    */
+   static bool anonTmpFileLinkable(int tmpFileFd);
+
+   /**
+    * @brief  Links an anonymous 'O_TMPFILE' inode at a path through its entry in the process's file
+    *         descriptors table or, should it not be accessible, through the 'AT_EMPTY_PATH' flag
+    *         (which on older kernels requires the 'CAP_DAC_READ_SEARCH' capability)
+    * @param  tmpFileFd   The file descriptor of the anonymous inode
+    * @param  linkAbsPath The absolute path the anonymous inode is to be linked at
+    * @return 0 on success, -1 on failure with 'errno' set by 'linkat()' (EEXIST = the path already exists)
+    */
+   static int linkAnonTmpFile(int tmpFileFd, const std::string& linkAbsPath);
+
    /* -------------------------- Session Raw Send/Receive -------------------------- */
 
    /**
@@ -212,15 +316,188 @@ class SessMgr
    void sendRawTag();
 
    /**
-    * @brief  Prepares the session manager to receive the raw
-    *         contents of a file being uploaded or downloaded
+    * @brief  Returns the maximum wire size of a file segment, i.e. its plaintext size plus the integrity
+    *         tags of the chunks it is made of and, if the connection's file transfers are compressed,
+    *         the table of the chunks' sizes on the wire preceding them
+    * @param  segSize The file segment's plaintext size
+    * @return The file segment's maximum wire size
+    */
+   unsigned int fileSegmentWireSize(unsigned int segSize);
+
+   /**
+    * @brief  Compresses a file raw contents' chunk into a destination buffer, where, for not wasting CPU time on
+    *         incompressible data (e.g. media or archive files), a sample of the chunk is compressed first, with
+    *         the chunk being left uncompressed if its sample does not shrink below FILE_COMPR_SAMPLE_MAX_RATIO
+    * @param  chunk     The chunk's plaintext address
+    * @param  chunkSize The chunk's plaintext size
+    * @param  destBuf   The destination buffer (at least 'chunkSize' bytes)
+    * @return The chunk's compressed size, or its plaintext size if the chunk should be sent uncompressed
+    */
+   static unsigned int compressFileChunk(unsigned char* chunk, unsigned int chunkSize, unsigned char* destBuf);
+
+   /**
+    * @brief  Decompresses a verified file raw contents' chunk of a stream into its plaintext address
+    * @param  stream     The stream the chunk belongs to
+    * @param  comprChunk The chunk's compressed data address
+    * @param  comprSize  The chunk's compressed size
+    * @param  chunk      The address where to write the chunk's plaintext
+    * @param  chunkSize  The chunk's expected plaintext size
+    * @throws ERR_SESSABORT_FILE_DECOMPRESS_FAILED The chunk failed its decompression or
+    *                                              its plaintext is of unexpected size
+    */
+   void decompressFileChunk(SessStream& stream, unsigned char* comprChunk, unsigned int comprSize,
+                            unsigned char* chunk, unsigned int chunkSize);
+
+   /**
+    * @brief  Returns a string reporting the savings of the compression of file transfers
+    * @param  rawBytes  The plaintext size of the file segments sent or received
+    * @param  wireBytes The wire size of the file segments sent or received
+    * @return The compression statistics string
+    */
+   static std::string compressionStatsStr(unsigned long rawBytes, unsigned long wireBytes);
+
+   /**
+    * @brief  Returns the plaintext size of the next file segment to be sent, adapted so to match
+    *         the connection's current bandwidth-delay product within FILE_SEGMENT_MIN_CHUNKS and
+    *         FILE_SEGMENT_CHUNKS chunks, and not exceeding the remaining file bytes to be sent
+    * @param  bytesRem The remaining file bytes to be sent
+    * @return The plaintext size of the next file segment to be sent
+    */
+   unsigned int adaptSendSegSize(long int bytesRem);
+
+   /**
+    * @brief  Prepares the chunks jobs of a file segment, where each chunk's plaintext is located in the
+    *         segment's plaintext buffer and its ciphertext, followed by its integrity tag, in the
+    *         segment's ciphertext buffer, with compressed chunks being encrypted or decrypted in place
+    * @param  stream     The stream the file segment belongs to
+    * @param  jobs       The chunks jobs array to be initialized (at least FILE_SEGMENT_CHUNKS elements)
+    * @param  segSize    The file segment's plaintext size
+    * @param  ptBuf      The segment's plaintext buffer
+    * @param  ctBuf      The segment's ciphertext buffer
+    * @param  chunkSizes The table of the chunks' sizes on the wire at the start of the ciphertext buffer,
+    *                    where a size smaller than the chunk's plaintext size denotes a compressed
+    *                    chunk (nullptr if the connection's file transfers are not compressed)
+    * @param  encrypt    Whether the chunks are to be encrypted (plaintext -> ciphertext
+    *                    buffer) or decrypted (ciphertext -> plaintext buffer)
+    * @return The number of chunks the file segment is made of
+    */
+   unsigned int prepFileSegmentJobs(SessStream& stream, AESGCMChunkJob* jobs, unsigned int segSize,
+                                    unsigned char* ptBuf, unsigned char* ctBuf, uint32_t* chunkSizes, bool encrypt);
+
+   /**
+    * @brief  Encrypts a file raw contents' segment of a stream from a plaintext into a ciphertext buffer,
+    *         where each of its chunks is encrypted with the stream's sending IV as a standalone AES_128_GCM
+    *         operation authenticating its sequence number, size, whether it is the file's last chunk and
+    *         whether it is compressed as AAD (possibly in parallel by the AES_128_GCM workers pool), with
+    *         each chunk's ciphertext followed by its integrity tag and, if the connection's file transfers are
+    *         compressed, the compressible chunks being compressed before their encryption and the chunks
+    *         being preceded by the table of their sizes on the wire (where if the stream's transfer is
+    *         authenticated only the chunks are not encrypted nor compressed, but sent as-is along with
+    *         their GMAC integrity tag)
+    * @param  stream   The stream the file segment belongs to
+    * @param  segSize  The segment's plaintext size (must be <= FILE_SEGMENT_SIZE and <= the stream's 'rawBytesRem')
+    * @param  keyEpoch The epoch of the sending key the segment's chunks are to be encrypted with
+    * @param  ptBuf    The segment's plaintext buffer
+    * @param  ctBuf    The segment's ciphertext buffer (at least CONN_BUF_SIZE bytes)
+    * @return The segment's wire size, i.e. the size of its chunks' ciphertexts
+    *         and integrity tags, plus the chunks' sizes table, if any
+    * @throws ERR_SESSABORT_INTERNAL_ERROR  Invalid segment size
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW   EVP_CIPHER context creation failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The plaintext block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+    */
+   unsigned int encryptFileSegment(SessStream& stream, unsigned int segSize, uint32_t keyEpoch,
+                                   unsigned char* ptBuf, unsigned char* ctBuf);
+
+   /**
+    * @brief  Verifies and decrypts the next file raw contents' segment of a stream from a ciphertext into a
+    *         plaintext buffer with the stream's receiving IV (possibly in parallel by the AES_128_GCM workers
+    *         pool), decompressing its compressed chunks, if any, and updating the number of remaining file
+    *         bytes to be received and the sequence number of the stream's next chunk
+    * @param  stream   The stream the file segment belongs to
+    * @param  segSize  The segment's plaintext size, as announced by its 'FILE_SEGMENT' session message
+    * @param  wireSize The segment's wire size, as announced by its 'FILE_SEGMENT' session message
+    * @param  keyEpoch The epoch of the receiving key the segment's chunks are encrypted
+    *                  with, as announced by its 'FILE_SEGMENT' session message
+    * @param  ctBuf    The segment's ciphertext buffer (chunks' sizes table, ciphertexts and tags)
+    * @param  ptBuf    The segment's plaintext buffer (at least FILE_SEGMENT_SIZE bytes)
+    * @throws ERR_SESSABORT_INVALID_FILE_SEGMENT     The segment's chunks' sizes table is
+    *                                                inconsistent with its announced sizes
+    * @throws ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED A chunk of a segment other than the file's
+    *                                                last failed its integrity verification
+    * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED         A chunk of the file's last segment
+    *                                                failed its integrity verification
+    * @throws ERR_SESSABORT_FILE_DECOMPRESS_FAILED   A compressed chunk failed its decompression
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW              EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT          Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE               Key derivation failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE            Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW            EVP_CIPHER context creation failed
+    * @throws ERR_OSSL_EVP_DECRYPT_INIT              EVP_CIPHER decrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE           The ciphertext block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_DECRYPT_UPDATE            EVP_CIPHER decrypt update failed
+    * @throws ERR_OSSL_SET_TAG_FAILED                Error in setting the expected chunk integrity tag
+    */
+   void decryptFileSegment(SessStream& stream, unsigned int segSize, unsigned int wireSize,
+                           uint32_t keyEpoch, unsigned char* ctBuf, unsigned char* ptBuf);
+
+   /**
+    * @brief  Verifies and decrypts a file raw contents' segment of the current stream that has been fully
+    *         received in the primary connection buffer (possibly in parallel by the AES_128_GCM workers pool),
+    *         writes the resulting plaintext into the stream's temporary file and sets the associated connection
+    *         manager to expect the next session message
+    * @param  segSize  The segment's plaintext size, as announced by its 'FILE_SEGMENT' session message
+    * @param  wireSize The segment's wire size, as announced by its 'FILE_SEGMENT' session message
+    * @param  keyEpoch The segment's key epoch, as announced by its 'FILE_SEGMENT' session message
+    * @throws ERR_SESSABORT_INVALID_FILE_SEGMENT     The segment's chunks' sizes table is
+    *                                                inconsistent with its announced sizes
+    * @throws ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED A chunk of a segment other than the file's
+    *                                                last failed its integrity verification
+    * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED         A chunk of the file's last segment
+    *                                                failed its integrity verification
+    * @throws ERR_SESSABORT_FILE_DECOMPRESS_FAILED   A compressed chunk failed its decompression
+    * @throws ERR_FILE_WRITE_FAILED                  Error in writing to the temporary file
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW              EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT          Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE               Key derivation failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE            Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW            EVP_CIPHER context creation failed
+    * @throws ERR_OSSL_EVP_DECRYPT_INIT              EVP_CIPHER decrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE           The ciphertext block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_DECRYPT_UPDATE            EVP_CIPHER decrypt update failed
+    * @throws ERR_OSSL_SET_TAG_FAILED                Error in setting the expected chunk integrity tag
+    */
+   void recvFileSegment(unsigned int segSize, unsigned int wireSize, uint32_t keyEpoch);
+
+   /**
+    * @brief Prepares the current stream to send the raw contents of the file being uploaded or downloaded,
+    *        whose size is assumed to be specified in its 'mainFileInfo' object, from its 'rawOffset' and for
+    *        its 'rawLength' (if not 0) by initializing the number of raw bytes to be sent, the sequence number
+    *        of the first chunk and the number of worker threads to be used for encrypting the file's segments
+    */
+   void prepSendFileRaw();
+
+   /**
+    * @brief  Prepares the current stream to receive the raw contents of a file being uploaded or
+    *         downloaded, whose segments are each announced by a 'FILE_SEGMENT' session message,
+    *         writing them into an anonymous 'O_TMPFILE' inode in the main file's directory or,
+    *         where the filesystem does not support it or it could not be linked (no '/proc'),
+    *         into the named temporary file
+    *         (where a resumed reception writes them into its already open temporary file, which
+    *         holds the file's contents up to the offset)
     * @throws ERR_SESSABORT_INTERNAL_ERROR  Invalid session manager operation or step
     *                                       for receiving a file's raw contents
     * @throws ERR_SESS_FILE_OPEN_FAILED     Failed to open the temporary file
     *                                       descriptor in write-byte mode
     * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
-    * @throws ERR_OSSL_EVP_DECRYPT_INIT     EVP_CIPHER decrypt initialization failed
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
     * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
     * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
@@ -231,18 +508,14 @@ class SessMgr
    void prepRecvFileRaw();
 
    /**
-    * @brief Finalizes a received file, whether uploaded or downloaded, by:\n\n
-    *           1) Verifying its integrity tag\n\n
-    *           2) Moving it from the temporary into the main directory\n\n
-    *           3) Setting its last modified time to the one
-    *              specified in the '_remFileInfo' object
-    * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
-    * @throws ERR_NON_POSITIVE_BUFFER_SIZE   The ciphertext block size is non-positive (probable overflow)
-    * @throws ERR_OSSL_EVP_DECRYPT_UPDATE    EVP_CIPHER decrypt update failed
-    * @throws ERR_OSSL_SET_TAG_FAILED        Error in setting the expected file integrity tag
-    * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED File integrity verification failed
-    * @throws ERR_SESS_FILE_CLOSE_FAILED     Error in closing the temporary file
-    * @throws ERR_SESS_FILE_RENAME_FAILED    Error in moving the temporary file to the main directory
+    * @brief Finalizes a received file, whether uploaded or downloaded,
+    *        whose chunks have all been verified upon reception, by:\n\n
+    *           1) Publishing it as the main file, by linking it into the main directory if
+    *              anonymous or by moving it from the temporary into the main directory\n\n
+    *           2) Setting its last modified time to the one
+    *              specified in the 'remFileInfo' object
+    * @throws ERR_SESS_FILE_CLOSE_FAILED     Error in flushing or closing the temporary file
+    * @throws ERR_SESS_FILE_RENAME_FAILED    Error in linking or moving the temporary file to the main directory
     * @throws ERR_SESS_FILE_META_SET_FAILED  Error in setting the main file's last modification time
     */
    void finalizeRecvFileRaw();
@@ -250,9 +523,10 @@ class SessMgr
    /* -------------------- Session Messages Wrapping/Unwrapping -------------------- */
 
    /**
-    * @brief  Wraps a session message stored in the associated connection's
-    *         secondary buffer into a session message wrapper in the connection's
-    *         primary buffer, sending the resulting wrapper to the connection peer
+    * @brief  Wraps a session message into a session message wrapper in the associated connection's
+    *         primary buffer, sending the resulting wrapper to the connection peer and accounting
+    *         it in the data protected by the current sending key
+    * @param  sessMsgBuf The buffer storing the session message to be wrapped
     * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
@@ -262,6 +536,44 @@ class SessMgr
     * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
     * @throws ERR_SEND_FAILED              send() fatal error
     */
+   void wrapSendSessMsg(unsigned char* sessMsgBuf);
+
+   /**
+    * @brief  Sends a 'REKEY' session message to the connection peer, for then ratcheting the sending key
+    *         and the session messages' sending IV into the ones of the key's next epoch, which the file
+    *         segments encrypted from now on are protected with
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED         The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED               send() fatal error
+    */
+   void sendRekeyMsg();
+
+   /**
+    * @brief  Wraps a session message stored in the associated connection's
+    *         secondary buffer into a session message wrapper in the connection's
+    *         primary buffer, sending the resulting wrapper to the connection peer,
+    *         where if the current sending key has reached the SESS_REKEY_MAX_BYTES
+    *         or SESS_REKEY_MAX_OPS limits it is first ratcheted via a 'REKEY' message
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED         The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED               send() fatal error
+    */
    void wrapSendSessMsg();
 
    /**
@@ -276,6 +588,21 @@ class SessMgr
     */
    void unwrapSessMsg();
 
+   /**
+    * @brief  If the session message unwrapped in the associated connection's secondary buffer is a
+    *         'REKEY' message, ratchets the receiving key and the session messages' receiving IV into
+    *         the ones of the key's next epoch, which the following session messages are wrapped with
+    * @return 'true' if the unwrapped session message was a 'REKEY' message, or 'false' otherwise
+    * @throws ERR_SESSABORT_INVALID_KEY_EPOCH 'REKEY' message of invalid length
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW       EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT   Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE        Key derivation failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE     Invalid AES_128_GCM manager state
+    * @note   As the peer has already ratcheted its sending key, a 'REKEY' message must
+    *         be processed before any other session message following it is unwrapped
+    */
+   bool recvRekeyMsg();
+
    /* -------------------------- Session Messages Sending -------------------------- */
 
    /**
@@ -297,10 +624,10 @@ class SessMgr
    /**
     * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgFileInfo'
     *         session message of the specified type containing the name and metadata of the main
-    *         file referred by the '_mainFileInfo' attribute, for then wrapping and sending the
+    *         file referred by the 'mainFileInfo' attribute, for then wrapping and sending the
     *         resulting session message wrapper to the connection peer
     * @param  sessMsgType The 'SessMsgFileInfo' session message type (FILE_UPLOAD_REQ || FILE_EXISTS)
-    * @throws ERR_SESS_INTERNAL_ERROR      Invalid 'sessMsgType' or uninitialized '_mainFileInfo' attribute
+    * @throws ERR_SESS_INTERNAL_ERROR      Invalid 'sessMsgType' or uninitialized 'mainFileInfo' attribute
     * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
@@ -350,7 +677,7 @@ class SessMgr
    /**
     * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgPoolSize'
     *         session message of implicit type 'POOL_SIZE' containing the serialized size of
-    *         the user's storage pool store in the '_rawBytesRem' attribute, for then wrapping
+    *         the user's storage pool store in the 'rawBytesRem' attribute, for then wrapping
     *         and sending the resulting session message wrapper to the connection peer
     * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
@@ -363,23 +690,139 @@ class SessMgr
     */
    void sendSessMsgPoolSize();
 
+   /**
+    * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgUploadResume' session
+    *         message of implicit type 'UPLOAD_RESUME' containing the offset from which the upload of the current
+    *         stream is resumed stored in its 'rawOffset' attribute, for then wrapping and sending the resulting
+    *         session message wrapper to the connection peer
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void sendSessMsgUploadResume();
+
+   /**
+    * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgDownloadRange' session
+    *         message of implicit type 'DOWNLOAD_RANGE' confirming the download of the current stream's file from
+    *         the offset and for the length stored in its 'rawOffset' and 'rawLength' attributes, for then wrapping
+    *         and sending the resulting session message wrapper to the connection peer
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void sendSessMsgDownloadRange();
+
+   /**
+    * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgUploadDigest' session
+    *         message of implicit type 'UPLOAD_DIGEST' containing the digest of the contents of the current stream's
+    *         file to be uploaded, for then wrapping and sending the resulting session message wrapper to the
+    *         connection peer
+    * @param  digest The SHA-256 digest of the contents of the file to be uploaded
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void sendSessMsgUploadDigest(const unsigned char* digest);
+
+   /**
+    * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgDeltaSigs' session message
+    *         of implicit type 'DELTA_SIGNATURES' containing the signatures of the blocks of the server's copy of the
+    *         current stream's file to be uploaded, as computed in full by its 'fileDelta' object, for then
+    *         wrapping and sending the resulting session message wrapper to the connection peer
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void sendSessMsgDeltaSigs();
+
+   /**
+    * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgUploadDelta' session
+    *         message of implicit type 'UPLOAD_DELTA' announcing that the raw contents of the current stream's
+    *         file to be uploaded are sent as its delta against the server's copy, for then wrapping and sending
+    *         the resulting session message wrapper to the connection peer
+    * @param  deltaSize The size of the file's delta
+    * @param  digest    The SHA-256 digest of the contents of the file to be uploaded
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void sendSessMsgUploadDelta(uint64_t deltaSize, const unsigned char* digest);
+
+   /**
+    * @brief  Prepares in the associated connection manager's secondary buffer a 'SessMsgFileSegment'
+    *         session message of implicit type 'FILE_SEGMENT' announcing a file raw contents' segment of
+    *         the specified stream, plaintext and wire size and key epoch, for then wrapping and sending
+    *         the resulting session message wrapper to the connection peer
+    * @param  stream   The stream the file segment belongs to
+    * @param  segSize  The file segment's plaintext size
+    * @param  wireSize The file segment's wire size
+    * @param  keyEpoch The epoch of the sending key the segment's chunks have been encrypted with
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW     EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE      Key derivation failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED         The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED               send() fatal error
+    */
+   void sendSessMsgFileSegment(SessStream& stream, unsigned int segSize, unsigned int wireSize, uint32_t keyEpoch);
+
    /* ------------------------- Session Messages Reception ------------------------- */
 
    /**
-    * @brief Validates and loads into a FileInfo object pointed by the '_remFileInfo' attribute
+    * @brief  Validates and applies to the current stream the file transfer
+    *         flags embedded within a received session message
+    * @param  xferFlags The received file transfer flags
+    * @throws ERR_SESS_MALFORMED_MESSAGE Unknown file transfer flags
+    */
+   void loadSessMsgXferFlags(uint8_t xferFlags);
+
+   /**
+    * @brief Validates and loads into a FileInfo object pointed by the 'remFileInfo' attribute
     *        the name and metadata of a remote file embedded within a 'SessMsgFileInfo'
     *        session message stored in the associated connection manager's secondary buffer
-    * @throws ERR_SESS_MALFORMED_MESSAGE Invalid file values in the 'SessMsgFileInfo' message
+    * @throws ERR_SESS_MALFORMED_MESSAGE Invalid file values or unknown file
+    *                                    transfer flags in the 'SessMsgFileInfo' message
     */
    void loadRemSessMsgFileInfo();
 
    /**
     * @brief  Validates the 'fileName' string embedded within a 'SessMsgFileName'
     *         session message stored in the associated connection manager's secondary
-    *         buffer and initializes the '_mainFileAbsPath' attribute to the
+    *         buffer and initializes the 'mainFileAbsPath' attribute to the
     *         concatenation of the session's main directory with such file name
     * @return The file name embedded in the 'SessMsgFileName' session message
-    * @throws ERR_SESS_MALFORMED_MESSAGE The 'fileName' string does not represent a valid Linux file name
+    * @throws ERR_SESS_MALFORMED_MESSAGE The 'fileName' string does not represent a valid
+    *                                    Linux file name or unknown file transfer flags
     */
    std::string loadMainSessMsgFileName();
 
@@ -395,26 +838,95 @@ class SessMgr
 
    /**
     * @brief Reads the serialized size of a user's storage pool from a
-    *        'SessMsgPoolSize' session  message into the '_rawBytesRem' attribute
+    *        'SessMsgPoolSize' session  message into the 'rawBytesRem' attribute
     */
    void loadSessMsgPoolSize();
 
+   /**
+    * @brief  Validates and loads into the 'rawOffset' attribute the offset from which the upload of the current
+    *         stream is resumed embedded within a 'SessMsgUploadResume' session message stored in the associated
+    *         connection manager's secondary buffer, which must be a positive multiple of FILE_CHUNK_SIZE smaller
+    *         than the size of the file being uploaded (specified in its 'mainFileInfo' object)
+    * @throws ERR_SESS_MALFORMED_MESSAGE Invalid message length or upload offset
+    */
+   void loadSessMsgUploadResume();
+
+   /**
+    * @brief  Validates and loads into the 'rawOffset' and 'rawLength' attributes the byte range of the file of the
+    *         current stream to be downloaded embedded within a 'SessMsgDownloadRange' session message stored in
+    *         the associated connection manager's secondary buffer, which must start before the end of the file
+    *         to be downloaded (specified in its 'mainFileInfo' object) and not extend past it
+    * @throws ERR_SESS_MALFORMED_MESSAGE Invalid message length or byte range
+    */
+   void loadSessMsgDownloadRange();
+
+   /**
+    * @brief  Validates and loads the digest of the contents of the current stream's file to be uploaded
+    *         embedded within a 'SessMsgUploadDigest' session message stored in the associated
+    *         connection manager's secondary buffer
+    * @param  digest The buffer the SHA-256 digest of the file's contents is loaded into
+    * @throws ERR_SESS_MALFORMED_MESSAGE Invalid message length
+    */
+   void loadSessMsgUploadDigest(unsigned char* digest);
+
+   /**
+    * @brief  Validates and loads into the current stream's 'fileDelta' object the signatures of the blocks of the
+    *         server's copy of the file to be uploaded embedded within a 'SessMsgDeltaSigs' session message stored
+    *         in the associated connection manager's secondary buffer, where the copy's size must be the one
+    *         specified in the 'remFileInfo' object and its blocks must be at least FILE_DELTA_MIN_BLOCK bytes,
+    *         no more than FILE_DELTA_MAX_BLOCKS and consistent with such size and the message length
+    * @throws ERR_SESS_MALFORMED_MESSAGE Invalid message length or blocks
+    */
+   void loadSessMsgDeltaSigs();
+
+   /**
+    * @brief  Validates and loads into the 'rawLength' attribute the size of the delta of the current stream's
+    *         file to be uploaded and the digest of its contents embedded within a 'SessMsgUploadDelta' session
+    *         message stored in the associated connection manager's secondary buffer
+    * @param  digest The buffer the SHA-256 digest of the file's contents is loaded into
+    * @throws ERR_SESS_MALFORMED_MESSAGE Invalid message length or delta size
+    */
+   void loadSessMsgUploadDelta(unsigned char* digest);
+
+   /**
+    * @brief  Reads and validates the plaintext and wire sizes of the file segment of the current stream
+    *         announced by a 'SessMsgFileSegment' session message, where the plaintext size must be positive,
+    *         not exceed neither the maximum segment size nor the stream's file bytes yet to be announced and
+    *         consist of whole chunks unless it is the file's last segment, while the wire size must exceed the
+    *         segment's integrity tags and chunks' sizes table and not exceed the segment's maximum wire size,
+    *         to which it must be equal if the file transfers are not compressed, and its key epoch must be
+    *         neither older than the previous segment's nor newer than the current receiving key's
+    * @param  bytesRem The stream's file bytes yet to be announced
+    * @param  wireSize Where to write the announced file segment's wire size
+    * @param  keyEpoch Where to write the announced file segment's key epoch
+    * @return The announced file segment's plaintext size
+    * @throws ERR_SESSABORT_INVALID_FILE_SEGMENT The stream is not expecting a file segment or
+    *                                            the announced segment sizes are invalid
+    * @throws ERR_SESSABORT_INVALID_KEY_EPOCH    Invalid announced segment key epoch
+    * @note   As the segment's raw contents immediately follow its announcement,
+    *         an invalid announcement requires the connection to be dropped
+    */
+   unsigned int loadSessMsgFileSegment(uint64_t bytesRem, unsigned int& wireSize, uint32_t& keyEpoch);
+
   public:
 
    /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
    /**
-    * @brief Session manager object constructor
-    * @param connMgr A reference to the connection manager parent object
-    * @param mainDir The session's main directory, consisting in the user's storage pool on
-    *                the SafeCloud server or their downloads folder in the client application
+    * @brief Session manager object constructor, deriving from the connection's IV the independent
+    *        IVs used for the session messages and the file chunks of each stream in each direction
+    * @param connMgr    A reference to the connection manager parent object
+    * @param mainDir    The session's main directory, consisting in the user's storage pool on
+    *                   the SafeCloud server or their downloads folder in the client application
+    * @param isServer   Whether the session manager belongs to the SafeCloud server or client
+    * @param aesGCMPool The application's AES_128_GCM workers pool
     */
-   SessMgr(ConnMgr& connMgr, std::string* mainDir);
+   SessMgr(ConnMgr& connMgr, std::string* mainDir, bool isServer, AESGCMPool& aesGCMPool);
 
    /**
-    * @brief Session manager object destructor,  performing cleanup operations on the session's
-    *        state attributes and resetting the associated connection manager's reception mode
-    *        to 'RECV_MSG' and marking the contents of its primary connection buffer as consumed
+    * @brief Session manager object destructor, performing cleanup operations on the session's
+    *        streams and resetting the associated connection manager's reception mode to
+    *        'RECV_MSG' and marking the contents of its primary connection buffer as consumed
     * @note  It is assumed the connection's cryptographic quantities (session key, IV)
     *        to be securely erased by the associated connection manager parent object
     */
@@ -423,17 +935,32 @@ class SessMgr
    /* ============================= OTHER PUBLIC METHODS ============================= */
 
    /**
-    * @brief  Returns whether the session manager is idle
+    * @brief  Returns a string reporting the savings of the compression
+    *         of the file transfers carried out in the session
+    * @return The session's compression statistics string
+    */
+   std::string compressionStatsStr();
+
+   /**
+    * @brief  Returns whether the session manager is idle, i.e. no operation is pending on any of its streams
     * @return A boolean indicating whether the connection manager is idle
     */
    bool isIdle();
 
    /**
-    * @brief Reset the session manager state in preparation to the next session operation by
-    *        resetting and performing cleanup operation on all its session state attributes
-    *        and by resetting the associated connection manager's reception mode to 'RECV_MSG'
+    * @brief Resets the current stream in preparation to its next operation, resetting and performing
+    *        cleanup operations on its operation state attributes, resetting the session's AES_128_GCM
+    *        managers, resetting the associated connection manager's reception mode to 'RECV_MSG'
     *        and by marking the contents of its primary connection buffer as consumed
     */
+   void resetStreamState();
+
+   /**
+    * @brief Reset the session manager state in preparation to the next session operations by
+    *        resetting and performing cleanup operation on all its streams and session state
+    *        attributes and by resetting the associated connection manager's reception mode
+    *        to 'RECV_MSG' and by marking the contents of its primary connection buffer as consumed
+    */
    void resetSessState();
 
    /**
@@ -3,6 +3,10 @@
 
 /* SafeCloud Session Messages Definitions */
 
+/* ================================== INCLUDES ================================== */
+#include "defaults.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/AESGCMMgr/AESGCMMgr.h"
+
 /* ================ SAFECLOUD SESSION MESSAGE TYPES DEFINITIONS ================ */
 enum SessMsgType : uint8_t
  {
@@ -17,6 +21,7 @@ enum SessMsgType : uint8_t
   // ------------------- Other Payload Session Message Types ------------------- //
   FILE_EXISTS,        // A file with such name already exists     (Client <- Server)
   POOL_SIZE,          // Client storage pool information raw size (Client <- Server)
+  FILE_SEGMENT,       // A file raw contents' segment follows     (Client <-> Server)
 
   /* -------------- Signaling Session Message Types (no payload) -------------- */
 
@@ -29,6 +34,7 @@ enum SessMsgType : uint8_t
   CANCEL,              // Session operation cancellation           (Client -> Server)
   COMPLETED,           // Session operation completion             (Client <-> Server)
   BYE,                 // Peer graceful disconnection              (Client <-> Server)
+  REKEY,               // The sender's keys are ratcheted          (Client <-> Server)
 
   // ------------------ Error Signaling Session Message Types ------------------ //
 
@@ -47,10 +53,37 @@ enum SessMsgType : uint8_t
   // The peer received a malformed session message
   ERR_MALFORMED_SESS_MESSAGE,
 
+  // The peer has not enough storage space for the file to be received
+  ERR_NO_SPACE,
+
   // The peer received a session message of unknown type, an error
   // to be attributed to a desynchronization between the connection
   // peers' IVs and that requires their connection to be reset
-  ERR_UNKNOWN_SESSMSG_TYPE
+  ERR_UNKNOWN_SESSMSG_TYPE,
+
+  /* ------------------- Feature-Specific Session Message Types ------------------- */
+
+  /*
+   * Session message types exchanged only on connections where their optional feature has been
+   * negotiated, which are appended so that the values of the previous types are preserved
+   * and SafeCloud versions not supporting the feature can still interoperate
+   */
+
+  // Payload session message types (STSM_FEATURE_RESUMABLE_UPLOADS)
+  UPLOAD_RESUME,       // An interrupted upload is resumed from an offset  (Client <- Server)
+
+  // Payload session message types (STSM_FEATURE_RANGED_DOWNLOADS)
+  DOWNLOAD_RANGE,      // Download confirmation of a file's byte range     (Client -> Server)
+
+  // Payload session message types (STSM_FEATURE_DEDUP_UPLOADS)
+  UPLOAD_DIGEST,       // The digest of the contents of a file to upload   (Client -> Server)
+
+  // Signaling session message types (STSM_FEATURE_DELTA_UPLOADS)
+  DELTA_CONFIRM,       // Upload confirmation requesting to send a delta   (Client -> Server)
+
+  // Payload session message types (STSM_FEATURE_DELTA_UPLOADS)
+  DELTA_SIGNATURES,    // The blocks' signatures of the server's copy      (Client <- Server)
+  UPLOAD_DELTA         // The size of the delta of a file to upload        (Client -> Server)
  };
 
 /* ================== SAFECLOUD SESSION MESSAGES DEFINITIONS ================== */
@@ -58,8 +91,9 @@ enum SessMsgType : uint8_t
 // Base Session Message
 struct __attribute__((packed)) SessMsg
  {
-  uint16_t    msgLen;   // Total Session message length
-  SessMsgType msgType;  // Session Message Type
+  uint16_t    msgLen;    // Total Session message length
+  SessMsgType msgType;   // Session Message Type
+  uint8_t     streamId;  // The identifier of the session stream (operation) the message refers to
  };
 
 // Session Message Wrapper
@@ -70,6 +104,21 @@ struct SessMsgWrapper
   char      tag[AES_128_GCM_TAG_SIZE];    // AES_128_GCM Integrity Tag (16 bytes)
  };
 
+/* ---------------------------- File Transfer Flags ---------------------------- */
+
+/*
+ * Flags set by the client in the operation-starting message of a file transfer and echoed
+ * by the server in its 'FILE_EXISTS' reply, so that both peers agree on how the transfer's
+ * file chunks are protected (control messages are always encrypted regardless)
+ */
+
+// The file chunks are authenticated only (GMAC) instead of encrypted, for
+// files whose contents have already been encrypted by the client
+#define SESS_XFER_AUTH_ONLY 0x01
+
+// The file transfer flags supported by this SafeCloud version
+#define SESS_XFER_FLAGS (SESS_XFER_AUTH_ONLY)
+
 /* -------------------- 'SessMsgFileInfo' Session Message -------------------- */
 
 // Used with type = FILE_UPLOAD_REQ, FILE_EXISTS
@@ -79,6 +128,7 @@ struct __attribute__((packed)) SessMsgFileInfo : public SessMsg
   long int fileSize;         // The file size in bytes
   long int lastModTime;      // The file last modification time in UNIX epochs
   long int creationTime;     // The file creation time in UNIX epochs
+  uint8_t  xferFlags;        // The file transfer flags
   unsigned char fileName[];  // The file name (variable size)
  };
 
@@ -88,6 +138,7 @@ struct __attribute__((packed)) SessMsgFileInfo : public SessMsg
 
 struct __attribute__((packed)) SessMsgFileName : public SessMsg
  {
+  uint8_t  xferFlags;        // The file transfer flags (FILE_DOWNLOAD_REQ only)
   unsigned char fileName[];  // The file name, '/0' character included (variable size)
  };
 
@@ -108,7 +159,90 @@ struct __attribute__((packed)) SessMsgFileRename : public SessMsg
 
 struct __attribute__((packed)) SessMsgPoolSize : public SessMsg
  {
-  unsigned int serPoolSize;  // The serialized contents' size of a user's storage pool
+  uint64_t serPoolSize;  // The serialized contents' size of a user's storage pool
+ };
+
+// 'SessMsgPoolSize' session message as exchanged on connections
+// not supporting 64-bit sizes (no 'STSM_FEATURE_LARGE_FILES')
+struct __attribute__((packed)) SessMsgPoolSizeLegacy : public SessMsg
+ {
+  uint32_t serPoolSize;  // The serialized contents' size of a user's storage pool
+ };
+
+/* ------------------- 'SessMsgUploadResume' Session Message ------------------- */
+
+// Used with type = UPLOAD_RESUME, preceding the server's response to a 'FILE_UPLOAD_REQ'
+
+struct __attribute__((packed)) SessMsgUploadResume : public SessMsg
+ {
+  uint64_t offset;  // The offset up to which the server has already received and verified the file's
+                    // contents, from which the upload is resumed (a multiple of FILE_CHUNK_SIZE)
+ };
+
+/* ------------------- 'SessMsgDownloadRange' Session Message ------------------- */
+
+// Used with type = DOWNLOAD_RANGE, which replaces the client's 'CONFIRM' of a
+// download operation so that only a byte range of the file is downloaded
+
+struct __attribute__((packed)) SessMsgDownloadRange : public SessMsg
+ {
+  uint64_t offset;  // The offset in the file from which its contents are downloaded
+  uint64_t length;  // The number of the file's bytes to be downloaded from the offset (0 = up to the file's end)
+ };
+
+/* ------------------- 'SessMsgUploadDigest' Session Message ------------------- */
+
+// Used with type = UPLOAD_DIGEST, following a 'FILE_UPLOAD_REQ' of a non-empty file so that the
+// server may complete the upload without its contents being transferred if it already holds them
+
+struct __attribute__((packed)) SessMsgUploadDigest : public SessMsg
+ {
+  unsigned char digest[FILE_DIGEST_SIZE];  // The SHA-256 digest of the file's contents
+ };
+
+/* ------------------- 'SessMsgDeltaSigs' Session Message ------------------- */
+
+// Used with type = DELTA_SIGNATURES, replying to a 'DELTA_CONFIRM' of an upload with the signatures of
+// the blocks of the server's copy of the file, against which the client computes the file's delta
+
+// The signature of a block of the server's copy of a file
+struct __attribute__((packed)) DeltaBlockSig
+ {
+  uint32_t      weak;                            // The block's rolling checksum
+  unsigned char strong[FILE_DELTA_STRONG_SIZE];  // The block's strong signature (truncated SHA-256)
+ };
+
+struct __attribute__((packed)) SessMsgDeltaSigs : public SessMsg
+ {
+  uint64_t      baseSize;   // The size of the server's copy of the file
+  uint32_t      blockSize;  // The size of its blocks (but its last, which may be shorter)
+  uint32_t      numBlocks;  // The number of its blocks (<= FILE_DELTA_MAX_BLOCKS)
+  DeltaBlockSig sigs[];     // The blocks' signatures (variable size)
+ };
+
+/* ------------------- 'SessMsgUploadDelta' Session Message ------------------- */
+
+// Used with type = UPLOAD_DELTA, announcing that the raw contents sent for an upload are
+// the delta of its file against the server's copy rather than the file's contents
+
+struct __attribute__((packed)) SessMsgUploadDelta : public SessMsg
+ {
+  uint64_t      deltaSize;                 // The size of the file's delta
+  unsigned char digest[FILE_DIGEST_SIZE];  // The SHA-256 digest of the file's contents, which
+                                           // the server verifies the reconstructed file against
+ };
+
+/* ------------------- 'SessMsgFileSegment' Session Message ------------------- */
+
+// Used with type = FILE_SEGMENT
+
+struct __attribute__((packed)) SessMsgFileSegment : public SessMsg
+ {
+  unsigned int segSize;   // The plaintext size of the file raw contents' segment following the message
+  unsigned int wireSize;  // The size of the segment's raw contents on the wire (which
+                          // is smaller than its maximum if any chunk is compressed)
+  uint32_t     keyEpoch;  // The epoch of the key the segment's chunks are protected with (which may
+                          // precede the current one, as segments may be encrypted before being sent)
  };
 
 
@@ -125,5 +259,21 @@ struct __attribute__((packed)) PoolFileInfo
   char          filename[];       // The file name
  };
 
+/*
+ * The Associated Authenticated Data (AAD) of a file's raw contents chunk, which is
+ * not sent along with the chunk but is independently computed by both peers from
+ * its position in the file, so that chunks that are reordered, dropped, truncated
+ * or replayed from another transfer fail their integrity verification
+ */
+
+struct __attribute__((packed)) FileChunkAAD
+ {
+  uint64_t seqNum;     // The chunk sequence number in the file (starting from 0)
+  uint32_t chunkSize;  // The chunk plaintext size
+  uint8_t  lastChunk;  // Whether this is the last chunk of the file
+  uint8_t  compressed; // Whether the chunk is transferred compressed
+  uint8_t  authOnly;   // Whether the chunk is authenticated only (GMAC), and so transferred unencrypted
+ };
+
 
 #endif //SAFECLOUD_SESSMSG_H
\ No newline at end of file
@@ -0,0 +1,238 @@
+/* SafeCloud Session Stream Definitions */
+
+/* ================================== INCLUDES ================================== */
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "SessStream.h"
+#include "errCodes/execErrCodes/execErrCodes.h"
+
+
+/* ============================== PRIVATE METHODS ============================== */
+
+/**
+ * @brief Closes the stream's open temporary file, which if the reception of its file is resumable is
+ *        preserved at the 'resumeFileAbsPath' path with its contents past the 'rawOffset' truncated to a whole
+ *        number of chunks and synchronized to storage, and otherwise or if it cannot be preserved is deleted
+ *        unless anonymous
+ */
+void SessMgr::SessStream::closeTmpFile()
+ {
+  // The file descriptor of the temporary file
+  int tmpFileFd = fileno(tmpFileDscr);
+
+  // The size of the temporary file's contents that are preserved
+  off_t preservedSize = 0;
+
+  // Whether the temporary file has been moved to the 'resumeFileAbsPath' path
+  bool tmpFileMoved = false;
+
+  // If the file's reception is resumable, preserve the temporary file contents that were written, all of which
+  // were verified upon reception, with the ones received from the 'rawOffset' truncated to a whole number of
+  // chunks so that the reception can be resumed on a chunk boundary (discarding the preallocated extents past
+  // them), where such contents are synchronized to storage before being preserved so that a partial file can
+  // never hold unverified contents
+  if(resumeFileAbsPath != nullptr && fflush(tmpFileDscr) == 0)
+   {
+    preservedSize = ftello(tmpFileDscr);
+    if(preservedSize > 0 && (uint64_t)preservedSize >= rawOffset)
+     {
+      preservedSize -= (off_t)(((uint64_t)preservedSize - rawOffset) % FILE_CHUNK_SIZE);
+      if(preservedSize > 0 && ftruncate(tmpFileFd, preservedSize) == 0 && fdatasync(tmpFileFd) == 0)
+       {
+        // An anonymous temporary file is linked (as in 'SessMgr::finalizeRecvFileRaw()'), while a named one is moved
+        if(tmpFileAnon)
+         {
+          if(linkAnonTmpFile(tmpFileFd, *resumeFileAbsPath) != 0)
+           LOG_EXEC_CODE(ERR_FILE_RENAME_FAILED, *resumeFileAbsPath, ERRNO_DESC);
+         }
+        else
+         {
+          if(rename(tmpFileAbsPath->c_str(), resumeFileAbsPath->c_str()) != 0)
+           LOG_EXEC_CODE(ERR_FILE_RENAME_FAILED, *tmpFileAbsPath, ERRNO_DESC);
+          else
+           tmpFileMoved = true;
+         }
+       }
+     }
+   }
+
+  // Close the temporary file, deleting it unless anonymous or moved
+  if(fclose(tmpFileDscr) != 0)
+   LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, *tmpFileAbsPath, ERRNO_DESC);
+  else
+   if(!tmpFileAnon && !tmpFileMoved && remove(tmpFileAbsPath->c_str()) == -1)
+    LOG_EXEC_CODE(ERR_FILE_DELETE_FAILED, *tmpFileAbsPath, ERRNO_DESC);
+ }
+
+
+/* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+/**
+ * @brief Session stream object constructor
+ * @param id          The stream identifier (< SESS_MAX_STREAMS)
+ * @param connIV      The connection's IV the stream's chunks IVs are derived from
+ * @param sendChannel The IV channel identifier of the direction the stream's chunks are sent in
+ * @param recvChannel The IV channel identifier of the direction the stream's chunks are received in
+ */
+SessMgr::SessStream::SessStream(uint8_t id, const IV& connIV, uint32_t sendChannel, uint32_t recvChannel)
+ : streamId(id), op(IDLE), opStep(OP_START), mainDirInfo(nullptr), mainFileAbsPath(nullptr),
+   mainFileInfo(nullptr), mainFileDscr(nullptr), mainFileMap(nullptr), mainFileMapSize(0), tmpFileAbsPath(nullptr), tmpFileDscr(nullptr),
+   tmpFileAnon(false), resumeFileAbsPath(nullptr), remFileInfo(nullptr), rawOffset(0), rawLength(0), rawBytesRem(0), chunkSeqNum(0),
+   cryptoWorkers(1), xferRawBytes(0), xferWireBytes(0), authOnly(false), contentMDCtx(nullptr),
+   fileDelta(nullptr),
+   sendChunkIV(connIV, sendChannel | SESS_IV_STREAM_CHANNEL(id)),
+   recvChunkIV(connIV, recvChannel | SESS_IV_STREAM_CHANNEL(id))
+ {}
+
+
+/**
+ * @brief Session stream object destructor, unmapping and closing its main file, closing and
+ *        deleting or preserving its temporary file, if any, and its dynamic attributes
+ */
+SessMgr::SessStream::~SessStream()
+ {
+  // If mapped, unmap the main file
+  if(mainFileMap != nullptr && munmap(mainFileMap, mainFileMapSize) != 0)
+   LOG_EXEC_CODE(ERR_FILE_UNMAP_FAILED, *mainFileAbsPath, ERRNO_DESC);
+
+  // If open, close the main file
+  if(mainFileDscr != nullptr)
+   {
+    if(fclose(mainFileDscr) != 0)
+     LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, *mainFileAbsPath, ERRNO_DESC);
+   }
+
+  // If open, close and delete or preserve the temporary file
+  if(tmpFileDscr != nullptr)
+   closeTmpFile();
+
+  // Delete the stream's dynamic attributes
+  delete mainDirInfo;
+  delete mainFileAbsPath;
+  delete mainFileInfo;
+  delete tmpFileAbsPath;
+  delete resumeFileAbsPath;
+  delete remFileInfo;
+
+  // Free the digest context of the received file's contents, if any
+  EVP_MD_CTX_free(contentMDCtx);
+
+  // Delete the delta of the uploaded file, if any
+  delete fileDelta;
+ }
+
+
+/* ============================ OTHER PUBLIC METHODS ============================ */
+
+/**
+ * @brief Resets the stream into the 'IDLE' operation in preparation to its next operation
+ *        by resetting and performing cleanup operations on all its operation state attributes
+ */
+void SessMgr::SessStream::reset()
+ {
+  // Reset the stream current operation and operation step
+  op     = IDLE;
+  opStep = OP_START;
+
+  // If present, delete and reset the
+  // contents of the session's main directory
+  if(mainDirInfo != nullptr)
+   {
+    delete mainDirInfo;
+    mainDirInfo = nullptr;
+   }
+
+  // If mapped, unmap the main file and reset its mapping
+  if(mainFileMap != nullptr)
+   {
+    if(munmap(mainFileMap, mainFileMapSize) != 0)
+     LOG_EXEC_CODE(ERR_FILE_UNMAP_FAILED, *mainFileAbsPath, ERRNO_DESC);
+    mainFileMap     = nullptr;
+    mainFileMapSize = 0;
+   }
+
+  // If open, close the main file and reset its descriptor
+  if(mainFileDscr != nullptr)
+   {
+    if(fclose(mainFileDscr) != 0)
+     LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, *mainFileAbsPath, ERRNO_DESC);
+    mainFileDscr = nullptr;
+   }
+
+  // If present, reset the main file absolute path
+  if(mainFileAbsPath != nullptr)
+   {
+    delete mainFileAbsPath;
+    mainFileAbsPath = nullptr;
+   }
+
+  // If present, delete and reset the main file information
+  if(mainFileInfo != nullptr)
+   {
+    delete mainFileInfo;
+    mainFileInfo = nullptr;
+   }
+
+  // If open, close the temporary file, deleting or preserving
+  // it, and reset its descriptor and anonymity
+  if(tmpFileDscr != nullptr)
+   {
+    closeTmpFile();
+    tmpFileDscr = nullptr;
+   }
+  tmpFileAnon = false;
+
+  // If present, reset the temporary file absolute path
+  if(tmpFileAbsPath != nullptr)
+   {
+    delete tmpFileAbsPath;
+    tmpFileAbsPath = nullptr;
+   }
+
+  // If present, reset the path where the temporary file is preserved
+  if(resumeFileAbsPath != nullptr)
+   {
+    delete resumeFileAbsPath;
+    resumeFileAbsPath = nullptr;
+   }
+
+  // If present, delete the information on the remote file
+  if(remFileInfo != nullptr)
+   {
+    delete remFileInfo;
+    remFileInfo = nullptr;
+   }
+
+  // Reset the offset and length of the file raw contents sent or received and the
+  // number of remaining raw bytes to be sent or received in a raw data transmission
+  rawOffset   = 0;
+  rawLength   = 0;
+  rawBytesRem = 0;
+
+  // Reset the sequence number of the next file chunk to be sent or received
+  // and the number of worker threads used for encrypting or decrypting it
+  chunkSeqNum = 0;
+  cryptoWorkers = 1;
+
+  // Reset the plaintext and wire sizes of the file segments sent or received
+  xferRawBytes  = 0;
+  xferWireBytes = 0;
+
+  // Reset the stream's transfers to be encrypted
+  authOnly = false;
+
+  // If present, free and reset the digest context of the received file's contents
+  if(contentMDCtx != nullptr)
+   {
+    EVP_MD_CTX_free(contentMDCtx);
+    contentMDCtx = nullptr;
+   }
+
+  // If present, delete and reset the delta of the uploaded file
+  if(fileDelta != nullptr)
+   {
+    delete fileDelta;
+    fileDelta = nullptr;
+   }
+ }
@@ -0,0 +1,154 @@
+#ifndef SAFECLOUD_SESSSTREAM_H
+#define SAFECLOUD_SESSSTREAM_H
+
+/* SafeCloud Session Stream Declaration */
+
+/*
+ * A session stream holds the state of one of the operations that can be concurrently
+ * carried out within a session over the same connection and session key, where:
+ *
+ *   - Every session message carries the identifier of the stream it refers to
+ *
+ *   - Every file raw contents' segment is preceded by a 'FILE_SEGMENT' session message
+ *     identifying its stream and size, so that the segments of different
+ *     operations can be interleaved on the connection
+ *
+ *   - The chunks of the segments of each stream are encrypted with a per-stream and per-direction
+ *     IV derived from the connection's IV, so that the order in which the segments of different
+ *     streams are processed does not affect the IVs of the session messages nor of other streams
+ */
+
+/* ================================== INCLUDES ================================== */
+#include "SafeCloudApp/ConnMgr/SessMgr/SessMgr.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/FileDelta/FileDelta.h"
+
+class SessMgr::SessStream
+ {
+  public:
+
+   /* ================================= ATTRIBUTES ================================= */
+
+   // The stream identifier (< SESS_MAX_STREAMS)
+   const uint8_t streamId;
+
+   // The stream current operation and operation step
+   sessMgrOp     op;
+   sessMgrOpStep opStep;
+
+   // The contents of the session's main directory
+   DirInfo* mainDirInfo;
+
+   // The absolute path, information and file descriptor
+   // of a same file in the session's main directory
+   std::string* mainFileAbsPath;
+   FileInfo*    mainFileInfo;
+   FILE*        mainFileDscr;
+
+   // The read-only memory mapping of the main file and its size, which the raw contents
+   // of a file being downloaded are encrypted from when the file could be mapped
+   unsigned char* mainFileMap;
+   size_t         mainFileMapSize;
+
+   // The absolute path and file descriptor
+   // of a same file in the session's temporary directory
+   std::string* tmpFileAbsPath;
+   FILE*        tmpFileDscr;
+
+   // Whether the temporary file is an anonymous 'O_TMPFILE' inode in the main file's directory rather
+   // than the named file at 'tmpFileAbsPath', which is released by the kernel when closed and so
+   // never needs to be deleted (see the 'SessMgr::prepRecvFileRaw()' method)
+   bool tmpFileAnon;
+
+   // The absolute path where the verified contents of the file being received are preserved if its
+   // reception is interrupted, so that it can be later resumed from them (nullptr = not resumable)
+   std::string* resumeFileAbsPath;
+
+   // Information on a remote file
+   FileInfo* remFileInfo;
+
+   // The offset in the file from which its raw contents are sent or received, i.e.
+   // the size of the contents already held by the receiver of a resumed transfer
+   uint64_t rawOffset;
+
+   // The number of the file's raw bytes sent or received from its 'rawOffset'
+   // in a ranged download (0 = up to the file's end, as in other transfers)
+   uint64_t rawLength;
+
+   // The number of remaining raw bytes to be
+   // sent or received in a raw data transmission
+   uint64_t rawBytesRem;
+
+   // The sequence number of the next file raw
+   // contents' chunk to be sent or received
+   uint64_t chunkSeqNum;
+
+   // The number of worker threads used for encrypting or
+   // decrypting the segments of the file being sent or received
+   unsigned int cryptoWorkers;
+
+   // The plaintext and wire sizes of the file segments sent or received in
+   // the stream's current operation, reporting the compression's savings
+   unsigned long xferRawBytes;
+   unsigned long xferWireBytes;
+
+   // Whether the file chunks transferred in the stream's current operation are authenticated
+   // only (GMAC) instead of encrypted, as requested by the client for contents it has
+   // already encrypted by itself (see the 'SESS_XFER_AUTH_ONLY' transfer flag)
+   bool authOnly;
+
+   // The digest context of the raw contents of a file being received, which is used by the
+   // server for deduplicating uploaded files in its content store (nullptr = not digested)
+   EVP_MD_CTX* contentMDCtx;
+
+   // The delta of a file being uploaded against the server's copy of it, whose raw contents
+   // sent or received are such delta instead of the file's contents (nullptr = no delta)
+   FileDelta* fileDelta;
+
+   // The digest of the contents of the file being uploaded as a delta, against which the file
+   // rebuilt from it is verified (server) or which is announced along with it (client)
+   unsigned char deltaDigest[FILE_DIGEST_SIZE];
+
+   // The IVs used for encrypting the chunks of the file segments sent
+   // and for decrypting the ones received on the stream, which are
+   // preserved across the stream's operations
+   IV sendChunkIV;
+   IV recvChunkIV;
+
+   /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+   /**
+    * @brief Session stream object constructor
+    * @param id          The stream identifier (< SESS_MAX_STREAMS)
+    * @param connIV      The connection's IV the stream's chunks IVs are derived from
+    * @param sendChannel The IV channel identifier of the direction the stream's chunks are sent in
+    * @param recvChannel The IV channel identifier of the direction the stream's chunks are received in
+    */
+   SessStream(uint8_t id, const IV& connIV, uint32_t sendChannel, uint32_t recvChannel);
+
+   /**
+    * @brief Session stream object destructor, unmapping and closing its main file, closing and
+    *        deleting or preserving its temporary file, if any, and its dynamic attributes
+    */
+   ~SessStream();
+
+   /* ============================= OTHER PUBLIC METHODS ============================= */
+
+   /**
+    * @brief Resets the stream into the 'IDLE' operation in preparation to its next operation
+    *        by resetting and performing cleanup operations on all its operation state attributes
+    */
+   void reset();
+
+  private:
+
+   /**
+    * @brief Closes the stream's open temporary file, which if the reception of its file is resumable is
+    *        preserved at the 'resumeFileAbsPath' path with its contents past the 'rawOffset' truncated to a whole
+    *        number of chunks and synchronized to storage, and otherwise or if it cannot be preserved is deleted
+    *        unless anonymous
+    */
+   void closeTmpFile();
+ };
+
+
+#endif //SAFECLOUD_SESSSTREAM_H
@@ -15,6 +15,21 @@
 // (select() limitation, 1024 (FD_SETSIZE) - 1 (Listening Socket))
 #define SRV_MAX_CONN (FD_SETSIZE-1)
 
+/* ------------------- Server Session Resumption Parameters ------------------- */
+#define SRV_TICKET_LIFETIME     86400  // The default resumption tickets' lifetime in seconds (0 = disabled)
+#define SRV_TICKET_KEY_ROTATION 3600   // The default resumption ticket keys' rotation interval in seconds
+
+/* -------------------- Server Uploads Durability Parameters -------------------- */
+#define SRV_DURABILITY_MODE     2      // The default uploads durability mode (0 = none, 1 = files, 2 = files + directories)
+#define SRV_GROUP_COMMIT_WINDOW 5      // The default uploads group commit window in milliseconds
+
+/* ---------------------- Server Partial Uploads Parameters ---------------------- */
+#define SRV_UPLOAD_RETENTION    86400  // The default retention time of interrupted uploads in seconds (0 = disabled)
+
+/* ----------------------- Server Content Store Parameters ----------------------- */
+#define SRV_STORE_GC_INTERVAL   0      // The default content store garbage collection interval in seconds (0 = store disabled)
+#define SRV_STORE_GC_BATCH      256    // The number of content store objects examined per garbage collection step
+
 /* ----------------------- Server Files Paths Parameters ----------------------- */
 
 // ------------------------ Server Cryptographic Files ------------------------ //
@@ -29,6 +44,10 @@
 #define SRV_USER_PUBK_DIR_PATH(username) SRV_USER_HOME_PATH(username) + "pubk/"
 #define SRV_USER_PUBK_PATH(username)     SRV_USER_PUBK_DIR_PATH(username) + username + "_pubk.pem"
 #define SRV_USER_TEMP_DIR_PATH(username) SRV_USER_HOME_PATH(username) + "temp/"
+#define SRV_USER_RESUME_DIR_PATH(username) SRV_USER_HOME_PATH(username) + "resume/"
+
+// -------------------------- Server Content Store -------------------------- //
+#define SRV_STORE_DIR_PATH               "./store/"
 
 
 /* ============================= CLIENT PARAMETERS ============================= */
@@ -52,6 +71,7 @@
 #define CLI_USER_PRIVK_DIR_PATH(username) CLI_USER_HOME_PATH(username) + "privk/"
 #define CLI_USER_PRIVK_PATH(username)     CLI_USER_PRIVK_DIR_PATH(username) + username + "_privk.pem"
 #define CLI_USER_TEMP_DIR_PATH(username)  CLI_USER_HOME_PATH(username) + "temp/"
+#define CLI_USER_RESUME_DIR_PATH(username) CLI_USER_HOME_PATH(username) + "resume/"
 
 
 /* ====================== CLIENT-SERVER COMMON PARAMETERS ====================== */
@@ -67,7 +87,23 @@
 #define CLI_PWD_MAX_LENGTH  30        // The user password maximum length (`\0' not included)
 
 /* --------------------- Application Constraint Parameters --------------------- */
-#define FILE_UPLOAD_MAX_SIZE 4294967295  // File upload maximum size (4GB - 1B, 2^32 - 1)
+#define FILE_UPLOAD_MAX_SIZE        10737418239999  // File upload maximum size (10000GB - 1B, the largest
+                                                    // file size representable in the files' metadata)
+#define FILE_UPLOAD_MAX_SIZE_LEGACY 4294967295      // File upload maximum size with peers not supporting
+                                                    // 64-bit file sizes (4GB - 1B, 2^32 - 1)
+#define FILE_DIGEST_SIZE            32              // The size of the SHA-256 digests of the files'
+                                                    // contents announced in deduplicated uploads
+
+/* -------------------------- Delta Uploads Parameters -------------------------- */
+#define FILE_DELTA_MIN_SIZE    1048576     // The minimum size of both a file and the server's copy of it for
+                                           // uploading it as a delta against such copy (1MB)
+#define FILE_DELTA_MAX_SIZE    1073741824  // The maximum size of the server's copy of a file for uploading it as
+                                           // a delta against such copy, bounding the time spent by the server
+                                           // in signing its blocks (1GB)
+#define FILE_DELTA_MIN_BLOCK   2048        // The minimum size of the blocks the server's copy is divided into
+#define FILE_DELTA_MAX_BLOCKS  4096        // The maximum number of blocks the server's copy is divided into,
+                                           // bounding their signatures to fit in a single session message
+#define FILE_DELTA_STRONG_SIZE 8           // The size of the blocks' strong signatures (truncated SHA-256)
 
 
 #endif //SAFECLOUD_DEFAULTS_H
\ No newline at end of file
@@ -28,6 +28,18 @@ enum execErrCode : unsigned char
   ERR_SRV_CERT_OPEN_FAILED,
   ERR_SRV_CERT_INVALID,
 
+  // -------------------- Server Session Resumption Errors -------------------- //
+  ERR_SRV_TICKET_PARAMS_INVALID,
+
+  // ------------------- Server Uploads Durability Errors ------------------- //
+  ERR_SRV_DURABILITY_PARAMS_INVALID,
+
+  // --------------------- Server Partial Uploads Errors --------------------- //
+  ERR_SRV_RETENTION_INVALID,
+
+  // ---------------------- Server Content Store Errors ---------------------- //
+  ERR_SRV_STORE_GC_INVALID,
+
   // --------------------- Server Listening Socket Errors --------------------- //
   ERR_LSK_INIT_FAILED,
   ERR_LSK_SO_REUSEADDR_FAILED,
@@ -125,13 +137,19 @@ enum execErrCode : unsigned char
 
   // ------------------ Files and Directories Common Errors ------------------ //
   ERR_DIR_OPEN_FAILED,
+  ERR_DIR_CREATE_FAILED,
   ERR_DIR_CLOSE_FAILED,
+  ERR_DIR_SYNC_FAILED,
   ERR_FILE_OPEN_FAILED,
   ERR_FILE_READ_FAILED,
   ERR_FILE_WRITE_FAILED,
   ERR_FILE_DELETE_FAILED,
+  ERR_FILE_RENAME_FAILED,
+  ERR_FILE_LINK_FAILED,
   ERR_FILE_TOO_LARGE,
   ERR_FILE_CLOSE_FAILED,
+  ERR_FILE_SYNC_FAILED,
+  ERR_FILE_UNMAP_FAILED,
 
   // ----------------------- Client Login Common Errors ----------------------- //
   ERR_LOGIN_NAME_EMPTY,
@@ -151,6 +169,8 @@ enum execErrCode : unsigned char
   ERR_OSSL_EVP_PKEY_DERIVE_INIT,
   ERR_OSSL_EVP_PKEY_DERIVE_SET_PEER,
   ERR_OSSL_EVP_PKEY_DERIVE,
+  ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY,
+  ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY,
 
   // RAND errors
   ERR_OSSL_RAND_POLL_FAILED,
@@ -173,12 +193,16 @@ enum execErrCode : unsigned char
   ERR_OSSL_EVP_SIGN_UPDATE,
   ERR_OSSL_EVP_SIGN_FINAL,
 
+  // HMAC errors
+  ERR_OSSL_HMAC_FAILED,
+
   // EVP_ENCRYPT errors
   ERR_OSSL_AES_128_CBC_PT_TOO_LARGE,
   ERR_OSSL_EVP_CIPHER_CTX_NEW,
   ERR_OSSL_EVP_ENCRYPT_INIT,
   ERR_OSSL_EVP_ENCRYPT_UPDATE,
   ERR_OSSL_EVP_ENCRYPT_FINAL,
+  ERR_OSSL_AEAD_UNKNOWN_CIPHER,
 
   // X509 Store errors
   ERR_OSSL_PEM_WRITE_BIO_X509,
@@ -215,6 +239,12 @@ enum execErrCode : unsigned char
   // ---------------  Connection-aborting Common Session Errors --------------- //
   ERR_SESSABORT_UNEXPECTED_FILE_SIZE,
   ERR_SESSABORT_UNKNOWN_SESSMSG_TYPE,
+  ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED,
+  ERR_SESSABORT_INVALID_FILE_SEGMENT,
+  ERR_SESSABORT_INVALID_STREAM,
+  ERR_SESSABORT_FILE_DECOMPRESS_FAILED,
+  ERR_SESSABORT_INVALID_KEY_EPOCH,
+  ERR_SESSABORT_INVALID_FILE_DELTA,
 
   // -----------------------------  Other Errors ----------------------------- //
   ERR_MALLOC_FAILED,
@@ -233,12 +263,24 @@ static const std::unordered_map<execErrCode,errCodeInfo> execErrCodeInfoMap =
     // ------------------ Server Private Key Retrieval Errors ------------------ //
     { ERR_SRV_PRIVKFILE_NOT_FOUND,   {FATAL, "The server RSA private key file was not found"} },
     { ERR_SRV_PRIVKFILE_OPEN_FAILED, {FATAL, "Error in opening the server's RSA private key file"} },
-    { ERR_SRV_PRIVK_INVALID,         {FATAL, "The contents of the server's private key file could not be interpreted as a valid RSA key pair"} },
+    { ERR_SRV_PRIVK_INVALID,         {FATAL, "The contents of the server's private key file could not be interpreted as a valid RSA-2048 or Ed25519 key pair"} },
 
     // ------------------ Server Certificate Retrieval Errors ------------------ //
     { ERR_SRV_CERT_OPEN_FAILED,      {FATAL, "The server certificate file could not be opened"} },
     { ERR_SRV_CERT_INVALID,          {FATAL, "The server certificate file does not contain a valid X.509 certificate"} },
 
+    // -------------------- Server Session Resumption Errors -------------------- //
+    { ERR_SRV_TICKET_PARAMS_INVALID, {ERROR, "The resumption tickets lifetime or key rotation interval is invalid"} },
+
+    // ------------------- Server Uploads Durability Errors ------------------- //
+    { ERR_SRV_DURABILITY_PARAMS_INVALID, {ERROR, "The uploads durability mode or group commit window is invalid"} },
+
+    // --------------------- Server Partial Uploads Errors --------------------- //
+    { ERR_SRV_RETENTION_INVALID,     {ERROR, "The partial uploads retention time is invalid"} },
+
+    // ---------------------- Server Content Store Errors ---------------------- //
+    { ERR_SRV_STORE_GC_INVALID,      {ERROR, "The content store garbage collection interval is invalid"} },
+
     // --------------------- Server Listening Socket Errors --------------------- //
     { ERR_LSK_INIT_FAILED,           {FATAL, "Listening Socket Initialization Failed"} },
     { ERR_LSK_SO_REUSEADDR_FAILED,   {FATAL, "Failed to set the listening socket's SO_REUSEADDR option"} },
@@ -268,7 +310,7 @@ static const std::unordered_map<execErrCode,errCodeInfo> execErrCodeInfoMap =
     // ----------------------- Server Client Login Errors ----------------------- //
     { ERR_LOGIN_PUBKEYFILE_NOT_FOUND,    {ERROR,    "The user RSA private key file was not found"} },
     { ERR_LOGIN_PUBKEYFILE_OPEN_FAILED,  {CRITICAL, "Error in opening the client's RSA public key file"} },
-    { ERR_LOGIN_PUBKEY_INVALID,          {CRITICAL, "The contents of the client's RSA public key file do not represent a valid RSA public key"} },
+    { ERR_LOGIN_PUBKEY_INVALID,          {CRITICAL, "The contents of the client's public key file do not represent a valid RSA-2048 or Ed25519 public key"} },
 
     // ---------------  Connection-aborting Server Session Errors --------------- //
     { ERR_SESSABORT_UNEXPECTED_POOL_SIZE,         {CRITICAL, "The serialized pool raw contents that were sent differ from their expected size"} },
@@ -292,7 +334,7 @@ static const std::unordered_map<execErrCode,errCodeInfo> execErrCodeInfoMap =
     { ERR_LOGIN_PWD_TOO_LONG,          {ERROR,    "The user-provided password is too long"} },
     { ERR_LOGIN_PRIVKFILE_NOT_FOUND,   {ERROR,    "The user RSA private key file was not found"} },
     { ERR_LOGIN_PRIVKFILE_OPEN_FAILED, {ERROR,    "Error in opening the user's RSA private key file"} },
-    { ERR_LOGIN_PRIVK_INVALID,         {ERROR,    "The contents of the user's private key file could not be interpreted as a valid RSA key pair"} },
+    { ERR_LOGIN_PRIVK_INVALID,         {ERROR,    "The contents of the user's private key file could not be interpreted as a valid RSA-2048 or Ed25519 key pair"} },
     { ERR_DOWNDIR_NOT_FOUND,           {CRITICAL, "The client's download directory was not found"} },
     { ERR_CLI_LOGIN_FAILED,            {CRITICAL, "Maximum number of login attempts reached, please try again later"} },
 
@@ -336,13 +378,19 @@ static const std::unordered_map<execErrCode,errCodeInfo> execErrCodeInfoMap =
 
     // ------------------ Files and Directories Common Errors ------------------ //
     { ERR_DIR_OPEN_FAILED,    {CRITICAL, "The directory was not found"} },
+    { ERR_DIR_CREATE_FAILED,  {CRITICAL, "Error in creating the directory"} },
     { ERR_DIR_CLOSE_FAILED,   {CRITICAL, "Error in closing the directory"} },
+    { ERR_DIR_SYNC_FAILED,    {CRITICAL, "Error in synchronizing the directory to storage"} },
     { ERR_FILE_OPEN_FAILED,   {CRITICAL, "The file was not found"} },
     { ERR_FILE_READ_FAILED,   {CRITICAL, "Error in reading from the file"} },
     { ERR_FILE_WRITE_FAILED,  {CRITICAL, "Error in writing to the file"} },
     { ERR_FILE_DELETE_FAILED, {CRITICAL, "Error in deleting the file"} },
+    { ERR_FILE_RENAME_FAILED, {CRITICAL, "Error in moving the file"} },
+    { ERR_FILE_LINK_FAILED,   {CRITICAL, "Error in linking the file"} },
     { ERR_FILE_TOO_LARGE,     {CRITICAL, "The file is too large"} },
     { ERR_FILE_CLOSE_FAILED,  {CRITICAL, "Error in closing the file"} },
+    { ERR_FILE_SYNC_FAILED,   {CRITICAL, "Error in synchronizing the file to storage"} },
+    { ERR_FILE_UNMAP_FAILED,  {CRITICAL, "Error in unmapping the file from memory"} },
 
     // ----------------------- Client Login Common Errors ----------------------- //
     { ERR_LOGIN_NAME_EMPTY,         {ERROR, "The user-provided name is empty"} },
@@ -362,6 +410,8 @@ static const std::unordered_map<execErrCode,errCodeInfo> execErrCodeInfoMap =
     { ERR_OSSL_EVP_PKEY_DERIVE_INIT,     {FATAL, "Key derivation context initialization failed"} },
     { ERR_OSSL_EVP_PKEY_DERIVE_SET_PEER, {FATAL, "Failed to set the remote actor's public key in the key derivation context"} },
     { ERR_OSSL_EVP_PKEY_DERIVE,          {FATAL, "Shared secret derivation failed"} },
+    { ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY,  {FATAL, "Could not write the ephemeral public key in its raw format"} },
+    { ERR_OSSL_EVP_PKEY_NEW_RAW_PUBKEY,  {FATAL, "Could not read the ephemeral public key from its raw format"} },
 
     // RAND errors
     { ERR_OSSL_RAND_POLL_FAILED,  {FATAL,"Could not generate a seed via the RAND_poll() function"} },
@@ -384,12 +434,16 @@ static const std::unordered_map<execErrCode,errCodeInfo> execErrCodeInfoMap =
     { ERR_OSSL_EVP_SIGN_UPDATE,   {FATAL, "EVP_MD signing update failed"} },
     { ERR_OSSL_EVP_SIGN_FINAL,    {FATAL, "EVP_MD signing final failed"} },
 
+    // HMAC errors
+    { ERR_OSSL_HMAC_FAILED, {FATAL, "HMAC computation failed"} },
+
     // EVP_ENCRYPT errors
     { ERR_OSSL_AES_128_CBC_PT_TOO_LARGE, {FATAL, "The plaintext to encrypt using AES_128_CBC is too large"} },
     { ERR_OSSL_EVP_CIPHER_CTX_NEW,       {FATAL, "EVP_CIPHER context creation failed"} },
     { ERR_OSSL_EVP_ENCRYPT_INIT,         {FATAL, "EVP_CIPHER encrypt initialization failed"} },
     { ERR_OSSL_EVP_ENCRYPT_UPDATE,       {FATAL, "EVP_CIPHER encrypt update failed"} },
     { ERR_OSSL_EVP_ENCRYPT_FINAL,        {FATAL, "EVP_CIPHER encrypt final failed"} },
+    { ERR_OSSL_AEAD_UNKNOWN_CIPHER,      {FATAL, "Unknown AEAD cipher"} },
 
     // X509 Store Errors
     { ERR_OSSL_PEM_WRITE_BIO_X509,  {FATAL, "Could not write the server's X.509 certificate to the memory BIO"} },
@@ -408,8 +462,8 @@ static const std::unordered_map<execErrCode,errCodeInfo> execErrCodeInfoMap =
     { ERR_OSSL_EVP_DECRYPT_FINAL,  {FATAL, "EVP_CIPHER decrypt final failed"} },
 
     // TAG errors
-    { ERR_OSSL_GET_TAG_FAILED, {FATAL, "Failed to retrieve the encryption operation's AES_128_GCM tag"} },
-    { ERR_OSSL_SET_TAG_FAILED, {FATAL, "Failed to set the decryption operation's expected AES_128_GCM tag"} },
+    { ERR_OSSL_GET_TAG_FAILED, {FATAL, "Failed to retrieve the encryption operation's AEAD tag"} },
+    { ERR_OSSL_SET_TAG_FAILED, {FATAL, "Failed to set the decryption operation's expected AEAD tag"} },
 
     // --------------------------- STSM Common Errors --------------------------- //
     { ERR_STSM_UNEXPECTED_MESSAGE,    {CRITICAL, "An out-of-order STSM message has been received"} },
@@ -424,8 +478,14 @@ static const std::unordered_map<execErrCode,errCodeInfo> execErrCodeInfoMap =
     { ERR_AESGCMMGR_INVALID_STATE, {CRITICAL, "Invalid AES_128_GCM manager state"} },
 
     // ---------------  Connection-aborting Common Session Errors --------------- //
-    { ERR_SESSABORT_UNEXPECTED_FILE_SIZE, {CRITICAL, "The file raw contents that were read differ from its expected size"} },
-    { ERR_SESSABORT_UNKNOWN_SESSMSG_TYPE, {CRITICAL, "A session message of unknown type has been received"} },
+    { ERR_SESSABORT_UNEXPECTED_FILE_SIZE,     {CRITICAL, "The file raw contents that were read differ from its expected size"} },
+    { ERR_SESSABORT_UNKNOWN_SESSMSG_TYPE,     {CRITICAL, "A session message of unknown type has been received"} },
+    { ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED, {CRITICAL, "A file raw contents' chunk failed its integrity verification"} },
+    { ERR_SESSABORT_INVALID_FILE_SEGMENT,     {CRITICAL, "A file raw contents' segment of invalid size or stream has been announced"} },
+    { ERR_SESSABORT_INVALID_STREAM,           {CRITICAL, "A session message referring to an invalid stream has been received"} },
+    { ERR_SESSABORT_FILE_DECOMPRESS_FAILED,   {CRITICAL, "A compressed file raw contents' chunk failed its decompression"} },
+    { ERR_SESSABORT_INVALID_KEY_EPOCH,        {CRITICAL, "A session rekey message or file segment of invalid key epoch has been received"} },
+    { ERR_SESSABORT_INVALID_FILE_DELTA,       {CRITICAL, "A malformed delta of a file being uploaded has been received"} },
 
     // -----------------------------  Other Errors ----------------------------- //
     { ERR_MALLOC_FAILED,            {FATAL,    "malloc() failed"} },
@@ -23,6 +23,7 @@ enum sessErrCode : unsigned char
   ERR_SESS_SRV_CLI_INTERNAL_ERROR,
   ERR_SESS_SRV_CLI_UNEXPECTED_MESSAGE,
   ERR_SESS_SRV_CLI_MALFORMED_MESSAGE,
+  ERR_SESS_SRV_CLI_NO_SPACE,
 
 
   /* -------------------------- CLIENT-SPECIFIC ERRORS -------------------------- */
@@ -43,6 +44,7 @@ enum sessErrCode : unsigned char
   ERR_SESS_CLI_SRV_INTERNAL_ERROR,
   ERR_SESS_CLI_SRV_UNEXPECTED_MESSAGE,
   ERR_SESS_CLI_SRV_MALFORMED_MESSAGE,
+  ERR_SESS_CLI_SRV_NO_SPACE,
 
 
   /* ----------------------- CLIENT-SERVER COMMON ERRORS ----------------------- */
@@ -64,6 +66,7 @@ enum sessErrCode : unsigned char
   ERR_SESS_INTERNAL_ERROR,
   ERR_SESS_UNEXPECTED_MESSAGE,
   ERR_SESS_MALFORMED_MESSAGE,
+  ERR_SESS_NO_SPACE,
 
   // -------------------------- Other Session Errors -------------------------- //
   ERR_OSSL_DECRYPT_VERIFY_FAILED,  // Session Wrapper Integrity Tag Verification Error
@@ -84,6 +87,7 @@ static const std::unordered_map<sessErrCode,errCodeInfo> sessErrCodeInfoMap =
     { ERR_SESS_SRV_CLI_INTERNAL_ERROR,     {WARNING, "The client reported an internal error"}},
     { ERR_SESS_SRV_CLI_UNEXPECTED_MESSAGE, {ERROR,   "The client reported to have received an unexpected session message"}},
     { ERR_SESS_SRV_CLI_MALFORMED_MESSAGE,  {ERROR,   "The client reported to have received a malformed session message"}},
+    { ERR_SESS_SRV_CLI_NO_SPACE,           {WARNING, "The client reported not to have enough storage space for the file"}},
 
 
     /* -------------------------- CLIENT-SPECIFIC ERRORS -------------------------- */
@@ -95,7 +99,7 @@ static const std::unordered_map<sessErrCode,errCodeInfo> sessErrCodeInfoMap =
     { ERR_SESS_FILE_NOT_FOUND,   {WARNING, "The file was not found"}},
     { ERR_SESS_FILE_READ_FAILED, {ERROR,   "Error in reading the file"}},
     { ERR_SESS_FILE_IS_DIR,      {WARNING, "The specified file is a directory"}},
-    { ERR_SESS_FILE_TOO_BIG,     {WARNING, "The file is too big (> 4GB)"}},
+    { ERR_SESS_FILE_TOO_BIG,     {WARNING, "The file is too big"}},
     { ERR_SESS_UPLOAD_DIR,       {WARNING, "Uploading directories is currently not supported"}},
     { ERR_SESS_UPLOAD_TOO_BIG,   {WARNING, "The file is too big to be uploaded"}},
     { ERR_SESS_RENAME_SAME_NAME, {WARNING, "Renaming a file to itself would have no effect"}},
@@ -104,12 +108,13 @@ static const std::unordered_map<sessErrCode,errCodeInfo> sessErrCodeInfoMap =
     { ERR_SESS_CLI_SRV_INTERNAL_ERROR,     {ERROR,    "The server reported an internal error"}},
     { ERR_SESS_CLI_SRV_UNEXPECTED_MESSAGE, {CRITICAL, "The server reported to have received an unexpected session message"}},
     { ERR_SESS_CLI_SRV_MALFORMED_MESSAGE,  {CRITICAL, "The server reported to have received a malformed session message"}},
+    { ERR_SESS_CLI_SRV_NO_SPACE,           {WARNING,  "The SafeCloud server has not enough storage space for the file"}},
 
 
     /* ----------------------- CLIENT-SERVER COMMON ERRORS ----------------------- */
 
     // ----------------------- Session Files Common Errors ----------------------- //
-    { ERR_SESS_DIR_INFO_OVERFLOW,         {ERROR,    "Directory information size overflow (>4GB)"}},
+    { ERR_SESS_DIR_INFO_OVERFLOW,         {ERROR,    "Directory information size overflow"}},
     { ERR_SESS_MAIN_FILE_IS_DIR,          {CRITICAL, "Main file found as a sub-directory of the session's main directory"}},
     { ERR_SESS_FILE_INVALID_NAME,         {ERROR,    "The provided file name is invalid"}},
     { ERR_SESS_FILE_META_NEGATIVE,        {CRITICAL, "Attempting to initialize a file's metadata to negative values"}},
@@ -125,6 +130,7 @@ static const std::unordered_map<sessErrCode,errCodeInfo> sessErrCodeInfoMap =
     { ERR_SESS_INTERNAL_ERROR,     {CRITICAL, "An internal error has occurred"}},
     { ERR_SESS_UNEXPECTED_MESSAGE, {ERROR,    "An unexpected session message was received"}},
     { ERR_SESS_MALFORMED_MESSAGE,  {ERROR,    "A malformed session message was received"}},
+    { ERR_SESS_NO_SPACE,           {WARNING,  "Not enough storage space for the file"}},
 
     // -------------------------- Other Session Errors -------------------------- //
     { ERR_OSSL_DECRYPT_VERIFY_FAILED, {ERROR,    "AES_GCM Tag verification failed"}},
@@ -0,0 +1,139 @@
+/* OpenSSL AEAD Ciphers Utility Functions Definitions */
+
+/* ================================== INCLUDES ================================== */
+#include "AEAD.h"
+#include "errCodes/execErrCodes/execErrCodes.h"
+
+// CPU features detection headers
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+
+/* ============================ FUNCTIONS DEFINITIONS ============================ */
+
+/**
+ * @brief  Returns the OpenSSL EVP_CIPHER implementing an AEAD cipher
+ * @param  cipher The AEAD cipher
+ * @return The OpenSSL EVP_CIPHER implementing the AEAD cipher
+ * @throws ERR_OSSL_AEAD_UNKNOWN_CIPHER Unknown AEAD cipher
+ */
+const EVP_CIPHER* AEAD_GetEVPCipher(AEADCipher cipher)
+ {
+  switch(cipher)
+   {
+    case AEAD_AES_128_GCM:
+     return EVP_aes_128_gcm();
+
+    case AEAD_CHACHA20_POLY1305:
+     return EVP_chacha20_poly1305();
+
+    default:
+     THROW_EXEC_EXCP(ERR_OSSL_AEAD_UNKNOWN_CIPHER, "cipher = " + std::to_string(cipher));
+   }
+ }
+
+
+/**
+ * @brief  Returns a human-readable name of an AEAD cipher
+ * @param  cipher The AEAD cipher
+ * @return The AEAD cipher's name
+ */
+std::string AEAD_CipherToStr(AEADCipher cipher)
+ {
+  switch(cipher)
+   {
+    case AEAD_AES_128_GCM:
+     return "AES_128_GCM";
+
+    case AEAD_CHACHA20_POLY1305:
+     return "ChaCha20-Poly1305";
+
+    default:
+     return "Unknown AEAD cipher (" + std::to_string(cipher) + ")";
+   }
+ }
+
+
+/**
+ * @brief  Returns whether the CPU provides the AES and carry-less multiplication
+ *         instructions used by OpenSSL to accelerate the AES_128_GCM cipher
+ * @return 'true' if AES_128_GCM is hardware-accelerated, 'false' otherwise
+ */
+bool AEAD_HasAESAccel()
+ {
+#if defined(__x86_64__) || defined(__i386__)
+  // CPUID leaf 1 registers
+  unsigned int eax, ebx, ecx, edx;
+
+  // AES-NI and PCLMULQDQ instructions
+  if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+   return false;
+  return (ecx & bit_AES) && (ecx & bit_PCLMUL);
+
+#elif defined(__aarch64__)
+  // ARMv8 Cryptography Extensions AES and PMULL instructions
+  unsigned long hwcap = getauxval(AT_HWCAP);
+  return (hwcap & HWCAP_AES) && (hwcap & HWCAP_PMULL);
+
+#else
+  // Other architectures are conservatively assumed to lack AES acceleration
+  return false;
+#endif
+ }
+
+
+/**
+ * @brief Writes the local peer's AEAD ciphers in decreasing order of
+ *        preference, as derived from the CPU features it detects
+ * @param prefs The buffer where to write the AEAD ciphers' preferences (AEAD_NUM_CIPHERS bytes)
+ */
+void AEAD_GetCipherPrefs(uint8_t* prefs)
+ {
+  // Whether AES_128_GCM is hardware-accelerated, which
+  // is detected once and for all the peer's connections
+  static const bool aesAccel = AEAD_HasAESAccel();
+
+  if(aesAccel)
+   {
+    prefs[0] = AEAD_AES_128_GCM;
+    prefs[1] = AEAD_CHACHA20_POLY1305;
+   }
+  else
+   {
+    prefs[0] = AEAD_CHACHA20_POLY1305;
+    prefs[1] = AEAD_AES_128_GCM;
+   }
+ }
+
+
+/**
+ * @brief  Selects the AEAD cipher to be used in a connection from the client's and the server's preferences,
+ *         consisting in the common cipher with the lowest sum of its rankings in both preferences, with ties
+ *         being resolved in favour of the client's preference (so that a client lacking AES hardware
+ *         acceleration obtains ChaCha20-Poly1305 even from a server that would prefer AES_128_GCM)
+ * @param  cliPrefs The client's AEAD ciphers in decreasing order of preference (AEAD_NUM_CIPHERS bytes)
+ * @param  srvPrefs The server's AEAD ciphers in decreasing order of preference (AEAD_NUM_CIPHERS bytes)
+ * @return The selected AEAD cipher, or AEAD_NONE if the peers have no AEAD cipher in common
+ */
+AEADCipher AEAD_SelectCipher(const uint8_t* cliPrefs, const uint8_t* srvPrefs)
+ {
+  // The selected cipher and the sum of its rankings in both preferences
+  AEADCipher selCipher = AEAD_NONE;
+  unsigned int selRank = 2 * AEAD_NUM_CIPHERS;
+
+  // As the client's preferences are scanned in decreasing order, a strictly
+  // lower rankings sum is required for a cipher to replace the selected one
+  for(unsigned int cliRank = 0; cliRank < AEAD_NUM_CIPHERS; cliRank++)
+   for(unsigned int srvRank = 0; srvRank < AEAD_NUM_CIPHERS; srvRank++)
+    if(cliPrefs[cliRank] != AEAD_NONE && cliPrefs[cliRank] == srvPrefs[srvRank] && cliRank + srvRank < selRank)
+     {
+      selCipher = (AEADCipher)cliPrefs[cliRank];
+      selRank   = cliRank + srvRank;
+     }
+
+  return selCipher;
+ }
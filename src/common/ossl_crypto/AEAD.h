@@ -0,0 +1,82 @@
+#ifndef SAFECLOUD_AEAD_H
+#define SAFECLOUD_AEAD_H
+
+/* OpenSSL AEAD Ciphers Utility Functions Declarations */
+
+/* ================================== INCLUDES ================================== */
+
+// System Headers
+#include <string>
+
+// OpenSSL Headers
+#include <openssl/evp.h>
+
+/*
+ * The AEAD ciphers that can be used for protecting the session phase of a connection, which is
+ * chosen in the STSM handshake from both peers' preferences (see the AEAD_SelectCipher() function),
+ * where each peer prefers AES_128_GCM if its CPU provides AES and carry-less multiplication
+ * instructions, and ChaCha20-Poly1305 otherwise (being several times faster in software)
+ */
+enum AEADCipher : uint8_t
+ {
+  AEAD_NONE = 0,           // No cipher (unused preference slot)
+  AEAD_AES_128_GCM,        // AES_128 in GCM mode (16 bytes key)
+  AEAD_CHACHA20_POLY1305   // ChaCha20-Poly1305 (32 bytes key)
+ };
+
+// The number of AEAD ciphers supported by this SafeCloud version
+#define AEAD_NUM_CIPHERS 2
+
+// The maximum key size in bytes of the supported AEAD ciphers, with shorter keys
+// consisting of the first bytes of a session key of such size (256 bit)
+#define AEAD_KEY_MAX_SIZE 32
+
+
+/* =========================== FUNCTIONS DECLARATIONS =========================== */
+
+/**
+ * @brief  Returns the OpenSSL EVP_CIPHER implementing an AEAD cipher
+ * @param  cipher The AEAD cipher
+ * @return The OpenSSL EVP_CIPHER implementing the AEAD cipher
+ * @throws ERR_OSSL_AEAD_UNKNOWN_CIPHER Unknown AEAD cipher
+ */
+const EVP_CIPHER* AEAD_GetEVPCipher(AEADCipher cipher);
+
+
+/**
+ * @brief  Returns a human-readable name of an AEAD cipher
+ * @param  cipher The AEAD cipher
+ * @return The AEAD cipher's name
+ */
+std::string AEAD_CipherToStr(AEADCipher cipher);
+
+
+/**
+ * @brief  Returns whether the CPU provides the AES and carry-less multiplication
+ *         instructions used by OpenSSL to accelerate the AES_128_GCM cipher
+ * @return 'true' if AES_128_GCM is hardware-accelerated, 'false' otherwise
+ */
+bool AEAD_HasAESAccel();
+
+
+/**
+ * @brief Writes the local peer's AEAD ciphers in decreasing order of
+ *        preference, as derived from the CPU features it detects
+ * @param prefs The buffer where to write the AEAD ciphers' preferences (AEAD_NUM_CIPHERS bytes)
+ */
+void AEAD_GetCipherPrefs(uint8_t* prefs);
+
+
+/**
+ * @brief  Selects the AEAD cipher to be used in a connection from the client's and the server's preferences,
+ *         consisting in the common cipher with the lowest sum of its rankings in both preferences, with ties
+ *         being resolved in favour of the client's preference (so that a client lacking AES hardware
+ *         acceleration obtains ChaCha20-Poly1305 even from a server that would prefer AES_128_GCM)
+ * @param  cliPrefs The client's AEAD ciphers in decreasing order of preference (AEAD_NUM_CIPHERS bytes)
+ * @param  srvPrefs The server's AEAD ciphers in decreasing order of preference (AEAD_NUM_CIPHERS bytes)
+ * @return The selected AEAD cipher, or AEAD_NONE if the peers have no AEAD cipher in common
+ */
+AEADCipher AEAD_SelectCipher(const uint8_t* cliPrefs, const uint8_t* srvPrefs);
+
+
+#endif //SAFECLOUD_AEAD_H
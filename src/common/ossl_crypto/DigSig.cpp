@@ -7,8 +7,34 @@
 /* ============================ FUNCTIONS DEFINITIONS ============================ */
 
 /**
- * @brief             Digitally signs data of arbitrary size
- *                    using the SHA-256 hash-and-sign paradigm
+ * @brief  Returns whether a long-term key is of a type supported by the
+ *         SafeCloud digital signatures, i.e. either RSA-2048 or Ed25519
+ * @param  key The long-term (public or private) key to be checked
+ * @return 'true' if the key is supported, 'false' otherwise
+ */
+bool digSigKeySupported(EVP_PKEY* key)
+ {
+  switch(EVP_PKEY_get_base_id(key))
+   {
+    // RSA keys are supported on 2048 bits only, as the size of
+    // their signatures determines the STSM authentication proofs' one
+    case EVP_PKEY_RSA:
+     return EVP_PKEY_get_bits(key) == 2048;
+
+    // Ed25519 keys
+    case EVP_PKEY_ED25519:
+     return true;
+
+    // Any other key type
+    default:
+     return false;
+   }
+ }
+
+
+/**
+ * @brief             Digitally signs data of arbitrary size using the SHA-256
+ *                    hash-and-sign paradigm with RSA keys or PureEdDSA with Ed25519 keys
  * @param signPrivKey The digital signature signer's private key
  * @param srcAddr     The initial address of the data to be signed
  * @param srcSize     The size of the data to be signed
@@ -24,38 +50,57 @@
 unsigned int digSigSign(EVP_PKEY* signPrivKey, unsigned char* srcAddr, size_t srcSize, unsigned char* sigAddr)
  {
   EVP_MD_CTX* digSigCTX;  // Digital Signature signing context
-  unsigned int sigSize;   // The resulting digital signature size
+  size_t      sigSize;    // The resulting digital signature size
+
+  // Whether the signer's key is an Ed25519 key, whose PureEdDSA signatures
+  // hash the data internally and so cannot be computed incrementally
+  bool isEd25519 = EVP_PKEY_get_base_id(signPrivKey) == EVP_PKEY_ED25519;
 
   // Create the digital signature signing context
   digSigCTX = EVP_MD_CTX_new();
   if(!digSigCTX)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_MD_CTX_NEW, OSSL_ERR_DESC);
 
-  // Initialize the digital signature signing context
-  // so to use the SHA-256 hash-and-sign paradigm
-  if(EVP_SignInit(digSigCTX, EVP_sha256()) != 1)
+  // Initialize the digital signature signing context so to use the SHA-256
+  // hash-and-sign paradigm with RSA keys (no digest with Ed25519 keys)
+  if(EVP_DigestSignInit(digSigCTX, NULL, isEd25519 ? NULL : EVP_sha256(), NULL, signPrivKey) != 1)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_SIGN_INIT, OSSL_ERR_DESC);
 
-  // Pass the address and size of the data to be signed
-  if(EVP_SignUpdate(digSigCTX, srcAddr, srcSize) != 1)
-   THROW_EXEC_EXCP(ERR_OSSL_EVP_SIGN_UPDATE, OSSL_ERR_DESC);
-
-  // Sign the data with the provided private key and write
-  // the resulting signature into the destination buffer
-  if(EVP_SignFinal(digSigCTX, sigAddr, &sigSize, signPrivKey) != 1)
-   THROW_EXEC_EXCP(ERR_OSSL_EVP_SIGN_FINAL, OSSL_ERR_DESC);
+  // The destination buffer is assumed to be large enough
+  // to contain a signature of the signer's key maximum size
+  sigSize = EVP_PKEY_get_size(signPrivKey);
+
+  // With Ed25519 keys, sign the data in a single pass
+  if(isEd25519)
+   {
+    if(EVP_DigestSign(digSigCTX, sigAddr, &sigSize, srcAddr, srcSize) != 1)
+     THROW_EXEC_EXCP(ERR_OSSL_EVP_SIGN_FINAL, OSSL_ERR_DESC);
+   }
+
+  // With RSA keys, sign the data incrementally
+  else
+   {
+    // Pass the address and size of the data to be signed
+    if(EVP_DigestSignUpdate(digSigCTX, srcAddr, srcSize) != 1)
+     THROW_EXEC_EXCP(ERR_OSSL_EVP_SIGN_UPDATE, OSSL_ERR_DESC);
+
+    // Sign the data with the provided private key and write
+    // the resulting signature into the destination buffer
+    if(EVP_DigestSignFinal(digSigCTX, sigAddr, &sigSize) != 1)
+     THROW_EXEC_EXCP(ERR_OSSL_EVP_SIGN_FINAL, OSSL_ERR_DESC);
+   }
 
   // Free the digital signature signing context
   EVP_MD_CTX_free(digSigCTX);
 
   // Return the resulting digital signature size
-  return sigSize;
+  return (unsigned int)sigSize;
  }
 
 
 /**
- * @brief            Verifies a digital signature generated
- *                   via the SHA-256 hash-and-sign paradigm
+ * @brief            Verifies a digital signature generated via the SHA-256
+ *                   hash-and-sign paradigm with RSA keys or PureEdDSA with Ed25519 keys
  * @param signPubKey The digital signature signer's public key
  * @param srcAddr    The initial address of the data to be verified
  * @param srcSize    The size of the data to be verified
@@ -70,34 +115,47 @@ unsigned int digSigSign(EVP_PKEY* signPrivKey, unsigned char* srcAddr, size_t sr
 void digSigVerify(EVP_PKEY* signPubKey, unsigned char* srcAddr, size_t srcSize, unsigned char* signAddr, size_t signSize)
  {
   EVP_MD_CTX* digVerCTX;  // Digital Signature verification context
+  int         verRet;     // The signature verification result
+
+  // Whether the signer's key is an Ed25519 key, whose PureEdDSA signatures
+  // hash the data internally and so cannot be verified incrementally
+  bool isEd25519 = EVP_PKEY_get_base_id(signPubKey) == EVP_PKEY_ED25519;
 
   // Create the digital signature verification context
   digVerCTX = EVP_MD_CTX_new();
   if(!digVerCTX)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_MD_CTX_NEW, OSSL_ERR_DESC);
 
-  // Initialize the digital signature verification
-  // context so to use the SHA-256 hash-and-sign paradigm
-  if(EVP_VerifyInit(digVerCTX, EVP_sha256()) != 1)
+  // Initialize the digital signature verification context so to use the
+  // SHA-256 hash-and-sign paradigm with RSA keys (no digest with Ed25519 keys)
+  if(EVP_DigestVerifyInit(digVerCTX, NULL, isEd25519 ? NULL : EVP_sha256(), NULL, signPubKey) != 1)
    THROW_EXEC_EXCP(ERR_OSSL_EVP_VERIFY_INIT, OSSL_ERR_DESC);
 
-  // Pass the address and size of the data to be verified
-  if(EVP_VerifyUpdate(digVerCTX, srcAddr, srcSize) != 1)
-   THROW_EXEC_EXCP(ERR_OSSL_EVP_VERIFY_UPDATE, OSSL_ERR_DESC);
+  // With Ed25519 keys, verify the digital signature in a single pass
+  if(isEd25519)
+   verRet = EVP_DigestVerify(digVerCTX, signAddr, signSize, srcAddr, srcSize);
 
-  // Verify the digital signature
-  int verFinalRet = EVP_VerifyFinal(digVerCTX, signAddr, signSize, signPubKey);
+  // With RSA keys, verify the digital signature incrementally
+  else
+   {
+    // Pass the address and size of the data to be verified
+    if(EVP_DigestVerifyUpdate(digVerCTX, srcAddr, srcSize) != 1)
+     THROW_EXEC_EXCP(ERR_OSSL_EVP_VERIFY_UPDATE, OSSL_ERR_DESC);
 
-    // EVP_VerifyFinal internal error
-    if(verFinalRet == -1)
-     THROW_EXEC_EXCP(ERR_OSSL_EVP_VERIFY_FINAL, OSSL_ERR_DESC);
+    // Verify the digital signature
+    verRet = EVP_DigestVerifyFinal(digVerCTX, signAddr, signSize);
+   }
 
     // Signature verification failed
-    if(verFinalRet == 0)
+    if(verRet == 0)
      THROW_EXEC_EXCP(ERR_OSSL_SIG_VERIFY_FAILED, OSSL_ERR_DESC);
 
-  /* At this point the digital signature is valid (verFinalRet == 1) */
+    // Signature verification internal error
+    if(verRet != 1)
+     THROW_EXEC_EXCP(ERR_OSSL_EVP_VERIFY_FINAL, OSSL_ERR_DESC);
+
+  /* At this point the digital signature is valid (verRet == 1) */
 
   // Free the digital signature verification context
   EVP_MD_CTX_free(digVerCTX);
- }
\ No newline at end of file
+ }
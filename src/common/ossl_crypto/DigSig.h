@@ -13,8 +13,17 @@
 /* =========================== FUNCTIONS DECLARATIONS =========================== */
 
 /**
- * @brief             Digitally signs data of arbitrary size
- *                    using the SHA-256 hash-and-sign paradigm
+ * @brief  Returns whether a long-term key is of a type supported by the
+ *         SafeCloud digital signatures, i.e. either RSA-2048 or Ed25519
+ * @param  key The long-term (public or private) key to be checked
+ * @return 'true' if the key is supported, 'false' otherwise
+ */
+bool digSigKeySupported(EVP_PKEY* key);
+
+
+/**
+ * @brief             Digitally signs data of arbitrary size using the SHA-256
+ *                    hash-and-sign paradigm with RSA keys or PureEdDSA with Ed25519 keys
  * @param signPrivKey The digital signature signer's private key
  * @param srcAddr     The initial address of the data to be signed
  * @param srcSize     The size of the data to be signed
@@ -31,8 +40,8 @@ unsigned int digSigSign(EVP_PKEY* signPrivKey, unsigned char* srcAddr, size_t sr
 
 
 /**
- * @brief            Verifies a digital signature generated
- *                   via the SHA-256 hash-and-sign paradigm
+ * @brief            Verifies a digital signature generated via the SHA-256
+ *                   hash-and-sign paradigm with RSA keys or PureEdDSA with Ed25519 keys
  * @param signPubKey The digital signature signer's public key
  * @param srcAddr    The initial address of the data to be verified
  * @param srcSize    The size of the data to be verified
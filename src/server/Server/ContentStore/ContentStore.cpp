@@ -0,0 +1,376 @@
+/* SafeCloud Server Content Store Definitions */
+
+/* ================================== INCLUDES ================================== */
+
+// System Headers
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <vector>
+
+// SafeCloud Headers
+#include "ContentStore.h"
+#include "defaults.h"
+#include "errCodes/execErrCodes/execErrCodes.h"
+
+/* =============================== PRIVATE METHODS =============================== */
+
+/**
+ * @brief Sets the next garbage collection step to be performed after a delay
+ * @param delay The delay of the next garbage collection step in seconds
+ */
+void ContentStore::scheduleGC(long delay)
+ {
+  clock_gettime(CLOCK_MONOTONIC, &_gcDeadline);
+  _gcDeadline.tv_sec += delay;
+ }
+
+
+/* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+/**
+ * @brief  ContentStore object constructor, creating the store directory if the store is enabled
+ * @param  gcInterval The garbage collection interval in seconds (0 = store disabled)
+ * @throws ERR_SRV_STORE_GC_INVALID Negative garbage collection interval
+ * @throws ERR_DIR_CREATE_FAILED    The store directory could not be created
+ */
+ContentStore::ContentStore(int gcInterval) : _gcInterval(gcInterval), _gcDir(nullptr), _gcFreed(0), _gcDeadline()
+ {
+  // Ensure the garbage collection interval to be valid
+  if(gcInterval < 0)
+   THROW_EXEC_EXCP(ERR_SRV_STORE_GC_INVALID, "interval = " + std::to_string(gcInterval));
+
+  if(!enabled())
+   return;
+
+  // Create the store directory if it does not exist
+  if(mkdir(SRV_STORE_DIR_PATH, 0700) != 0 && errno != EEXIST)
+   THROW_EXEC_EXCP(ERR_DIR_CREATE_FAILED, SRV_STORE_DIR_PATH, ERRNO_DESC);
+
+  // Schedule the first garbage collection
+  scheduleGC(_gcInterval);
+ }
+
+
+/**
+ * @brief ContentStore object destructor, closing the store
+ *        directory swept by the garbage collection in progress
+ */
+ContentStore::~ContentStore()
+ {
+  if(_gcDir != nullptr && closedir(_gcDir) != 0)
+   LOG_EXEC_CODE(ERR_DIR_CLOSE_FAILED, SRV_STORE_DIR_PATH, ERRNO_DESC);
+ }
+
+
+/* ============================ OTHER PUBLIC METHODS ============================ */
+
+/**
+ * @brief  Returns whether the users' files are deduplicated in the content store
+ * @return Whether the users' files are deduplicated in the content store
+ */
+bool ContentStore::enabled() const
+ { return _gcInterval > 0; }
+
+
+/**
+ * @brief  Returns a digest context of the contents of a file being uploaded, which if the upload
+ *         is resumed is initialized with the contents already received in the file's first bytes
+ * @param  filePath The path of the file being uploaded
+ * @param  length   The number of the file's first bytes already received
+ * @return The digest context of the file's contents, or 'nullptr' if the store is disabled or the
+ *         context could not be initialized (logged), in which case the file is not deduplicated
+ */
+EVP_MD_CTX* ContentStore::initDigest(const std::string& filePath, uint64_t length) const
+ {
+  EVP_MD_CTX*                mdCtx;  // The digest context of the file's contents
+  int                        fileFd; // The file descriptor the file's first bytes are read from
+  std::vector<unsigned char> buf;    // The buffer the file's first bytes are read into
+  ssize_t                    readRet;
+
+  if(!enabled())
+   return nullptr;
+
+  mdCtx = EVP_MD_CTX_new();
+  if(mdCtx == nullptr)
+   {
+    LOG_EXEC_CODE(ERR_OSSL_EVP_MD_CTX_NEW, OSSL_ERR_DESC);
+    return nullptr;
+   }
+  if(EVP_DigestInit_ex(mdCtx, EVP_sha256(), NULL) != 1)
+   {
+    LOG_EXEC_CODE(ERR_OSSL_EVP_DIGEST_INIT, OSSL_ERR_DESC);
+    EVP_MD_CTX_free(mdCtx);
+    return nullptr;
+   }
+
+  if(length == 0)
+   return mdCtx;
+
+  // Digest the file's first bytes, which were received by a previous upload
+  fileFd = open(filePath.c_str(), O_RDONLY);
+  if(fileFd == -1)
+   {
+    LOG_EXEC_CODE(ERR_FILE_OPEN_FAILED, filePath, ERRNO_DESC);
+    EVP_MD_CTX_free(mdCtx);
+    return nullptr;
+   }
+
+  buf.resize(65536);
+  while(length > 0)
+   {
+    readRet = read(fileFd, buf.data(), length < buf.size() ? length : buf.size());
+    if(readRet <= 0)
+     {
+      LOG_EXEC_CODE(ERR_FILE_READ_FAILED, filePath, readRet == 0 ? "unexpected end of file" : ERRNO_DESC);
+      break;
+     }
+    if(EVP_DigestUpdate(mdCtx, buf.data(), (size_t)readRet) != 1)
+     {
+      LOG_EXEC_CODE(ERR_OSSL_EVP_DIGEST_UPDATE, OSSL_ERR_DESC);
+      break;
+     }
+    length -= (uint64_t)readRet;
+   }
+
+  if(close(fileFd) != 0)
+   LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, filePath, ERRNO_DESC);
+
+  if(length > 0)
+   {
+    EVP_MD_CTX_free(mdCtx);
+    return nullptr;
+   }
+  return mdCtx;
+ }
+
+
+/**
+ * @brief  Returns the path of the object of a file's contents in the store
+ * @param  digest      The SHA-256 digest of the file's contents
+ * @param  lastModTime The file's last modification time
+ * @return The path of the object of the file's contents
+ */
+std::string ContentStore::getObjPath(const unsigned char* digest, long int lastModTime) const
+ {
+  char digestHex[2 * FILE_DIGEST_SIZE + 1];  // The hexadecimal representation of the digest
+
+  for(unsigned int i = 0; i < FILE_DIGEST_SIZE; i++)
+   sprintf(&digestHex[2 * i], "%02x", digest[i]);
+
+  return SRV_STORE_DIR_PATH + std::string(digestHex, 2 * FILE_DIGEST_SIZE) + "_" + std::to_string(lastModTime);
+ }
+
+
+/**
+ * @brief  Returns whether an object of the store is referenced by a user's storage pool
+ * @param  objPath The path of the object
+ * @param  poolDir The absolute path of the user's storage pool
+ * @return Whether the object exists and is referenced by the user's storage pool
+ */
+bool ContentStore::isHeld(const std::string& objPath, const std::string& poolDir) const
+ {
+  struct stat objInfo;   // Information on the object
+  struct stat fileInfo;  // Information on a file in the user's storage pool
+  DIR*        dir;       // The user's storage pool
+  dirent*     dirEntry;  // An entry of the user's storage pool
+  bool        held = false;
+
+  // An object not existing or not referenced by any storage pool is not held by the user
+  if(!enabled() || stat(objPath.c_str(), &objInfo) != 0 || !S_ISREG(objInfo.st_mode) || objInfo.st_nlink < 2)
+   return false;
+
+  // Look for a file in the user's storage pool linking the object
+  dir = opendir(poolDir.c_str());
+  if(dir == nullptr)
+   {
+    LOG_EXEC_CODE(ERR_DIR_OPEN_FAILED, poolDir, ERRNO_DESC);
+    return false;
+   }
+
+  while(!held && (dirEntry = readdir(dir)) != nullptr)
+   held = dirEntry->d_ino == objInfo.st_ino && dirEntry->d_name[0] != '.' &&
+          stat((poolDir + dirEntry->d_name).c_str(), &fileInfo) == 0 &&
+          fileInfo.st_ino == objInfo.st_ino && fileInfo.st_dev == objInfo.st_dev;
+
+  if(closedir(dir) != 0)
+   LOG_EXEC_CODE(ERR_DIR_CLOSE_FAILED, poolDir, ERRNO_DESC);
+
+  return held;
+ }
+
+
+/**
+ * @brief  Links an object of the store as a new file in a user's storage pool
+ * @param  objPath  The path of the object
+ * @param  filePath The absolute path of the file in the user's storage pool, which must not exist
+ * @return Whether the object has been linked (failures being logged)
+ */
+bool ContentStore::linkObj(const std::string& objPath, const std::string& filePath) const
+ {
+  if(link(objPath.c_str(), filePath.c_str()) != 0)
+   {
+    LOG_EXEC_CODE(ERR_FILE_LINK_FAILED, "source: \"" + objPath + "\", dest: \"" + filePath + "\"", ERRNO_DESC);
+    return false;
+   }
+  return true;
+ }
+
+
+/**
+ * @brief  Deduplicates an uploaded file in a user's storage pool, replacing it with a link to the object
+ *         of its contents if the store holds it or otherwise linking it into the store as such object,
+ *         with failures, which only prevent the file from being deduplicated, being logged
+ * @param  filePath  The absolute path of the uploaded file
+ * @param  stagePath The absolute path in the user's temporary directory through which the
+ *                   object is linked, so to atomically replace the uploaded file
+ * @param  objPath   The path of the object of the file's contents
+ * @return Whether the file has been replaced by a link to an object already held by the store
+ */
+bool ContentStore::ingest(const std::string& filePath, const std::string& stagePath, const std::string& objPath) const
+ {
+  struct stat fileInfo;  // Information on the uploaded file
+  struct stat objInfo;   // Information on the object of the file's contents
+
+  if(stat(filePath.c_str(), &fileInfo) != 0)
+   {
+    LOG_EXEC_CODE(ERR_FILE_OPEN_FAILED, filePath, ERRNO_DESC);
+    return false;
+   }
+
+  // If the store does not hold the object of the file's contents, link the file as such
+  // object (which fails if the store and the storage pool are on different filesystems)
+  if(stat(objPath.c_str(), &objInfo) != 0)
+   {
+    if(errno != ENOENT || link(filePath.c_str(), objPath.c_str()) != 0)
+     LOG_EXEC_CODE(ERR_FILE_LINK_FAILED, "source: \"" + filePath + "\", dest: \"" + objPath + "\"", ERRNO_DESC);
+    return false;
+   }
+
+  // An object whose size differs from the file's has been altered outside of
+  // the server, and is not trusted to hold the file's contents
+  if(!S_ISREG(objInfo.st_mode) || objInfo.st_size != fileInfo.st_size)
+   {
+    LOG_WARNING("Content store object \"" + objPath + "\" does not match its size ("
+                + std::to_string(objInfo.st_size) + " != " + std::to_string(fileInfo.st_size) + " bytes)")
+    return false;
+   }
+
+  // Replace the file with a link to the object, staged in the temporary directory
+  // so that the file is atomically replaced and a failure leaves it untouched
+  unlink(stagePath.c_str());
+  if(link(objPath.c_str(), stagePath.c_str()) != 0)
+   {
+    LOG_EXEC_CODE(ERR_FILE_LINK_FAILED, "source: \"" + objPath + "\", dest: \"" + stagePath + "\"", ERRNO_DESC);
+    return false;
+   }
+  if(rename(stagePath.c_str(), filePath.c_str()) != 0)
+   {
+    LOG_EXEC_CODE(ERR_FILE_RENAME_FAILED, "source: \"" + stagePath + "\", dest: \"" + filePath + "\"", ERRNO_DESC);
+    unlink(stagePath.c_str());
+    return false;
+   }
+  return true;
+ }
+
+
+/**
+ * @brief  Returns whether the store is enabled and, if so, the time remaining until
+ *         the next garbage collection step is due (select() timeout purposes)
+ * @param  timeout The time remaining until the next garbage collection step is due
+ * @return Whether the store is enabled
+ */
+bool ContentStore::getTimeout(timeval& timeout) const
+ {
+  timespec now;   // The current (monotonic) time
+  long remUs;     // The time remaining until the next garbage collection step in microseconds
+
+  if(!enabled())
+   return false;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  remUs = (_gcDeadline.tv_sec - now.tv_sec) * 1000000 + (_gcDeadline.tv_nsec - now.tv_nsec) / 1000;
+  if(remUs < 0)
+   remUs = 0;
+
+  timeout.tv_sec  = remUs / 1000000;
+  timeout.tv_usec = remUs % 1000000;
+  return true;
+ }
+
+
+/**
+ * @brief  Returns whether the next garbage collection step is due
+ * @return Whether the next garbage collection step is due
+ */
+bool ContentStore::isDue() const
+ {
+  timespec now;   // The current (monotonic) time
+
+  if(!enabled())
+   return false;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec > _gcDeadline.tv_sec || (now.tv_sec == _gcDeadline.tv_sec && now.tv_nsec >= _gcDeadline.tv_nsec);
+ }
+
+
+/**
+ * @brief Performs a garbage collection step, starting a new collection if none is in progress, deleting
+ *        the unreferenced objects among the next SRV_STORE_GC_BATCH entries of the store directory and,
+ *        once all have been examined, scheduling the next collection after the garbage collection interval
+ */
+void ContentStore::collect()
+ {
+  dirent*     dirEntry;  // An entry of the store directory
+  struct stat objInfo;   // Information on an object
+  std::string objPath;   // The path of an object
+
+  // Start a new garbage collection
+  if(_gcDir == nullptr)
+   {
+    _gcDir = opendir(SRV_STORE_DIR_PATH);
+    if(_gcDir == nullptr)
+     {
+      LOG_EXEC_CODE(ERR_DIR_OPEN_FAILED, SRV_STORE_DIR_PATH, ERRNO_DESC);
+      scheduleGC(_gcInterval);
+      return;
+     }
+    _gcFreed = 0;
+   }
+
+  // Delete the objects no longer linked by any storage pool among the next entries of the store directory,
+  // where as the server is single-threaded an object cannot be linked while it is being examined
+  for(unsigned int i = 0; i < SRV_STORE_GC_BATCH; i++)
+   {
+    dirEntry = readdir(_gcDir);
+
+    // If all entries have been examined, schedule the next garbage collection
+    if(dirEntry == nullptr)
+     {
+      if(closedir(_gcDir) != 0)
+       LOG_EXEC_CODE(ERR_DIR_CLOSE_FAILED, SRV_STORE_DIR_PATH, ERRNO_DESC);
+      _gcDir = nullptr;
+
+      if(_gcFreed > 0)
+       LOG_INFO("Content store garbage collection deleted " + std::to_string(_gcFreed) + " unreferenced objects")
+
+      scheduleGC(_gcInterval);
+      return;
+     }
+
+    if(dirEntry->d_name[0] == '.')
+     continue;
+    objPath = SRV_STORE_DIR_PATH + std::string(dirEntry->d_name);
+    if(stat(objPath.c_str(), &objInfo) == 0 && S_ISREG(objInfo.st_mode) && objInfo.st_nlink == 1)
+     {
+      if(unlink(objPath.c_str()) != 0)
+       LOG_EXEC_CODE(ERR_FILE_DELETE_FAILED, objPath, ERRNO_DESC);
+      else
+       _gcFreed++;
+     }
+   }
+
+  // Continue the garbage collection as soon as the server's pending socket events have been served
+  scheduleGC(0);
+ }
\ No newline at end of file
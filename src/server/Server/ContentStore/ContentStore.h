@@ -0,0 +1,153 @@
+#ifndef SAFECLOUD_CONTENTSTORE_H
+#define SAFECLOUD_CONTENTSTORE_H
+
+/*
+ * This class represents the content-addressed store optionally used by the SafeCloud server for
+ * deduplicating the files in the users' storage pools, where:
+ *
+ *   - Each distinct file content is stored once as an "object" in the server's store directory, whose name
+ *     is the hexadecimal SHA-256 digest of its contents followed by its last modification time, the latter
+ *     being part of the key as it is an attribute of the object's inode shared by all its names
+ *
+ *   - The files in the users' storage pools are hard links to the objects of their contents, so that a
+ *     storage pool remains a plain directory mapping the user's file names to their contents and the number
+ *     of pool files referencing an object is maintained by the filesystem as its link count (minus one)
+ *
+ *   - Uploaded files are digested as their segments are received and once completed are replaced by a link
+ *     to the object of their contents if the store already holds it, or are otherwise linked as such object
+ *
+ *   - If the client announces the digest of a file it is about to upload (see 'STSM_FEATURE_DEDUP_UPLOADS')
+ *     and the store holds the object of its contents which is already referenced by the user's storage pool,
+ *     the object is linked under the file's name without its contents being transferred, where requiring
+ *     the user to already hold the contents prevents a client knowing only their digest from obtaining
+ *     them or probing whether other users hold them (their uploads are deduplicated once completed)
+ *
+ *   - Objects which are no longer referenced by any storage pool (i.e. whose link count is 1)
+ *     are deleted by a garbage collection periodically sweeping the store in small steps
+ *     carried out between the server's socket events (see 'Server::srvLoop()')
+ */
+
+/* ================================== INCLUDES ================================== */
+#include <cstdint>
+#include <ctime>
+#include <sys/time.h>
+#include <dirent.h>
+#include <string>
+#include <openssl/evp.h>
+#include <openssl/err.h>
+
+
+class ContentStore
+ {
+  private:
+
+   /* ================================= ATTRIBUTES ================================= */
+   long          _gcInterval;  // The garbage collection interval in seconds (0 = store disabled)
+   DIR*          _gcDir;       // The store directory swept by the garbage collection in progress, if any
+   unsigned long _gcFreed;     // The number of objects deleted by the garbage collection in progress
+   timespec      _gcDeadline;  // The (monotonic) time at which the next garbage collection step is performed
+
+   /* =============================== PRIVATE METHODS =============================== */
+
+   /**
+    * @brief Sets the next garbage collection step to be performed after a delay
+    * @param delay The delay of the next garbage collection step in seconds
+    */
+   void scheduleGC(long delay);
+
+  public:
+
+   /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+   /**
+    * @brief  ContentStore object constructor, creating the store directory if the store is enabled
+    * @param  gcInterval The garbage collection interval in seconds (0 = store disabled)
+    * @throws ERR_SRV_STORE_GC_INVALID Negative garbage collection interval
+    * @throws ERR_DIR_CREATE_FAILED    The store directory could not be created
+    */
+   explicit ContentStore(int gcInterval);
+
+   /**
+    * @brief ContentStore object destructor, closing the store
+    *        directory swept by the garbage collection in progress
+    */
+   ~ContentStore();
+
+   /* ============================ OTHER PUBLIC METHODS ============================ */
+
+   /**
+    * @brief  Returns whether the users' files are deduplicated in the content store
+    * @return Whether the users' files are deduplicated in the content store
+    */
+   bool enabled() const;
+
+   /**
+    * @brief  Returns a digest context of the contents of a file being uploaded, which if the upload
+    *         is resumed is initialized with the contents already received in the file's first bytes
+    * @param  filePath The path of the file being uploaded
+    * @param  length   The number of the file's first bytes already received
+    * @return The digest context of the file's contents, or 'nullptr' if the store is disabled or the
+    *         context could not be initialized (logged), in which case the file is not deduplicated
+    */
+   EVP_MD_CTX* initDigest(const std::string& filePath, uint64_t length) const;
+
+   /**
+    * @brief  Returns the path of the object of a file's contents in the store
+    * @param  digest      The SHA-256 digest of the file's contents
+    * @param  lastModTime The file's last modification time
+    * @return The path of the object of the file's contents
+    */
+   std::string getObjPath(const unsigned char* digest, long int lastModTime) const;
+
+   /**
+    * @brief  Returns whether an object of the store is referenced by a user's storage pool
+    * @param  objPath The path of the object
+    * @param  poolDir The absolute path of the user's storage pool
+    * @return Whether the object exists and is referenced by the user's storage pool
+    */
+   bool isHeld(const std::string& objPath, const std::string& poolDir) const;
+
+   /**
+    * @brief  Links an object of the store as a new file in a user's storage pool
+    * @param  objPath  The path of the object
+    * @param  filePath The absolute path of the file in the user's storage pool, which must not exist
+    * @return Whether the object has been linked (failures being logged)
+    */
+   bool linkObj(const std::string& objPath, const std::string& filePath) const;
+
+   /**
+    * @brief  Deduplicates an uploaded file in a user's storage pool, replacing it with a link to the object
+    *         of its contents if the store holds it or otherwise linking it into the store as such object,
+    *         with failures, which only prevent the file from being deduplicated, being logged
+    * @param  filePath  The absolute path of the uploaded file
+    * @param  stagePath The absolute path in the user's temporary directory through which the
+    *                   object is linked, so to atomically replace the uploaded file
+    * @param  objPath   The path of the object of the file's contents
+    * @return Whether the file has been replaced by a link to an object already held by the store
+    */
+   bool ingest(const std::string& filePath, const std::string& stagePath, const std::string& objPath) const;
+
+   /**
+    * @brief  Returns whether the store is enabled and, if so, the time remaining until
+    *         the next garbage collection step is due (select() timeout purposes)
+    * @param  timeout The time remaining until the next garbage collection step is due
+    * @return Whether the store is enabled
+    */
+   bool getTimeout(timeval& timeout) const;
+
+   /**
+    * @brief  Returns whether the next garbage collection step is due
+    * @return Whether the next garbage collection step is due
+    */
+   bool isDue() const;
+
+   /**
+    * @brief Performs a garbage collection step, starting a new collection if none is in progress, deleting
+    *        the unreferenced objects among the next SRV_STORE_GC_BATCH entries of the store directory and,
+    *        once all have been examined, scheduling the next collection after the garbage collection interval
+    */
+   void collect();
+ };
+
+
+#endif //SAFECLOUD_CONTENTSTORE_H
\ No newline at end of file
@@ -0,0 +1,206 @@
+/* SafeCloud Server Uploads Group Commit Definitions */
+
+/* ================================== INCLUDES ================================== */
+
+// System Headers
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <unordered_map>
+
+// SafeCloud Headers
+#include "GroupCommit.h"
+#include "errCodes/execErrCodes/execErrCodes.h"
+
+/* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+/**
+ * @brief  GroupCommit object constructor
+ * @param  mode     The server's durability mode of the uploaded files (see 'durabilityMode')
+ * @param  windowMs The group commit window in milliseconds
+ * @throws ERR_SRV_DURABILITY_PARAMS_INVALID Unknown durability mode or negative group commit window
+ */
+GroupCommit::GroupCommit(int mode, int windowMs)
+ : _mode(DURABILITY_NONE), _windowMs(windowMs), _pending(), _deadline()
+ {
+  // Ensure the durability mode and the group commit window to be valid
+  if(mode < DURABILITY_NONE || mode > DURABILITY_FILE_DIR || windowMs < 0)
+   THROW_EXEC_EXCP(ERR_SRV_DURABILITY_PARAMS_INVALID, "mode = " + std::to_string(mode)
+                                                      + ", window = " + std::to_string(windowMs));
+  _mode = static_cast<durabilityMode>(mode);
+ }
+
+
+/**
+ * @brief GroupCommit object destructor, closing the
+ *        file descriptors of the uploads still pending
+ */
+GroupCommit::~GroupCommit()
+ { cancelUploads(-1); }
+
+
+/* ============================ OTHER PUBLIC METHODS ============================ */
+
+/**
+ * @brief  Returns whether completed uploads must be made durable before being notified to clients
+ * @return Whether completed uploads must be made durable before being notified to clients
+ */
+bool GroupCommit::enabled() const
+ { return _mode != DURABILITY_NONE; }
+
+
+/**
+ * @brief Adds a completed upload to the group commit, starting its window if no other upload is pending
+ *        and discarding a previous upload on the same stream that is still pending
+ * @param csk      The connection socket of the client the upload belongs to
+ * @param streamId The identifier of the session stream of the upload
+ * @param fileFd   A read-only file descriptor of the uploaded file, which is closed by the group commit
+ * @param dirPath  The absolute path of the directory the uploaded file was linked into
+ */
+void GroupCommit::addUpload(int csk, uint8_t streamId, int fileFd, const std::string& dirPath)
+ {
+  // Discard a previous upload on the same stream still pending, whose operation must have been
+  // aborted (and which otherwise would notify the completion of this upload before its commit)
+  for(auto it = _pending.begin(); it != _pending.end(); ++it)
+   if(it->csk == csk && it->streamId == streamId)
+    {
+     if(close(it->fileFd) != 0)
+      LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, "fd " + std::to_string(it->fileFd), ERRNO_DESC);
+     _pending.erase(it);
+     break;
+    }
+
+  // If this is the first upload of a new batch, start its group commit window
+  if(_pending.empty())
+   {
+    clock_gettime(CLOCK_MONOTONIC, &_deadline);
+    _deadline.tv_sec  += _windowMs / 1000;
+    _deadline.tv_nsec += (_windowMs % 1000) * 1000000;
+    if(_deadline.tv_nsec >= 1000000000)
+     {
+      _deadline.tv_sec++;
+      _deadline.tv_nsec -= 1000000000;
+     }
+   }
+
+  _pending.push_back({csk, streamId, fileFd, dirPath});
+ }
+
+
+/**
+ * @brief Removes from the group commit the pending uploads of a client whose connection is closed
+ * @param csk The connection socket of the client (-1 = all clients)
+ */
+void GroupCommit::cancelUploads(int csk)
+ {
+  for(auto it = _pending.begin(); it != _pending.end();)
+   if(csk == -1 || it->csk == csk)
+    {
+     if(close(it->fileFd) != 0)
+      LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, "fd " + std::to_string(it->fileFd), ERRNO_DESC);
+     it = _pending.erase(it);
+    }
+   else
+    ++it;
+ }
+
+
+/**
+ * @brief  Returns whether uploads are awaiting the group commit and, if so, the time
+ *         remaining until their window elapses (select() timeout purposes)
+ * @param  timeout The time remaining until the group commit window elapses
+ * @return Whether uploads are awaiting the group commit
+ */
+bool GroupCommit::getTimeout(timeval& timeout) const
+ {
+  timespec now;   // The current (monotonic) time
+  long remUs;     // The time remaining until the group commit window elapses in microseconds
+
+  if(_pending.empty())
+   return false;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  remUs = (_deadline.tv_sec - now.tv_sec) * 1000000 + (_deadline.tv_nsec - now.tv_nsec) / 1000;
+  if(remUs < 0)
+   remUs = 0;
+
+  timeout.tv_sec  = remUs / 1000000;
+  timeout.tv_usec = remUs % 1000000;
+  return true;
+ }
+
+
+/**
+ * @brief  Returns whether the pending uploads' group commit window has elapsed
+ * @return Whether the pending uploads' group commit window has elapsed
+ */
+bool GroupCommit::isDue() const
+ {
+  timespec now;   // The current (monotonic) time
+
+  if(_pending.empty())
+   return false;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec > _deadline.tv_sec || (now.tv_sec == _deadline.tv_sec && now.tv_nsec >= _deadline.tv_nsec);
+ }
+
+
+/**
+ * @brief Synchronizes the files of the pending uploads and, depending on the durability mode,
+ *        the directories they were linked into, each directory being synchronized only once
+ * @param committed The uploads that were committed, along with whether they are durable
+ */
+void GroupCommit::commit(std::vector<committedUpload>& committed)
+ {
+  // Whether each directory of the batch's uploads has been successfully synchronized
+  std::unordered_map<std::string,bool> dirsSynced;
+
+  // File descriptor of a directory to be synchronized
+  int dirFd;
+
+  committed.clear();
+
+  /*
+   * Synchronize the contents of all the batch's files first, so that the storage's journal commit
+   * triggered by the first synchronization also covers the following ones (which then complete
+   * with little to no further I/O) and the directories are synchronized only after their files
+   */
+  for(auto& upload : _pending)
+   {
+    committed.push_back({upload.csk, upload.streamId, true});
+    if(fsync(upload.fileFd) != 0)
+     {
+      LOG_EXEC_CODE(ERR_FILE_SYNC_FAILED, "fd " + std::to_string(upload.fileFd), ERRNO_DESC);
+      committed.back().durable = false;
+     }
+    if(close(upload.fileFd) != 0)
+     LOG_EXEC_CODE(ERR_FILE_CLOSE_FAILED, "fd " + std::to_string(upload.fileFd), ERRNO_DESC);
+   }
+
+  // If required, synchronize once each directory the batch's files were linked into
+  if(_mode == DURABILITY_FILE_DIR)
+   for(size_t i = 0; i < _pending.size(); i++)
+    {
+     auto dirIt = dirsSynced.find(_pending[i].dirPath);
+     if(dirIt == dirsSynced.end())
+      {
+       dirIt = dirsSynced.emplace(_pending[i].dirPath, false).first;
+       dirFd = open(_pending[i].dirPath.c_str(), O_RDONLY | O_DIRECTORY);
+       if(dirFd == -1)
+        LOG_EXEC_CODE(ERR_DIR_OPEN_FAILED, _pending[i].dirPath, ERRNO_DESC);
+       else
+        {
+         if(fsync(dirFd) != 0)
+          LOG_EXEC_CODE(ERR_DIR_SYNC_FAILED, _pending[i].dirPath, ERRNO_DESC);
+         else
+          dirIt->second = true;
+         if(close(dirFd) != 0)
+          LOG_EXEC_CODE(ERR_DIR_CLOSE_FAILED, _pending[i].dirPath, ERRNO_DESC);
+        }
+      }
+     committed[i].durable = committed[i].durable && dirIt->second;
+    }
+
+  _pending.clear();
+ }
\ No newline at end of file
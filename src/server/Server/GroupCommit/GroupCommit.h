@@ -0,0 +1,132 @@
+#ifndef SAFECLOUD_GROUPCOMMIT_H
+#define SAFECLOUD_GROUPCOMMIT_H
+
+/*
+ * This class represents the group commit used by the SafeCloud server for making the files uploaded
+ * into the users' storage pools durable before notifying their clients of the uploads' completion,
+ * where:
+ *
+ *   - Depending on the server's durability mode, a completed upload requires its file
+ *     and possibly also the directory it was linked into to be synchronized to storage
+ *
+ *   - Rather than being synchronized as soon as they complete, uploads are collected for a short
+ *     "window" starting from the first upload of a batch and synchronized together once it elapses,
+ *     so that the uploads completing within the same window share the storage's journal commits
+ *     and their directories are synchronized only once
+ *
+ *   - The 'COMPLETED' session messages of the uploads of a batch are sent only
+ *     after the batch has been synchronized (see 'SrvSessMgr::uploadCommitCallback()')
+ */
+
+/* ================================== INCLUDES ================================== */
+#include <cstdint>
+#include <ctime>
+#include <sys/time.h>
+#include <string>
+#include <vector>
+
+// The server's durability modes of the uploaded files
+enum durabilityMode : uint8_t
+ {
+  DURABILITY_NONE,     // Uploads complete as soon as their files are linked into the storage pool
+  DURABILITY_FILE,     // Uploads complete once their files' contents are synchronized to storage
+  DURABILITY_FILE_DIR  // Uploads complete once both their files' contents and
+                       // the storage pool directory are synchronized to storage
+ };
+
+
+class GroupCommit
+ {
+  public:
+
+   // An upload made durable (or failed to) by a group commit
+   struct committedUpload
+    {
+     int     csk;       // The connection socket of the client the upload belongs to
+     uint8_t streamId;  // The identifier of the session stream of the upload
+     bool    durable;   // Whether the uploaded file has been successfully synchronized to storage
+    };
+
+  private:
+
+   // An upload awaiting the group commit
+   struct pendingUpload
+    {
+     int         csk;       // The connection socket of the client the upload belongs to
+     uint8_t     streamId;  // The identifier of the session stream of the upload
+     int         fileFd;    // A read-only file descriptor of the uploaded file
+     std::string dirPath;   // The absolute path of the directory the uploaded file was linked into
+    };
+
+   /* ================================= ATTRIBUTES ================================= */
+   durabilityMode             _mode;      // The server's durability mode of the uploaded files
+   long                       _windowMs;  // The group commit window in milliseconds
+   std::vector<pendingUpload> _pending;   // The uploads awaiting the group commit
+   timespec                   _deadline;  // The (monotonic) time at which the pending uploads are committed
+
+  public:
+
+   /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+   /**
+    * @brief  GroupCommit object constructor
+    * @param  mode     The server's durability mode of the uploaded files (see 'durabilityMode')
+    * @param  windowMs The group commit window in milliseconds
+    * @throws ERR_SRV_DURABILITY_PARAMS_INVALID Unknown durability mode or negative group commit window
+    */
+   GroupCommit(int mode, int windowMs);
+
+   /**
+    * @brief GroupCommit object destructor, closing the
+    *        file descriptors of the uploads still pending
+    */
+   ~GroupCommit();
+
+   /* ============================ OTHER PUBLIC METHODS ============================ */
+
+   /**
+    * @brief  Returns whether completed uploads must be made durable before being notified to clients
+    * @return Whether completed uploads must be made durable before being notified to clients
+    */
+   bool enabled() const;
+
+   /**
+    * @brief Adds a completed upload to the group commit, starting its window if no other upload is pending
+    *        and discarding a previous upload on the same stream that is still pending
+    * @param csk      The connection socket of the client the upload belongs to
+    * @param streamId The identifier of the session stream of the upload
+    * @param fileFd   A read-only file descriptor of the uploaded file, which is closed by the group commit
+    * @param dirPath  The absolute path of the directory the uploaded file was linked into
+    */
+   void addUpload(int csk, uint8_t streamId, int fileFd, const std::string& dirPath);
+
+   /**
+    * @brief Removes from the group commit the pending uploads of a client whose connection is closed
+    * @param csk The connection socket of the client (-1 = all clients)
+    */
+   void cancelUploads(int csk);
+
+   /**
+    * @brief  Returns whether uploads are awaiting the group commit and, if so, the time
+    *         remaining until their window elapses (select() timeout purposes)
+    * @param  timeout The time remaining until the group commit window elapses
+    * @return Whether uploads are awaiting the group commit
+    */
+   bool getTimeout(timeval& timeout) const;
+
+   /**
+    * @brief  Returns whether the pending uploads' group commit window has elapsed
+    * @return Whether the pending uploads' group commit window has elapsed
+    */
+   bool isDue() const;
+
+   /**
+    * @brief Synchronizes the files of the pending uploads and, depending on the durability mode,
+    *        the directories they were linked into, each directory being synchronized only once
+    * @param committed The uploads that were committed, along with whether they are durable
+    */
+   void commit(std::vector<committedUpload>& committed);
+ };
+
+
+#endif //SAFECLOUD_GROUPCOMMIT_H
\ No newline at end of file
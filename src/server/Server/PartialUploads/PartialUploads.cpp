@@ -0,0 +1,175 @@
+/* SafeCloud Server Partial Uploads Definitions */
+
+/* ================================== INCLUDES ================================== */
+
+// System Headers
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <ctime>
+#include <openssl/evp.h>
+
+// SafeCloud Headers
+#include "PartialUploads.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/SessMgr.h"
+#include "errCodes/execErrCodes/execErrCodes.h"
+
+/* ================================ CONSTRUCTOR ================================ */
+
+/**
+ * @brief  PartialUploads object constructor
+ * @param  retention The retention time of the partial uploads in seconds (0 = resumption disabled)
+ * @throws ERR_SRV_RETENTION_INVALID Negative retention time
+ */
+PartialUploads::PartialUploads(int retention) : _retention(retention)
+ {
+  // Ensure the retention time to be valid
+  if(retention < 0)
+   THROW_EXEC_EXCP(ERR_SRV_RETENTION_INVALID, "retention = " + std::to_string(retention));
+ }
+
+
+/* ============================ OTHER PUBLIC METHODS ============================ */
+
+/**
+ * @brief  Returns whether interrupted uploads are retained for their resumption
+ * @return Whether interrupted uploads are retained for their resumption
+ */
+bool PartialUploads::enabled() const
+ { return _retention > 0; }
+
+
+/**
+ * @brief  Returns the absolute path of the partial upload of a file in a user's partial uploads directory,
+ *         whose name is the hexadecimal SHA-256 digest of the file's name, size and last modification time
+ *         and of whether its contents are authenticated only (so that names are of fixed length)
+ * @param  resumeDir The absolute path of the user's partial uploads directory
+ * @param  fileInfo  The information on the file being uploaded
+ * @param  authOnly  Whether the file's contents are authenticated only
+ * @return The absolute path of the partial upload of the file
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL EVP_MD digest failed
+ */
+std::string PartialUploads::getPath(const std::string& resumeDir, const FileInfo& fileInfo, bool authOnly) const
+ {
+  // The partial upload's key, whose fields are separated by
+  // NUL characters, which cannot appear in a file name
+  std::string key = fileInfo.fileName + '\0' + std::to_string(fileInfo.meta->fileSizeRaw) + '\0'
+                    + std::to_string(fileInfo.meta->lastModTimeRaw) + '\0' + (authOnly ? "1" : "0");
+
+  // The key's digest and its hexadecimal representation
+  unsigned char keyDigest[EVP_MAX_MD_SIZE];
+  unsigned int  keyDigestSize;
+  char          keyDigestHex[2 * EVP_MAX_MD_SIZE + 1];
+
+  if(EVP_Digest(key.data(), key.size(), keyDigest, &keyDigestSize, EVP_sha256(), NULL) != 1)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_DIGEST_FINAL, OSSL_ERR_DESC);
+
+  for(unsigned int i = 0; i < keyDigestSize; i++)
+   sprintf(&keyDigestHex[2 * i], "%02x", keyDigest[i]);
+
+  return resumeDir + std::string(keyDigestHex, 2 * keyDigestSize);
+ }
+
+
+/**
+ * @brief Prepares a user's partial uploads directory for a new upload, creating it if it does not exist
+ *        or otherwise deleting the partial uploads it contains that have expired, with failures, which
+ *        only prevent uploads from being resumed, being logged
+ * @param resumeDir The absolute path of the user's partial uploads directory
+ */
+void PartialUploads::prepDir(const std::string& resumeDir) const
+ {
+  DIR*           dir;          // The user's partial uploads directory
+  dirent*        dirEntry;     // An entry of the partial uploads directory
+  struct stat    partialInfo;  // Information on a partial upload
+  std::string    partialPath;  // The absolute path of a partial upload
+  time_t         now;          // The current time
+
+  // Open the partial uploads directory, creating it if it does not exist
+  dir = opendir(resumeDir.c_str());
+  if(dir == nullptr)
+   {
+    if(errno != ENOENT)
+     LOG_EXEC_CODE(ERR_DIR_OPEN_FAILED, resumeDir, ERRNO_DESC);
+    else
+     if(mkdir(resumeDir.c_str(), 0700) != 0)
+      LOG_EXEC_CODE(ERR_DIR_CREATE_FAILED, resumeDir, ERRNO_DESC);
+    return;
+   }
+
+  // Delete the partial uploads whose contents were last written more than the
+  // retention time ago, including the ones whose upload was claimed but never
+  // completed nor released as the server was terminated abruptly
+  now = time(nullptr);
+  while((dirEntry = readdir(dir)) != nullptr)
+   {
+    if(dirEntry->d_name[0] == '.')
+     continue;
+    partialPath = resumeDir + dirEntry->d_name;
+    if(stat(partialPath.c_str(), &partialInfo) == 0 && S_ISREG(partialInfo.st_mode) &&
+       now - partialInfo.st_mtime >= _retention && remove(partialPath.c_str()) != 0)
+     LOG_EXEC_CODE(ERR_FILE_DELETE_FAILED, partialPath, ERRNO_DESC);
+   }
+
+  if(closedir(dir) != 0)
+   LOG_EXEC_CODE(ERR_DIR_CLOSE_FAILED, resumeDir, ERRNO_DESC);
+ }
+
+
+/**
+ * @brief  Claims the partial upload of a file for its resumption by moving it to a path private to the
+ *         upload, so that it is not resumed by other uploads in the meantime, and opening it in write
+ *         mode positioned at its end, where partial uploads not being a whole number of chunks smaller
+ *         than the file (i.e. not produced by the server) are deleted rather than resumed
+ * @param  partialPath The absolute path of the partial upload of the file
+ * @param  claimPath   The absolute path the partial upload is moved to
+ * @param  fileSize    The size of the file being uploaded
+ * @param  offset      The size of the claimed partial upload, from which the upload is resumed
+ * @return The descriptor of the claimed partial upload, or 'nullptr' if the file has no partial upload
+ */
+FILE* PartialUploads::claim(const std::string& partialPath, const std::string& claimPath, long int fileSize, long int& offset) const
+ {
+  struct stat partialInfo;  // Information on the partial upload
+  int         partialFd;    // The file descriptor of the claimed partial upload
+  FILE*       partialDscr;  // The descriptor of the claimed partial upload
+
+  offset = 0;
+
+  // If the file has no partial upload, it must be uploaded from its start
+  if(stat(partialPath.c_str(), &partialInfo) != 0 || !S_ISREG(partialInfo.st_mode))
+   return nullptr;
+
+  // Delete partial uploads that cannot have been produced by the server for the file
+  if(partialInfo.st_size == 0 || partialInfo.st_size >= fileSize || partialInfo.st_size % FILE_CHUNK_SIZE != 0)
+   {
+    if(remove(partialPath.c_str()) != 0)
+     LOG_EXEC_CODE(ERR_FILE_DELETE_FAILED, partialPath, ERRNO_DESC);
+    return nullptr;
+   }
+
+  // Move the partial upload to the upload's private path
+  if(rename(partialPath.c_str(), claimPath.c_str()) != 0)
+   {
+    LOG_EXEC_CODE(ERR_FILE_RENAME_FAILED, partialPath, ERRNO_DESC);
+    return nullptr;
+   }
+
+  // Open the claimed partial upload in write mode (without truncating it) positioned at its end,
+  // where the position is set before the descriptor is associated with a stream so that the
+  // stream's buffering mode can still be changed (see 'SrvSessMgr::initStreamingIO()')
+  partialFd = open(claimPath.c_str(), O_WRONLY);
+  if(partialFd == -1 || lseek(partialFd, partialInfo.st_size, SEEK_SET) == -1 ||
+     (partialDscr = fdopen(partialFd, "wb")) == nullptr)
+   {
+    LOG_EXEC_CODE(ERR_FILE_OPEN_FAILED, claimPath, ERRNO_DESC);
+    if(partialFd != -1)
+     close(partialFd);
+    if(remove(claimPath.c_str()) != 0)
+     LOG_EXEC_CODE(ERR_FILE_DELETE_FAILED, claimPath, ERRNO_DESC);
+    return nullptr;
+   }
+
+  offset = partialInfo.st_size;
+  return partialDscr;
+ }
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef SAFECLOUD_PARTIALUPLOADS_H
+#define SAFECLOUD_PARTIALUPLOADS_H
+
+/*
+ * This class represents the interrupted uploads retained by the SafeCloud server for
+ * their resumption, or "partial uploads", where:
+ *
+ *   - When an upload is interrupted (e.g. the connection drops), the contents of its file received
+ *     and verified so far, truncated to a whole number of chunks, are preserved as a partial upload
+ *     in the user's "resume" directory rather than deleted along with the temporary file
+ *
+ *   - A partial upload is keyed by the name, size and last modification time of its file and by
+ *     whether its contents are authenticated only, so that it is resumed only by a following
+ *     upload request of the same version of the same file (see 'getPath()')
+ *
+ *   - Upon resuming a partial upload the server informs the client of the offset its contents
+ *     extend to, and the client sends the file's remaining chunks only, whose sequence numbers
+ *     continue from such offset so that, being bound to their position in the file by their
+ *     authentication, they cannot be spliced with the partial upload's contents at other offsets
+ *
+ *   - Partial uploads that are not resumed within the server's retention time are deleted
+ */
+
+/* ================================== INCLUDES ================================== */
+#include <cstdio>
+#include <string>
+#include "DirInfo/FileInfo/FileInfo.h"
+
+
+class PartialUploads
+ {
+  private:
+
+   /* ================================= ATTRIBUTES ================================= */
+   long _retention;  // The retention time of the partial uploads in seconds (0 = resumption disabled)
+
+  public:
+
+   /* ================================ CONSTRUCTOR ================================ */
+
+   /**
+    * @brief  PartialUploads object constructor
+    * @param  retention The retention time of the partial uploads in seconds (0 = resumption disabled)
+    * @throws ERR_SRV_RETENTION_INVALID Negative retention time
+    */
+   explicit PartialUploads(int retention);
+
+   /* ============================ OTHER PUBLIC METHODS ============================ */
+
+   /**
+    * @brief  Returns whether interrupted uploads are retained for their resumption
+    * @return Whether interrupted uploads are retained for their resumption
+    */
+   bool enabled() const;
+
+   /**
+    * @brief  Returns the absolute path of the partial upload of a file in a user's partial uploads directory,
+    *         whose name is the hexadecimal SHA-256 digest of the file's name, size and last modification time
+    *         and of whether its contents are authenticated only (so that names are of fixed length)
+    * @param  resumeDir The absolute path of the user's partial uploads directory
+    * @param  fileInfo  The information on the file being uploaded
+    * @param  authOnly  Whether the file's contents are authenticated only
+    * @return The absolute path of the partial upload of the file
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL EVP_MD digest failed
+    */
+   std::string getPath(const std::string& resumeDir, const FileInfo& fileInfo, bool authOnly) const;
+
+   /**
+    * @brief Prepares a user's partial uploads directory for a new upload, creating it if it does not exist
+    *        or otherwise deleting the partial uploads it contains that have expired, with failures, which
+    *        only prevent uploads from being resumed, being logged
+    * @param resumeDir The absolute path of the user's partial uploads directory
+    */
+   void prepDir(const std::string& resumeDir) const;
+
+   /**
+    * @brief  Claims the partial upload of a file for its resumption by moving it to a path private to the
+    *         upload, so that it is not resumed by other uploads in the meantime, and opening it in write
+    *         mode positioned at its end, where partial uploads not being a whole number of chunks smaller
+    *         than the file (i.e. not produced by the server) are deleted rather than resumed
+    * @param  partialPath The absolute path of the partial upload of the file
+    * @param  claimPath   The absolute path the partial upload is moved to
+    * @param  fileSize    The size of the file being uploaded
+    * @param  offset      The size of the claimed partial upload, from which the upload is resumed
+    * @return The descriptor of the claimed partial upload, or 'nullptr' if the file has no partial upload
+    */
+   FILE* claim(const std::string& partialPath, const std::string& claimPath, long int fileSize, long int& offset) const;
+ };
+
+
+#endif //SAFECLOUD_PARTIALUPLOADS_H
\ No newline at end of file
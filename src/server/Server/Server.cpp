@@ -5,6 +5,7 @@
 /* ================================== INCLUDES ================================== */
 #include "errCodes/execErrCodes/execErrCodes.h"
 #include "errCodes/sessErrCodes/sessErrCodes.h"
+#include "ossl_crypto/DigSig.h"
 #include <unistd.h>
 #include <arpa/inet.h>
 #include <cstring>
@@ -42,7 +43,7 @@ void Server::setSrvEndpoint(uint16_t& srvPort)
  * @throws ERR_SRV_PRIVKFILE_OPEN_FAILED Error in opening the server's RSA private key file
  * @throws ERR_FILE_CLOSE_FAILED         Error in closing the server's RSA private key file
  * @throws ERR_SRV_PRIVK_INVALID         The contents of the server's private key file
- *                                       could not be interpreted as a valid RSA key pair
+ *                                       could not be interpreted as a valid RSA-2048 or Ed25519 key pair
  */
 void Server::getServerRSAKey()
  {
@@ -75,6 +76,11 @@ void Server::getServerRSAKey()
     if(!_rsaKey)
      THROW_EXEC_EXCP(ERR_SRV_PRIVK_INVALID, RSAKeyFilePath, OSSL_ERR_DESC);
 
+    // Ensure the private key to be of a type supported
+    // in the STSM handshake (RSA-2048 or Ed25519)
+    if(!digSigKeySupported(_rsaKey))
+     THROW_EXEC_EXCP(ERR_SRV_PRIVK_INVALID, RSAKeyFilePath, "Unsupported key type");
+
     // At this point the server's long-term RSA private key is valid
     LOG_DEBUG("SafeCloud server long-term RSA private key successfully loaded")
 
@@ -96,7 +102,7 @@ void Server::getServerRSAKey()
  * @brief  Loads the server X.509 certificate from its default ".pem" file
  * @throws ERR_SRV_CERT_OPEN_FAILED The server certificate file could not be opened
  * @throws ERR_FILE_CLOSE_FAILED    The server certificate file could not be closed
- * @throws ERR_SRV_CERT_INVALID     The server certificate is invalid
+ * @throws ERR_SRV_CERT_INVALID     The server certificate is invalid or does not match its private key
  */
 void Server::getServerCert()
  {
@@ -120,6 +126,14 @@ void Server::getServerCert()
   if(!srvCert)
    THROW_EXEC_EXCP(ERR_SRV_CERT_INVALID, SRV_CERT_PATH, OSSL_ERR_DESC);
 
+  // Ensure the server certificate to match the server's long-term
+  // private key, whose type determines its STSM digital signatures
+  if(X509_check_private_key(srvCert, _rsaKey) != 1)
+   {
+    X509_free(srvCert);
+    THROW_EXEC_EXCP(ERR_SRV_CERT_INVALID, SRV_CERT_PATH, "The certificate does not match the server's private key");
+   }
+
   // At this point the server certificate has been loaded successfully
   // and, in DEBUG_MODE, print its subject and issuer
 #ifdef DEBUG_MODE
@@ -186,6 +200,9 @@ void Server::closeConn(connMapIt cliIt)
   // set of file descriptors of open sockets
   FD_CLR(cliIt->first, &_skSet);
 
+  // Discard the client's uploads awaiting the group commit, if any
+  _groupCommit.cancelUploads(cliIt->first);
+
   // Delete the client's connection manager
   delete(cliIt->second);
 
@@ -218,7 +235,7 @@ void Server::newClientData(int ski)
   SrvConnMgr* srvConnMgr;
 
   // Whether the client connection should be terminated
-  bool shutdownCliConn;
+  bool shutdownCliConn = false;
 
   // Retrieve the connection's map entry associated with "ski"
   connIt = _connMap.find(ski);
@@ -266,8 +283,8 @@ void Server::newClientData(int ski)
     // Handle the session exception that was raised
     handleSessErrException(sessExcp);
 
-    // Reset the server session manager's state
-    srvConnMgr->getSession()->resetSessState();
+    // Reset the state of the stream the session exception was raised on
+    srvConnMgr->getSession()->resetStreamState();
    }
 
   // If the client's connection should be terminated due to it gracefully
@@ -297,6 +314,119 @@ void Server::newClientData(int ski)
  }
 
 
+/**
+ * @brief Sends the next file segment or upload outcome pending to be sent to a client whose
+ *        connection socket is writable via its associated SrvConnMgr object's session manager,
+ *        closing the client's connection should an execution exception occur
+ * @param ski The writable connection socket
+ */
+void Server::newClientSendReady(int ski)
+ {
+  // _connMap iterator
+  connMapIt connIt;
+
+  // The client's assigned connection manager
+  SrvConnMgr* srvConnMgr;
+
+  // Whether the client connection should be terminated
+  bool shutdownCliConn = false;
+
+  // Retrieve the connection's map entry associated with "ski", which
+  // may have been closed while handling its incoming data
+  connIt = _connMap.find(ski);
+  if(connIt == _connMap.end())
+   return;
+
+  // Retrieve the pointer to the client's connection manager
+  srvConnMgr = connIt->second;
+
+  // Ensure the client session to still have file segments pending
+  // to be sent after its incoming data has been handled
+  if(!(srvConnMgr->isInSessionPhase() && srvConnMgr->getSession()->hasPendingSend()))
+   return;
+
+  try
+   {
+    // Send the next file segment pending to be sent via
+    // the send handler of the client's session manager
+    srvConnMgr->getSession()->srvSessSendHandler();
+   }
+  catch(execErrExcp& excp)
+   {
+    // Change a ERR_PEER_DISCONNECTED into the
+    // more specific ERR_CLI_DISCONNECTED error code
+    if(excp.exErrcode == ERR_PEER_DISCONNECTED)
+     excp.exErrcode = ERR_CLI_DISCONNECTED;
+
+    // Handle the execution exception that was raised
+    handleExecErrException(excp);
+
+    // The client connection must always be terminated
+    shutdownCliConn = true;
+   }
+  catch(sessErrExcp& sessExcp)
+   {
+    // Handle the session exception that was raised
+    handleSessErrException(sessExcp);
+
+    // Reset the state of the stream the session exception was raised on
+    srvConnMgr->getSession()->resetStreamState();
+   }
+
+  // If an execution exception has occurred, terminate the client's connection
+  if(shutdownCliConn)
+   closeConn(connIt);
+  else
+
+   // Otherwise, if the SafeCloud server is shutting down and the client session
+   // is now idle (i.e. the outcome of its last upload was notified to the client),
+   // close the session and connection as in the newClientData() method
+   if(_shutdown && srvConnMgr->getSession()->isIdle())
+    {
+      // Close the session with the client by
+      // sending the 'BYE' session signaling message
+      srvConnMgr->getSession()->closeSession();
+
+      LOG_DEBUG("Sent 'BYE' session message to user \""
+                + *srvConnMgr->getName() + "\"")
+
+      // Close the client connection
+      closeConn(connIt);
+    }
+ }
+
+
+/**
+ * @brief Commits the uploads whose group commit window has elapsed, setting the session
+ *        managers of their clients to notify them of the outcome of their uploads
+ */
+void Server::commitUploads()
+ {
+  // The uploads that were committed, along with whether they are durable
+  std::vector<GroupCommit::committedUpload> committed;
+
+  // _connMap iterator
+  connMapIt connIt;
+
+  // Synchronize the pending uploads' files and directories
+  _groupCommit.commit(committed);
+
+  // For each committed upload
+  for(auto& upload : committed)
+   {
+    // Retrieve the connection's map entry associated with the upload
+    // (where the uploads of closed connections are discarded by closeConn())
+    connIt = _connMap.find(upload.csk);
+    if(connIt == _connMap.end())
+     continue;
+
+    // Set the client's session manager to notify the client of the outcome of its upload
+    // as its connection socket becomes writable (see the newClientSendReady() method)
+    connIt->second->getSession()->uploadCommitCallback(upload.streamId, upload.durable);
+   }
+ }
+
+
 /**
  * @brief Accepts an incoming client connection, creating its
  *        client object and entry in the connections' map
@@ -364,7 +494,7 @@ void Server::newClientConnection()
 
   // Attempt to initialize the client's connection manager
   try
-   { srvConnMgr = new SrvConnMgr(csk,_guestIdx,_rsaKey,_srvCert); }
+   { srvConnMgr = new SrvConnMgr(csk,_guestIdx,_rsaKey,_srvCert,_ticketKeys,_groupCommit,_partialUploads,_contentStore,_aesGCMPool); }
 
   // If an execution exception occurred in instantiating the server
   // connection manager, the client cannot connect to the SafeCloud server
@@ -443,12 +573,23 @@ void Server::srvLoop()
   // for asynchronously reading incoming client data
   fd_set skReadSet;
 
+  // Set of file descriptors of connection sockets used for asynchronously
+  // sending the file segments pending to be sent to their clients
+  fd_set skWriteSet;
+
   // select() return
   int selRet;
 
+  // The select() timeout, set to the time remaining until the window of the uploads
+  // awaiting the group commit elapses or the next content store garbage collection step
+  timeval commitTimeout;
+  timeval gcTimeout;
+  timeval* selTimeout;
+
   // Initialize the set of file descriptor of open sockets
   // used for asynchronously reading incoming client data
   FD_ZERO(&skReadSet);
+  FD_ZERO(&skWriteSet);
 
   // -------------------------- SafeCloud Server Main Loop -------------------------- //
 
@@ -483,8 +624,21 @@ void Server::srvLoop()
     // Reset the list of sockets to wait input data from to all open sockets
     skReadSet = _skSet;
 
-    // Wait indefinitely for input data to be available on any open socket
-    selRet = select(_skMax + 1, &skReadSet, NULL, NULL, NULL);
+    // Set the list of sockets to wait to be writable to the connection
+    // sockets of the clients having file segments pending to be sent
+    FD_ZERO(&skWriteSet);
+    for(auto& conn : _connMap)
+     if(conn.second->isInSessionPhase() && conn.second->getSession()->hasPendingSend())
+      FD_SET(conn.first, &skWriteSet);
+
+    // Wait for input data to be available on any open socket or for any socket with pending file
+    // segments to be writable, indefinitely or, if uploads are awaiting the group commit, until
+    // their group commit window elapses, or, if the content store is enabled, until its next
+    // garbage collection step is due, whichever comes first
+    selTimeout = _groupCommit.getTimeout(commitTimeout) ? &commitTimeout : NULL;
+    if(_contentStore.getTimeout(gcTimeout) && (selTimeout == NULL || timercmp(&gcTimeout, selTimeout, <)))
+     selTimeout = &gcTimeout;
+    selRet = select(_skMax + 1, &skReadSet, &skWriteSet, NULL, selTimeout);
 
     // Depending on the select() return
     switch(selRet)
@@ -500,10 +654,11 @@ void Server::srvLoop()
       // ----------------------------- select() timeout ----------------------------- //
       case 0:
 
-       // As it is not implemented, a select() timeout is a fatal error
-       THROW_EXEC_EXCP(ERR_SRV_SELECT_FAILED, "select() timeout", ERRNO_DESC);
+       // The group commit window of the pending uploads has elapsed or the next content
+       // store garbage collection step is due, which are performed below
+       break;
 
-      // ----------- selRet = Number of sockets with available input data ----------- //
+      // ------- selRet = Number of sockets with available input data or writable ------- //
       default:
 
        /*
@@ -512,28 +667,45 @@ void Server::srvLoop()
        */
 
        // Browse all sockets file descriptors from 0 to _skMax
-       for(int ski = 0; ski <= _skMax; ski++)
-
-        // If input data is available on socket "ski"
-        if(FD_ISSET(ski, &skReadSet))
-         {
-          // If "ski" is the server's listening socket, a new
-          // client is attempting to connect with the SafeCloud server
-          if(ski == _lsk)
-           newClientConnection();
-
-          // Otherwise "ski" is a connection socket of an existing
-          // client which has sent new data to the server
-          else
-           newClientData(ski);
-
-          // Once the listening or connection socket has been served, decrement
-          // the number of sockets with pending input data and, if no other is
-          // present, break the "for" loop for restarting the main server loop
-          if(--selRet == 0)
-           break;
-         }
+       for(int ski = 0; ski <= _skMax && selRet > 0; ski++)
+        {
+         // If input data is available on socket "ski"
+         if(FD_ISSET(ski, &skReadSet))
+          {
+           // If "ski" is the server's listening socket, a new
+           // client is attempting to connect with the SafeCloud server
+           if(ski == _lsk)
+            newClientConnection();
+
+           // Otherwise "ski" is a connection socket of an existing
+           // client which has sent new data to the server
+           else
+            newClientData(ski);
+
+           // Once the listening or connection socket has been served,
+           // decrement the number of sockets with pending events
+           selRet--;
+          }
+
+         // If socket "ski" is writable, send its client the next pending file segment
+         if(FD_ISSET(ski, &skWriteSet))
+          {
+           newClientSendReady(ski);
+           selRet--;
+          }
+
+         // Once no other socket has pending events the "for" loop
+         // is exited for restarting the main server loop
+        }
      } // switch(selRet)
+
+    // If their group commit window has elapsed, commit the pending uploads
+    if(_groupCommit.isDue())
+     commitUploads();
+
+    // If it is due, perform the next content store garbage collection step
+    if(_contentStore.isDue())
+     _contentStore.collect();
    } // while(1)
 
   // ------------------------ End SafeCloud Server Main Loop ------------------------ //
@@ -544,24 +716,38 @@ void Server::srvLoop()
 
 /**
  * @brief  SafeCloud server object constructor
- * @param  srvPort The OS port the server should bind on
- * @throws ERR_SRV_PORT_INVALID          Invalid server port
- * @throws ERR_SRV_PRIVKFILE_NOT_FOUND   The server RSA private key file was not found
- * @throws ERR_SRV_PRIVKFILE_OPEN_FAILED Error in opening the server's RSA private key file
- * @throws ERR_FILE_CLOSE_FAILED         Error in closing the server's RSA
- *                                       private key OR certificate file
- * @throws ERR_SRV_PRIVK_INVALID         The contents of the server's private key file
- *                                       could not be interpreted as a valid RSA key pair
- * @throws ERR_SRV_CERT_OPEN_FAILED      The server certificate file could not be opened
- * @throws ERR_SRV_CERT_INVALID          The server certificate is invalid
- * @throws ERR_LSK_INIT_FAILED           Listening socket initialization failed
- * @throws ERR_LSK_SO_REUSEADDR_FAILED   Error in setting the listening
- *                                       socket's SO_REUSEADDR option
- * @throws ERR_LSK_BIND_FAILED           Error in binding the listening
- *                                       socket on the specified host port
+ * @param  srvPort           The OS port the server should bind on
+ * @param  ticketLifetime    The resumption tickets' lifetime in seconds (0 = resumption disabled)
+ * @param  ticketKeyRotation The resumption ticket keys' rotation interval in seconds
+ * @param  durability        The uploads durability mode (see 'durabilityMode')
+ * @param  commitWindow      The uploads group commit window in milliseconds
+ * @param  uploadRetention   The retention time of interrupted uploads in seconds (0 = resumption disabled)
+ * @param  storeGCInterval   The content store garbage collection interval in seconds (0 = store disabled)
+ * @throws ERR_SRV_PORT_INVALID              Invalid server port
+ * @throws ERR_SRV_TICKET_PARAMS_INVALID     Invalid resumption tickets' lifetime or key rotation interval
+ * @throws ERR_SRV_DURABILITY_PARAMS_INVALID Invalid uploads durability mode or group commit window
+ * @throws ERR_SRV_RETENTION_INVALID         Invalid partial uploads retention time
+ * @throws ERR_SRV_STORE_GC_INVALID          Invalid content store garbage collection interval
+ * @throws ERR_DIR_CREATE_FAILED             The content store directory could not be created
+ * @throws ERR_SRV_PRIVKFILE_NOT_FOUND       The server RSA private key file was not found
+ * @throws ERR_SRV_PRIVKFILE_OPEN_FAILED     Error in opening the server's RSA private key file
+ * @throws ERR_FILE_CLOSE_FAILED             Error in closing the server's RSA
+ *                                           private key OR certificate file
+ * @throws ERR_SRV_PRIVK_INVALID             The contents of the server's private key file
+ *                                           could not be interpreted as a valid RSA-2048 or Ed25519 key pair
+ * @throws ERR_SRV_CERT_OPEN_FAILED          The server certificate file could not be opened
+ * @throws ERR_SRV_CERT_INVALID              The server certificate is invalid or does not match its private key
+ * @throws ERR_LSK_INIT_FAILED               Listening socket initialization failed
+ * @throws ERR_LSK_SO_REUSEADDR_FAILED       Error in setting the listening
+ *                                           socket's SO_REUSEADDR option
+ * @throws ERR_LSK_BIND_FAILED               Error in binding the listening
+ *                                           socket on the specified host port
  */
-Server::Server(uint16_t srvPort)
- : SafeCloudApp(), _lsk(-1), _srvCert(nullptr), _connMap(), _skSet(), _skMax(-1), _guestIdx(1)
+Server::Server(uint16_t srvPort, int ticketLifetime, int ticketKeyRotation, int durability, int commitWindow,
+               int uploadRetention, int storeGCInterval)
+ : SafeCloudApp(), _lsk(-1), _srvCert(nullptr), _ticketKeys(ticketLifetime, ticketKeyRotation),
+   _groupCommit(durability, commitWindow), _partialUploads(uploadRetention), _contentStore(storeGCInterval),
+   _aesGCMPool(), _connMap(), _skSet(), _skMax(-1), _guestIdx(1)
  {
   // Set the server endpoint parameters
   setSrvEndpoint(srvPort);
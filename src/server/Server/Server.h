@@ -6,6 +6,10 @@
 /* ================================== INCLUDES ================================== */
 #include "SafeCloudApp/SafeCloudApp.h"
 #include "SrvConnMgr/SrvConnMgr.h"
+#include "TicketKeys/TicketKeys.h"
+#include "GroupCommit/GroupCommit.h"
+#include "PartialUploads/PartialUploads.h"
+#include "ContentStore/ContentStore.h"
 
 
 class Server : public SafeCloudApp
@@ -18,6 +22,21 @@ class Server : public SafeCloudApp
    int   _lsk;       // The server listening socket's file descriptor
    X509* _srvCert;   // The server's X.509 certificate
 
+   // The keys used for sealing and opening the clients' resumption tickets
+   TicketKeys _ticketKeys;
+
+   // The group commit making the uploaded files durable
+   GroupCommit _groupCommit;
+
+   // The interrupted uploads retained for their resumption
+   PartialUploads _partialUploads;
+
+   // The content store deduplicating the users' files
+   ContentStore _contentStore;
+
+   // The AES_128_GCM workers pool encrypting and decrypting the file segments of all connections
+   AESGCMPool _aesGCMPool;
+
    /* ----------------------- Client Connections Management ----------------------- */
 
    // A map associating the file descriptors of open connection
@@ -61,7 +80,7 @@ class Server : public SafeCloudApp
     * @throws ERR_SRV_PRIVKFILE_OPEN_FAILED Error in opening the server's RSA private key file
     * @throws ERR_FILE_CLOSE_FAILED         Error in closing the server's RSA private key file
     * @throws ERR_SRV_PRIVK_INVALID         The contents of the server's private key file
-    *                                       could not be interpreted as a valid RSA key pair
+    *                                       could not be interpreted as a valid RSA-2048 or Ed25519 key pair
     */
    void getServerRSAKey();
 
@@ -100,6 +119,20 @@ class Server : public SafeCloudApp
    */
   void newClientData(int ski);
 
+  /**
+   * @brief Sends the next file segment or upload outcome pending to be sent to a client whose
+   *        connection socket is writable via its associated SrvConnMgr object's session manager,
+   *        closing the client's connection should an execution exception occur
+   * @param ski The writable connection socket
+   */
+  void newClientSendReady(int ski);
+
+  /**
+   * @brief Commits the uploads whose group commit window has elapsed, setting the session
+   *        managers of their clients to notify them of the outcome of their uploads
+   */
+  void commitUploads();
+
   /**
    * @brief Accepts an incoming client connection, creating its
    *        client object and entry in the connections' map
@@ -120,23 +153,35 @@ class Server : public SafeCloudApp
 
    /**
     * @brief  SafeCloud server object constructor
-    * @param  srvPort The OS port the server should bind on
-    * @throws ERR_SRV_PORT_INVALID          Invalid server port
-    * @throws ERR_SRV_PRIVKFILE_NOT_FOUND   The server RSA private key file was not found
-    * @throws ERR_SRV_PRIVKFILE_OPEN_FAILED Error in opening the server's RSA private key file
-    * @throws ERR_FILE_CLOSE_FAILED         Error in closing the server's RSA
-    *                                       private key OR certificate file
-    * @throws ERR_SRV_PRIVK_INVALID         The contents of the server's private key file
-    *                                       could not be interpreted as a valid RSA key pair
-    * @throws ERR_SRV_CERT_OPEN_FAILED      The server certificate file could not be opened
-    * @throws ERR_SRV_CERT_INVALID          The server certificate is invalid
-    * @throws ERR_LSK_INIT_FAILED           Listening socket initialization failed
-    * @throws ERR_LSK_SO_REUSEADDR_FAILED   Error in setting the listening
-    *                                       socket's SO_REUSEADDR option
-    * @throws ERR_LSK_BIND_FAILED           Error in binding the listening
-    *                                       socket on the specified host port
+    * @param  srvPort           The OS port the server should bind on
+    * @param  ticketLifetime    The resumption tickets' lifetime in seconds (0 = resumption disabled)
+    * @param  ticketKeyRotation The resumption ticket keys' rotation interval in seconds
+    * @param  durability        The uploads durability mode (see 'durabilityMode')
+    * @param  commitWindow      The uploads group commit window in milliseconds
+    * @param  uploadRetention   The retention time of interrupted uploads in seconds (0 = resumption disabled)
+    * @param  storeGCInterval   The content store garbage collection interval in seconds (0 = store disabled)
+    * @throws ERR_SRV_PORT_INVALID              Invalid server port
+    * @throws ERR_SRV_TICKET_PARAMS_INVALID     Invalid resumption tickets' lifetime or key rotation interval
+    * @throws ERR_SRV_DURABILITY_PARAMS_INVALID Invalid uploads durability mode or group commit window
+    * @throws ERR_SRV_RETENTION_INVALID         Invalid partial uploads retention time
+    * @throws ERR_SRV_STORE_GC_INVALID          Invalid content store garbage collection interval
+    * @throws ERR_DIR_CREATE_FAILED             The content store directory could not be created
+    * @throws ERR_SRV_PRIVKFILE_NOT_FOUND       The server RSA private key file was not found
+    * @throws ERR_SRV_PRIVKFILE_OPEN_FAILED     Error in opening the server's RSA private key file
+    * @throws ERR_FILE_CLOSE_FAILED             Error in closing the server's RSA
+    *                                           private key OR certificate file
+    * @throws ERR_SRV_PRIVK_INVALID             The contents of the server's private key file
+    *                                           could not be interpreted as a valid RSA-2048 or Ed25519 key pair
+    * @throws ERR_SRV_CERT_OPEN_FAILED          The server certificate file could not be opened
+    * @throws ERR_SRV_CERT_INVALID              The server certificate is invalid or does not match its private key
+    * @throws ERR_LSK_INIT_FAILED               Listening socket initialization failed
+    * @throws ERR_LSK_SO_REUSEADDR_FAILED       Error in setting the listening
+    *                                           socket's SO_REUSEADDR option
+    * @throws ERR_LSK_BIND_FAILED               Error in binding the listening
+    *                                           socket on the specified host port
     */
-   explicit Server(uint16_t srvPort);
+   Server(uint16_t srvPort, int ticketLifetime, int ticketKeyRotation, int durability, int commitWindow,
+          int uploadRetention, int storeGCInterval);
 
    /**
     * @brief SafeCloud server object destructor, closing open client
@@ -41,16 +41,25 @@ bool SrvConnMgr::srvRecvMsgData()
 /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
 /**
- * @brief          SrvConnMgr object constructor
- * @param csk      The connection socket associated with this manager
- * @param guestIdx The connected client's temporary identifier
- * @param rsaKey   The server's long-term RSA key pair
- * @param srvCert  The server's X.509 certificate
+ * @brief                SrvConnMgr object constructor
+ * @param csk            The connection socket associated with this manager
+ * @param guestIdx       The connected client's temporary identifier
+ * @param rsaKey         The server's long-term RSA key pair
+ * @param srvCert        The server's X.509 certificate
+ * @param ticketKeys     The server's resumption ticket keys
+ * @param groupCommit    The server's uploads group commit
+ * @param partialUploads The server's interrupted uploads retained for their resumption
+ * @param contentStore   The server's content store deduplicating the users' files
+ * @param aesGCMPool     The server's AES_128_GCM workers pool
  * @note The constructor also initializes the _srvSTSMMgr child object
  */
-SrvConnMgr::SrvConnMgr(int csk, unsigned int guestIdx, EVP_PKEY* rsaKey, X509* srvCert)
+SrvConnMgr::SrvConnMgr(int csk, unsigned int guestIdx, EVP_PKEY* rsaKey, X509* srvCert, TicketKeys& ticketKeys,
+                       GroupCommit& groupCommit, PartialUploads& partialUploads, ContentStore& contentStore,
+                       AESGCMPool& aesGCMPool)
   : ConnMgr(csk,new std::string("Guest" + std::to_string(guestIdx)),nullptr),
-    _poolDir(nullptr), _srvSTSMMgr(new SrvSTSMMgr(rsaKey,*this,srvCert)), _srvSessMgr(nullptr)
+    _poolDir(nullptr), _srvSTSMMgr(new SrvSTSMMgr(rsaKey,*this,srvCert,ticketKeys)), _srvSessMgr(nullptr),
+    _groupCommit(groupCommit), _partialUploads(partialUploads), _resumeDir(nullptr),
+    _contentStore(contentStore), _aesGCMPool(aesGCMPool)
  {
   // Log the client's connection
   LOG_INFO("\"" + *_name + "\" has connected")
@@ -63,6 +72,10 @@ SrvConnMgr::SrvConnMgr(int csk, unsigned int guestIdx, EVP_PKEY* rsaKey, X509* s
  */
 SrvConnMgr::~SrvConnMgr()
  {
+  // If the connection's file transfers were compressed, log the session's compression savings
+  if(_compress && _srvSessMgr != nullptr)
+   LOG_INFO("[" + *_name + "] Session file transfers " + _srvSessMgr->compressionStatsStr())
+
   // Delete the connection manager's child objects
   delete _srvSTSMMgr;
   delete _srvSessMgr;
@@ -74,9 +87,11 @@ SrvConnMgr::~SrvConnMgr()
   delete _name;
   delete _tmpDir;
   delete _poolDir;
+  delete _resumeDir;
   _name = nullptr;
   _tmpDir = nullptr;
   _poolDir = nullptr;
+  _resumeDir = nullptr;
  }
 
 /* ============================ OTHER PUBLIC METHODS ============================ */
@@ -108,6 +123,7 @@ SrvSessMgr* SrvConnMgr::getSession()
  *                        passes them to the session raw handler
  * @throws ERR_CSK_RECV_FAILED       Error in receiving data from the connection socket
  * @throws ERR_PEER_DISCONNECTED     The connection peer has abruptly disconnected
+ * @throws ERR_SEND_FAILED           Error in reading from the connection socket's error queue
  * @throws ERR_MSG_LENGTH_INVALID    Received an invalid message length value
  * @throws ERR_CONNMGR_INVALID_STATE The connection manager is in the 'RECV_RAW'
  *                                   mode in the STSM Key establishment phase
@@ -116,6 +132,16 @@ SrvSessMgr* SrvConnMgr::getSession()
  */
 void SrvConnMgr::srvRecvHandleData()
  {
+  // As the select() reports a connection socket with pending zero-copy completion notifications in its
+  // error queue as readable even if no input data is available on it, if any zero-copy send has not
+  // completed yet process such notifications, returning if no input data is actually available
+  if((int32_t)(_zcSendSeq - _zcComplSeq) > 0)
+   {
+    recvZeroCopyCompl();
+    if(!isRecvDataAvailable())
+     return;
+   }
+
   // If the connection manager is in the 'RECV_MSG' reception mode
   if(_recvMode == RECV_MSG)
    {
@@ -178,6 +204,7 @@ void SrvConnMgr::srvRecvHandleData()
 
      // Reads bytes belonging to the same data block from the connection socket into
      // the primary connection buffer and pass them to the session raw  handler
-     _srvSessMgr->srvSessRawHandler(recvRaw());
+     recvRaw();
+     _srvSessMgr->srvSessRawHandler();
     }
  }
\ No newline at end of file
@@ -7,6 +7,9 @@
 #include "SafeCloudApp/ConnMgr/ConnMgr.h"
 #include "SrvSTSMMgr/SrvSTSMMgr.h"
 #include "SrvSessMgr/SrvSessMgr.h"
+#include "../GroupCommit/GroupCommit.h"
+#include "../PartialUploads/PartialUploads.h"
+#include "../ContentStore/ContentStore.h"
 #include <unordered_map>
 
 
@@ -26,6 +29,22 @@ class SrvConnMgr : public ConnMgr
     // The child server Session Manager object
     SrvSessMgr*        _srvSessMgr;
 
+    // The server's group commit making the uploaded files durable
+    GroupCommit&       _groupCommit;
+
+    // The server's interrupted uploads retained for their resumption
+    PartialUploads&    _partialUploads;
+
+    // The absolute path of the directory of the interrupted uploads
+    // of the authenticated client associated with this manager
+    std::string*       _resumeDir;
+
+    // The server's content store deduplicating the users' files
+    ContentStore&      _contentStore;
+
+    // The server's AES_128_GCM workers pool
+    AESGCMPool&        _aesGCMPool;
+
     /* =============================== FRIEND CLASSES =============================== */
     friend class SrvSTSMMgr;
     friend class SrvSessMgr;
@@ -48,14 +67,21 @@ class SrvConnMgr : public ConnMgr
    /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
    /**
-    * @brief          SrvConnMgr object constructor
-    * @param csk      The connection socket associated with this manager
-    * @param guestIdx The connected client's temporary identifier
-    * @param rsaKey   The server's long-term RSA key pair
-    * @param srvCert  The server's X.509 certificate
+    * @brief                SrvConnMgr object constructor
+    * @param csk            The connection socket associated with this manager
+    * @param guestIdx       The connected client's temporary identifier
+    * @param rsaKey         The server's long-term RSA key pair
+    * @param srvCert        The server's X.509 certificate
+    * @param ticketKeys     The server's resumption ticket keys
+    * @param groupCommit    The server's uploads group commit
+    * @param partialUploads The server's interrupted uploads retained for their resumption
+    * @param contentStore   The server's content store deduplicating the users' files
+    * @param aesGCMPool     The server's AES_128_GCM workers pool
     * @note The constructor also initializes the _srvSTSMMgr child object
     */
-   SrvConnMgr(int csk, unsigned int guestIdx, EVP_PKEY* rsaKey, X509* srvCert);
+   SrvConnMgr(int csk, unsigned int guestIdx, EVP_PKEY* rsaKey, X509* srvCert, TicketKeys& ticketKeys,
+              GroupCommit& groupCommit, PartialUploads& partialUploads, ContentStore& contentStore,
+              AESGCMPool& aesGCMPool);
 
    /**
     * @brief SrvConnMgr object destructor, which safely deletes
@@ -84,6 +110,7 @@ class SrvConnMgr : public ConnMgr
    *                        passes them to the session raw handler
    * @throws ERR_CSK_RECV_FAILED       Error in receiving data from the connection socket
    * @throws ERR_PEER_DISCONNECTED     The connection peer has abruptly disconnected
+   * @throws ERR_SEND_FAILED           Error in reading from the connection socket's error queue
    * @throws ERR_MSG_LENGTH_INVALID    Received an invalid message length value
    * @throws ERR_CONNMGR_INVALID_STATE The connection manager is in the 'RECV_RAW'
    *                                   mode in the STSM Key establishment phase
@@ -4,6 +4,7 @@
 
 // System Headers
 #include <cstring>
+#include <unistd.h>
 
 // SafeCloud Headers
 #include "errCodes/execErrCodes/execErrCodes.h"
@@ -143,21 +144,41 @@ void SrvSTSMMgr::checkSrvSTSMMsg()
     // 'CLIENT_HELLO' message
     case CLIENT_HELLO:
 
-     // This message can be received only in the
-     // 'WAITING_CLI_HELLO' STSM server state
-     if(_stsmSrvState != WAITING_CLI_HELLO)
+     // This message can be received only in the 'WAITING_CLI_HELLO'
+     // and 'WAITING_CLI_FULL_HELLO' STSM server states
+     if(_stsmSrvState == WAITING_CLI_AUTH)
       sendSrvSTSMErrMsg(ERR_UNEXPECTED_MESSAGE,
                         "'CLIENT_HELLO' in the 'WAITING_CLI_AUTH' state");
 
-     // Ensure the message length to be equal
-     // to the size of a 'CLIENT_HELLO' message
-     if(stsmMsg->header.len != sizeof(STSM_CLIENT_HELLO_MSG))
+     // Ensure the message length to be at least equal to the size of a 'CLIENT_HELLO'
+     // message's fixed part (the size of the client's ephemeral public key depending
+     // on its chosen STSM suite, which is validated in the recv_client_hello() method)
+     if(stsmMsg->header.len < sizeof(STSM_CLIENT_HELLO_MSG))
       sendSrvSTSMErrMsg(ERR_MALFORMED_MESSAGE,
                         "'CLIENT_HELLO' message of unexpected length");
 
      // A valid 'CLIENT_HELLO' message has been received
      return;
 
+    // 'CLI_RESUME_HELLO' message
+    case CLI_RESUME_HELLO:
+
+     // This message can be received only in the 'WAITING_CLI_HELLO' STSM server
+     // state (i.e. a client can present a single resumption ticket per connection)
+     if(_stsmSrvState != WAITING_CLI_HELLO)
+      sendSrvSTSMErrMsg(ERR_UNEXPECTED_MESSAGE,
+                        "'CLI_RESUME_HELLO' message outside the 'WAITING_CLI_HELLO' state");
+
+     // Ensure the message length to be at least equal to the size of a
+     // 'CLI_RESUME_HELLO' message's fixed part (the size of the client's ephemeral
+     // public key being validated in the recv_cli_resume_hello() method)
+     if(stsmMsg->header.len < sizeof(STSM_CLI_RESUME_HELLO_MSG))
+      sendSrvSTSMErrMsg(ERR_MALFORMED_MESSAGE,
+                        "'CLI_RESUME_HELLO' message of unexpected length");
+
+     // A valid 'CLI_RESUME_HELLO' message has been received
+     return;
+
     // 'CLI_AUTH' message
     case CLI_AUTH:
 
@@ -165,10 +186,12 @@ void SrvSTSMMgr::checkSrvSTSMMsg()
      // 'WAITING_CLI_AUTH' STSM client state
      if(_stsmSrvState != WAITING_CLI_AUTH)
       sendSrvSTSMErrMsg(ERR_UNEXPECTED_MESSAGE,
-                        "'CLI_AUTH' message in the 'WAITING_CLI_HELLO' state");
+                        "'CLI_AUTH' message before the 'CLIENT_HELLO' message");
 
-     // Ensure the message length to be equal to the size of a 'CLI_AUTH' message
-     if(stsmMsg->header.len != sizeof(STSM_CLI_AUTH_MSG))
+     // Ensure the message length to be compatible with the size of a 'CLI_AUTH' message,
+     // whose client's STSM authentication proof is of up to STSM_AUTH_PROOF_MAX_SIZE bytes
+     if(stsmMsg->header.len <= sizeof(STSM_CLI_AUTH_MSG) ||
+        stsmMsg->header.len > sizeof(STSM_CLI_AUTH_MSG) + STSM_AUTH_PROOF_MAX_SIZE)
       sendSrvSTSMErrMsg(ERR_MALFORMED_MESSAGE,
                         "'CLI_AUTH' message of unexpected length");
 
@@ -208,14 +231,149 @@ void SrvSTSMMgr::checkSrvSTSMMsg()
  }
 
 
+/* ------------------------ Connection Parameters Utilities ------------------------ */
+
+/**
+ * @brief  Sets the connection parameters offered by the client in its 'hello' message, i.e.
+ *         its initial random IV, the optional features enabled in the secure communication
+ *         and the AEAD cipher selected from both peers' preferences
+ * @param  iv          The initial random IV provided by the client
+ * @param  cliFeatures The optional features supported by the client
+ * @param  cliCiphers  The AEAD ciphers supported by the client in decreasing order of preference
+ * @throws ERR_STSM_MALFORMED_MESSAGE No AEAD cipher in common with the client
+ */
+void SrvSTSMMgr::setConnParams(IV& iv, uint8_t cliFeatures, uint8_t* cliCiphers)
+ {
+  // The AEAD ciphers supported by the server in decreasing order of preference
+  uint8_t srvCiphers[AEAD_NUM_CIPHERS];
+
+  /* ----------------------------- Random IV ----------------------------- */
+
+  // Initialize the associated connection manager's IV to the client-provided value
+  _srvConnMgr._iv = new IV(iv);
+
+  /* ------------------------- Supported Features ------------------------- */
+
+  // Enable the compression of the connection's file
+  // transfers if it is supported by both the client and the server
+  _srvConnMgr._compress = (cliFeatures & STSM_SUPPORTED_FEATURES & STSM_FEATURE_COMPRESSION) != 0;
+
+  // Enable 64-bit file and storage pool sizes if they are supported by both the client and the server
+  // (otherwise the connection is restricted to files and storage pools of at most 4GB)
+  _srvConnMgr._largeFiles = (cliFeatures & STSM_SUPPORTED_FEATURES & STSM_FEATURE_LARGE_FILES) != 0;
+
+  // Enable the resumption of interrupted uploads if it is supported by both the
+  // client and the server and the server retains partial uploads (see 'PartialUploads')
+  _srvConnMgr._resumeUploads = (cliFeatures & STSM_SUPPORTED_FEATURES & STSM_FEATURE_RESUMABLE_UPLOADS) != 0 &&
+                               _srvConnMgr._partialUploads.enabled();
+
+  // Enable downloads of byte ranges of files if they are supported by both the client and the server
+  _srvConnMgr._rangedDownloads = (cliFeatures & STSM_SUPPORTED_FEATURES & STSM_FEATURE_RANGED_DOWNLOADS) != 0;
+
+  // Enable uploads announcing their file's digest if they are supported by both the client and the
+  // server and the server deduplicates the users' files in its content store (see 'ContentStore')
+  _srvConnMgr._dedupUploads = (cliFeatures & STSM_SUPPORTED_FEATURES & STSM_FEATURE_DEDUP_UPLOADS) != 0 &&
+                              _srvConnMgr._contentStore.enabled();
+
+  // Enable uploads sending only the changes to the server's copy of
+  // their file if they are supported by both the client and the server
+  _srvConnMgr._deltaUploads = (cliFeatures & STSM_SUPPORTED_FEATURES & STSM_FEATURE_DELTA_UPLOADS) != 0;
+
+  /* ----------------------------- AEAD Cipher ----------------------------- */
+
+  // Select the AEAD cipher protecting the session phase of the connection
+  // from the client's and the server's preferences (see "AEAD.h")
+  AEAD_GetCipherPrefs(srvCiphers);
+  _srvConnMgr._aeadCipher = AEAD_SelectCipher(cliCiphers, srvCiphers);
+
+  // A client not offering any AEAD cipher supported by the server is attributed to a malformed message
+  if(_srvConnMgr._aeadCipher == AEAD_NONE)
+   sendSrvSTSMErrMsg(ERR_MALFORMED_MESSAGE, "No AEAD cipher in common with the client");
+ }
+
+
+/**
+ * @brief Sets the name of the authenticated client along with its
+ *        temporary, pool and interrupted uploads directories
+ * @param cliName The authenticated client's name
+ */
+void SrvSTSMMgr::setClientInfo(std::string& cliName)
+ {
+  // Update the client's name
+  delete _srvConnMgr._name;
+  _srvConnMgr._name = new std::string(cliName);
+
+  // Set the connection's temporary directory
+  _srvConnMgr._tmpDir = new std::string(SRV_USER_TEMP_DIR_PATH(cliName));
+
+  // Set the client's pool directory path
+  _srvConnMgr._poolDir = new std::string(SRV_USER_POOL_PATH(cliName));
+
+  // Set the client's interrupted uploads directory path
+  _srvConnMgr._resumeDir = new std::string(SRV_USER_RESUME_DIR_PATH(cliName));
+ }
+
+
+/**
+ * @brief  Issues the client a resumption ticket for the resumption PSK derived from the
+ *         current session key, valid for the remaining lifetime from their last full STSM
+ *         authentication (or an empty ticket if resumption tickets are disabled)
+ * @param  ticket         The ticket to be issued
+ * @param  ticketLifetime The ticket's remaining lifetime in seconds (0 = no ticket issued)
+ * @throws ERR_OSSL_RAND_BYTES_FAILED   RAND_bytes() ticket key or nonce generation failed
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW  EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the ticket's integrity tag
+ */
+void SrvSTSMMgr::issueTicket(STSMTicket& ticket, uint32_t& ticketLifetime)
+ {
+  // The ticket's contents
+  STSMTicketContents ticketContents;
+
+  // If resumption tickets are disabled or the client's tickets
+  // have expired, send the client an empty ticket of no lifetime
+  ticketLifetime = _ticketKeys.enabled() ? _ticketKeys.remLifetime(_cliAuthTime) : 0;
+  if(ticketLifetime == 0)
+   {
+    memset(&ticket, 0, sizeof(STSMTicket));
+    return;
+   }
+
+  // Set the ticket's contents (zeroing their padding)
+  memset(&ticketContents, 0, sizeof(STSMTicketContents));
+  ticketContents.authTime = _cliAuthTime;
+  strncpy(reinterpret_cast<char*>(&ticketContents.cliName[0]), _srvConnMgr._name->c_str(), CLI_NAME_MAX_LENGTH);
+  memcpy(&ticketContents.psk[0], &_resPSK[0], STSM_RES_PSK_SIZE);
+
+  // Seal the ticket's contents with the current ticket key
+  _ticketKeys.sealTicket(ticketContents, ticket);
+
+  // Safely delete the ticket's contents
+  OPENSSL_cleanse(&ticketContents, sizeof(STSMTicketContents));
+ }
+
+
 /* ------------------------- 'CLIENT_HELLO' Message (1/4) ------------------------- */
 
 /**
  * @brief  Parses the client's 'CLIENT_HELLO' STSM message (1/4), consisting of:\n\n
- *             1) Their ephemeral DH public key "Yc"\n\n
- *             2) The initial random IV to be used in the secure communication
- * @throws ERR_OSSL_BIO_NEW_FAILED         OpenSSL BIO initialization failed
+ *             1) The initial random IV to be used in the secure communication\n\n
+ *             2) The optional features supported by the client\n\n
+ *             3) The AEAD ciphers supported by the client in decreasing order of preference\n\n
+ *             4) The STSM suite chosen by the client, of which the server
+ *                generates its ephemeral key pair accordingly\n\n
+ *             5) Their ephemeral public key "Yc"
+ * @throws ERR_STSM_MALFORMED_MESSAGE      Unsupported STSM suite, message length not matching
+ *                                         its ephemeral public key size or no AEAD cipher
+ *                                         in common with the client
  * @throws ERR_OSSL_EVP_PKEY_NEW           EVP_PKEY struct creation failed
+ * @throws ERR_OSSL_EVP_PKEY_ASSIGN        EVP_PKEY struct assignment failure
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW       EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT   EVP_PKEY key generation initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN        EVP_PKEY Key generation failed
+ * @throws ERR_OSSL_BIO_NEW_FAILED         OpenSSL BIO initialization failed
  * @throws ERR_STSM_SRV_CLI_INVALID_PUBKEY The client provided an invalid
  *                                         ephemeral DH public key
  */
@@ -224,37 +382,38 @@ void SrvSTSMMgr::recv_client_hello()
   // Interpret the connection manager's primary buffer as a 'CLIENT_HELLO' STSM message
   STSM_CLIENT_HELLO_MSG* cliHelloMsg = reinterpret_cast<STSM_CLIENT_HELLO_MSG*>(_srvConnMgr._priBuf);
 
-  /* ------------------ Client's ephemeral DH public key ------------------ */
+  /* ----------------------------- STSM Suite ----------------------------- */
 
-  // Initialize a memory BIO to the client's ephemeral DH public key
-  BIO* cliPubDHBio = BIO_new_mem_buf(cliHelloMsg->cliEDHPubKey, -1);
-  if(cliPubDHBio == NULL)
-   THROW_EXEC_EXCP(ERR_OSSL_BIO_NEW_FAILED, OSSL_ERR_DESC);
+  // A client choosing an STSM suite not supported by
+  // the server is attributed to a malformed message
+  if(cliHelloMsg->cliSuite != STSM_SUITE_DH2048 && cliHelloMsg->cliSuite != STSM_SUITE_X25519)
+   sendSrvSTSMErrMsg(ERR_MALFORMED_MESSAGE, "Unsupported STSM suite");
 
-  /* NOT NEEDED (from valgrind memory checker) */
-  /*
-  // Initialize the client's ephemeral DH public key structure
-  _otherDHEPubKey = EVP_PKEY_new();
-  if(_otherDHEPubKey == nullptr)
-   THROW_EXEC_EXCP(ERR_OSSL_EVP_PKEY_NEW, OSSL_ERR_DESC);
-  */
+  // Set the client-chosen STSM suite
+  _stsmSuite = (STSMSuite)cliHelloMsg->cliSuite;
 
-  // Write the client's ephemeral DH public key
-  // from the memory BIO into the EVP_PKEY structure
-  _otherDHEPubKey = PEM_read_bio_PUBKEY(cliPubDHBio, NULL,NULL, NULL);
+  // Ensure the message length to match the size of the client's
+  // ephemeral public key in its chosen STSM suite
+  if(cliHelloMsg->header.len != sizeof(STSM_CLIENT_HELLO_MSG) + EDHPubKeySize())
+   sendSrvSTSMErrMsg(ERR_MALFORMED_MESSAGE, "'CLIENT_HELLO' message of unexpected length");
 
-  // Free the memory BIO
-  if(BIO_free(cliPubDHBio) != 1)
-   LOG_EXEC_CODE(ERR_OSSL_BIO_FREE_FAILED, OSSL_ERR_DESC);
+  // Generate the server's ephemeral key pair of the client-chosen STSM suite
+  EDHKeygen();
+
+  /* ------------------ Client's ephemeral DH public key ------------------ */
+
+  // Read the client's ephemeral public key from the 'CLIENT_HELLO' message
+  readOtherEDHPubKey(cliHelloMsg->cliEDHPubKey);
 
   // Ensure the client's ephemeral DH public key to be valid
   if(_otherDHEPubKey == nullptr)
    sendSrvSTSMErrMsg(ERR_INVALID_PUBKEY,OSSL_ERR_DESC);
 
-  /* ----------------------------- Random IV ----------------------------- */
+  /* ---------------------- Random IV, Features and Cipher ---------------------- */
 
-  // Initialize the associated connection manager's IV to the client-provided value
-  _srvConnMgr._iv = new IV(cliHelloMsg->iv);
+  // Set the client's initial random IV, the optional features
+  // enabled in the secure communication and its AEAD cipher
+  setConnParams(cliHelloMsg->iv, cliHelloMsg->cliFeatures, cliHelloMsg->cliCiphers);
 
   /* ------------------------------ Cleanup ------------------------------ */
 
@@ -284,12 +443,13 @@ void SrvSTSMMgr::recv_client_hello()
 
 /**
  * @brief Sends the 'SRV_AUTH' STSM message to the client (2/4), consisting of:\n\n
- *            1) The server's ephemeral DH public key "Ys"\n\n
- *            2) The server's STSM authentication proof, consisting of the concatenation
+ *            1) The optional features and the AEAD cipher selected for the connection\n\n
+ *            2) The server's ephemeral DH public key "Ys"\n\n
+ *            3) The server's STSM authentication proof, consisting of the concatenation
  *               of both actors' ephemeral public DH keys (STSM authentication value)
- *               signed with the server's long-term private RSA key and encrypted with
+ *               signed with the server's long-term private key and encrypted with
  *               the resulting shared  session key "{<Yc||Ys>s}k"\n\n
- *            3) The server's certificate "srvCert"
+ *            4) The server's certificate "srvCert"
  * @throws ERR_STSM_MY_PUBKEY_MISSING           The server's ephemeral DH
  *                                              public key is missing
  * @throws ERR_STSM_OTHER_PUBKEY_MISSING        The client's ephemeral DH
@@ -299,6 +459,8 @@ void SrvSTSMMgr::recv_client_hello()
  *                                              DH public key into a BIO
  * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read a cryptographic
  *                                              quantity from a BIO
+ * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write an ephemeral
+ *                                              X25519 public key
  * @throws ERR_OSSL_EVP_MD_CTX_NEW              EVP_MD context creation failed
  * @throws ERR_OSSL_EVP_SIGN_INIT               EVP_MD signing initialization failed
  * @throws ERR_OSSL_EVP_SIGN_UPDATE             EVP_MD signing update failed
@@ -321,10 +483,25 @@ void SrvSTSMMgr::send_srv_auth()
   // primary connection buffer as a 'SRV_AUTH' message
   STSM_SRV_AUTH_MSG* stsmSrvAuth = reinterpret_cast<STSM_SRV_AUTH_MSG*>(_srvConnMgr._priBuf);
 
+  // The size of an ephemeral public key in the STSM suite used
+  unsigned int pubKeySize = EDHPubKeySize();
+
+  // The sizes of the server's signed STSM authentication value and proof
+  unsigned int srvSigSize;
+  int          srvProofSize;
+
+  /* ----------------------- Connection Parameters ----------------------- */
+
+  // Announce the optional features enabled and the AEAD cipher selected for the
+  // session phase of the connection, allowing the client to send its first
+  // session request along with its 'CLI_AUTH' message
+  stsmSrvAuth->srvFeatures = _srvConnMgr.getFeatures();
+  stsmSrvAuth->srvCipher = _srvConnMgr._aeadCipher;
+
   /* ------------------ Server's ephemeral DH public key ------------------ */
 
   // Write the server's ephemeral DH public key into the 'SRV_AUTH' message
-  writeMyEDHPubKey(&stsmSrvAuth->srvEDHPubKey[0]);
+  writeMyEDHPubKey(&stsmSrvAuth->srvAuthData[0]);
 
   /* ----------------- Server's STSM Authentication Proof ----------------- */
 
@@ -332,22 +509,18 @@ void SrvSTSMMgr::send_srv_auth()
   // concatenation of both actors' ephemeral public DH keys "Yc||Ys",
   // in the associated connection manager's secondary buffer
   writeOtherEDHPubKey(&_srvConnMgr._secBuf[0]);
-  writeMyEDHPubKey(&_srvConnMgr._secBuf[DH2048_PUBKEY_PEM_SIZE]);
+  writeMyEDHPubKey(&_srvConnMgr._secBuf[pubKeySize]);
 
-  /*
-   * Sign the server's STSM authentication value with its long-term private RSA key
-   *
-   * NOTE: As the server's private RSA key is on 2048 bit, the resulting
-   *       signature has an implicit size of 2048 bits = 256 bytes
-   */
-  digSigSign(_myRSALongPrivKey, &_srvConnMgr._secBuf[0],
-             2 * DH2048_PUBKEY_PEM_SIZE, &_srvConnMgr._secBuf[2 * DH2048_PUBKEY_PEM_SIZE]);
+  // Sign the server's STSM authentication value with its long-term private key, whose
+  // signature size depends on its type (RSA2048_SIG_SIZE or ED25519_SIG_SIZE bytes)
+  srvSigSize = digSigSign(_myLongPrivKey, &_srvConnMgr._secBuf[0],
+                          2 * pubKeySize, &_srvConnMgr._secBuf[2 * pubKeySize]);
 
   /*
   // LOG: Server's signed STSM authentication value
   printf("Server signed STSM authentication value: \n");
-  for(int i=0; i < RSA2048_SIG_SIZE; i++)
-   printf("%02x", _srvConnMgr._secBuf[2 * DH2048_PUBKEY_PEM_SIZE + i]);
+  for(int i=0; i < srvSigSize; i++)
+   printf("%02x", _srvConnMgr._secBuf[2 * pubKeySize + i]);
   printf("\n");
   */
 
@@ -355,14 +528,15 @@ void SrvSTSMMgr::send_srv_auth()
    * Encrypt the signed STSM authentication value as the server
    * STSM authentication proof in the 'SRV_AUTH' message
    *
-   * NOTE: Being the size of the signed STSM authentication value of 256 bytes
-   *       an integer multiple of the AES block size, its encryption will always
-   *       add a full padding block of 128 bits = 16 bytes, for an implicit size
-   *       of the resulting STSM authentication proof of 256 + 16 = 272 bytes
+   * NOTE: Being the size of both RSA-2048 and Ed25519 signatures an integer
+   *       multiple of the AES block size, their encryption will always add a
+   *       full padding block of 128 bits = 16 bytes, for a size of the resulting
+   *       STSM authentication proof of respectively 272 and 80 bytes
    */
-  AES_128_CBC_Encrypt(_srvConnMgr._skey, _srvConnMgr._iv,
-                      &_srvConnMgr._secBuf[2 * DH2048_PUBKEY_PEM_SIZE],
-                      RSA2048_SIG_SIZE, stsmSrvAuth->srvSTSMAuthProof);
+  srvProofSize = AES_128_CBC_Encrypt(_srvConnMgr._skey, _srvConnMgr._iv,
+                                     &_srvConnMgr._secBuf[2 * pubKeySize],
+                                     (int)srvSigSize, &stsmSrvAuth->srvAuthData[pubKeySize]);
+  stsmSrvAuth->srvSTSMAuthProofSize = (uint16_t)srvProofSize;
 
   /* --------------------- Server's X.509 Certificate --------------------- */
 
@@ -380,7 +554,7 @@ void SrvSTSMMgr::send_srv_auth()
 
   // Write the server's X.509 certificate
   // from the BIO to the 'SRV_AUTH' message
-  if(BIO_read(srvCertBIO, stsmSrvAuth->srvCert, srvCertSize) <= 0)
+  if(BIO_read(srvCertBIO, &stsmSrvAuth->srvAuthData[pubKeySize + srvProofSize], srvCertSize) <= 0)
    THROW_EXEC_EXCP(ERR_OSSL_BIO_READ_FAILED, OSSL_ERR_DESC);
 
   // Free the memory BIO
@@ -390,9 +564,8 @@ void SrvSTSMMgr::send_srv_auth()
   /* ------------------ Message Finalization and Sending ------------------ */
 
   // Initialize the 'SRV_AUTH' message length and type
-  stsmSrvAuth->header.len = sizeof(STSMMsgHeader)
-                            + DH2048_PUBKEY_PEM_SIZE + STSM_AUTH_PROOF_SIZE
-                            + srvCertSize;
+  stsmSrvAuth->header.len = sizeof(STSM_SRV_AUTH_MSG)
+                            + pubKeySize + srvProofSize + srvCertSize;
   stsmSrvAuth->header.type = SRV_AUTH;
 
   // Send the 'SRV_AUTH' message to the client
@@ -412,8 +585,8 @@ void SrvSTSMMgr::send_srv_auth()
   printf("\n");
 
   printf("Server's STSM authentication proof:\n");
-  for(int i=0; i < STSM_AUTH_PROOF_SIZE ; i++)
-   printf("%02x", stsmSrvAuth->srvSTSMAuthProof[i]);
+  for(int i=0; i < srvProofSize ; i++)
+   printf("%02x", stsmSrvAuth->srvAuthData[pubKeySize + i]);
   printf("\n");
   */
  }
@@ -423,57 +596,64 @@ void SrvSTSMMgr::send_srv_auth()
 
 /**
  * @brief         Attempts to retrieve a client's long-term
- *                RSA public key from its ".pem" file
+ *                public key (RSA-2048 or Ed25519) from its ".pem" file
  * @param cliName The client's (candidate) name
- * @return        The client's long-term RSA public key
+ * @return        The client's long-term public key
  * @throws ERR_LOGIN_PUBKEYFILE_NOT_FOUND   No public key file associated
  *                                          with such client name was found
  * @throws ERR_LOGIN_PUBKEYFILE_OPEN_FAILED Failed to open the client's public key file
  * @throws ERR_FILE_CLOSE_FAILED            Failed to close the client's public key file
- * @throws ERR_LOGIN_PUBKEY_INVALID         The contents of the client's public key file could
- *                                          not be interpreted as a valid RSA public key
+ * @throws ERR_LOGIN_PUBKEY_INVALID         The contents of the client's public key file could not
+ *                                          be interpreted as a valid RSA-2048 or Ed25519 public key
  */
-EVP_PKEY* SrvSTSMMgr::getCliRSAPubKey(std::string& cliName)
+EVP_PKEY* SrvSTSMMgr::getCliPubKey(std::string& cliName)
  {
-  EVP_PKEY* cliRSAPubKey;      // The client's long term RSA public key
-  FILE* cliRSAPubKeyFile;      // The client's long-term RSA public key file (.pem)
-  char* cliRSAPubKeyFilePath;  // The client's long-term RSA public key file path
+  EVP_PKEY* cliPubKey;      // The client's long term public key
+  FILE* cliPubKeyFile;      // The client's long-term public key file (.pem)
+  char* cliPubKeyFilePath;  // The client's long-term public key file path
 
   // Derive the expected absolute, or canonicalized, path of the server's private key file
-  cliRSAPubKeyFilePath = realpath(std::string(SRV_USER_PUBK_PATH(cliName)).c_str(), NULL);
-  if(!cliRSAPubKeyFilePath)
+  cliPubKeyFilePath = realpath(std::string(SRV_USER_PUBK_PATH(cliName)).c_str(), NULL);
+  if(!cliPubKeyFilePath)
    THROW_EXEC_EXCP(ERR_LOGIN_PUBKEYFILE_NOT_FOUND, "client name = \"" + cliName + "\"");
 
-  // Try-catch block to allow the cliRSAPubKeyFilePath
+  // Try-catch block to allow the cliPubKeyFilePath
   // both to be freed and reported in case of errors
   try
    {
-    // Attempt to open the client's RSA public key file
-    cliRSAPubKeyFile = fopen(cliRSAPubKeyFilePath, "r");
-    if(!cliRSAPubKeyFile)
-     THROW_EXEC_EXCP(ERR_LOGIN_PUBKEYFILE_OPEN_FAILED, cliRSAPubKeyFilePath, ERRNO_DESC);
+    // Attempt to open the client's public key file
+    cliPubKeyFile = fopen(cliPubKeyFilePath, "r");
+    if(!cliPubKeyFile)
+     THROW_EXEC_EXCP(ERR_LOGIN_PUBKEYFILE_OPEN_FAILED, cliPubKeyFilePath, ERRNO_DESC);
 
-    // Attempt to read the client's long-term RSA public key from its file
-    cliRSAPubKey = PEM_read_PUBKEY(cliRSAPubKeyFile, NULL, NULL, NULL);
+    // Attempt to read the client's long-term public key from its file
+    cliPubKey = PEM_read_PUBKEY(cliPubKeyFile, NULL, NULL, NULL);
 
-    // Close the client's RSA public key file
-    if(fclose(cliRSAPubKeyFile) != 0)
-     THROW_EXEC_EXCP(ERR_FILE_CLOSE_FAILED, cliRSAPubKeyFilePath, ERRNO_DESC);
+    // Close the client's public key file
+    if(fclose(cliPubKeyFile) != 0)
+     THROW_EXEC_EXCP(ERR_FILE_CLOSE_FAILED, cliPubKeyFilePath, ERRNO_DESC);
 
     // Ensure that a valid public key has been read
-    if(!cliRSAPubKey)
-     THROW_EXEC_EXCP(ERR_LOGIN_PUBKEY_INVALID, cliRSAPubKeyFilePath, OSSL_ERR_DESC);
+    if(!cliPubKey)
+     THROW_EXEC_EXCP(ERR_LOGIN_PUBKEY_INVALID, cliPubKeyFilePath, OSSL_ERR_DESC);
 
-    // Free the client's RSA public key file path
-    free(cliRSAPubKeyFilePath);
+    // Ensure the client's public key to be of a supported type
+    if(!digSigKeySupported(cliPubKey))
+     {
+      EVP_PKEY_free(cliPubKey);
+      THROW_EXEC_EXCP(ERR_LOGIN_PUBKEY_INVALID, cliPubKeyFilePath, "Unsupported key type");
+     }
+
+    // Free the client's public key file path
+    free(cliPubKeyFilePath);
 
     // Return the client's public key
-    return cliRSAPubKey;
+    return cliPubKey;
    }
   catch(execErrExcp& cliPubKeyFileExcp)
    {
-    // Free the client's RSA public key file path
-    free(cliRSAPubKeyFilePath);
+    // Free the client's public key file path
+    free(cliPubKeyFilePath);
 
     // Rethrow the error
     throw;
@@ -486,7 +666,7 @@ EVP_PKEY* SrvSTSMMgr::getCliRSAPubKey(std::string& cliName)
  *            1) The client's name \n
  *            2) The client's STSM authentication proof, consisting of the concatenation
  *               of its name and both actors' ephemeral public DH keys (STSM authentication
- *               value) signed with the client's long-term private RSA key and encrypted
+ *               value) signed with the client's long-term private key and encrypted
  *               with the resulting shared session key "{<name||Yc||Ys>s}k"\n
  * @throws ERR_STSM_SRV_CLIENT_LOGIN_FAILED Unrecognized client's username
  * @throws ERR_STSM_MY_PUBKEY_MISSING       The server's ephemeral DH public key is missing
@@ -506,12 +686,18 @@ EVP_PKEY* SrvSTSMMgr::getCliRSAPubKey(std::string& cliName)
  */
 void SrvSTSMMgr::recv_cli_auth()
  {
-  EVP_PKEY* cliRSAPubKey;   // The client's long term RSA public key
+  EVP_PKEY* cliPubKey;   // The client's long term public key
 
   // Interpret the associated connection manager's
   // primary connection buffer as a 'CLI_AUTH' message
   STSM_CLI_AUTH_MSG* stsmCliAuth = reinterpret_cast<STSM_CLI_AUTH_MSG*>(_srvConnMgr._priBuf);
 
+  // The size of an ephemeral public key in the STSM suite used
+  unsigned int pubKeySize = EDHPubKeySize();
+
+  // The size of the client's STSM authentication proof (already validated in checkSrvSTSMMsg())
+  int cliProofSize = (int)(stsmCliAuth->header.len - sizeof(STSM_CLI_AUTH_MSG));
+
   /* ---------------------- Client's Name Validation ---------------------- */
 
   // Extract the client's name as a string from the 'CLI_AUTH' message
@@ -528,8 +714,8 @@ void SrvSTSMMgr::recv_cli_auth()
     sanitizeUsername(cliName);
 
     // Assert a client with such name to be registered within the
-    // SafeCloud server by retrieving its long-term RSA public key
-    cliRSAPubKey = getCliRSAPubKey(cliName);
+    // SafeCloud server by retrieving its long-term public key
+    cliPubKey = getCliPubKey(cliName);
    }
   catch(execErrExcp& cliLoginExcp)
    {
@@ -555,7 +741,7 @@ void SrvSTSMMgr::recv_cli_auth()
   /*
   // LOG: Client's STSM authentication proof
   printf("Client's STSM authentication proof:\n");
-  for(int i=0; i < STSM_AUTH_PROOF_SIZE ; i++)
+  for(int i=0; i < cliProofSize ; i++)
    printf("%02x", stsmCliAuth->cliSTSMAuthProof[i]);
   printf("\n");
   */
@@ -565,35 +751,42 @@ void SrvSTSMMgr::recv_cli_auth()
   // in the associated connection manager's secondary buffer
   strcpy(reinterpret_cast<char*>(&_srvConnMgr._secBuf), cliName.c_str());
   writeOtherEDHPubKey(&_srvConnMgr._secBuf[cliName.length() + 1]);
-  writeMyEDHPubKey(&_srvConnMgr._secBuf[cliName.length() + 1 + DH2048_PUBKEY_PEM_SIZE]);
+  writeMyEDHPubKey(&_srvConnMgr._secBuf[cliName.length() + 1 + pubKeySize]);
 
   // Decrypt the client's STSM authentication proof in
   // the associated connection manager's secondary buffer
   int decProofSize = AES_128_CBC_Decrypt(_srvConnMgr._skey, _srvConnMgr._iv,
-                                         stsmCliAuth->cliSTSMAuthProof,STSM_AUTH_PROOF_SIZE,
-                                         &_srvConnMgr._secBuf[cliName.length() + 1 + (2 * DH2048_PUBKEY_PEM_SIZE)]);
+                                         stsmCliAuth->cliSTSMAuthProof, cliProofSize,
+                                         &_srvConnMgr._secBuf[cliName.length() + 1 + (2 * pubKeySize)]);
 
-  // Assert the decrypted STSM authentication proof to be on RSA2048_SIG_SIZE = 256 bytes
-  if(decProofSize != 256)
-   sendSrvSTSMErrMsg(ERR_MALFORMED_MESSAGE,"Decrypted client's STSM authentication proof of invalid size");
+  // Assert the decrypted STSM authentication proof to be of the signature size of the
+  // client's long-term key type (RSA2048_SIG_SIZE = 256 or ED25519_SIG_SIZE = 64 bytes)
+  if(decProofSize != EVP_PKEY_get_size(cliPubKey))
+   {
+    EVP_PKEY_free(cliPubKey);
+    sendSrvSTSMErrMsg(ERR_MALFORMED_MESSAGE,"Decrypted client's STSM authentication proof of invalid size");
+   }
 
   /*
   // LOG: Client's signed STSM authentication value
   printf("Client signed STSM authentication value: \n");
-  for(int i=0; i < RSA2048_SIG_SIZE; i++)
-   printf("%02x", _srvConnMgr._secBuf[cliName.length() + 1 + (2 * DH2048_PUBKEY_PEM_SIZE) + i]);
+  for(int i=0; i < decProofSize; i++)
+   printf("%02x", _srvConnMgr._secBuf[cliName.length() + 1 + (2 * pubKeySize) + i]);
   printf("\n");
   */
 
   // Attempt to verify the client's signature on its STSM authentication value <name||Yc||Ys>c
   try
    {
-    digSigVerify(cliRSAPubKey, &_srvConnMgr._secBuf[0],
-                  cliName.length() + 1 + (2 * DH2048_PUBKEY_PEM_SIZE),
-                  &_srvConnMgr._secBuf[cliName.length() + 1 + (2 * DH2048_PUBKEY_PEM_SIZE)], RSA2048_SIG_SIZE);
+    digSigVerify(cliPubKey, &_srvConnMgr._secBuf[0],
+                  cliName.length() + 1 + (2 * pubKeySize),
+                  &_srvConnMgr._secBuf[cliName.length() + 1 + (2 * pubKeySize)], decProofSize);
    }
   catch(execErrExcp& digVerExcp)
    {
+    // Free the client's public key
+    EVP_PKEY_free(cliPubKey);
+
     // If the signature verification failed, inform the client that they
     // have failed the STSM authentication and abort the connection
     if(digVerExcp.exErrcode == ERR_OSSL_SIG_VERIFY_FAILED)
@@ -607,31 +800,36 @@ void SrvSTSMMgr::recv_cli_auth()
   /* ---------------- Client Information Update and Cleanup ---------------- */
 
   // Free the client's public key
-  EVP_PKEY_free(cliRSAPubKey);
+  EVP_PKEY_free(cliPubKey);
 
   LOG_DEBUG("[" + *_srvConnMgr._name + "] STSM 3/4: Received valid 'CLI_AUTH' message")
 
   // Log the authenticated client
-  LOG_INFO("\"" + *_srvConnMgr._name + "\" has logged in as \"" + cliName + "\"")
+  LOG_INFO("\"" + *_srvConnMgr._name + "\" has logged in as \"" + cliName + "\" (session cipher: "
+           + AEAD_CipherToStr(_srvConnMgr._aeadCipher) + ")")
 
-  // Update the client's name
-  delete _srvConnMgr._name;
-  _srvConnMgr._name = new std::string(cliName);
+  // Set the client's name and directories
+  setClientInfo(cliName);
 
-  // Set the connection's temporary directory
-  _srvConnMgr._tmpDir = new std::string(SRV_USER_TEMP_DIR_PATH(cliName));
-
-  // Set the client's pool directory path
-  _srvConnMgr._poolDir = new std::string(SRV_USER_POOL_PATH(cliName));
+  // Set the time of the client's full STSM authentication,
+  // from which its resumption tickets' lifetime is computed
+  _cliAuthTime = (uint64_t)time(NULL);
  }
 
 
 /* ---------------------------- 'SRV_OK' Message (4/4) ---------------------------- */
 
 /**
- * @brief Sends the 'SRV_OK' message to the client (4/4), consisting of
- *        just the notification that their authentication was successful
- *        and so that the connection can now switch to the session phase
+ * @brief  Sends the 'SRV_OK' message to the client (4/4), consisting of the notification
+ *         that their authentication was successful and so that the connection can now
+ *         switch to the session phase, along with the optional features enabled in it,
+ *         the AEAD cipher selected for it and a resumption ticket for future connections
+ * @throws ERR_OSSL_RAND_BYTES_FAILED   RAND_bytes() ticket key or nonce generation failed
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW  EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the ticket's integrity tag
  */
 void SrvSTSMMgr::send_srv_ok()
  {
@@ -643,24 +841,300 @@ void SrvSTSMMgr::send_srv_ok()
   stsmSrvOK->header.len = sizeof(STSM_SRV_OK_MSG);
   stsmSrvOK->header.type = SRV_OK;
 
+  // Notify the client of the optional features enabled in the secure communication
+  stsmSrvOK->srvFeatures = _srvConnMgr.getFeatures();
+
+  // Notify the client of the AEAD cipher selected for the secure communication
+  stsmSrvOK->srvCipher = _srvConnMgr._aeadCipher;
+
+  // Issue the client a resumption ticket for its future connections
+  issueTicket(stsmSrvOK->ticket, stsmSrvOK->ticketLifetime);
+
   // Send the 'SRV_OK' message to the client
   _srvConnMgr.sendMsg();
 
-  LOG_DEBUG("[" + *_srvConnMgr._name + "] STSM 4/4: Sent 'SRV_OK' message, STSM protocol completed")
+  LOG_DEBUG("[" + *_srvConnMgr._name + "] STSM 4/4: Sent 'SRV_OK' message, STSM protocol completed (session cipher: "
+            + AEAD_CipherToStr(_srvConnMgr._aeadCipher) + ")")
+ }
+
+/* --------------------- 'CLI_RESUME_HELLO' Message (1/2) --------------------- */
+
+/**
+ * @brief  Parses the client's 'CLI_RESUME_HELLO' STSM message (1/2), consisting of:\n\n
+ *             1) The initial random IV to be used in the secure communication\n\n
+ *             2) The optional features supported by the client\n\n
+ *             3) The AEAD ciphers supported by the client in decreasing order of preference\n\n
+ *             4) The STSM suite chosen by the client\n\n
+ *             5) The resumption ticket previously issued to the client\n\n
+ *             6) The client's binder, proving its knowledge of the ticket's resumption PSK\n\n
+ *             7) Their ephemeral public key "Yc"
+ * @return Whether the client's resumption ticket was accepted, with a ticket that could not
+ *         be opened, has expired, refers to a client no longer registered within the server
+ *         or whose binder is invalid being rejected before any key is generated
+ * @throws ERR_STSM_MALFORMED_MESSAGE      Unsupported STSM suite, message length not matching
+ *                                         its ephemeral public key size or no AEAD cipher
+ *                                         in common with the client
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW     EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_DECRYPT_INIT       EVP_CIPHER decrypt initialization failed
+ * @throws ERR_OSSL_EVP_DECRYPT_UPDATE     EVP_CIPHER decrypt update failed
+ * @throws ERR_OSSL_SET_TAG_FAILED         Error in setting the ticket's expected integrity tag
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW       EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT   Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE        Key derivation failed
+ * @throws ERR_OSSL_HMAC_FAILED            HMAC computation failed
+ * @throws ERR_OSSL_EVP_PKEY_NEW           EVP_PKEY struct creation failed
+ * @throws ERR_OSSL_EVP_PKEY_ASSIGN        EVP_PKEY struct assignment failure
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT   EVP_PKEY key generation initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_KEYGEN        EVP_PKEY Key generation failed
+ * @throws ERR_OSSL_BIO_NEW_FAILED         OpenSSL BIO initialization failed
+ * @throws ERR_STSM_SRV_CLI_INVALID_PUBKEY The client provided an invalid
+ *                                         ephemeral DH public key
+ */
+bool SrvSTSMMgr::recv_cli_resume_hello()
+ {
+  // Interpret the connection manager's primary buffer as a 'CLI_RESUME_HELLO' STSM message
+  STSM_CLI_RESUME_HELLO_MSG* cliResHelloMsg = reinterpret_cast<STSM_CLI_RESUME_HELLO_MSG*>(_srvConnMgr._priBuf);
+
+  // The contents of the client's resumption ticket
+  STSMTicketContents ticketContents;
+
+  // The size in bytes of the 'CLI_RESUME_HELLO' message's portion preceding the client's binder
+  size_t binderOffset = cliResHelloMsg->cliBinder - _srvConnMgr._priBuf;
+
+  // The binder key and the expected client's binder
+  unsigned char binderKey[STSM_RES_PSK_SIZE];
+  unsigned char expBinder[STSM_RES_MAC_SIZE];
+
+  // Whether the client's binder is valid
+  bool binderValid;
+
+  /* ----------------------------- STSM Suite ----------------------------- */
+
+  // A client choosing an STSM suite not supported by
+  // the server is attributed to a malformed message
+  if(cliResHelloMsg->cliSuite != STSM_SUITE_DH2048 && cliResHelloMsg->cliSuite != STSM_SUITE_X25519)
+   sendSrvSTSMErrMsg(ERR_MALFORMED_MESSAGE, "Unsupported STSM suite");
+
+  // Set the client-chosen STSM suite
+  _stsmSuite = (STSMSuite)cliResHelloMsg->cliSuite;
+
+  // Ensure the message length to match the size of the client's
+  // ephemeral public key in its chosen STSM suite
+  if(cliResHelloMsg->header.len != sizeof(STSM_CLI_RESUME_HELLO_MSG) + EDHPubKeySize())
+   sendSrvSTSMErrMsg(ERR_MALFORMED_MESSAGE, "'CLI_RESUME_HELLO' message of unexpected length");
+
+  /* ------------------------ Resumption Ticket ------------------------ */
+
+  // Attempt to open the client's resumption ticket, which is rejected if it
+  // was not issued by this server instance or if its lifetime has elapsed
+  if(!_ticketKeys.openTicket(cliResHelloMsg->ticket, ticketContents))
+   {
+    LOG_DEBUG("[" + *_srvConnMgr._name + "] Invalid or expired resumption ticket")
+    return false;
+   }
+
+  // Extract the ticket's client name
+  std::string cliName(reinterpret_cast<char*>(&ticketContents.cliName[0]));
+
+  // Ensure the client to still be registered within the SafeCloud
+  // server, i.e. that its long-term public key file still exists
+  if(access(std::string(SRV_USER_PUBK_PATH(cliName)).c_str(), R_OK) != 0)
+   {
+    LOG_DEBUG("[" + *_srvConnMgr._name + "] Resumption ticket of the no longer registered client \""
+              + cliName + "\"")
+    OPENSSL_cleanse(&ticketContents, sizeof(STSMTicketContents));
+    return false;
+   }
+
+  /* -------------------------- Client's Binder -------------------------- */
+
+  // Build the client's binder input, consisting of the concatenation of the 'CLI_RESUME_HELLO'
+  // message's portion preceding the binder and of the client's ephemeral public key "Yc",
+  // in the associated connection manager's secondary buffer
+  memcpy(&_srvConnMgr._secBuf[0], _srvConnMgr._priBuf, binderOffset);
+  memcpy(&_srvConnMgr._secBuf[binderOffset], cliResHelloMsg->cliEDHPubKey, EDHPubKeySize());
+
+  // Compute the expected client's binder with the ticket's resumption PSK binder key
+  deriveLabeledKey(ticketContents.psk, STSM_RES_BINDER_LABEL, binderKey);
+  computeResMAC(binderKey, &_srvConnMgr._secBuf[0], binderOffset + EDHPubKeySize(), expBinder);
+  OPENSSL_cleanse(&binderKey[0], STSM_RES_PSK_SIZE);
+
+  // Verify the client's binder in constant time, which proves that the
+  // client presenting the ticket knows its resumption PSK (preventing
+  // the replay of resumption tickets observed in past connections)
+  binderValid = CRYPTO_memcmp(expBinder, cliResHelloMsg->cliBinder, STSM_RES_MAC_SIZE) == 0;
+  if(!binderValid)
+   {
+    LOG_DEBUG("[" + *_srvConnMgr._name + "] Invalid resumption binder")
+    OPENSSL_cleanse(&ticketContents, sizeof(STSMTicketContents));
+    return false;
+   }
+
+  /* ---------------------- Resumption Parameters ---------------------- */
+
+  // Set the ticket's resumption PSK and the time of the client's last full STSM authentication
+  memcpy(&_resPSK[0], &ticketContents.psk[0], STSM_RES_PSK_SIZE);
+  _cliAuthTime = ticketContents.authTime;
+  OPENSSL_cleanse(&ticketContents, sizeof(STSMTicketContents));
+
+  /* ------------------ Client's ephemeral DH public key ------------------ */
+
+  // Read the client's ephemeral public key from the 'CLI_RESUME_HELLO' message
+  readOtherEDHPubKey(cliResHelloMsg->cliEDHPubKey);
+
+  // Ensure the client's ephemeral DH public key to be valid
+  if(_otherDHEPubKey == nullptr)
+   sendSrvSTSMErrMsg(ERR_INVALID_PUBKEY,OSSL_ERR_DESC);
+
+  // Generate the server's ephemeral key pair of the client-chosen STSM suite
+  EDHKeygen();
+
+  /* ---------------------- Random IV, Features and Cipher ---------------------- */
+
+  // Set the client's initial random IV, the optional features
+  // enabled in the secure communication and its AEAD cipher
+  setConnParams(cliResHelloMsg->iv, cliResHelloMsg->cliFeatures, cliResHelloMsg->cliCiphers);
+
+  /* ---------------- Client Information Update and Cleanup ---------------- */
+
+  LOG_DEBUG("[" + *_srvConnMgr._name + "] STSM 1/2: Received valid 'CLI_RESUME_HELLO' message")
+
+  // Log the client resuming its authentication
+  LOG_INFO("\"" + *_srvConnMgr._name + "\" has resumed its login as \"" + cliName + "\" (session cipher: "
+           + AEAD_CipherToStr(_srvConnMgr._aeadCipher) + ")")
+
+  // Set the client's name and directories
+  setClientInfo(cliName);
+
+  // The client's resumption ticket was accepted
+  return true;
+ }
+
+
+/**
+ * @brief Sends the 'SRV_RESUME_REJECTED' STSM message to the client (2/2), informing
+ *        them that their resumption ticket was rejected and that they must continue
+ *        with a full STSM execution, starting from their 'CLIENT_HELLO' message
+ */
+void SrvSTSMMgr::send_srv_resume_rejected()
+ {
+  // Interpret the associated connection manager's
+  // primary connection buffer as a STSMsg
+  STSMMsg* resRejMsg = reinterpret_cast<STSMMsg*>(_srvConnMgr._priBuf);
+
+  // Set the message header's length and type
+  resRejMsg->header.len = sizeof(STSMMsg);
+  resRejMsg->header.type = SRV_RESUME_REJECTED;
+
+  // Send the 'SRV_RESUME_REJECTED' message to the client
+  _srvConnMgr.sendMsg();
+
+  LOG_DEBUG("[" + *_srvConnMgr._name + "] STSM 2/2: Sent 'SRV_RESUME_REJECTED' message, awaiting 'CLIENT_HELLO' message")
+ }
+
+
+/* ----------------------- 'SRV_RESUME_OK' Message (2/2) ----------------------- */
+
+/**
+ * @brief  Sends the 'SRV_RESUME_OK' STSM message to the client (2/2), consisting of:\n\n
+ *            1) The optional features enabled in the secure communication\n\n
+ *            2) The AEAD cipher selected for the session phase of the connection\n\n
+ *            3) A new resumption ticket, along with its remaining lifetime\n\n
+ *            4) The server's finished value, proving its knowledge of the ticket's
+ *               resumption PSK and its agreement on the resulting session key\n\n
+ *            5) The server's ephemeral public key "Ys"
+ * @throws ERR_OSSL_RAND_BYTES_FAILED           RAND_bytes() ticket key or nonce generation failed
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW          EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT            EVP_CIPHER encrypt initialization failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE          EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL           EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED              Error in retrieving the ticket's integrity tag
+ * @throws ERR_STSM_MY_PUBKEY_MISSING           The server's ephemeral DH public key is missing
+ * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
+ * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write an ephemeral
+ *                                              DH public key into a BIO
+ * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read a cryptographic
+ *                                              quantity from a BIO
+ * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write an ephemeral
+ *                                              X25519 public key
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW            EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT        Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE             Key derivation failed
+ * @throws ERR_OSSL_HMAC_FAILED                 HMAC computation failed
+ */
+void SrvSTSMMgr::send_srv_resume_ok()
+ {
+  // Interpret the associated connection manager's
+  // primary connection buffer as a 'SRV_RESUME_OK' message
+  STSM_SRV_RESUME_OK_MSG* stsmSrvResOK = reinterpret_cast<STSM_SRV_RESUME_OK_MSG*>(_srvConnMgr._priBuf);
+
+  // The size of an ephemeral public key in the STSM suite used
+  unsigned int pubKeySize = EDHPubKeySize();
+
+  // The size in bytes of the 'SRV_RESUME_OK' message's portion preceding the server's finished value
+  size_t finishedOffset = stsmSrvResOK->srvFinished - _srvConnMgr._priBuf;
+
+  // The finished key derived from the session key
+  unsigned char finishedKey[STSM_RES_PSK_SIZE];
+
+  /*
+   * Save the client's binder at the start of the associated connection manager's
+   * secondary buffer before the 'CLI_RESUME_HELLO' message is overwritten
+   *
+   * NOTE: 'cliBinder' is read through the 'CLI_RESUME_HELLO' message
+   *       layout, as both messages share the primary connection buffer
+   */
+  memcpy(&_srvConnMgr._secBuf[0],
+         reinterpret_cast<STSM_CLI_RESUME_HELLO_MSG*>(_srvConnMgr._priBuf)->cliBinder, STSM_RES_MAC_SIZE);
+
+  // Initialize the 'SRV_RESUME_OK' message length and type
+  stsmSrvResOK->header.len = sizeof(STSM_SRV_RESUME_OK_MSG) + pubKeySize;
+  stsmSrvResOK->header.type = SRV_RESUME_OK;
+
+  // Notify the client of the optional features enabled in the secure
+  // communication and of the AEAD cipher selected for it
+  stsmSrvResOK->srvFeatures = _srvConnMgr.getFeatures();
+  stsmSrvResOK->srvCipher = _srvConnMgr._aeadCipher;
+
+  // Issue the client a new resumption ticket, maintaining
+  // the time of their last full STSM authentication
+  issueTicket(stsmSrvResOK->ticket, stsmSrvResOK->ticketLifetime);
+
+  // Write the server's ephemeral public key "Ys" into the message
+  writeMyEDHPubKey(stsmSrvResOK->srvEDHPubKey);
+
+  // Build the server's finished value input, consisting of the concatenation of the client's binder,
+  // the 'SRV_RESUME_OK' message's portion preceding the finished value and the server's ephemeral
+  // public key "Ys", in the associated connection manager's secondary buffer
+  memcpy(&_srvConnMgr._secBuf[STSM_RES_MAC_SIZE], _srvConnMgr._priBuf, finishedOffset);
+  memcpy(&_srvConnMgr._secBuf[STSM_RES_MAC_SIZE + finishedOffset], stsmSrvResOK->srvEDHPubKey, pubKeySize);
+
+  // Compute the server's finished value with the session key's finished key
+  deriveLabeledKey(_srvConnMgr._skey, STSM_RES_FINISHED_LABEL, finishedKey);
+  computeResMAC(finishedKey, &_srvConnMgr._secBuf[0],
+                STSM_RES_MAC_SIZE + finishedOffset + pubKeySize, stsmSrvResOK->srvFinished);
+  OPENSSL_cleanse(&finishedKey[0], STSM_RES_PSK_SIZE);
+
+  // Send the 'SRV_RESUME_OK' message to the client
+  _srvConnMgr.sendMsg();
+
+  LOG_DEBUG("[" + *_srvConnMgr._name + "] STSM 2/2: Sent 'SRV_RESUME_OK' message, STSM protocol completed (session cipher: "
+            + AEAD_CipherToStr(_srvConnMgr._aeadCipher) + ")")
  }
 
 
 /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
 /**
- * @brief                  SrvSTSMMgr object constructor
- * @param myRSALongPrivKey The server's long-term RSA key pair
- * @param srvConnMgr       The parent SrvConnMgr instance managing this object
- * @param srvCert          The server's X.509 certificate
+ * @brief               SrvSTSMMgr object constructor
+ * @param myLongPrivKey The server's long-term key pair (RSA-2048 or Ed25519)
+ * @param srvConnMgr    The parent SrvConnMgr instance managing this object
+ * @param srvCert       The server's X.509 certificate
+ * @param ticketKeys    The server's resumption ticket keys
  */
-SrvSTSMMgr::SrvSTSMMgr(EVP_PKEY* myRSALongPrivKey, SrvConnMgr& srvConnMgr, X509* srvCert)
- : STSMMgr(myRSALongPrivKey), _stsmSrvState(WAITING_CLI_HELLO), _srvConnMgr(srvConnMgr),
-   _srvCert(srvCert), _lastSrvSTSMMsgTime(time(NULL))
+SrvSTSMMgr::SrvSTSMMgr(EVP_PKEY* myLongPrivKey, SrvConnMgr& srvConnMgr, X509* srvCert, TicketKeys& ticketKeys)
+ : STSMMgr(myLongPrivKey), _stsmSrvState(WAITING_CLI_HELLO), _srvConnMgr(srvConnMgr),
+   _srvCert(srvCert), _ticketKeys(ticketKeys), _cliAuthTime(0), _lastSrvSTSMMsgTime(time(NULL))
  {}
 
 /* ============================ OTHER PUBLIC METHODS ============================ */
@@ -685,23 +1159,62 @@ bool SrvSTSMMgr::STSMMsgHandler()
   // appropriate for the current server's STSM state, throwing an error otherwise
   checkSrvSTSMMsg();
 
+  // If the client is attempting to resume its authentication
+  if(reinterpret_cast<STSMMsg*>(_srvConnMgr._priBuf)->header.type == CLI_RESUME_HELLO)
+   {
+    // Parse the client's 'CLI_RESUME_HELLO' message, and if its resumption ticket was rejected
+    // inform the client that it must continue with a full STSM execution on this connection
+    if(!recv_cli_resume_hello())
+     {
+      send_srv_resume_rejected();
+
+      // Update the STSM server state
+      _stsmSrvState = WAITING_CLI_FULL_HELLO;
+
+      // Update the time at which the
+      // server sent its last STSM message
+      _lastSrvSTSMMsgTime = time(NULL);
+
+      // Inform the connection manager that the STSM
+      // key exchange protocol is still in progress
+      return false;
+     }
+
+    // Derive the shared session key from the ticket's resumption PSK
+    // and from the server's private and client's public ephemeral keys
+    deriveSessKey(_srvConnMgr._skey, _resPSK);
+
+    // Derive the resumption PSK of the new session key
+    deriveLabeledKey(_srvConnMgr._skey, STSM_RES_PSK_LABEL, _resPSK);
+
+    // Send the server's 'SRV_RESUME_OK' message
+    send_srv_resume_ok();
+
+    // Inform the connection manager that the STSM key exchange protocol has completed
+    // successfully and so that the connection can now switch to the session phase
+    return true;
+   }
+
   // Depending on the server's current state (and implicitly from
   // the previous check, the STSM message type that was received)
-  if(_stsmSrvState == WAITING_CLI_HELLO)
+  if(_stsmSrvState == WAITING_CLI_HELLO || _stsmSrvState == WAITING_CLI_FULL_HELLO)
    {
     // Parse the client's 'CLIENT_HELLO' message
     recv_client_hello();
 
-    // Derive the shared AES_128 session key from the server's
-    // private and the client's public ephemeral DH keys
-    deriveAES128SKey(_srvConnMgr._skey);
+    // Derive the shared session key from the server's
+    // private and the client's public ephemeral keys
+    deriveSessKey(_srvConnMgr._skey, nullptr);
+
+    // Derive the resumption PSK of the session key
+    deriveLabeledKey(_srvConnMgr._skey, STSM_RES_PSK_LABEL, _resPSK);
 
     // In DEBUG_MODE, log the shared session key in hexadecimal
 #ifdef DEBUG_MODE
-  char skeyHex[33];
-  for(int i = 0; i < AES_128_KEY_SIZE; i++)
+  char skeyHex[2 * AEAD_KEY_MAX_SIZE + 1];
+  for(int i = 0; i < AEAD_KEY_MAX_SIZE; i++)
    sprintf(skeyHex + 2 * i, "%.2x", _srvConnMgr._skey[i]);
-  skeyHex[32] = '\0';
+  skeyHex[2 * AEAD_KEY_MAX_SIZE] = '\0';
 
   LOG_DEBUG("[" + *_srvConnMgr._name + "] Shared session key: " + std::string(skeyHex))
 #endif
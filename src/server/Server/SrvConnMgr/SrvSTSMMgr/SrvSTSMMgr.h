@@ -5,6 +5,7 @@
 
 /* ================================== INCLUDES ================================== */
 #include "SafeCloudApp/ConnMgr/STSMMgr/STSMMgr.h"
+#include "../../TicketKeys/TicketKeys.h"
 
 // The maximum delay in seconds from when the server sent its last STSM
 // message for a received client STSM message to be considered valid
@@ -24,6 +25,10 @@ class SrvSTSMMgr : public STSMMgr
       // The server has not yet received the client's 'hello' message
       WAITING_CLI_HELLO,
 
+      // The server has rejected the client's resumption ticket and
+      // is awaiting its 'hello' message for a full STSM execution
+      WAITING_CLI_FULL_HELLO,
+
       // The server has sent its 'auth' message and is awaiting the client's one
       WAITING_CLI_AUTH
      };
@@ -32,6 +37,9 @@ class SrvSTSMMgr : public STSMMgr
     enum STSMSrvState _stsmSrvState;        // Current server state in the STSM key exchange protocol
     SrvConnMgr&       _srvConnMgr;          // The parent SrvConnMgr instance managing this object
     X509*             _srvCert;             // The server's X.509 certificate
+    TicketKeys&       _ticketKeys;          // The server's resumption ticket keys
+    uint64_t          _cliAuthTime;         // The time in Unix epochs of the client's last full
+                                            // STSM authentication (resumption tickets purposes)
     unsigned long     _lastSrvSTSMMsgTime;  // The time in Unix epochs at which the server sent its
                                             // last STSM message to the client (STSM timeout purposes)
 
@@ -79,14 +87,60 @@ class SrvSTSMMgr : public STSMMgr
      */
     void checkSrvSTSMMsg();
 
+    /* ------------------------ Connection Parameters Utilities ------------------------ */
+
+    /**
+     * @brief  Sets the connection parameters offered by the client in its 'hello' message, i.e.
+     *         its initial random IV, the optional features enabled in the secure communication
+     *         and the AEAD cipher selected from both peers' preferences
+     * @param  iv          The initial random IV provided by the client
+     * @param  cliFeatures The optional features supported by the client
+     * @param  cliCiphers  The AEAD ciphers supported by the client in decreasing order of preference
+     * @throws ERR_STSM_MALFORMED_MESSAGE No AEAD cipher in common with the client
+     */
+    void setConnParams(IV& iv, uint8_t cliFeatures, uint8_t* cliCiphers);
+
+    /**
+     * @brief Sets the name of the authenticated client along with its
+     *        temporary, pool and interrupted uploads directories
+     * @param cliName The authenticated client's name
+     */
+    void setClientInfo(std::string& cliName);
+
+    /**
+     * @brief  Issues the client a resumption ticket for the resumption PSK derived from the
+     *         current session key, valid for the remaining lifetime from their last full STSM
+     *         authentication (or an empty ticket if resumption tickets are disabled)
+     * @param  ticket         The ticket to be issued
+     * @param  ticketLifetime The ticket's remaining lifetime in seconds (0 = no ticket issued)
+     * @throws ERR_OSSL_RAND_BYTES_FAILED   RAND_bytes() ticket key or nonce generation failed
+     * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW  EVP_CIPHER context creation failed
+     * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+     * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+     * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+     * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the ticket's integrity tag
+     */
+    void issueTicket(STSMTicket& ticket, uint32_t& ticketLifetime);
+
     /* ------------------------- 'CLIENT_HELLO' Message (1/4) ------------------------- */
 
     /**
      * @brief  Parses the client's 'CLIENT_HELLO' STSM message (1/4), consisting of:\n\n
-     *             1) Their ephemeral DH public key "Yc"\n\n
-     *             2) The initial random IV to be used in the secure communication
-     * @throws ERR_OSSL_BIO_NEW_FAILED O       OpenSSL BIO initialization failed
+     *             1) The initial random IV to be used in the secure communication\n\n
+     *             2) The optional features supported by the client\n\n
+     *             3) The AEAD ciphers supported by the client in decreasing order of preference\n\n
+     *             4) The STSM suite chosen by the client, of which the server
+     *                generates its ephemeral key pair accordingly\n\n
+     *             5) Their ephemeral public key "Yc"
+     * @throws ERR_STSM_MALFORMED_MESSAGE      Unsupported STSM suite, message length not matching
+     *                                         its ephemeral public key size or no AEAD cipher
+     *                                         in common with the client
      * @throws ERR_OSSL_EVP_PKEY_NEW           EVP_PKEY struct creation failed
+     * @throws ERR_OSSL_EVP_PKEY_ASSIGN        EVP_PKEY struct assignment failure
+     * @throws ERR_OSSL_EVP_PKEY_CTX_NEW       EVP_PKEY context creation failed
+     * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT   EVP_PKEY key generation initialization failed
+     * @throws ERR_OSSL_EVP_PKEY_KEYGEN        EVP_PKEY Key generation failed
+     * @throws ERR_OSSL_BIO_NEW_FAILED         OpenSSL BIO initialization failed
      * @throws ERR_STSM_SRV_CLI_INVALID_PUBKEY The client provided an invalid
      *                                         ephemeral DH public key
      */
@@ -96,12 +150,13 @@ class SrvSTSMMgr : public STSMMgr
 
     /**
      * @brief Sends the 'SRV_AUTH' STSM message to the client (2/4), consisting of:\n\n
-     *            1) The server's ephemeral DH public key "Ys"\n\n
-     *            2) The server's STSM authentication proof, consisting of the concatenation
+     *            1) The optional features and the AEAD cipher selected for the connection\n\n
+     *            2) The server's ephemeral DH public key "Ys"\n\n
+     *            3) The server's STSM authentication proof, consisting of the concatenation
      *               of both actors' ephemeral public DH keys (STSM authentication value)
-     *               signed with the server's long-term private RSA key and encrypted with
+     *               signed with the server's long-term private key and encrypted with
      *               the resulting shared  session key "{<Yc||Ys>s}k"\n\n
-     *            3) The server's certificate "srvCert"
+     *            4) The server's certificate "srvCert"
      * @throws ERR_STSM_MY_PUBKEY_MISSING           The server's ephemeral DH
      *                                              public key is missing
      * @throws ERR_STSM_OTHER_PUBKEY_MISSING        The client's ephemeral DH
@@ -111,6 +166,8 @@ class SrvSTSMMgr : public STSMMgr
      *                                              DH public key into a BIO
      * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read a cryptographic
      *                                              quantity from a BIO
+     * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write an ephemeral
+     *                                              X25519 public key
      * @throws ERR_OSSL_EVP_MD_CTX_NEW              EVP_MD context creation failed
      * @throws ERR_OSSL_EVP_SIGN_INIT               EVP_MD signing initialization failed
      * @throws ERR_OSSL_EVP_SIGN_UPDATE             EVP_MD signing update failed
@@ -133,24 +190,24 @@ class SrvSTSMMgr : public STSMMgr
 
     /**
      * @brief         Attempts to retrieve a client's long-term
-     *                RSA public key from its ".pem" file
+     *                public key (RSA-2048 or Ed25519) from its ".pem" file
      * @param cliName The client's (candidate) name
-     * @return        The client's long-term RSA public key
+     * @return        The client's long-term public key
      * @throws ERR_LOGIN_PUBKEYFILE_NOT_FOUND   No public key file associated
      *                                          with such client name was found
      * @throws ERR_LOGIN_PUBKEYFILE_OPEN_FAILED Failed to open the client's public key file
      * @throws ERR_FILE_CLOSE_FAILED            Failed to close the client's public key file
-     * @throws ERR_LOGIN_PUBKEY_INVALID         The contents of the client's public key file could
-     *                                          not be interpreted as a valid RSA public key
+     * @throws ERR_LOGIN_PUBKEY_INVALID         The contents of the client's public key file could not
+     *                                          be interpreted as a valid RSA-2048 or Ed25519 public key
      */
-    static EVP_PKEY* getCliRSAPubKey(std::string& cliName);
+    static EVP_PKEY* getCliPubKey(std::string& cliName);
 
     /**
      * @brief  Parses the client's 'CLI_AUTH' STSM message (3/4), consisting of:\n\n
      *            1) The client's name \n\n
      *            2) The client's STSM authentication proof, consisting of the concatenation
      *               of its name and both actors' ephemeral public DH keys (STSM authentication
-     *               value) signed with the client's long-term private RSA key and encrypted
+     *               value) signed with the client's long-term private key and encrypted
      *               with the resulting shared session key "{<name||Yc||Ys>s}k"
      * @throws ERR_STSM_SRV_CLIENT_LOGIN_FAILED Unrecognized client's username
      * @throws ERR_STSM_MY_PUBKEY_MISSING       The server's ephemeral DH public key is missing
@@ -173,23 +230,98 @@ class SrvSTSMMgr : public STSMMgr
     /* ---------------------------- 'SRV_OK' Message (4/4) ---------------------------- */
 
     /**
-     * @brief Sends the 'SRV_OK' message to the client (4/4), consisting of
-     *        just the notification that their authentication was successful
-     *        and so that the connection can now switch to the session phase
+     * @brief Sends the 'SRV_OK' message to the client (4/4), consisting of the notification
+     *        that their authentication was successful and so that the connection can now
+     *        switch to the session phase, along with the optional features enabled in it
+     *        and the AEAD cipher selected for it
      */
     void send_srv_ok();
 
+    /* --------------------- 'CLI_RESUME_HELLO' Message (1/2) --------------------- */
+
+    /**
+     * @brief  Parses the client's 'CLI_RESUME_HELLO' STSM message (1/2), consisting of:\n\n
+     *             1) The initial random IV to be used in the secure communication\n\n
+     *             2) The optional features supported by the client\n\n
+     *             3) The AEAD ciphers supported by the client in decreasing order of preference\n\n
+     *             4) The STSM suite chosen by the client\n\n
+     *             5) The resumption ticket previously issued to the client\n\n
+     *             6) The client's binder, proving its knowledge of the ticket's resumption PSK\n\n
+     *             7) Their ephemeral public key "Yc"
+     * @return Whether the client's resumption ticket was accepted, with a ticket that could not
+     *         be opened, has expired, refers to a client no longer registered within the server
+     *         or whose binder is invalid being rejected before any key is generated
+     * @throws ERR_STSM_MALFORMED_MESSAGE      Unsupported STSM suite, message length not matching
+     *                                         its ephemeral public key size or no AEAD cipher
+     *                                         in common with the client
+     * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW     EVP_CIPHER context creation failed
+     * @throws ERR_OSSL_EVP_DECRYPT_INIT       EVP_CIPHER decrypt initialization failed
+     * @throws ERR_OSSL_EVP_DECRYPT_UPDATE     EVP_CIPHER decrypt update failed
+     * @throws ERR_OSSL_SET_TAG_FAILED         Error in setting the ticket's expected integrity tag
+     * @throws ERR_OSSL_EVP_PKEY_CTX_NEW       EVP_PKEY context creation failed
+     * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT   Key derivation context initialization failed
+     * @throws ERR_OSSL_EVP_PKEY_DERIVE        Key derivation failed
+     * @throws ERR_OSSL_HMAC_FAILED            HMAC computation failed
+     * @throws ERR_OSSL_EVP_PKEY_NEW           EVP_PKEY struct creation failed
+     * @throws ERR_OSSL_EVP_PKEY_ASSIGN        EVP_PKEY struct assignment failure
+     * @throws ERR_OSSL_EVP_PKEY_KEYGEN_INIT   EVP_PKEY key generation initialization failed
+     * @throws ERR_OSSL_EVP_PKEY_KEYGEN        EVP_PKEY Key generation failed
+     * @throws ERR_OSSL_BIO_NEW_FAILED         OpenSSL BIO initialization failed
+     * @throws ERR_STSM_SRV_CLI_INVALID_PUBKEY The client provided an invalid
+     *                                         ephemeral DH public key
+     */
+    bool recv_cli_resume_hello();
+
+    /**
+     * @brief Sends the 'SRV_RESUME_REJECTED' STSM message to the client (2/2), informing
+     *        them that their resumption ticket was rejected and that they must continue
+     *        with a full STSM execution, starting from their 'CLIENT_HELLO' message
+     */
+    void send_srv_resume_rejected();
+
+    /* ----------------------- 'SRV_RESUME_OK' Message (2/2) ----------------------- */
+
+    /**
+     * @brief  Sends the 'SRV_RESUME_OK' STSM message to the client (2/2), consisting of:\n\n
+     *            1) The optional features enabled in the secure communication\n\n
+     *            2) The AEAD cipher selected for the session phase of the connection\n\n
+     *            3) A new resumption ticket, along with its remaining lifetime\n\n
+     *            4) The server's finished value, proving its knowledge of the ticket's
+     *               resumption PSK and its agreement on the resulting session key\n\n
+     *            5) The server's ephemeral public key "Ys"
+     * @throws ERR_OSSL_RAND_BYTES_FAILED           RAND_bytes() ticket key or nonce generation failed
+     * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW          EVP_CIPHER context creation failed
+     * @throws ERR_OSSL_EVP_ENCRYPT_INIT            EVP_CIPHER encrypt initialization failed
+     * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE          EVP_CIPHER encrypt update failed
+     * @throws ERR_OSSL_EVP_ENCRYPT_FINAL           EVP_CIPHER encrypt final failed
+     * @throws ERR_OSSL_GET_TAG_FAILED              Error in retrieving the ticket's integrity tag
+     * @throws ERR_STSM_MY_PUBKEY_MISSING           The server's ephemeral DH public key is missing
+     * @throws ERR_OSSL_BIO_NEW_FAILED              OpenSSL BIO initialization failed
+     * @throws ERR_OSSL_PEM_WRITE_BIO_PUBKEY_FAILED Failed to write an ephemeral
+     *                                              DH public key into a BIO
+     * @throws ERR_OSSL_BIO_READ_FAILED             Failed to read a cryptographic
+     *                                              quantity from a BIO
+     * @throws ERR_OSSL_EVP_PKEY_GET_RAW_PUBKEY     Failed to write an ephemeral
+     *                                              X25519 public key
+     * @throws ERR_OSSL_EVP_PKEY_CTX_NEW            EVP_PKEY context creation failed
+     * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT        Key derivation context initialization failed
+     * @throws ERR_OSSL_EVP_PKEY_DERIVE             Key derivation failed
+     * @throws ERR_OSSL_HMAC_FAILED                 HMAC computation failed
+     */
+    void send_srv_resume_ok();
+
    public:
 
     /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
 
     /**
-     * @brief                  SrvSTSMMgr object constructor
-     * @param myRSALongPrivKey The server's long-term RSA key pair
-     * @param srvConnMgr       The parent SrvConnMgr instance managing this object
-     * @param srvCert          The server's X.509 certificate
+     * @brief               SrvSTSMMgr object constructor
+     * @param myLongPrivKey The server's long-term key pair (RSA-2048 or Ed25519)
+     * @param srvConnMgr    The parent SrvConnMgr instance managing this object
+     * @param srvCert       The server's X.509 certificate
+     * @param ticketKeys    The server's resumption ticket keys
      */
-    SrvSTSMMgr(EVP_PKEY* myRSALongPrivKey, SrvConnMgr& srvConnMgr, X509* srvCert);
+    SrvSTSMMgr(EVP_PKEY* myLongPrivKey, SrvConnMgr& srvConnMgr, X509* srvCert, TicketKeys& ticketKeys);
 
     /* Same destructor of the 'STSMMgr' base class */
 
@@ -3,14 +3,29 @@
 /* ================================== INCLUDES ================================== */
 
 // System Headers
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
 #include <cstring>
+#include <algorithm>
+#include <vector>
 
 // SafeCloud Headers
 #include "../SrvConnMgr.h"
+#include "SafeCloudApp/ConnMgr/SessMgr/SessStream/SessStream.h"
 #include "errCodes/sessErrCodes/sessErrCodes.h"
 #include "errCodes/execErrCodes/execErrCodes.h"
 
 
+/* ========================== STATIC MEMBERS DEFINITIONS ========================== */
+unsigned char* volatile SrvSessMgr::_mapGuardStart = nullptr;
+unsigned char* volatile SrvSessMgr::_mapGuardEnd   = nullptr;
+volatile sig_atomic_t   SrvSessMgr::_mapFaulted    = 0;
+long                    SrvSessMgr::_pageSize      = 0;
+
+
 /* ============================== PRIVATE METHODS ============================== */
 
 /* ------------------- Server Session Manager Utility Methods ------------------- */
@@ -26,6 +41,8 @@
  *                                       invalid for its current operation or step
  * @throws ERR_SESS_MALFORMED_MESSAGE    The session manager received
  *                                       a malformed session message
+ * @throws ERR_SESS_NO_SPACE             Not enough storage space
+ *                                       for the file to be received
  * @throws ERR_SESS_UNKNOWN_SESSMSG_TYPE The session manager received a
  *                                       session message of unknown type
  * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
@@ -76,6 +93,15 @@ void SrvSessMgr::sendSrvSessSignalMsg(SessMsgType sessMsgSignalingType, const st
       THROW_SESS_EXCP(ERR_SESS_MALFORMED_MESSAGE, "Client: \""
                       + *_connMgr._name + "\", " + abortedOpToStr());
 
+    // Not enough storage space is available for the file to be received
+    case ERR_NO_SPACE:
+     if(!errReason.empty())
+      THROW_SESS_EXCP(ERR_SESS_NO_SPACE, "Client: \""
+                      + *_connMgr._name + "\", " + abortedOpToStr(), errReason);
+     else
+      THROW_SESS_EXCP(ERR_SESS_NO_SPACE, "Client: \""
+                      + *_connMgr._name + "\", " + abortedOpToStr());
+
     // A session message of unknown type was received, an error to be attributed to a desynchronization
     // between the client and server IVs and that requires the connection to be reset
     case ERR_UNKNOWN_SESSMSG_TYPE:
@@ -93,6 +119,315 @@ void SrvSessMgr::sendSrvSessSignalMsg(SessMsgType sessMsgSignalingType, const st
  }
 
 
+/**
+ * @brief  Asserts the filesystem of the user's storage pool to have enough free space for the
+ *         file to be uploaded, which when overwriting an existing file coexists with it until
+ *         the upload completes, so to reject the upload before the client confirms it
+ * @throws ERR_SESS_NO_SPACE             Not enough storage space for the file to be uploaded
+ * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+ * @throws ERR_CLI_DISCONNECTED          The client disconnected during the send()
+ * @throws ERR_SEND_FAILED               send() fatal error
+ */
+void SrvSessMgr::checkPoolSpace()
+ {
+  struct statvfs poolFsInfo;  // Information on the filesystem of the user's storage pool
+
+  // Assert the storage space available to unprivileged users on the storage
+  // pool's filesystem to be at least the size of the file to be uploaded
+  // (where if such information is not available the check is skipped)
+  if(statvfs(_mainDirAbsPath->c_str(), &poolFsInfo) == 0 &&
+     (unsigned long)poolFsInfo.f_bavail * poolFsInfo.f_frsize < (unsigned long)_stream->remFileInfo->meta->fileSizeRaw)
+   sendSrvSessSignalMsg(ERR_NO_SPACE, "file \"" + _stream->remFileInfo->fileName + "\" ("
+                                      + _stream->remFileInfo->meta->fileSizeStr + "), available "
+                                      + std::to_string((unsigned long)poolFsInfo.f_bavail * poolFsInfo.f_frsize)
+                                      + " bytes");
+ }
+
+
+/**
+ * @brief  Preallocates the temporary file of the file being uploaded to its announced size, so that
+ *         its extents are reserved as contiguously as the filesystem allows rather than grown by
+ *         each segment write, rejecting the upload if there is not enough storage space for it
+ *         (where the extents are released along with the temporary file if the upload is aborted)
+ * @throws ERR_SESS_NO_SPACE             Not enough storage space for the file to be uploaded
+ * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+ * @throws ERR_CLI_DISCONNECTED          The client disconnected during the send()
+ * @throws ERR_SEND_FAILED               send() fatal error
+ */
+void SrvSessMgr::preallocUploadFile()
+ {
+  // Reserve the extents of the whole file without writing them
+  if(fallocate(fileno(_stream->tmpFileDscr), 0, 0, _stream->remFileInfo->meta->fileSizeRaw) == -1)
+   {
+    // If the storage space (or the user's quota) is not enough for the file, reject the upload
+    if(errno == ENOSPC || errno == EDQUOT || errno == EFBIG)
+     sendSrvSessSignalMsg(ERR_NO_SPACE, "file \"" + _stream->remFileInfo->fileName + "\" ("
+                                        + _stream->remFileInfo->meta->fileSizeStr + "), " + ERRNO_DESC);
+
+    // Otherwise, as if the filesystem does not support preallocation,
+    // proceed with the upload growing the file on each segment write
+    LOG_DEBUG("[" + *_connMgr._name + "] Preallocation of file \"" + _stream->remFileInfo->fileName
+              + "\" not available (" + std::string(ERRNO_DESC) + ")")
+   }
+ }
+
+
+/**
+ * @brief  If the resumption of uploads is supported by both peers, prepares the user's partial uploads
+ *         directory and sets the file being uploaded to be preserved as a partial upload if its upload is
+ *         interrupted, where if a partial upload of the file exists it is claimed as the upload's temporary
+ *         file and the client is informed of the offset its upload is resumed from
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL    EVP_MD digest failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_CLI_DISCONNECTED         The client disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SrvSessMgr::claimPartialUpload()
+ {
+  FILE*       partialDscr;  // The descriptor of the claimed partial upload of the file
+  std::string claimPath;    // The path the claimed partial upload is moved to
+  long int    offset;       // The offset the upload is resumed from
+
+  // Uploads are resumable only if both peers support their resumption
+  if(!_connMgr._resumeUploads)
+   return;
+
+  // Prepare the user's partial uploads directory and set the file to be preserved
+  // at the path of its partial upload should its upload be interrupted
+  _partialUploads.prepDir(*_resumeDirAbsPath);
+  _stream->resumeFileAbsPath = new std::string(_partialUploads.getPath(*_resumeDirAbsPath, *_stream->remFileInfo,
+                                                                       _stream->authOnly));
+
+  // Attempt to claim the file's partial upload into a path private to the
+  // upload (where the connection socket and stream identify the upload)
+  claimPath   = *_stream->resumeFileAbsPath + "_" + std::to_string(_connMgr._csk) + "_" + std::to_string(_stream->streamId);
+  partialDscr = _partialUploads.claim(*_stream->resumeFileAbsPath, claimPath,
+                                      _stream->remFileInfo->meta->fileSizeRaw, offset);
+
+  // If the file has no partial upload, it is uploaded from its start
+  if(partialDscr == nullptr)
+   return;
+
+  // Set the claimed partial upload as the upload's temporary file
+  // and the upload to be resumed from the offset its contents extend to
+  delete _stream->tmpFileAbsPath;
+  _stream->tmpFileAbsPath = new std::string(claimPath);
+  _stream->tmpFileDscr    = partialDscr;
+  _stream->rawOffset      = offset;
+
+  // Inform the client of the offset the upload is resumed from
+  sendSessMsgUploadResume();
+
+  LOG_INFO("[" + *_connMgr._name + "] Resuming the upload of file \"" + _stream->remFileInfo->fileName
+           + "\" from offset " + std::to_string(offset) + " of " + _stream->remFileInfo->meta->fileSizeStr)
+ }
+
+
+/**
+ * @brief Sets the transfer of a file to use the streaming I/O mode if its size is at least SRV_STREAMING_IO_MIN_SIZE,
+ *        disabling the stdio buffering of its descriptor, so that its segments are directly read or written between
+ *        the file and the connection buffers, and hinting the kernel that the file is accessed sequentially
+ *        (which also doubles its read-ahead), where it must be called before any I/O on the file descriptor
+ * @param fileDscr The descriptor of the file being uploaded or downloaded
+ * @param fileSize The size of the file being uploaded or downloaded
+ */
+void SrvSessMgr::initStreamingIO(FILE* fileDscr, long long fileSize)
+ {
+  // Smaller files are transferred through the stdio buffers and the page cache
+  if(fileSize < SRV_STREAMING_IO_MIN_SIZE)
+   return;
+
+  // Disable the stdio buffering of the file descriptor, so that as segments are larger than
+  // the stdio buffer they are directly read or written without being copied through it
+  setvbuf(fileDscr, nullptr, _IONBF, 0);
+
+  // Hint the kernel that the file is accessed sequentially
+  posix_fadvise(fileno(fileDscr), 0, 0, POSIX_FADV_SEQUENTIAL);
+ }
+
+
+/**
+ * @brief Releases the page cache used by a file transferred in streaming I/O mode as its windows are completed,
+ *        where, every time a segment completes a window (see SRV_STREAMING_IO_WINDOW):\n\n
+ *           - Writing (upload): The writeback of the completed window is started and, once the one of the previous
+ *             window has completed, the previous window is dropped from the page cache (so that writing is never
+ *             blocked on the writeback of the window just completed, and each window is dropped once clean)\n\n
+ *           - Reading (download): The completed window is dropped from the page cache
+ *             and the next window is hinted to be read ahead\n\n
+ *        with failures, which do not affect the transfer's correctness, being ignored
+ * @param fileDscr  The descriptor of the file being uploaded or downloaded
+ * @param fileMap   The memory mapping of the file being downloaded, if any, whose
+ *                  completed windows are also unmapped from the server's memory
+ * @param fileSize  The size of the file being uploaded or downloaded
+ * @param doneBytes The number of the file's bytes written or read so far, including the last segment
+ * @param segSize   The size of the last segment written or read
+ * @param writing   Whether the file is being written (upload) or read (download)
+ */
+void SrvSessMgr::advanceStreamingIO(FILE* fileDscr, unsigned char* fileMap, long long fileSize,
+                                    long long doneBytes, unsigned int segSize, bool writing)
+ {
+  // The file descriptor of the file
+  int fd;
+
+  // The start and end of the file's contents completed by the last segment, i.e. from the start of the window
+  // the segment began in up to the window boundary it crossed or, if it was the last segment, to the file's end
+  long long winStart;
+  long long winEnd;
+
+  // Smaller files are transferred through the stdio buffers and the page cache
+  if(fileSize < SRV_STREAMING_IO_MIN_SIZE)
+   return;
+
+  // If the last segment did not complete a window nor the file, there is nothing to release
+  if((doneBytes - segSize) / SRV_STREAMING_IO_WINDOW == doneBytes / SRV_STREAMING_IO_WINDOW && doneBytes != fileSize)
+   return;
+
+  // Determine the file's contents completed by the last segment
+  winStart = ((doneBytes - segSize) / SRV_STREAMING_IO_WINDOW) * SRV_STREAMING_IO_WINDOW;
+  if(doneBytes == fileSize)
+   winEnd = fileSize;
+  else
+   winEnd = (doneBytes / SRV_STREAMING_IO_WINDOW) * SRV_STREAMING_IO_WINDOW;
+  fd = fileno(fileDscr);
+
+  // Upload
+  if(writing)
+   {
+    // Start the writeback of the completed window without waiting for it
+    sync_file_range(fd, winStart, winEnd - winStart, SYNC_FILE_RANGE_WRITE);
+
+    // Wait for the writeback of the previous window, which has had a window's worth
+    // of writes to complete, and drop its now clean pages from the page cache
+    if(winStart >= SRV_STREAMING_IO_WINDOW)
+     {
+      sync_file_range(fd, winStart - SRV_STREAMING_IO_WINDOW, SRV_STREAMING_IO_WINDOW,
+                      SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+      posix_fadvise(fd, winStart - SRV_STREAMING_IO_WINDOW, SRV_STREAMING_IO_WINDOW, POSIX_FADV_DONTNEED);
+     }
+   }
+
+  // Download
+  else
+   {
+    // If the file is mapped, unmap the completed window's pages from the server's memory, which
+    // otherwise would keep them in the page cache (the window start being page-aligned)
+    if(fileMap != nullptr)
+     madvise(fileMap + winStart, (size_t)(winEnd - winStart), MADV_DONTNEED);
+
+    // Drop the completed window, whose pages are clean, from the page cache
+    posix_fadvise(fd, winStart, winEnd - winStart, POSIX_FADV_DONTNEED);
+
+    // Hint the kernel to read ahead the next window, if any
+    if(doneBytes < fileSize)
+     posix_fadvise(fd, winEnd, SRV_STREAMING_IO_WINDOW, POSIX_FADV_WILLNEED);
+   }
+ }
+
+
+/**
+ * @brief SIGBUS handler, which when the fault occurred in the mapped contents of the file segment being
+ *        encrypted (i.e. the file was truncated after being mapped) maps a page of zeros over the faulting
+ *        page and flags the fault, so that the segment's encryption completes and the download is then
+ *        aborted, and which otherwise restores the signal's default action, so that the fault re-occurs
+ *        and terminates the server as it would have without the handler
+ * @param sig  The signal number (SIGBUS)
+ * @param info Information on the signal, including the faulting address
+ * @note  The handler's third parameter, the context of the interrupted thread, is unused
+ */
+void SrvSessMgr::mapFileFaultHandler(int sig, siginfo_t* info, void*)
+ {
+  // The faulting address
+  unsigned char* faultAddr = static_cast<unsigned char*>(info->si_addr);
+
+  // The start of the faulting page
+  void* faultPage;
+
+  // If the fault occurred in the segment being encrypted (possibly by a worker thread),
+  // replace its faulting page with a page of zeros and flag the fault, resuming the encryption
+  if(faultAddr >= _mapGuardStart && faultAddr < _mapGuardEnd)
+   {
+    faultPage = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(faultAddr) & ~(uintptr_t)(_pageSize - 1));
+    if(mmap(faultPage, _pageSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) != MAP_FAILED)
+     {
+      _mapFaulted = 1;
+      return;
+     }
+   }
+
+  // Otherwise restore the signal's default action, which is taken as the fault re-occurs
+  signal(sig, SIG_DFL);
+ }
+
+
+/**
+ * @brief Maps read-only into memory the file being downloaded, so that its segments are encrypted
+ *        directly from the page cache rather than being first copied into the secondary buffer, where
+ *        the file is hinted to be accessed sequentially and, should it not be possible to map it,
+ *        its segments are read through its file descriptor as usual
+ */
+void SrvSessMgr::mapDownloadFile()
+ {
+  // The SIGBUS handler action
+  struct sigaction faultAction;
+
+  // The memory mapping of the file
+  void* fileMap;
+
+  // Empty files have no contents to be mapped
+  if(_stream->mainFileInfo->meta->fileSizeRaw <= 0)
+   return;
+
+  // Install the SIGBUS handler upon the first file mapping, so that a file
+  // truncated after being mapped aborts its download only (the handler
+  // being process-wide, as are the server's other signal handlers)
+  if(_pageSize == 0)
+   {
+    memset(&faultAction, 0, sizeof(faultAction));
+    faultAction.sa_sigaction = mapFileFaultHandler;
+    faultAction.sa_flags     = SA_SIGINFO;
+    sigemptyset(&faultAction.sa_mask);
+    if(sigaction(SIGBUS, &faultAction, nullptr) != 0)
+     {
+      LOG_DEBUG("[" + *_connMgr._name + "] SIGBUS handler installation failed (" + std::string(ERRNO_DESC)
+                + "), reading file \"" + _stream->mainFileInfo->fileName + "\" through its descriptor")
+      return;
+     }
+    _pageSize = sysconf(_SC_PAGESIZE);
+   }
+
+  // Map the file read-only, falling back to reading it through its descriptor on failure
+  fileMap = mmap(nullptr, (size_t)_stream->mainFileInfo->meta->fileSizeRaw, PROT_READ, MAP_SHARED,
+                 fileno(_stream->mainFileDscr), 0);
+  if(fileMap == MAP_FAILED)
+   {
+    LOG_DEBUG("[" + *_connMgr._name + "] Mapping of file \"" + _stream->mainFileInfo->fileName + "\" failed ("
+              + std::string(ERRNO_DESC) + "), reading it through its descriptor")
+    return;
+   }
+
+  // Hint the kernel that the mapping is accessed sequentially (read-ahead and early reclaim)
+  madvise(fileMap, (size_t)_stream->mainFileInfo->meta->fileSizeRaw, MADV_SEQUENTIAL);
+
+  _stream->mainFileMap     = static_cast<unsigned char*>(fileMap);
+  _stream->mainFileMapSize = (size_t)_stream->mainFileInfo->meta->fileSizeRaw;
+ }
+
+
 /**
  * @brief  Dispatches a received session message to the callback method associated with
  *         its type and the server session manager current operation and implicit step
@@ -107,7 +442,7 @@ void SrvSessMgr::sendSrvSessSignalMsg(SessMsgType sessMsgSignalingType, const st
 void SrvSessMgr::dispatchRecvSessMsg()
  {
   // Depending on the current server session manager operation
-  switch(_sessMgrOp)
+  switch(_stream->op)
    {
 
     /* ---------------- 'IDLE' Server Session Manager Operation ---------------- */
@@ -119,31 +454,31 @@ void SrvSessMgr::dispatchRecvSessMsg()
       {
        // ----------------- 'FILE_UPLOAD_REQ' Session Message ----------------- //
        case FILE_UPLOAD_REQ:
-        _sessMgrOp = UPLOAD;
+        _stream->op = UPLOAD;
         uploadStartCallback();
         break;
 
        // ---------------- 'FILE_DOWNLOAD_REQ' Session Message ---------------- //
        case FILE_DOWNLOAD_REQ:
-        _sessMgrOp = DOWNLOAD;
+        _stream->op = DOWNLOAD;
         downloadStartCallback();
         break;
 
        // ----------------- 'FILE_DELETE_REQ' Session Message ----------------- //
        case FILE_DELETE_REQ:
-        _sessMgrOp = DELETE;
+        _stream->op = DELETE;
         deleteStartCallback();
         break;
 
        // ----------------- 'FILE_RENAME_REQ' Session Message ----------------- //
        case FILE_RENAME_REQ:
-        _sessMgrOp = RENAME;
+        _stream->op = RENAME;
         renameStartCallback();
         break;
 
        // ------------------ 'FILE_LIST_REQ' Session Message ------------------ //
        case FILE_LIST_REQ:
-        _sessMgrOp = LIST;
+        _stream->op = LIST;
         listStartCallback();
         break;
 
@@ -161,16 +496,41 @@ void SrvSessMgr::dispatchRecvSessMsg()
     /* --------------- 'UPLOAD' Server Session Manager Operation --------------- */
     case SessMgr::UPLOAD:
 
-     // --------------------- 'CONFIRM' Signaling Message --------------------- //
-     if(_recvSessMsgType == CONFIRM)
-      uploadConfCallback();
+     // Depending on the type of the received session message
+     switch(_recvSessMsgType)
+      {
+       // -------------------- 'CONFIRM' Signaling Message -------------------- //
+       case CONFIRM:
+        uploadConfCallback();
+        return;
 
-     // ---------------------- Unexpected Session Message ---------------------- //
-     else
-      sendSrvSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"\"" + std::to_string(_recvSessMsgType) +
-                                                       "\" session message type received in the "
-                                                       "'UPLOAD' operation, step "
-                                                       + sessMgrOpStepToStrUpCase());
+       // ------------------ 'FILE_SEGMENT' Session Message ------------------ //
+       case FILE_SEGMENT:
+        uploadSegmentCallback();
+        return;
+
+       // ------------------ 'UPLOAD_DIGEST' Session Message ------------------ //
+       case UPLOAD_DIGEST:
+        uploadDigestCallback();
+        return;
+
+       // ----------------- 'DELTA_CONFIRM' Signaling Message ----------------- //
+       case DELTA_CONFIRM:
+        uploadDeltaConfCallback();
+        return;
+
+       // ------------------ 'UPLOAD_DELTA' Session Message ------------------ //
+       case UPLOAD_DELTA:
+        uploadDeltaCallback();
+        return;
+
+       // --------------------- Unexpected Session Message --------------------- //
+       default:
+        sendSrvSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"\"" + std::to_string(_recvSessMsgType) +
+                                                         "\" session message type received in the "
+                                                         "'UPLOAD' operation, step "
+                                                         + sessMgrOpStepToStrUpCase());
+      }
      break;
 
 
@@ -185,6 +545,12 @@ void SrvSessMgr::dispatchRecvSessMsg()
         downloadConfSendFileCallback();
         return;
 
+       // ---------------- 'DOWNLOAD_RANGE' Session Message ---------------- //
+       case DOWNLOAD_RANGE:
+        loadSessMsgDownloadRange();
+        downloadConfSendFileCallback();
+        return;
+
        // ------------------- 'COMPLETED' Signaling Message ------------------- //
        case COMPLETED:
         downloadComplCallback();
@@ -253,13 +619,16 @@ void SrvSessMgr::dispatchRecvSessMsg()
  *              2.1) If the file to be uploaded is empty and the file in the user's storage
  *                   pool does not exist or is empty, directly touch such a file in the user's
  *                   storage pool and notify them that the upload operation has completed\n\n
- *              2.2) If the file to be uploaded is NOT empty, depending on whether a file with
+ *              2.2) If the file to be uploaded is NOT empty, after resuming its upload from
+ *                   its partial upload, if any, and depending on whether a file with
  *                   the same name already exists in the user's storage pool:\n\n
  *                   2.1.1) If it does, the local file information are sent to the client,
  *                          with their confirmation  being required on whether the upload
  *                          should proceed and so such file be overwritten\n\n
  *                   2.2.2) If it does not, notify the client that the server
  *                          is ready to receive the file's raw contents
+ *              (where if deduplicated uploads have been negotiated such response is
+ *              deferred until the digest of the file's contents is received)
  * @throws ERR_SESS_MALFORMED_MESSAGE    Invalid file values in the 'SessMsgFileInfo' message
  * @throws ERR_SESS_MAIN_FILE_IS_DIR     The file to be uploaded was found as a
  *                                       directory in the client's storage pool (!)
@@ -269,6 +638,7 @@ void SrvSessMgr::dispatchRecvSessMsg()
  * @throws ERR_SESS_FILE_OPEN_FAILED     Error in opening the uploaded empty main file
  * @throws ERR_SESS_FILE_CLOSE_FAILED    Error in closing the uploaded empty main file
  * @throws ERR_SESS_FILE_META_SET_FAILED Error in setting the empty main file's metadata
+ * @throws ERR_SESS_NO_SPACE             Not enough storage space for the file to be uploaded
  * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
@@ -281,31 +651,31 @@ void SrvSessMgr::dispatchRecvSessMsg()
 void SrvSessMgr::uploadStartCallback()
  {
   // Load the name and metadata of the remote file to
-  // be uploaded into the '_remFileInfo' attribute
+  // be uploaded into the 'remFileInfo' attribute
   loadRemSessMsgFileInfo();
 
   // Initialize the main and temporary absolute paths of the file to be uploaded
-  _mainFileAbsPath = new std::string(*_mainDirAbsPath + _remFileInfo->fileName);
-  _tmpFileAbsPath  = new std::string(*_tmpDirAbsPath + _remFileInfo->fileName + "_PART");
+  _stream->mainFileAbsPath = new std::string(*_mainDirAbsPath + _stream->remFileInfo->fileName);
+  _stream->tmpFileAbsPath  = new std::string(*_tmpDirAbsPath + _stream->remFileInfo->fileName + "_PART");
 
   /*
   // LOG: Remote file information
-  _remFileInfo->printFileInfo();
+  _stream->remFileInfo->printFileInfo();
 
   // LOG: Main and temporary files absolute paths
-  std::cout << "_mainFileAbsPath = " << *_mainFileAbsPath << std::endl;
-  std::cout << "_tmpFileAbsPath = " << *_tmpFileAbsPath << std::endl;
+  std::cout << "mainFileAbsPath = " << *_stream->mainFileAbsPath << std::endl;
+  std::cout << "tmpFileAbsPath = " << *_stream->tmpFileAbsPath << std::endl;
   */
 
   // Check whether a file with the same name of the one to be uploaded
   // already exists in the user's storage pool by attempting to
-  // load its information into the '_mainFileInfo' attribute
+  // load its information into the 'mainFileInfo' attribute
   checkLoadMainFileInfo();
 
   // If the file to be uploaded is empty and the file in
   // the user's storage pool does not exist or is empty
-  if(_remFileInfo->meta->fileSizeRaw == 0 &&
-    (_mainFileInfo == nullptr || _mainFileInfo->meta->fileSizeRaw == 0))
+  if(_stream->remFileInfo->meta->fileSizeRaw == 0 &&
+    (_stream->mainFileInfo == nullptr || _stream->mainFileInfo->meta->fileSizeRaw == 0))
    {
     // Touch the empty file in the user's storage
     // pool, possibly overwriting the existing one
@@ -315,43 +685,89 @@ void SrvSessMgr::uploadStartCallback()
     sendSrvSessSignalMsg(COMPLETED);
 
     LOG_INFO("[" + *_connMgr._name + "] Empty file \"" +
-             _remFileInfo->fileName + "\" uploaded into the storage pool")
+             _stream->remFileInfo->fileName + "\" uploaded into the storage pool")
 
-    // Reset the server session manager state and return
-    resetSessState();
+    // Reset the stream state and return
+    resetStreamState();
     return;
    }
 
-  // Otherwise, if a file with the same name of the one to
+  // If the client announces the digest of the non-empty file's contents, await it
+  // before responding so that the upload may complete without their transfer
+  if(_connMgr._dedupUploads)
+   {
+    LOG_DEBUG("[" + *_connMgr._name + "] Received upload request of file \""
+              + _stream->remFileInfo->fileName + "\", awaiting its contents' digest")
+    return;
+   }
+
+  // Otherwise, respond to the upload request
+  respondUploadReq();
+ }
+
+
+/**
+ * @brief  Responds to the upload request of a non-empty file by resuming its upload from its partial
+ *         upload, if any, and, depending on whether a file with the same name already exists in the
+ *         user's storage pool, either sending the local file information to the client for them to
+ *         confirm its overwriting or notifying them that the server is ready to receive its raw contents
+ * @throws ERR_SESS_NO_SPACE            Not enough storage space for the file to be uploaded
+ * @throws ERR_SESS_FILE_OPEN_FAILED    Failed to open the temporary file
+ *                                      descriptor in write-byte mode
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SrvSessMgr::respondUploadReq()
+ {
+  // Resume the upload from the file's partial upload, if any
+  claimPartialUpload();
+
+  // If a file with the same name of the one to
   // be uploaded was found in the user's storage pool
-  if(_mainFileInfo != nullptr)
+  if(_stream->mainFileInfo != nullptr)
    {
+    // Assert the storage pool to have enough free space for the file to be
+    // uploaded before asking the client to confirm the file's overwriting
+    checkPoolSpace();
+
     // Prepare a 'SessMsgFileInfo' session message of type 'FILE_EXISTS'
     // containing the local file name and metadata and send it to the client
     sendSessMsgFileInfo(FILE_EXISTS);
 
     // Set the server session manager to expect the file upload confirmation
-    _sessMgrOpStep = WAITING_CONF;
+    _stream->opStep = WAITING_CONF;
 
     LOG_INFO("[" + *_connMgr._name + "] Received upload request of already-existing \""
-             + _remFileInfo->fileName + "\" file, awaiting client confirmation")
+             + _stream->remFileInfo->fileName + "\" file, awaiting client confirmation")
    }
 
   // Otherwise, if a file with the same name of the one to
   // be uploaded was not found in the user's storage pool
   else
    {
+    // Prepare the server session manager to receive the raw contents of the file to be
+    // uploaded, preallocating it before the client is told to send them so that the
+    // upload is rejected before any segment is sent if there is not enough space for it
+    prepRecvFileRaw();
+    preallocUploadFile();
+    initStreamingIO(_stream->tmpFileDscr, _stream->remFileInfo->meta->fileSizeRaw);
+
+    // If the content store is enabled, digest the file's contents as they are received
+    _stream->contentMDCtx = _contentStore.initDigest(*_stream->tmpFileAbsPath, _stream->rawOffset);
+
     // Inform the client that a file with such name is not present
     // in the user's storage pool, and so that the server is now
     // expecting the raw contents of the file to be uploaded
     sendSrvSessSignalMsg(FILE_NOT_EXISTS);
 
-    // Prepare the server session manager to receive
-    // the raw contents of the file to be uploaded
-    prepRecvFileRaw();
-
     LOG_INFO("[" + *_connMgr._name + "] Received upload request of "
-             "file \"" + _remFileInfo->fileName + "\" not existing "
+             "file \"" + _stream->remFileInfo->fileName + "\" not existing "
              "in the storage pool, awaiting the raw file contents")
    }
  }
@@ -369,6 +785,7 @@ void SrvSessMgr::uploadStartCallback()
  * @throws ERR_SESS_FILE_CLOSE_FAILED    Error in closing the empty file to be uploaded
  * @throws ERR_SESS_FILE_META_SET_FAILED Error in setting the metadata
  *                                       of the file to be uploaded
+ * @throws ERR_SESS_NO_SPACE             Not enough storage space for the file to be uploaded
  * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
@@ -384,7 +801,7 @@ void SrvSessMgr::uploadConfCallback()
  {
   /* [PATCH] */
   // If the file to be uploaded is empty
-  if(_remFileInfo->meta->fileSizeRaw == 0)
+  if(_stream->remFileInfo->meta->fileSizeRaw == 0)
    {
     // Touch the empty file in the user's storage
     // pool, possibly overwriting the existing one
@@ -394,144 +811,418 @@ void SrvSessMgr::uploadConfCallback()
     sendSrvSessSignalMsg(COMPLETED);
 
     LOG_INFO("[" + *_connMgr._name + "] Empty file \""
-             + _remFileInfo->fileName + "\" uploaded into the storage pool")
+             + _stream->remFileInfo->fileName + "\" uploaded into the storage pool")
 
-    // Reset the server session manager state and return
-    resetSessState();
+    // Reset the stream state and return
+    resetStreamState();
     return;
    }
 
    // Otherwise, if the file to be uploaded is NOT empty
   else
    {
-    // Prepare the server session manager to receive
-    // the raw contents of the file to be uploaded
+    // Prepare the server session manager to receive the raw
+    // contents of the file to be uploaded, preallocating it
     prepRecvFileRaw();
+    preallocUploadFile();
+    initStreamingIO(_stream->tmpFileDscr, _stream->remFileInfo->meta->fileSizeRaw);
+
+    // If the content store is enabled, digest the file's contents as they are received
+    _stream->contentMDCtx = _contentStore.initDigest(*_stream->tmpFileAbsPath, _stream->rawOffset);
 
     LOG_INFO("[" + *_connMgr._name + "] Upload of file \""
-             + _remFileInfo->fileName + "\" confirmed, awaiting "
-             "the file's raw contents (" + _remFileInfo->meta->fileSizeStr + ")")
+             + _stream->remFileInfo->fileName + "\" confirmed, awaiting "
+             "the file's raw contents (" + _stream->remFileInfo->meta->fileSizeStr + ")")
    }
  }
 
 
 /**
- * @brief  'UPLOAD' operation raw file contents callback, which:\n\n
- *            1) If the file being uploaded has not been completely received yet, decrypts its received raw
- *               bytes and writes them into the session's temporary file in the user's temporary directory\n\n
- *            2) If the file being uploaded has been completely received, verifies its trailing integrity
- *               tag, moves the temporary into the associated main file in the user's storage pool, sets
- *               its last modified time to the one specified in the '_remFileInfo' object, notifies the
- *               success of the upload operation to the client and resets the server session manager state
- * @param  recvBytes The number of bytes received in the associated connection manager's primary buffer
- * @throws ERR_FILE_WRITE_FAILED          Error in writing to the temporary file
- * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
- * @throws ERR_NON_POSITIVE_BUFFER_SIZE   The ciphertext block size is non-positive (probable overflow)
- * @throws ERR_OSSL_EVP_DECRYPT_UPDATE    EVP_CIPHER decrypt update failed
- * @throws ERR_OSSL_SET_TAG_FAILED        Error in setting the expected file integrity tag
- * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED File integrity verification failed
- * @throws ERR_SESS_FILE_CLOSE_FAILED     Error in closing the temporary file
- * @throws ERR_SESS_FILE_RENAME_FAILED    Error in moving the temporary file to the main directory
- * @throws ERR_SESS_FILE_META_SET_FAILED  Error in setting the main file's last modification time
- * @throws ERR_OSSL_EVP_ENCRYPT_INIT      EVP_CIPHER encrypt initialization failed
- * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE    EVP_CIPHER encrypt update failed
- * @throws ERR_OSSL_EVP_ENCRYPT_FINAL     EVP_CIPHER encrypt final failed
- * @throws ERR_OSSL_GET_TAG_FAILED        Error in retrieving the resulting integrity tag
- * @throws ERR_PEER_DISCONNECTED          The connection peer disconnected during the send()
- * @throws ERR_SEND_FAILED                send() fatal error
- * @throws ERR_SESS_INTERNAL_ERROR        Failed to close or move the uploaded temporary
- *                                        file or NULL session attributes
+ * @brief  'UPLOAD' operation 'UPLOAD_DIGEST' session message callback, which if a file with the same name of
+ *         the one to be uploaded does not exist in the user's storage pool and the content store holds the object
+ *         of its contents which is already referenced by the user's storage pool, links such object as the
+ *         file and completes the upload without its raw contents being transferred, otherwise responding to
+ *         the upload request as usual
+ * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid 'SessMsgUploadDigest' message length
+ * @throws ERR_SESS_INTERNAL_ERROR      Failed to open the linked file for its synchronization
+ * @throws ERR_SESS_NO_SPACE            Not enough storage space for the file to be uploaded
+ * @throws ERR_SESS_FILE_OPEN_FAILED    Failed to open the temporary file
+ *                                      descriptor in write-byte mode
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SrvSessMgr::uploadDigestCallback()
+ {
+  unsigned char digest[FILE_DIGEST_SIZE];  // The digest of the contents of the file to be uploaded
+  std::string   objPath;                   // The path of the object of the file's contents
+
+  // Load the digest of the contents of the file to be uploaded
+  loadSessMsgUploadDigest(digest);
+
+  // If a file with the same name does not exist in the user's storage pool and the object of the
+  // file's contents, whose last modification time is part of its key, is already referenced by
+  // the user's storage pool, link the object as the file in place of receiving its contents
+  objPath = _contentStore.getObjPath(digest, _stream->remFileInfo->meta->lastModTimeRaw);
+  if(_stream->mainFileInfo == nullptr && _contentStore.isHeld(objPath, *_mainDirAbsPath)
+     && _contentStore.linkObj(objPath, *_stream->mainFileAbsPath))
+   {
+    LOG_INFO("[" + *_connMgr._name + "] File \"" + _stream->remFileInfo->fileName + "\" ("
+             + _stream->remFileInfo->meta->fileSizeStr + ") deduplicated from the content store")
+    commitUpload();
+    return;
+   }
+
+  // Otherwise, respond to the upload request as usual
+  respondUploadReq();
+ }
+
+
+/**
+ * @brief  'UPLOAD' operation 'DELTA_CONFIRM' session message callback, confirming the overwriting of the
+ *         existing file with the one to be uploaded as its delta against the file, whose blocks' signatures
+ *         are then computed and sent to the client by the send handler (see the signUploadBase() method),
+ *         where delta uploads are eligible only for files which are not authenticated only, whose upload is
+ *         not resumed and both of whose versions are at least FILE_DELTA_MIN_SIZE bytes, with the existing
+ *         one being at most FILE_DELTA_MAX_SIZE bytes
+ * @throws ERR_SESS_UNEXPECTED_MESSAGE  The upload is not eligible for being carried out as a delta
+ * @throws ERR_SESS_INTERNAL_ERROR      Failed to open the existing file
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
  */
-void SrvSessMgr::uploadRecvRawCallback(size_t recvBytes)
+void SrvSessMgr::uploadDeltaConfCallback()
  {
-  // fwrite() return, representing the number of bytes written
-  // from the secondary connection buffer into the temporary file
-  size_t fwriteRet;
+  int baseFd;  // The file descriptor of the existing file the delta is computed against
+
+  // Assert the upload to be eligible for being carried out as a delta
+  if(_stream->authOnly || _stream->rawOffset != 0 ||
+     _stream->mainFileInfo->meta->fileSizeRaw < FILE_DELTA_MIN_SIZE ||
+     _stream->mainFileInfo->meta->fileSizeRaw > FILE_DELTA_MAX_SIZE ||
+     _stream->remFileInfo->meta->fileSizeRaw < FILE_DELTA_MIN_SIZE)
+   sendSrvSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'DELTA_CONFIRM' session message received for "
+                                                    "file \"" + _stream->remFileInfo->fileName + "\" "
+                                                    "not eligible for a delta upload");
+
+  // Open the existing file, which remains readable through its descriptor
+  // once the uploaded file has atomically replaced it in the storage pool
+  baseFd = open(_stream->mainFileAbsPath->c_str(), O_RDONLY);
+  if(baseFd == -1)
+   sendSrvSessSignalMsg(ERR_INTERNAL_ERROR, "Failed to open file \"" + *_stream->mainFileAbsPath
+                                            + "\" for its delta upload (" + ERRNO_DESC + ")");
+
+  // Divide the existing file into blocks and set the stream to sign them
+  // as the connection becomes writable (see the signUploadBase() method)
+  _stream->fileDelta = new FileDelta(baseFd, _stream->mainFileInfo->meta->fileSizeRaw);
+  _stream->opStep    = SIGNING_BASE;
+
+  LOG_INFO("[" + *_connMgr._name + "] Upload of file \"" + _stream->remFileInfo->fileName + "\" confirmed "
+           "as a delta, signing its " + std::to_string(_stream->fileDelta->getNumBlocks())
+           + " blocks of " + std::to_string(_stream->fileDelta->getBlockSize()) + " bytes")
+ }
+
 
+/**
+ * @brief  Computes a step of the signatures of the blocks of the existing file the current stream's delta upload
+ *         is computed against, which is called by the send handler as the connection becomes writable so that
+ *         signing large files does not stall the server's main loop, sending the signatures to the client
+ *         once all of them have been computed
+ * @throws ERR_SESS_FILE_READ_FAILED    Error in reading the existing file
+ * @throws ERR_OSSL_EVP_MD_CTX_NEW      EVP_MD context creation failed
+ * @throws ERR_OSSL_EVP_DIGEST_INIT     EVP_MD digest initialization failed
+ * @throws ERR_OSSL_EVP_DIGEST_UPDATE   EVP_MD digest update failed
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL    EVP_MD digest final failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SrvSessMgr::signUploadBase()
+ {
+  // Compute the signatures of the existing file's next blocks
+  if(!_stream->fileDelta->computeSigsStep())
+   {
+    sendSessSignalMsg(ERR_INTERNAL_ERROR);
+    THROW_SESS_EXCP(ERR_SESS_FILE_READ_FAILED, *_stream->mainFileAbsPath, ERRNO_DESC);
+   }
+
+  // Once all blocks have been signed, send their signatures
+  // to the client and await the delta of the file to be uploaded
+  if(_stream->fileDelta->sigsComputed())
+   {
+    sendSessMsgDeltaSigs();
+    _stream->opStep = WAITING_CONF;
+
+    LOG_DEBUG("[" + *_connMgr._name + "] Sent the signatures of the blocks of file \""
+              + _stream->remFileInfo->fileName + "\"")
+   }
+ }
+
+
+/**
+ * @brief  'UPLOAD' operation 'UPLOAD_DELTA' session message callback, preparing the server session manager
+ *         to receive the delta of the file to be uploaded, which is applied as it is received to rebuild
+ *         the file in its temporary file, where as such a file cannot be verified until its whole delta
+ *         has been applied its upload is not preserved as a partial upload should it be interrupted
+ * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid 'SessMsgUploadDelta' message length or delta size
+ * @throws ERR_SESS_NO_SPACE            Not enough storage space for the file to be uploaded
+ * @throws ERR_SESS_FILE_OPEN_FAILED    Failed to open the temporary file
+ *                                      descriptor in write-byte mode
+ * @throws ERR_OSSL_EVP_MD_CTX_NEW      EVP_MD context creation failed
+ * @throws ERR_OSSL_EVP_DIGEST_INIT     EVP_MD digest initialization failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SrvSessMgr::uploadDeltaCallback()
+ {
+  // Load the size of the file's delta and the digest of its contents
+  loadSessMsgUploadDelta(_stream->deltaDigest);
+
+  // The rebuilt file is not preserved as a partial upload
+  delete _stream->resumeFileAbsPath;
+  _stream->resumeFileAbsPath = nullptr;
+
+  // Prepare the server session manager to receive the file's delta, preallocating
+  // the file to be rebuilt, and prepare to apply the delta as it is received
+  prepRecvFileRaw();
+  preallocUploadFile();
+  _stream->fileDelta->startApply(_stream->tmpFileDscr, _stream->remFileInfo->meta->fileSizeRaw);
+
+  LOG_INFO("[" + *_connMgr._name + "] Awaiting the delta of file \"" + _stream->remFileInfo->fileName
+           + "\" (" + std::to_string(_stream->rawLength) + " bytes for " + _stream->remFileInfo->meta->fileSizeStr + ")")
+ }
+
+
+/**
+ * @brief  'UPLOAD' operation 'FILE_SEGMENT' session message callback, validating the announced
+ *         file segment's sizes and setting the associated connection manager to receive its raw
+ *         contents (chunks' sizes table, ciphertexts and integrity tags) into the primary buffer
+ * @throws ERR_SESSABORT_INVALID_FILE_SEGMENT The stream is not expecting a file segment or
+ *                                            the announced segment sizes are invalid
+ * @throws ERR_SESSABORT_INVALID_KEY_EPOCH    Invalid announced segment key epoch
+ */
+void SrvSessMgr::uploadSegmentCallback()
+ {
+  // Read and validate the announced file segment's plaintext and wire sizes and key epoch
+  _recvSegSize = loadSessMsgFileSegment(_stream->rawBytesRem, _recvWireSize, _recvKeyEpoch);
+
+  // Set the associated connection manager to receive the segment's raw contents
+  _connMgr._recvMode = ConnMgr::RECV_RAW;
+  _connMgr._recvBlockSize = _recvWireSize;
+ }
+
+
+/**
+ * @brief  'UPLOAD' operation raw file contents callback, which:\n\n
+ *            1) If the current segment of the file being uploaded has been completely received, verifies
+ *               and decrypts its chunks and writes them into the stream's temporary file in the user's
+ *               temporary directory (otherwise waiting for its additional bytes)\n\n
+ *            2) If the file being uploaded has been completely received, moves the temporary into the
+ *               associated main file in the user's storage pool, sets its last modified time to the
+ *               one specified in the 'remFileInfo' object and, depending on the server's durability
+ *               mode, either notifies the success of the upload operation to the client and resets
+ *               the stream state or adds the upload to the group commit making it durable
+ * @throws ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED A chunk other than the file's last
+ *                                                failed its integrity verification
+ * @throws ERR_FILE_WRITE_FAILED                  Error in writing to the temporary file
+ * @throws ERR_AESGCMMGR_INVALID_STATE            Invalid AES_128_GCM manager state
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE           The ciphertext block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_DECRYPT_INIT              EVP_CIPHER decrypt initialization failed
+ * @throws ERR_OSSL_EVP_DECRYPT_UPDATE            EVP_CIPHER decrypt update failed
+ * @throws ERR_OSSL_SET_TAG_FAILED                Error in setting the expected chunk integrity tag
+ * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED         The file's last chunk failed its integrity verification
+ * @throws ERR_SESS_FILE_CLOSE_FAILED             Error in closing the temporary file
+ * @throws ERR_SESS_FILE_RENAME_FAILED            Error in moving the temporary file to the main directory
+ * @throws ERR_SESS_FILE_META_SET_FAILED          Error in setting the main file's last modification time
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT              EVP_CIPHER encrypt initialization failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE            EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL             EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED                Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED                  The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED                        send() fatal error
+ * @throws ERR_SESS_INTERNAL_ERROR                Failed to close or move the uploaded temporary
+ *                                                file or NULL session attributes
+ */
+void SrvSessMgr::uploadRecvRawCallback()
+ {
 #ifdef DEBUG_MODE
   // The file's current upload progress discretized between 0-100%
   unsigned char currUploadProg;
 #endif
 
-  /* -------------------------------- File Upload Loop -------------------------------- */
+  // If the current segment of the file being uploaded has not been completely
+  // received yet in the primary connection buffer, wait for its additional bytes
+  if(_connMgr._priBufInd != _connMgr._recvBlockSize)
+   return;
 
-  // If the file being uploaded has not been completely received yet
-  if(_rawBytesRem > 0)
-   {
-    // Decrypted the received file raw contents from
-    // the primary into the secondary connection buffer
-    _aesGCMMgr.decryptAddCT(&_connMgr._priBuf[0], (int)recvBytes, &_connMgr._secBuf[0]);
+  /* ---------------------------- File Segment Reception ---------------------------- */
 
-    // Write the decrypted file contents from the secondary buffer into the temporary file
-    fwriteRet = fwrite(_connMgr._secBuf, sizeof(char), recvBytes, _tmpFileDscr);
+  // Verify and decrypt the received segment, writing its plaintext into the
+  // stream's temporary file and preparing to receive the next session message
+  recvFileSegment(_recvSegSize, _recvWireSize, _recvKeyEpoch);
 
-    // Writing into the temporary file less bytes than the ones received into the
-    // primary connection buffer is a critical error that in the current session state
-    // cannot be notified to the client and so require its connection to be dropped
-    if(fwriteRet < recvBytes)
-     THROW_EXEC_EXCP(ERR_FILE_WRITE_FAILED,"file: " + *_tmpFileAbsPath + "\", " + *_connMgr._name +
-                                           "\" upload operation aborted","written " + std::to_string(fwriteRet)
-                                           + " < recvBytes = " + std::to_string(recvBytes) + " bytes");
+  // If digested, update the digest of the file's contents with the segment's plaintext, where
+  // a failure only prevents the file from being deduplicated in the content store
+  if(_stream->contentMDCtx != nullptr && EVP_DigestUpdate(_stream->contentMDCtx, _connMgr._secBuf, _recvSegSize) != 1)
+   {
+    LOG_EXEC_CODE(ERR_OSSL_EVP_DIGEST_UPDATE, OSSL_ERR_DESC);
+    EVP_MD_CTX_free(_stream->contentMDCtx);
+    _stream->contentMDCtx = nullptr;
+   }
 
-    // Update the number of remaining file of the file being uploaded
-    _rawBytesRem -= recvBytes;
+  // If the file is uploaded in streaming I/O mode, release the page cache used by its completed windows
+  // (where the segments of a file's delta do not map to the windows of the file being rebuilt)
+  if(_stream->fileDelta == nullptr)
+   advanceStreamingIO(_stream->tmpFileDscr, nullptr, _stream->remFileInfo->meta->fileSizeRaw,
+                      _stream->remFileInfo->meta->fileSizeRaw - _stream->rawBytesRem, _recvSegSize, true);
 
-    // In DEBUG_MODE, compute and log the file's current upload progress
+  // In DEBUG_MODE, compute and log the file's current upload progress
 #ifdef DEBUG_MODE
-    currUploadProg = (unsigned char)((float)(_remFileInfo->meta->fileSizeRaw - _rawBytesRem) /
-                                     (float)_remFileInfo->meta->fileSizeRaw * 100);
+  currUploadProg = (unsigned char)((float)(_stream->rawOffset + _stream->rawLength - _stream->rawBytesRem) /
+                                   (float)(_stream->rawOffset + _stream->rawLength) * 100);
 
-    LOG_DEBUG("[" + *_connMgr._name + "] File \"" + _remFileInfo->fileName + "\" (" + _remFileInfo->meta->fileSizeStr +
-              ") upload progress: " + std::to_string((int)currUploadProg) + "%")
+  LOG_DEBUG("[" + *_connMgr._name + "] File \"" + _stream->remFileInfo->fileName + "\" (" + _stream->remFileInfo->meta->fileSizeStr +
+            ") upload progress: " + std::to_string((int)currUploadProg) + "%")
 #endif
 
-    // If the file being uploaded has not been completely received yet, update the associated
-    // connection manager's expected data block size to its number of remaining bytes
-    if(_rawBytesRem > 0)
-     _connMgr._recvBlockSize = _rawBytesRem;
+  /* --------------------------- File Upload Finalization --------------------------- */
+
+  // If the file being uploaded has been completely received
+  if(_stream->rawBytesRem == 0)
+   {
+    // If the file was uploaded as a delta, verify the file rebuilt from it
+    if(_stream->fileDelta != nullptr && !_stream->fileDelta->finishApply(_stream->deltaDigest))
+     sendSrvSessSignalMsg(ERR_INTERNAL_ERROR,"File \"" + _stream->remFileInfo->fileName + "\" rebuilt "
+                                             "from its delta does not match the uploaded contents");
+
+    /*
+     * Finalize the uploaded file, whose chunks have all been verified, by:
+     *    1) Moving it from the temporary into the user's storage pool
+     *    2) Setting its last modified time to the one
+     *       specified in the 'remFileInfo' object
+     */
+    finalizeRecvFileRaw();
+
+    // If digested, deduplicate the uploaded file in the content store
+    if(_stream->contentMDCtx != nullptr || (_stream->fileDelta != nullptr && _contentStore.enabled()))
+     ingestUploadFile();
+
+    // Complete the upload
+    commitUpload();
+   }
+ }
 
-    // Otherwise, if the file has been completely received, set the associated connection
-    // manager's expected data block size to the size of an AES_128_GCM integrity tag
-    else
-     _connMgr._recvBlockSize = AES_128_GCM_TAG_SIZE;
 
-    // Reset the index of the most significant byte in the primary connection buffer
-    _connMgr._priBufInd = 0;
+/**
+ * @brief Deduplicates the current stream's uploaded file, which has been finalized in the user's storage pool,
+ *        in the content store by finalizing the digest of its contents (or, if it was uploaded as a delta,
+ *        by the digest of the rebuilt file), where failures, which only prevent the file from being
+ *        deduplicated, are logged
+ */
+void SrvSessMgr::ingestUploadFile()
+ {
+  unsigned char digest[FILE_DIGEST_SIZE];  // The digest of the uploaded file's contents
+
+  if(_stream->fileDelta != nullptr)
+   memcpy(digest, _stream->fileDelta->getDigest(), FILE_DIGEST_SIZE);
+  else if(EVP_DigestFinal_ex(_stream->contentMDCtx, digest, NULL) != 1)
+   {
+    LOG_EXEC_CODE(ERR_OSSL_EVP_DIGEST_FINAL, OSSL_ERR_DESC);
+    return;
    }
 
-  /* ------------------------ File Integrity Tag Verification ------------------------ */
+  // Replace the file with a link to the object of its contents or link it as such object, staging
+  // the link in the temporary file's path (which is free once the file has been finalized)
+  if(_contentStore.ingest(*_stream->mainFileAbsPath, *_stream->tmpFileAbsPath,
+                          _contentStore.getObjPath(digest, _stream->remFileInfo->meta->lastModTimeRaw)))
+   LOG_INFO("[" + *_connMgr._name + "] Uploaded file \"" + _stream->remFileInfo->fileName
+            + "\" deduplicated into the content store")
+ }
+
 
-  // Otherwise, if the file being uploaded has been fully received and so its
-  // integrity must be verified via the trailing AES_128_GCM integrity tag
+/**
+ * @brief  Completes the upload of the current stream's file, which has been finalized in the user's storage pool,
+ *         by either notifying the client of its completion or, if uploads must be made durable, adding it to the
+ *         group commit, which will notify its completion to the client once the file is synchronized to storage
+ * @throws ERR_SESS_INTERNAL_ERROR      Failed to open the uploaded file for its synchronization
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SrvSessMgr::commitUpload()
+ {
+  // If uploads must be made durable, add the upload to the group commit, which will
+  // notify its completion to the client once its file has been synchronized to storage
+  if(_groupCommit.enabled())
+   {
+    // Open a read-only file descriptor of the uploaded file for its synchronization, where
+    // the main file cannot be concurrently replaced as the server is single-threaded
+    int commitFd = open(_stream->mainFileAbsPath->c_str(), O_RDONLY);
+    if(commitFd == -1)
+     sendSrvSessSignalMsg(ERR_INTERNAL_ERROR, "Failed to open uploaded file \"" + *_stream->mainFileAbsPath
+                                              + "\" for its synchronization (" + ERRNO_DESC + ")");
+
+    _groupCommit.addUpload(_connMgr._csk, _stream->streamId, commitFd, *_mainDirAbsPath);
+    _stream->opStep = WAITING_COMMIT;
+   }
+
+  // Otherwise, directly notify the client that the file upload has been completed
   else
+   uploadComplete();
+ }
 
-   // If the complete integrity tag has not yet been received in
-   // the primary connection buffer, wait for its additional bytes
-   if(_connMgr._priBufInd != AES_128_GCM_TAG_SIZE)
-    return;
 
-   // Otherwise, if the file integrity tag has been fully received
-   else
-    {
-     /*
-      * Finalize the uploaded file by:
-      *    1) Verifying its integrity tag
-      *    2) Moving it from the temporary into the user's storage pool
-      *    3) Setting its last modified time to the one
-      *       specified in the '_remFileInfo' object
-      */
-     finalizeRecvFileRaw();
-
-     // Notify the client that the file upload has been completed successfully
-     sendSessSignalMsg(COMPLETED);
-
-     // Log the successful upload operation
-     LOG_INFO("[" + *_connMgr._name + "] File \"" + _remFileInfo->fileName + "\" ("
-              + _remFileInfo->meta->fileSizeStr + ") uploaded into the storage pool")
-
-     // Reset the server session state
-     resetSessState();
-    }
+/**
+ * @brief  Notifies the client that the file upload of the current stream has been completed
+ *         successfully, logging the successful upload operation and resetting the stream state
+ * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED              send() fatal error
+ */
+void SrvSessMgr::uploadComplete()
+ {
+  // Notify the client that the file upload has been completed successfully
+  sendSessSignalMsg(COMPLETED);
+
+  // Log the successful upload operation
+  LOG_INFO("[" + *_connMgr._name + "] File \"" + _stream->remFileInfo->fileName + "\" ("
+           + _stream->remFileInfo->meta->fileSizeStr + ") uploaded into the storage pool"
+           + (_stream->authOnly ? " (authenticated only)" : "")
+           + (_stream->fileDelta != nullptr ? " (as a delta of " + std::to_string(_stream->rawLength) + " bytes)" : "")
+           + (_connMgr._compress && _stream->xferRawBytes != 0 ? ", " + compressionStatsStr(_stream->xferRawBytes, _stream->xferWireBytes) : ""))
+
+  // Reset the stream state
+  resetStreamState();
  }
 
 
@@ -547,8 +1238,8 @@ void SrvSessMgr::uploadRecvRawCallback(size_t recvBytes)
  *               notification depending on whether the file to be downloaded is empty or not.
  * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid file name in the 'SessMsgFileName' message
  * @throws ERR_SESS_MAIN_FILE_IS_DIR    The file to be downloaded was found to be a directory (!)
- * @throws ERR_SESS_INTERNAL_ERROR      Failed to open the file descriptor
- *                                      of the file to be downloaded
+ * @throws ERR_SESS_INTERNAL_ERROR      Failed to open the file descriptor of the file to be downloaded
+ *                                      or the file is too large for the client (> 4GB - 1B)
  * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
@@ -561,15 +1252,15 @@ void SrvSessMgr::uploadRecvRawCallback(size_t recvBytes)
 void SrvSessMgr::downloadStartCallback()
  {
   // Retrieve the file name the client wants to download, also loading
-  // its associated absolute path into the '_mainFileAbsPath' attribute
+  // its associated absolute path into the 'mainFileAbsPath' attribute
   std::string fileName = std::move(loadMainSessMsgFileName());
 
   // Check whether the file the client wants to download exists in their storage
-  // pool by attempting to load its information into the '_mainFileInfo' attribute
+  // pool by attempting to load its information into the 'mainFileInfo' attribute
   checkLoadMainFileInfo();
 
   // If the file the client wants to download was not found in their storage pool
-  if(_mainFileInfo == nullptr)
+  if(_stream->mainFileInfo == nullptr)
    {
     // Notify the client that the file to be downloaded was not found
     sendSrvSessSignalMsg(FILE_NOT_EXISTS);
@@ -577,39 +1268,45 @@ void SrvSessMgr::downloadStartCallback()
     LOG_INFO("[" + *_connMgr._name + "] Attempting to download "
              "file \""+ fileName + "\" not existing in the storage pool")
 
-    // Reset the server session manager state and return
-    resetSessState();
+    // Reset the stream state and return
+    resetStreamState();
     return;
    }
 
   // Otherwise, if the file the client wants to download was found in their storage pool
   else
    {
+    // Files larger than 4GB - 1B cannot be downloaded by clients not supporting 64-bit file sizes
+    if(!_connMgr._largeFiles && _stream->mainFileInfo->meta->fileSizeRaw > FILE_UPLOAD_MAX_SIZE_LEGACY)
+     sendSrvSessSignalMsg(ERR_INTERNAL_ERROR,"The file to be downloaded (" + *_stream->mainFileAbsPath + ", " +
+                                             _stream->mainFileInfo->meta->fileSizeStr + ") is too large for a"
+                                             " client not supporting 64-bit file sizes");
+
     // If the file to be downloaded is empty
-    if(_mainFileInfo->meta->fileSizeRaw == 0)
+    if(_stream->mainFileInfo->meta->fileSizeRaw == 0)
      {
       // Set the server session manager to expect the client completion notification
-      _sessMgrOpStep = WAITING_COMPL;
+      _stream->opStep = WAITING_COMPL;
 
       LOG_INFO("[" + *_connMgr._name + "] Received download request of empty file"
-               " \"" + _mainFileInfo->fileName + "\", awaiting client completion")
+               " \"" + _stream->mainFileInfo->fileName + "\", awaiting client completion")
      }
 
     // Otherwise, if the file to be downloaded is NOT empty
     else
      {
       // Attempt to open the file to be downloaded in read-byte mode
-      _mainFileDscr = fopen(_mainFileAbsPath->c_str(), "rb");
-      if(!_mainFileDscr)
+      _stream->mainFileDscr = fopen(_stream->mainFileAbsPath->c_str(), "rb");
+      if(!_stream->mainFileDscr)
        sendSrvSessSignalMsg(ERR_INTERNAL_ERROR,"Failed to open the file descriptor of the"
-                            " main file to be downloaded (" + *_mainFileAbsPath + ")");
+                            " main file to be downloaded (" + *_stream->mainFileAbsPath + ")");
 
       // Set the server session manager to expect the client confirmation notification
-      _sessMgrOpStep = WAITING_CONF;
+      _stream->opStep = WAITING_CONF;
 
       LOG_INFO("[" + *_connMgr._name + "] Received download request"
-               " of file \"" + _mainFileInfo->fileName + "\" ("
-               + _mainFileInfo->meta->fileSizeStr + "), awaiting client confirmation")
+               " of file \"" + _stream->mainFileInfo->fileName + "\" ("
+               + _stream->mainFileInfo->meta->fileSizeStr + "), awaiting client confirmation")
      }
 
     // Prepare a 'SessMsgFileInfo' session message of type 'FILE_EXISTS' containing
@@ -620,93 +1317,41 @@ void SrvSessMgr::downloadStartCallback()
 
 
 /**
- * @brief 'DOWNLOAD' operation 'CONFIRM' session message callback, sending the raw contents of
- *        the file to be downloaded and its resulting integrity tag to the client, and setting
- *        the server session manager to expect the client download completion notification
- * @throws ERR_FILE_WRITE_FAILED              Error in reading from the main file
- * @throws ERR_SESSABORT_UNEXPECTED_FILE_SIZE The sent file raw contents differ from its expected size
- * @throws ERR_AESGCMMGR_INVALID_STATE        Invalid AES_128_GCM manager state
- * @throws ERR_OSSL_EVP_ENCRYPT_INIT          EVP_CIPHER encrypt initialization failed
- * @throws ERR_NON_POSITIVE_BUFFER_SIZE       The plaintext block size is non-positive (probable overflow)
- * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE        EVP_CIPHER encrypt update failed
- * @throws ERR_OSSL_EVP_ENCRYPT_FINAL         EVP_CIPHER encrypt final failed
- * @throws ERR_OSSL_GET_TAG_FAILED            Error in retrieving the resulting integrity tag
- * @throws ERR_SEND_OVERFLOW                  Attempting to send a number of bytes > _priBufSize
- * @throws ERR_PEER_DISCONNECTED              The connection peer disconnected during the send()
- * @throws ERR_SEND_FAILED                    send() fatal error
+ * @brief 'DOWNLOAD' operation 'CONFIRM' or 'DOWNLOAD_RANGE' session message callback, preparing the stream to
+ *        send the raw contents of the file to be downloaded, or of its byte range the client requested, (mapped
+ *        into memory if possible and in streaming I/O mode if they are large enough), whose segments are then
+ *        sent to the client as the connection socket becomes writable, interleaved with the ones of the
+ *        session's other streams (see the srvSessSendHandler() method)
+ * @throws ERR_SESS_INTERNAL_ERROR Failed to seek the file to the start of the requested byte range
  */
 void SrvSessMgr::downloadConfSendFileCallback()
  {
-  // fread() return, representing the number of bytes read
-  // from main file into the secondary connection buffer
-  size_t freadRet;
-
-  // The total number of file bytes sent to the client
-  size_t totBytesSent = 0;
-
-#ifdef DEBUG_MODE
-  // The file's current download progress discretized between 0-100%
-  unsigned char currDownloadProg;
-#endif
-
-  // Initialize the file encryption operation
-  _aesGCMMgr.encryptInit();
-
-  // ------------------------------- File Download Loop ------------------------------- //
-
-  do
-   {
-    // Read the file raw contents into the secondary buffer size (possibly filling it)
-    freadRet = fread(_connMgr._secBuf, sizeof(char), _connMgr._secBufSize, _mainFileDscr);
-
-    // An error occurred in reading the file raw contents is a critical
-    // error that in the current session state cannot be notified
-    // to the client and so require their connection to be dropped
-    if(ferror(_mainFileDscr))
-     THROW_EXEC_EXCP(ERR_FILE_READ_FAILED,"file: " + *_mainFileAbsPath + "\", "
-                     + *_connMgr._name + "\" upload operation aborted", ERRNO_DESC);
-
-    // If bytes were read from the file into the secondary connection buffer
-    if(freadRet > 0)
-     {
-      // Encrypt the file raw contents from the secondary into the primary connection buffer
-      _aesGCMMgr.encryptAddPT(&_connMgr._secBuf[0], (int)freadRet, &_connMgr._priBuf[0]);
-
-      // Send the encrypted file contents to the client
-      _connMgr.sendRaw(freadRet);
-
-      // Update the total number of bytes sent to the client
-      totBytesSent += freadRet;
-
-      // In DEBUG_MODE, compute and log the file's current download progress
-#ifdef DEBUG_MODE
-      currDownloadProg = (unsigned char)((float)totBytesSent /
-                         (float)_mainFileInfo->meta->fileSizeRaw * 100);
-
-      LOG_DEBUG("[" + *_connMgr._name + "] File \"" + _mainFileInfo->fileName +
-                "\" (" + _mainFileInfo->meta->fileSizeStr + ") download progress: "
-                + std::to_string((int)currDownloadProg) + "%")
-#endif
-     }
-   } while(!feof(_mainFileDscr)); // While the main file has not been completely read
-
-  // ----------------------------- End File Download Loop ----------------------------- //
-
-  // Having sent to the client  a number of bytes different from the file
-  // size is a critical error that in the current session state cannot be
-  // notified to the client and so require their connection to be dropped
-  if(totBytesSent != _mainFileInfo->meta->fileSizeRaw)
-   THROW_EXEC_EXCP(ERR_SESSABORT_UNEXPECTED_FILE_SIZE, "file: \"" + _mainFileInfo->fileName + "\", \""
-                                                       + *_connMgr._name + "\" upload operation aborted",
-                                                       std::to_string(totBytesSent) + " != "
-                                                       + std::to_string(_mainFileInfo->meta->fileSizeRaw));
-
-  // Finalize the file download operation by sending
-  // the resulting integrity tag to the client
-  sendRawTag();
-
-  // Set the server session manager to expect the client download's completion
-  _sessMgrOpStep = WAITING_COMPL;
+  // Prepare the stream to send the file's raw contents,
+  // in streaming I/O mode if they are large enough
+  prepSendFileRaw();
+  initStreamingIO(_stream->mainFileDscr, (long long)(_stream->rawOffset + _stream->rawLength));
+
+  // Map the file into memory, so that its segments are encrypted directly from the page cache
+  mapDownloadFile();
+
+  // If the file is not mapped, position its descriptor at the start of the requested byte range
+  // (which must follow setting its buffering mode in the streaming I/O mode)
+  if(_stream->mainFileMap == nullptr && _stream->rawOffset != 0 &&
+     fseeko(_stream->mainFileDscr, (off_t)_stream->rawOffset, SEEK_SET) != 0)
+   sendSrvSessSignalMsg(ERR_INTERNAL_ERROR,"Failed to seek file \"" + *_stream->mainFileAbsPath + "\" to offset "
+                                           + std::to_string(_stream->rawOffset) + " (" + ERRNO_DESC + ")");
+
+  // Set the stream to send the file's raw contents
+  _stream->opStep = SENDING_RAW;
+
+  if(_stream->rawLength == (uint64_t)_stream->mainFileInfo->meta->fileSizeRaw)
+   LOG_INFO("[" + *_connMgr._name + "] Download of file \"" + _stream->mainFileInfo->fileName + "\" ("
+            + _stream->mainFileInfo->meta->fileSizeStr + ") confirmed, sending the file's raw contents")
+  else
+   LOG_INFO("[" + *_connMgr._name + "] Download of bytes " + std::to_string(_stream->rawOffset) + "-"
+            + std::to_string(_stream->rawOffset + _stream->rawLength) + " of file \""
+            + _stream->mainFileInfo->fileName + "\" (" + _stream->mainFileInfo->meta->fileSizeStr
+            + ") confirmed, sending the file's raw contents")
  }
 
 
@@ -718,15 +1363,17 @@ void SrvSessMgr::downloadComplCallback()
  {
   // Log the success of the download operation depending
   // on whether the downloaded file is empty or not
-  if(_mainFileInfo->meta->fileSizeRaw == 0)
+  if(_stream->mainFileInfo->meta->fileSizeRaw == 0)
    LOG_INFO("[" + *_connMgr._name + "] Empty file \""
-            + _mainFileInfo->fileName + "\" downloaded from the storage pool")
+            + _stream->mainFileInfo->fileName + "\" downloaded from the storage pool")
   else
-   LOG_INFO("[" + *_connMgr._name + "] File \"" + _mainFileInfo->fileName + "\" ("
-            + _mainFileInfo->meta->fileSizeStr + ") downloaded from the storage pool")
+   LOG_INFO("[" + *_connMgr._name + "] File \"" + _stream->mainFileInfo->fileName + "\" ("
+            + _stream->mainFileInfo->meta->fileSizeStr + ") downloaded from the storage pool"
+            + (_stream->authOnly ? " (authenticated only)" : "")
+            + (_connMgr._compress ? ", " + compressionStatsStr(_stream->xferRawBytes, _stream->xferWireBytes) : ""))
 
-  // Reset the server session manager state
-  resetSessState();
+  // Reset the stream state
+  resetStreamState();
  }
 
 
@@ -755,15 +1402,15 @@ void SrvSessMgr::downloadComplCallback()
 void SrvSessMgr::deleteStartCallback()
  {
   // Retrieve the file name the client wants to delete, also loading
-  // its associated absolute path into the '_mainFileAbsPath' attribute
+  // its associated absolute path into the 'mainFileAbsPath' attribute
   std::string fileName = std::move(loadMainSessMsgFileName());
 
   // Check whether the file the client wants to delete exists in their storage
-  // pool by attempting to load its information into the '_mainFileInfo' attribute
+  // pool by attempting to load its information into the 'mainFileInfo' attribute
   checkLoadMainFileInfo();
 
   // If the file the client wants to delete was not found in their storage pool
-  if(_mainFileInfo == nullptr)
+  if(_stream->mainFileInfo == nullptr)
    {
     // Notify the client that the file was not found
     sendSrvSessSignalMsg(FILE_NOT_EXISTS);
@@ -771,8 +1418,8 @@ void SrvSessMgr::deleteStartCallback()
     LOG_INFO("[" + *_connMgr._name + "] Attempting to delete "
              "file \""+ fileName + "\" not existing in the storage pool")
 
-    // Reset the server session manager state and return
-    resetSessState();
+    // Reset the stream state and return
+    resetStreamState();
     return;
    }
 
@@ -784,10 +1431,10 @@ void SrvSessMgr::deleteStartCallback()
     sendSessMsgFileInfo(FILE_EXISTS);
 
     // Set the server session manager to expect the client confirmation notification
-    _sessMgrOpStep = WAITING_CONF;
+    _stream->opStep = WAITING_CONF;
 
     LOG_INFO("[" + *_connMgr._name + "] Received delete request of file \""
-             + _mainFileInfo->fileName + "\" (" + _mainFileInfo->meta->fileSizeStr +
+             + _stream->mainFileInfo->fileName + "\" (" + _stream->mainFileInfo->meta->fileSizeStr +
              "), awaiting client confirmation")
    }
  }
@@ -809,19 +1456,19 @@ void SrvSessMgr::deleteStartCallback()
 void SrvSessMgr::deleteConfCallback()
  {
   // Attempt to delete the main file
-  if(remove(_mainFileAbsPath->c_str()) == -1)
-   sendSrvSessSignalMsg(ERR_INTERNAL_ERROR, "Failed to delete file \"" + *_mainFileAbsPath +
+  if(remove(_stream->mainFileAbsPath->c_str()) == -1)
+   sendSrvSessSignalMsg(ERR_INTERNAL_ERROR, "Failed to delete file \"" + *_stream->mainFileAbsPath +
                                             "\" (reason: " + ERRNO_DESC + ")");
 
   // Notify the client that the file has been successfully deleted
   sendSrvSessSignalMsg(COMPLETED);
 
   // Log the successful delete operation
-  LOG_INFO("[" + *_connMgr._name + "] File \"" + _mainFileInfo->fileName +
-           "\" (" + _mainFileInfo->meta->fileSizeStr + ") deleted from the storage pool")
+  LOG_INFO("[" + *_connMgr._name + "] File \"" + _stream->mainFileInfo->fileName +
+           "\" (" + _stream->mainFileInfo->meta->fileSizeStr + ") deleted from the storage pool")
 
-  // Reset the server session state
-  resetSessState();
+  // Reset the stream state
+  resetStreamState();
  }
 
 
@@ -859,7 +1506,7 @@ void SrvSessMgr::renameStartCallback()
 
   // Retrieve the candidate old and new name of the file to be
   // renamed, also loading their associated absolute paths into the
-  // '_mainFileAbsPath' and '_tmpFileAbsPath' attributes respectively
+  // 'mainFileAbsPath' and 'tmpFileAbsPath' attributes respectively
   loadSessMsgFileRename(&oldFilename,&newFilename);
 
   // Initialize the absolute paths associated with the old and the new file names
@@ -873,12 +1520,12 @@ void SrvSessMgr::renameStartCallback()
   */
 
   // Check whether the file the client wants to rename exists in their storage
-  // pool by attempting to load its information into the '_mainFileInfo' attribute
-  _mainFileAbsPath = &oldFileNameAbsPath;
+  // pool by attempting to load its information into the 'mainFileInfo' attribute
+  _stream->mainFileAbsPath = &oldFileNameAbsPath;
   checkLoadMainFileInfo();
 
   // If the file the client wants to rename was not found in their storage pool
-  if(_mainFileInfo == nullptr)
+  if(_stream->mainFileInfo == nullptr)
    {
     // Notify the client that the file to be renamed was not found
     sendSrvSessSignalMsg(FILE_NOT_EXISTS);
@@ -891,17 +1538,17 @@ void SrvSessMgr::renameStartCallback()
   else
    {
     // Delete the information on the file the client wants to rename
-    delete _mainFileInfo;
+    delete _stream->mainFileInfo;
 
     // Check whether a file with the same name of the one the user wants
     // to rename the file to exists in their storage pool by attempting
-    // to load its information into the '_mainFileInfo' attribute
-    _mainFileAbsPath = &newFileNameAbsPath;
+    // to load its information into the 'mainFileInfo' attribute
+    _stream->mainFileAbsPath = &newFileNameAbsPath;
     checkLoadMainFileInfo();
 
     // If a file with the same name of the one the user wants
     // to rename the file to exists in their storage pool
-    if(_mainFileInfo != nullptr)
+    if(_stream->mainFileInfo != nullptr)
      {
       // Prepare and send a 'SessMsgFileInfo' session message of type 'FILE_EXISTS'
       // containing the information on the file with the same name of the
@@ -930,13 +1577,13 @@ void SrvSessMgr::renameStartCallback()
    }
 
   // Delete the old and new file names strings
-  // and reset the '_mainFileAbsPath' attribute
+  // and reset the 'mainFileAbsPath' attribute
   delete oldFilename;
   delete newFilename;
-  _mainFileAbsPath = nullptr;
+  _stream->mainFileAbsPath = nullptr;
 
-  // Reset the server session manager state and return
-  resetSessState();
+  // Reset the stream state and return
+  resetStreamState();
  }
 
 
@@ -951,9 +1598,9 @@ void SrvSessMgr::renameStartCallback()
  *               expect their completion notification.
  * @throws ERR_DIR_OPEN_FAILED                The user's storage pool was not found (!)
  * @throws ERR_SESS_FILE_READ_FAILED          Error in reading from the user's storage pool
- * @throws ERR_SESS_DIR_INFO_OVERFLOW         The storage pool information size exceeds 4GB
+ * @throws ERR_SESS_DIR_INFO_OVERFLOW         The storage pool information size overflows a 64-bit integer
  * @throws ERR_SESS_INTERNAL_ERROR            The serialized size of the
- *                                            user's storage pool exceeds 4GB
+ *                                            user's storage pool exceeds the connection's maximum
  * @throws ERR_AESGCMMGR_INVALID_STATE        Invalid AES_128_GCM manager state
  * @throws ERR_NON_POSITIVE_BUFFER_SIZE       The AAD block size is non-positive (probable overflow)
  * @throws ERR_OSSL_EVP_ENCRYPT_INIT          EVP_CIPHER encrypt initialization failed
@@ -969,9 +1616,9 @@ void SrvSessMgr::renameStartCallback()
 void SrvSessMgr::listStartCallback()
  {
   // Attempt to build a snapshot of the user storage
-  // pool's contents into the '_mainDirInfo' attribute
+  // pool's contents into the 'mainDirInfo' attribute
   try
-   { _mainDirInfo = new DirInfo(_mainDirAbsPath); }
+   { _stream->mainDirInfo = new DirInfo(_mainDirAbsPath); }
   catch(sessErrExcp& poolDirExcp)
    {
     // Notify the client of the internal error
@@ -983,9 +1630,9 @@ void SrvSessMgr::listStartCallback()
 
   /*
   // LOG: User storage pool contents and information
-  _mainDirInfo->printDirContents();
-  std::cout << "N° files = " << _mainDirInfo->numFiles << std::endl;
-  std::cout << "Pool contents' raw size = " << _mainDirInfo->dirRawSize << std::endl;
+  _stream->mainDirInfo->printDirContents();
+  std::cout << "N° files = " << _stream->mainDirInfo->numFiles << std::endl;
+  std::cout << "Pool contents' raw size = " << _stream->mainDirInfo->dirRawSize << std::endl;
   */
 
   /*
@@ -995,30 +1642,31 @@ void SrvSessMgr::listStartCallback()
    * attribute storing the file name length in the 'PoolFileInfo' struct
    */
 
-  // Assert the serialized size of the user's storage
-  // pool not to overflow an unsigned integer
-  if(_mainDirInfo->dirRawSize > UINT_MAX - _mainDirInfo->numFiles)
+  // Assert the serialized size of the user's storage pool not to overflow the size announced in the
+  // 'SessMsgPoolSize' message, which is a 32-bit integer on connections not supporting 64-bit sizes
+  if(_stream->mainDirInfo->dirRawSize > (_connMgr._largeFiles ? UINT64_MAX : UINT32_MAX) - _stream->mainDirInfo->numFiles ||
+     (!_connMgr._largeFiles && _stream->mainDirInfo->numFiles > UINT32_MAX))
    sendSrvSessSignalMsg(ERR_INTERNAL_ERROR,"Storage pool serialized contents' size"
                                            "overflow (raw contents' size = "
-                                           + std::to_string(_mainDirInfo->dirRawSize) +
-                                           ", numFiles = " + std::to_string(_mainDirInfo->numFiles));
+                                           + std::to_string(_stream->mainDirInfo->dirRawSize) +
+                                           ", numFiles = " + std::to_string(_stream->mainDirInfo->numFiles));
 
   // Compute and write the serialized size of the user's
-  // storage pool in the '_rawBytesRem' attribute
-  _rawBytesRem = _mainDirInfo->dirRawSize + _mainDirInfo->numFiles;
+  // storage pool in the 'rawBytesRem' attribute
+  _stream->rawBytesRem = _stream->mainDirInfo->dirRawSize + _stream->mainDirInfo->numFiles;
 
   // Prepare and send a 'SessMsgPoolSize' session message of implicit 'POOL_SIZE' type
   // containing the serialized size of the user's storage pool and send it to the client
   sendSessMsgPoolSize();
 
   // If the user's storage pool is empty
-  if(_rawBytesRem == 0)
+  if(_stream->rawBytesRem == 0)
    {
     // Log that the user requested the contents of its empty storage pool
     LOG_INFO("[" + *_connMgr._name + "] Requested the empty storage pool's contents")
 
-    // Reset the session state and return
-    resetSessState();
+    // Reset the stream state and return
+    resetStreamState();
    }
 
   // Otherwise, if the user's storage pool is NOT empty
@@ -1029,10 +1677,10 @@ void SrvSessMgr::listStartCallback()
 
     // Set the server session manager to expect the
     // client pool contents' reception completion
-    _sessMgrOpStep = WAITING_COMPL;
+    _stream->opStep = WAITING_COMPL;
 
     LOG_INFO("[" + *_connMgr._name + "] Sent the requested storage pool's contents ("
-             + std::to_string(_mainDirInfo->numFiles) + " files), awaiting client confirmation")
+             + std::to_string(_stream->mainDirInfo->numFiles) + " files), awaiting client confirmation")
    }
  }
 
@@ -1068,12 +1716,12 @@ void SrvSessMgr::sendPoolRawContents()
   _connMgr._secBufInd = 0;
 
   // Initialize the pool raw contents' encryption operation
-  _aesGCMMgr.encryptInit();
+  _sendAESGCMMgr.encryptInit();
 
   // ------------------ Serialized Pool Contents Sending Cycle ------------------ //
 
   // For each file in the user's storage pool
-  for(const auto& poolFile : _mainDirInfo->dirFiles)
+  for(const auto& poolFile : _stream->mainDirInfo->dirFiles)
    {
     // If the index of the first available byte in the secondary
     // connection buffer is greater than the maximum index at which
@@ -1082,8 +1730,8 @@ void SrvSessMgr::sendPoolRawContents()
      {
       // Encrypt the pool's serialized contents from the
       // secondary into the primary connection buffer
-      _aesGCMMgr.encryptAddPT(&_connMgr._secBuf[0],
-                              (int)(_connMgr._secBufInd), &_connMgr._priBuf[0]);
+      _sendAESGCMMgr.encryptAddPT(&_connMgr._secBuf[0],
+                                  (int)(_connMgr._secBufInd), &_connMgr._priBuf[0]);
 
       // Send the encrypted serialized pool contents to the client
       _connMgr.sendRaw(_connMgr._secBufInd);
@@ -1120,7 +1768,7 @@ void SrvSessMgr::sendPoolRawContents()
    {
     // Encrypt the pool's serialized contents from the
     // secondary into the primary connection buffer
-    _aesGCMMgr.encryptAddPT(&_connMgr._secBuf[0], (int)(_connMgr._secBufInd), &_connMgr._priBuf[0]);
+    _sendAESGCMMgr.encryptAddPT(&_connMgr._secBuf[0], (int)(_connMgr._secBufInd), &_connMgr._priBuf[0]);
 
     // Send the encrypted serialized pool contents to the client
     _connMgr.sendRaw(_connMgr._secBufInd);
@@ -1134,14 +1782,20 @@ void SrvSessMgr::sendPoolRawContents()
   // Having sent the client a number of bytes different that the previously computed
   // serialized pool size is a critical error that in the current session state
   // cannot be notified to the client and so require their connection to be dropped
-  if(totBytesSent != _rawBytesRem)
+  if(totBytesSent != _stream->rawBytesRem)
    THROW_EXEC_EXCP(ERR_SESSABORT_UNEXPECTED_POOL_SIZE, "\"" + *_connMgr._name + "\" LIST operation"
                                                        " aborted", std::to_string(totBytesSent) +
-                                                       " != " + std::to_string(_rawBytesRem));
+                                                       " != " + std::to_string(_stream->rawBytesRem));
 
   // Finalize the serialized pool contents transmission
   // by sending the resulting integrity tag to the client
   sendRawTag();
+
+  // Account the serialized pool contents and their integrity tag, encrypted as a single AEAD operation,
+  // in the data protected by the current sending key, so that should they have brought it past its usage
+  // limits the key is ratcheted via a 'REKEY' message before the next session message is sent
+  _sendKeyBytes += totBytesSent + AES_128_GCM_TAG_SIZE;
+  _sendKeyOps++;
  }
 
 
@@ -1154,8 +1808,8 @@ void SrvSessMgr::listComplCallback()
   // Log the success of the 'LIST' operation
   LOG_INFO("[" + *_connMgr._name + "] Successfully received the storage pool's contents")
 
-  // Reset the server session state
-  resetSessState();
+  // Reset the stream state
+  resetStreamState();
  }
 
 
@@ -1167,10 +1821,24 @@ void SrvSessMgr::listComplCallback()
  * @param srvConnMgr A reference to the server connection manager parent object
  */
 SrvSessMgr::SrvSessMgr(SrvConnMgr& srvConnMgr)
-  : SessMgr(reinterpret_cast<ConnMgr&>(srvConnMgr),srvConnMgr._poolDir)
+  : SessMgr(reinterpret_cast<ConnMgr&>(srvConnMgr),srvConnMgr._poolDir,true,srvConnMgr._aesGCMPool), _sendCtBufs{nullptr, nullptr},
+    _sendCtBufSeq{_connMgr._zcSendSeq, _connMgr._zcSendSeq}, _sendCtBufInd(0), _sendStreamInd(0),
+    _recvSegSize(0), _recvWireSize(0), _recvKeyEpoch(0), _groupCommit(srvConnMgr._groupCommit),
+    _partialUploads(srvConnMgr._partialUploads), _resumeDirAbsPath(srvConnMgr._resumeDir),
+    _contentStore(srvConnMgr._contentStore)
  {}
 
-/* Same destructor of the SessMgr base class */
+
+/**
+ * @brief SrvSessMgr object destructor, unmapping the ciphertext buffers of the files being
+ *        downloaded without waiting for the kernel to release them from their zero-copy sends
+ */
+SrvSessMgr::~SrvSessMgr()
+ {
+  for(unsigned char* ctBuf : _sendCtBufs)
+   if(ctBuf != nullptr)
+    munmap(ctBuf, fileSegmentWireSize(FILE_SEGMENT_SIZE));
+ }
 
 /* ============================= OTHER PUBLIC METHODS ============================= */
 
@@ -1195,6 +1863,11 @@ void SrvSessMgr::srvSessMsgHandler()
  // session message in the connection's secondary buffer
  unwrapSessMsg();
 
+ // A 'REKEY' message, which may be received in any operation and step,
+ // is handled by ratcheting the session messages' receiving key
+ if(recvRekeyMsg())
+  return;
+
  // Interpret the contents of associated connection
  // manager's secondary buffer as a base session message
  SessMsg* sessMsg = reinterpret_cast<SessMsg*>(_connMgr._secBuf);
@@ -1204,6 +1877,15 @@ void SrvSessMgr::srvSessMsgHandler()
  _recvSessMsgLen = sessMsg->msgLen;
  _recvSessMsgType = sessMsg->msgType;
 
+ // A session message referring to a non-existing stream is attributed to a desynchronization
+ // between the connection peers and requires the connection to be reset
+ if(sessMsg->streamId >= SESS_MAX_STREAMS)
+  THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_STREAM, "Client: \"" + *_connMgr._name + "\", stream "
+                                                + std::to_string(sessMsg->streamId));
+
+ // Carry out the received session message on its stream
+ _stream = _streams[sessMsg->streamId];
+
  // If a signaling message type was received, assert the message
  // length to be equal to the size of a base session message
  if(isSessSignalingMsgType(_recvSessMsgType) && _recvSessMsgLen != sizeof(SessMsg))
@@ -1230,7 +1912,7 @@ void SrvSessMgr::srvSessMsgHandler()
    case FILE_DELETE_REQ:
    case FILE_RENAME_REQ:
    case FILE_LIST_REQ:
-    if(_sessMgrOp != IDLE)
+    if(_stream->op != IDLE)
      sendSrvSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE, "\"" + std::to_string(_recvSessMsgType) + "\" "
                                                        "operation-starting session message type received in"
                                                        " session operation \"" + sessMgrOpToStrUpCase() +
@@ -1239,16 +1921,65 @@ void SrvSessMgr::srvSessMsgHandler()
 
    /* ------------------------------ 'CONFIRM' Signaling Message Type ------------------------------ */
 
-   // A 'CONFIRM' signaling message type is allowed only in the 'UPLOAD',
-   // 'DOWNLOAD' and 'DELETE' operations with step 'WAITING_CONF'
+   // A 'CONFIRM' signaling message type is allowed only in the 'UPLOAD', 'DOWNLOAD'
+   // and 'DELETE' operations with step 'WAITING_CONF' (and not past a 'DELTA_CONFIRM')
    case CONFIRM:
-    if(!((_sessMgrOp == UPLOAD || _sessMgrOp == DOWNLOAD || _sessMgrOp == DELETE)
-         && _sessMgrOpStep == WAITING_CONF))
+    if(!((_stream->op == UPLOAD || _stream->op == DOWNLOAD || _stream->op == DELETE)
+         && _stream->opStep == WAITING_CONF && _stream->fileDelta == nullptr))
      sendSrvSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'CONFIRM' session message received in "
                                                       "session operation \"" + sessMgrOpToStrUpCase() +
                                                       "\", step " + sessMgrOpStepToStrUpCase());
     break;
 
+   /* --------------------------- 'DOWNLOAD_RANGE' Payload Message Type --------------------------- */
+
+   // A 'DOWNLOAD_RANGE' payload message type, which confirms a download of a byte range of its
+   // file, is allowed only in the 'DOWNLOAD' operation with step 'WAITING_CONF' and on
+   // connections where ranged downloads have been negotiated
+   case DOWNLOAD_RANGE:
+    if(!(_stream->op == DOWNLOAD && _stream->opStep == WAITING_CONF && _connMgr._rangedDownloads))
+     sendSrvSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'DOWNLOAD_RANGE' session message received in "
+                                                      "session operation \"" + sessMgrOpToStrUpCase() +
+                                                      "\", step " + sessMgrOpStepToStrUpCase());
+    break;
+
+   /* --------------------------- 'DELTA_CONFIRM' Signaling Message Type --------------------------- */
+
+   // A 'DELTA_CONFIRM' signaling message type, which confirms an upload to be carried out as a
+   // delta against the existing file, is allowed only in the 'UPLOAD' operation with step
+   // 'WAITING_CONF' (once) and on connections where delta uploads have been negotiated
+   case DELTA_CONFIRM:
+    if(!(_stream->op == UPLOAD && _stream->opStep == WAITING_CONF && _connMgr._deltaUploads
+         && _stream->fileDelta == nullptr))
+     sendSrvSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'DELTA_CONFIRM' session message received in "
+                                                      "session operation \"" + sessMgrOpToStrUpCase() +
+                                                      "\", step " + sessMgrOpStepToStrUpCase());
+    break;
+
+   /* ---------------------------- 'UPLOAD_DELTA' Payload Message Type ---------------------------- */
+
+   // An 'UPLOAD_DELTA' payload message type, which announces the delta of a file to be uploaded, is allowed
+   // only in the 'UPLOAD' operation with step 'WAITING_CONF' past a 'DELTA_CONFIRM' (i.e. once the
+   // signatures of the existing file's blocks have been sent, the step being 'SIGNING_BASE' until then)
+   case UPLOAD_DELTA:
+    if(!(_stream->op == UPLOAD && _stream->opStep == WAITING_CONF && _stream->fileDelta != nullptr))
+     sendSrvSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'UPLOAD_DELTA' session message received in "
+                                                      "session operation \"" + sessMgrOpToStrUpCase() +
+                                                      "\", step " + sessMgrOpStepToStrUpCase());
+    break;
+
+   /* ---------------------------- 'UPLOAD_DIGEST' Payload Message Type ---------------------------- */
+
+   // An 'UPLOAD_DIGEST' payload message type, which announces the digest of the contents of a file
+   // to be uploaded, is allowed only in the 'UPLOAD' operation with step 'OP_START' and on
+   // connections where deduplicated uploads have been negotiated
+   case UPLOAD_DIGEST:
+    if(!(_stream->op == UPLOAD && _stream->opStep == OP_START && _connMgr._dedupUploads))
+     sendSrvSessSignalMsg(ERR_UNEXPECTED_SESS_MESSAGE,"'UPLOAD_DIGEST' session message received in "
+                                                      "session operation \"" + sessMgrOpToStrUpCase() +
+                                                      "\", step " + sessMgrOpStepToStrUpCase());
+    break;
+
    /* ------------------------------- 'CANCEL' Signaling Message Type ------------------------------- */
 
    // A 'CANCEL' signaling message type is allowed only in the 'UPLOAD',
@@ -1258,8 +1989,8 @@ void SrvSessMgr::srvSessMsgHandler()
     // Since after sending a 'CANCEL' message the client has supposedly reset its session
     // state, in case such a message is received in an invalid operation or step just log
     // the error without notifying the client that an unexpected session message was received
-    if(!((_sessMgrOp == UPLOAD || _sessMgrOp == DOWNLOAD || _sessMgrOp == DELETE)
-         && _sessMgrOpStep == WAITING_CONF))
+    if(!((_stream->op == UPLOAD || _stream->op == DOWNLOAD || _stream->op == DELETE)
+         && _stream->opStep == WAITING_CONF))
      LOG_WARNING("Client \"" + *_connMgr._name + "\" cancelled an operation with the session manager "
                  "in operation '" + sessMgrOpToStrUpCase() + "', step " + sessMgrOpStepToStrUpCase())
 
@@ -1267,35 +1998,33 @@ void SrvSessMgr::srvSessMsgHandler()
     // operation and step, log the operation that has been cancelled
     else
      {
-      if(_sessMgrOp == UPLOAD)
+      if(_stream->op == UPLOAD)
        LOG_INFO("[" + *_connMgr._name + "] File upload cancelled (file: \""
-                + _remFileInfo->fileName + "\", size: " + _remFileInfo->meta->fileSizeStr + ")")
+                + _stream->remFileInfo->fileName + "\", size: " + _stream->remFileInfo->meta->fileSizeStr + ")")
       else
-       if(_sessMgrOp == DOWNLOAD)
+       if(_stream->op == DOWNLOAD)
         LOG_INFO("[" + *_connMgr._name + "] File download cancelled (file: \""
-                 + _mainFileInfo->fileName + "\", size: " + _mainFileInfo->meta->fileSizeStr + ")")
+                 + _stream->mainFileInfo->fileName + "\", size: " + _stream->mainFileInfo->meta->fileSizeStr + ")")
        else
         LOG_INFO("[" + *_connMgr._name + "] File deletion cancelled (file: \""
-                 + _mainFileInfo->fileName + "\", size: " + _mainFileInfo->meta->fileSizeStr + ")")
+                 + _stream->mainFileInfo->fileName + "\", size: " + _stream->mainFileInfo->meta->fileSizeStr + ")")
      }
 
-    // Reset the server session state and return
-    resetSessState();
+    // Reset the stream state and return
+    resetStreamState();
     return;
 
    /* ---------------------------- 'COMPLETED' Signaling Message Type ---------------------------- */
 
-   /*
-    * A 'COMPLETED' signaling message type is allowed only in:
-    *   1) The 'DOWNLOAD' operation of any step
-    *   2) The 'LIST' operation with step 'WAITING_COMPL'
-    */
+   // A 'COMPLETED' signaling message type is allowed only
+   // in the 'DOWNLOAD' and 'LIST' operations with step 'WAITING_COMPL'
+
    case COMPLETED:
 
     // Since after sending a 'COMPLETED' message the client has supposedly reset its session state,
     // if such a message type is received in an invalid operation or step just throw the associated
     // exception without notifying the client that an unexpected session message was received
-    if(!((_sessMgrOp == DOWNLOAD) || (_sessMgrOp == LIST && _sessMgrOpStep == WAITING_COMPL)))
+    if(!((_stream->op == DOWNLOAD || _stream->op == LIST) && _stream->opStep == WAITING_COMPL))
      THROW_SESS_EXCP(ERR_SESS_UNEXPECTED_MESSAGE, "Client: \"" + *_connMgr._name + "\", " + abortedOpToStr(),
                                                   "'COMPLETED' session message received in session operation "
                                                   "\"" + sessMgrOpToStrUpCase() + "\", step "
@@ -1304,13 +2033,13 @@ void SrvSessMgr::srvSessMsgHandler()
 
    /* ------------------------------- 'BYE' Signaling Message Type ------------------------------- */
 
-   // A 'BYE' signaling message type is allowed in the 'IDLE' operation only
+   // A 'BYE' signaling message type is allowed with all the session's streams in the 'IDLE' operation only
    case BYE:
 
     // Since after sending a 'BYE' message the client is supposedly shutting down the connection,
     // if such a message type is received in an invalid operation or step just throw the associated
     // exception without notifying the client that an unexpected session message was received
-    if(_sessMgrOp != IDLE)
+    if(!isIdle())
      LOG_WARNING("Client \"" + *_connMgr._name + "\" gracefully disconnecting with the session manager in"
                  "the \"" + sessMgrOpToStrUpCase() + "\" operation, step " + sessMgrOpStepToStrUpCase())
 
@@ -1318,6 +2047,19 @@ void SrvSessMgr::srvSessMsgHandler()
     _connMgr._shutdownConn = true;
     return;
 
+   /* -------------------------------- 'FILE_SEGMENT' Message Type -------------------------------- */
+
+   // A 'FILE_SEGMENT' message type is allowed only in the 'UPLOAD' operation with step 'WAITING_RAW',
+   // where as the segment's raw contents immediately follow its announcement, an unexpected
+   // 'FILE_SEGMENT' message requires the connection to be dropped
+   case FILE_SEGMENT:
+    if(!(_stream->op == UPLOAD && _stream->opStep == WAITING_RAW))
+     THROW_EXEC_EXCP(ERR_SESSABORT_INVALID_FILE_SEGMENT, "Client: \"" + *_connMgr._name + "\", stream "
+                                                         + std::to_string(_stream->streamId) + ", operation "
+                                                         + sessMgrOpToStrUpCase() + ", step "
+                                                         + sessMgrOpStepToStrUpCase());
+    break;
+
    /* ------------------------------ Error Signaling Message Types ------------------------------ */
 
    /* Error Signaling Message Types are allowed in all operations and steps */
@@ -1337,6 +2079,11 @@ void SrvSessMgr::srvSessMsgHandler()
     THROW_SESS_EXCP(ERR_SESS_SRV_CLI_MALFORMED_MESSAGE, "Client: \"" + *_connMgr._name +
                                                         "\", " + abortedOpToStr());
 
+   // The client reported not to have enough storage space for the file to be received
+   case ERR_NO_SPACE:
+    THROW_SESS_EXCP(ERR_SESS_SRV_CLI_NO_SPACE, "Client: \"" + *_connMgr._name +
+                                               "\", " + abortedOpToStr());
+
    // The client reported to have received a session message of unknown type, an error to be attributed to
    // a desynchronization between the connection peers' IVs and that requires the connection to be reset
    case ERR_UNKNOWN_SESSMSG_TYPE:
@@ -1369,11 +2116,9 @@ void SrvSessMgr::srvSessMsgHandler()
 
 
 /**
- * @brief  Server session raw handler, passing the number of bytes read from the
- *         connection socket into the primary connection buffer to the raw sub-handler
- *         associated with the current server session manager operation and step
- * @param  recvBytes The number of bytes read from the connection
- *                   socket into the primary connection buffer
+ * @brief  Server session raw handler, passing the raw data read from the connection socket
+ *         into the primary connection buffer to the raw sub-handler associated
+ *         with the current server session manager operation and step
  * @throws ERR_SESSABORT_INTERNAL_ERROR   Invalid server session manager operation
  *                                        and step for receiving raw data
  * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
@@ -1382,6 +2127,7 @@ void SrvSessMgr::srvSessMsgHandler()
  * @throws ERR_FILE_WRITE_FAILED          Failed to write into the temporary file
  * @throws ERR_OSSL_SET_TAG_FAILED        Error in setting the expected file integrity tag
  * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED File integrity verification failed
+ * @throws ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED A file chunk integrity verification failed
  * @throws ERR_SESS_INTERNAL_ERROR        Failed to close or move the uploaded temporary
  *                                        file or NULL session attributes
  * @throws ERR_SESS_FILE_META_SET_FAILED  Error in setting the uploaded file's metadata
@@ -1392,16 +2138,288 @@ void SrvSessMgr::srvSessMsgHandler()
  * @throws ERR_PEER_DISCONNECTED          The connection peer disconnected during the send()
  * @throws ERR_SEND_FAILED                send() fatal error
  */
-void SrvSessMgr::srvSessRawHandler(size_t recvBytes)
+void SrvSessMgr::srvSessRawHandler()
  {
   // In its current implementation the only operation and step in which the SafeCloud
   // server may receive raw data is when receiving the contents of a file being uploaded
-  if(_sessMgrOp != UPLOAD || _sessMgrOpStep != WAITING_RAW)
+  if(_stream->op != UPLOAD || _stream->opStep != WAITING_RAW)
    THROW_EXEC_EXCP(ERR_SESSABORT_INTERNAL_ERROR, "Receiving raw data with the server session manager"
                                                  " in operation \"" + sessMgrOpToStrUpCase() +
                                                  "\", step " + sessMgrOpStepToStrUpCase());
 
-  // Pass the number of bytes read from the connection socket into
+  // Pass the raw data read from the connection socket into
   // the primary connection buffer to 'UPLOAD' raw sub-handler
-  uploadRecvRawCallback(recvBytes);
+  uploadRecvRawCallback();
+ }
+
+/**
+ * @brief  Returns whether the server session manager has file raw contents, upload outcomes or delta signatures
+ *         pending to be sent to the client, i.e. whether any of its streams is sending the raw contents of a
+ *         file being downloaded, has had its uploaded file committed by the group commit or is signing the
+ *         existing file of a delta upload and the associated connection manager is not receiving a message
+ *         or raw data block in its primary connection buffer (which sending would overwrite)
+ * @return A boolean indicating whether the server session manager has file raw
+ *         contents, upload outcomes or delta signatures pending to be sent
+ */
+bool SrvSessMgr::hasPendingSend()
+ {
+  // File segments cannot be sent while a message or raw data block is being received in the
+  // primary connection buffer, as sending their announcements would overwrite its contents
+  if(_connMgr._recvMode != ConnMgr::RECV_MSG || _connMgr._priBufInd != 0)
+   return false;
+
+  for(SessStream* stream : _streams)
+   if((stream->op == DOWNLOAD && stream->opStep == SENDING_RAW)
+      || (stream->op == UPLOAD && (stream->opStep == COMMITTED || stream->opStep == COMMIT_FAILED
+                                   || stream->opStep == SIGNING_BASE)))
+    return true;
+  return false;
+ }
+
+
+/**
+ * @brief  Server session send handler, called when the connection socket is writable and the server session
+ *         manager has file raw contents pending to be sent, which selects in round-robin the next stream
+ *         sending the raw contents of a file being downloaded and sends its next segment to the client,
+ *         announced by a 'FILE_SEGMENT' session message, so that the segments of the files being
+ *         downloaded on different streams are interleaved on the connection, where:\n\n
+ *            - Segments are alternately encrypted into two ciphertext buffers, so that as a segment sent
+ *              in zero-copy mode cannot be overwritten until the kernel has released its buffer, the
+ *              encryption of a segment overlaps with the transmission of the previous one\n\n
+ *            - Segments of files mapped into memory are encrypted directly from their mapping, checking
+ *              the file not to have been truncated beforehand and its pages not to have been found
+ *              unbacked by the file during their encryption (see the mapFileFaultHandler() method)\n\n
+ *            - Once all the raw contents of a file have been sent, its stream is set to
+ *              expect the client download completion notification\n\n
+ *         Streams whose uploaded files have been committed by the group commit take precedence over
+ *         downloads, the handler notifying the client of the outcome of their upload instead, while streams
+ *         signing the existing file of a delta upload take their turn in the round-robin, each computing a
+ *         step of the file's blocks' signatures (see the signUploadBase() method)
+ * @throws ERR_SESS_INTERNAL_ERROR            An uploaded file could not be synchronized to storage
+ * @throws ERR_FILE_READ_FAILED               Error in reading from the main file
+ * @throws ERR_SESS_FILE_READ_FAILED          Error in reading the existing file of a delta upload
+ * @throws ERR_OSSL_EVP_MD_CTX_NEW            EVP_MD context creation failed
+ * @throws ERR_OSSL_EVP_DIGEST_INIT           EVP_MD digest initialization failed
+ * @throws ERR_OSSL_EVP_DIGEST_UPDATE         EVP_MD digest update failed
+ * @throws ERR_OSSL_EVP_DIGEST_FINAL          EVP_MD digest final failed
+ * @throws ERR_SESSABORT_UNEXPECTED_FILE_SIZE The sent file raw contents differ from its expected size
+ * @throws ERR_OSSL_EVP_PKEY_CTX_NEW          EVP_PKEY context creation failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT      Key derivation context initialization failed
+ * @throws ERR_OSSL_EVP_PKEY_DERIVE           Key derivation failed
+ * @throws ERR_AESGCMMGR_INVALID_STATE        Invalid AES_128_GCM manager state
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW        EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT          EVP_CIPHER encrypt initialization failed
+ * @throws ERR_NON_POSITIVE_BUFFER_SIZE       The plaintext block size is non-positive (probable overflow)
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE        EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL         EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED            Error in retrieving the resulting integrity tag
+ * @throws ERR_PEER_DISCONNECTED              The connection peer disconnected during the send()
+ * @throws ERR_SEND_FAILED                    send() fatal error
+ */
+void SrvSessMgr::srvSessSendHandler()
+ {
+  // fread() return, representing the number of bytes read
+  // from main file into the secondary connection buffer
+  size_t freadRet;
+
+  // The plaintext and ciphertext sizes of the file segment to be sent
+  unsigned int segSize;
+  unsigned int ctSize;
+
+  // The offset of the file segment to be sent in the file and its plaintext contents
+  // (in the file's mapping or read into the secondary connection buffer)
+  long int       segOffset;
+  unsigned char* segPtBuf;
+
+  // The main file's current status (mapped files' truncation checks purposes)
+  struct stat fileStat;
+
+  // The epoch of the sending key the segment is encrypted with
+  uint32_t keyEpoch;
+
+  // The ciphertext buffer the segment is encrypted into and its mapping, if created
+  unsigned char*& ctBuf = _sendCtBufs[_sendCtBufInd];
+  void*           ctBufMap;
+
+#ifdef DEBUG_MODE
+  // The file's current download progress discretized between 0-100%
+  unsigned char currDownloadProg;
+#endif
+
+  // Process the zero-copy completion notifications received since the socket was last writable, if any,
+  // so that the ciphertext buffers are mostly found released by the kernel by the time they are reused
+  if((int32_t)(_connMgr._zcSendSeq - _connMgr._zcComplSeq) > 0)
+   _connMgr.recvZeroCopyCompl();
+
+  // Notify the client of the outcome of the first upload committed by the group commit, if any
+  for(SessStream* stream : _streams)
+   if(stream->op == UPLOAD && (stream->opStep == COMMITTED || stream->opStep == COMMIT_FAILED))
+    {
+     _stream = stream;
+
+     // If the uploaded file could not be synchronized to storage, notify the client that its
+     // upload has failed (the file in the storage pool being possibly lost on a power failure)
+     if(_stream->opStep == COMMIT_FAILED)
+      sendSrvSessSignalMsg(ERR_INTERNAL_ERROR, "Failed to synchronize uploaded file \""
+                                               + *_stream->mainFileAbsPath + "\" to storage");
+
+     // Otherwise, notify the client that the file upload has been completed successfully
+     uploadComplete();
+     return;
+    }
+
+  // Select in round-robin the next stream sending the raw contents of a
+  // file being downloaded or signing the existing file of a delta upload
+  for(unsigned char i = 0; i < SESS_MAX_STREAMS; i++)
+   {
+    _sendStreamInd = (unsigned char)((_sendStreamInd + 1) % SESS_MAX_STREAMS);
+    if((_streams[_sendStreamInd]->op == DOWNLOAD && _streams[_sendStreamInd]->opStep == SENDING_RAW)
+       || (_streams[_sendStreamInd]->op == UPLOAD && _streams[_sendStreamInd]->opStep == SIGNING_BASE))
+     break;
+   }
+  _stream = _streams[_sendStreamInd];
+
+  // If the stream is signing the existing file of a delta upload, compute its next step
+  if(_stream->op == UPLOAD && _stream->opStep == SIGNING_BASE)
+   {
+    signUploadBase();
+    return;
+   }
+
+  // Should never happen, as the handler is called only if hasPendingSend() holds
+  if(_stream->op != DOWNLOAD || _stream->opStep != SENDING_RAW)
+   return;
+
+  // Determine the plaintext size of the next file segment to be sent and its offset in the file
+  segSize   = adaptSendSegSize(_stream->rawBytesRem);
+  segOffset = (long int)(_stream->rawOffset + _stream->rawLength - _stream->rawBytesRem);
+
+  // If the file is mapped into memory, the segment is encrypted directly from its mapping
+  if(_stream->mainFileMap != nullptr)
+   {
+    // As accessing the mapping beyond the file's end raises a SIGBUS, ensure the
+    // file not to have been truncated since the download operation was started, which
+    // is a critical error that in the current session state cannot be notified to
+    // the client and so require their connection to be dropped
+    if(fstat(fileno(_stream->mainFileDscr), &fileStat) != 0)
+     THROW_EXEC_EXCP(ERR_FILE_READ_FAILED,"file: " + *_stream->mainFileAbsPath + "\", "
+                     + *_connMgr._name + "\" download operation aborted", ERRNO_DESC);
+    if(fileStat.st_size < segOffset + segSize)
+     THROW_EXEC_EXCP(ERR_SESSABORT_UNEXPECTED_FILE_SIZE, "file: \"" + _stream->mainFileInfo->fileName + "\", \""
+                                                         + *_connMgr._name + "\" download operation aborted",
+                                                         std::to_string(fileStat.st_size) + " != "
+                                                         + std::to_string(_stream->mainFileInfo->meta->fileSizeRaw));
+    segPtBuf = _stream->mainFileMap + segOffset;
+   }
+
+  // Otherwise, read the segment's raw contents from the file into the secondary buffer
+  else
+   {
+    freadRet = fread(_connMgr._secBuf, sizeof(char), segSize, _stream->mainFileDscr);
+
+    // An error occurred in reading the file raw contents is a critical
+    // error that in the current session state cannot be notified
+    // to the client and so require their connection to be dropped
+    if(ferror(_stream->mainFileDscr))
+     THROW_EXEC_EXCP(ERR_FILE_READ_FAILED,"file: " + *_stream->mainFileAbsPath + "\", "
+                     + *_connMgr._name + "\" download operation aborted", ERRNO_DESC);
+
+    // Reading from the file less bytes than its expected size (i.e. the file was
+    // truncated after the download operation was started) is a critical error
+    // that in the current session state cannot be notified to the client
+    // and so require their connection to be dropped
+    if(freadRet != segSize)
+     THROW_EXEC_EXCP(ERR_SESSABORT_UNEXPECTED_FILE_SIZE, "file: \"" + _stream->mainFileInfo->fileName + "\", \""
+                                                         + *_connMgr._name + "\" download operation aborted",
+                                                         std::to_string(segOffset + freadRet) + " != "
+                                                         + std::to_string(_stream->mainFileInfo->meta->fileSizeRaw));
+    segPtBuf = &_connMgr._secBuf[0];
+   }
+
+  // Map the ciphertext buffer upon its first use
+  if(ctBuf == nullptr)
+   {
+    ctBufMap = mmap(nullptr, fileSegmentWireSize(FILE_SEGMENT_SIZE), PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(ctBufMap == MAP_FAILED)
+     THROW_EXEC_EXCP(ERR_MALLOC_FAILED, "requested size = "
+                                        + std::to_string(fileSegmentWireSize(FILE_SEGMENT_SIZE)), ERRNO_DESC);
+    ctBuf = static_cast<unsigned char*>(ctBufMap);
+   }
+
+  // Wait for the kernel to release the ciphertext buffer from its previous send
+  _connMgr.waitZeroCopyCompl(_sendCtBufSeq[_sendCtBufInd]);
+
+  // If the file is mapped, guard the segment's contents in the mapping from the file being
+  // truncated between the check above and their encryption (see mapFileFaultHandler())
+  if(_stream->mainFileMap != nullptr)
+   {
+    _mapFaulted    = 0;
+    _mapGuardStart = segPtBuf;
+    _mapGuardEnd   = segPtBuf + segSize;
+   }
+
+  // Encrypt the segment's chunks into the ciphertext buffer (which must
+  // precede its announcement, as it overwrites the secondary buffer)
+  keyEpoch = _sendKeyEpoch;
+  ctSize   = encryptFileSegment(*_stream, segSize, keyEpoch, segPtBuf, ctBuf);
+
+  // If the file is mapped, clear the guard and, should some of the segment's pages have been found
+  // unbacked by the file during its encryption (i.e. it was truncated), abort the download
+  if(_stream->mainFileMap != nullptr)
+   {
+    _mapGuardStart = nullptr;
+    _mapGuardEnd   = nullptr;
+    if(_mapFaulted)
+     THROW_EXEC_EXCP(ERR_SESSABORT_UNEXPECTED_FILE_SIZE, "file: \"" + _stream->mainFileInfo->fileName + "\", \""
+                                                         + *_connMgr._name + "\" download operation aborted",
+                                                         "file truncated while being read");
+   }
+
+  // If the file is downloaded in streaming I/O mode, release the page cache used by its completed windows
+  advanceStreamingIO(_stream->mainFileDscr, _stream->mainFileMap, (long long)(_stream->rawOffset + _stream->rawLength),
+                     (long long)(_stream->rawOffset + _stream->rawLength - _stream->rawBytesRem), segSize, false);
+
+  // Announce the segment to the client and send its chunks along with their integrity tags
+  sendSessMsgFileSegment(*_stream, segSize, ctSize, keyEpoch);
+  _sendCtBufSeq[_sendCtBufInd] = _connMgr.sendRawZeroCopy(ctBuf, ctSize);
+  _sendCtBufInd ^= 1;
+
+  // In DEBUG_MODE, compute and log the file's current download progress
+#ifdef DEBUG_MODE
+  currDownloadProg = (unsigned char)((float)(_stream->rawLength - _stream->rawBytesRem) /
+                     (float)_stream->rawLength * 100);
+
+  LOG_DEBUG("[" + *_connMgr._name + "] File \"" + _stream->mainFileInfo->fileName +
+            "\" (" + _stream->mainFileInfo->meta->fileSizeStr + ") download progress: "
+            + std::to_string((int)currDownloadProg) + "%")
+#endif
+
+  // If the file's raw contents have all been sent, set the stream to expect the client download's completion
+  // (where the ciphertext buffers are left to be released by the kernel, with its notifications being
+  // processed as the connection socket becomes readable or writable or before the buffers' reuse)
+  if(_stream->rawBytesRem == 0)
+   _stream->opStep = WAITING_COMPL;
+ }
+
+
+/**
+ * @brief Upload group commit callback, called by the server once the file uploaded on a stream awaiting
+ *        the group commit has been synchronized to storage (or failed to), setting the stream to notify
+ *        the client of the upload's outcome as the connection socket becomes writable (as the primary
+ *        connection buffer may be receiving a message of another stream, see the hasPendingSend() method)
+ * @param streamId The identifier of the stream of the committed upload
+ * @param durable  Whether the uploaded file has been successfully synchronized to storage
+ */
+void SrvSessMgr::uploadCommitCallback(uint8_t streamId, bool durable)
+ {
+  // The stream of the committed upload
+  SessStream* stream = _streams[streamId];
+
+  // If the stream's upload has been aborted while awaiting the group commit, the commit has no effect
+  if(stream->op != UPLOAD || stream->opStep != WAITING_COMMIT)
+   return;
+
+  // Set the stream to notify the client of the upload's outcome
+  stream->opStep = durable ? COMMITTED : COMMIT_FAILED;
  }
\ No newline at end of file
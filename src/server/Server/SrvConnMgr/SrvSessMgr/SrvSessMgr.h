@@ -4,11 +4,26 @@
 /* SafeCloud Server Session Manager Declaration */
 
 /* ================================== INCLUDES ================================== */
+#include <vector>
+#include <csignal>
 #include "SafeCloudApp/ConnMgr/SessMgr/SessMgr.h"
 
+// The minimum size of the files uploaded or downloaded in streaming I/O mode, whose contents bypass the
+// stdio buffers and are dropped from the page cache as they are transferred, so that large transfers do
+// not evict from it the files of the other users (see the initStreamingIO() and advanceStreamingIO() methods)
+#define SRV_STREAMING_IO_MIN_SIZE (64 * 1024 * 1024)  // 64 MB
 
-// Forward Declaration
+// The size of the windows the contents of the files transferred in streaming I/O mode are
+// written back, dropped from the page cache or hinted to be read ahead in, which bounds
+// the page cache used by each transfer to about two windows
+#define SRV_STREAMING_IO_WINDOW   (8 * 1024 * 1024)   // 8 MB
+
+
+// Forward Declarations
 class SrvConnMgr;
+class GroupCommit;
+class PartialUploads;
+class ContentStore;
 
 class SrvSessMgr : public SessMgr
  {
@@ -16,7 +31,45 @@ class SrvSessMgr : public SessMgr
 
    /* ================================= ATTRIBUTES ================================= */
 
-   /* Same of the 'SessMgr' base class */
+   // The ciphertext buffers the segments of the files being downloaded are alternately encrypted into,
+   // which are mapped upon their first use and, as the kernel may still be sending from them in zero-copy
+   // mode, unmapped rather than freed when the session ends (the kernel holding its own references
+   // to their pages), so that their zero-copy sends never need to be waited for past their reuse
+   unsigned char* _sendCtBufs[2];
+
+   // The zero-copy sequence number of the last send from each ciphertext buffer
+   uint32_t _sendCtBufSeq[2];
+
+   // The index of the ciphertext buffer the next file segment is encrypted into
+   unsigned char _sendCtBufInd;
+
+   // The index of the last stream a file segment has been sent from
+   unsigned char _sendStreamInd;
+
+   // The plaintext and wire sizes and key epoch of the file segment being received
+   unsigned int _recvSegSize;
+   unsigned int _recvWireSize;
+   uint32_t     _recvKeyEpoch;
+
+   // The server's group commit making the uploaded files durable
+   GroupCommit& _groupCommit;
+
+   // The server's partial uploads and the absolute path of the user's partial uploads directory
+   PartialUploads& _partialUploads;
+   std::string*    _resumeDirAbsPath;
+
+   // The server's content store deduplicating the users' files
+   ContentStore& _contentStore;
+
+   // The mapped contents of the file segment being encrypted, whose pages the SIGBUS handler
+   // replaces with zeros if they are no longer backed by the file (i.e. it was truncated),
+   // and whether it has done so (see the mapFileFaultHandler() method)
+   static unsigned char* volatile _mapGuardStart;
+   static unsigned char* volatile _mapGuardEnd;
+   static volatile sig_atomic_t   _mapFaulted;
+
+   // The system's memory page size (cached for the SIGBUS handler)
+   static long _pageSize;
 
    /* ============================== PRIVATE METHODS ============================== */
 
@@ -33,6 +86,8 @@ class SrvSessMgr : public SessMgr
     *                                       invalid for its current operation or step
     * @throws ERR_SESS_MALFORMED_MESSAGE    The session manager received
     *                                       a malformed session message
+    * @throws ERR_SESS_NO_SPACE             Not enough storage space
+    *                                       for the file to be received
     * @throws ERR_SESS_UNKNOWN_SESSMSG_TYPE The session manager received a
     *                                       session message of unknown type
     * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
@@ -48,6 +103,106 @@ class SrvSessMgr : public SessMgr
 
    void sendSrvSessSignalMsg(SessMsgType sessMsgSignalingType, const std::string& errReason);
 
+   /**
+    * @brief  Asserts the filesystem of the user's storage pool to have enough free space for the
+    *         file to be uploaded, which when overwriting an existing file coexists with it until
+    *         the upload completes, so to reject the upload before the client confirms it
+    * @throws ERR_SESS_NO_SPACE             Not enough storage space for the file to be uploaded
+    * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+    * @throws ERR_CLI_DISCONNECTED          The client disconnected during the send()
+    * @throws ERR_SEND_FAILED               send() fatal error
+    */
+   void checkPoolSpace();
+
+   /**
+    * @brief  Preallocates the temporary file of the file being uploaded to its announced size, so that
+    *         its extents are reserved as contiguously as the filesystem allows rather than grown by
+    *         each segment write, rejecting the upload if there is not enough storage space for it
+    *         (where the extents are released along with the temporary file if the upload is aborted)
+    * @throws ERR_SESS_NO_SPACE             Not enough storage space for the file to be uploaded
+    * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE   EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL    EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED       Error in retrieving the resulting integrity tag
+    * @throws ERR_CLI_DISCONNECTED          The client disconnected during the send()
+    * @throws ERR_SEND_FAILED               send() fatal error
+    */
+   void preallocUploadFile();
+
+   /**
+    * @brief  If the resumption of uploads is supported by both peers, prepares the user's partial uploads
+    *         directory and sets the file being uploaded to be preserved as a partial upload if its upload is
+    *         interrupted, where if a partial upload of the file exists it is claimed as the upload's temporary
+    *         file and the client is informed of the offset its upload is resumed from
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL    EVP_MD digest failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_CLI_DISCONNECTED         The client disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void claimPartialUpload();
+
+   /**
+    * @brief Sets the transfer of a file to use the streaming I/O mode if its size is at least SRV_STREAMING_IO_MIN_SIZE,
+    *        disabling the stdio buffering of its descriptor, so that its segments are directly read or written between
+    *        the file and the connection buffers, and hinting the kernel that the file is accessed sequentially
+    *        (which also doubles its read-ahead), where it must be called before any I/O on the file descriptor
+    * @param fileDscr The descriptor of the file being uploaded or downloaded
+    * @param fileSize The size of the file being uploaded or downloaded
+    */
+   static void initStreamingIO(FILE* fileDscr, long long fileSize);
+
+   /**
+    * @brief Releases the page cache used by a file transferred in streaming I/O mode as its windows are completed,
+    *        where, every time a segment completes a window (see SRV_STREAMING_IO_WINDOW):\n\n
+    *           - Writing (upload): The writeback of the completed window is started and, once the one of the previous
+    *             window has completed, the previous window is dropped from the page cache (so that writing is never
+    *             blocked on the writeback of the window just completed, and each window is dropped once clean)\n\n
+    *           - Reading (download): The completed window is dropped from the page cache
+    *             and the next window is hinted to be read ahead\n\n
+    *        with failures, which do not affect the transfer's correctness, being ignored
+    * @param fileDscr  The descriptor of the file being uploaded or downloaded
+    * @param fileMap   The memory mapping of the file being downloaded, if any, whose
+    *                  completed windows are also unmapped from the server's memory
+    * @param fileSize  The size of the file being uploaded or downloaded
+    * @param doneBytes The number of the file's bytes written or read so far, including the last segment
+    * @param segSize   The size of the last segment written or read
+    * @param writing   Whether the file is being written (upload) or read (download)
+    */
+   static void advanceStreamingIO(FILE* fileDscr, unsigned char* fileMap, long long fileSize,
+                                  long long doneBytes, unsigned int segSize, bool writing);
+
+   /**
+    * @brief SIGBUS handler, which when the fault occurred in the mapped contents of the file segment being
+    *        encrypted (i.e. the file was truncated after being mapped) maps a page of zeros over the faulting
+    *        page and flags the fault, so that the segment's encryption completes and the download is then
+    *        aborted, and which otherwise restores the signal's default action, so that the fault re-occurs
+    *        and terminates the server as it would have without the handler
+    * @param sig  The signal number (SIGBUS)
+    * @param info Information on the signal, including the faulting address
+    * @note  The handler's third parameter, the context of the interrupted thread, is unused
+    */
+   static void mapFileFaultHandler(int sig, siginfo_t* info, void*);
+
+   /**
+    * @brief Maps read-only into memory the file being downloaded, so that its segments are encrypted
+    *        directly from the page cache rather than being first copied into the secondary buffer, where
+    *        the file is hinted to be accessed sequentially and, should it not be possible to map it,
+    *        its segments are read through its file descriptor as usual
+    */
+   void mapDownloadFile();
+
    /**
     * @brief  Dispatches a received session message to the callback method associated with
     *         its type and the server session manager current operation and implicit step
@@ -68,13 +223,16 @@ class SrvSessMgr : public SessMgr
     *           1) Loading the name and metadata of the remote file to be uploaded\n\n
     *              2.1) If the file to be uploaded is empty, directly touch such a file in the
     *                   user's storage pool and notify them that the upload operation has completed\n\n
-    *              2.2) If the file to be uploaded is NOT empty, depending on whether a file with
+    *              2.2) If the file to be uploaded is NOT empty, after resuming its upload from
+    *                   its partial upload, if any, and depending on whether a file with
     *                   the same name already exists in the user's storage pool:\n\n
     *                   2.1.1) If it does, the local file information are sent to the client,
     *                          with their confirmation  being required on whether the upload
     *                          should proceed and so such file be overwritten\n\n
     *                   2.2.2) If it does not, notify the client that the server
     *                          is ready to receive the file's raw contents
+    *              (where if deduplicated uploads have been negotiated such response is
+    *              deferred until the digest of the file's contents is received)
     * @throws ERR_SESS_MALFORMED_MESSAGE    Invalid file values in the 'SessMsgFileInfo' message
     * @throws ERR_SESS_MAIN_FILE_IS_DIR     The file to be uploaded was found as a
     *                                       directory in the client's storage pool (!)
@@ -84,6 +242,7 @@ class SrvSessMgr : public SessMgr
     * @throws ERR_SESS_FILE_OPEN_FAILED     Error in opening the uploaded empty main file
     * @throws ERR_SESS_FILE_CLOSE_FAILED    Error in closing the uploaded empty main file
     * @throws ERR_SESS_FILE_META_SET_FAILED Error in setting the empty main file's metadata
+    * @throws ERR_SESS_NO_SPACE             Not enough storage space for the file to be uploaded
     * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
@@ -95,6 +254,25 @@ class SrvSessMgr : public SessMgr
     */
    void uploadStartCallback();
 
+   /**
+    * @brief  Responds to the upload request of a non-empty file by resuming its upload from its partial
+    *         upload, if any, and, depending on whether a file with the same name already exists in the
+    *         user's storage pool, either sending the local file information to the client for them to
+    *         confirm its overwriting or notifying them that the server is ready to receive its raw contents
+    * @throws ERR_SESS_NO_SPACE            Not enough storage space for the file to be uploaded
+    * @throws ERR_SESS_FILE_OPEN_FAILED    Failed to open the temporary file
+    *                                      descriptor in write-byte mode
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void respondUploadReq();
+
    /**
     * @brief  'UPLOAD' operation 'CONFIRM' session message callback, which:\n\n
     *             1) [PATCH] If the file to be uploaded is empty, touch it in the user's
@@ -107,6 +285,7 @@ class SrvSessMgr : public SessMgr
     * @throws ERR_SESS_FILE_CLOSE_FAILED    Error in closing the empty file to be uploaded
     * @throws ERR_SESS_FILE_META_SET_FAILED Error in setting the metadata
     *                                       of the file to be uploaded
+    * @throws ERR_SESS_NO_SPACE             Not enough storage space for the file to be uploaded
     * @throws ERR_AESGCMMGR_INVALID_STATE   Invalid AES_128_GCM manager state
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT     EVP_CIPHER encrypt initialization failed
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE  The AAD block size is non-positive (probable overflow)
@@ -120,34 +299,171 @@ class SrvSessMgr : public SessMgr
     */
    void uploadConfCallback();
 
+   /**
+    * @brief  'UPLOAD' operation 'FILE_SEGMENT' session message callback, validating the announced
+    *         file segment's sizes and setting the associated connection manager to receive its raw
+    *         contents (chunks' sizes table, ciphertexts and integrity tags) into the primary buffer
+    * @throws ERR_SESSABORT_INVALID_FILE_SEGMENT The stream is not expecting a file segment or
+    *                                            the announced segment sizes are invalid
+    * @throws ERR_SESSABORT_INVALID_KEY_EPOCH    Invalid announced segment key epoch
+    */
+   void uploadSegmentCallback();
+
+   /**
+    * @brief  'UPLOAD' operation 'UPLOAD_DIGEST' session message callback, which if a file with the same name of
+    *         the one to be uploaded does not exist in the user's storage pool and the content store holds the object
+    *         of its contents which is already referenced by the user's storage pool, links such object as the
+    *         file and completes the upload without its raw contents being transferred, otherwise responding to
+    *         the upload request as usual
+    * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid 'SessMsgUploadDigest' message length
+    * @throws ERR_SESS_INTERNAL_ERROR      Failed to open the linked file for its synchronization
+    * @throws ERR_SESS_NO_SPACE            Not enough storage space for the file to be uploaded
+    * @throws ERR_SESS_FILE_OPEN_FAILED    Failed to open the temporary file
+    *                                      descriptor in write-byte mode
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void uploadDigestCallback();
+
+   /**
+    * @brief  'UPLOAD' operation 'DELTA_CONFIRM' session message callback, confirming the overwriting of the
+    *         existing file with the one to be uploaded as its delta against the file, whose blocks' signatures
+    *         are then computed and sent to the client by the send handler (see the signUploadBase() method),
+    *         where delta uploads are eligible only for files which are not authenticated only, whose upload is
+    *         not resumed and both of whose versions are at least FILE_DELTA_MIN_SIZE bytes, with the existing
+    *         one being at most FILE_DELTA_MAX_SIZE bytes
+    * @throws ERR_SESS_UNEXPECTED_MESSAGE  The upload is not eligible for being carried out as a delta
+    * @throws ERR_SESS_INTERNAL_ERROR      Failed to open the existing file
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void uploadDeltaConfCallback();
+
+   /**
+    * @brief  Computes a step of the signatures of the blocks of the existing file the current stream's delta upload
+    *         is computed against, which is called by the send handler as the connection becomes writable so that
+    *         signing large files does not stall the server's main loop, sending the signatures to the client
+    *         once all of them have been computed
+    * @throws ERR_SESS_FILE_READ_FAILED    Error in reading the existing file
+    * @throws ERR_OSSL_EVP_MD_CTX_NEW      EVP_MD context creation failed
+    * @throws ERR_OSSL_EVP_DIGEST_INIT     EVP_MD digest initialization failed
+    * @throws ERR_OSSL_EVP_DIGEST_UPDATE   EVP_MD digest update failed
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL    EVP_MD digest final failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void signUploadBase();
+
+   /**
+    * @brief  'UPLOAD' operation 'UPLOAD_DELTA' session message callback, preparing the server session manager
+    *         to receive the delta of the file to be uploaded, which is applied as it is received to rebuild
+    *         the file in its temporary file, where as such a file cannot be verified until its whole delta
+    *         has been applied its upload is not preserved as a partial upload should it be interrupted
+    * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid 'SessMsgUploadDelta' message length or delta size
+    * @throws ERR_SESS_NO_SPACE            Not enough storage space for the file to be uploaded
+    * @throws ERR_SESS_FILE_OPEN_FAILED    Failed to open the temporary file
+    *                                      descriptor in write-byte mode
+    * @throws ERR_OSSL_EVP_MD_CTX_NEW      EVP_MD context creation failed
+    * @throws ERR_OSSL_EVP_DIGEST_INIT     EVP_MD digest initialization failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void uploadDeltaCallback();
+
    /**
     * @brief  'UPLOAD' operation raw file contents callback, which:\n\n
-    *            1) If the file being uploaded has not been completely received yet, decrypts its received raw
-    *               bytes and writes them into the session's temporary file in the user's temporary directory\n\n
-    *            2) If the file being uploaded has been completely received, verifies its trailing integrity
-    *               tag, moves the temporary into the associated main file in the user's storage pool, sets
-    *               its last modified time to the one specified in the '_remFileInfo' object, notifies the
-    *               success of the upload operation to the client and resets the server session manager state
-    * @param  recvBytes The number of bytes received in the associated connection manager's primary buffer
-    * @throws ERR_FILE_WRITE_FAILED          Error in writing to the temporary file
-    * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
-    * @throws ERR_NON_POSITIVE_BUFFER_SIZE   The ciphertext block size is non-positive (probable overflow)
-    * @throws ERR_OSSL_EVP_DECRYPT_UPDATE    EVP_CIPHER decrypt update failed
-    * @throws ERR_OSSL_SET_TAG_FAILED        Error in setting the expected file integrity tag
-    * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED File integrity verification failed
-    * @throws ERR_SESS_FILE_CLOSE_FAILED     Error in closing the temporary file
-    * @throws ERR_SESS_FILE_RENAME_FAILED    Error in moving the temporary file to the main directory
-    * @throws ERR_SESS_FILE_META_SET_FAILED  Error in setting the main file's last modification time
-    * @throws ERR_OSSL_EVP_ENCRYPT_INIT      EVP_CIPHER encrypt initialization failed
-    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE    EVP_CIPHER encrypt update failed
-    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL     EVP_CIPHER encrypt final failed
-    * @throws ERR_OSSL_GET_TAG_FAILED        Error in retrieving the resulting integrity tag
-    * @throws ERR_PEER_DISCONNECTED          The connection peer disconnected during the send()
-    * @throws ERR_SEND_FAILED                send() fatal error
-    * @throws ERR_SESS_INTERNAL_ERROR        Failed to close or move the uploaded temporary
-    *                                        file or NULL session attributes
+    *            1) If the current segment of the file being uploaded has been completely received, verifies
+    *               and decrypts its chunks and writes them into the stream's temporary file in the user's
+    *               temporary directory (otherwise waiting for its additional bytes)\n\n
+    *            2) If the file being uploaded has been completely received, moves the temporary into the
+    *               associated main file in the user's storage pool, sets its last modified time to the
+    *               one specified in the 'remFileInfo' object and, depending on the server's durability
+    *               mode, either notifies the success of the upload operation to the client and resets
+    *               the stream state or adds the upload to the group commit making it durable
+    * @throws ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED A chunk other than the file's last
+    *                                                failed its integrity verification
+    * @throws ERR_FILE_WRITE_FAILED                  Error in writing to the temporary file
+    * @throws ERR_AESGCMMGR_INVALID_STATE            Invalid AES_128_GCM manager state
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE           The ciphertext block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_DECRYPT_INIT              EVP_CIPHER decrypt initialization failed
+    * @throws ERR_OSSL_EVP_DECRYPT_UPDATE            EVP_CIPHER decrypt update failed
+    * @throws ERR_OSSL_SET_TAG_FAILED                Error in setting the expected chunk integrity tag
+    * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED         The file's last chunk failed its integrity verification
+    * @throws ERR_SESS_FILE_CLOSE_FAILED             Error in closing the temporary file
+    * @throws ERR_SESS_FILE_RENAME_FAILED            Error in moving the temporary file to the main directory
+    * @throws ERR_SESS_FILE_META_SET_FAILED          Error in setting the main file's last modification time
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT              EVP_CIPHER encrypt initialization failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE            EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL             EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED                Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED                  The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED                        send() fatal error
+    * @throws ERR_SESS_INTERNAL_ERROR                Failed to close or move the uploaded temporary
+    *                                                file or NULL session attributes
     */
-   void uploadRecvRawCallback(size_t recvBytes);
+   void uploadRecvRawCallback();
+
+   /**
+    * @brief Deduplicates the current stream's uploaded file, which has been finalized in the user's storage pool,
+    *        in the content store by finalizing the digest of its contents (or, if it was uploaded as a delta,
+    *        by the digest of the rebuilt file), where failures, which only prevent the file from being
+    *        deduplicated, are logged
+    */
+   void ingestUploadFile();
+
+   /**
+    * @brief  Completes the upload of the current stream's file, which has been finalized in the user's storage pool,
+    *         by either notifying the client of its completion or, if uploads must be made durable, adding it to the
+    *         group commit, which will notify its completion to the client once the file is synchronized to storage
+    * @throws ERR_SESS_INTERNAL_ERROR      Failed to open the uploaded file for its synchronization
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void commitUpload();
+
+   /**
+    * @brief  Notifies the client that the file upload of the current stream has been completed
+    *         successfully, logging the successful upload operation and resetting the stream state
+    * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED        The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED              send() fatal error
+    */
+   void uploadComplete();
 
    /* -------------------- 'DOWNLOAD' Operation Callback Methods -------------------- */
 
@@ -161,8 +477,8 @@ class SrvSessMgr : public SessMgr
     *               notification depending on whether the file to be downloaded is empty or not.
     * @throws ERR_SESS_MALFORMED_MESSAGE   Invalid file name in the 'SessMsgFileName' message
     * @throws ERR_SESS_MAIN_FILE_IS_DIR    The file to be downloaded was found to be a directory (!)
-    * @throws ERR_SESS_INTERNAL_ERROR      Failed to open the file descriptor
-    *                                      of the file to be downloaded
+    * @throws ERR_SESS_INTERNAL_ERROR      Failed to open the file descriptor of the file to be downloaded
+    *                                      or the file is too large for the client (> 4GB - 1B)
     * @throws ERR_AESGCMMGR_INVALID_STATE  Invalid AES_128_GCM manager state
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE The AAD block size is non-positive (probable overflow)
@@ -175,20 +491,12 @@ class SrvSessMgr : public SessMgr
    void downloadStartCallback();
 
    /**
-    * @brief 'DOWNLOAD' operation 'CONFIRM' session message callback, sending the raw contents of
-    *        the file to be downloaded and its resulting integrity tag to the client, and setting
-    *        the server session manager to expect the client download completion notification
-    * @throws ERR_FILE_WRITE_FAILED              Error in reading from the main file
-    * @throws ERR_SESSABORT_UNEXPECTED_FILE_SIZE The sent file raw contents differ from its expected size
-    * @throws ERR_AESGCMMGR_INVALID_STATE        Invalid AES_128_GCM manager state
-    * @throws ERR_OSSL_EVP_ENCRYPT_INIT          EVP_CIPHER encrypt initialization failed
-    * @throws ERR_NON_POSITIVE_BUFFER_SIZE       The plaintext block size is non-positive (probable overflow)
-    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE        EVP_CIPHER encrypt update failed
-    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL         EVP_CIPHER encrypt final failed
-    * @throws ERR_OSSL_GET_TAG_FAILED            Error in retrieving the resulting integrity tag
-    * @throws ERR_SEND_OVERFLOW                  Attempting to send a number of bytes > _priBufSize
-    * @throws ERR_PEER_DISCONNECTED              The connection peer disconnected during the send()
-    * @throws ERR_SEND_FAILED                    send() fatal error
+    * @brief 'DOWNLOAD' operation 'CONFIRM' or 'DOWNLOAD_RANGE' session message callback, preparing the stream to
+    *        send the raw contents of the file to be downloaded, or of its byte range the client requested, (mapped
+    *        into memory if possible and in streaming I/O mode if they are large enough), whose segments are then
+    *        sent to the client as the connection socket becomes writable, interleaved with the ones of the
+    *        session's other streams (see the srvSessSendHandler() method)
+    * @throws ERR_SESS_INTERNAL_ERROR Failed to seek the file to the start of the requested byte range
     */
    void downloadConfSendFileCallback();
 
@@ -276,9 +584,9 @@ class SrvSessMgr : public SessMgr
     *               expect their completion notification.
     * @throws ERR_DIR_OPEN_FAILED                The user's storage pool was not found (!)
     * @throws ERR_SESS_FILE_READ_FAILED          Error in reading from the user's storage pool
-    * @throws ERR_SESS_DIR_INFO_OVERFLOW         The storage pool information size exceeds 4GB
+    * @throws ERR_SESS_DIR_INFO_OVERFLOW         The storage pool information size overflows a 64-bit integer
     * @throws ERR_SESS_INTERNAL_ERROR            The serialized size of the
-    *                                            user's storage pool exceeds 4GB
+    *                                            user's storage pool exceeds the connection's maximum
     * @throws ERR_AESGCMMGR_INVALID_STATE        Invalid AES_128_GCM manager state
     * @throws ERR_NON_POSITIVE_BUFFER_SIZE       The AAD block size is non-positive (probable overflow)
     * @throws ERR_OSSL_EVP_ENCRYPT_INIT          EVP_CIPHER encrypt initialization failed
@@ -326,7 +634,11 @@ class SrvSessMgr : public SessMgr
     */
    explicit SrvSessMgr(SrvConnMgr& cliConnMgr);
 
-   /* Same destructor of the SessMgr base class */
+   /**
+    * @brief SrvSessMgr object destructor, unmapping the ciphertext buffers of the files being
+    *        downloaded without waiting for the kernel to release them from their zero-copy sends
+    */
+   ~SrvSessMgr();
 
    /* ============================= OTHER PUBLIC METHODS ============================= */
 
@@ -347,11 +659,9 @@ class SrvSessMgr : public SessMgr
    void srvSessMsgHandler();
 
    /**
-    * @brief  Server session raw handler, passing the number of bytes read from the
-    *         connection socket into the primary connection buffer to the raw sub-handler
-    *         associated with the current server session manager operation and step
-    * @param  recvBytes The number of bytes read from the connection
-    *                   socket into the primary connection buffer
+    * @brief  Server session raw handler, passing the raw data read from the connection socket
+    *         into the primary connection buffer to the raw sub-handler associated
+    *         with the current server session manager operation and step
     * @throws ERR_SESSABORT_INTERNAL_ERROR   Invalid server session manager operation
     *                                        and step for receiving raw data
     * @throws ERR_AESGCMMGR_INVALID_STATE    Invalid AES_128_GCM manager state
@@ -360,6 +670,7 @@ class SrvSessMgr : public SessMgr
     * @throws ERR_FILE_WRITE_FAILED          Failed to write into the temporary file
     * @throws ERR_OSSL_SET_TAG_FAILED        Error in setting the expected file integrity tag
     * @throws ERR_OSSL_DECRYPT_VERIFY_FAILED File integrity verification failed
+    * @throws ERR_SESSABORT_FILE_CHUNK_VERIFY_FAILED A file chunk integrity verification failed
     * @throws ERR_SESS_INTERNAL_ERROR        Failed to close or move the uploaded temporary
     *                                        file or NULL session attributes
     * @throws ERR_SESS_FILE_META_SET_FAILED  Error in setting the uploaded file's metadata
@@ -370,7 +681,69 @@ class SrvSessMgr : public SessMgr
     * @throws ERR_PEER_DISCONNECTED          The connection peer disconnected during the send()
     * @throws ERR_SEND_FAILED                send() fatal error
     */
-   void srvSessRawHandler(size_t recvBytes);
+   void srvSessRawHandler();
+
+   /**
+    * @brief  Returns whether the server session manager has file raw contents, upload outcomes or delta signatures
+    *         pending to be sent to the client, i.e. whether any of its streams is sending the raw contents of a
+    *         file being downloaded, has had its uploaded file committed by the group commit or is signing the
+    *         existing file of a delta upload and the associated connection manager is not receiving a message
+    *         or raw data block in its primary connection buffer (which sending would overwrite)
+    * @return A boolean indicating whether the server session manager has file raw
+    *         contents, upload outcomes or delta signatures pending to be sent
+    */
+   bool hasPendingSend();
+
+   /**
+    * @brief  Server session send handler, called when the connection socket is writable and the server session
+    *         manager has file raw contents pending to be sent, which selects in round-robin the next stream
+    *         sending the raw contents of a file being downloaded and sends its next segment to the client,
+    *         announced by a 'FILE_SEGMENT' session message, so that the segments of the files being
+    *         downloaded on different streams are interleaved on the connection, where:\n\n
+    *            - Segments are alternately encrypted into two ciphertext buffers, so that as a segment sent
+    *              in zero-copy mode cannot be overwritten until the kernel has released its buffer, the
+    *              encryption of a segment overlaps with the transmission of the previous one\n\n
+    *            - Segments of files mapped into memory are encrypted directly from their mapping, checking
+    *              the file not to have been truncated beforehand and its pages not to have been found
+    *              unbacked by the file during their encryption (see the mapFileFaultHandler() method)\n\n
+    *            - Once all the raw contents of a file have been sent, its stream is set to
+    *              expect the client download completion notification\n\n
+    *         Streams whose uploaded files have been committed by the group commit take precedence over
+    *         downloads, the handler notifying the client of the outcome of their upload instead, while streams
+    *         signing the existing file of a delta upload take their turn in the round-robin, each computing a
+    *         step of the file's blocks' signatures (see the signUploadBase() method)
+    * @throws ERR_SESS_INTERNAL_ERROR            An uploaded file could not be synchronized to storage
+    * @throws ERR_FILE_READ_FAILED               Error in reading from the main file
+    * @throws ERR_SESS_FILE_READ_FAILED          Error in reading the existing file of a delta upload
+    * @throws ERR_OSSL_EVP_MD_CTX_NEW            EVP_MD context creation failed
+    * @throws ERR_OSSL_EVP_DIGEST_INIT           EVP_MD digest initialization failed
+    * @throws ERR_OSSL_EVP_DIGEST_UPDATE         EVP_MD digest update failed
+    * @throws ERR_OSSL_EVP_DIGEST_FINAL          EVP_MD digest final failed
+    * @throws ERR_SESSABORT_UNEXPECTED_FILE_SIZE The sent file raw contents differ from its expected size
+    * @throws ERR_OSSL_EVP_PKEY_CTX_NEW          EVP_PKEY context creation failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE_INIT      Key derivation context initialization failed
+    * @throws ERR_OSSL_EVP_PKEY_DERIVE           Key derivation failed
+    * @throws ERR_AESGCMMGR_INVALID_STATE        Invalid AES_128_GCM manager state
+    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW        EVP_CIPHER context creation failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT          EVP_CIPHER encrypt initialization failed
+    * @throws ERR_NON_POSITIVE_BUFFER_SIZE       The plaintext block size is non-positive (probable overflow)
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE        EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL         EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED            Error in retrieving the resulting integrity tag
+    * @throws ERR_PEER_DISCONNECTED              The connection peer disconnected during the send()
+    * @throws ERR_SEND_FAILED                    send() fatal error
+    */
+   void srvSessSendHandler();
+
+   /**
+    * @brief Upload group commit callback, called by the server once the file uploaded on a stream awaiting
+    *        the group commit has been synchronized to storage (or failed to), setting the stream to notify
+    *        the client of the upload's outcome as the connection socket becomes writable (as the primary
+    *        connection buffer may be receiving a message of another stream, see the hasPendingSend() method)
+    * @param streamId The identifier of the stream of the committed upload
+    * @param durable  Whether the uploaded file has been successfully synchronized to storage
+    */
+   void uploadCommitCallback(uint8_t streamId, bool durable);
  };
 
 
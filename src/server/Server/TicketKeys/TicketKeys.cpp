@@ -0,0 +1,275 @@
+/* SafeCloud Server Resumption Ticket Keys Definitions */
+
+/* ================================== INCLUDES ================================== */
+
+// OpenSSL Headers
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+// SafeCloud Headers
+#include "TicketKeys.h"
+#include "errCodes/execErrCodes/execErrCodes.h"
+
+/* =============================== PRIVATE METHODS =============================== */
+
+/**
+ * @brief  Replaces the current ticket key with a new random key if its rotation interval has
+ *         elapsed, and deletes the previous ticket keys whose tickets can no longer be valid
+ * @throws ERR_OSSL_RAND_BYTES_FAILED RAND_bytes() ticket key generation failed
+ */
+void TicketKeys::rotateKeys()
+ {
+  // The current time in Unix epochs
+  time_t now = time(NULL);
+
+  // If there is no current ticket key or its rotation interval has elapsed
+  if(_keys.empty() || now - _keys.front().creationTime >= _rotation)
+   {
+    // Create a new random ticket key as the current one
+    _keys.emplace_front();
+    _keys.front().id = _nextKeyId++;
+    _keys.front().creationTime = now;
+    if(RAND_bytes(&_keys.front().key[0], TICKET_KEY_SIZE) != 1)
+     {
+      _keys.pop_front();
+      THROW_EXEC_EXCP(ERR_OSSL_RAND_BYTES_FAILED, OSSL_ERR_DESC);
+     }
+   }
+
+  /*
+   * Delete the oldest ticket keys whose last sealed tickets have expired, where
+   * a ticket key last sealed a ticket when it was replaced by the following key
+   *
+   * NOTE: As a ticket's lifetime is computed from the client's last full STSM
+   *       authentication, which precedes the ticket's sealing, this represents
+   *       an upper bound on when the key's tickets may still be valid
+   */
+  while(_keys.size() > 1 && now - _keys[_keys.size() - 2].creationTime > _lifetime)
+   {
+    OPENSSL_cleanse(&_keys.back().key[0], TICKET_KEY_SIZE);
+    _keys.pop_back();
+   }
+ }
+
+
+/* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+/**
+ * @brief  TicketKeys object constructor
+ * @param  lifetime The tickets' lifetime in seconds (0 = resumption disabled)
+ * @param  rotation The interval in seconds after which the current ticket key is replaced
+ * @throws ERR_SRV_TICKET_PARAMS_INVALID Negative tickets' lifetime or non-positive rotation interval
+ */
+TicketKeys::TicketKeys(int lifetime, int rotation)
+ : _lifetime(lifetime), _rotation(rotation), _nextKeyId(0), _keys()
+ {
+  // Ensure the tickets' lifetime and the ticket keys' rotation interval to be valid
+  if(lifetime < 0 || rotation <= 0)
+   THROW_EXEC_EXCP(ERR_SRV_TICKET_PARAMS_INVALID, "lifetime = " + std::to_string(lifetime)
+                                                  + ", rotation = " + std::to_string(rotation));
+
+  // Start the ticket keys' identifiers from a random value, so that
+  // tickets issued before a server restart are never matched with
+  // a ticket key (which would in any case fail their verification)
+  if(RAND_bytes(reinterpret_cast<unsigned char*>(&_nextKeyId), sizeof(_nextKeyId)) != 1)
+   THROW_EXEC_EXCP(ERR_OSSL_RAND_BYTES_FAILED, OSSL_ERR_DESC);
+ }
+
+
+/**
+ * @brief TicketKeys object destructor, safely deleting the ticket keys
+ */
+TicketKeys::~TicketKeys()
+ {
+  for(TicketKey& ticketKey : _keys)
+   OPENSSL_cleanse(&ticketKey.key[0], TICKET_KEY_SIZE);
+ }
+
+
+/* ============================ OTHER PUBLIC METHODS ============================ */
+
+/**
+ * @brief  Returns whether the server issues resumption tickets
+ * @return Whether the server issues resumption tickets
+ */
+bool TicketKeys::enabled() const
+ { return _lifetime > 0; }
+
+
+/**
+ * @brief  Returns the remaining lifetime of the tickets issued to a client
+ * @param  authTime The time in Unix epochs of the client's last full STSM authentication
+ * @return The remaining lifetime in seconds of the tickets issued to the client
+ */
+uint32_t TicketKeys::remLifetime(uint64_t authTime) const
+ {
+  // The time in Unix epochs at which the client's tickets expire
+  uint64_t expTime = authTime + (uint64_t)_lifetime;
+
+  // The current time in Unix epochs
+  uint64_t now = (uint64_t)time(NULL);
+
+  if(expTime <= now)
+   return 0;
+  return (uint32_t)(expTime - now);
+ }
+
+
+/**
+ * @brief  Seals a resumption ticket's contents into a ticket with the current ticket key
+ * @param  contents The ticket's contents
+ * @param  ticket   The ticket to be sealed
+ * @throws ERR_OSSL_RAND_BYTES_FAILED   RAND_bytes() ticket key or nonce generation failed
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW  EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+ * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+ * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the ticket's integrity tag
+ */
+void TicketKeys::sealTicket(const STSMTicketContents& contents, STSMTicket& ticket)
+ {
+  EVP_CIPHER_CTX* ticketCTX;  // The ticket's encryption context
+  int             outSize;    // The size of an encryption output
+
+  // Rotate the ticket keys, if necessary
+  rotateKeys();
+
+  // Set the ticket's key identifier and generate its random nonce
+  ticket.keyId = _keys.front().id;
+  if(RAND_bytes(&ticket.nonce[0], STSM_TICKET_NONCE_SIZE) != 1)
+   THROW_EXEC_EXCP(ERR_OSSL_RAND_BYTES_FAILED, OSSL_ERR_DESC);
+
+  // Create the ticket's encryption context
+  ticketCTX = EVP_CIPHER_CTX_new();
+  if(!ticketCTX)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_CIPHER_CTX_NEW, OSSL_ERR_DESC);
+
+  // Initialize the encryption with the current ticket key and the ticket's nonce
+  // (whose 12 bytes match the AES_256_GCM default IV size)
+  if(EVP_EncryptInit_ex(ticketCTX, EVP_aes_256_gcm(), NULL, &_keys.front().key[0], &ticket.nonce[0]) != 1)
+   {
+    EVP_CIPHER_CTX_free(ticketCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_ENCRYPT_INIT, OSSL_ERR_DESC);
+   }
+
+  // Authenticate the ticket's key identifier as AAD and encrypt the ticket's contents
+  if(EVP_EncryptUpdate(ticketCTX, NULL, &outSize, reinterpret_cast<const unsigned char*>(&ticket.keyId),
+                       sizeof(ticket.keyId)) != 1 ||
+     EVP_EncryptUpdate(ticketCTX, &ticket.encContents[0], &outSize,
+                       reinterpret_cast<const unsigned char*>(&contents), sizeof(STSMTicketContents)) != 1)
+   {
+    EVP_CIPHER_CTX_free(ticketCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_ENCRYPT_UPDATE, OSSL_ERR_DESC);
+   }
+
+  // Finalize the encryption (which in GCM mode adds no further ciphertext)
+  if(EVP_EncryptFinal_ex(ticketCTX, &ticket.encContents[outSize], &outSize) != 1)
+   {
+    EVP_CIPHER_CTX_free(ticketCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_ENCRYPT_FINAL, OSSL_ERR_DESC);
+   }
+
+  // Retrieve the ticket's integrity tag
+  if(EVP_CIPHER_CTX_ctrl(ticketCTX, EVP_CTRL_AEAD_GET_TAG, STSM_TICKET_TAG_SIZE, &ticket.tag[0]) != 1)
+   {
+    EVP_CIPHER_CTX_free(ticketCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_GET_TAG_FAILED, OSSL_ERR_DESC);
+   }
+
+  // Free the ticket's encryption context
+  EVP_CIPHER_CTX_free(ticketCTX);
+ }
+
+
+/**
+ * @brief  Opens a resumption ticket presented by a client, verifying its integrity and validity
+ * @param  ticket   The ticket to be opened
+ * @param  contents The ticket's contents
+ * @return Whether the ticket is valid, i.e. it was sealed by a retained ticket key,
+ *         it has not been tampered with and its lifetime has not elapsed
+ * @throws ERR_OSSL_RAND_BYTES_FAILED  RAND_bytes() ticket key generation failed
+ * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW EVP_CIPHER context creation failed
+ * @throws ERR_OSSL_EVP_DECRYPT_INIT   EVP_CIPHER decrypt initialization failed
+ * @throws ERR_OSSL_EVP_DECRYPT_UPDATE EVP_CIPHER decrypt update failed
+ * @throws ERR_OSSL_SET_TAG_FAILED     Error in setting the ticket's expected integrity tag
+ */
+bool TicketKeys::openTicket(const STSMTicket& ticket, STSMTicketContents& contents)
+ {
+  EVP_CIPHER_CTX* ticketCTX;            // The ticket's decryption context
+  int             outSize;              // The size of a decryption output
+  TicketKey*      ticketKey = nullptr;  // The ticket key the ticket was sealed with
+  int             verified;             // Whether the ticket's integrity was verified
+
+  // If resumption tickets are disabled, no ticket is valid
+  if(!enabled())
+   return false;
+
+  // Rotate the ticket keys, if necessary
+  rotateKeys();
+
+  // Search for the ticket key the ticket was sealed with among the retained ones
+  for(TicketKey& retKey : _keys)
+   if(retKey.id == ticket.keyId)
+    {
+     ticketKey = &retKey;
+     break;
+    }
+
+  // A ticket sealed with a ticket key that is no longer retained (or that
+  // was never created) has either expired or it is not authentic
+  if(ticketKey == nullptr)
+   return false;
+
+  // Create the ticket's decryption context
+  ticketCTX = EVP_CIPHER_CTX_new();
+  if(!ticketCTX)
+   THROW_EXEC_EXCP(ERR_OSSL_EVP_CIPHER_CTX_NEW, OSSL_ERR_DESC);
+
+  // Initialize the decryption with the ticket key and the ticket's nonce
+  if(EVP_DecryptInit_ex(ticketCTX, EVP_aes_256_gcm(), NULL, &ticketKey->key[0], &ticket.nonce[0]) != 1)
+   {
+    EVP_CIPHER_CTX_free(ticketCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_DECRYPT_INIT, OSSL_ERR_DESC);
+   }
+
+  // Authenticate the ticket's key identifier as AAD and decrypt the ticket's contents
+  if(EVP_DecryptUpdate(ticketCTX, NULL, &outSize, reinterpret_cast<const unsigned char*>(&ticket.keyId),
+                       sizeof(ticket.keyId)) != 1 ||
+     EVP_DecryptUpdate(ticketCTX, reinterpret_cast<unsigned char*>(&contents), &outSize,
+                       &ticket.encContents[0], sizeof(STSMTicketContents)) != 1)
+   {
+    EVP_CIPHER_CTX_free(ticketCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_EVP_DECRYPT_UPDATE, OSSL_ERR_DESC);
+   }
+
+  // Set the ticket's expected integrity tag
+  if(EVP_CIPHER_CTX_ctrl(ticketCTX, EVP_CTRL_AEAD_SET_TAG, STSM_TICKET_TAG_SIZE,
+                         const_cast<unsigned char*>(&ticket.tag[0])) != 1)
+   {
+    EVP_CIPHER_CTX_free(ticketCTX);
+    THROW_EXEC_EXCP(ERR_OSSL_SET_TAG_FAILED, OSSL_ERR_DESC);
+   }
+
+  // Verify the ticket's integrity
+  verified = EVP_DecryptFinal_ex(ticketCTX, reinterpret_cast<unsigned char*>(&contents) + outSize, &outSize);
+
+  // Free the ticket's decryption context
+  EVP_CIPHER_CTX_free(ticketCTX);
+
+  // A ticket failing its integrity verification is not authentic, while a
+  // ticket whose client name is not NUL-terminated should never be sealed
+  if(verified != 1 || contents.cliName[CLI_NAME_MAX_LENGTH] != '\0')
+   {
+    OPENSSL_cleanse(&contents, sizeof(STSMTicketContents));
+    return false;
+   }
+
+  // Ensure the ticket's lifetime not to have elapsed
+  if(contents.authTime > (uint64_t)time(NULL) || remLifetime(contents.authTime) == 0)
+   {
+    OPENSSL_cleanse(&contents, sizeof(STSMTicketContents));
+    return false;
+   }
+
+  return true;
+ }
\ No newline at end of file
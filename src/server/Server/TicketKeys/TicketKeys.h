@@ -0,0 +1,118 @@
+#ifndef SAFECLOUD_TICKETKEYS_H
+#define SAFECLOUD_TICKETKEYS_H
+
+/*
+ * This class represents the keys used by the SafeCloud server for sealing and opening the
+ * resumption tickets issued to clients, which allow them to resume their authentication in
+ * an abbreviated STSM execution without the server having to store any per-client state, where:
+ *
+ *   - Tickets are sealed with the current ticket key, which is replaced
+ *     by a new random key every "rotation" seconds
+ *
+ *   - Previous ticket keys are retained for opening the tickets sealed with them for as long
+ *     as such tickets may still be valid, i.e. for "lifetime" seconds after their replacement
+ *
+ *   - A ticket is valid for "lifetime" seconds from the client's last full STSM authentication,
+ *     so that clients must periodically authenticate with their long-term keys
+ *
+ *   - Ticket keys are never written to disk, so that a server restart
+ *     invalidates all tickets issued before it
+ */
+
+/* ================================== INCLUDES ================================== */
+#include <deque>
+#include "SafeCloudApp/ConnMgr/STSMMgr/STSMMsg.h"
+
+// The size in bytes of a ticket key (AES_256_GCM)
+#define TICKET_KEY_SIZE 32
+
+
+class TicketKeys
+ {
+  private:
+
+   // A ticket key along with its identifier and creation time
+   struct TicketKey
+    {
+     uint32_t      id;                    // The ticket key identifier
+     time_t        creationTime;          // The time in Unix epochs at which the key was created
+     unsigned char key[TICKET_KEY_SIZE];  // The ticket key value
+    };
+
+   /* ================================= ATTRIBUTES ================================= */
+   int                   _lifetime;   // The tickets' lifetime in seconds (0 = resumption disabled)
+   int                   _rotation;   // The interval in seconds after which the current ticket key is replaced
+   uint32_t              _nextKeyId;  // The identifier of the next ticket key to be created
+   std::deque<TicketKey> _keys;       // The ticket keys, from the current to the oldest retained one
+
+   /* =============================== PRIVATE METHODS =============================== */
+
+   /**
+    * @brief  Replaces the current ticket key with a new random key if its rotation interval has
+    *         elapsed, and deletes the previous ticket keys whose tickets can no longer be valid
+    * @throws ERR_OSSL_RAND_BYTES_FAILED RAND_bytes() ticket key generation failed
+    */
+   void rotateKeys();
+
+  public:
+
+   /* ========================= CONSTRUCTOR AND DESTRUCTOR ========================= */
+
+   /**
+    * @brief  TicketKeys object constructor
+    * @param  lifetime The tickets' lifetime in seconds (0 = resumption disabled)
+    * @param  rotation The interval in seconds after which the current ticket key is replaced
+    * @throws ERR_SRV_TICKET_PARAMS_INVALID Negative tickets' lifetime or non-positive rotation interval
+    */
+   TicketKeys(int lifetime, int rotation);
+
+   /**
+    * @brief TicketKeys object destructor, safely deleting the ticket keys
+    */
+   ~TicketKeys();
+
+   /* ============================ OTHER PUBLIC METHODS ============================ */
+
+   /**
+    * @brief  Returns whether the server issues resumption tickets
+    * @return Whether the server issues resumption tickets
+    */
+   bool enabled() const;
+
+   /**
+    * @brief  Returns the remaining lifetime of the tickets issued to a client
+    * @param  authTime The time in Unix epochs of the client's last full STSM authentication
+    * @return The remaining lifetime in seconds of the tickets issued to the client
+    */
+   uint32_t remLifetime(uint64_t authTime) const;
+
+   /**
+    * @brief  Seals a resumption ticket's contents into a ticket with the current ticket key
+    * @param  contents The ticket's contents
+    * @param  ticket   The ticket to be sealed
+    * @throws ERR_OSSL_RAND_BYTES_FAILED   RAND_bytes() ticket key or nonce generation failed
+    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW  EVP_CIPHER context creation failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_INIT    EVP_CIPHER encrypt initialization failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_UPDATE  EVP_CIPHER encrypt update failed
+    * @throws ERR_OSSL_EVP_ENCRYPT_FINAL   EVP_CIPHER encrypt final failed
+    * @throws ERR_OSSL_GET_TAG_FAILED      Error in retrieving the ticket's integrity tag
+    */
+   void sealTicket(const STSMTicketContents& contents, STSMTicket& ticket);
+
+   /**
+    * @brief  Opens a resumption ticket presented by a client, verifying its integrity and validity
+    * @param  ticket   The ticket to be opened
+    * @param  contents The ticket's contents
+    * @return Whether the ticket is valid, i.e. it was sealed by a retained ticket key,
+    *         it has not been tampered with and its lifetime has not elapsed
+    * @throws ERR_OSSL_RAND_BYTES_FAILED  RAND_bytes() ticket key generation failed
+    * @throws ERR_OSSL_EVP_CIPHER_CTX_NEW EVP_CIPHER context creation failed
+    * @throws ERR_OSSL_EVP_DECRYPT_INIT   EVP_CIPHER decrypt initialization failed
+    * @throws ERR_OSSL_EVP_DECRYPT_UPDATE EVP_CIPHER decrypt update failed
+    * @throws ERR_OSSL_SET_TAG_FAILED     Error in setting the ticket's expected integrity tag
+    */
+   bool openTicket(const STSMTicket& ticket, STSMTicketContents& contents);
+ };
+
+
+#endif //SAFECLOUD_TICKETKEYS_H
\ No newline at end of file
@@ -58,16 +58,25 @@ void OSSignalsCallback(__attribute__((unused)) int signum)
 /* ------------------------ Server Object Initialization ------------------------ */
 
 /**
- * @brief         Attempts to initialize the SafeCloud Server
- *                object by passing it the OS port it must bind on
- * @param srvPort The port the SafeCloud server must bind on
+ * @brief                   Attempts to initialize the SafeCloud Server object by passing it the OS port it must
+ *                          bind on, the parameters of the resumption tickets it issues, its uploads durability,
+ *                          the retention time of interrupted uploads and its content store's parameters
+ * @param srvPort           The port the SafeCloud server must bind on
+ * @param ticketLifetime    The resumption tickets' lifetime in seconds (0 = resumption disabled)
+ * @param ticketKeyRotation The resumption ticket keys' rotation interval in seconds
+ * @param durability        The uploads durability mode (0 = none, 1 = files, 2 = files + directories)
+ * @param commitWindow      The uploads group commit window in milliseconds
+ * @param uploadRetention   The retention time of interrupted uploads in seconds (0 = resumption disabled)
+ * @param storeGCInterval   The content store garbage collection interval in seconds (0 = store disabled)
  */
-void serverInit(uint16_t& srvPort)
+void serverInit(uint16_t& srvPort, int& ticketLifetime, int& ticketKeyRotation, int& durability, int& commitWindow,
+                int& uploadRetention, int& storeGCInterval)
  {
   // Attempt to initialize the client object by
   // passing the server connection parameters
   try
-   { srv = new Server(srvPort); }
+   { srv = new Server(srvPort, ticketLifetime, ticketKeyRotation, durability, commitWindow, uploadRetention,
+                      storeGCInterval); }
   catch(execErrExcp& excp)
    {
     // If the exception is relative to an invalid srvIP passed via
@@ -77,6 +86,32 @@ void serverInit(uint16_t& srvPort)
      std::cerr << "\nPlease specify a PORT >= " << std::to_string(SRV_PORT_MIN)
                << " for the '-p' option\n" << std::endl;
 
+    // If the exception is relative to invalid resumption tickets' parameters passed
+    // via command-line arguments, "gently" inform the user of their allowed values
+    else
+     if(excp.exErrcode == ERR_SRV_TICKET_PARAMS_INVALID)
+      std::cerr << "\nPlease specify a LIFETIME >= 0 for the '-t' option"
+                   " and a ROTATION > 0 for the '-k' option\n" << std::endl;
+
+    // If the exception is relative to invalid uploads durability parameters passed
+    // via command-line arguments, "gently" inform the user of their allowed values
+    else
+     if(excp.exErrcode == ERR_SRV_DURABILITY_PARAMS_INVALID)
+      std::cerr << "\nPlease specify a DURABILITY in [0,2] for the '-d' option"
+                   " and a WINDOW >= 0 for the '-w' option\n" << std::endl;
+
+    // If the exception is relative to an invalid partial uploads retention time passed
+    // via command-line arguments, "gently" inform the user of its allowed values
+    else
+     if(excp.exErrcode == ERR_SRV_RETENTION_INVALID)
+      std::cerr << "\nPlease specify a RETENTION >= 0 for the '-r' option\n" << std::endl;
+
+    // If the exception is relative to an invalid content store garbage collection interval
+    // passed via command-line arguments, "gently" inform the user of its allowed values
+    else
+     if(excp.exErrcode == ERR_SRV_STORE_GC_INVALID)
+      std::cerr << "\nPlease specify an INTERVAL >= 0 for the '-s' option\n" << std::endl;
+
      // All other exceptions should be handled by the general
      // handleExecErrException() function (which, being all
      // of FATAL severity, will terminate the execution)
@@ -100,10 +135,22 @@ void printProgramUsageGuidelines()
  {
   std::cerr << "\nUsage:" << std::endl;
   std::cerr << "----- " << std::endl;
-  std::cerr << "./server           -> Bind the server to the default port ("
+  std::cerr << "./server                 -> Bind the server to the default port ("
             << SRV_DEFAULT_PORT << ")" << std::endl;
-  std::cerr << "./server [-p PORT] -> Bind the server to the custom PORT >= "
+  std::cerr << "./server [-p PORT]       -> Bind the server to the custom PORT >= "
             << std::to_string(SRV_PORT_MIN) << std::endl;
+  std::cerr << "         [-t LIFETIME]   -> Set the resumption tickets' lifetime in seconds (default "
+            << SRV_TICKET_LIFETIME << ", 0 = disabled)" << std::endl;
+  std::cerr << "         [-k ROTATION]   -> Set the resumption ticket keys' rotation interval in seconds (default "
+            << SRV_TICKET_KEY_ROTATION << ")" << std::endl;
+  std::cerr << "         [-d DURABILITY] -> Set the uploads durability (0 = none, 1 = fsync files, 2 = fsync files and"
+               " directories, default " << SRV_DURABILITY_MODE << ")" << std::endl;
+  std::cerr << "         [-w WINDOW]     -> Set the uploads group commit window in milliseconds (default "
+            << SRV_GROUP_COMMIT_WINDOW << ")" << std::endl;
+  std::cerr << "         [-r RETENTION]  -> Set the retention time of interrupted uploads in seconds (default "
+            << SRV_UPLOAD_RETENTION << ", 0 = disabled)" << std::endl;
+  std::cerr << "         [-s INTERVAL]   -> Deduplicate the users' files in a content store garbage collected every"
+               " INTERVAL seconds (default " << SRV_STORE_GC_INTERVAL << ", 0 = disabled)" << std::endl;
   std::cerr << std::endl;
  }
 
@@ -116,20 +163,41 @@ void printProgramUsageGuidelines()
  *              "defaults.h" (with validity checks remanded to the Server's constructor)\n\n
  *           3) The resulting options' values are written in
  *              the reference variables provided by the caller
- * @param argc    The number of command-line input arguments
- * @param argv    The array of command-line input arguments
- * @param srvPort The resulting port the SafeCloud server must bind to
+ * @param argc              The number of command-line input arguments
+ * @param argv              The array of command-line input arguments
+ * @param srvPort           The resulting port the SafeCloud server must bind to
+ * @param ticketLifetime    The resulting resumption tickets' lifetime in seconds
+ * @param ticketKeyRotation The resulting resumption ticket keys' rotation interval in seconds
+ * @param durability        The resulting uploads durability mode
+ * @param commitWindow      The resulting uploads group commit window in milliseconds
+ * @param uploadRetention   The resulting retention time of interrupted uploads in seconds
+ * @param storeGCInterval   The resulting content store garbage collection interval in seconds
  */
-void parseCmdArgs(int argc, char** argv, uint16_t& srvPort)
+void parseCmdArgs(int argc, char** argv, uint16_t& srvPort, int& ticketLifetime, int& ticketKeyRotation,
+                  int& durability, int& commitWindow, int& uploadRetention, int& storeGCInterval)
  {
   // The candidate port the SafeCloud server must bind to
   uint16_t _srvPort = SRV_DEFAULT_PORT;
 
+  // The candidate resumption tickets' lifetime and ticket keys' rotation interval
+  int _ticketLifetime = SRV_TICKET_LIFETIME;
+  int _ticketKeyRotation = SRV_TICKET_KEY_ROTATION;
+
+  // The candidate uploads durability mode and group commit window
+  int _durability = SRV_DURABILITY_MODE;
+  int _commitWindow = SRV_GROUP_COMMIT_WINDOW;
+
+  // The candidate retention time of interrupted uploads
+  int _uploadRetention = SRV_UPLOAD_RETENTION;
+
+  // The candidate content store garbage collection interval
+  int _storeGCInterval = SRV_STORE_GC_INTERVAL;
+
   // The current command-line option parsed by the getOpt() function
   int opt;
 
   // Read all command-line arguments via the getOpt() function
-  while((opt = getopt(argc, argv, ":p:h")) != -1)
+  while((opt = getopt(argc, argv, ":p:t:k:d:w:r:s:h")) != -1)
    switch(opt)
     {
      // Help option
@@ -153,10 +221,82 @@ void parseCmdArgs(int argc, char** argv, uint16_t& srvPort)
 #pragma clang diagnostic pop
       break;
 
-     // Server Port option WITHOUT value
+     // Resumption tickets' lifetime option + its value
+     // (validity checks remanded to the Server's constructor)
+     case 't':
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "cert-err34-c"
+      _ticketLifetime = atoi(optarg);
+#pragma clang diagnostic pop
+      break;
+
+     // Resumption ticket keys' rotation interval option + its value
+     // (validity checks remanded to the Server's constructor)
+     case 'k':
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "cert-err34-c"
+      _ticketKeyRotation = atoi(optarg);
+#pragma clang diagnostic pop
+      break;
+
+     // Uploads durability mode option + its value
+     // (validity checks remanded to the Server's constructor)
+     case 'd':
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "cert-err34-c"
+      _durability = atoi(optarg);
+#pragma clang diagnostic pop
+      break;
+
+     // Uploads group commit window option + its value
+     // (validity checks remanded to the Server's constructor)
+     case 'w':
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "cert-err34-c"
+      _commitWindow = atoi(optarg);
+#pragma clang diagnostic pop
+      break;
+
+     // Interrupted uploads retention time option + its value
+     // (validity checks remanded to the Server's constructor)
+     case 'r':
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "cert-err34-c"
+      _uploadRetention = atoi(optarg);
+#pragma clang diagnostic pop
+      break;
+
+     // Content store garbage collection interval option + its value
+     // (validity checks remanded to the Server's constructor)
+     case 's':
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "cert-err34-c"
+      _storeGCInterval = atoi(optarg);
+#pragma clang diagnostic pop
+      break;
+
+     // Option WITHOUT value
      case ':':
-      std::cerr << "\nPlease specify a PORT >= " << std::to_string(SRV_PORT_MIN)
-                << " for the '-p' option\n" << std::endl;
+      if(optopt == 'p')
+       std::cerr << "\nPlease specify a PORT >= " << std::to_string(SRV_PORT_MIN)
+                 << " for the '-p' option\n" << std::endl;
+      else
+       if(optopt == 't')
+        std::cerr << "\nPlease specify a LIFETIME >= 0 for the '-t' option\n" << std::endl;
+       else
+        if(optopt == 'k')
+         std::cerr << "\nPlease specify a ROTATION > 0 for the '-k' option\n" << std::endl;
+        else
+         if(optopt == 'd')
+          std::cerr << "\nPlease specify a DURABILITY in [0,2] for the '-d' option\n" << std::endl;
+         else
+          if(optopt == 'w')
+           std::cerr << "\nPlease specify a WINDOW >= 0 for the '-w' option\n" << std::endl;
+          else
+           if(optopt == 'r')
+            std::cerr << "\nPlease specify a RETENTION >= 0 for the '-r' option\n" << std::endl;
+           else
+            std::cerr << "\nPlease specify an INTERVAL >= 0 for the '-s' option\n" << std::endl;
       exit(EXIT_FAILURE);
       // break;
 
@@ -188,6 +328,12 @@ void parseCmdArgs(int argc, char** argv, uint16_t& srvPort)
   // Copy the UNVALIDATED temporary option's values
   // into the references provided by the caller
   srvPort = _srvPort;
+  ticketLifetime = _ticketLifetime;
+  ticketKeyRotation = _ticketKeyRotation;
+  durability = _durability;
+  commitWindow = _commitWindow;
+  uploadRetention = _uploadRetention;
+  storeGCInterval = _storeGCInterval;
  }
 
 
@@ -203,18 +349,33 @@ int main(int argc, char** argv)
   // The OS port the SafeCloud server must bind on
   uint16_t srvPort;
 
+  // The resumption tickets' lifetime and ticket keys' rotation interval
+  int ticketLifetime;
+  int ticketKeyRotation;
+
+  // The uploads durability mode and group commit window
+  int durability;
+  int commitWindow;
+
+  // The retention time of interrupted uploads
+  int uploadRetention;
+
+  // The content store garbage collection interval
+  int storeGCInterval;
+
   // Register the SIGINT, SIGTERM and SIGQUIT signals handler
   signal(SIGINT, OSSignalsCallback);
   signal(SIGTERM, OSSignalsCallback);
   signal(SIGQUIT, OSSignalsCallback);
 
-  // Determine the Port the SafeCloud server must
-  // bind to by parsing the command-line arguments
-  parseCmdArgs(argc, argv, srvPort);
+  // Determine the Port the SafeCloud server must bind to, the resumption tickets', the uploads durability,
+  // the partial uploads and the content store parameters by parsing the command-line arguments
+  parseCmdArgs(argc, argv, srvPort, ticketLifetime, ticketKeyRotation, durability, commitWindow, uploadRetention,
+               storeGCInterval);
 
-  // Attempt to initialize the SafeCloud Server
-  // object by passing the OS port it must bind on
-  serverInit(srvPort);
+  // Attempt to initialize the SafeCloud Server object by passing it the OS port it must bind on, the
+  // resumption tickets', the uploads durability, the partial uploads and the content store parameters
+  serverInit(srvPort, ticketLifetime, ticketKeyRotation, durability, commitWindow, uploadRetention, storeGCInterval);
 
   // Start the SafeCloud server
   try